@@ -0,0 +1,1045 @@
+/**
+ * Dweve HEDL - Hierarchical Entity Data Language
+ *
+ * Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file hedl_bench.c
+ * @brief Native benchmark suite for the HEDL C API
+ *
+ * The C-side counterpart of crates/hedl-bench/benches/bindings/ffi.rs. Every
+ * measurement crosses the FFI boundary exactly as production C code does.
+ *
+ * Measures:
+ * - Parsing across document shapes (wide matrix lists, deep nesting,
+ *   reference-heavy, block strings) and sizes
+ * - Every exporter, in its allocating, callback and caller-buffer variants
+ * - Multi-threaded parse scaling: concurrent C threads, hedl_parse_batch
+ *   and hedl_parse_parallel
+ *
+ * Each case runs warmup iterations, then timed repetitions; the report gives
+ * min/mean/stddev/percentiles, throughput and peak RSS. Pass --json FILE to
+ * also write the results as JSON for regression tracking.
+ *
+ * Usage: hedl_bench_c [--quick] [--reps N] [--warmup N] [--sizes A,B,...]
+ *                     [--threads N] [--filter TEXT] [--json FILE]
+ */
+
+/* clock_gettime and CLOCK_MONOTONIC are POSIX, not ISO C */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "hedl.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <pthread.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+/* Exporters are compiled in to match the library's Cargo features; the
+ * CMake target defines these from the HEDL_FEATURE_* options. */
+#ifndef HEDL_BENCH_JSON
+#define HEDL_BENCH_JSON 1
+#endif
+#ifndef HEDL_BENCH_YAML
+#define HEDL_BENCH_YAML 1
+#endif
+#ifndef HEDL_BENCH_XML
+#define HEDL_BENCH_XML 1
+#endif
+#ifndef HEDL_BENCH_CSV
+#define HEDL_BENCH_CSV 1
+#endif
+#ifndef HEDL_BENCH_NEO4J
+#define HEDL_BENCH_NEO4J 1
+#endif
+
+#define MAX_SIZES 8
+#define MAX_THREAD_STEPS 8
+#define DEEP_LEVELS 32
+#define BATCH_DOCS 16
+
+/* ============================================================================
+ * Timing and Memory
+ * ============================================================================ */
+
+/**
+ * Monotonic time in nanoseconds
+ */
+static uint64_t now_ns(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/**
+ * Reset the peak-RSS high-water mark where the platform allows it
+ *
+ * Linux resets VmHWM through /proc/self/clear_refs, which gives each case
+ * its own peak; elsewhere the peak is process-wide and only ever grows.
+ */
+static void reset_peak_rss(void) {
+#ifdef __linux__
+    FILE* f = fopen("/proc/self/clear_refs", "w");
+    if (f) {
+        fputs("5", f);
+        fclose(f);
+    }
+#endif
+}
+
+/**
+ * Peak resident set size in bytes since the last reset, or 0 if unknown
+ */
+static uint64_t peak_rss_bytes(void) {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        return (uint64_t)pmc.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+#ifdef __linux__
+    FILE* f = fopen("/proc/self/status", "r");
+    if (f) {
+        char line[256];
+        unsigned long long kb = 0;
+        while (fgets(line, sizeof(line), f)) {
+            if (sscanf(line, "VmHWM: %llu kB", &kb) == 1) {
+                break;
+            }
+        }
+        fclose(f);
+        if (kb) {
+            return (uint64_t)kb * 1024;
+        }
+    }
+#endif
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return (uint64_t)usage.ru_maxrss;
+#else
+    return (uint64_t)usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
+static int cpu_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
+
+/* ============================================================================
+ * Growable Text Buffer
+ * ============================================================================ */
+
+typedef struct {
+    char* data;
+    size_t len;
+    size_t cap;
+} Buf;
+
+static void buf_reserve(Buf* b, size_t extra) {
+    if (b->len + extra + 1 <= b->cap) {
+        return;
+    }
+    size_t cap = b->cap ? b->cap : 4096;
+    while (cap < b->len + extra + 1) {
+        cap *= 2;
+    }
+    char* data = realloc(b->data, cap);
+    if (!data) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    b->data = data;
+    b->cap = cap;
+}
+
+static void buf_printf(Buf* b, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    va_list copy;
+    va_copy(copy, args);
+    int n = vsnprintf(NULL, 0, fmt, copy);
+    va_end(copy);
+    if (n > 0) {
+        buf_reserve(b, (size_t)n);
+        vsnprintf(b->data + b->len, b->cap - b->len, fmt, args);
+        b->len += (size_t)n;
+    }
+    va_end(args);
+}
+
+static void buf_free(Buf* b) {
+    free(b->data);
+    b->data = NULL;
+    b->len = b->cap = 0;
+}
+
+/* ============================================================================
+ * Document Shapes
+ * ============================================================================ */
+
+/**
+ * Wide matrix list: one typed list of `size` rows with 16 mixed columns
+ */
+static void gen_wide(Buf* b, int size) {
+    buf_printf(b, "%%VERSION: 1.0\n%%STRUCT: Metric (%d): [id", size);
+    for (int c = 1; c < 16; c++) {
+        buf_printf(b, ",c%d", c);
+    }
+    buf_printf(b, "]\n---\nmetrics: @Metric\n");
+    for (int i = 0; i < size; i++) {
+        buf_printf(b, "  |m%d", i + 1);
+        for (int c = 1; c < 16; c++) {
+            switch (c % 4) {
+                case 0: buf_printf(b, ",%d", i * 31 + c); break;
+                case 1: buf_printf(b, ",%d.%02d", i % 977, (i + c) % 100); break;
+                case 2: buf_printf(b, ",%s", ((i + c) % 3) ? "true" : "false"); break;
+                default: buf_printf(b, ",label_%d_%d", c, i % 113); break;
+            }
+        }
+        buf_printf(b, "\n");
+    }
+}
+
+/**
+ * Deep nesting: `size` objects, each a chain of DEEP_LEVELS nested objects
+ */
+static void gen_deep(Buf* b, int size) {
+    buf_printf(b, "%%VERSION: 1.0\n---\n");
+    for (int i = 0; i < size; i++) {
+        buf_printf(b, "tree_%d:\n", i);
+        for (int level = 1; level <= DEEP_LEVELS; level++) {
+            int indent = level * 2;
+            buf_printf(b, "%*sname: level_%d\n", indent, "", level);
+            buf_printf(b, "%*svalue: %d\n", indent, "", i * DEEP_LEVELS + level);
+            if (level < DEEP_LEVELS) {
+                buf_printf(b, "%*schild:\n", indent, "");
+            }
+        }
+    }
+}
+
+/**
+ * Reference-heavy: `size` people and 2x`size` tasks that reference people
+ * and earlier tasks, so strict parsing resolves three references per task
+ */
+static void gen_refs(Buf* b, int size) {
+    int tasks = size * 2;
+    buf_printf(b,
+        "%%VERSION: 1.0\n"
+        "%%STRUCT: Person (%d): [id,name,team]\n"
+        "%%STRUCT: Task (%d): [id,title,owner,reviewer,depends_on]\n"
+        "---\n"
+        "people: @Person\n", size, tasks);
+    for (int i = 0; i < size; i++) {
+        buf_printf(b, "  |p%d,Person %d,team_%d\n", i + 1, i + 1, i % 7);
+    }
+    buf_printf(b, "tasks: @Task\n");
+    for (int i = 0; i < tasks; i++) {
+        buf_printf(b, "  |t%d,Task %d,@Person:p%d,@Person:p%d,", i + 1, i + 1,
+                   (i * 7) % size + 1, (i * 13 + 3) % size + 1);
+        if (i > 0) {
+            buf_printf(b, "@Task:t%d\n", (i * 7 + 3) % i + 1);
+        } else {
+            buf_printf(b, "~\n");
+        }
+    }
+}
+
+/**
+ * Block strings: `size` keys, each holding an eight-line block string
+ */
+static void gen_blocks(Buf* b, int size) {
+    buf_printf(b, "%%VERSION: 1.0\n---\n");
+    for (int i = 0; i < size; i++) {
+        buf_printf(b, "note_%d: \"\"\"\n", i);
+        for (int line = 0; line < 8; line++) {
+            buf_printf(b, "  Entry %d line %d: the quick brown fox jumps over "
+                          "the lazy dog, \"quoted\" and, comma-separated.\n", i, line);
+        }
+        buf_printf(b, "\"\"\"\n");
+    }
+}
+
+typedef struct {
+    const char* name;
+    void (*generate)(Buf* b, int size);
+} Shape;
+
+static const Shape SHAPES[] = {
+    {"wide", gen_wide},
+    {"deep", gen_deep},
+    {"refs", gen_refs},
+    {"blocks", gen_blocks},
+};
+
+#define SHAPE_COUNT ((int)(sizeof(SHAPES) / sizeof(SHAPES[0])))
+
+/* ============================================================================
+ * Statistics and Reporting
+ * ============================================================================ */
+
+typedef struct {
+    char name[96];
+    char group[24];
+    char shape[16];
+    int size;
+    int threads;
+    size_t input_bytes;
+    size_t output_bytes;
+    int reps;
+    double min_ns, mean_ns, stddev_ns, p50_ns, p90_ns, p99_ns, max_ns;
+    double throughput_mbs;
+    uint64_t peak_rss;
+    int status;
+    char error[160];
+} Result;
+
+typedef struct {
+    int warmup;
+    int reps;
+    int sizes[MAX_SIZES];
+    int size_count;
+    int max_threads;
+    const char* filter;
+    const char* json_path;
+} Config;
+
+static Result* g_results = NULL;
+static size_t g_result_count = 0;
+static size_t g_result_cap = 0;
+
+static Result* push_result(void) {
+    if (g_result_count == g_result_cap) {
+        size_t cap = g_result_cap ? g_result_cap * 2 : 64;
+        Result* grown = realloc(g_results, cap * sizeof(Result));
+        if (!grown) {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+        g_results = grown;
+        g_result_cap = cap;
+    }
+    Result* r = &g_results[g_result_count++];
+    memset(r, 0, sizeof(*r));
+    return r;
+}
+
+static int cmp_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Nearest-rank percentile of sorted samples
+ */
+static double percentile(const double* sorted, int n, double p) {
+    int rank = (int)ceil(p / 100.0 * n);
+    if (rank < 1) rank = 1;
+    if (rank > n) rank = n;
+    return sorted[rank - 1];
+}
+
+static void summarize(Result* r, double* samples, int n) {
+    qsort(samples, (size_t)n, sizeof(double), cmp_double);
+    double sum = 0.0;
+    for (int i = 0; i < n; i++) {
+        sum += samples[i];
+    }
+    double mean = sum / n;
+    double var = 0.0;
+    for (int i = 0; i < n; i++) {
+        var += (samples[i] - mean) * (samples[i] - mean);
+    }
+    r->reps = n;
+    r->min_ns = samples[0];
+    r->max_ns = samples[n - 1];
+    r->mean_ns = mean;
+    r->stddev_ns = n > 1 ? sqrt(var / (n - 1)) : 0.0;
+    r->p50_ns = percentile(samples, n, 50.0);
+    r->p90_ns = percentile(samples, n, 90.0);
+    r->p99_ns = percentile(samples, n, 99.0);
+    if (r->input_bytes && r->p50_ns > 0) {
+        r->throughput_mbs = (double)r->input_bytes / (r->p50_ns / 1e9) / 1e6;
+    }
+}
+
+static void format_ns(double ns, char* out, size_t size) {
+    if (ns < 1e3) {
+        snprintf(out, size, "%.0f ns", ns);
+    } else if (ns < 1e6) {
+        snprintf(out, size, "%.2f us", ns / 1e3);
+    } else if (ns < 1e9) {
+        snprintf(out, size, "%.2f ms", ns / 1e6);
+    } else {
+        snprintf(out, size, "%.2f s", ns / 1e9);
+    }
+}
+
+static void print_header(void) {
+    printf("%-44s %10s %10s %10s %10s %9s %9s\n",
+           "Case", "p50", "p90", "p99", "stddev", "MB/s", "peak MiB");
+    printf("----------------------------------------------------------------"
+           "----------------------------------------------\n");
+}
+
+static void print_result(const Result* r) {
+    if (r->status != HEDL_OK) {
+        printf("%-44s FAILED (%d): %s\n", r->name, r->status, r->error);
+        return;
+    }
+    char p50[24], p90[24], p99[24], sd[24];
+    format_ns(r->p50_ns, p50, sizeof(p50));
+    format_ns(r->p90_ns, p90, sizeof(p90));
+    format_ns(r->p99_ns, p99, sizeof(p99));
+    format_ns(r->stddev_ns, sd, sizeof(sd));
+    printf("%-44s %10s %10s %10s %10s %9.1f %9.1f\n", r->name, p50, p90, p99, sd,
+           r->throughput_mbs, (double)r->peak_rss / (1024.0 * 1024.0));
+}
+
+static void print_section(const char* title) {
+    printf("\n");
+    printf("=================================================\n");
+    printf(" %s\n", title);
+    printf("=================================================\n\n");
+    print_header();
+}
+
+static void json_string(FILE* f, const char* s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            fprintf(f, "\\%c", c);
+        } else if (c < 0x20) {
+            fprintf(f, "\\u%04x", c);
+        } else {
+            fputc(c, f);
+        }
+    }
+    fputc('"', f);
+}
+
+static int write_json(const Config* cfg, const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "cannot write %s\n", path);
+        return 1;
+    }
+    fprintf(f, "{\n  \"suite\": \"hedl_bench_c\",\n");
+    fprintf(f, "  \"timestamp\": %lld,\n", (long long)time(NULL));
+    fprintf(f, "  \"config\": {\"warmup\": %d, \"reps\": %d, \"max_threads\": %d, \"sizes\": [",
+            cfg->warmup, cfg->reps, cfg->max_threads);
+    for (int i = 0; i < cfg->size_count; i++) {
+        fprintf(f, "%s%d", i ? ", " : "", cfg->sizes[i]);
+    }
+    fprintf(f, "]},\n  \"results\": [\n");
+    for (size_t i = 0; i < g_result_count; i++) {
+        const Result* r = &g_results[i];
+        fprintf(f, "    {\"name\": ");
+        json_string(f, r->name);
+        fprintf(f, ", \"group\": ");
+        json_string(f, r->group);
+        fprintf(f, ", \"shape\": ");
+        json_string(f, r->shape);
+        fprintf(f, ", \"size\": %d, \"threads\": %d, \"input_bytes\": %zu, "
+                   "\"output_bytes\": %zu, \"status\": %d",
+                r->size, r->threads, r->input_bytes, r->output_bytes, r->status);
+        if (r->status == HEDL_OK) {
+            fprintf(f, ", \"reps\": %d, \"min_ns\": %.0f, \"mean_ns\": %.1f, "
+                       "\"stddev_ns\": %.1f, \"p50_ns\": %.0f, \"p90_ns\": %.0f, "
+                       "\"p99_ns\": %.0f, \"max_ns\": %.0f, \"throughput_mbs\": %.3f, "
+                       "\"peak_rss_bytes\": %llu",
+                    r->reps, r->min_ns, r->mean_ns, r->stddev_ns, r->p50_ns, r->p90_ns,
+                    r->p99_ns, r->max_ns, r->throughput_mbs, (unsigned long long)r->peak_rss);
+        } else {
+            fprintf(f, ", \"error\": ");
+            json_string(f, r->error);
+        }
+        fprintf(f, "}%s\n", i + 1 < g_result_count ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+    return 0;
+}
+
+/* ============================================================================
+ * Case Runner
+ * ============================================================================ */
+
+/**
+ * One benchmarked operation: returns a HEDL status code and may report the
+ * size of what it produced through *out_bytes
+ */
+typedef int (*bench_fn)(void* ctx, size_t* out_bytes);
+
+typedef struct {
+    const char* input;
+    size_t len;
+    const HedlDocument* doc;
+    char* buf;
+    size_t cap;
+    int threads;
+    size_t written;
+} Ctx;
+
+static int selected(const Config* cfg, const char* name) {
+    return !cfg->filter || strstr(name, cfg->filter) != NULL;
+}
+
+/**
+ * Run warmup and timed repetitions of fn, then record and print the result
+ */
+static void run_case(const Config* cfg, const char* group, const char* shape, int size,
+                     int threads, const char* name, bench_fn fn, void* ctx,
+                     size_t input_bytes) {
+    if (!selected(cfg, name)) {
+        return;
+    }
+    Result* r = push_result();
+    snprintf(r->name, sizeof(r->name), "%s", name);
+    snprintf(r->group, sizeof(r->group), "%s", group);
+    snprintf(r->shape, sizeof(r->shape), "%s", shape);
+    r->size = size;
+    r->threads = threads;
+    r->input_bytes = input_bytes;
+
+    for (int i = 0; i < cfg->warmup; i++) {
+        size_t bytes = 0;
+        int rc = fn(ctx, &bytes);
+        if (rc != HEDL_OK) {
+            const char* err = hedl_get_last_error();
+            r->status = rc;
+            snprintf(r->error, sizeof(r->error), "%s", err ? err : "unknown error");
+            print_result(r);
+            return;
+        }
+        r->output_bytes = bytes;
+    }
+
+    double* samples = malloc((size_t)cfg->reps * sizeof(double));
+    if (!samples) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    reset_peak_rss();
+    for (int i = 0; i < cfg->reps; i++) {
+        size_t bytes = 0;
+        uint64_t start = now_ns();
+        int rc = fn(ctx, &bytes);
+        uint64_t end = now_ns();
+        if (rc != HEDL_OK) {
+            const char* err = hedl_get_last_error();
+            r->status = rc;
+            snprintf(r->error, sizeof(r->error), "%s", err ? err : "unknown error");
+            free(samples);
+            print_result(r);
+            return;
+        }
+        r->output_bytes = bytes;
+        samples[i] = (double)(end - start);
+    }
+    r->peak_rss = peak_rss_bytes();
+    summarize(r, samples, cfg->reps);
+    free(samples);
+    print_result(r);
+}
+
+/* ============================================================================
+ * Parse Cases
+ * ============================================================================ */
+
+static int bench_parse(void* p, size_t* out_bytes) {
+    Ctx* c = p;
+    HedlDocument* doc = NULL;
+    int rc = hedl_parse_sized(c->input, c->len, 1, 0, &doc);
+    hedl_free_document(doc);
+    *out_bytes = 0;
+    return rc;
+}
+
+static int bench_parse_lenient(void* p, size_t* out_bytes) {
+    Ctx* c = p;
+    HedlDocument* doc = NULL;
+    int rc = hedl_parse_sized(c->input, c->len, 0, 0, &doc);
+    hedl_free_document(doc);
+    *out_bytes = 0;
+    return rc;
+}
+
+static int bench_validate(void* p, size_t* out_bytes) {
+    Ctx* c = p;
+    *out_bytes = 0;
+    return hedl_validate_sized(c->input, c->len, 1, 0);
+}
+
+static int bench_snapshot_load(void* p, size_t* out_bytes) {
+    Ctx* c = p;
+    HedlDocument* doc = NULL;
+    int rc = hedl_from_snapshot((const uint8_t*)c->buf, c->cap, &doc);
+    hedl_free_document(doc);
+    *out_bytes = 0;
+    return rc;
+}
+
+/* ============================================================================
+ * Export Cases
+ * ============================================================================ */
+
+static void count_sink(const char* data, size_t len, void* user_data) {
+    (void)data;
+    ((Ctx*)user_data)->written += len;
+}
+
+/*
+ * Each exporter is measured three ways: the allocating call plus
+ * hedl_free_string, the callback variant into a counting sink, and the
+ * caller-buffer variant into a buffer sized once up front.
+ */
+#define DEFINE_EXPORT(name, alloc_call, callback_call, into_call)             \
+    static int bench_##name##_alloc(void* p, size_t* out_bytes) {              \
+        Ctx* c = p;                                                            \
+        char* out = NULL;                                                      \
+        int rc = alloc_call;                                                   \
+        if (rc == HEDL_OK) {                                                   \
+            *out_bytes = strlen(out);                                          \
+        }                                                                      \
+        hedl_free_string(out);                                                 \
+        return rc;                                                             \
+    }                                                                          \
+    static int bench_##name##_callback(void* p, size_t* out_bytes) {           \
+        Ctx* c = p;                                                            \
+        c->written = 0;                                                        \
+        int rc = callback_call;                                                \
+        *out_bytes = c->written;                                               \
+        return rc;                                                             \
+    }                                                                          \
+    static int bench_##name##_into(void* p, size_t* out_bytes) {               \
+        Ctx* c = p;                                                            \
+        size_t needed = 0;                                                     \
+        int rc = into_call;                                                    \
+        *out_bytes = needed ? needed - 1 : 0;                                  \
+        return rc;                                                             \
+    }
+
+DEFINE_EXPORT(canonical,
+              hedl_canonicalize(c->doc, &out),
+              hedl_canonicalize_callback(c->doc, count_sink, c),
+              hedl_canonicalize_into(c->doc, c->buf, c->cap, &needed))
+#if HEDL_BENCH_JSON
+DEFINE_EXPORT(json,
+              hedl_to_json(c->doc, 0, &out),
+              hedl_to_json_callback(c->doc, 0, count_sink, c),
+              hedl_to_json_into(c->doc, 0, c->buf, c->cap, &needed))
+#endif
+#if HEDL_BENCH_YAML
+DEFINE_EXPORT(yaml,
+              hedl_to_yaml(c->doc, 0, &out),
+              hedl_to_yaml_callback(c->doc, 0, count_sink, c),
+              hedl_to_yaml_into(c->doc, 0, c->buf, c->cap, &needed))
+#endif
+#if HEDL_BENCH_XML
+DEFINE_EXPORT(xml,
+              hedl_to_xml(c->doc, &out),
+              hedl_to_xml_callback(c->doc, count_sink, c),
+              hedl_to_xml_into(c->doc, c->buf, c->cap, &needed))
+#endif
+#if HEDL_BENCH_CSV
+DEFINE_EXPORT(csv,
+              hedl_to_csv(c->doc, &out),
+              hedl_to_csv_callback(c->doc, count_sink, c),
+              hedl_to_csv_into(c->doc, c->buf, c->cap, &needed))
+#endif
+#if HEDL_BENCH_NEO4J
+DEFINE_EXPORT(neo4j,
+              hedl_to_neo4j_cypher(c->doc, 1, &out),
+              hedl_to_neo4j_cypher_callback(c->doc, 1, count_sink, c),
+              hedl_to_neo4j_cypher_into(c->doc, 1, c->buf, c->cap, &needed))
+#endif
+
+typedef struct {
+    const char* name;
+    bench_fn alloc;
+    bench_fn callback;
+    bench_fn into;
+    int format;         /* HEDL_FORMAT_* for hedl_estimate_output_size */
+    uint32_t flags;     /* HEDL_EXPORT_* matching the calls above */
+} Exporter;
+
+#define EXPORTER(name, format, flags) \
+    {#name, bench_##name##_alloc, bench_##name##_callback, bench_##name##_into, format, flags}
+
+static const Exporter EXPORTERS[] = {
+    EXPORTER(canonical, HEDL_FORMAT_HEDL, 0),
+#if HEDL_BENCH_JSON
+    EXPORTER(json, HEDL_FORMAT_JSON, 0),
+#endif
+#if HEDL_BENCH_YAML
+    EXPORTER(yaml, HEDL_FORMAT_YAML, 0),
+#endif
+#if HEDL_BENCH_XML
+    EXPORTER(xml, HEDL_FORMAT_XML, 0),
+#endif
+#if HEDL_BENCH_CSV
+    EXPORTER(csv, HEDL_FORMAT_CSV, 0),
+#endif
+#if HEDL_BENCH_NEO4J
+    EXPORTER(neo4j, HEDL_FORMAT_CYPHER, HEDL_EXPORT_CYPHER_MERGE),
+#endif
+};
+
+#define EXPORTER_COUNT ((int)(sizeof(EXPORTERS) / sizeof(EXPORTERS[0])))
+
+/* ============================================================================
+ * Threading Cases
+ * ============================================================================ */
+
+typedef struct {
+    const Ctx* ctx;
+    int status;
+} Worker;
+
+#ifdef _WIN32
+static DWORD WINAPI parse_worker(LPVOID arg) {
+#else
+static void* parse_worker(void* arg) {
+#endif
+    Worker* w = arg;
+    HedlDocument* doc = NULL;
+    w->status = hedl_parse_sized(w->ctx->input, w->ctx->len, 1, 0, &doc);
+    hedl_free_document(doc);
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+/**
+ * c->threads C threads each parse the input once; the sample is the wall
+ * time until all of them finish
+ */
+static int bench_concurrent_parse(void* p, size_t* out_bytes) {
+    Ctx* c = p;
+    Worker workers[64];
+    int n = c->threads < 64 ? c->threads : 64;
+#ifdef _WIN32
+    HANDLE handles[64];
+#else
+    pthread_t handles[64];
+#endif
+    for (int i = 0; i < n; i++) {
+        workers[i].ctx = c;
+        workers[i].status = HEDL_OK;
+#ifdef _WIN32
+        handles[i] = CreateThread(NULL, 0, parse_worker, &workers[i], 0, NULL);
+#else
+        pthread_create(&handles[i], NULL, parse_worker, &workers[i]);
+#endif
+    }
+    int rc = HEDL_OK;
+    for (int i = 0; i < n; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(handles[i], INFINITE);
+        CloseHandle(handles[i]);
+#else
+        pthread_join(handles[i], NULL);
+#endif
+        if (workers[i].status != HEDL_OK && rc == HEDL_OK) {
+            rc = workers[i].status;
+        }
+    }
+    *out_bytes = 0;
+    return rc;
+}
+
+static int bench_parse_batch(void* p, size_t* out_bytes) {
+    Ctx* c = p;
+    const char* inputs[BATCH_DOCS];
+    size_t lens[BATCH_DOCS];
+    HedlDocument* docs[BATCH_DOCS];
+    int codes[BATCH_DOCS];
+    for (int i = 0; i < BATCH_DOCS; i++) {
+        inputs[i] = c->input;
+        lens[i] = c->len;
+    }
+    int rc = hedl_parse_batch(inputs, lens, BATCH_DOCS, 1, docs, codes, NULL, c->threads);
+    for (int i = 0; i < BATCH_DOCS; i++) {
+        hedl_free_document(docs[i]);
+    }
+    *out_bytes = 0;
+    return rc;
+}
+
+static int bench_parse_parallel(void* p, size_t* out_bytes) {
+    Ctx* c = p;
+    HedlDocument* doc = NULL;
+    int rc = hedl_parse_parallel(c->input, c->len, 1, c->threads, &doc);
+    hedl_free_document(doc);
+    *out_bytes = 0;
+    return rc;
+}
+
+/* ============================================================================
+ * Suites
+ * ============================================================================ */
+
+static void run_parse_suite(const Config* cfg) {
+    print_section("Parsing");
+    for (int s = 0; s < SHAPE_COUNT; s++) {
+        for (int z = 0; z < cfg->size_count; z++) {
+            int size = cfg->sizes[z];
+            Buf input = {0};
+            SHAPES[s].generate(&input, size);
+            Ctx ctx = {input.data, input.len, NULL, NULL, 0, 1, 0};
+            char name[96];
+
+            snprintf(name, sizeof(name), "parse/%s/%d", SHAPES[s].name, size);
+            run_case(cfg, "parse", SHAPES[s].name, size, 1, name, bench_parse, &ctx, input.len);
+            snprintf(name, sizeof(name), "parse_lenient/%s/%d", SHAPES[s].name, size);
+            run_case(cfg, "parse", SHAPES[s].name, size, 1, name, bench_parse_lenient, &ctx,
+                     input.len);
+            snprintf(name, sizeof(name), "validate/%s/%d", SHAPES[s].name, size);
+            run_case(cfg, "parse", SHAPES[s].name, size, 1, name, bench_validate, &ctx,
+                     input.len);
+
+            HedlDocument* doc = NULL;
+            uint8_t* snap = NULL;
+            size_t snap_len = 0;
+            if (hedl_parse_sized(input.data, input.len, 1, 0, &doc) == HEDL_OK &&
+                hedl_to_snapshot(doc, &snap, &snap_len) == HEDL_OK) {
+                ctx.buf = (char*)snap;
+                ctx.cap = snap_len;
+                snprintf(name, sizeof(name), "snapshot_load/%s/%d", SHAPES[s].name, size);
+                run_case(cfg, "parse", SHAPES[s].name, size, 1, name, bench_snapshot_load,
+                         &ctx, snap_len);
+                hedl_free_bytes(snap, snap_len);
+            }
+            hedl_free_document(doc);
+            buf_free(&input);
+        }
+    }
+}
+
+static void run_export_suite(const Config* cfg) {
+    static const char* variants[] = {"alloc", "callback", "into"};
+
+    print_section("Export");
+    for (int s = 0; s < SHAPE_COUNT; s++) {
+        for (int z = 0; z < cfg->size_count; z++) {
+            int size = cfg->sizes[z];
+            Buf input = {0};
+            SHAPES[s].generate(&input, size);
+            HedlDocument* doc = NULL;
+            if (hedl_parse_sized(input.data, input.len, 1, 0, &doc) != HEDL_OK) {
+                const char* err = hedl_get_last_error();
+                fprintf(stderr, "skipping %s/%d: %s\n", SHAPES[s].name, size,
+                        err ? err : "parse failed");
+                buf_free(&input);
+                continue;
+            }
+
+            for (int e = 0; e < EXPORTER_COUNT; e++) {
+                Ctx ctx = {input.data, input.len, doc, NULL, 0, 1, 0};
+
+                /* Size the caller buffer from the guaranteed bound so the
+                 * into variant never measures a BUFFER_TOO_SMALL retry */
+                if (hedl_estimate_output_size(doc, EXPORTERS[e].format, EXPORTERS[e].flags,
+                                              &ctx.cap) != HEDL_OK) {
+                    fprintf(stderr, "no size bound for %s\n", EXPORTERS[e].name);
+                    exit(1);
+                }
+                bench_fn fns[3] = {EXPORTERS[e].alloc, EXPORTERS[e].callback,
+                                   EXPORTERS[e].into};
+                ctx.buf = malloc(ctx.cap);
+                if (!ctx.buf) {
+                    fprintf(stderr, "out of memory\n");
+                    exit(1);
+                }
+
+                for (int v = 0; v < 3; v++) {
+                    char name[96];
+                    snprintf(name, sizeof(name), "to_%s/%s/%s/%d", EXPORTERS[e].name,
+                             variants[v], SHAPES[s].name, size);
+                    run_case(cfg, "export", SHAPES[s].name, size, 1, name, fns[v], &ctx,
+                             input.len);
+                }
+                free(ctx.buf);
+            }
+            hedl_free_document(doc);
+            buf_free(&input);
+        }
+    }
+}
+
+static void run_threading_suite(const Config* cfg) {
+    int steps[MAX_THREAD_STEPS];
+    int step_count = 0;
+    for (int t = 1; t <= cfg->max_threads && step_count < MAX_THREAD_STEPS; t *= 2) {
+        steps[step_count++] = t;
+    }
+    if (steps[step_count - 1] != cfg->max_threads && step_count < MAX_THREAD_STEPS) {
+        steps[step_count++] = cfg->max_threads;
+    }
+
+    print_section("Threading");
+
+    /* Concurrent C threads and batch parsing use the largest configured size;
+     * hedl_parse_parallel needs thousands of rows before it splits a list */
+    int size = cfg->sizes[cfg->size_count - 1];
+    int parallel_size = size < 20000 ? 20000 : size;
+    Buf input = {0};
+    Buf large = {0};
+    gen_wide(&input, size);
+    gen_wide(&large, parallel_size);
+
+    for (int i = 0; i < step_count; i++) {
+        int t = steps[i];
+        char name[96];
+        Ctx ctx = {input.data, input.len, NULL, NULL, 0, t, 0};
+
+        snprintf(name, sizeof(name), "concurrent_parse/wide/%d/t%d", size, t);
+        run_case(cfg, "threading", "wide", size, t, name, bench_concurrent_parse, &ctx,
+                 input.len * (size_t)t);
+        snprintf(name, sizeof(name), "parse_batch/wide/%d/t%d", size, t);
+        run_case(cfg, "threading", "wide", size, t, name, bench_parse_batch, &ctx,
+                 input.len * BATCH_DOCS);
+
+        Ctx big = {large.data, large.len, NULL, NULL, 0, t, 0};
+        snprintf(name, sizeof(name), "parse_parallel/wide/%d/t%d", parallel_size, t);
+        run_case(cfg, "threading", "wide", parallel_size, t, name, bench_parse_parallel, &big,
+                 large.len);
+    }
+
+    buf_free(&input);
+    buf_free(&large);
+}
+
+/* ============================================================================
+ * Main
+ * ============================================================================ */
+
+static int parse_sizes(Config* cfg, const char* list) {
+    cfg->size_count = 0;
+    const char* p = list;
+    while (*p && cfg->size_count < MAX_SIZES) {
+        char* end = NULL;
+        long v = strtol(p, &end, 10);
+        if (end == p || v <= 0) {
+            return 0;
+        }
+        cfg->sizes[cfg->size_count++] = (int)v;
+        p = *end == ',' ? end + 1 : end;
+    }
+    return cfg->size_count > 0;
+}
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "usage: %s [--quick] [--reps N] [--warmup N] [--sizes A,B,...]\n"
+            "          [--threads N] [--filter TEXT] [--json FILE]\n", argv0);
+}
+
+int main(int argc, char** argv) {
+    Config cfg = {5, 50, {10, 100, 1000}, 3, cpu_count(), NULL, NULL};
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* val = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(arg, "--quick") == 0) {
+            cfg.warmup = 2;
+            cfg.reps = 10;
+            cfg.sizes[0] = 10;
+            cfg.sizes[1] = 100;
+            cfg.size_count = 2;
+        } else if (strcmp(arg, "--reps") == 0 && val) {
+            cfg.reps = atoi(val);
+            i++;
+        } else if (strcmp(arg, "--warmup") == 0 && val) {
+            cfg.warmup = atoi(val);
+            i++;
+        } else if (strcmp(arg, "--sizes") == 0 && val) {
+            if (!parse_sizes(&cfg, val)) {
+                usage(argv[0]);
+                return 2;
+            }
+            i++;
+        } else if (strcmp(arg, "--threads") == 0 && val) {
+            cfg.max_threads = atoi(val);
+            i++;
+        } else if (strcmp(arg, "--filter") == 0 && val) {
+            cfg.filter = val;
+            i++;
+        } else if (strcmp(arg, "--json") == 0 && val) {
+            cfg.json_path = val;
+            i++;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (cfg.reps < 1 || cfg.warmup < 0 || cfg.max_threads < 1) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    printf("HEDL C API Benchmarks\n");
+    printf("=====================\n\n");
+    printf("warmup %d, reps %d, threads up to %d, sizes", cfg.warmup, cfg.reps,
+           cfg.max_threads);
+    for (int i = 0; i < cfg.size_count; i++) {
+        printf(" %d", cfg.sizes[i]);
+    }
+    printf("\n");
+
+    run_parse_suite(&cfg);
+    run_export_suite(&cfg);
+    run_threading_suite(&cfg);
+
+    int failed = 0;
+    for (size_t i = 0; i < g_result_count; i++) {
+        failed += g_results[i].status != HEDL_OK;
+    }
+    printf("\n%zu cases, %d failed\n", g_result_count, failed);
+
+    int rc = 0;
+    if (cfg.json_path) {
+        rc = write_json(&cfg, cfg.json_path);
+        if (rc == 0) {
+            printf("Results written to %s\n", cfg.json_path);
+        }
+    }
+    free(g_results);
+    return rc;
+}
@@ -0,0 +1,80 @@
+/**
+ * Dweve HEDL - Hierarchical Entity Data Language
+ *
+ * Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file cpp_wrapper.cpp
+ * @brief C++17 wrapper (hedl.hpp) example
+ *
+ * Demonstrates:
+ * - RAII document handles with move semantics
+ * - Zero-copy std::string_view access to exported strings
+ * - Streaming exports into std::ostream and lambda sinks
+ * - Error handling with hedl::Error
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+#include <utility>
+#include "hedl.hpp"
+
+static const char* SAMPLE_HEDL =
+    "%VERSION: 1.0\n"
+    "%STRUCT: User: [id, name, email]\n"
+    "---\n"
+    "users: @User\n"
+    "  | alice, Alice Smith, alice@example.com\n"
+    "  | bob, Bob Jones, bob@example.com\n";
+
+int main() {
+    try {
+        // The handle frees the document when it goes out of scope
+        hedl::Document doc = hedl::Document::parse(SAMPLE_HEDL);
+
+        auto [major, minor] = doc.version();
+        std::cout << "Version: " << major << '.' << minor << '\n';
+        std::cout << "Schemas: " << doc.schema_count() << '\n';
+
+        // Ownership moves; the source handle becomes empty
+        hedl::Document owner = std::move(doc);
+
+        // View the library-allocated buffer without copying it
+        hedl::OwnedString canonical = owner.canonicalize();
+        std::string_view text = canonical.view();
+        std::cout << "\nCanonical (" << text.size() << " bytes):\n" << text << '\n';
+
+        // Stream JSON straight to stdout in 64-byte chunks
+        std::cout << "\nJSON:\n";
+        owner.write_json(hedl::ostream_sink(std::cout), false, 64);
+        std::cout << '\n';
+
+        // Any callable taking std::string_view works as a sink
+        std::size_t chunks = 0;
+        std::size_t bytes = 0;
+        owner.write_canonical([&](std::string_view chunk) {
+            ++chunks;
+            bytes += chunk.size();
+        }, 16);
+        std::cout << "\nCanonical streamed as " << chunks << " chunks, " << bytes << " bytes\n";
+
+        hedl::Diagnostics diagnostics = owner.lint();
+        std::cout << "Lint diagnostics: " << diagnostics.size() << '\n';
+        for (int i = 0; i < diagnostics.size(); i++) {
+            std::cout << "  - " << diagnostics.message(i).view() << '\n';
+        }
+    } catch (const hedl::Error& e) {
+        std::cerr << "HEDL error " << e.code() << ": " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    // Failures surface as exceptions carrying the HEDL error code
+    try {
+        hedl::Document::parse("%VERSION: x\n---\n", true);
+    } catch (const hedl::Error& e) {
+        std::cout << "\nExpected error " << e.code() << ": " << e.what() << '\n';
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,768 @@
+/**
+ * Dweve HEDL - Hierarchical Entity Data Language
+ *
+ * Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file hedl.hpp
+ * @brief Header-only C++17 wrapper over the HEDL C API
+ *
+ * Provides:
+ * - Move-only RAII handles (hedl::Document, hedl::Diagnostics) that free
+ *   themselves, so no hedl_free_* call can be forgotten
+ * - hedl::OwnedString / hedl::OwnedBytes, which keep the buffer allocated by
+ *   HEDL and expose it as std::string_view without copying
+ * - Sink adaptors that stream exporter output into any callable taking a
+ *   std::string_view (lambdas, hedl::ostream_sink) with no per-chunk allocation
+ * - Non-owning views (hedl::Object, hedl::Item, hedl::List, hedl::Node,
+ *   hedl::Value) for reading a parsed document in place
+ * - hedl::Error exceptions carrying the HEDL error code and message
+ *
+ * Example usage:
+ *
+ *   hedl::Document doc = hedl::Document::parse(input);
+ *   hedl::OwnedString json = doc.to_json();
+ *   consume(json.view());                          // no copy
+ *   doc.write_yaml(hedl::ostream_sink(std::cout)); // streamed in chunks
+ *   int64_t age = doc.root().get("users").list().row(0).get_int(2);
+ *
+ * Functions of formats disabled at build time are only referenced when
+ * called, so unused ones do not cause link errors.
+ */
+
+#ifndef HEDL_HPP
+#define HEDL_HPP
+
+#include "hedl.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace hedl {
+
+/* ==========================================================================
+ * Errors
+ * ========================================================================== */
+
+/** Exception thrown when a HEDL call fails. */
+class Error : public std::runtime_error {
+public:
+    Error(int code, const std::string& message) : std::runtime_error(message), code_(code) {}
+
+    /** HEDL error code (one of the HEDL_ERR_* constants). */
+    int code() const noexcept { return code_; }
+
+private:
+    int code_;
+};
+
+namespace detail {
+
+/** Throw the calling thread's last error for a failed call. */
+[[noreturn]] inline void throw_last_error(int code) {
+    const char* message = hedl_get_last_error();
+    throw Error(code, message ? message : "unknown HEDL error");
+}
+
+inline void check(int code) {
+    if (code != HEDL_OK) {
+        throw_last_error(code);
+    }
+}
+
+} // namespace detail
+
+/* ==========================================================================
+ * Owned Buffers
+ * ========================================================================== */
+
+/** Null-terminated string allocated by HEDL, freed with hedl_free_string. */
+class OwnedString {
+public:
+    OwnedString() noexcept = default;
+
+    /** Take ownership of a string returned by a hedl_* function. */
+    explicit OwnedString(char* data) noexcept
+        : data_(data), size_(data ? std::strlen(data) : 0) {}
+
+    OwnedString(OwnedString&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+    OwnedString& operator=(OwnedString&& other) noexcept {
+        if (this != &other) {
+            hedl_free_string(data_);
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    OwnedString(const OwnedString&) = delete;
+    OwnedString& operator=(const OwnedString&) = delete;
+
+    ~OwnedString() { hedl_free_string(data_); }
+
+    std::string_view view() const noexcept { return {data_ ? data_ : "", size_}; }
+    operator std::string_view() const noexcept { return view(); }
+
+    const char* c_str() const noexcept { return data_ ? data_ : ""; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    /** Give up ownership; the caller must call hedl_free_string. */
+    char* release() noexcept {
+        size_ = 0;
+        return std::exchange(data_, nullptr);
+    }
+
+private:
+    char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+/** Byte buffer allocated by HEDL, freed with hedl_free_bytes. */
+class OwnedBytes {
+public:
+    OwnedBytes() noexcept = default;
+
+    /** Take ownership of a buffer returned by a hedl_* function. */
+    OwnedBytes(std::uint8_t* data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+    OwnedBytes(OwnedBytes&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+    OwnedBytes& operator=(OwnedBytes&& other) noexcept {
+        if (this != &other) {
+            hedl_free_bytes(data_, size_);
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    OwnedBytes(const OwnedBytes&) = delete;
+    OwnedBytes& operator=(const OwnedBytes&) = delete;
+
+    ~OwnedBytes() { hedl_free_bytes(data_, size_); }
+
+    const std::uint8_t* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    /** The bytes as a character view, e.g. for writing to a stream. */
+    std::string_view view() const noexcept {
+        return {reinterpret_cast<const char*>(data_), size_};
+    }
+
+private:
+    std::uint8_t* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+/* ==========================================================================
+ * Output Sinks
+ * ========================================================================== */
+
+/**
+ * Sink writing every chunk straight to a std::ostream.
+ * Throws hedl::Error(HEDL_ERR_IO) if the stream enters a failed state.
+ */
+class OstreamSink {
+public:
+    explicit OstreamSink(std::ostream& os) noexcept : os_(&os) {}
+
+    void operator()(std::string_view chunk) const {
+        os_->write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        if (!*os_) {
+            throw Error(HEDL_ERR_IO, "output stream write failed");
+        }
+    }
+
+private:
+    std::ostream* os_;
+};
+
+inline OstreamSink ostream_sink(std::ostream& os) noexcept { return OstreamSink(os); }
+
+namespace detail {
+
+template <class Sink>
+struct SinkState {
+    Sink* sink;
+    std::exception_ptr error;
+};
+
+/**
+ * hedl_output_callback forwarding each chunk to a C++ sink.
+ * Exceptions must not unwind through the library, so the first one is
+ * captured, later chunks are skipped, and stream() rethrows it.
+ */
+template <class Sink>
+void sink_trampoline(const char* data, std::size_t len, void* user_data) noexcept {
+    auto* state = static_cast<SinkState<Sink>*>(user_data);
+    if (state->error) {
+        return;
+    }
+    try {
+        (*state->sink)(std::string_view(data, len));
+    } catch (...) {
+        state->error = std::current_exception();
+    }
+}
+
+/** Run a callback exporter `call(callback, user_data)` into `sink`. */
+template <class Sink, class Call>
+void stream(Sink& sink, Call&& call) {
+    SinkState<Sink> state{&sink, nullptr};
+    int code = call(&sink_trampoline<Sink>, &state);
+    if (state.error) {
+        std::rethrow_exception(state.error);
+    }
+    check(code);
+}
+
+} // namespace detail
+
+/* ==========================================================================
+ * Diagnostics
+ * ========================================================================== */
+
+/** Move-only handle to lint diagnostics. */
+class Diagnostics {
+public:
+    /** Take ownership of a handle returned by hedl_lint. */
+    explicit Diagnostics(HedlDiagnostics* diag) noexcept : diag_(diag) {}
+
+    Diagnostics(Diagnostics&& other) noexcept : diag_(std::exchange(other.diag_, nullptr)) {}
+
+    Diagnostics& operator=(Diagnostics&& other) noexcept {
+        if (this != &other) {
+            hedl_free_diagnostics(diag_);
+            diag_ = std::exchange(other.diag_, nullptr);
+        }
+        return *this;
+    }
+
+    Diagnostics(const Diagnostics&) = delete;
+    Diagnostics& operator=(const Diagnostics&) = delete;
+
+    ~Diagnostics() { hedl_free_diagnostics(diag_); }
+
+    int size() const noexcept {
+        int count = hedl_diagnostics_count(diag_);
+        return count < 0 ? 0 : count;
+    }
+
+    OwnedString message(int index) const {
+        char* out = nullptr;
+        detail::check(hedl_diagnostics_get(diag_, index, &out));
+        return OwnedString(out);
+    }
+
+    /** Severity of a diagnostic (0=Hint, 1=Warning, 2=Error). */
+    int severity(int index) const {
+        int severity = hedl_diagnostics_severity(diag_, index);
+        if (severity < 0) {
+            throw Error(HEDL_ERR_NULL_PTR, "diagnostic index out of range");
+        }
+        return severity;
+    }
+
+    const HedlDiagnostics* get() const noexcept { return diag_; }
+
+private:
+    HedlDiagnostics* diag_;
+};
+
+/* ==========================================================================
+ * Document Traversal
+ * ========================================================================== */
+
+namespace detail {
+
+inline std::string_view view(const char* ptr, std::size_t len) noexcept {
+    return ptr ? std::string_view(ptr, len) : std::string_view();
+}
+
+/** Traversal accessors do not set the last error, so describe the code. */
+inline void check_access(int code) {
+    switch (code) {
+    case HEDL_OK:
+        return;
+    case HEDL_ERR_NOT_FOUND:
+        throw Error(code, "no such entry");
+    case HEDL_ERR_TYPE_MISMATCH:
+        throw Error(code, "value has a different type");
+    case HEDL_ERR_INVALID_UTF8:
+        throw Error(code, "key is not valid UTF-8");
+    default:
+        throw Error(code, "invalid traversal handle");
+    }
+}
+
+} // namespace detail
+
+/*
+ * The traversal views below borrow from their Document: they are cheap to
+ * copy, never free anything, and must not outlive the document.
+ */
+
+/** View of a value (HedlValueView); string members point into the document. */
+class Value {
+public:
+    explicit Value(const HedlValueView& view) noexcept : view_(view) {}
+
+    /** One of the HEDL_VALUE_* constants. */
+    int kind() const noexcept { return view_.kind; }
+    bool is_null() const noexcept { return view_.kind == HEDL_VALUE_NULL; }
+
+    bool as_bool() const { return expect(HEDL_VALUE_BOOL).bool_value != 0; }
+    std::int64_t as_int() const { return expect(HEDL_VALUE_INT).int_value; }
+    double as_float() const {
+        if (view_.kind == HEDL_VALUE_INT) {
+            return static_cast<double>(view_.int_value);
+        }
+        return expect(HEDL_VALUE_FLOAT).float_value;
+    }
+    std::string_view as_string() const {
+        const HedlValueView& v = expect(HEDL_VALUE_STRING);
+        return detail::view(v.str_ptr, v.str_len);
+    }
+
+    /** Target ID of a reference. */
+    std::string_view ref_id() const {
+        const HedlValueView& v = expect(HEDL_VALUE_REFERENCE);
+        return detail::view(v.str_ptr, v.str_len);
+    }
+    /** Qualifying type of a reference (empty for local references). */
+    std::string_view ref_type() const {
+        const HedlValueView& v = expect(HEDL_VALUE_REFERENCE);
+        return detail::view(v.ref_type_ptr, v.ref_type_len);
+    }
+
+    const HedlValueView& get() const noexcept { return view_; }
+
+private:
+    const HedlValueView& expect(int kind) const {
+        if (view_.kind != kind) {
+            throw Error(HEDL_ERR_TYPE_MISMATCH, "value has a different kind");
+        }
+        return view_;
+    }
+
+    HedlValueView view_;
+};
+
+/** View of a node (a list row or a nested child). */
+class Node {
+public:
+    explicit Node(const HedlNode* node) noexcept : node_(node) {}
+
+    std::string_view id() const {
+        const char* ptr = nullptr;
+        std::size_t len = 0;
+        detail::check_access(hedl_node_id(node_, &ptr, &len));
+        return detail::view(ptr, len);
+    }
+
+    std::string_view type_name() const {
+        const char* ptr = nullptr;
+        std::size_t len = 0;
+        detail::check_access(hedl_node_type_name(node_, &ptr, &len));
+        return detail::view(ptr, len);
+    }
+
+    std::size_t field_count() const noexcept { return hedl_node_field_count(node_); }
+
+    Value field(std::size_t index) const {
+        HedlValueView view{};
+        detail::check_access(hedl_node_field(node_, index, &view));
+        return Value(view);
+    }
+
+    // Typed getters throw hedl::Error (HEDL_ERR_TYPE_MISMATCH) on a kind mismatch.
+
+    std::int64_t get_int(std::size_t index) const {
+        std::int64_t out = 0;
+        detail::check_access(hedl_node_field_int(node_, index, &out));
+        return out;
+    }
+
+    double get_float(std::size_t index) const {
+        double out = 0.0;
+        detail::check_access(hedl_node_field_float(node_, index, &out));
+        return out;
+    }
+
+    bool get_bool(std::size_t index) const {
+        int out = 0;
+        detail::check_access(hedl_node_field_bool(node_, index, &out));
+        return out != 0;
+    }
+
+    std::string_view get_string(std::size_t index) const {
+        const char* ptr = nullptr;
+        std::size_t len = 0;
+        detail::check_access(hedl_node_field_string(node_, index, &ptr, &len));
+        return detail::view(ptr, len);
+    }
+
+    /** Child at index within a type group; throws if there is none. */
+    Node child(std::string_view type_name, std::size_t index) const {
+        const HedlNode* child = hedl_node_child(node_, type_name.data(), type_name.size(), index);
+        if (!child) {
+            throw Error(HEDL_ERR_NOT_FOUND, "no such child node");
+        }
+        return Node(child);
+    }
+
+    const HedlNode* get() const noexcept { return node_; }
+
+private:
+    const HedlNode* node_;
+};
+
+/** View of a matrix list. */
+class List {
+public:
+    explicit List(const HedlList* list) noexcept : list_(list) {}
+
+    std::string_view type_name() const {
+        const char* ptr = nullptr;
+        std::size_t len = 0;
+        detail::check_access(hedl_list_type_name(list_, &ptr, &len));
+        return detail::view(ptr, len);
+    }
+
+    std::size_t column_count() const noexcept { return hedl_list_column_count(list_); }
+
+    std::string_view column(std::size_t index) const {
+        const char* ptr = nullptr;
+        std::size_t len = 0;
+        detail::check_access(hedl_list_column(list_, index, &ptr, &len));
+        return detail::view(ptr, len);
+    }
+
+    /** Index of a schema column; resolve once, then read fields by index. */
+    std::size_t column_index(std::string_view name) const {
+        std::size_t index = 0;
+        detail::check_access(hedl_list_column_index(list_, name.data(), name.size(), &index));
+        return index;
+    }
+
+    std::size_t size() const noexcept { return hedl_list_row_count(list_); }
+
+    Node row(std::size_t index) const {
+        const HedlNode* node = hedl_list_row(list_, index);
+        if (!node) {
+            throw Error(HEDL_ERR_NOT_FOUND, "row index out of range");
+        }
+        return Node(node);
+    }
+
+    const HedlList* get() const noexcept { return list_; }
+
+private:
+    const HedlList* list_;
+};
+
+class Object;
+
+/** View of an item: a scalar, a nested object or a matrix list. */
+class Item {
+public:
+    explicit Item(const HedlItem* item) noexcept : item_(item) {}
+
+    /** One of the HEDL_ITEM_* constants. */
+    int kind() const noexcept { return hedl_item_kind(item_); }
+
+    Value value() const {
+        HedlValueView view{};
+        detail::check_access(hedl_item_value(item_, &view));
+        return Value(view);
+    }
+
+    inline Object object() const;
+
+    List list() const {
+        const HedlList* list = hedl_item_list(item_);
+        if (!list) {
+            throw Error(HEDL_ERR_TYPE_MISMATCH, "item is not a list");
+        }
+        return List(list);
+    }
+
+    const HedlItem* get() const noexcept { return item_; }
+
+private:
+    const HedlItem* item_;
+};
+
+/** View of a map of named items (the document root or a nested object). */
+class Object {
+public:
+    explicit Object(const HedlObject* obj) noexcept : obj_(obj) {}
+
+    std::size_t size() const noexcept { return hedl_object_len(obj_); }
+
+    /** Item under key; throws hedl::Error (HEDL_ERR_NOT_FOUND) if absent. */
+    Item get(std::string_view key) const {
+        const HedlItem* item = nullptr;
+        detail::check_access(hedl_object_get(obj_, key.data(), key.size(), &item));
+        return Item(item);
+    }
+
+    bool contains(std::string_view key) const noexcept {
+        const HedlItem* item = nullptr;
+        return hedl_object_get(obj_, key.data(), key.size(), &item) == HEDL_OK;
+    }
+
+    /** Call fn(std::string_view key, hedl::Item item) for every entry in key order. */
+    template <class Fn>
+    void for_each(Fn&& fn) const {
+        const char* key = nullptr;
+        std::size_t len = 0;
+        const HedlItem* item = nullptr;
+        while (hedl_object_next(obj_, key, len, &key, &len, &item) == HEDL_OK) {
+            fn(std::string_view(key, len), Item(item));
+        }
+    }
+
+    const HedlObject* get() const noexcept { return obj_; }
+
+private:
+    const HedlObject* obj_;
+};
+
+inline Object Item::object() const {
+    const HedlObject* obj = hedl_item_object(item_);
+    if (!obj) {
+        throw Error(HEDL_ERR_TYPE_MISMATCH, "item is not an object");
+    }
+    return Object(obj);
+}
+
+/* ==========================================================================
+ * Document
+ * ========================================================================== */
+
+/** Move-only handle to a parsed HEDL document. */
+class Document {
+public:
+    /**
+     * Parse a HEDL document. The input is read in place, not copied.
+     * max_size is the largest accepted input in bytes; 0 keeps the 1 GB default.
+     */
+    static Document parse(std::string_view input, bool strict = false, size_t max_size = 0) {
+        HedlDocument* doc = nullptr;
+        detail::check(
+            hedl_parse_sized(input.data(), input.size(), strict ? 1 : 0, max_size, &doc));
+        return Document(doc);
+    }
+
+    static Document from_json(std::string_view json) {
+        HedlDocument* doc = nullptr;
+        detail::check(hedl_from_json_sized(json.data(), json.size(), &doc));
+        return Document(doc);
+    }
+
+    static Document from_yaml(std::string_view yaml) {
+        HedlDocument* doc = nullptr;
+        detail::check(hedl_from_yaml_sized(yaml.data(), yaml.size(), &doc));
+        return Document(doc);
+    }
+
+    static Document from_xml(std::string_view xml) {
+        HedlDocument* doc = nullptr;
+        detail::check(hedl_from_xml_sized(xml.data(), xml.size(), &doc));
+        return Document(doc);
+    }
+
+    static Document from_parquet(const std::uint8_t* data, std::size_t len) {
+        HedlDocument* doc = nullptr;
+        detail::check(hedl_from_parquet(data, len, &doc));
+        return Document(doc);
+    }
+
+    /** Take ownership of a handle returned by a hedl_* function. */
+    explicit Document(HedlDocument* doc) noexcept : doc_(doc) {}
+
+    Document(Document&& other) noexcept : doc_(std::exchange(other.doc_, nullptr)) {}
+
+    Document& operator=(Document&& other) noexcept {
+        if (this != &other) {
+            hedl_free_document(doc_);
+            doc_ = std::exchange(other.doc_, nullptr);
+        }
+        return *this;
+    }
+
+    Document(const Document&) = delete;
+    Document& operator=(const Document&) = delete;
+
+    ~Document() { hedl_free_document(doc_); }
+
+    const HedlDocument* get() const noexcept { return doc_; }
+
+    /** Give up ownership; the caller must call hedl_free_document. */
+    HedlDocument* release() noexcept { return std::exchange(doc_, nullptr); }
+
+    // ----- Document information -----
+
+    std::pair<int, int> version() const {
+        int major = 0;
+        int minor = 0;
+        detail::check(hedl_get_version(doc_, &major, &minor));
+        return {major, minor};
+    }
+
+    int schema_count() const noexcept { return hedl_schema_count(doc_); }
+    int alias_count() const noexcept { return hedl_alias_count(doc_); }
+    int root_item_count() const noexcept { return hedl_root_item_count(doc_); }
+
+    /** Root object, for reading the document in place. */
+    Object root() const noexcept { return Object(hedl_document_root(doc_)); }
+
+    /** Node of a type with an ID (hashed lookup); throws if there is none. */
+    Node find_node(std::string_view type_name, std::string_view id) const {
+        const HedlNode* node = nullptr;
+        detail::check_access(hedl_find_node(doc_, type_name.data(), type_name.size(),
+                                            id.data(), id.size(), &node));
+        return Node(node);
+    }
+
+    /** Target of a key-value reference; throws if it names no single node. */
+    Node resolve(const Value& reference) const {
+        const HedlNode* node = nullptr;
+        detail::check_access(hedl_resolve_reference(doc_, &reference.get(), nullptr, &node));
+        return Node(node);
+    }
+
+    /** Target of a reference read from context's fields. */
+    Node resolve(const Value& reference, const Node& context) const {
+        const HedlNode* node = nullptr;
+        detail::check_access(
+            hedl_resolve_reference(doc_, &reference.get(), context.get(), &node));
+        return Node(node);
+    }
+
+    // ----- Owned-buffer exports -----
+
+    OwnedString canonicalize() const {
+        char* out = nullptr;
+        detail::check(hedl_canonicalize(doc_, &out));
+        return OwnedString(out);
+    }
+
+    OwnedString to_json(bool include_metadata = false) const {
+        char* out = nullptr;
+        detail::check(hedl_to_json(doc_, include_metadata ? 1 : 0, &out));
+        return OwnedString(out);
+    }
+
+    OwnedString to_yaml(bool include_metadata = false) const {
+        char* out = nullptr;
+        detail::check(hedl_to_yaml(doc_, include_metadata ? 1 : 0, &out));
+        return OwnedString(out);
+    }
+
+    OwnedString to_xml() const {
+        char* out = nullptr;
+        detail::check(hedl_to_xml(doc_, &out));
+        return OwnedString(out);
+    }
+
+    OwnedString to_csv() const {
+        char* out = nullptr;
+        detail::check(hedl_to_csv(doc_, &out));
+        return OwnedString(out);
+    }
+
+    OwnedString to_neo4j_cypher(bool use_merge = false) const {
+        char* out = nullptr;
+        detail::check(hedl_to_neo4j_cypher(doc_, use_merge ? 1 : 0, &out));
+        return OwnedString(out);
+    }
+
+    OwnedBytes to_parquet() const {
+        std::uint8_t* data = nullptr;
+        std::size_t len = 0;
+        detail::check(hedl_to_parquet(doc_, &data, &len));
+        return OwnedBytes(data, len);
+    }
+
+    // ----- Streaming exports -----
+    //
+    // `sink` is any callable taking std::string_view. It is invoked once per
+    // chunk of at most chunk_size bytes (0 selects HEDL_DEFAULT_CHUNK_SIZE);
+    // the view is only valid during the call. An exception thrown by the sink
+    // stops further delivery and is rethrown once the export returns.
+
+    template <class Sink>
+    void write_canonical(Sink&& sink, std::size_t chunk_size = 0) const {
+        detail::stream(sink, [&](hedl_output_callback cb, void* user_data) {
+            return hedl_canonicalize_callback_chunked(doc_, chunk_size, cb, user_data);
+        });
+    }
+
+    template <class Sink>
+    void write_json(Sink&& sink, bool include_metadata = false, std::size_t chunk_size = 0) const {
+        detail::stream(sink, [&](hedl_output_callback cb, void* user_data) {
+            return hedl_to_json_callback_chunked(
+                doc_, include_metadata ? 1 : 0, chunk_size, cb, user_data);
+        });
+    }
+
+    template <class Sink>
+    void write_yaml(Sink&& sink, bool include_metadata = false, std::size_t chunk_size = 0) const {
+        detail::stream(sink, [&](hedl_output_callback cb, void* user_data) {
+            return hedl_to_yaml_callback_chunked(
+                doc_, include_metadata ? 1 : 0, chunk_size, cb, user_data);
+        });
+    }
+
+    template <class Sink>
+    void write_xml(Sink&& sink, std::size_t chunk_size = 0) const {
+        detail::stream(sink, [&](hedl_output_callback cb, void* user_data) {
+            return hedl_to_xml_callback_chunked(doc_, chunk_size, cb, user_data);
+        });
+    }
+
+    template <class Sink>
+    void write_csv(Sink&& sink, std::size_t chunk_size = 0) const {
+        detail::stream(sink, [&](hedl_output_callback cb, void* user_data) {
+            return hedl_to_csv_callback_chunked(doc_, chunk_size, cb, user_data);
+        });
+    }
+
+    template <class Sink>
+    void write_neo4j_cypher(Sink&& sink, bool use_merge = false, std::size_t chunk_size = 0) const {
+        detail::stream(sink, [&](hedl_output_callback cb, void* user_data) {
+            return hedl_to_neo4j_cypher_callback_chunked(
+                doc_, use_merge ? 1 : 0, chunk_size, cb, user_data);
+        });
+    }
+
+    // ----- Linting -----
+
+    Diagnostics lint() const {
+        HedlDiagnostics* diag = nullptr;
+        detail::check(hedl_lint(doc_, &diag));
+        return Diagnostics(diag);
+    }
+
+private:
+    HedlDocument* doc_;
+};
+
+} // namespace hedl
+
+#endif /* HEDL_HPP */
@@ -23,6 +23,7 @@
 //! - Memory management overhead
 //! - Cross-language data transfer
 //! - All 16 audited FFI functions tested
+//! - Audit logging cost with the audit target disabled vs enabled
 //!
 //! Run with: cargo bench --package hedl-bench --bench ffi
 
@@ -812,7 +813,110 @@ fn bench_ffi_error_handling(c: &mut Criterion) {
 }
 
 // ============================================================================
-// 8. Export Reports
+// 8. Audit Overhead
+// ============================================================================
+
+/// Subscriber that accepts every event and formats its fields into a
+/// throwaway buffer, so the enabled case pays formatting but not I/O.
+struct DiscardSubscriber;
+
+struct DiscardVisitor(String);
+
+impl tracing::field::Visit for DiscardVisitor {
+    fn record_debug(&mut self, _field: &tracing::field::Field, value: &dyn std::fmt::Debug) {
+        use std::fmt::Write;
+        let _ = write!(self.0, "{:?}", value);
+    }
+}
+
+impl tracing::Subscriber for DiscardSubscriber {
+    fn enabled(&self, _metadata: &tracing::Metadata<'_>) -> bool {
+        true
+    }
+
+    fn new_span(&self, _span: &tracing::span::Attributes<'_>) -> tracing::span::Id {
+        tracing::span::Id::from_u64(1)
+    }
+
+    fn record(&self, _span: &tracing::span::Id, _values: &tracing::span::Record<'_>) {}
+
+    fn record_follows_from(&self, _span: &tracing::span::Id, _follows: &tracing::span::Id) {}
+
+    fn event(&self, event: &tracing::Event<'_>) {
+        let mut visitor = DiscardVisitor(String::new());
+        event.record(&mut visitor);
+        black_box(visitor.0);
+    }
+
+    fn enter(&self, _span: &tracing::span::Id) {}
+
+    fn exit(&self, _span: &tracing::span::Id) {}
+}
+
+/// Benchmark audit logging cost with the audit target disabled vs enabled.
+///
+/// No subscriber is installed by default, so the "disabled" cases show what
+/// every FFI call pays when nobody listens; it should match the bare hooks
+/// at a few nanoseconds and leave `hedl_parse` level with native parsing.
+fn bench_ffi_audit_overhead(c: &mut Criterion) {
+    use hedl_ffi::audit::{audit_call_success, sanitize_pointer, AuditTimer};
+    use hedl_ffi::audit_start;
+
+    ensure_init();
+    let mut group = c.benchmark_group("ffi_audit_overhead");
+
+    let hedl = CString::new("%VERSION: 1.0\n---\nname: Alice\n").unwrap();
+    let input = hedl.as_ptr();
+
+    let audit_hooks = || {
+        let start = AuditTimer::start();
+        audit_start!(
+            "bench_audit",
+            "input_ptr" => sanitize_pointer(black_box(input)),
+            "input_len" => (-1).to_string(),
+        );
+        audit_call_success("bench_audit", start.elapsed());
+    };
+    let parse = || unsafe {
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        let result = hedl_parse(black_box(input), -1, 0, &mut doc);
+        assert_eq!(result, HEDL_OK);
+        hedl_free_document(doc);
+    };
+
+    group.bench_function("hooks_disabled", |b| b.iter(audit_hooks));
+    group.bench_function("parse_native", |b| {
+        b.iter(|| hedl_core::parse(black_box(hedl.as_bytes())).unwrap())
+    });
+    group.bench_function("parse_audit_disabled", |b| b.iter(parse));
+
+    tracing::subscriber::with_default(DiscardSubscriber, || {
+        group.bench_function("hooks_enabled", |b| b.iter(audit_hooks));
+        group.bench_function("parse_audit_enabled", |b| b.iter(parse));
+    });
+
+    group.finish();
+
+    // Metrics
+    let iterations = 10_000u64;
+    let measure = |f: &dyn Fn()| {
+        let start = std::time::Instant::now();
+        for _ in 0..iterations {
+            f();
+        }
+        start.elapsed().as_nanos() as u64
+    };
+
+    record_perf("audit_hooks_disabled", measure(&audit_hooks), iterations, None);
+    record_perf("audit_parse_disabled", measure(&parse), iterations, None);
+    tracing::subscriber::with_default(DiscardSubscriber, || {
+        record_perf("audit_hooks_enabled", measure(&audit_hooks), iterations, None);
+        record_perf("audit_parse_enabled", measure(&parse), iterations, None);
+    });
+}
+
+// ============================================================================
+// 9. Export Reports
 // ============================================================================
 
 use hedl_bench::{CustomTable, Insight, TableCell};
@@ -2094,6 +2198,7 @@ criterion_group! {
         bench_ffi_large_buffers,
         bench_ffi_struct_marshaling,
         bench_ffi_error_handling,
+        bench_ffi_audit_overhead,
         export_reports
 }
 
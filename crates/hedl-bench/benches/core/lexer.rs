@@ -25,7 +25,10 @@ use hedl_bench::{
     generate_users, generate_products, generate_blog, sizes,
     BenchmarkReport, PerfResult,
 };
-use hedl_core::lex::{parse_expression, parse_reference, scan_regions};
+use hedl_core::lex::{
+    calculate_indent, parse_csv_row, parse_csv_row_ref, parse_expression, parse_reference,
+    scan_regions,
+};
 use std::cell::RefCell;
 use std::time::Instant;
 
@@ -42,7 +45,7 @@ fn ensure_init() {
             let mut report = BenchmarkReport::new("HEDL Lexer Performance Report");
             report.set_timestamp();
             report.add_note("Tokenization and lexical analysis performance");
-            report.add_note("Tests reference parsing, expression parsing, and region scanning");
+            report.add_note("Tests references, expressions, regions, matrix rows and indentation");
             report.add_note("Includes error recovery and span tracking benchmarks");
             *r.borrow_mut() = Some(report);
         });
@@ -260,6 +263,117 @@ fn bench_scan_complex_documents(c: &mut Criterion) {
     group.finish();
 }
 
+// ============================================================================
+// Matrix Row Benchmarks
+// ============================================================================
+
+const ROW_CASES: &[(&str, &str)] = &[
+    ("plain", "u123456, Alice Smith, alice@example.com, 42, true, 1234.5, @Team:eng"),
+    ("numeric_wide", "1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20"),
+    ("quoted", r#"p1, "Widget, large", "said ""hi""", "C:\\temp", "plain quoted""#),
+    ("expression_tensor", "p2, $(price * (1 + tax)), [[1, 2], [3, 4]], [0.5, 0.25]"),
+];
+
+fn bench_parse_csv_row(c: &mut Criterion) {
+    let mut group = c.benchmark_group("parse_csv_row");
+
+    for (name, input) in ROW_CASES {
+        group.throughput(Throughput::Bytes(input.len() as u64));
+        group.bench_function(BenchmarkId::new("owned", name), |b| {
+            b.iter(|| parse_csv_row(black_box(input)))
+        });
+        group.bench_function(BenchmarkId::new("borrowed", name), |b| {
+            b.iter(|| parse_csv_row_ref(black_box(input)))
+        });
+
+        // Collect metrics
+        let iterations = 10_000u64;
+        let mut total_ns = 0u64;
+        for _ in 0..iterations {
+            let start = Instant::now();
+            let _ = parse_csv_row_ref(input);
+            total_ns += start.elapsed().as_nanos() as u64;
+        }
+        record_perf(
+            &format!("parse_csv_row_{}", name),
+            iterations,
+            total_ns,
+            Some(input.len() as u64),
+        );
+    }
+
+    // Every row of a generated document, as the parser sees them
+    let hedl = generate_users(sizes::MEDIUM);
+    let rows: Vec<&str> = hedl
+        .lines()
+        .filter_map(|line| line.trim_start().strip_prefix('|'))
+        .collect();
+    let bytes: u64 = rows.iter().map(|row| row.len() as u64).sum();
+
+    group.throughput(Throughput::Bytes(bytes));
+    group.bench_function(BenchmarkId::new("users_rows", sizes::MEDIUM), |b| {
+        b.iter(|| {
+            for row in &rows {
+                let _ = parse_csv_row_ref(black_box(row));
+            }
+        })
+    });
+
+    let iterations = 100u64;
+    let mut total_ns = 0u64;
+    for _ in 0..iterations {
+        let start = Instant::now();
+        for row in &rows {
+            let _ = parse_csv_row_ref(row);
+        }
+        total_ns += start.elapsed().as_nanos() as u64;
+    }
+    record_perf(
+        &format!("parse_csv_row_users_{}", sizes::MEDIUM),
+        iterations,
+        total_ns,
+        Some(bytes),
+    );
+
+    group.finish();
+}
+
+// ============================================================================
+// Indentation Benchmarks
+// ============================================================================
+
+fn bench_calculate_indent(c: &mut Criterion) {
+    let mut group = c.benchmark_group("calculate_indent");
+
+    let test_cases = vec![
+        ("flat", "name: Alice".to_string()),
+        ("row", "  | alice, Alice".to_string()),
+        ("nested", format!("{}| o1, 9.5", " ".repeat(8))),
+        ("deep", format!("{}key: value", " ".repeat(40))),
+    ];
+
+    for (name, input) in &test_cases {
+        group.bench_function(*name, |b| b.iter(|| calculate_indent(black_box(input), 1)));
+
+        // Collect metrics
+        let iterations = 10_000u64;
+        let mut total_ns = 0u64;
+        for _ in 0..iterations {
+            let start = Instant::now();
+            let _ = calculate_indent(input, 1);
+            total_ns += start.elapsed().as_nanos() as u64;
+        }
+        record_perf(
+            &format!("calculate_indent_{}", name),
+            iterations,
+            total_ns,
+            Some(input.len() as u64),
+        );
+    }
+
+    group.finish();
+}
+
 // ============================================================================
 // Report Export
 // ============================================================================
@@ -322,6 +436,8 @@ criterion_group! {
         bench_scan_regions,
         bench_scan_documents,
         bench_scan_complex_documents,
+        bench_parse_csv_row,
+        bench_calculate_indent,
         export_reports
 }
 
@@ -0,0 +1,308 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//! Canonical content digests.
+//!
+//! Hashes the canonical form of a document without building it: the
+//! [`CanonicalWriter`] streams into an incremental hasher in bounded chunks,
+//! so a fingerprint costs one serialization pass and no output allocation.
+//! The document digest equals the digest of [`canonicalize_with_config`]'s
+//! output under the same configuration.
+//!
+//! [`canonical_digests`] additionally hashes each root entry's canonical lines
+//! on their own, in the same pass. Entry digests do not depend on the rest of
+//! the document, so equal digests under equal keys in two documents mean that
+//! entry is unchanged.
+//!
+//! [`canonicalize_with_config`]: crate::canonicalize_with_config
+
+use crate::config::CanonicalConfig;
+use crate::writer::CanonicalWriter;
+use hedl_core::{Document, HedlError};
+use std::cell::RefCell;
+use std::fmt;
+use std::io;
+use xxhash_rust::xxh3::Xxh3Default;
+
+/// Buffered canonical output handed to the hasher at a time.
+const DIGEST_CHUNK_SIZE: usize = 64 * 1024;
+
+/// Length of the longest supported digest, in bytes.
+pub const MAX_DIGEST_LEN: usize = 32;
+
+/// Hash function used for canonical digests.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+pub enum DigestAlgorithm {
+    /// BLAKE3, 32-byte digest. Cryptographic; use for content addressing.
+    Blake3,
+    /// XXH3 128-bit, 16-byte digest. Not collision resistant against
+    /// adversarial input, but several times faster; use for cache keys.
+    Xxh3_128,
+}
+
+impl DigestAlgorithm {
+    /// Length of this algorithm's digests, in bytes.
+    pub fn digest_len(self) -> usize {
+        match self {
+            Self::Blake3 => 32,
+            Self::Xxh3_128 => 16,
+        }
+    }
+}
+
+/// A digest produced by [`canonical_digest`] or [`canonical_digests`].
+#[derive(Clone, Copy, PartialEq, Eq, Hash)]
+pub struct Digest {
+    bytes: [u8; MAX_DIGEST_LEN],
+    len: usize,
+}
+
+impl Digest {
+    /// The digest bytes (`digest_len()` of the algorithm that produced it).
+    pub fn as_bytes(&self) -> &[u8] {
+        &self.bytes[..self.len]
+    }
+
+    fn from_slice(bytes: &[u8]) -> Self {
+        let mut digest = Self {
+            bytes: [0; MAX_DIGEST_LEN],
+            len: bytes.len(),
+        };
+        digest.bytes[..bytes.len()].copy_from_slice(bytes);
+        digest
+    }
+}
+
+impl fmt::Display for Digest {
+    /// Lowercase hex.
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        for byte in self.as_bytes() {
+            write!(f, "{:02x}", byte)?;
+        }
+        Ok(())
+    }
+}
+
+impl fmt::Debug for Digest {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        write!(f, "Digest({})", self)
+    }
+}
+
+/// Digests of a whole document and of each of its root entries.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct DocumentDigests {
+    /// Digest of the full canonical output.
+    pub document: Digest,
+    /// Digest of each root entry's canonical lines, sorted by key.
+    pub entries: Vec<(String, Digest)>,
+}
+
+impl DocumentDigests {
+    /// Digest of the root entry `key`, if the document has one.
+    pub fn get(&self, key: &str) -> Option<&Digest> {
+        self.entries
+            .binary_search_by(|(k, _)| k.as_str().cmp(key))
+            .ok()
+            .map(|i| &self.entries[i].1)
+    }
+}
+
+/// Incremental hasher for one of the supported algorithms.
+enum Hasher {
+    Blake3(Box<blake3::Hasher>),
+    Xxh3(Box<Xxh3Default>),
+}
+
+impl Hasher {
+    fn new(algorithm: DigestAlgorithm) -> Self {
+        match algorithm {
+            DigestAlgorithm::Blake3 => Self::Blake3(Box::new(blake3::Hasher::new())),
+            DigestAlgorithm::Xxh3_128 => Self::Xxh3(Box::new(Xxh3Default::new())),
+        }
+    }
+
+    fn update(&mut self, data: &[u8]) {
+        match self {
+            Self::Blake3(hasher) => {
+                hasher.update(data);
+            }
+            Self::Xxh3(hasher) => hasher.update(data),
+        }
+    }
+
+    fn digest(&self) -> Digest {
+        match self {
+            Self::Blake3(hasher) => Digest::from_slice(hasher.finalize().as_bytes()),
+            // Canonical XXH128 byte order is big-endian
+            Self::Xxh3(hasher) => Digest::from_slice(&hasher.digest128().to_be_bytes()),
+        }
+    }
+
+    fn reset(&mut self) {
+        match self {
+            Self::Blake3(hasher) => {
+                hasher.reset();
+            }
+            Self::Xxh3(hasher) => hasher.reset(),
+        }
+    }
+}
+
+impl io::Write for Hasher {
+    fn write(&mut self, data: &[u8]) -> io::Result<usize> {
+        self.update(data);
+        Ok(data.len())
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        Ok(())
+    }
+}
+
+/// Hash the canonical form of `doc` without materializing it.
+///
+/// # Errors
+///
+/// The same errors as [`canonicalize_with_config`](crate::canonicalize_with_config).
+///
+/// # Examples
+///
+/// ```no_run
+/// use hedl_c14n::{canonical_digest, CanonicalConfig, DigestAlgorithm};
+/// use hedl_core::Document;
+///
+/// # fn example(doc: Document) -> Result<(), hedl_core::HedlError> {
+/// let digest = canonical_digest(&doc, &CanonicalConfig::default(), DigestAlgorithm::Blake3)?;
+/// println!("{}", digest);
+/// # Ok(())
+/// # }
+/// ```
+pub fn canonical_digest(
+    doc: &Document,
+    config: &CanonicalConfig,
+    algorithm: DigestAlgorithm,
+) -> Result<Digest, HedlError> {
+    let mut hasher = Hasher::new(algorithm);
+    crate::canonicalize_to_writer(doc, config, &mut hasher, DIGEST_CHUNK_SIZE)?;
+    Ok(hasher.digest())
+}
+
+/// Hash the canonical form of `doc` and of each root entry in one pass.
+///
+/// `document` matches [`canonical_digest`]; each entry digest covers the
+/// lines that entry contributes to the canonical body.
+///
+/// # Errors
+///
+/// The same errors as [`canonicalize_with_config`](crate::canonicalize_with_config).
+pub fn canonical_digests(
+    doc: &Document,
+    config: &CanonicalConfig,
+    algorithm: DigestAlgorithm,
+) -> Result<DocumentDigests, HedlError> {
+    let hashers = RefCell::new((Hasher::new(algorithm), Hasher::new(algorithm)));
+    let mut entries = Vec::with_capacity(doc.root.len());
+
+    let mut sink = TeeSink(&hashers);
+    let mut writer = CanonicalWriter::with_sink(config.clone(), &mut sink, DIGEST_CHUNK_SIZE);
+    writer.write_document_marked(doc, |key| {
+        let (_, entry) = &mut *hashers.borrow_mut();
+        if let Some(key) = key {
+            entries.push((key.to_string(), entry.digest()));
+        }
+        entry.reset();
+    })?;
+    drop(writer);
+
+    let document = hashers.borrow().0.digest();
+    Ok(DocumentDigests { document, entries })
+}
+
+/// Feeds the document hasher and the current entry's hasher together.
+struct TeeSink<'a>(&'a RefCell<(Hasher, Hasher)>);
+
+impl io::Write for TeeSink<'_> {
+    fn write(&mut self, data: &[u8]) -> io::Result<usize> {
+        let (document, entry) = &mut *self.0.borrow_mut();
+        document.update(data);
+        entry.update(data);
+        Ok(data.len())
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        Ok(())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::canonicalize_with_config;
+    use hedl_core::{Item, Value};
+
+    fn sample() -> Document {
+        let mut doc = Document::new((1, 0));
+        doc.root.insert(
+            "name".to_string(),
+            Item::Scalar(Value::String("Alice".to_string())),
+        );
+        doc.root
+            .insert("age".to_string(), Item::Scalar(Value::Int(30)));
+        doc
+    }
+
+    fn reference(doc: &Document, algorithm: DigestAlgorithm) -> Digest {
+        let text = canonicalize_with_config(doc, &CanonicalConfig::default()).unwrap();
+        let mut hasher = Hasher::new(algorithm);
+        hasher.update(text.as_bytes());
+        hasher.digest()
+    }
+
+    #[test]
+    fn test_digest_matches_hash_of_canonical_text() {
+        let doc = sample();
+        for algorithm in [DigestAlgorithm::Blake3, DigestAlgorithm::Xxh3_128] {
+            let digest = canonical_digest(&doc, &CanonicalConfig::default(), algorithm).unwrap();
+            assert_eq!(digest, reference(&doc, algorithm));
+            assert_eq!(digest.as_bytes().len(), algorithm.digest_len());
+        }
+    }
+
+    #[test]
+    fn test_entry_digests_track_changed_entries() {
+        let config = CanonicalConfig::default();
+        let before = canonical_digests(&sample(), &config, DigestAlgorithm::Xxh3_128).unwrap();
+        assert_eq!(
+            before.document,
+            reference(&sample(), DigestAlgorithm::Xxh3_128)
+        );
+
+        let keys: Vec<&str> = before.entries.iter().map(|(k, _)| k.as_str()).collect();
+        assert_eq!(keys, ["age", "name"]);
+
+        let mut changed = sample();
+        changed
+            .root
+            .insert("age".to_string(), Item::Scalar(Value::Int(31)));
+        let after = canonical_digests(&changed, &config, DigestAlgorithm::Xxh3_128).unwrap();
+
+        assert_ne!(before.document, after.document);
+        assert_ne!(before.get("age"), after.get("age"));
+        assert_eq!(before.get("name"), after.get("name"));
+        assert!(after.get("missing").is_none());
+    }
+}
@@ -23,6 +23,7 @@
 
 use std::collections::BTreeMap;
 use std::fmt::Write;
+use std::io;
 
 use crate::config::{CanonicalConfig, QuotingStrategy};
 use crate::ditto::can_use_ditto;
@@ -141,12 +142,15 @@ const WHOLE_NUMBER_DECIMAL_PLACES: usize = 1;
 /// - Pre-allocated 4KB output buffer (P1 optimization)
 /// - Direct BTreeMap iteration without cloning (P0 optimization)
 /// - Cell buffer reuse across rows (P1 optimization)
-pub struct CanonicalWriter {
+/// - Optional sink drains the buffer in bounded chunks (see [`CanonicalWriter::with_sink`])
+pub struct CanonicalWriter<'s> {
     config: CanonicalConfig,
     output: String,
+    sink: Option<&'s mut dyn io::Write>,
+    flush_threshold: usize,
 }
 
-impl CanonicalWriter {
+impl CanonicalWriter<'static> {
     /// Creates a new canonical writer with the given configuration.
     pub fn new(config: CanonicalConfig) -> Self {
         // P1 OPTIMIZATION: Pre-allocate capacity (1.2-1.3x speedup)
@@ -154,13 +158,76 @@ impl CanonicalWriter {
         Self {
             config,
             output: String::with_capacity(INITIAL_OUTPUT_BUFFER_CAPACITY),
+            sink: None,
+            flush_threshold: usize::MAX,
+        }
+    }
+}
+
+impl<'s> CanonicalWriter<'s> {
+    /// Creates a canonical writer that streams its output into `sink`.
+    ///
+    /// Output is buffered until at least `chunk_size` bytes are pending and then
+    /// written to the sink at the next line boundary, so memory usage stays
+    /// bounded by roughly `chunk_size` plus one line regardless of document size.
+    /// A `chunk_size` of 0 is treated as 1 (flush after every line).
+    pub fn with_sink(
+        config: CanonicalConfig,
+        sink: &'s mut dyn io::Write,
+        chunk_size: usize,
+    ) -> Self {
+        let chunk_size = chunk_size.max(1);
+        Self {
+            config,
+            output: String::with_capacity(chunk_size.min(INITIAL_OUTPUT_BUFFER_CAPACITY)),
+            sink: Some(sink),
+            flush_threshold: chunk_size,
         }
     }
 
     /// Writes a HEDL document to canonical string format.
     ///
     /// Returns the canonicalized document as a string, or an error if writing fails.
+    /// When the writer was created with [`CanonicalWriter::with_sink`], all output
+    /// goes to the sink (which is flushed at the end) and the returned string is empty.
     pub fn write_document(&mut self, doc: &Document) -> Result<String, HedlError> {
+        self.write_header(doc)?;
+
+        // Body (sorted keys if configured)
+        self.spill()?;
+        self.write_items(&doc.root, ROOT_INDENT_LEVEL)?;
+
+        self.finish()
+    }
+
+    /// Writes a document, reporting where each root entry ends.
+    ///
+    /// Output is identical to [`write_document`](Self::write_document), but the
+    /// buffer is drained into the sink after the header and after every root
+    /// entry, and `mark` is then called with `None` (header) or the entry's key.
+    /// Everything the sink received since the previous mark belongs to that
+    /// section. Only meaningful for writers created with
+    /// [`with_sink`](Self::with_sink).
+    pub(crate) fn write_document_marked(
+        &mut self,
+        doc: &Document,
+        mut mark: impl FnMut(Option<&str>),
+    ) -> Result<(), HedlError> {
+        self.write_header(doc)?;
+        self.drain()?;
+        mark(None);
+
+        for (key, item) in &doc.root {
+            self.write_entry(key, item, ROOT_INDENT_LEVEL, "")?;
+            self.drain()?;
+            mark(Some(key));
+        }
+
+        self.finish().map(|_| ())
+    }
+
+    /// Writes the header directives and the `---` separator.
+    fn write_header(&mut self, doc: &Document) -> Result<(), HedlError> {
         // Header: VERSION
         writeln!(self.output, "%VERSION: {}.{}", doc.version.0, doc.version.1)
             .map_err(|e| HedlError::syntax(format!("Write error: {}", e), ERROR_LINE_UNKNOWN))?;
@@ -225,12 +292,46 @@ impl CanonicalWriter {
         writeln!(self.output, "---")
             .map_err(|e| HedlError::syntax(format!("Write error: {}", e), ERROR_LINE_UNKNOWN))?;
 
-        // Body (sorted keys if configured)
-        self.write_items(&doc.root, ROOT_INDENT_LEVEL)?;
+        Ok(())
+    }
+
+    /// Flush remaining output to the sink, or return it for buffered writers.
+    fn finish(&mut self) -> Result<String, HedlError> {
+        if let Some(sink) = self.sink.as_mut() {
+            sink.write_all(self.output.as_bytes())
+                .and_then(|_| sink.flush())
+                .map_err(|e| HedlError::syntax(format!("Write error: {}", e), ERROR_LINE_UNKNOWN))?;
+            self.output.clear();
+        }
 
         Ok(std::mem::take(&mut self.output))
     }
 
+    /// Hand all buffered output to the sink regardless of the flush threshold.
+    fn drain(&mut self) -> Result<(), HedlError> {
+        if let Some(sink) = self.sink.as_mut() {
+            sink.write_all(self.output.as_bytes())
+                .map_err(|e| HedlError::syntax(format!("Write error: {}", e), ERROR_LINE_UNKNOWN))?;
+            self.output.clear();
+        }
+        Ok(())
+    }
+
+    /// Hand buffered output to the sink once it reaches the flush threshold.
+    ///
+    /// Called only at line boundaries; a no-op for writers without a sink.
+    fn spill(&mut self) -> Result<(), HedlError> {
+        if self.output.len() < self.flush_threshold {
+            return Ok(());
+        }
+        if let Some(sink) = self.sink.as_mut() {
+            sink.write_all(self.output.as_bytes())
+                .map_err(|e| HedlError::syntax(format!("Write error: {}", e), ERROR_LINE_UNKNOWN))?;
+            self.output.clear();
+        }
+        Ok(())
+    }
+
     /// Recursively collect all MatrixList types and their counts from the document body.
     /// This ensures inline schema types are included in STRUCT declarations with counts.
     fn collect_matrix_list_types_and_counts(
@@ -296,35 +397,52 @@ impl CanonicalWriter {
         // BTreeMap is already sorted, iterate directly without collecting/cloning
         // Note: sort_keys config is redundant for BTreeMap (always sorted)
         for (key, item) in items {
-            match item {
-                Item::Scalar(value) => {
-                    let (formatted, needs_block) = self.format_value_for_kv(value);
-                    if needs_block {
-                        // Write block string
-                        writeln!(self.output, "{}{}: \"\"\"", indent_str, key)
-                            .map_err(|e| HedlError::syntax(format!("Write error: {}", e), ERROR_LINE_UNKNOWN))?;
-                        for line in formatted.lines() {
-                            writeln!(self.output, "{}", line).map_err(|e| {
-                                HedlError::syntax(format!("Write error: {}", e), ERROR_LINE_UNKNOWN)
-                            })?;
-                        }
-                        writeln!(self.output, "\"\"\"")
-                            .map_err(|e| HedlError::syntax(format!("Write error: {}", e), ERROR_LINE_UNKNOWN))?;
-                    } else {
-                        writeln!(self.output, "{}{}: {}", indent_str, key, formatted)
-                            .map_err(|e| HedlError::syntax(format!("Write error: {}", e), ERROR_LINE_UNKNOWN))?;
+            self.write_entry(key, item, indent, &indent_str)?;
+        }
+
+        Ok(())
+    }
+
+    /// Write one key-value entry (and everything nested under it) to output.
+    ///
+    /// `indent_str` is the whitespace for `indent`, computed once per map by the caller.
+    fn write_entry(
+        &mut self,
+        key: &str,
+        item: &Item,
+        indent: usize,
+        indent_str: &str,
+    ) -> Result<(), HedlError> {
+        match item {
+            Item::Scalar(value) => {
+                let (formatted, needs_block) = self.format_value_for_kv(value);
+                if needs_block {
+                    // Write block string
+                    writeln!(self.output, "{}{}: \"\"\"", indent_str, key)
+                        .map_err(|e| HedlError::syntax(format!("Write error: {}", e), ERROR_LINE_UNKNOWN))?;
+                    for line in formatted.lines() {
+                        writeln!(self.output, "{}", line).map_err(|e| {
+                            HedlError::syntax(format!("Write error: {}", e), ERROR_LINE_UNKNOWN)
+                        })?;
                     }
-                }
-                Item::Object(child_items) => {
-                    writeln!(self.output, "{}{}:", indent_str, key)
+                    writeln!(self.output, "\"\"\"")
+                        .map_err(|e| HedlError::syntax(format!("Write error: {}", e), ERROR_LINE_UNKNOWN))?;
+                } else {
+                    writeln!(self.output, "{}{}: {}", indent_str, key, formatted)
                         .map_err(|e| HedlError::syntax(format!("Write error: {}", e), ERROR_LINE_UNKNOWN))?;
-                    self.write_items(child_items, indent + INDENT_INCREMENT)?;
-                }
-                Item::List(matrix_list) => {
-                    self.write_matrix_list(key, matrix_list, indent)?;
                 }
             }
+            Item::Object(child_items) => {
+                writeln!(self.output, "{}{}:", indent_str, key)
+                    .map_err(|e| HedlError::syntax(format!("Write error: {}", e), ERROR_LINE_UNKNOWN))?;
+                self.spill()?;
+                self.write_items(child_items, indent + INDENT_INCREMENT)?;
+            }
+            Item::List(matrix_list) => {
+                self.write_matrix_list(key, matrix_list, indent)?;
+            }
         }
+        self.spill()?;
 
         Ok(())
     }
@@ -401,6 +519,7 @@ impl CanonicalWriter {
             writeln!(self.output, "{}|{}", indent_str, cells.join(","))
                 .map_err(|e| HedlError::syntax(format!("Write error: {}", e), ERROR_LINE_UNKNOWN))?;
         }
+        self.spill()?;
 
         // Write children if any
         for child_nodes in row_node.children.values() {
@@ -19,7 +19,7 @@
 //!
 //! Tests for canonical output generation, ditto optimization, and round-trip stability.
 
-use hedl_c14n::{canonicalize, canonicalize_with_config, CanonicalConfig};
+use hedl_c14n::{canonicalize, canonicalize_to_writer, canonicalize_with_config, CanonicalConfig};
 use hedl_core::{parse, Document, Item, MatrixList, Node, Reference, Value};
 
 // =============================================================================
@@ -814,3 +814,85 @@ items: @TestItem
         }
     }
 }
+
+// =============================================================================
+// Streaming Writer Tests
+// =============================================================================
+
+/// Sink that records the size of every write it receives.
+#[derive(Default)]
+struct RecordingSink {
+    data: Vec<u8>,
+    writes: Vec<usize>,
+}
+
+impl std::io::Write for RecordingSink {
+    fn write(&mut self, buf: &[u8]) -> std::io::Result<usize> {
+        self.data.extend_from_slice(buf);
+        self.writes.push(buf.len());
+        Ok(buf.len())
+    }
+
+    fn flush(&mut self) -> std::io::Result<()> {
+        Ok(())
+    }
+}
+
+fn large_list_document(rows: usize) -> Document {
+    let mut doc = Document::new((1, 0));
+    let mut list = MatrixList::new("Row", vec!["id".to_string(), "name".to_string()]);
+    for i in 0..rows {
+        list.add_row(Node::new(
+            "Row",
+            format!("r{}", i),
+            vec![
+                Value::String(format!("r{}", i)),
+                Value::String(format!("name {}", i)),
+            ],
+        ));
+    }
+    doc.root.insert("rows".to_string(), Item::List(list));
+    doc
+}
+
+#[test]
+fn test_canonicalize_to_writer_matches_string_output() {
+    let doc = large_list_document(500);
+    let expected = canonicalize(&doc).unwrap();
+
+    let mut sink = RecordingSink::default();
+    canonicalize_to_writer(&doc, &CanonicalConfig::default(), &mut sink, 256).unwrap();
+
+    assert_eq!(String::from_utf8(sink.data).unwrap(), expected);
+    assert!(sink.writes.len() > 1, "output should arrive in several chunks");
+    // Chunks are cut at line boundaries, so each stays within chunk_size + one line.
+    assert!(sink.writes.iter().all(|&n| n < 256 + 64));
+}
+
+#[test]
+fn test_canonicalize_to_writer_zero_chunk_size() {
+    let doc = large_list_document(3);
+    let expected = canonicalize(&doc).unwrap();
+
+    let mut out = Vec::new();
+    canonicalize_to_writer(&doc, &CanonicalConfig::default(), &mut out, 0).unwrap();
+    assert_eq!(String::from_utf8(out).unwrap(), expected);
+}
+
+#[test]
+fn test_canonicalize_to_writer_propagates_io_error() {
+    struct FailingSink;
+    impl std::io::Write for FailingSink {
+        fn write(&mut self, _buf: &[u8]) -> std::io::Result<usize> {
+            Err(std::io::Error::new(std::io::ErrorKind::Other, "sink closed"))
+        }
+        fn flush(&mut self) -> std::io::Result<()> {
+            Ok(())
+        }
+    }
+
+    let doc = large_list_document(10);
+    let err = canonicalize_to_writer(&doc, &CanonicalConfig::default(), &mut FailingSink, 16)
+        .unwrap_err();
+    assert!(err.to_string().contains("sink closed"));
+}
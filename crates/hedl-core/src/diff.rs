@@ -0,0 +1,1074 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Structural diffs between documents.
+//!
+//! [`diff_documents`] compares two documents and records only what changed,
+//! so a replica can be brought up to date by shipping the change instead of
+//! the whole document. Matrix list rows are matched by node ID: a list that
+//! keeps its type and schema is described by the IDs of removed rows, the
+//! changed rows, and the new rows together with the ID of the row they
+//! follow. Objects are compared key by key; anything else that changed is
+//! replaced outright.
+//!
+//! Keys are visited in sorted order, the order canonical output uses, so a
+//! diff (and its encoding) is deterministic and equal documents give an empty
+//! diff. [`DocumentDiff::apply`] validates the whole diff against the target
+//! before touching it; a diff that does not fit leaves the document unchanged.
+//! Validation finds the rows a list diff names in one scan of the list that
+//! compares IDs without hashing or copying them, and the rows are then
+//! updated, removed and inserted at those positions: a small change to a
+//! long list edits it in place instead of rebuilding it.
+//!
+//! # Encoding
+//!
+//! [`DocumentDiff::to_bytes`] uses the container of [`crate::snapshot`]
+//! (string table, tree words, checksum) under the magic `HEDLDIFF`. Like
+//! snapshots, the encoding is versioned and readers only accept their own
+//! [`DIFF_FORMAT_VERSION`].
+//!
+//! # Examples
+//!
+//! ```rust
+//! use hedl_core::{diff_documents, parse, DocumentDiff};
+//!
+//! let old = parse(b"%VERSION: 1.0\n%STRUCT: U: [id, n]\n---\nu: @U\n  | a, 1\n  | b, 2\n").unwrap();
+//! let new = parse(b"%VERSION: 1.0\n%STRUCT: U: [id, n]\n---\nu: @U\n  | a, 1\n  | b, 3\n").unwrap();
+//!
+//! let bytes = diff_documents(&old, &new).to_bytes().unwrap();
+//!
+//! let mut replica = old.clone();
+//! DocumentDiff::from_bytes(&bytes).unwrap().apply(&mut replica).unwrap();
+//! assert_eq!(replica, new);
+//! ```
+
+use crate::snapshot::{seal, unseal, Reader, Writer, NO_STRING};
+use crate::{Document, HedlError, HedlResult, Item, MatrixList, Node};
+use std::cmp::Ordering;
+use std::collections::{BTreeMap, HashMap, HashSet};
+
+/// Leading bytes of every encoded diff.
+const DIFF_MAGIC: [u8; 8] = *b"HEDLDIFF";
+
+/// Layout version written by [`DocumentDiff::to_bytes`].
+pub const DIFF_FORMAT_VERSION: u32 = 1;
+
+// Change tags
+const CHANGE_REMOVED: u32 = 0;
+const CHANGE_SET: u32 = 1;
+const CHANGE_OBJECT: u32 = 2;
+const CHANGE_ROWS: u32 = 3;
+
+// =============================================================================
+// Diff Model
+// =============================================================================
+
+/// Changes that turn one document into another.
+#[derive(Debug, Clone, PartialEq, Default)]
+pub struct DocumentDiff {
+    /// New version, if it changed.
+    pub version: Option<(u32, u32)>,
+    /// Alias changes by name: the new value, or `None` if removed.
+    pub aliases: Vec<(String, Option<String>)>,
+    /// Schema changes by type name: the new columns, or `None` if removed.
+    pub structs: Vec<(String, Option<Vec<String>>)>,
+    /// Nest rule changes by parent type: the new child type, or `None` if removed.
+    pub nests: Vec<(String, Option<String>)>,
+    /// Changes to the root body, sorted by key.
+    pub root: Vec<EntryDiff>,
+}
+
+/// Change to one key of an object.
+#[derive(Debug, Clone, PartialEq)]
+pub struct EntryDiff {
+    /// The key.
+    pub key: String,
+    /// What happened to its item.
+    pub change: ItemDiff,
+}
+
+/// Change to one item.
+#[derive(Debug, Clone, PartialEq)]
+pub enum ItemDiff {
+    /// The key is gone.
+    Removed,
+    /// The key is new, or its item is replaced outright.
+    Set(Item),
+    /// The item stays an object; changes to its keys, sorted by key.
+    Object(Vec<EntryDiff>),
+    /// The item stays a matrix list with the same type and schema.
+    Rows(RowsDiff),
+}
+
+/// Row changes to a matrix list, matched by node ID.
+#[derive(Debug, Clone, PartialEq, Default)]
+pub struct RowsDiff {
+    /// The list's new count hint.
+    pub count_hint: Option<usize>,
+    /// IDs of rows that are gone.
+    pub removed: Vec<String>,
+    /// Rows whose fields or children changed, in full.
+    pub updated: Vec<Node>,
+    /// New rows, in list order.
+    pub inserted: Vec<RowInsert>,
+}
+
+/// A new row and its position.
+#[derive(Debug, Clone, PartialEq)]
+pub struct RowInsert {
+    /// ID of the row this one follows, or `None` for the front of the list.
+    /// May name a row inserted earlier in the same diff.
+    pub after: Option<String>,
+    /// The row.
+    pub node: Node,
+}
+
+impl DocumentDiff {
+    /// Whether the diff changes nothing.
+    pub fn is_empty(&self) -> bool {
+        self.version.is_none()
+            && self.aliases.is_empty()
+            && self.structs.is_empty()
+            && self.nests.is_empty()
+            && self.root.is_empty()
+    }
+}
+
+impl RowsDiff {
+    fn has_row_changes(&self) -> bool {
+        !(self.removed.is_empty() && self.updated.is_empty() && self.inserted.is_empty())
+    }
+}
+
+// =============================================================================
+// Diffing
+// =============================================================================
+
+/// Compute the changes that turn `old` into `new`.
+///
+/// The resulting diff applied to `old` gives a document equal to `new`.
+/// Lists are diffed row by row when both sides have the same type and
+/// schema, unique row IDs, and the rows they share in the same order;
+/// otherwise, or when the rows to send would be no fewer than the new list
+/// itself, the list is replaced as a whole.
+pub fn diff_documents(old: &Document, new: &Document) -> DocumentDiff {
+    DocumentDiff {
+        version: (old.version != new.version).then_some(new.version),
+        aliases: map_changes(&old.aliases, &new.aliases),
+        structs: map_changes(&old.structs, &new.structs),
+        nests: map_changes(&old.nests, &new.nests),
+        root: object_changes(&old.root, &new.root),
+    }
+}
+
+/// Visit the union of two maps' keys in sorted order.
+fn for_each_key<'a, V>(
+    old: &'a BTreeMap<String, V>,
+    new: &'a BTreeMap<String, V>,
+    mut f: impl FnMut(&'a String, Option<&'a V>, Option<&'a V>),
+) {
+    let mut old_iter = old.iter().peekable();
+    let mut new_iter = new.iter().peekable();
+    loop {
+        let order = match (old_iter.peek(), new_iter.peek()) {
+            (None, None) => break,
+            (Some(_), None) => Ordering::Less,
+            (None, Some(_)) => Ordering::Greater,
+            (Some((a, _)), Some((b, _))) => a.cmp(b),
+        };
+        match order {
+            Ordering::Less => {
+                if let Some((key, value)) = old_iter.next() {
+                    f(key, Some(value), None);
+                }
+            }
+            Ordering::Greater => {
+                if let Some((key, value)) = new_iter.next() {
+                    f(key, None, Some(value));
+                }
+            }
+            Ordering::Equal => {
+                if let (Some((key, old)), Some((_, new))) = (old_iter.next(), new_iter.next()) {
+                    f(key, Some(old), Some(new));
+                }
+            }
+        }
+    }
+}
+
+fn map_changes<V: PartialEq + Clone>(
+    old: &BTreeMap<String, V>,
+    new: &BTreeMap<String, V>,
+) -> Vec<(String, Option<V>)> {
+    let mut changes = Vec::new();
+    for_each_key(old, new, |key, old, new| {
+        if old != new {
+            changes.push((key.clone(), new.cloned()));
+        }
+    });
+    changes
+}
+
+fn object_changes(old: &BTreeMap<String, Item>, new: &BTreeMap<String, Item>) -> Vec<EntryDiff> {
+    let mut changes = Vec::new();
+    for_each_key(old, new, |key, old, new| {
+        let change = match (old, new) {
+            (Some(old), Some(new)) => item_diff(old, new),
+            (Some(_), None) => Some(ItemDiff::Removed),
+            (None, new) => new.map(|item| ItemDiff::Set(item.clone())),
+        };
+        if let Some(change) = change {
+            changes.push(EntryDiff {
+                key: key.clone(),
+                change,
+            });
+        }
+    });
+    changes
+}
+
+fn item_diff(old: &Item, new: &Item) -> Option<ItemDiff> {
+    match (old, new) {
+        (Item::Object(old), Item::Object(new)) => {
+            let changes = object_changes(old, new);
+            (!changes.is_empty()).then_some(ItemDiff::Object(changes))
+        }
+        (Item::List(old), Item::List(new))
+            if old.type_name == new.type_name && old.schema == new.schema =>
+        {
+            rows_diff(old, new)
+        }
+        _ if old == new => None,
+        _ => Some(ItemDiff::Set(new.clone())),
+    }
+}
+
+/// Index rows by ID, or `None` if an ID repeats.
+fn id_index(rows: &[Node]) -> Option<HashMap<&str, usize>> {
+    let mut index = HashMap::with_capacity(rows.len());
+    for (i, node) in rows.iter().enumerate() {
+        if index.insert(node.id.as_str(), i).is_some() {
+            return None;
+        }
+    }
+    Some(index)
+}
+
+fn rows_diff(old: &MatrixList, new: &MatrixList) -> Option<ItemDiff> {
+    let replace = || Some(ItemDiff::Set(Item::List(new.clone())));
+    let (Some(old_index), Some(new_index)) = (id_index(&old.rows), id_index(&new.rows)) else {
+        return replace();
+    };
+
+    let mut diff = RowsDiff {
+        count_hint: new.count_hint,
+        removed: old
+            .rows
+            .iter()
+            .filter(|node| !new_index.contains_key(node.id.as_str()))
+            .map(|node| node.id.clone())
+            .collect(),
+        ..RowsDiff::default()
+    };
+
+    // Old position of the last row kept so far: shared rows must not move
+    let mut last_kept = None;
+    for (j, node) in new.rows.iter().enumerate() {
+        match old_index.get(node.id.as_str()) {
+            Some(&i) => {
+                if last_kept.is_some_and(|last| i < last) {
+                    return replace();
+                }
+                last_kept = Some(i);
+                if old.rows[i] != *node {
+                    diff.updated.push(node.clone());
+                }
+            }
+            None => diff.inserted.push(RowInsert {
+                after: j.checked_sub(1).map(|prev| new.rows[prev].id.clone()),
+                node: node.clone(),
+            }),
+        }
+    }
+
+    if !diff.has_row_changes() && old.count_hint == new.count_hint {
+        None
+    } else if diff.updated.len() + diff.inserted.len() >= new.rows.len() {
+        replace()
+    } else {
+        Some(ItemDiff::Rows(diff))
+    }
+}
+
+// =============================================================================
+// Applying
+// =============================================================================
+
+impl DocumentDiff {
+    /// Apply the diff to `doc`.
+    ///
+    /// # Errors
+    ///
+    /// A conversion error if the diff does not fit `doc`: a changed key is
+    /// missing or of another kind, or a row ID to remove, update or insert
+    /// after is missing or not unique (or one to insert already exists).
+    /// `doc` is left unchanged in that case.
+    pub fn apply(&self, doc: &mut Document) -> HedlResult<()> {
+        let mut plans = Vec::new();
+        check_entries(&doc.root, &self.root, "", &mut plans)?;
+
+        if let Some(version) = self.version {
+            doc.version = version;
+        }
+        apply_map(&mut doc.aliases, &self.aliases);
+        apply_map(&mut doc.structs, &self.structs);
+        apply_map(&mut doc.nests, &self.nests);
+        apply_entries(&mut doc.root, &self.root, &mut plans.into_iter());
+        Ok(())
+    }
+}
+
+/// Row diffs that remove rows or insert at no more than this many places
+/// are applied by shifting the list in place; larger ones rebuild it.
+const IN_PLACE_EDITS: usize = 8;
+
+/// Where a checked row diff lands in its list.
+struct RowPlan<'d> {
+    /// Positions of the updated rows, aligned with `RowsDiff::updated`.
+    updated: Vec<usize>,
+    /// Positions of the removed rows, ascending.
+    removed: Vec<usize>,
+    /// New rows in list order, grouped by the position of the old row they
+    /// follow (`None` for the front), ascending.
+    inserted: Vec<(Option<usize>, Vec<&'d Node>)>,
+}
+
+/// Positions of the rows a diff names, found in one scan of the list.
+///
+/// Only the named IDs are searched for, so the scan compares each row's ID
+/// against a short sorted list and allocates nothing per row.
+struct RowPositions<'d> {
+    ids: Vec<&'d str>,
+    positions: Vec<Option<usize>>,
+}
+
+impl<'d> RowPositions<'d> {
+    fn find(list: &MatrixList, rows: &'d RowsDiff, path: &str) -> HedlResult<Self> {
+        let mut ids: Vec<&str> = rows.removed.iter().map(String::as_str).collect();
+        ids.extend(rows.updated.iter().map(|node| node.id.as_str()));
+        for insert in &rows.inserted {
+            ids.extend(insert.after.as_deref());
+            ids.push(insert.node.id.as_str());
+        }
+        ids.sort_unstable();
+        ids.dedup();
+
+        let mut positions = vec![None; ids.len()];
+        if !ids.is_empty() {
+            for (i, node) in list.rows.iter().enumerate() {
+                if let Ok(slot) = ids.binary_search(&node.id.as_str()) {
+                    if positions[slot].replace(i).is_some() {
+                        return Err(mismatch(format!(
+                            "row '{}' is not unique in '{}'",
+                            node.id, path
+                        )));
+                    }
+                }
+            }
+        }
+        Ok(Self { ids, positions })
+    }
+
+    /// Position of a row named by the diff.
+    fn get(&self, id: &str) -> Option<usize> {
+        let slot = self.ids.binary_search(&id).ok()?;
+        self.positions[slot]
+    }
+}
+
+fn mismatch(message: String) -> HedlError {
+    HedlError::conversion(format!("Diff does not apply: {}", message))
+}
+
+fn join(path: &str, key: &str) -> String {
+    if path.is_empty() {
+        key.to_string()
+    } else {
+        format!("{}.{}", path, key)
+    }
+}
+
+/// Check changes against `target`, pushing a plan for every row diff in the
+/// order `apply_entries` visits them.
+fn check_entries<'d>(
+    target: &BTreeMap<String, Item>,
+    changes: &'d [EntryDiff],
+    path: &str,
+    plans: &mut Vec<RowPlan<'d>>,
+) -> HedlResult<()> {
+    for (i, change) in changes.iter().enumerate() {
+        // Plans hold positions in the target, so no key may change twice
+        if i > 0 && changes[i - 1].key >= change.key {
+            return Err(mismatch(format!(
+                "'{}' is repeated or out of order",
+                join(path, &change.key)
+            )));
+        }
+        let item = target.get(&change.key);
+        match (&change.change, item) {
+            (ItemDiff::Set(_), _) | (ItemDiff::Removed, Some(_)) => {}
+            (ItemDiff::Object(changes), Some(Item::Object(object))) => {
+                check_entries(object, changes, &join(path, &change.key), plans)?;
+            }
+            (ItemDiff::Rows(rows), Some(Item::List(list))) => {
+                plans.push(check_rows(list, rows, &join(path, &change.key))?);
+            }
+            (ItemDiff::Removed, None) => {
+                return Err(mismatch(format!("'{}' not found", join(path, &change.key))))
+            }
+            (ItemDiff::Object(_), _) => {
+                return Err(mismatch(format!(
+                    "'{}' is not an object",
+                    join(path, &change.key)
+                )))
+            }
+            (ItemDiff::Rows(_), _) => {
+                return Err(mismatch(format!(
+                    "'{}' is not a list",
+                    join(path, &change.key)
+                )))
+            }
+        }
+    }
+    Ok(())
+}
+
+fn check_rows<'d>(list: &MatrixList, rows: &'d RowsDiff, path: &str) -> HedlResult<RowPlan<'d>> {
+    let missing = |id: &str| mismatch(format!("no row '{}' in '{}'", id, path));
+    let at = RowPositions::find(list, rows, path)?;
+
+    let mut removed = Vec::with_capacity(rows.removed.len());
+    for id in &rows.removed {
+        match at.get(id) {
+            Some(i) => removed.push(i),
+            None => return Err(missing(id)),
+        }
+    }
+    removed.sort_unstable();
+    if let Some(pair) = removed.windows(2).find(|pair| pair[0] == pair[1]) {
+        return Err(missing(&list.rows[pair[0]].id));
+    }
+    let kept = |id: &str| at.get(id).filter(|i| removed.binary_search(i).is_err());
+
+    let mut updated = Vec::with_capacity(rows.updated.len());
+    for node in &rows.updated {
+        match kept(&node.id) {
+            Some(i) => updated.push(i),
+            None => return Err(missing(&node.id)),
+        }
+    }
+
+    // Rows inserted after other new rows follow them wherever they land
+    let mut runs: BTreeMap<Option<usize>, Vec<&Node>> = BTreeMap::new();
+    let mut followers: HashMap<&str, Vec<&Node>> = HashMap::new();
+    let mut inserted = HashSet::with_capacity(rows.inserted.len());
+    for insert in &rows.inserted {
+        match insert.after.as_deref() {
+            None => runs.entry(None).or_default().push(&insert.node),
+            Some(after) if inserted.contains(after) => {
+                followers.entry(after).or_default().push(&insert.node);
+            }
+            Some(after) => match kept(after) {
+                Some(i) => runs.entry(Some(i)).or_default().push(&insert.node),
+                None => return Err(missing(after)),
+            },
+        }
+        let id = insert.node.id.as_str();
+        if inserted.contains(id) || kept(id).is_some() {
+            return Err(mismatch(format!("row '{}' already in '{}'", id, path)));
+        }
+        inserted.insert(id);
+    }
+    let inserted = runs
+        .into_iter()
+        .map(|(after, nodes)| {
+            let mut run = Vec::new();
+            emit_inserted(nodes, &mut followers, &mut run);
+            (after, run)
+        })
+        .collect();
+
+    Ok(RowPlan {
+        updated,
+        removed,
+        inserted,
+    })
+}
+
+fn apply_map<V: Clone>(target: &mut BTreeMap<String, V>, changes: &[(String, Option<V>)]) {
+    for (key, value) in changes {
+        match value {
+            Some(value) => {
+                target.insert(key.clone(), value.clone());
+            }
+            None => {
+                target.remove(key);
+            }
+        }
+    }
+}
+
+/// Apply checked changes, taking the row plans in `check_entries` order.
+fn apply_entries(
+    target: &mut BTreeMap<String, Item>,
+    changes: &[EntryDiff],
+    plans: &mut std::vec::IntoIter<RowPlan<'_>>,
+) {
+    for change in changes {
+        match (&change.change, target.get_mut(&change.key)) {
+            (ItemDiff::Removed, _) => {
+                target.remove(&change.key);
+            }
+            (ItemDiff::Set(item), _) => {
+                target.insert(change.key.clone(), item.clone());
+            }
+            (ItemDiff::Object(changes), Some(Item::Object(object))) => {
+                apply_entries(object, changes, plans);
+            }
+            (ItemDiff::Rows(rows), Some(Item::List(list))) => {
+                let plan = plans.next().expect("planned by check_entries");
+                apply_rows(list, rows, plan);
+            }
+            _ => unreachable!("checked by check_entries"),
+        }
+    }
+}
+
+/// Apply checked row changes at their planned positions.
+///
+/// Untouched rows stay where they are unless rows are removed or inserted
+/// at many places, which costs one pass moving every row into a new list.
+fn apply_rows(list: &mut MatrixList, rows: &RowsDiff, plan: RowPlan<'_>) {
+    for (node, &i) in rows.updated.iter().zip(&plan.updated) {
+        list.rows[i] = node.clone();
+    }
+
+    if plan.removed.len() + plan.inserted.len() <= IN_PLACE_EDITS {
+        // Back to front, so each edit leaves the positions before it valid
+        let mut removed = plan.removed.iter().rev().peekable();
+        for (after, run) in plan.inserted.iter().rev() {
+            let at = after.map_or(0, |i| i + 1);
+            while let Some(&i) = removed.next_if(|&&i| i >= at) {
+                list.rows.remove(i);
+            }
+            list.rows.splice(at..at, run.iter().map(|&node| node.clone()));
+        }
+        for &i in removed {
+            list.rows.remove(i);
+        }
+    } else {
+        let mut removed = plan.removed.iter().peekable();
+        let mut runs = plan.inserted.iter().peekable();
+        let old_rows = std::mem::take(&mut list.rows);
+        let mut out = Vec::with_capacity(old_rows.len() - plan.removed.len() + rows.inserted.len());
+        if let Some((_, run)) = runs.next_if(|(after, _)| after.is_none()) {
+            out.extend(run.iter().map(|&node| node.clone()));
+        }
+        for (i, node) in old_rows.into_iter().enumerate() {
+            if removed.next_if_eq(&&i).is_some() {
+                continue;
+            }
+            out.push(node);
+            if let Some((_, run)) = runs.next_if(|(after, _)| *after == Some(i)) {
+                out.extend(run.iter().map(|&node| node.clone()));
+            }
+        }
+        list.rows = out;
+    }
+    list.count_hint = rows.count_hint;
+}
+
+/// Push `nodes`, each directly followed by the rows inserted after it.
+///
+/// Iterative, since appending many rows makes each follow the previous one.
+fn emit_inserted<'d>(
+    nodes: Vec<&'d Node>,
+    after: &mut HashMap<&str, Vec<&'d Node>>,
+    out: &mut Vec<&'d Node>,
+) {
+    let mut stack = vec![nodes.into_iter()];
+    while let Some(top) = stack.last_mut() {
+        match top.next() {
+            Some(node) => {
+                out.push(node);
+                if let Some(followers) = after.remove(node.id.as_str()) {
+                    stack.push(followers.into_iter());
+                }
+            }
+            None => {
+                stack.pop();
+            }
+        }
+    }
+}
+
+// =============================================================================
+// Encoding
+// =============================================================================
+
+impl DocumentDiff {
+    /// Encode the diff. Equal diffs produce identical bytes.
+    ///
+    /// # Errors
+    ///
+    /// A conversion error if a collection or the string table has more
+    /// entries than the format's 32-bit lengths can describe.
+    pub fn to_bytes(&self) -> HedlResult<Vec<u8>> {
+        let mut w = Writer::default();
+        match self.version {
+            Some((major, minor)) => {
+                w.word(1);
+                w.word(major);
+                w.word(minor);
+            }
+            None => w.word(0),
+        }
+        write_string_changes(&mut w, &self.aliases);
+        w.count(self.structs.len());
+        for (name, columns) in &self.structs {
+            w.string(name);
+            match columns {
+                Some(columns) => {
+                    w.word(1);
+                    w.strings_list(columns);
+                }
+                None => w.word(0),
+            }
+        }
+        write_string_changes(&mut w, &self.nests);
+        write_entries(&mut w, &self.root);
+        seal(&w, DIFF_MAGIC, DIFF_FORMAT_VERSION, "diff")
+    }
+
+    /// Decode a diff written by [`to_bytes`](Self::to_bytes).
+    ///
+    /// # Errors
+    ///
+    /// A conversion error if the bytes are not a diff, have another format
+    /// version, fail the checksum or are malformed.
+    pub fn from_bytes(bytes: &[u8]) -> HedlResult<Self> {
+        unseal(bytes, DIFF_MAGIC, DIFF_FORMAT_VERSION, "diff", |r| {
+            let version = if r.bool()? {
+                Some((r.word()?, r.word()?))
+            } else {
+                None
+            };
+            let aliases = read_string_changes(r)?;
+            let n = r.count()?;
+            let mut structs = Vec::with_capacity(n);
+            for _ in 0..n {
+                let name = r.string()?;
+                let columns = if r.bool()? {
+                    Some(r.strings_list()?)
+                } else {
+                    None
+                };
+                structs.push((name, columns));
+            }
+            let nests = read_string_changes(r)?;
+            let root = read_entries(r)?;
+            Ok(Self {
+                version,
+                aliases,
+                structs,
+                nests,
+                root,
+            })
+        })
+    }
+}
+
+fn write_string_changes<'a>(w: &mut Writer<'a>, changes: &'a [(String, Option<String>)]) {
+    w.count(changes.len());
+    for (key, value) in changes {
+        w.string(key);
+        match value {
+            Some(value) => w.string(value),
+            None => w.word(NO_STRING),
+        }
+    }
+}
+
+fn write_entries<'a>(w: &mut Writer<'a>, changes: &'a [EntryDiff]) {
+    w.count(changes.len());
+    for change in changes {
+        w.string(&change.key);
+        match &change.change {
+            ItemDiff::Removed => w.word(CHANGE_REMOVED),
+            ItemDiff::Set(item) => {
+                w.word(CHANGE_SET);
+                w.item(item);
+            }
+            ItemDiff::Object(changes) => {
+                w.word(CHANGE_OBJECT);
+                write_entries(w, changes);
+            }
+            ItemDiff::Rows(rows) => {
+                w.word(CHANGE_ROWS);
+                w.opt_usize(rows.count_hint);
+                w.strings_list(&rows.removed);
+                w.nodes(&rows.updated);
+                w.count(rows.inserted.len());
+                for insert in &rows.inserted {
+                    match &insert.after {
+                        Some(id) => w.string(id),
+                        None => w.word(NO_STRING),
+                    }
+                    w.node(&insert.node);
+                }
+            }
+        }
+    }
+}
+
+fn read_opt_string(r: &mut Reader<'_>) -> HedlResult<Option<String>> {
+    match r.word()? {
+        NO_STRING => Ok(None),
+        index => r.string_at(index).map(|s| Some(s.to_owned())),
+    }
+}
+
+fn read_string_changes(r: &mut Reader<'_>) -> HedlResult<Vec<(String, Option<String>)>> {
+    let n = r.count()?;
+    let mut changes = Vec::with_capacity(n);
+    for _ in 0..n {
+        changes.push((r.string()?, read_opt_string(r)?));
+    }
+    Ok(changes)
+}
+
+fn read_entries(r: &mut Reader<'_>) -> HedlResult<Vec<EntryDiff>> {
+    let n = r.count()?;
+    let mut changes = Vec::with_capacity(n);
+    for _ in 0..n {
+        let key = r.string()?;
+        let change = match r.word()? {
+            CHANGE_REMOVED => ItemDiff::Removed,
+            CHANGE_SET => ItemDiff::Set(r.item()?),
+            CHANGE_OBJECT => ItemDiff::Object(r.nested(read_entries)?),
+            CHANGE_ROWS => {
+                let count_hint = r.opt_usize()?;
+                let removed = r.strings_list()?;
+                let updated = r.nodes()?;
+                let n = r.count()?;
+                let mut inserted = Vec::with_capacity(n);
+                for _ in 0..n {
+                    inserted.push(RowInsert {
+                        after: read_opt_string(r)?,
+                        node: r.node()?,
+                    });
+                }
+                ItemDiff::Rows(RowsDiff {
+                    count_hint,
+                    removed,
+                    updated,
+                    inserted,
+                })
+            }
+            _ => return Err(r.invalid("bad change tag")),
+        };
+        changes.push(EntryDiff { key, change });
+    }
+    Ok(changes)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::{parse, to_snapshot};
+
+    const OLD: &str = "%VERSION: 1.0
+%ALIAS: %active: \"Active\"
+%STRUCT: Team: [id, name]
+%STRUCT: User: [id, name, score]
+%NEST: Team > User
+---
+config:
+  title: Reference data
+  limit: 42
+  retired: true
+teams(3): @Team
+  | t1, Platform
+    | u1, Alice, 9
+  | t2, Data
+  | t3, Infra
+users: @User
+  | a, Ann, 1
+  | b, Ben, 2
+  | c, Cat, 3
+  | d, Dan, 4
+";
+
+    const NEW: &str = "%VERSION: 1.0
+%ALIAS: %active: \"Enabled\"
+%STRUCT: Team: [id, name]
+%STRUCT: User: [id, name, score]
+%STRUCT: Tag: [id]
+%NEST: Team > User
+---
+config:
+  title: Reference data
+  limit: 43
+teams(2): @Team
+  | t1, Platform
+    | u1, Alice, 10
+  | t3, Infra
+users: @User
+  | z, Zed, 0
+  | a, Ann, 1
+  | b, Ben, 5
+  | x, Xia, 6
+  | y, Yan, 7
+  | c, Cat, 3
+  | d, Dan, 4
+tags: @Tag
+  | red
+";
+
+    fn rows(diff: &DocumentDiff, key: &str) -> RowsDiff {
+        match diff.root.iter().find(|e| e.key == key).map(|e| &e.change) {
+            Some(ItemDiff::Rows(rows)) => rows.clone(),
+            other => panic!("expected row changes for {}, got {:?}", key, other),
+        }
+    }
+
+    #[test]
+    fn test_apply_reproduces_new_document() {
+        let old = parse(OLD.as_bytes()).unwrap();
+        let new = parse(NEW.as_bytes()).unwrap();
+        let diff = diff_documents(&old, &new);
+
+        let keys: Vec<_> = diff.root.iter().map(|e| e.key.as_str()).collect();
+        assert_eq!(keys, ["config", "tags", "teams", "users"]);
+
+        let users = rows(&diff, "users");
+        assert!(users.removed.is_empty());
+        assert_eq!(users.updated.len(), 1);
+        let inserted: Vec<_> = users
+            .inserted
+            .iter()
+            .map(|i| (i.after.as_deref(), i.node.id.as_str()))
+            .collect();
+        assert_eq!(inserted, [(None, "z"), (Some("b"), "x"), (Some("x"), "y")]);
+
+        let teams = rows(&diff, "teams");
+        assert_eq!(teams.removed, ["t2"]);
+        assert_eq!(teams.count_hint, Some(2));
+
+        let mut patched = old.clone();
+        diff.apply(&mut patched).unwrap();
+        assert_eq!(patched, new);
+    }
+
+    #[test]
+    fn test_encoding_round_trip() {
+        let old = parse(OLD.as_bytes()).unwrap();
+        let new = parse(NEW.as_bytes()).unwrap();
+        let diff = diff_documents(&old, &new);
+
+        let bytes = diff.to_bytes().unwrap();
+        assert_eq!(&bytes[..8], &DIFF_MAGIC);
+        assert_eq!(bytes, diff_documents(&old, &new.clone()).to_bytes().unwrap());
+        assert_eq!(DocumentDiff::from_bytes(&bytes).unwrap(), diff);
+
+        let err = DocumentDiff::from_bytes(&to_snapshot(&old).unwrap()).unwrap_err();
+        assert_eq!(err.message, "Invalid diff: not a HEDL diff");
+        assert!(DocumentDiff::from_bytes(&bytes[..bytes.len() - 8]).is_err());
+    }
+
+    #[test]
+    fn test_equal_documents_give_empty_diff() {
+        let doc = parse(OLD.as_bytes()).unwrap();
+        let diff = diff_documents(&doc, &doc.clone());
+        assert!(diff.is_empty());
+
+        let mut patched = doc.clone();
+        DocumentDiff::from_bytes(&diff.to_bytes().unwrap())
+            .unwrap()
+            .apply(&mut patched)
+            .unwrap();
+        assert_eq!(patched, doc);
+    }
+
+    #[test]
+    fn test_reordered_rows_replace_list() {
+        let old = parse(OLD.as_bytes()).unwrap();
+        let new = parse(
+            OLD.replace(
+                "  | c, Cat, 3\n  | d, Dan, 4",
+                "  | d, Dan, 4\n  | c, Cat, 3",
+            )
+            .as_bytes(),
+        )
+        .unwrap();
+        let diff = diff_documents(&old, &new);
+        assert!(matches!(diff.root[0].change, ItemDiff::Set(Item::List(_))));
+
+        let mut patched = old.clone();
+        diff.apply(&mut patched).unwrap();
+        assert_eq!(patched, new);
+    }
+
+    #[test]
+    fn test_mismatched_target_is_untouched() {
+        let old = parse(OLD.as_bytes()).unwrap();
+        let new = parse(NEW.as_bytes()).unwrap();
+        let diff = diff_documents(&old, &new);
+
+        // Already patched: the removed team is gone and the inserted users exist
+        let mut target = new.clone();
+        let err = diff.apply(&mut target).unwrap_err();
+        assert!(err.message.contains("does not apply"), "{}", err.message);
+        assert_eq!(target, new);
+    }
+
+    #[test]
+    fn test_large_list_diff_is_small() {
+        let mut text = String::from("%VERSION: 1.0\n%STRUCT: R: [id, v]\n---\nrows: @R\n");
+        for i in 0..1000 {
+            text.push_str(&format!("  | r{}, {}\n", i, i));
+        }
+        let old = parse(text.as_bytes()).unwrap();
+        let new = parse(text.replace("  | r500, 500\n", "  | r500, -1\n").as_bytes()).unwrap();
+
+        let bytes = diff_documents(&old, &new).to_bytes().unwrap();
+        assert!(bytes.len() * 20 < to_snapshot(&new).unwrap().len());
+
+        let mut patched = old.clone();
+        DocumentDiff::from_bytes(&bytes)
+            .unwrap()
+            .apply(&mut patched)
+            .unwrap();
+        assert_eq!(patched, new);
+    }
+
+    fn row_list(ids: impl IntoIterator<Item = String>) -> String {
+        let mut text = String::from("%VERSION: 1.0\n%STRUCT: R: [id, v]\n---\nrows: @R\n");
+        for id in ids {
+            text.push_str(&format!("  | {}, 0\n", id));
+        }
+        text
+    }
+
+    fn list_rows(doc: &Document) -> &Vec<Node> {
+        match doc.root.get("rows") {
+            Some(Item::List(list)) => &list.rows,
+            other => panic!("expected a list, got {:?}", other),
+        }
+    }
+
+    #[test]
+    fn test_small_diff_edits_large_list_in_place() {
+        let ids = (0..100_000).map(|i| format!("r{}", i));
+        let old = parse(row_list(ids).as_bytes()).unwrap();
+        let text = row_list((0..100_000).filter(|&i| i != 70_000).map(|i| format!("r{}", i)))
+            .replace("  | r500, 0\n", "  | r500, 1\n");
+        let new = parse(text.as_bytes()).unwrap();
+        let diff = diff_documents(&old, &new);
+
+        let mut patched = old.clone();
+        let buffer = list_rows(&patched).as_ptr();
+        let far_id = list_rows(&patched)[99_999].id.as_ptr();
+        diff.apply(&mut patched).unwrap();
+        assert_eq!(patched, new);
+
+        // The update and removal edit the existing rows: nothing is rebuilt
+        assert_eq!(list_rows(&patched).as_ptr(), buffer);
+        assert_eq!(list_rows(&patched)[99_998].id.as_ptr(), far_id);
+    }
+
+    #[test]
+    fn test_duplicate_ids_only_matter_when_named() {
+        let old = parse(row_list(["a", "b", "c"].map(String::from)).as_bytes()).unwrap();
+        let new = parse(row_list(["a", "c"].map(String::from)).as_bytes()).unwrap();
+        let diff = diff_documents(&old, &new);
+
+        let mut target = old.clone();
+        if let Some(Item::List(list)) = target.root.get_mut("rows") {
+            let extra = list.rows[0].clone();
+            list.rows.push(extra);
+        }
+        let mut patched = target.clone();
+        diff.apply(&mut patched).unwrap();
+        assert_eq!(list_rows(&patched).len(), 3);
+
+        if let Some(Item::List(list)) = target.root.get_mut("rows") {
+            list.rows[0].id = "b".to_string();
+        }
+        let err = diff.apply(&mut target.clone()).unwrap_err();
+        assert!(err.message.contains("row 'b' is not unique"), "{}", err.message);
+    }
+
+    #[test]
+    fn test_repeated_key_is_rejected() {
+        let old = parse(row_list(["a", "b"].map(String::from)).as_bytes()).unwrap();
+        let new = parse(row_list(["a"].map(String::from)).as_bytes()).unwrap();
+        let mut diff = diff_documents(&old, &new);
+        diff.root.push(diff.root[0].clone());
+
+        let mut target = old.clone();
+        let err = diff.apply(&mut target).unwrap_err();
+        assert!(err.message.contains("'rows' is repeated"), "{}", err.message);
+        assert_eq!(target, old);
+    }
+
+    #[test]
+    fn test_random_row_diffs_apply() {
+        let mut seed: u64 = 0x2545_f491_4f6c_dd1d;
+        let mut next = |bound: usize| {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            (seed % bound as u64) as usize
+        };
+
+        let mut fresh = 0;
+        let mut ids: Vec<String> = (0..40).map(|i| format!("r{}", i)).collect();
+        for _ in 0..300 {
+            let old = parse(row_list(ids.clone()).as_bytes()).unwrap();
+            // Up to a dozen removals and insertions, across both apply paths
+            for _ in 0..=next(12) {
+                if ids.len() > 1 && next(2) == 0 {
+                    ids.remove(next(ids.len()));
+                } else {
+                    fresh += 1;
+                    ids.insert(next(ids.len() + 1), format!("n{}", fresh));
+                }
+            }
+            let mut text = row_list(ids.clone());
+            if next(2) == 0 {
+                let id = &ids[next(ids.len())];
+                text = text.replace(&format!("  | {}, 0\n", id), &format!("  | {}, 1\n", id));
+            }
+            let new = parse(text.as_bytes()).unwrap();
+
+            let mut patched = old.clone();
+            diff_documents(&old, &new).apply(&mut patched).unwrap();
+            assert_eq!(list_rows(&patched), list_rows(&new));
+        }
+    }
+}
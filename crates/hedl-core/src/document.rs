@@ -17,7 +17,7 @@
 
 //! Document structure for parsed HEDL.
 
-use crate::Value;
+use crate::{NodeIndex, Value};
 use std::collections::BTreeMap;
 
 /// A node in a matrix list.
@@ -214,6 +214,11 @@ impl Document {
         self.root.get(key)
     }
 
+    /// Build a [`NodeIndex`] for looking nodes up by type and ID.
+    pub fn node_index(&self) -> NodeIndex<'_> {
+        NodeIndex::build(self)
+    }
+
     /// Get a struct schema by type name.
     pub fn get_schema(&self, type_name: &str) -> Option<&Vec<String>> {
         self.structs.get(type_name)
@@ -0,0 +1,1648 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Incremental re-parsing for live-edited documents.
+//!
+//! [`IncrementalDocument`] keeps a parsed [`Document`] in step with a text
+//! that is edited line by line. The body is cut into top-level entries: an
+//! indent-0 line together with everything indented below it and the blank
+//! and comment lines that follow. An edit re-parses only the entries whose
+//! lines it touches, plus the entry just before them, and splices the new
+//! items into the document root; every other entry keeps its parsed items.
+//!
+//! Root-level matrix lists are cut further, into one block per row: the row
+//! line with the child rows, blank and comment lines below it. An edit that
+//! stays inside a list's rows re-parses only the blocks it touches, the block
+//! before them, and the blocks after while a changed row feeds a ditto (`^`)
+//! in the next one; the new rows replace the old ones in the list. Editing a
+//! row of a long list therefore does not re-lex the rest of the list.
+//!
+//! Checks that span entries are maintained incrementally. Root keys, node
+//! IDs and references are indexed per entry and per row block, and an edit
+//! re-checks only the references in the new entries and those pointing at
+//! IDs it added or removed. Edits inside the header fall back to a full
+//! re-parse.
+//!
+//! What an edit still costs beyond the lines it re-parses:
+//!
+//! - Finding the edited entry walks the top-level entries, which are bounded
+//!   by the root key count, not by the rows.
+//! - Inserting or removing rows moves the list's later rows in memory and
+//!   shifts its per-row line offsets; replacing rows one for one does neither.
+//! - Edits that add or remove an indent-0 line, or touch the lines before a
+//!   list's first row, re-parse whole entries, lists included.
+//!
+//! The handle keeps the text once, per entry and row block, as the source
+//! for re-parsing; the document itself holds none of it.
+//!
+//! After every successful edit the document equals what
+//! [`parse_with_limits`](crate::parse_with_limits) returns for the edited
+//! text. An edit the full parser would reject fails and leaves the document
+//! untouched.
+//!
+//! Edits are described with [`TextEdit`] from [`crate::lex::incremental`],
+//! whose line cache serves editor tooling but does not build documents.
+//!
+//! # Examples
+//!
+//! ```
+//! use hedl_core::lex::incremental::TextEdit;
+//! use hedl_core::{IncrementalDocument, Item, ParseOptions, Value};
+//!
+//! let text = "%VERSION: 1.0\n---\nname: demo\nport: 8080\n";
+//! let mut doc = IncrementalDocument::new(text.as_bytes(), ParseOptions::default()).unwrap();
+//!
+//! // Line 3 (0-indexed) is "port: 8080"
+//! doc.apply(&TextEdit::replace(3, 4, "port: 9090")).unwrap();
+//! assert_eq!(doc.document().root.get("port"), Some(&Item::Scalar(Value::Int(9090))));
+//!
+//! // A rejected edit leaves the document as it was
+//! assert!(doc.apply(&TextEdit::insert(4, "name: again")).is_err());
+//! assert_eq!(doc.line_count(), 5);
+//! ```
+
+use crate::block_string::{try_start_block_string, BlockStringResult};
+use crate::document::{Document, Item, Node};
+use crate::error::{HedlError, HedlResult};
+use crate::header::{parse_header, Header};
+use crate::lex::calculate_indent;
+use crate::lex::incremental::TextEdit;
+use crate::limits::Limits;
+use crate::parser::{parse_body, parse_list_rows, ParseOptions, RowMode, TreeSink};
+use crate::preprocess::{is_blank_line, is_comment_line, preprocess};
+use crate::reference::{check_nest_depth, check_reference, IdIndex, TypeRegistry};
+use crate::value::{Reference, Value};
+use std::borrow::BorrowMut;
+use std::collections::{BTreeMap, HashMap, HashSet};
+use std::ops::Range;
+
+// ==================== Entries ====================
+
+/// Text and cross-entry facts of one unit the body is cut into: a
+/// top-level entry, or one row block of a root-level matrix list.
+struct Unit {
+    /// Lines joined with `\n`.
+    text: String,
+    line_count: usize,
+    /// Node IDs as `(type, id, line)`, the line relative to the unit start.
+    ids: Vec<(String, String, usize)>,
+    /// References with the type of the row they appear in.
+    refs: Vec<(Reference, Option<String>)>,
+    /// Object keys, counted as the parser's `max_total_keys` check does.
+    keys: usize,
+}
+
+impl Unit {
+    fn new(lines: &[&str]) -> Self {
+        Self {
+            text: join_lines(lines.iter().copied()),
+            line_count: lines.len(),
+            ids: Vec::new(),
+            refs: Vec::new(),
+            keys: 0,
+        }
+    }
+
+    /// Bytes the unit adds to the document text, including its leading newline.
+    fn text_len(&self) -> usize {
+        self.text.len() + 1
+    }
+}
+
+/// One top-level entry of the body.
+struct Entry {
+    /// The entry's lines; for a list with `rows`, those before its first row.
+    unit: Unit,
+    /// Root key the entry defines; `None` for leading blank and comment lines.
+    key: Option<String>,
+    /// Row blocks of a root-level matrix list that has rows.
+    rows: Option<Rows>,
+}
+
+impl Entry {
+    /// Lines of the entry, row blocks included.
+    fn span(&self) -> usize {
+        self.unit.line_count + self.rows.as_ref().map_or(0, Rows::lines)
+    }
+}
+
+/// Row blocks of a root-level matrix list. A block is one row line with
+/// the child rows, blank and comment lines below it; it parses to exactly
+/// one row, so block `i` holds row `i` of the list.
+struct Rows {
+    blocks: Vec<u64>,
+    /// Lines in blocks `..=i`.
+    ends: Vec<usize>,
+}
+
+impl Rows {
+    fn lines(&self) -> usize {
+        self.ends.last().copied().unwrap_or(0)
+    }
+
+    /// First line of block `i` relative to the first row, or the end of
+    /// the rows for `i == blocks.len()`.
+    fn start(&self, i: usize) -> usize {
+        if i == 0 {
+            0
+        } else {
+            self.ends[i - 1]
+        }
+    }
+
+    /// Block holding row line `line`, or `blocks.len()` past the last row.
+    fn find(&self, line: usize) -> usize {
+        self.ends.partition_point(|&end| end <= line)
+    }
+}
+
+/// A row block and the list entry holding it.
+struct Block {
+    unit: Unit,
+    list: u64,
+}
+
+/// Body lines being replaced: `old_lines` from body line `start` before
+/// the edit, `new_lines` after it.
+struct Region {
+    start: usize,
+    old_lines: usize,
+    new_lines: usize,
+}
+
+/// An entry parsed from a region, not yet committed.
+struct NewEntry {
+    unit: Unit,
+    key: Option<String>,
+    item: Option<Item>,
+    /// Row blocks, when the entry is a root-level matrix list with rows.
+    blocks: Vec<Unit>,
+}
+
+impl NewEntry {
+    fn span(&self) -> usize {
+        self.unit.line_count + self.blocks.iter().map(|b| b.line_count).sum::<usize>()
+    }
+}
+
+/// Whether `line` starts a new top-level entry.
+fn starts_entry(line: &str) -> bool {
+    !line.starts_with(' ')
+        && !line.starts_with('\t')
+        && !is_blank_line(line)
+        && !is_comment_line(line)
+}
+
+/// Whether `line` is a row of a root-level matrix list.
+fn starts_row(line: &str) -> bool {
+    match calculate_indent(line, 0) {
+        Ok(Some(info)) => info.level == 1 && line[info.spaces..].starts_with('|'),
+        _ => false,
+    }
+}
+
+/// Positions of the lines that start row blocks.
+fn row_lines(lines: &[&str]) -> Vec<usize> {
+    (0..lines.len()).filter(|&i| starts_row(lines[i])).collect()
+}
+
+/// Whether the body parser enters block-string mode on `line`.
+fn opens_block_string(line: &str) -> bool {
+    if is_blank_line(line) || is_comment_line(line) {
+        return false;
+    }
+    let spaces = match calculate_indent(line, 0) {
+        Ok(Some(info)) => info.spaces,
+        _ => return false,
+    };
+    let content = &line[spaces..];
+    !content.starts_with('|')
+        && matches!(
+            try_start_block_string(content, 0, 0),
+            Ok(BlockStringResult::MultiLineStarted(_))
+        )
+}
+
+/// Split body lines into entry sizes, mirroring the body parser's view of
+/// block strings. Also returns whether a block string is still open at the end.
+fn split_entries(lines: &[&str]) -> (Vec<usize>, bool) {
+    let mut sizes = Vec::new();
+    let mut current = 0;
+    let mut in_block = false;
+
+    for line in lines {
+        if in_block {
+            in_block = !line.contains("\"\"\"");
+        } else {
+            if starts_entry(line) && current > 0 {
+                sizes.push(current);
+                current = 0;
+            }
+            in_block = opens_block_string(line);
+        }
+        current += 1;
+    }
+    if current > 0 {
+        sizes.push(current);
+    }
+    (sizes, in_block)
+}
+
+/// Hand the IDs in `registry` to `units`, which hold consecutive lines
+/// from absolute line `first_line` on.
+fn assign_ids<'a>(
+    units: impl IntoIterator<Item = &'a mut Unit>,
+    first_line: usize,
+    registry: &TypeRegistry,
+) {
+    let mut ids: Vec<(String, String, usize)> = registry
+        .entries()
+        .map(|(type_name, id, line)| (type_name.to_string(), id.to_string(), line))
+        .collect();
+    ids.sort_by_key(|&(_, _, line)| line);
+
+    let mut ids = ids.into_iter().peekable();
+    let mut start = first_line;
+    for unit in units {
+        let end = start + unit.line_count;
+        while let Some((type_name, id, line)) = ids.next_if(|&(_, _, line)| line < end) {
+            unit.ids.push((type_name, id, line - start));
+        }
+        start = end;
+    }
+}
+
+/// Collect a unit's references, key count and nesting depth the way
+/// reference resolution walks a full document.
+struct EntryWalker<'a> {
+    unit: &'a mut Unit,
+    strict: bool,
+    max_nest_depth: usize,
+}
+
+impl EntryWalker<'_> {
+    fn items(&mut self, items: &BTreeMap<String, Item>, depth: usize) -> HedlResult<()> {
+        check_nest_depth(depth, self.max_nest_depth)?;
+        self.unit.keys += items.len();
+
+        for item in items.values() {
+            match item {
+                Item::Scalar(value) => self.reference(value, None),
+                Item::List(list) => {
+                    for node in &list.rows {
+                        self.node(node, depth)?;
+                    }
+                }
+                Item::Object(obj) => self.items(obj, depth + 1)?,
+            }
+        }
+        Ok(())
+    }
+
+    fn node(&mut self, node: &Node, depth: usize) -> HedlResult<()> {
+        check_nest_depth(depth, self.max_nest_depth)?;
+
+        for value in &node.fields {
+            self.reference(value, Some(&node.type_name));
+        }
+        for child_list in node.children.values() {
+            for child in child_list {
+                self.node(child, depth + 1)?;
+            }
+        }
+        Ok(())
+    }
+
+    fn reference(&mut self, value: &Value, current_type: Option<&str>) {
+        if let Value::Reference(reference) = value {
+            // Lenient mode only rejects ambiguous unqualified key-value references
+            if self.strict || (reference.type_name.is_none() && current_type.is_none()) {
+                self.unit
+                    .refs
+                    .push((reference.clone(), current_type.map(str::to_string)));
+            }
+        }
+    }
+}
+
+// ==================== Live Index ====================
+
+/// Node IDs and references of the committed units.
+#[derive(Default)]
+struct LiveIndex {
+    /// type -> id -> (unit, line relative to its start)
+    by_type: HashMap<String, HashMap<String, (u64, usize)>>,
+    /// id -> types defining it
+    by_id: HashMap<String, Vec<String>>,
+    /// id -> units holding references to it
+    referrers: HashMap<String, Vec<u64>>,
+    nodes: usize,
+    keys: usize,
+}
+
+impl IdIndex for LiveIndex {
+    fn contains_in_type(&self, type_name: &str, id: &str) -> bool {
+        self.by_type
+            .get(type_name)
+            .map(|ids| ids.contains_key(id))
+            .unwrap_or(false)
+    }
+
+    fn types_with_id(&self, id: &str) -> Vec<&str> {
+        self.by_id
+            .get(id)
+            .map_or_else(Vec::new, |types| types.iter().map(String::as_str).collect())
+    }
+}
+
+impl LiveIndex {
+    /// First ID of `unit` that is already defined, with its definition.
+    fn collision<'u>(&self, unit: &'u Unit) -> Option<(&'u (String, String, usize), u64, usize)> {
+        unit.ids.iter().find_map(|def| {
+            let (type_name, id, _) = def;
+            self.by_type
+                .get(type_name)
+                .and_then(|ids| ids.get(id))
+                .map(|&(uid, line)| (def, uid, line))
+        })
+    }
+
+    fn add(&mut self, uid: u64, unit: &Unit) {
+        for (type_name, id, line) in &unit.ids {
+            self.by_type
+                .entry(type_name.clone())
+                .or_default()
+                .insert(id.clone(), (uid, *line));
+            self.by_id
+                .entry(id.clone())
+                .or_default()
+                .push(type_name.clone());
+        }
+        for (reference, _) in &unit.refs {
+            self.referrers
+                .entry(reference.id.clone())
+                .or_default()
+                .push(uid);
+        }
+        self.nodes += unit.ids.len();
+        self.keys += unit.keys;
+    }
+
+    fn remove(&mut self, uid: u64, unit: &Unit) {
+        for (type_name, id, _) in &unit.ids {
+            if let Some(ids) = self.by_type.get_mut(type_name) {
+                ids.remove(id);
+                if ids.is_empty() {
+                    self.by_type.remove(type_name);
+                }
+            }
+            if let Some(types) = self.by_id.get_mut(id) {
+                types.retain(|t| t != type_name);
+                if types.is_empty() {
+                    self.by_id.remove(id);
+                }
+            }
+        }
+        for (reference, _) in &unit.refs {
+            if let Some(uids) = self.referrers.get_mut(&reference.id) {
+                uids.retain(|&u| u != uid);
+                if uids.is_empty() {
+                    self.referrers.remove(&reference.id);
+                }
+            }
+        }
+        self.nodes -= unit.ids.len();
+        self.keys -= unit.keys;
+    }
+}
+
+/// The committed unit `uid`, an entry or a row block.
+fn unit_of<'a>(entries: &'a HashMap<u64, Entry>, blocks: &'a HashMap<u64, Block>, uid: u64) -> &'a Unit {
+    match entries.get(&uid) {
+        Some(entry) => &entry.unit,
+        None => &blocks[&uid].unit,
+    }
+}
+
+// ==================== Incremental Document ====================
+
+/// A parsed document that stays in sync with line-based text edits.
+///
+/// See the [module documentation](self) for how edits are applied.
+///
+/// The document is held in a `D`, so a wrapper can keep data derived from
+/// the document next to it (see [`IncrementalDocument::new_in`]).
+///
+/// # Thread Safety
+///
+/// Not synchronized; use one instance per document or guard it with a mutex.
+pub struct IncrementalDocument<D = Document> {
+    options: ParseOptions,
+    /// Header lines up to and including the `---` separator, joined with `\n`.
+    header_text: String,
+    header_lines: usize,
+    header: Header,
+    /// Entries by ID, and their order in the body.
+    entries: HashMap<u64, Entry>,
+    order: Vec<u64>,
+    /// Row blocks by ID; their order is kept by the list entry.
+    blocks: HashMap<u64, Block>,
+    next_uid: u64,
+    index: LiveIndex,
+    doc: D,
+    text_len: usize,
+    body_lines: usize,
+}
+
+impl IncrementalDocument {
+    /// Parse `input` and keep the state needed for incremental edits.
+    ///
+    /// Fails exactly when [`parse_with_limits`](crate::parse_with_limits)
+    /// fails for the same input and options.
+    pub fn new(input: &[u8], options: ParseOptions) -> HedlResult<Self> {
+        Self::new_in(input, options)
+    }
+}
+
+impl<D: BorrowMut<Document> + From<Document>> IncrementalDocument<D> {
+    /// [`IncrementalDocument::new`], holding the document in a `D`.
+    ///
+    /// Edits change the document only through `D::borrow_mut`, so a holder
+    /// can drop whatever it derived from the document there.
+    pub fn new_in(input: &[u8], options: ParseOptions) -> HedlResult<Self> {
+        let preprocessed = preprocess(input, &options.limits)?;
+        let lines: Vec<(usize, &str)> = preprocessed.lines().collect();
+        let (header, body_start_idx) = parse_header(&lines, &options.limits)?;
+
+        let header_text = join_lines(lines[..body_start_idx].iter().map(|&(_, line)| line));
+        let mut doc = Document::new(header.version);
+        doc.aliases = header.aliases.clone();
+        doc.structs = header.structs.clone();
+        doc.nests = header.nests.clone();
+
+        let mut this = Self {
+            options,
+            text_len: header_text.len(),
+            header_text,
+            header_lines: body_start_idx,
+            header,
+            entries: HashMap::new(),
+            order: Vec::new(),
+            blocks: HashMap::new(),
+            next_uid: 0,
+            index: LiveIndex::default(),
+            doc: D::from(doc),
+            body_lines: 0,
+        };
+
+        let body: Vec<&str> = lines[body_start_idx..]
+            .iter()
+            .map(|&(_, line)| line)
+            .collect();
+        let new_entries = this.parse_region(0, &body, false)?;
+        this.commit(0..0, new_entries)?;
+        Ok(this)
+    }
+
+    /// The current document.
+    #[inline]
+    pub fn document(&self) -> &Document {
+        self.doc.borrow()
+    }
+
+    /// The value holding the current document.
+    #[inline]
+    pub fn holder(&self) -> &D {
+        &self.doc
+    }
+
+    /// Number of lines in the current text.
+    #[inline]
+    pub fn line_count(&self) -> usize {
+        self.header_lines + self.body_lines
+    }
+
+    /// The current text, with line endings normalized to `\n`.
+    pub fn text(&self) -> String {
+        let mut text = String::with_capacity(self.text_len);
+        text.push_str(&self.header_text);
+        for uid in &self.order {
+            let entry = &self.entries[uid];
+            text.push('\n');
+            text.push_str(&entry.unit.text);
+            for block in entry.rows.iter().flat_map(|rows| &rows.blocks) {
+                text.push('\n');
+                text.push_str(&self.blocks[block].unit.text);
+            }
+        }
+        text
+    }
+
+    /// Replace lines `edit.start_line..edit.end_line` (0-indexed) with the
+    /// lines of `edit.new_text`.
+    ///
+    /// A trailing newline in `new_text` does not add an empty line, and an
+    /// empty `new_text` deletes the range. On error the document and text
+    /// are left unchanged.
+    pub fn apply(&mut self, edit: &TextEdit) -> HedlResult<()> {
+        let total = self.line_count();
+        if edit.start_line > edit.end_line || edit.end_line > total {
+            return Err(HedlError::syntax(
+                format!(
+                    "edit range {}..{} is outside the document's {} lines",
+                    edit.start_line, edit.end_line, total
+                ),
+                0,
+            ));
+        }
+
+        let new_lines = edit_lines(&edit.new_text, edit.start_line, &self.options.limits)?;
+
+        if edit.start_line < self.header_lines {
+            // Header changes can affect every entry
+            let text = self.text();
+            let mut lines: Vec<&str> = text.split('\n').collect();
+            lines.splice(
+                edit.start_line..edit.end_line,
+                new_lines.iter().map(String::as_str),
+            );
+            *self = Self::new_in(join_lines(lines).as_bytes(), self.options.clone())?;
+            return Ok(());
+        }
+
+        let start = edit.start_line - self.header_lines;
+        let end = edit.end_line - self.header_lines;
+        if self.apply_rows(start, end, &new_lines)? {
+            return Ok(());
+        }
+
+        // Entries touched by the edit, plus the one before: new lines at the
+        // start of the edit may continue it
+        let mut first = None;
+        let mut last = None;
+        let mut offset = 0;
+        for (pos, uid) in self.order.iter().enumerate() {
+            let lines = offset..offset + self.entries[uid].span();
+            if first.is_none() && start < lines.end {
+                first = Some(pos);
+            }
+            if end > start && lines.contains(&(end - 1)) {
+                last = Some(pos);
+            }
+            offset = lines.end;
+        }
+        // An insertion after the last line extends the last entry
+        let first = first.unwrap_or(self.order.len().saturating_sub(1));
+        let last = last.unwrap_or(first).max(first);
+        let lo = first.saturating_sub(1);
+        let mut hi = (last + 1).min(self.order.len());
+        let region_start = self.lines_before(lo);
+
+        let new_entries = loop {
+            let mut region: Vec<&str> = Vec::new();
+            let mut line = region_start;
+            for uid in &self.order[lo..hi] {
+                for text in self.entry_lines(*uid) {
+                    if line == start {
+                        region.extend(new_lines.iter().map(String::as_str));
+                    }
+                    if line < start || line >= end {
+                        region.push(text);
+                    }
+                    line += 1;
+                }
+            }
+            if line == start {
+                region.extend(new_lines.iter().map(String::as_str));
+            }
+
+            // A block string left open swallows the next entry
+            if split_entries(&region).1 && hi < self.order.len() {
+                hi += 1;
+                continue;
+            }
+            break self.parse_region(region_start, &region, hi < self.order.len())?;
+        };
+
+        self.commit(lo..hi, new_entries)
+    }
+
+    /// Apply an edit of body lines `start..end` that stays inside the rows
+    /// of one root-level matrix list by re-parsing only the row blocks it
+    /// touches. Returns `false`, changing nothing, for any other edit.
+    fn apply_rows(&mut self, start: usize, end: usize, new_lines: &[String]) -> HedlResult<bool> {
+        if new_lines.iter().any(|line| starts_entry(line)) {
+            return Ok(false);
+        }
+        let (pos, rows_start, touched) = match self.row_region(start, end) {
+            Some(found) => found,
+            None => return Ok(false),
+        };
+        let entry = &self.entries[&self.order[pos]];
+        let (key, rows) = match (&entry.key, &entry.rows) {
+            (Some(key), Some(rows)) => (key.as_str(), rows),
+            _ => return Ok(false),
+        };
+        let list = match self.document().root.get(key) {
+            Some(Item::List(list)) => list,
+            _ => return Ok(false),
+        };
+
+        let lo = touched.start;
+        let mut hi = touched.end;
+        let prev_row = lo.checked_sub(1).map(|i| list.rows[i].fields.clone());
+        let region_start = rows_start + rows.start(lo);
+        let first_line = self.header_lines + region_start + 1;
+
+        let (region, new_rows, registry) = loop {
+            let mut region: Vec<&str> = Vec::new();
+            let mut line = region_start;
+            for block in &rows.blocks[lo..hi] {
+                for text in self.blocks[block].unit.text.split('\n') {
+                    if line == start {
+                        region.extend(new_lines.iter().map(String::as_str));
+                    }
+                    if line < start || line >= end {
+                        region.push(text);
+                    }
+                    line += 1;
+                }
+            }
+            if line == start {
+                region.extend(new_lines.iter().map(String::as_str));
+            }
+
+            // Lines before the first row belong to the list's own lines
+            if region.first().is_some_and(|line| !starts_row(line)) {
+                return Ok(false);
+            }
+
+            let numbered: Vec<(usize, &str)> = region
+                .iter()
+                .enumerate()
+                .map(|(n, &line)| (first_line + n, line))
+                .collect();
+            let mut registry = TypeRegistry::new();
+            let new_rows = parse_list_rows(
+                &numbered,
+                &self.header,
+                &self.options.limits,
+                &mut registry,
+                key,
+                list,
+                prev_row.clone(),
+            )?;
+
+            // A changed last row alters a ditto in the next block
+            if hi < rows.blocks.len() {
+                let last_values = new_rows.last().map(|row| &row.fields).or(prev_row.as_ref());
+                let next_line = self.blocks[&rows.blocks[hi]].unit.text.split('\n').next();
+                if last_values != Some(&list.rows[hi - 1].fields)
+                    && next_line.is_some_and(|line| line.contains('^'))
+                {
+                    hi += 1;
+                    continue;
+                }
+            }
+            break (region, new_rows, registry);
+        };
+
+        let starts = row_lines(&region);
+        if starts.len() != new_rows.len() {
+            return Ok(false);
+        }
+        let mut new_blocks = Vec::with_capacity(starts.len());
+        for (n, row) in new_rows.iter().enumerate() {
+            let block_end = starts.get(n + 1).copied().unwrap_or(region.len());
+            let mut block = Unit::new(&region[starts[n]..block_end]);
+            self.walker(&mut block).node(row, 0)?;
+            new_blocks.push(block);
+        }
+        assign_ids(&mut new_blocks, first_line, &registry);
+
+        self.commit_rows(pos, lo..hi, region_start, new_blocks, new_rows)?;
+        Ok(true)
+    }
+
+    /// For an edit of body lines `start..end` inside the rows of one
+    /// root-level matrix list: the list's position, the body line of its
+    /// first row, and the blocks to re-parse, those the edit touches plus
+    /// the one before.
+    fn row_region(&self, start: usize, end: usize) -> Option<(usize, usize, Range<usize>)> {
+        // The edit's new lines continue the entry holding the line before it
+        let (pos, entry_start) = self.entry_at(start.checked_sub(1)?)?;
+        let entry = &self.entries[&self.order[pos]];
+        let rows = entry.rows.as_ref()?;
+        let rows_start = entry_start + entry.unit.line_count;
+        if start < rows_start || end > rows_start + rows.lines() {
+            return None;
+        }
+
+        let (row_start, row_end) = (start - rows_start, end - rows_start);
+        let first = rows.find(row_start);
+        // New lines at the start of a block may continue the one before
+        let lo = if first > 0 && row_start == rows.start(first) {
+            first - 1
+        } else {
+            first
+        };
+        let last = if row_end > row_start {
+            rows.find(row_end - 1)
+        } else {
+            first
+        };
+        Some((pos, rows_start, lo..(last + 1).min(rows.blocks.len())))
+    }
+
+    /// Position of the entry holding body line `line`, and its first line.
+    fn entry_at(&self, line: usize) -> Option<(usize, usize)> {
+        let mut start = 0;
+        for (pos, uid) in self.order.iter().enumerate() {
+            let end = start + self.entries[uid].span();
+            if line < end {
+                return Some((pos, start));
+            }
+            start = end;
+        }
+        None
+    }
+
+    /// Lines of entry `uid`, row blocks included.
+    fn entry_lines(&self, uid: u64) -> impl Iterator<Item = &str> + '_ {
+        let entry = &self.entries[&uid];
+        let blocks = entry.rows.iter().flat_map(|rows| &rows.blocks);
+        entry
+            .unit
+            .text
+            .split('\n')
+            .chain(blocks.flat_map(move |block| self.blocks[block].unit.text.split('\n')))
+    }
+
+    fn walker<'a>(&self, unit: &'a mut Unit) -> EntryWalker<'a> {
+        EntryWalker {
+            unit,
+            strict: self.options.strict_refs,
+            max_nest_depth: Limits::default().max_nest_depth,
+        }
+    }
+
+    /// Parse body lines starting at body line `region_start` into entries.
+    fn parse_region(
+        &self,
+        region_start: usize,
+        region: &[&str],
+        entries_follow: bool,
+    ) -> HedlResult<Vec<NewEntry>> {
+        let (sizes, _) = split_entries(region);
+        let mut new_entries = Vec::with_capacity(sizes.len());
+        let mut offset = 0;
+
+        for (i, &size) in sizes.iter().enumerate() {
+            let lines = &region[offset..offset + size];
+            let first_line = self.header_lines + region_start + offset + 1;
+            let numbered: Vec<(usize, &str)> = lines
+                .iter()
+                .enumerate()
+                .map(|(n, &line)| (first_line + n, line))
+                .collect();
+            let at_end = !entries_follow && i + 1 == sizes.len();
+
+            let mut registry = TypeRegistry::new();
+            let root = parse_body(
+                &mut TreeSink,
+                &numbered,
+                &self.header,
+                &self.options.limits,
+                &mut registry,
+                at_end,
+                RowMode::Sequential,
+                None,
+            )?;
+
+            // A root-level matrix list keeps one block per row
+            let starts = match root.values().next() {
+                Some(Item::List(list)) => Some(row_lines(lines))
+                    .filter(|starts| !starts.is_empty() && starts.len() == list.rows.len()),
+                _ => None,
+            };
+            let mut unit = Unit::new(lines);
+            let mut blocks = Vec::new();
+            match (starts, root.values().next()) {
+                (Some(starts), Some(Item::List(list))) => {
+                    unit = Unit::new(&lines[..starts[0]]);
+                    unit.keys = root.len();
+                    for (n, row) in list.rows.iter().enumerate() {
+                        let block_end = starts.get(n + 1).copied().unwrap_or(size);
+                        let mut block = Unit::new(&lines[starts[n]..block_end]);
+                        self.walker(&mut block).node(row, 0)?;
+                        blocks.push(block);
+                    }
+                }
+                _ => self.walker(&mut unit).items(&root, 0)?,
+            }
+            assign_ids(std::iter::once(&mut unit).chain(&mut blocks), first_line, &registry);
+
+            new_entries.push(NewEntry {
+                unit,
+                key: root.keys().next().cloned(),
+                item: root.into_values().next(),
+                blocks,
+            });
+            offset += size;
+        }
+        Ok(new_entries)
+    }
+
+    /// Replace entries `old` (positions in `order`) with `new_entries` after
+    /// running the checks that span entries.
+    fn commit(&mut self, old: Range<usize>, new_entries: Vec<NewEntry>) -> HedlResult<()> {
+        let region = Region {
+            start: self.lines_before(old.start),
+            old_lines: self.order[old.clone()]
+                .iter()
+                .map(|uid| self.entries[uid].span())
+                .sum(),
+            new_lines: new_entries.iter().map(NewEntry::span).sum(),
+        };
+        self.check_root_keys(&old, &region, &new_entries)?;
+
+        // Units in text order: each entry, then its row blocks
+        let old_uids: Vec<u64> = self.order[old.clone()]
+            .iter()
+            .flat_map(|uid| {
+                let blocks = self.entries[uid].rows.iter().flat_map(|rows| &rows.blocks);
+                std::iter::once(uid).chain(blocks).copied()
+            })
+            .collect();
+        let new_units: Vec<&Unit> = new_entries
+            .iter()
+            .flat_map(|new| std::iter::once(&new.unit).chain(&new.blocks))
+            .collect();
+        let mut uid = self.swap_units(&region, &old_uids, &new_units)?;
+
+        let root = &mut self.doc.borrow_mut().root;
+        for old_uid in &old_uids {
+            match self.entries.remove(old_uid) {
+                Some(entry) => {
+                    if let Some(key) = entry.key {
+                        root.remove(&key);
+                    }
+                }
+                None => {
+                    self.blocks.remove(old_uid);
+                }
+            }
+        }
+        let mut entry_uids = Vec::with_capacity(new_entries.len());
+        for new in new_entries {
+            let entry_uid = uid;
+            uid += 1;
+            let mut blocks = Vec::with_capacity(new.blocks.len());
+            let mut ends = Vec::with_capacity(new.blocks.len());
+            for block in new.blocks {
+                ends.push(ends.last().copied().unwrap_or(0) + block.line_count);
+                blocks.push(uid);
+                self.blocks.insert(
+                    uid,
+                    Block {
+                        unit: block,
+                        list: entry_uid,
+                    },
+                );
+                uid += 1;
+            }
+            if let (Some(key), Some(item)) = (&new.key, new.item) {
+                root.insert(key.clone(), item);
+            }
+            let rows = if blocks.is_empty() {
+                None
+            } else {
+                Some(Rows { blocks, ends })
+            };
+            self.entries.insert(
+                entry_uid,
+                Entry {
+                    unit: new.unit,
+                    key: new.key,
+                    rows,
+                },
+            );
+            entry_uids.push(entry_uid);
+        }
+        self.order.splice(old, entry_uids);
+        Ok(())
+    }
+
+    /// Replace blocks `old` of the list at position `pos` with `new_blocks`
+    /// and their rows, after running the checks that span entries.
+    fn commit_rows(
+        &mut self,
+        pos: usize,
+        old: Range<usize>,
+        region_start: usize,
+        new_blocks: Vec<Unit>,
+        new_rows: Vec<Node>,
+    ) -> HedlResult<()> {
+        let list_uid = self.order[pos];
+        let old_uids: Vec<u64> = match &self.entries[&list_uid].rows {
+            Some(rows) => rows.blocks[old.clone()].to_vec(),
+            None => Vec::new(),
+        };
+        let region = Region {
+            start: region_start,
+            old_lines: old_uids
+                .iter()
+                .map(|uid| self.blocks[uid].unit.line_count)
+                .sum(),
+            new_lines: new_blocks.iter().map(|block| block.line_count).sum(),
+        };
+        let new_units: Vec<&Unit> = new_blocks.iter().collect();
+        let first_uid = self.swap_units(&region, &old_uids, &new_units)?;
+
+        for uid in &old_uids {
+            self.blocks.remove(uid);
+        }
+        let entry = match self.entries.get_mut(&list_uid) {
+            Some(entry) => entry,
+            None => return Ok(()),
+        };
+        if let Some(rows) = entry.rows.as_mut() {
+            let count = new_blocks.len();
+            let mut end = rows.start(old.start);
+            let mut ends = Vec::with_capacity(count);
+            for (n, block) in new_blocks.into_iter().enumerate() {
+                end += block.line_count;
+                ends.push(end);
+                self.blocks.insert(
+                    first_uid + n as u64,
+                    Block {
+                        unit: block,
+                        list: list_uid,
+                    },
+                );
+            }
+            rows.blocks
+                .splice(old.clone(), (0..count as u64).map(|n| first_uid + n));
+            rows.ends.splice(old.clone(), ends);
+            if region.new_lines != region.old_lines {
+                for end in &mut rows.ends[old.start + count..] {
+                    *end = *end + region.new_lines - region.old_lines;
+                }
+            }
+            if rows.blocks.is_empty() {
+                entry.rows = None;
+            }
+        }
+
+        // Rows after an unchanged count stay where they are
+        if let Some(key) = &entry.key {
+            if let Some(Item::List(list)) = self.doc.borrow_mut().root.get_mut(key) {
+                list.rows.splice(old, new_rows);
+            }
+        }
+        Ok(())
+    }
+
+    /// Swap the units `old_uids` for `new_units` in the index after the
+    /// size, ID, limit and reference checks that span entries. The new
+    /// units are numbered consecutively from the returned ID.
+    fn swap_units(
+        &mut self,
+        region: &Region,
+        old_uids: &[u64],
+        new_units: &[&Unit],
+    ) -> HedlResult<u64> {
+        let old_len: usize = old_uids
+            .iter()
+            .map(|&uid| unit_of(&self.entries, &self.blocks, uid).text_len())
+            .sum();
+        let new_len: usize = new_units.iter().map(|unit| unit.text_len()).sum();
+        let text_len = self.text_len - old_len + new_len;
+        if text_len > self.options.limits.max_file_size {
+            return Err(HedlError::security(
+                format!(
+                    "file too large: exceeds limit of {} bytes",
+                    self.options.limits.max_file_size
+                ),
+                0,
+            ));
+        }
+
+        // Swap the region's IDs and references in the index
+        for &uid in old_uids {
+            self.index
+                .remove(uid, unit_of(&self.entries, &self.blocks, uid));
+        }
+        let first_uid = self.next_uid;
+        let mut added = 0;
+        let mut result = Ok(());
+        for (pos, &unit) in new_units.iter().enumerate() {
+            if let Some(((type_name, id, rel), other, other_rel)) = self.index.collision(unit) {
+                let here = self.new_unit_line(region, new_units, pos) + rel;
+                let there = if other >= first_uid {
+                    self.new_unit_line(region, new_units, (other - first_uid) as usize)
+                } else {
+                    self.committed_line(other, region)
+                } + other_rel;
+                result = Err(HedlError::collision(
+                    format!(
+                        "duplicate ID '{}' in type '{}', previously defined at line {}",
+                        id,
+                        type_name,
+                        here.min(there)
+                    ),
+                    here.max(there),
+                ));
+                break;
+            }
+            self.index.add(first_uid + pos as u64, unit);
+            added += 1;
+        }
+
+        if result.is_ok() {
+            result = self.check_limits(self.header_lines + region.start + 1);
+        }
+        if result.is_ok() {
+            result = self.check_references(old_uids, first_uid, new_units);
+        }
+        if let Err(e) = result {
+            for (pos, unit) in new_units.iter().enumerate().take(added) {
+                self.index.remove(first_uid + pos as u64, unit);
+            }
+            for &uid in old_uids {
+                self.index.add(uid, unit_of(&self.entries, &self.blocks, uid));
+            }
+            return Err(e);
+        }
+
+        self.next_uid += new_units.len() as u64;
+        self.text_len = text_len;
+        self.body_lines = self.body_lines + region.new_lines - region.old_lines;
+        Ok(first_uid)
+    }
+
+    /// Reject root keys that the new entries define twice or that a
+    /// committed entry outside the region already defines.
+    fn check_root_keys(
+        &self,
+        old: &Range<usize>,
+        region: &Region,
+        new_entries: &[NewEntry],
+    ) -> HedlResult<()> {
+        let old_keys: HashSet<&str> = self.order[old.clone()]
+            .iter()
+            .filter_map(|uid| self.entries[uid].key.as_deref())
+            .collect();
+        let mut new_keys = HashSet::new();
+
+        for (pos, new) in new_entries.iter().enumerate() {
+            let key = match &new.key {
+                Some(key) => key,
+                None => continue,
+            };
+            let here = self.new_entry_line(region, new_entries, pos);
+            if new_keys.insert(key.as_str())
+                && !(self.document().root.contains_key(key) && !old_keys.contains(key.as_str()))
+            {
+                continue;
+            }
+            // Reported at the later of the two definitions, like a full parse
+            let there = self
+                .order
+                .iter()
+                .find(|uid| self.entries[*uid].key.as_deref() == Some(key))
+                .filter(|uid| !self.order[old.clone()].contains(uid))
+                .map(|&uid| self.committed_line(uid, region))
+                .unwrap_or(here);
+            return Err(HedlError::semantic(
+                format!("duplicate key: {}", key),
+                here.max(there),
+            ));
+        }
+
+        let limits = &self.options.limits;
+        let root_keys = self.document().root.len() - old_keys.len() + new_keys.len();
+        if root_keys > limits.max_object_keys {
+            return Err(HedlError::security(
+                format!(
+                    "object has too many keys: {} (max: {})",
+                    limits.max_object_keys + 1,
+                    limits.max_object_keys
+                ),
+                self.header_lines + region.start + 1,
+            ));
+        }
+        Ok(())
+    }
+
+    /// Number of body lines in the entries before position `pos`.
+    fn lines_before(&self, pos: usize) -> usize {
+        self.order[..pos]
+            .iter()
+            .map(|uid| self.entries[uid].span())
+            .sum()
+    }
+
+    /// Absolute first line of new entry `pos` of the region.
+    fn new_entry_line(&self, region: &Region, new_entries: &[NewEntry], pos: usize) -> usize {
+        let before: usize = new_entries[..pos].iter().map(NewEntry::span).sum();
+        self.header_lines + region.start + before + 1
+    }
+
+    /// Absolute first line of new unit `pos` of the region.
+    fn new_unit_line(&self, region: &Region, new_units: &[&Unit], pos: usize) -> usize {
+        let before: usize = new_units[..pos].iter().map(|unit| unit.line_count).sum();
+        self.header_lines + region.start + before + 1
+    }
+
+    /// Absolute first line of a committed unit outside the region, as it
+    /// will be once the region is replaced.
+    fn committed_line(&self, uid: u64, region: &Region) -> usize {
+        let entry_line = |uid: u64| {
+            let pos = self.order.iter().position(|&u| u == uid).unwrap_or(0);
+            self.lines_before(pos)
+        };
+        let mut line = match self.blocks.get(&uid) {
+            Some(block) => {
+                let list = &self.entries[&block.list];
+                let row_line = list.rows.as_ref().map_or(0, |rows| {
+                    rows.start(rows.blocks.iter().position(|&b| b == uid).unwrap_or(0))
+                });
+                entry_line(block.list) + list.unit.line_count + row_line
+            }
+            None => entry_line(uid),
+        };
+        if line >= region.start + region.old_lines {
+            line = line + region.new_lines - region.old_lines;
+        }
+        self.header_lines + line + 1
+    }
+
+    fn check_limits(&self, line: usize) -> HedlResult<()> {
+        let limits = &self.options.limits;
+        if self.index.nodes > limits.max_nodes {
+            return Err(HedlError::security(
+                format!("too many nodes: exceeds limit of {}", limits.max_nodes),
+                line,
+            ));
+        }
+        if self.index.keys > limits.max_total_keys {
+            return Err(HedlError::security(
+                format!(
+                    "too many total keys: {} exceeds limit {}",
+                    self.index.keys, limits.max_total_keys
+                ),
+                line,
+            ));
+        }
+        Ok(())
+    }
+
+    /// Check the new units' references, and committed references to any
+    /// ID the edit added or removed. New units are numbered from `first_uid`.
+    fn check_references(
+        &self,
+        old_uids: &[u64],
+        first_uid: u64,
+        new_units: &[&Unit],
+    ) -> HedlResult<()> {
+        let strict = self.options.strict_refs;
+        for unit in new_units {
+            for (reference, current_type) in &unit.refs {
+                check_reference(reference, &self.index, strict, current_type.as_deref())?;
+            }
+        }
+
+        let changed: HashSet<&str> = old_uids
+            .iter()
+            .flat_map(|&uid| unit_of(&self.entries, &self.blocks, uid).ids.iter())
+            .chain(new_units.iter().flat_map(|unit| unit.ids.iter()))
+            .map(|(_, id, _)| id.as_str())
+            .collect();
+        let mut checked = HashSet::new();
+        for id in changed {
+            for &uid in self.index.referrers.get(id).into_iter().flatten() {
+                if uid >= first_uid || !checked.insert((uid, id)) {
+                    continue;
+                }
+                for (reference, current_type) in &unit_of(&self.entries, &self.blocks, uid).refs {
+                    if reference.id == id {
+                        check_reference(reference, &self.index, strict, current_type.as_deref())?;
+                    }
+                }
+            }
+        }
+        Ok(())
+    }
+}
+
+
+/// Join lines with `\n`.
+fn join_lines<'a>(lines: impl IntoIterator<Item = &'a str>) -> String {
+    let mut text = String::new();
+    for (i, line) in lines.into_iter().enumerate() {
+        if i > 0 {
+            text.push('\n');
+        }
+        text.push_str(line);
+    }
+    text
+}
+
+/// Split and validate the replacement text of an edit starting at line
+/// `first_line` (0-indexed), with the same per-line checks as preprocessing.
+fn edit_lines(text: &str, first_line: usize, limits: &Limits) -> HedlResult<Vec<String>> {
+    let preprocessed = preprocess(text.as_bytes(), limits).map_err(|mut e| {
+        if e.line > 0 {
+            e.line += first_line;
+        }
+        e
+    })?;
+    let mut lines: Vec<String> = preprocessed
+        .lines()
+        .map(|(_, line)| line.to_string())
+        .collect();
+    if text.is_empty() || text.ends_with('\n') {
+        lines.pop();
+    }
+    // Preprocessing drops a leading BOM; inside a document it is content
+    if text.starts_with('\u{FEFF}') {
+        if let Some(line) = lines.first_mut() {
+            line.insert(0, '\u{FEFF}');
+        }
+    }
+    Ok(lines)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::parser::parse_with_limits;
+    use std::borrow::Borrow;
+
+    const TEXT: &str = "%VERSION: 1.0\n\
+        %STRUCT: User: [id, name, manager]\n\
+        %STRUCT: Team: [id, lead]\n\
+        %STRUCT: Post: [id, title]\n\
+        %NEST: User > Post\n\
+        ---\n\
+        # settings\n\
+        name: demo\n\
+        config:\n  host: localhost\n  port: 8080\n\
+        users: @User\n  | alice, Alice, ~\n    | p1, Hello\n  | bob, Bob, @alice\n\
+        teams: @Team\n  | core, @User:bob\n\
+        owner: @User:alice\n";
+
+    fn options(strict: bool) -> ParseOptions {
+        ParseOptions::builder().strict(strict).build()
+    }
+
+    fn spliced(text: &str, edit: &TextEdit) -> String {
+        let mut lines: Vec<&str> = text.split('\n').collect();
+        let new_lines: Vec<&str> = edit.new_text.lines().collect();
+        lines.splice(edit.start_line..edit.end_line, new_lines);
+        lines.join("\n")
+    }
+
+    /// Apply `edit` and check the outcome against parsing the edited text.
+    fn check_edit(doc: &mut IncrementalDocument, edit: &TextEdit, strict: bool) -> bool {
+        let before = doc.text();
+        let expected_text = spliced(&before, edit);
+        let expected = parse_with_limits(expected_text.as_bytes(), options(strict));
+
+        match (doc.apply(edit), expected) {
+            (Ok(()), Ok(parsed)) => {
+                assert_eq!(doc.text(), expected_text);
+                assert_eq!(
+                    doc.document(),
+                    &parsed,
+                    "after {:?}:\n{}",
+                    edit,
+                    expected_text
+                );
+                true
+            }
+            (Err(_), Err(_)) => {
+                assert_eq!(doc.text(), before, "rejected edit changed the text");
+                false
+            }
+            (got, want) => panic!(
+                "verdicts differ after {:?}: incremental {:?}, full parse {:?}\n{}",
+                edit,
+                got.err(),
+                want.err(),
+                expected_text
+            ),
+        }
+    }
+
+    /// Holder counting mutable borrows of its document.
+    struct Counted {
+        doc: Document,
+        changes: usize,
+    }
+
+    impl From<Document> for Counted {
+        fn from(doc: Document) -> Self {
+            Self { doc, changes: 0 }
+        }
+    }
+
+    impl Borrow<Document> for Counted {
+        fn borrow(&self) -> &Document {
+            &self.doc
+        }
+    }
+
+    impl BorrowMut<Document> for Counted {
+        fn borrow_mut(&mut self) -> &mut Document {
+            self.changes += 1;
+            &mut self.doc
+        }
+    }
+
+    #[test]
+    fn test_holder_sees_each_change() {
+        let mut doc: IncrementalDocument<Counted> =
+            IncrementalDocument::new_in(TEXT.as_bytes(), options(true)).unwrap();
+        let changes = doc.holder().changes;
+
+        // A rejected edit leaves the document alone
+        assert!(doc
+            .apply(&TextEdit::replace(7, 8, "name: @nobody"))
+            .is_err());
+        assert_eq!(doc.holder().changes, changes);
+
+        doc.apply(&TextEdit::replace(7, 8, "name: other")).unwrap();
+        assert!(doc.holder().changes > changes);
+        assert_eq!(
+            doc.document(),
+            &parse_with_limits(doc.text().as_bytes(), options(true)).unwrap()
+        );
+    }
+
+    #[test]
+    fn test_new_matches_full_parse() {
+        for strict in [true, false] {
+            let doc = IncrementalDocument::new(TEXT.as_bytes(), options(strict)).unwrap();
+            assert_eq!(
+                doc.document(),
+                &parse_with_limits(TEXT.as_bytes(), options(strict)).unwrap()
+            );
+            assert_eq!(doc.text(), TEXT);
+            assert_eq!(doc.line_count(), TEXT.split('\n').count());
+        }
+        assert!(IncrementalDocument::new(b"%VERSION: 1.0\n---\na: @x\n", options(true)).is_err());
+    }
+
+    #[test]
+    fn test_scalar_edit_reparses_one_entry() {
+        let mut doc = IncrementalDocument::new(TEXT.as_bytes(), options(true)).unwrap();
+        assert!(check_edit(
+            &mut doc,
+            &TextEdit::replace(7, 8, "name: live"),
+            true
+        ));
+        assert_eq!(
+            doc.document().root.get("name"),
+            Some(&Item::Scalar(Value::String("live".to_string())))
+        );
+    }
+
+    #[test]
+    fn test_cross_entry_checks() {
+        let mut doc = IncrementalDocument::new(TEXT.as_bytes(), options(true)).unwrap();
+        let line_count = doc.line_count();
+        let rejected = [
+            // duplicate root key
+            TextEdit::insert(line_count - 1, "name: again"),
+            // duplicate ID in another entry
+            TextEdit::insert(line_count - 1, "more: @User\n  | alice, Again, ~"),
+            // removing bob breaks teams' reference
+            TextEdit::delete(14, 15),
+            // unresolved new reference
+            TextEdit::replace(7, 8, "name: @User:nobody"),
+        ];
+        for edit in &rejected {
+            assert!(!check_edit(&mut doc, edit, true), "{:?} should fail", edit);
+        }
+
+        // New IDs in a new entry can be referenced from it
+        assert!(check_edit(
+            &mut doc,
+            &TextEdit::insert(line_count - 1, "extra: @User\n  | carol, Carol, @User:bob"),
+            true
+        ));
+    }
+
+    #[test]
+    fn test_ambiguity_detected_when_lenient() {
+        let mut doc = IncrementalDocument::new(TEXT.as_bytes(), options(false)).unwrap();
+        let line_count = doc.line_count();
+        assert!(check_edit(
+            &mut doc,
+            &TextEdit::insert(line_count - 1, "who: @core"),
+            false
+        ));
+        // A User named "core" makes the unqualified reference ambiguous
+        assert!(!check_edit(
+            &mut doc,
+            &TextEdit::insert(15, "  | core, Core, ~"),
+            false
+        ));
+    }
+
+    #[test]
+    fn test_block_strings_and_header_edits() {
+        let mut doc = IncrementalDocument::new(TEXT.as_bytes(), options(true)).unwrap();
+        // An open block string swallows the following entries
+        assert!(!check_edit(
+            &mut doc,
+            &TextEdit::insert(7, "text: \"\"\""),
+            true
+        ));
+        assert!(check_edit(
+            &mut doc,
+            &TextEdit::insert(7, "text: \"\"\"\n  a: 1\nb: 2\n\"\"\""),
+            true
+        ));
+        // Header edits re-parse everything
+        assert!(check_edit(
+            &mut doc,
+            &TextEdit::replace(3, 4, "%STRUCT: Post: [id, body]"),
+            true
+        ));
+        assert!(!check_edit(&mut doc, &TextEdit::delete(1, 2), true));
+        assert!(doc
+            .apply(&TextEdit::insert(doc.line_count() + 1, "x: 1"))
+            .is_err());
+    }
+
+    #[test]
+    fn test_row_edit_reparses_touched_rows() {
+        let mut text = String::from("%VERSION: 1.0\n%STRUCT: Item: [id, n]\n---\nitems: @Item\n");
+        for i in 0..10_000 {
+            text.push_str(&format!("  | i{}, {}\n", i, i));
+        }
+        text.push_str("last: @Item:i0\n");
+        let mut doc = IncrementalDocument::new(text.as_bytes(), options(true)).unwrap();
+        let row_id = |doc: &IncrementalDocument, i: usize| match doc.document().root.get("items") {
+            Some(Item::List(list)) => list.rows[i].id.as_ptr(),
+            _ => panic!("items is not a list"),
+        };
+        let far = row_id(&doc, 9_000);
+        assert_eq!(doc.blocks.len(), 10_000);
+
+        // Line 4 is the first row
+        assert!(check_edit(&mut doc, &TextEdit::replace(104, 105, "  | i100, changed"), true));
+        assert!(check_edit(&mut doc, &TextEdit::insert(105, "  | new, ^"), true));
+        assert!(check_edit(&mut doc, &TextEdit::delete(105, 106), true));
+        assert!(!check_edit(&mut doc, &TextEdit::delete(4, 5), true));
+
+        // Rows away from the edits were neither re-parsed nor moved
+        assert_eq!(row_id(&doc, 9_000), far);
+        assert_eq!(doc.blocks.len(), 10_000);
+    }
+
+    #[test]
+    fn test_row_edits_follow_dittos() {
+        let text = "%VERSION: 1.0\n\
+            %STRUCT: User: [id, name, manager]\n\
+            %STRUCT: Post: [id, title]\n\
+            %NEST: User > Post\n\
+            ---\n\
+            users: @User\n  | a, A, ~\n  | b, ^, ^\n  | c, ^, @a\n    | p1, Hi\n  | d, ^, ^\n";
+        let mut doc = IncrementalDocument::new(text.as_bytes(), options(true)).unwrap();
+        // Changing "a" reaches every row that copies its name
+        assert!(check_edit(&mut doc, &TextEdit::replace(6, 7, "  | a, Z, ~"), true));
+        // Removing the rows before a ditto leaves it without a previous row
+        assert!(!check_edit(&mut doc, &TextEdit::delete(6, 7), true));
+        // Child rows move with the row they sit under
+        assert!(check_edit(&mut doc, &TextEdit::insert(10, "    | p2, More"), true));
+        assert!(check_edit(&mut doc, &TextEdit::delete(7, 8), true));
+        assert!(!check_edit(&mut doc, &TextEdit::replace(6, 7, "    | p3, Orphan"), true));
+    }
+
+    #[test]
+    fn test_random_edits_match_full_parse() {
+        let pool = [
+            "",
+            "# note",
+            "name: demo",
+            "title: x",
+            "config:",
+            "  host: example",
+            "  nested:",
+            "    deep: 1",
+            "users: @User",
+            "  | dave, Dave, @alice",
+            "  | erin, Erin, @zed",
+            "    | p9, Post",
+            "teams: @Team",
+            "  | ops, @User:dave",
+            "link: @dave",
+            "link2: @User:erin",
+            "text: \"\"\"",
+            "\"\"\"",
+            "  | alice, Alice, ~",
+            "zed: @Team:ops",
+        ];
+        let mut seed: u64 = 0x2545_f491_4f6c_dd1d;
+        let mut next = |bound: usize| {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            (seed % bound as u64) as usize
+        };
+
+        for strict in [true, false] {
+            let mut doc = IncrementalDocument::new(TEXT.as_bytes(), options(strict)).unwrap();
+            let mut accepted = 0;
+            for _ in 0..600 {
+                let body_start = 6;
+                let lines = doc.line_count();
+                let start = body_start + next(lines - body_start + 1);
+                let end = (start + next(3)).min(lines);
+                let new_text: Vec<&str> = (0..next(3)).map(|_| pool[next(pool.len())]).collect();
+                let edit = TextEdit::replace(start, end, new_text.join("\n"));
+                if check_edit(&mut doc, &edit, strict) {
+                    accepted += 1;
+                }
+            }
+            assert!(accepted > 50, "only {} edits accepted", accepted);
+        }
+    }
+
+    #[test]
+    fn test_random_row_edits_match_full_parse() {
+        let pool = [
+            "",
+            "  # note",
+            "  | u1, One, ~",
+            "  | u2, ^, @u1",
+            "  | u3, Three, ^",
+            "  | u4, ^, ^",
+            "    | q1, Post",
+            "    | q2, ^",
+            "  | u1, Again, ~",
+            "  name: x",
+            "   | odd, Indent, ~",
+            "\"\"\"",
+            "after: @User:u1",
+        ];
+        let mut text = String::from(
+            "%VERSION: 1.0\n\
+             %STRUCT: User: [id, name, manager]\n\
+             %STRUCT: Post: [id, title]\n\
+             %NEST: User > Post\n\
+             ---\n\
+             users: @User\n",
+        );
+        for i in 0..40 {
+            text.push_str(&format!("  | r{}, Row {}, ~\n", i, i));
+            if i % 3 == 0 {
+                text.push_str(&format!("    | p{}, Post {}\n", i, i));
+            }
+        }
+        text.push_str("owner: @User:r0\n");
+
+        let mut seed: u64 = 0x9e37_79b9_7f4a_7c15;
+        let mut next = |bound: usize| {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            (seed % bound as u64) as usize
+        };
+
+        for strict in [true, false] {
+            let mut doc = IncrementalDocument::new(text.as_bytes(), options(strict)).unwrap();
+            let mut accepted = 0;
+            for _ in 0..600 {
+                let body_start = 6;
+                let lines = doc.line_count();
+                let start = body_start + next(lines - body_start + 1);
+                let end = (start + next(3)).min(lines);
+                let new_text: Vec<&str> = (0..next(3)).map(|_| pool[next(pool.len())]).collect();
+                let edit = TextEdit::replace(start, end, new_text.join("\n"));
+                if check_edit(&mut doc, &edit, strict) {
+                    accepted += 1;
+                }
+            }
+            assert!(accepted > 100, "only {} edits accepted", accepted);
+        }
+    }
+}
@@ -39,23 +39,16 @@ pub struct IndentInfo {
 /// - `line_num`: Line number (1-indexed) for error reporting
 pub fn calculate_indent(line: &str, line_num: u32) -> Result<Option<IndentInfo>, LexError> {
     let bytes = line.as_bytes();
-    let mut spaces = 0;
-
-    // Count leading spaces and detect tabs in indentation
-    for &b in bytes {
-        match b {
-            b' ' => spaces += 1,
-            b'\t' => {
-                // Tab found - check if line is blank after this point (use bytes for speed)
-                if bytes[spaces..].iter().all(|&b| b.is_ascii_whitespace()) {
-                    return Ok(None);
-                }
-                return Err(LexError::TabInIndentation {
-                    pos: SourcePos::new(line_num as usize, spaces + 1),
-                });
-            }
-            _ => break,
+    let spaces = leading_spaces(bytes);
+
+    // Tab in indentation - fine only if the rest of the line is blank
+    if bytes.get(spaces) == Some(&b'\t') {
+        if bytes[spaces..].iter().all(|&b| b.is_ascii_whitespace()) {
+            return Ok(None);
         }
+        return Err(LexError::TabInIndentation {
+            pos: SourcePos::new(line_num as usize, spaces + 1),
+        });
     }
 
     // Check if line is blank (only spaces or all whitespace) - use bytes for speed
@@ -77,6 +70,27 @@ pub fn calculate_indent(line: &str, line_num: u32) -> Result<Option<IndentInfo>,
     }))
 }
 
+/// Count the leading ASCII spaces of `bytes`.
+///
+/// Compares eight bytes per step as one `u64` (SWAR): XOR with a word of
+/// spaces leaves zero bytes where the line has spaces, so the first non-space
+/// byte is found from the trailing zero count without a per-byte branch.
+#[inline]
+fn leading_spaces(bytes: &[u8]) -> usize {
+    const SPACES: u64 = u64::from_le_bytes([b' '; 8]);
+
+    let mut count = 0;
+    for chunk in bytes.chunks_exact(8) {
+        let word = u64::from_le_bytes(chunk.try_into().unwrap()) ^ SPACES;
+        if word != 0 {
+            return count + (word.trailing_zeros() / 8) as usize;
+        }
+        count += 8;
+    }
+    let tail = bytes[count..].iter().take_while(|&&b| b == b' ').count();
+    count + tail
+}
+
 /// Validate that indent level doesn't exceed maximum.
 ///
 /// # Parameters
@@ -368,4 +382,31 @@ mod tests {
         assert!(debug_str.contains("spaces: 4"));
         assert!(debug_str.contains("level: 2"));
     }
+
+    // ==================== leading_spaces ====================
+
+    #[test]
+    fn test_leading_spaces_matches_bytewise_count() {
+        for spaces in 0..40 {
+            for rest in ["", "x", "\t", " é", "abcdefghijklmnopq"] {
+                let line = format!("{}{}", " ".repeat(spaces), rest);
+                let expected = line.bytes().take_while(|&b| b == b' ').count();
+                assert_eq!(leading_spaces(line.as_bytes()), expected, "{:?}", line);
+            }
+        }
+    }
+
+    #[test]
+    fn test_calculate_indent_wide_indent() {
+        let line = format!("{}key: value", " ".repeat(34));
+        let result = calculate_indent(&line, 1).unwrap().unwrap();
+        assert_eq!(result.spaces, 34);
+        assert_eq!(result.level, 17);
+
+        let line = format!("{}\tkey", " ".repeat(18));
+        assert!(matches!(
+            calculate_indent(&line, 3),
+            Err(LexError::TabInIndentation { pos }) if pos.column() == 19
+        ));
+    }
 }
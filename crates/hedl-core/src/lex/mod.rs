@@ -151,7 +151,7 @@ pub use regions::{scan_regions, strip_comment, Region, RegionType};
 pub use lex_inference::{infer_cell_value, infer_value, TensorValue, Value};
 
 // Re-export CSV parsing (from row module which handles tensors correctly)
-pub use row::{parse_csv_row, CsvField};
+pub use row::{parse_csv_row, parse_csv_row_ref, CsvField, CsvFieldRef};
 
 // Re-export incremental parsing
 pub use incremental::{IncrementalParser, ParseResult, TextEdit};
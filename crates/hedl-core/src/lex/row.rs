@@ -28,8 +28,10 @@
 //! - Whitespace trimming for unquoted fields
 //! - Escape sequences in quoted fields: `\n`, `\t`, `\r`, `\\`, `\"`
 //! - Full UTF-8 support
+//! - Zero-copy field slices through [`parse_csv_row_ref`]
 
 use crate::lex::error::LexError;
+use std::borrow::Cow;
 
 /// A parsed CSV field with metadata.
 #[derive(Debug, Clone, PartialEq, Eq)]
@@ -79,33 +81,40 @@ impl std::fmt::Display for CsvField {
     }
 }
 
-/// Parser state machine states.
-#[derive(Debug, Clone, Copy, PartialEq, Eq)]
-enum State {
-    StartField,
-    InUnquotedField,
-    InQuotedField,
-    AfterQuote,
-    InExpression,
+/// A parsed CSV field that borrows its value from the row when it can.
+///
+/// Unquoted fields, and quoted fields without escapes, are slices of the
+/// input; only quoted fields containing `""` or backslash escapes allocate.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct CsvFieldRef<'a> {
+    /// The field value (unquoted, with escapes processed).
+    pub value: Cow<'a, str>,
+    /// Whether the field was enclosed in quotes.
+    pub is_quoted: bool,
 }
 
-/// Optimized field finalization that minimizes allocations.
-#[inline]
-fn finalize_unquoted_field(mut field: String) -> Result<String, LexError> {
-    let original_len = field.len();
-    let trimmed = field.trim();
+impl<'a> CsvFieldRef<'a> {
+    #[inline]
+    fn borrowed(value: &'a str, is_quoted: bool) -> Self {
+        Self {
+            value: Cow::Borrowed(value),
+            is_quoted,
+        }
+    }
 
-    if trimmed.contains('"') {
-        return Err(LexError::QuoteInUnquotedField(trimmed.to_string()));
+    /// Converts into an owned [`CsvField`], copying a borrowed value.
+    #[inline]
+    pub fn into_owned(self) -> CsvField {
+        match self.value {
+            Cow::Borrowed(value) => CsvField::from_borrowed(value, self.is_quoted),
+            Cow::Owned(value) => CsvField::from_owned(value, self.is_quoted),
+        }
     }
+}
 
-    if trimmed.len() == original_len {
-        Ok(field)
-    } else if trimmed.is_empty() {
-        field.clear();
-        Ok(field)
-    } else {
-        Ok(trimmed.to_string())
+impl AsRef<str> for CsvFieldRef<'_> {
+    fn as_ref(&self) -> &str {
+        &self.value
     }
 }
 
@@ -152,6 +161,32 @@ fn finalize_unquoted_field(mut field: String) -> Result<String, LexError> {
 /// - Unclosed expression
 /// - Quote character in unquoted field
 pub fn parse_csv_row(csv_string: &str) -> Result<Vec<CsvField>, LexError> {
+    parse_csv_row_ref(csv_string)
+        .map(|fields| fields.into_iter().map(CsvFieldRef::into_owned).collect())
+}
+
+/// Parses a CSV string into fields that borrow from `csv_string`.
+///
+/// Accepts and rejects exactly the same rows as [`parse_csv_row`], with the
+/// same field values, but unquoted fields are zero-copy slices (see
+/// [`CsvFieldRef`]). The matrix-row parser uses this form.
+///
+/// # Examples
+///
+/// ```
+/// use hedl_core::lex::parse_csv_row_ref;
+/// use std::borrow::Cow;
+///
+/// let row = r#"alice, "Smith, A.", 30"#;
+/// let fields = parse_csv_row_ref(row).unwrap();
+/// assert!(matches!(fields[0].value, Cow::Borrowed("alice")));
+/// assert_eq!(fields[1].value, "Smith, A.");
+/// ```
+///
+/// # Errors
+///
+/// Same as [`parse_csv_row`].
+pub fn parse_csv_row_ref(csv_string: &str) -> Result<Vec<CsvFieldRef<'_>>, LexError> {
     if csv_string.is_empty() {
         return Ok(Vec::new());
     }
@@ -161,157 +196,178 @@ pub fn parse_csv_row(csv_string: &str) -> Result<Vec<CsvField>, LexError> {
         return Err(LexError::TrailingComma);
     }
 
-    // Pre-allocate based on estimated field count
-    let estimated_fields = csv_string.bytes().filter(|&b| b == b',').count() + 1;
-    let mut fields = Vec::with_capacity(estimated_fields);
-
-    let estimated_field_capacity = (csv_string.len() / estimated_fields.max(1)).max(16);
-    let mut current_field = String::with_capacity(estimated_field_capacity);
-    let mut _current_is_quoted = false;
-    let mut state = State::StartField;
-    let mut expression_depth: usize = 0;
-    let mut bracket_depth: usize = 0;
-
-    let mut chars = csv_string.chars().peekable();
-
-    while let Some(ch) = chars.next() {
-        match state {
-            State::StartField => {
-                _current_is_quoted = false;
-                if ch.is_ascii_whitespace() {
-                    continue;
-                } else if ch == ',' {
-                    fields.push(CsvField::from_borrowed("", false));
-                } else if ch == '"' {
-                    _current_is_quoted = true;
-                    state = State::InQuotedField;
-                } else if ch == '$' && chars.peek() == Some(&'(') {
-                    chars.next();
-                    current_field.push_str("$(");
-                    state = State::InExpression;
-                    expression_depth = 1;
-                } else if ch == '[' {
-                    bracket_depth = 1;
-                    current_field.push(ch);
-                    state = State::InUnquotedField;
-                } else {
-                    state = State::InUnquotedField;
-                    current_field.push(ch);
-                }
-            }
+    let bytes = csv_string.as_bytes();
+    let mut fields = Vec::with_capacity(memchr::memchr_iter(b',', bytes).count() + 1);
+    let mut pos = 0;
 
-            State::InUnquotedField => {
-                if ch == '[' {
-                    bracket_depth += 1;
-                    current_field.push(ch);
-                } else if ch == ']' {
-                    bracket_depth = bracket_depth.saturating_sub(1);
-                    current_field.push(ch);
-                } else if ch == ',' && bracket_depth == 0 {
-                    let value = finalize_unquoted_field(std::mem::take(&mut current_field))?;
-                    fields.push(CsvField::from_owned(value, false));
-                    bracket_depth = 0;
-                    state = State::StartField;
-                } else {
-                    current_field.push(ch);
-                }
-            }
+    loop {
+        pos = skip_ascii_whitespace(bytes, pos);
+        if pos == bytes.len() {
+            break;
+        }
 
-            State::InQuotedField => {
-                if ch == '"' {
-                    if chars.peek() == Some(&'"') {
-                        chars.next();
-                        current_field.push('"');
-                    } else {
-                        state = State::AfterQuote;
-                    }
-                } else if ch == '\\' {
-                    if let Some(&next_ch) = chars.peek() {
-                        match next_ch {
-                            'n' => {
-                                chars.next();
-                                current_field.push('\n');
-                            }
-                            't' => {
-                                chars.next();
-                                current_field.push('\t');
-                            }
-                            'r' => {
-                                chars.next();
-                                current_field.push('\r');
-                            }
-                            '\\' => {
-                                chars.next();
-                                current_field.push('\\');
-                            }
-                            '"' => {
-                                chars.next();
-                                current_field.push('"');
-                            }
-                            _ => {
-                                current_field.push(ch);
-                            }
-                        }
-                    } else {
-                        current_field.push(ch);
+        // Index of the comma ending this field, if any
+        let end = match bytes[pos] {
+            b',' => {
+                fields.push(CsvFieldRef::borrowed("", false));
+                pos += 1;
+                continue;
+            }
+            b'"' => {
+                let (value, close) = scan_quoted(csv_string, pos + 1)?;
+                fields.push(CsvFieldRef {
+                    value,
+                    is_quoted: true,
+                });
+                let after = skip_ascii_whitespace(bytes, close + 1);
+                match bytes.get(after) {
+                    None => break,
+                    Some(b',') => after,
+                    Some(_) => {
+                        let ch = csv_string[after..].chars().next().unwrap_or_default();
+                        return Err(LexError::ExpectedCommaAfterQuote(ch));
                     }
-                } else {
-                    current_field.push(ch);
                 }
             }
-
-            State::AfterQuote => {
-                if ch.is_ascii_whitespace() {
-                    continue;
-                } else if ch == ',' {
-                    fields.push(CsvField::from_owned(
-                        std::mem::take(&mut current_field),
-                        true,
-                    ));
-                    state = State::StartField;
-                } else {
-                    return Err(LexError::ExpectedCommaAfterQuote(ch));
-                }
+            _ => {
+                let end = scan_unquoted(bytes, pos)?;
+                let value = finalize_unquoted_field(&csv_string[pos..end])?;
+                fields.push(CsvFieldRef::borrowed(value, false));
+                end
             }
+        };
 
-            State::InExpression => {
-                current_field.push(ch);
-                if ch == '(' {
-                    expression_depth += 1;
-                } else if ch == ')' {
-                    expression_depth = expression_depth.saturating_sub(1);
-                    if expression_depth == 0 {
-                        state = State::InUnquotedField;
-                    }
-                }
-            }
+        if end == bytes.len() {
+            break;
         }
+        pos = end + 1;
     }
 
-    // Handle end of string
-    match state {
-        State::InQuotedField => {
-            return Err(LexError::UnclosedQuote {
-                pos: crate::lex::error::SourcePos::default(),
-            });
-        }
-        State::InExpression => {
-            return Err(LexError::UnclosedExpression {
-                pos: crate::lex::error::SourcePos::default(),
-            });
+    Ok(fields)
+}
+
+// ==================== Field scanning ====================
+//
+// Every structural character is ASCII, so the scanners jump between them with
+// `memchr`, which compares 16 or 32 bytes per step (SSE2, AVX2 selected at
+// runtime, or NEON) and never splits a UTF-8 sequence.
+
+#[inline]
+fn skip_ascii_whitespace(bytes: &[u8], pos: usize) -> usize {
+    bytes[pos..]
+        .iter()
+        .position(|b| !b.is_ascii_whitespace())
+        .map_or(bytes.len(), |i| pos + i)
+}
+
+/// Finds the end of the unquoted field starting at `start`: the index of the
+/// next comma outside `$(...)` and `[...]`, or the row length.
+#[inline]
+fn scan_unquoted(bytes: &[u8], start: usize) -> Result<usize, LexError> {
+    let mut pos = if bytes[start..].starts_with(b"$(") {
+        skip_expression(bytes, start + 2)?
+    } else {
+        start
+    };
+
+    loop {
+        match memchr::memchr2(b',', b'[', &bytes[pos..]) {
+            None => return Ok(bytes.len()),
+            Some(i) if bytes[pos + i] == b',' => return Ok(pos + i),
+            Some(i) => pos = skip_brackets(bytes, pos + i + 1),
         }
-        State::AfterQuote => {
-            fields.push(CsvField::from_owned(current_field, true));
+    }
+}
+
+/// Returns the index after the `)` closing an expression whose `$(` ends
+/// before `pos`. Parentheses are counted, quotes inside are not special.
+fn skip_expression(bytes: &[u8], mut pos: usize) -> Result<usize, LexError> {
+    let mut depth = 1usize;
+    while let Some(i) = memchr::memchr2(b'(', b')', &bytes[pos..]) {
+        pos += i + 1;
+        if bytes[pos - 1] == b'(' {
+            depth += 1;
+        } else {
+            depth -= 1;
+            if depth == 0 {
+                return Ok(pos);
+            }
         }
-        State::InUnquotedField | State::StartField => {
-            if !current_field.is_empty() || state == State::InUnquotedField {
-                let value = finalize_unquoted_field(current_field)?;
-                fields.push(CsvField::from_owned(value, false));
+    }
+    Err(LexError::UnclosedExpression {
+        pos: crate::lex::error::SourcePos::default(),
+    })
+}
+
+/// Returns the index after the `]` closing a bracket opened before `pos`, or
+/// the row length if it is never closed.
+fn skip_brackets(bytes: &[u8], mut pos: usize) -> usize {
+    let mut depth = 1usize;
+    while let Some(i) = memchr::memchr2(b'[', b']', &bytes[pos..]) {
+        pos += i + 1;
+        if bytes[pos - 1] == b'[' {
+            depth += 1;
+        } else {
+            depth -= 1;
+            if depth == 0 {
+                return pos;
             }
         }
     }
+    bytes.len()
+}
 
-    Ok(fields)
+/// Trims an unquoted field and rejects stray quotes.
+#[inline]
+fn finalize_unquoted_field(field: &str) -> Result<&str, LexError> {
+    let trimmed = field.trim();
+    if memchr::memchr(b'"', trimmed.as_bytes()).is_some() {
+        return Err(LexError::QuoteInUnquotedField(trimmed.to_string()));
+    }
+    Ok(trimmed)
+}
+
+/// Scans a quoted field whose content starts at `start` (after the opening
+/// quote). Returns the value and the index of the closing quote; the value
+/// borrows from `s` unless it contains escapes.
+fn scan_quoted(s: &str, start: usize) -> Result<(Cow<'_, str>, usize), LexError> {
+    let bytes = s.as_bytes();
+    let mut value = String::new();
+    // Start of the text not yet copied into `value`
+    let mut run = start;
+    let mut pos = start;
+
+    while let Some(i) = memchr::memchr2(b'"', b'\\', &bytes[pos..]) {
+        let i = pos + i;
+        let unescaped = match (bytes[i], bytes.get(i + 1)) {
+            (b'"', Some(b'"')) => '"',
+            (b'"', _) => {
+                if run == start {
+                    return Ok((Cow::Borrowed(&s[start..i]), i));
+                }
+                value.push_str(&s[run..i]);
+                return Ok((Cow::Owned(value), i));
+            }
+            (_, Some(b'n')) => '\n',
+            (_, Some(b't')) => '\t',
+            (_, Some(b'r')) => '\r',
+            (_, Some(b'\\')) => '\\',
+            (_, Some(b'"')) => '"',
+            // Unknown escape or lone backslash - keep as-is
+            _ => {
+                pos = i + 1;
+                continue;
+            }
+        };
+        value.push_str(&s[run..i]);
+        value.push(unescaped);
+        run = i + 2;
+        pos = run;
+    }
+
+    Err(LexError::UnclosedQuote {
+        pos: crate::lex::error::SourcePos::default(),
+    })
 }
 
 #[cfg(test)]
@@ -489,4 +545,286 @@ mod tests {
         let field = CsvField::from_borrowed("hello", true);
         assert_eq!(format!("{}", field), "\"hello\"");
     }
+
+    // ==================== Differential tests ====================
+
+    /// The original character-at-a-time state machine, kept as an oracle for
+    /// the memchr-based scanner.
+    mod reference {
+        use super::super::CsvField;
+        use crate::lex::error::LexError;
+
+        /// Parser state machine states.
+        #[derive(Debug, Clone, Copy, PartialEq, Eq)]
+        enum State {
+            StartField,
+            InUnquotedField,
+            InQuotedField,
+            AfterQuote,
+            InExpression,
+        }
+
+        /// Owned-buffer field finalization of the character state machine.
+        #[inline]
+        fn finalize_owned_field(mut field: String) -> Result<String, LexError> {
+            let original_len = field.len();
+            let trimmed = field.trim();
+
+            if trimmed.contains('"') {
+                return Err(LexError::QuoteInUnquotedField(trimmed.to_string()));
+            }
+
+            if trimmed.len() == original_len {
+                Ok(field)
+            } else if trimmed.is_empty() {
+                field.clear();
+                Ok(field)
+            } else {
+                Ok(trimmed.to_string())
+            }
+        }
+
+        pub(super) fn parse_csv_row(csv_string: &str) -> Result<Vec<CsvField>, LexError> {
+            if csv_string.is_empty() {
+                return Ok(Vec::new());
+            }
+
+            // Check for trailing comma
+            if csv_string.trim_end().ends_with(',') {
+                return Err(LexError::TrailingComma);
+            }
+
+            // Pre-allocate based on estimated field count
+            let estimated_fields = csv_string.bytes().filter(|&b| b == b',').count() + 1;
+            let mut fields = Vec::with_capacity(estimated_fields);
+
+            let estimated_field_capacity = (csv_string.len() / estimated_fields.max(1)).max(16);
+            let mut current_field = String::with_capacity(estimated_field_capacity);
+            let mut _current_is_quoted = false;
+            let mut state = State::StartField;
+            let mut expression_depth: usize = 0;
+            let mut bracket_depth: usize = 0;
+
+            let mut chars = csv_string.chars().peekable();
+
+            while let Some(ch) = chars.next() {
+                match state {
+                    State::StartField => {
+                        _current_is_quoted = false;
+                        if ch.is_ascii_whitespace() {
+                            continue;
+                        } else if ch == ',' {
+                            fields.push(CsvField::from_borrowed("", false));
+                        } else if ch == '"' {
+                            _current_is_quoted = true;
+                            state = State::InQuotedField;
+                        } else if ch == '$' && chars.peek() == Some(&'(') {
+                            chars.next();
+                            current_field.push_str("$(");
+                            state = State::InExpression;
+                            expression_depth = 1;
+                        } else if ch == '[' {
+                            bracket_depth = 1;
+                            current_field.push(ch);
+                            state = State::InUnquotedField;
+                        } else {
+                            state = State::InUnquotedField;
+                            current_field.push(ch);
+                        }
+                    }
+
+                    State::InUnquotedField => {
+                        if ch == '[' {
+                            bracket_depth += 1;
+                            current_field.push(ch);
+                        } else if ch == ']' {
+                            bracket_depth = bracket_depth.saturating_sub(1);
+                            current_field.push(ch);
+                        } else if ch == ',' && bracket_depth == 0 {
+                            let value = finalize_owned_field(std::mem::take(&mut current_field))?;
+                            fields.push(CsvField::from_owned(value, false));
+                            bracket_depth = 0;
+                            state = State::StartField;
+                        } else {
+                            current_field.push(ch);
+                        }
+                    }
+
+                    State::InQuotedField => {
+                        if ch == '"' {
+                            if chars.peek() == Some(&'"') {
+                                chars.next();
+                                current_field.push('"');
+                            } else {
+                                state = State::AfterQuote;
+                            }
+                        } else if ch == '\\' {
+                            if let Some(&next_ch) = chars.peek() {
+                                match next_ch {
+                                    'n' => {
+                                        chars.next();
+                                        current_field.push('\n');
+                                    }
+                                    't' => {
+                                        chars.next();
+                                        current_field.push('\t');
+                                    }
+                                    'r' => {
+                                        chars.next();
+                                        current_field.push('\r');
+                                    }
+                                    '\\' => {
+                                        chars.next();
+                                        current_field.push('\\');
+                                    }
+                                    '"' => {
+                                        chars.next();
+                                        current_field.push('"');
+                                    }
+                                    _ => {
+                                        current_field.push(ch);
+                                    }
+                                }
+                            } else {
+                                current_field.push(ch);
+                            }
+                        } else {
+                            current_field.push(ch);
+                        }
+                    }
+
+                    State::AfterQuote => {
+                        if ch.is_ascii_whitespace() {
+                            continue;
+                        } else if ch == ',' {
+                            fields.push(CsvField::from_owned(
+                                std::mem::take(&mut current_field),
+                                true,
+                            ));
+                            state = State::StartField;
+                        } else {
+                            return Err(LexError::ExpectedCommaAfterQuote(ch));
+                        }
+                    }
+
+                    State::InExpression => {
+                        current_field.push(ch);
+                        if ch == '(' {
+                            expression_depth += 1;
+                        } else if ch == ')' {
+                            expression_depth = expression_depth.saturating_sub(1);
+                            if expression_depth == 0 {
+                                state = State::InUnquotedField;
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Handle end of string
+            match state {
+                State::InQuotedField => {
+                    return Err(LexError::UnclosedQuote {
+                        pos: crate::lex::error::SourcePos::default(),
+                    });
+                }
+                State::InExpression => {
+                    return Err(LexError::UnclosedExpression {
+                        pos: crate::lex::error::SourcePos::default(),
+                    });
+                }
+                State::AfterQuote => {
+                    fields.push(CsvField::from_owned(current_field, true));
+                }
+                State::InUnquotedField | State::StartField => {
+                    if !current_field.is_empty() || state == State::InUnquotedField {
+                        let value = finalize_owned_field(current_field)?;
+                        fields.push(CsvField::from_owned(value, false));
+                    }
+                }
+            }
+
+            Ok(fields)
+        }
+    }
+
+    #[test]
+    fn test_borrowed_fields() {
+        let fields = parse_csv_row_ref(r#"a, "b c", "d""e", $(f, g), [1, 2]"#).unwrap();
+        assert!(matches!(fields[0].value, Cow::Borrowed("a")));
+        assert!(matches!(fields[1].value, Cow::Borrowed("b c")));
+        assert!(matches!(fields[2].value, Cow::Owned(_)));
+        assert_eq!(fields[2].value, "d\"e");
+        assert!(matches!(fields[3].value, Cow::Borrowed("$(f, g)")));
+        assert!(matches!(fields[4].value, Cow::Borrowed("[1, 2]")));
+    }
+
+    #[test]
+    fn test_matches_reference_on_edge_cases() {
+        let cases = [
+            "",
+            " ",
+            ",a",
+            ", ,a",
+            "a,,b",
+            "\"a\" , b",
+            "\"a\"b",
+            "\"a\\",
+            "\"a\\q\"",
+            "\"\\\\n\"",
+            "$(a, \"b)\", c)",
+            "$(a) b, c",
+            "$(a)\"",
+            "x $(a, b)",
+            "[1, [2, 3]], 4",
+            "[1, 2",
+            "]a, b",
+            "$a, b",
+            "\u{a0}\"a\"",
+            "a\u{a0}, \u{a0}",
+            "\"é\"é",
+            "日本, 語",
+            "\"a\"\t\t",
+            "\t,\t",
+            "$(",
+            "$((a)",
+            "\"",
+            "a\"",
+        ];
+        for case in cases {
+            assert_eq!(
+                parse_csv_row(case),
+                reference::parse_csv_row(case),
+                "{:?}",
+                case
+            );
+        }
+    }
+
+    #[test]
+    fn test_matches_reference_on_random_rows() {
+        const PIECES: &[&str] = &[
+            "a", "bc", " ", ",", ", ", "\"", "\"\"", "\\", "\\n", "\\q", "$(", "(", ")", "[", "]",
+            "é", "\t", "\u{a0}", "1.5", "@User:x",
+        ];
+        let mut state = 0x2545_f491_4f6c_dd1du64;
+        let mut next = move || {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            state
+        };
+        for _ in 0..20_000 {
+            let len = (next() % 12) as usize;
+            let row: String = (0..len)
+                .map(|_| PIECES[(next() % PIECES.len() as u64) as usize])
+                .collect();
+            assert_eq!(
+                parse_csv_row(&row),
+                reference::parse_csv_row(&row),
+                "{:?}",
+                row
+            );
+        }
+    }
 }
@@ -35,24 +35,41 @@
 
 mod block_string;
 pub mod convert;
+pub mod diff;
 mod document;
 mod error;
 pub mod errors;
 mod header;
+mod incremental;
 mod inference;
 pub mod lex;
 mod limits;
+mod node_index;
 mod parser;
 mod preprocess;
+mod projection;
 mod reference;
+pub mod snapshot;
+mod symbol;
 pub mod traverse;
+mod validate;
 mod value;
 
+pub use diff::{
+    diff_documents, DocumentDiff, EntryDiff, ItemDiff, RowInsert, RowsDiff, DIFF_FORMAT_VERSION,
+};
 pub use document::{Document, Item, MatrixList, Node};
 pub use error::{HedlError, HedlErrorKind, HedlResult};
+pub use incremental::IncrementalDocument;
 pub use limits::Limits;
-pub use parser::{parse, parse_with_limits, ParseOptions, ParseOptionsBuilder};
+pub use node_index::NodeIndex;
+pub use parser::{parse, parse_projected, parse_with_limits, ParseOptions, ParseOptionsBuilder};
+#[cfg(feature = "parallel")]
+pub use parser::parse_parallel;
+pub use projection::Projection;
+pub use snapshot::{from_snapshot, to_snapshot, SNAPSHOT_FORMAT_VERSION};
 pub use traverse::{traverse, DocumentVisitor, StatsCollector, VisitorContext};
+pub use validate::validate;
 pub use value::{Reference, Value};
 
 // Re-export useful types from the consolidated lex module
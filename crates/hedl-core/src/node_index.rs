@@ -0,0 +1,292 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Hash index from `(type, id)` to the node defining it.
+//!
+//! Reference resolution during parsing only needs to know that an ID
+//! exists, so [`crate::resolve_references`] keeps no node locations. A
+//! [`NodeIndex`] is built once from a parsed [`Document`] and answers
+//! "which node is `@User:u1`?" with a single hash lookup instead of a scan
+//! over every matrix list.
+//!
+//! Like the parser's type registry, the index is keyed by ID alone: nearly
+//! every ID is defined by one type, so a qualified lookup checks one node
+//! and an unqualified lookup finds every candidate type at once. Keys borrow
+//! from the document, so the index allocates nothing per node beyond its
+//! hash table slot.
+//!
+//! # Example
+//!
+//! ```
+//! use hedl_core::{parse, Reference};
+//!
+//! let doc = parse(b"%VERSION: 1.0\n%STRUCT: User: [id,name]\n---\nusers: @User\n  | u1, Alice\n")
+//!     .unwrap();
+//! let index = doc.node_index();
+//!
+//! let alice = index.get("User", "u1").unwrap();
+//! assert_eq!(alice.id, "u1");
+//!
+//! let reference = Reference::qualified("User", "u1");
+//! assert!(index.resolve(&reference, None).unwrap().is_some());
+//! ```
+
+use crate::document::{Document, Item, Node};
+use crate::error::{HedlError, HedlResult};
+use crate::value::Reference;
+use std::collections::hash_map::Entry;
+use std::collections::HashMap;
+
+// =============================================================================
+// Index
+// =============================================================================
+
+/// Nodes defining one ID, in document order.
+enum Nodes<'a> {
+    /// The common case: one type defines the ID.
+    One(&'a Node),
+    /// The ID is defined by several types.
+    Many(Vec<&'a Node>),
+}
+
+impl<'a> Nodes<'a> {
+    fn as_slice(&self) -> &[&'a Node] {
+        match self {
+            Nodes::One(node) => std::slice::from_ref(node),
+            Nodes::Many(nodes) => nodes,
+        }
+    }
+
+    fn push(&mut self, node: &'a Node) {
+        match self {
+            Nodes::One(first) => *self = Nodes::Many(vec![*first, node]),
+            Nodes::Many(nodes) => nodes.push(node),
+        }
+    }
+}
+
+/// Index of every node in a document by type and ID.
+///
+/// The index borrows the document; rebuild it after the document changes.
+pub struct NodeIndex<'a> {
+    by_id: HashMap<&'a str, Nodes<'a>>,
+    len: usize,
+}
+
+impl<'a> NodeIndex<'a> {
+    /// Index every node of `doc`, including nested children.
+    ///
+    /// If a type defines an ID twice (only possible in documents that were
+    /// not produced by the parser), the first node in document order wins.
+    pub fn build(doc: &'a Document) -> Self {
+        let mut index = Self {
+            by_id: HashMap::new(),
+            len: 0,
+        };
+
+        // Explicit stacks keep arbitrarily deep documents off the call stack
+        let mut objects = vec![&doc.root];
+        let mut nodes: Vec<&'a Node> = Vec::new();
+        while let Some(object) = objects.pop() {
+            for item in object.values() {
+                match item {
+                    Item::List(list) => {
+                        nodes.extend(list.rows.iter().rev());
+                        while let Some(node) = nodes.pop() {
+                            index.insert(node);
+                            for children in node.children.values().rev() {
+                                nodes.extend(children.iter().rev());
+                            }
+                        }
+                    }
+                    Item::Object(child) => objects.push(child),
+                    Item::Scalar(_) => {}
+                }
+            }
+        }
+
+        index
+    }
+
+    fn insert(&mut self, node: &'a Node) {
+        match self.by_id.entry(node.id.as_str()) {
+            Entry::Vacant(slot) => {
+                slot.insert(Nodes::One(node));
+            }
+            Entry::Occupied(mut slot) => {
+                let defined = slot
+                    .get()
+                    .as_slice()
+                    .iter()
+                    .any(|n| n.type_name == node.type_name);
+                if defined {
+                    return;
+                }
+                slot.get_mut().push(node);
+            }
+        }
+        self.len += 1;
+    }
+
+    /// Number of indexed nodes.
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    /// Whether the document has no nodes.
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    /// The node of type `type_name` with ID `id`.
+    pub fn get(&self, type_name: &str, id: &str) -> Option<&'a Node> {
+        self.by_id
+            .get(id)?
+            .as_slice()
+            .iter()
+            .find(|node| node.type_name == type_name)
+            .copied()
+    }
+
+    /// Every node with ID `id`, one per defining type, in document order.
+    pub fn nodes_with_id(&self, id: &str) -> &[&'a Node] {
+        self.by_id.get(id).map_or(&[], Nodes::as_slice)
+    }
+
+    /// The node a reference points to, with the parser's scoping rules.
+    ///
+    /// `current_type` is the type of the row holding the reference, or
+    /// `None` for a key-value reference: a qualified reference looks only
+    /// in its type; an unqualified one looks only in `current_type` when
+    /// given (SPEC 10.2, 10.3) and otherwise in every type (SPEC 10.3.1).
+    ///
+    /// # Errors
+    ///
+    /// A reference error if an unqualified key-value reference matches IDs
+    /// in several types. An ID that is not defined is `Ok(None)`.
+    pub fn resolve(
+        &self,
+        reference: &Reference,
+        current_type: Option<&str>,
+    ) -> HedlResult<Option<&'a Node>> {
+        self.resolve_id(reference.type_name.as_deref(), &reference.id, current_type)
+    }
+
+    /// [`NodeIndex::resolve`] for a reference given as its parts.
+    pub fn resolve_id(
+        &self,
+        type_name: Option<&str>,
+        id: &str,
+        current_type: Option<&str>,
+    ) -> HedlResult<Option<&'a Node>> {
+        if let Some(type_name) = type_name.or(current_type) {
+            return Ok(self.get(type_name, id));
+        }
+        match self.nodes_with_id(id) {
+            [] => Ok(None),
+            [node] => Ok(Some(*node)),
+            nodes => {
+                let mut types: Vec<&str> = nodes.iter().map(|n| n.type_name.as_str()).collect();
+                types.sort_unstable();
+                Err(HedlError::reference(
+                    format!(
+                        "Ambiguous unqualified reference '@{}' matches multiple types: [{}]",
+                        id,
+                        types.join(", ")
+                    ),
+                    0,
+                ))
+            }
+        }
+    }
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::parse;
+
+    const SAMPLE: &str = "%VERSION: 1.0
+%STRUCT: User: [id,name]
+%STRUCT: Post: [id,title,author]
+%STRUCT: Team: [id,name]
+%NEST: User > Post
+---
+users: @User
+  | u1, Alice
+    | p1, Hello, @User:u1
+    | p2, World, ~
+  | u2, Bob
+    | p3, Hi, @User:u2
+groups:
+  teams: @Team
+    | u1, Core
+    | t2, Docs
+";
+
+    #[test]
+    fn test_finds_rows_and_nested_children() {
+        let doc = parse(SAMPLE.as_bytes()).unwrap();
+        let index = doc.node_index();
+
+        assert_eq!(index.len(), 7);
+        assert_eq!(index.get("User", "u2").unwrap().id, "u2");
+        assert_eq!(index.get("Post", "p3").unwrap().type_name, "Post");
+        assert_eq!(index.get("Team", "t2").unwrap().id, "t2");
+        assert!(index.get("User", "p1").is_none());
+        assert!(index.get("Nope", "u1").is_none());
+        assert_eq!(index.nodes_with_id("u1").len(), 2);
+    }
+
+    #[test]
+    fn test_resolve_follows_scoping_rules() {
+        let doc = parse(SAMPLE.as_bytes()).unwrap();
+        let index = doc.node_index();
+
+        let qualified = Reference::qualified("Team", "u1");
+        let node = index.resolve(&qualified, Some("User")).unwrap().unwrap();
+        assert_eq!(node.type_name, "Team");
+
+        let local = Reference::local("u1");
+        let node = index.resolve(&local, Some("User")).unwrap().unwrap();
+        assert_eq!(node.type_name, "User");
+        assert!(index.resolve(&local, Some("Post")).unwrap().is_none());
+
+        assert!(index.resolve(&local, None).is_err());
+        let unique = Reference::local("t2");
+        assert_eq!(
+            index.resolve(&unique, None).unwrap().unwrap().type_name,
+            "Team"
+        );
+        assert!(index
+            .resolve(&Reference::local("x9"), None)
+            .unwrap()
+            .is_none());
+    }
+
+    #[test]
+    fn test_empty_document() {
+        let doc = parse(b"%VERSION: 1.0\n---\nname: x\n").unwrap();
+        let index = doc.node_index();
+        assert!(index.is_empty());
+        assert!(index.nodes_with_id("x").is_empty());
+    }
+}
@@ -71,11 +71,17 @@ use crate::header::parse_header;
 use crate::inference::{infer_quoted_value, infer_value, InferenceContext};
 use crate::limits::Limits;
 use crate::preprocess::{is_blank_line, is_comment_line, preprocess};
-use crate::reference::{register_node, resolve_references, TypeRegistry};
+use crate::projection::{
+    has_references, project_schema, register_skipped_ids, select_lines, ColumnPlan, Projection,
+};
+use crate::reference::{
+    register_node, resolve_references, validate_references_with, TypeRegistry,
+};
 use crate::value::Value;
 use crate::lex::{calculate_indent, is_valid_key_token, is_valid_type_name, strip_comment};
-use crate::lex::row::parse_csv_row;
+use crate::lex::row::parse_csv_row_ref;
 use std::collections::BTreeMap;
+use std::sync::Arc;
 
 /// Parsing options for configuring HEDL document parsing behavior.
 ///
@@ -419,6 +425,102 @@ pub fn parse(input: &[u8]) -> HedlResult<Document> {
 
 /// Parse a HEDL document with custom options.
 pub fn parse_with_limits(input: &[u8], options: ParseOptions) -> HedlResult<Document> {
+    parse_document(input, options, RowMode::Sequential)
+}
+
+/// Parse a HEDL document, splitting long matrix lists across threads.
+///
+/// Runs of peer rows in a matrix list are cut into chunks whose CSV fields
+/// and values are parsed in parallel on the current rayon pool (call it
+/// inside [`rayon::ThreadPool::install`] to choose the thread count). ID
+/// registration, node limits and list building then run in row order, so
+/// the result, including which error is reported for an invalid document,
+/// is the same as [`parse_with_limits`].
+///
+/// Documents without lists of a few thousand rows gain nothing from this
+/// and are parsed sequentially.
+///
+/// Requires the `parallel` feature.
+#[cfg(feature = "parallel")]
+pub fn parse_parallel(input: &[u8], options: ParseOptions) -> HedlResult<Document> {
+    parse_document(
+        input,
+        options,
+        RowMode::Parallel {
+            chunk_rows: PARALLEL_CHUNK_ROWS,
+        },
+    )
+}
+
+/// Parse only the keys and columns named by `projection`.
+///
+/// Lines outside the projection's key paths are scanned for indentation and
+/// block strings but not parsed, and cells outside its column projections
+/// are never inferred, so the cost of the parse follows the size of the
+/// projected data. The result is the document a full parse would produce,
+/// minus the unselected items and columns; the projected types' `%STRUCT`
+/// schemas list their kept columns.
+///
+/// In strict mode, references from the projected data must resolve against
+/// the whole document: the IDs of skipped matrix rows are then registered
+/// from their first field. Errors in skipped regions are not reported,
+/// apart from duplicate IDs found this way.
+///
+/// # Errors
+///
+/// Everything [`parse_with_limits`] reports for the projected lines, plus
+/// a schema error for a column projection on an undefined type or column
+/// and a syntax error for an empty key path segment.
+pub fn parse_projected(
+    input: &[u8],
+    options: ParseOptions,
+    projection: &Projection,
+) -> HedlResult<Document> {
+    let preprocessed = preprocess(input, &options.limits)?;
+    let lines: Vec<(usize, &str)> = preprocessed.lines().collect();
+    let (mut header, body_start_idx) = parse_header(&lines, &options.limits)?;
+
+    let columns = ColumnPlan::compile(projection, &header.structs)?;
+    let body_lines = &lines[body_start_idx..];
+    let selection = select_lines(body_lines, projection)?;
+    let (kept, skipped) = match &selection {
+        Some(selection) => (&selection.kept[..], &selection.skipped[..]),
+        None => (body_lines, &[][..]),
+    };
+
+    let mut type_registries = TypeRegistry::new();
+    let root = parse_body(
+        &mut TreeSink,
+        kept,
+        &header,
+        &options.limits,
+        &mut type_registries,
+        true,
+        RowMode::Sequential,
+        columns.as_ref(),
+    )?;
+
+    // The registry already holds every parsed ID; skipped rows are only
+    // read when a reference could need them
+    if options.strict_refs && !skipped.is_empty() && has_references(&root) {
+        register_skipped_ids(skipped, &header.nests, &mut type_registries)?;
+    }
+
+    if let Some(columns) = &columns {
+        columns.project_structs(&mut header.structs);
+    }
+    let mut doc = Document::new(header.version);
+    doc.aliases = header.aliases;
+    doc.structs = header.structs;
+    doc.nests = header.nests;
+    doc.root = root;
+
+    validate_references_with(&doc, &type_registries, options.strict_refs, &options.limits)?;
+
+    Ok(doc)
+}
+
+fn parse_document(input: &[u8], options: ParseOptions, rows: RowMode) -> HedlResult<Document> {
     // Phase 1: Preprocess (zero-copy line splitting)
     let preprocessed = preprocess(input, &options.limits)?;
 
@@ -431,7 +533,16 @@ pub fn parse_with_limits(input: &[u8], options: ParseOptions) -> HedlResult<Docu
     // Phase 3: Parse body
     let body_lines = &lines[body_start_idx..];
     let mut type_registries = TypeRegistry::new();
-    let root = parse_body(body_lines, &header, &options.limits, &mut type_registries)?;
+    let root = parse_body(
+        &mut TreeSink,
+        body_lines,
+        &header,
+        &options.limits,
+        &mut type_registries,
+        true,
+        rows,
+        None,
+    )?;
 
     // Build document
     let mut doc = Document::new(header.version);
@@ -448,15 +559,14 @@ pub fn parse_with_limits(input: &[u8], options: ParseOptions) -> HedlResult<Docu
 
 // --- Context Stack ---
 
-#[derive(Debug)]
-enum Frame {
+enum Frame<S: BodySink> {
     Root {
-        object: BTreeMap<String, Item>,
+        object: S::Object,
     },
     Object {
         indent: usize,
         key: String,
-        object: BTreeMap<String, Item>,
+        object: S::Object,
     },
     List {
         #[allow(dead_code)]
@@ -464,37 +574,262 @@ enum Frame {
         row_indent: usize,
         type_name: String,
         schema: Vec<String>,
+        /// Projected column indices; rows then hold only these values.
+        columns: Option<Arc<[usize]>>,
         last_row_values: Option<Vec<Value>>,
-        list: Vec<Node>,
+        list: S::Rows,
         key: String,
         count_hint: Option<usize>,
     },
 }
 
+// --- Body Sinks ---
+
+/// Storage behind the body parser's frames.
+///
+/// [`parse_with_limits`] builds the document tree through [`TreeSink`];
+/// [`crate::validate`] plugs in a sink that keeps only what the structural
+/// checks need (object keys and row counts), so both share every line rule,
+/// limit and error message.
+pub(crate) trait BodySink {
+    /// Entries of the root or of an open object.
+    type Object: Default;
+    /// Rows of an open matrix list.
+    type Rows: Default;
+
+    fn object_len(object: &Self::Object) -> usize;
+    fn object_contains(object: &Self::Object, key: &str) -> bool;
+    fn rows_is_empty(rows: &Self::Rows) -> bool;
+
+    fn insert_scalar(&mut self, object: &mut Self::Object, key: String, value: Value);
+    fn insert_object(&mut self, parent: &mut Self::Object, key: String, object: Self::Object);
+    fn insert_list(&mut self, parent: &mut Self::Object, key: String, list: ClosedList<Self::Rows>);
+
+    /// Append a row that has already passed ID registration and node limits.
+    fn push_row(&mut self, rows: &mut Self::Rows, row: Row<'_>);
+
+    /// Attach a closed list to the last row of `rows` as its children.
+    fn attach_children(&mut self, rows: &mut Self::Rows, list: ClosedList<Self::Rows>);
+
+    /// Called when an object frame opens `depth` objects below the root.
+    fn open_object(&mut self, _depth: usize) {}
+}
+
+/// A matrix list whose frame has been popped.
+pub(crate) struct ClosedList<R> {
+    pub type_name: String,
+    pub schema: Vec<String>,
+    pub rows: R,
+    pub count_hint: Option<usize>,
+}
+
+/// A parsed matrix row handed to [`BodySink::push_row`].
+pub(crate) struct Row<'a> {
+    pub type_name: &'a str,
+    pub id: &'a str,
+    pub values: &'a [Value],
+    pub child_count: Option<usize>,
+    /// Depth as counted by reference resolution: objects above the list
+    /// plus one per enclosing NEST level.
+    pub depth: usize,
+    /// IDs registered so far, including this row's.
+    pub registry: &'a TypeRegistry,
+}
+
+/// How [`parse_body`] handles matrix rows.
+#[derive(Debug, Clone, Copy)]
+pub(crate) enum RowMode {
+    /// One row at a time.
+    Sequential,
+    /// Long runs of peer rows are inferred in parallel, `chunk_rows` per task.
+    #[cfg(feature = "parallel")]
+    Parallel { chunk_rows: usize },
+}
+
+/// Builds the [`Document`] tree.
+pub(crate) struct TreeSink;
+
+impl BodySink for TreeSink {
+    type Object = BTreeMap<String, Item>;
+    type Rows = Vec<Node>;
+
+    fn object_len(object: &Self::Object) -> usize {
+        object.len()
+    }
+
+    fn object_contains(object: &Self::Object, key: &str) -> bool {
+        object.contains_key(key)
+    }
+
+    fn rows_is_empty(rows: &Self::Rows) -> bool {
+        rows.is_empty()
+    }
+
+    fn insert_scalar(&mut self, object: &mut Self::Object, key: String, value: Value) {
+        object.insert(key, Item::Scalar(value));
+    }
+
+    fn insert_object(&mut self, parent: &mut Self::Object, key: String, object: Self::Object) {
+        // Note: max_object_keys limit check is performed at a higher level
+        // during parsing, not here, to provide better error context
+        parent.insert(key, Item::Object(object));
+    }
+
+    fn insert_list(
+        &mut self,
+        parent: &mut Self::Object,
+        key: String,
+        list: ClosedList<Self::Rows>,
+    ) {
+        let mut matrix_list = if let Some(count) = list.count_hint {
+            MatrixList::with_count_hint(list.type_name, list.schema, count)
+        } else {
+            MatrixList::new(list.type_name, list.schema)
+        };
+        matrix_list.rows = list.rows;
+        parent.insert(key, Item::List(matrix_list));
+    }
+
+    fn push_row(&mut self, rows: &mut Self::Rows, row: Row<'_>) {
+        let mut node = Node::new(row.type_name, row.id, row.values.to_vec());
+
+        // Store child count from |N| syntax if present
+        if let Some(count) = row.child_count {
+            node.set_child_count(count);
+        }
+
+        rows.push(node);
+    }
+
+    fn attach_children(&mut self, rows: &mut Self::Rows, list: ClosedList<Self::Rows>) {
+        // Attach children to the last node in the list
+        if let Some(parent_node) = rows.last_mut() {
+            parent_node
+                .children
+                .entry(list.type_name)
+                .or_default()
+                .extend(list.rows);
+        }
+    }
+}
+
 // --- Body Parsing ---
 
-fn parse_body(
+/// Parse body lines into the root object.
+///
+/// `at_end` says whether `lines` run to the end of the document: only then
+/// is an object left open without children a truncated input.
+/// `columns` projects the rows of the listed types as they are inferred.
+#[allow(clippy::too_many_arguments)]
+pub(crate) fn parse_body<S: BodySink>(
+    sink: &mut S,
     lines: &[(usize, &str)],
     header: &crate::header::Header,
     limits: &Limits,
     type_registries: &mut TypeRegistry,
-) -> HedlResult<BTreeMap<String, Item>> {
-    let mut stack: Vec<Frame> = vec![Frame::Root {
-        object: BTreeMap::new(),
+    at_end: bool,
+    #[cfg_attr(not(feature = "parallel"), allow(unused_variables))] rows: RowMode,
+    columns: Option<&ColumnPlan>,
+) -> HedlResult<S::Object> {
+    let mut stack: Vec<Frame<S>> = vec![Frame::Root {
+        object: S::Object::default(),
     }];
+    parse_lines(
+        sink,
+        &mut stack,
+        lines,
+        header,
+        limits,
+        type_registries,
+        rows,
+        columns,
+    )?;
+
+    // Finalize: pop all frames and build result
+    finalize_stack(sink, stack, at_end)
+}
+
+/// Parse a run of rows, with their child rows, of the root-level matrix
+/// list `list` stored under `key`, as if they followed a row holding
+/// `prev_row` in that list. Returns the rows parsed.
+///
+/// Every line must belong to the list: the caller keeps indent-0 lines out.
+pub(crate) fn parse_list_rows(
+    lines: &[(usize, &str)],
+    header: &crate::header::Header,
+    limits: &Limits,
+    type_registries: &mut TypeRegistry,
+    key: &str,
+    list: &MatrixList,
+    prev_row: Option<Vec<Value>>,
+) -> HedlResult<Vec<Node>> {
+    let mut stack: Vec<Frame<TreeSink>> = vec![
+        Frame::Root {
+            object: BTreeMap::new(),
+        },
+        Frame::List {
+            list_start_indent: 0,
+            row_indent: 1,
+            type_name: list.type_name.clone(),
+            schema: list.schema.clone(),
+            columns: None,
+            last_row_values: prev_row,
+            list: Vec::new(),
+            key: key.to_string(),
+            count_hint: None,
+        },
+    ];
+    let mut sink = TreeSink;
+    parse_lines(
+        &mut sink,
+        &mut stack,
+        lines,
+        header,
+        limits,
+        type_registries,
+        RowMode::Sequential,
+        None,
+    )?;
+
+    // Close the child lists of the last row
+    pop_frames(&mut sink, &mut stack, 1);
+    match stack.pop() {
+        Some(Frame::List { list, .. }) if stack.len() == 1 => Ok(list),
+        _ => Err(HedlError::syntax(
+            format!("rows of list '{}' continue outside it", key),
+            lines.last().map_or(0, |&(line_num, _)| line_num),
+        )),
+    }
+}
+
+/// Parse body lines into the frames on `stack`, leaving them open.
+#[allow(clippy::too_many_arguments)]
+fn parse_lines<S: BodySink>(
+    sink: &mut S,
+    stack: &mut Vec<Frame<S>>,
+    lines: &[(usize, &str)],
+    header: &crate::header::Header,
+    limits: &Limits,
+    type_registries: &mut TypeRegistry,
+    #[cfg_attr(not(feature = "parallel"), allow(unused_variables))] rows: RowMode,
+    columns: Option<&ColumnPlan>,
+) -> HedlResult<()> {
     let mut node_count = 0usize;
     let mut total_keys = 0usize;
     let mut block_string: Option<BlockStringState> = None;
 
-    for &(line_num, line) in lines {
+    let mut rest = lines;
+    while let Some((&(line_num, line), tail)) = rest.split_first() {
+        rest = tail;
+
         // Handle block string accumulation mode
         if let Some(ref mut state) = block_string {
             // Process the line and check if block string is complete
             if let Some(full_content) = state.process_line(line, line_num, limits)? {
                 // Block string is complete
                 let value = Value::String(full_content);
-                pop_frames(&mut stack, state.indent);
-                insert_into_current(&mut stack, state.key.clone(), Item::Scalar(value));
+                pop_frames(sink, stack, state.indent);
+                insert_into_current(sink, stack, state.key.clone(), value);
                 block_string = None;
             }
             continue;
@@ -528,12 +863,13 @@ fn parse_body(
         let content = &line[indent_info.spaces..];
 
         // Pop frames as needed based on indentation
-        pop_frames(&mut stack, indent);
+        pop_frames(sink, stack, indent);
 
         // Classify and parse line
         if content.starts_with('|') {
             parse_matrix_row(
-                &mut stack,
+                sink,
+                stack,
                 content,
                 indent,
                 line_num,
@@ -541,18 +877,53 @@ fn parse_body(
                 limits,
                 type_registries,
                 &mut node_count,
+                columns,
             )?;
+
+            #[cfg(feature = "parallel")]
+            if let RowMode::Parallel { chunk_rows } = rows {
+                // Rows of the list on top of the stack, not of a list further down
+                let on_top = matches!(
+                    stack.last(),
+                    Some(Frame::List { row_indent, .. }) if *row_indent == indent
+                );
+                let run = peer_row_run(rest, indent_info.spaces);
+                if on_top && run >= 2 * chunk_rows {
+                    parse_row_run(
+                        sink,
+                        stack,
+                        &rest[..run],
+                        indent_info.spaces,
+                        chunk_rows,
+                        header,
+                        limits,
+                        type_registries,
+                        &mut node_count,
+                    )?;
+                    rest = &rest[run..];
+                }
+            }
         } else {
             // Check if this starts a block string
             match try_start_block_string(content, indent, line_num)? {
                 BlockStringResult::MultiLineStarted(state) => {
                     // Validate indent and check for duplicate key
-                    validate_indent_for_child(&stack, indent, line_num)?;
-                    check_duplicate_key(&stack, &state.key, line_num, limits, &mut total_keys)?;
+                    validate_indent_for_child(stack, indent, line_num)?;
+                    check_duplicate_key(stack, &state.key, line_num, limits, &mut total_keys)?;
                     block_string = Some(state);
                 }
                 BlockStringResult::NotBlockString => {
-                    parse_non_matrix_line(&mut stack, content, indent, line_num, header, limits, &mut total_keys)?;
+                    parse_non_matrix_line(
+                        sink,
+                        stack,
+                        content,
+                        indent,
+                        line_num,
+                        header,
+                        limits,
+                        &mut total_keys,
+                        columns,
+                    )?;
                 }
             }
         }
@@ -568,13 +939,11 @@ fn parse_body(
             state.start_line,
         ));
     }
-
-    // Finalize: pop all frames and build result
-    finalize_stack(stack)
+    Ok(())
 }
 
 
-fn pop_frames(stack: &mut Vec<Frame>, current_indent: usize) {
+fn pop_frames<S: BodySink>(sink: &mut S, stack: &mut Vec<Frame<S>>, current_indent: usize) {
     while stack.len() > 1 {
         let should_pop = match stack.last().unwrap() {
             Frame::Root { .. } => false,
@@ -584,71 +953,68 @@ fn pop_frames(stack: &mut Vec<Frame>, current_indent: usize) {
 
         if should_pop {
             let frame = stack.pop().unwrap();
-            attach_frame_to_parent(stack, frame);
+            attach_frame_to_parent(sink, stack, frame);
         } else {
             break;
         }
     }
 }
 
-fn attach_frame_to_parent(stack: &mut [Frame], frame: Frame) {
+fn attach_frame_to_parent<S: BodySink>(sink: &mut S, stack: &mut [Frame<S>], frame: Frame<S>) {
+    let parent = match stack.last_mut() {
+        Some(parent) => parent,
+        None => return,
+    };
+
     match frame {
-        Frame::Object { key, object, .. } => {
-            let item = Item::Object(object);
-            insert_into_parent(stack, key, item);
-        }
+        Frame::Object { key, object, .. } => match parent {
+            Frame::Root { object: parent } | Frame::Object { object: parent, .. } => {
+                sink.insert_object(parent, key, object);
+            }
+            // Objects never open inside a list context
+            Frame::List { .. } => {}
+        },
         Frame::List {
             key,
             type_name,
             schema,
+            columns,
             list,
             count_hint,
             ..
         } => {
-            let mut matrix_list = if let Some(count) = count_hint {
-                MatrixList::with_count_hint(type_name, schema, count)
-            } else {
-                MatrixList::new(type_name, schema)
+            let schema = match columns {
+                Some(kept) => project_schema(schema, &kept),
+                None => schema,
             };
-            matrix_list.rows = list;
-            insert_into_parent(stack, key, Item::List(matrix_list));
-        }
-        Frame::Root { .. } => {}
-    }
-}
-
-fn insert_into_parent(stack: &mut [Frame], key: String, item: Item) {
-    if let Some(parent) = stack.last_mut() {
-        match parent {
-            Frame::Root { object } | Frame::Object { object, .. } => {
-                // Note: max_object_keys limit check is performed at a higher level
-                // during parsing, not here, to provide better error context
-                object.insert(key, item);
-            }
-            Frame::List { list, .. } => {
-                // Attach children to the last node in the list
-                if let Some(parent_node) = list.last_mut() {
-                    if let Item::List(child_list) = item {
-                        parent_node
-                            .children
-                            .entry(child_list.type_name.clone())
-                            .or_default()
-                            .extend(child_list.rows);
-                    }
+            let closed = ClosedList {
+                type_name,
+                schema,
+                rows: list,
+                count_hint,
+            };
+            match parent {
+                Frame::Root { object } | Frame::Object { object, .. } => {
+                    sink.insert_list(object, key, closed);
                 }
+                Frame::List { list, .. } => sink.attach_children(list, closed),
             }
         }
+        Frame::Root { .. } => {}
     }
 }
 
-fn parse_non_matrix_line(
-    stack: &mut Vec<Frame>,
+#[allow(clippy::too_many_arguments)]
+fn parse_non_matrix_line<S: BodySink>(
+    sink: &mut S,
+    stack: &mut Vec<Frame<S>>,
     content: &str,
     indent: usize,
     line_num: usize,
     header: &crate::header::Header,
     limits: &Limits,
     total_keys: &mut usize,
+    columns: Option<&ColumnPlan>,
 ) -> HedlResult<()> {
     let content = strip_comment(content);
 
@@ -686,8 +1052,10 @@ fn parse_non_matrix_line(
         stack.push(Frame::Object {
             indent,
             key: key.to_string(),
-            object: BTreeMap::new(),
+            object: S::Object::default(),
         });
+        let depth = stack.iter().filter(|f| matches!(f, Frame::Object { .. })).count();
+        sink.open_object(depth);
     } else if after_colon_trimmed.starts_with('@') && is_list_start(after_colon_trimmed) {
         // Matrix list start
         if !after_colon.starts_with(' ') {
@@ -701,6 +1069,7 @@ fn parse_non_matrix_line(
         let parent_list_idx = validate_nested_list_indent(stack, indent, line_num)?;
 
         let (type_name, schema) = parse_list_start(after_colon_trimmed, line_num, header, limits)?;
+        let columns = columns.and_then(|c| c.get(&type_name));
 
         if let Some(_parent_idx) = parent_list_idx {
             // This is a nested list inside a list context (e.g., divisions(3): @Division under a company row)
@@ -710,8 +1079,9 @@ fn parse_non_matrix_line(
                 row_indent: indent + 1,
                 type_name,
                 schema,
+                columns,
                 last_row_values: None,
-                list: Vec::new(),
+                list: S::Rows::default(),
                 key: key.to_string(),
                 count_hint,
             });
@@ -722,8 +1092,9 @@ fn parse_non_matrix_line(
                 row_indent: indent + 1,
                 type_name,
                 schema,
+                columns,
                 last_row_values: None,
-                list: Vec::new(),
+                list: S::Rows::default(),
                 key: key.to_string(),
                 count_hint,
             });
@@ -752,7 +1123,7 @@ fn parse_non_matrix_line(
         } else {
             infer_value(value_str, &ctx, line_num)?
         };
-        insert_into_current(stack, key.to_string(), Item::Scalar(value));
+        insert_into_current(sink, stack, key.to_string(), value);
     }
 
     Ok(())
@@ -939,8 +1310,9 @@ fn parse_row_prefix(content: &str, line_num: usize) -> HedlResult<(Option<usize>
 }
 
 #[allow(clippy::too_many_arguments)]
-fn parse_matrix_row(
-    stack: &mut Vec<Frame>,
+fn parse_matrix_row<S: BodySink>(
+    sink: &mut S,
+    stack: &mut Vec<Frame<S>>,
     content: &str,
     indent: usize,
     line_num: usize,
@@ -948,69 +1320,142 @@ fn parse_matrix_row(
     limits: &Limits,
     type_registries: &mut TypeRegistry,
     node_count: &mut usize,
+    columns: Option<&ColumnPlan>,
 ) -> HedlResult<()> {
     // Find the active list frame
-    let list_frame_idx = find_list_frame(stack, indent, line_num, header, limits)?;
+    let list_frame_idx = find_list_frame(stack, indent, line_num, header, limits, columns)?;
+
+    let (child_count, values) = match &stack[list_frame_idx] {
+        Frame::List {
+            type_name,
+            schema,
+            columns,
+            last_row_values,
+            ..
+        } => infer_row(
+            content,
+            line_num,
+            type_name,
+            schema.len(),
+            columns.as_deref(),
+            &header.aliases,
+            last_row_values.as_deref(),
+            None,
+        )?,
+        _ => unreachable!(),
+    };
+
+    accept_row(
+        sink,
+        stack,
+        list_frame_idx,
+        line_num,
+        child_count,
+        values,
+        limits,
+        type_registries,
+        node_count,
+    )
+}
 
+/// The part of a matrix row that needs only the line and its list: prefix,
+/// CSV fields, shape, value inference and the ID column type.
+///
+/// With `columns`, only the cells at those indices are inferred and the
+/// values, `prev_row` and ditto columns are indexed by position in
+/// `columns`. Columns whose unquoted cell is a ditto (`^`) are appended to
+/// `dittos` when it is given.
+#[allow(clippy::too_many_arguments)]
+fn infer_row(
+    content: &str,
+    line_num: usize,
+    type_name: &str,
+    schema_len: usize,
+    columns: Option<&[usize]>,
+    aliases: &BTreeMap<String, String>,
+    prev_row: Option<&[Value]>,
+    mut dittos: Option<&mut Vec<usize>>,
+) -> HedlResult<(Option<usize>, Vec<Value>)> {
     // Parse the row prefix to extract optional child count and CSV content
     let (child_count, csv_content) = parse_row_prefix(content, line_num)?;
     let csv_content = strip_comment(csv_content).trim();
 
-    // Get list info
-    let (type_name, schema, prev_row) = {
-        let frame = &stack[list_frame_idx];
-        match frame {
-            Frame::List {
-                type_name,
-                schema,
-                last_row_values,
-                ..
-            } => (type_name.clone(), schema.clone(), last_row_values.clone()),
-            _ => unreachable!(),
-        }
-    };
-
     // Parse CSV
     let fields =
-        parse_csv_row(csv_content).map_err(|e| HedlError::syntax(e.to_string(), line_num))?;
+        parse_csv_row_ref(csv_content).map_err(|e| HedlError::syntax(e.to_string(), line_num))?;
 
     // Validate shape
-    if fields.len() != schema.len() {
+    if fields.len() != schema_len {
         return Err(HedlError::shape(
-            format!("expected {} columns, got {}", schema.len(), fields.len()),
+            format!("expected {} columns, got {}", schema_len, fields.len()),
             line_num,
         ));
     }
 
     // Infer values
-    let mut values = Vec::with_capacity(fields.len());
-    for (col_idx, field) in fields.iter().enumerate() {
-        let ctx = InferenceContext::for_matrix_cell(
-            &header.aliases,
-            col_idx,
-            prev_row.as_deref(),
-            &type_name,
-        );
+    let width = columns.map_or(fields.len(), <[usize]>::len);
+    let mut values = Vec::with_capacity(width);
+    for col_idx in 0..width {
+        let field = &fields[columns.map_or(col_idx, |c| c[col_idx])];
+        let ctx = InferenceContext::for_matrix_cell(aliases, col_idx, prev_row, type_name);
 
         let value = if field.is_quoted {
             infer_quoted_value(&field.value)
         } else {
+            if field.value == "^" {
+                if let Some(dittos) = dittos.as_deref_mut() {
+                    dittos.push(col_idx);
+                }
+            }
             infer_value(&field.value, &ctx, line_num)?
         };
 
         values.push(value);
     }
 
-    // Get ID from first column
-    let id = match &values[0] {
-        Value::String(s) => s.clone(),
-        _ => {
-            return Err(HedlError::semantic("ID column must be a string", line_num));
-        }
+    // ID must be a string
+    if !matches!(values[0], Value::String(_)) {
+        return Err(HedlError::semantic("ID column must be a string", line_num));
+    }
+
+    Ok((child_count, values))
+}
+
+/// Register an inferred row's ID, count it and append it to its list.
+#[allow(clippy::too_many_arguments)]
+fn accept_row<S: BodySink>(
+    sink: &mut S,
+    stack: &mut [Frame<S>],
+    list_frame_idx: usize,
+    line_num: usize,
+    child_count: Option<usize>,
+    values: Vec<Value>,
+    limits: &Limits,
+    type_registries: &mut TypeRegistry,
+    node_count: &mut usize,
+) -> HedlResult<()> {
+    // Objects above the list, plus one per NEST level (the outermost list is level 0)
+    let depth = stack[..=list_frame_idx]
+        .iter()
+        .filter(|f| !matches!(f, Frame::Root { .. }))
+        .count()
+        - 1;
+
+    let Frame::List {
+        type_name,
+        last_row_values,
+        list,
+        ..
+    } = &mut stack[list_frame_idx]
+    else {
+        unreachable!()
+    };
+    let Value::String(id) = &values[0] else {
+        unreachable!("infer_row checks the ID column")
     };
 
     // Register node ID
-    register_node(type_registries, &type_name, &id, line_num)?;
+    register_node(type_registries, type_name, id, line_num)?;
 
     // Check node count limit with checked arithmetic to prevent overflow
     *node_count = node_count.checked_add(1).ok_or_else(|| {
@@ -1023,29 +1468,205 @@ fn parse_matrix_row(
         ));
     }
 
-    // Update list frame - avoid clone by storing values first, then creating node
-    if let Frame::List {
-        last_row_values,
+    // The sink copies the values it keeps, then they move into the frame for
+    // ditto support without a second clone
+    sink.push_row(
         list,
-        ..
-    } = &mut stack[list_frame_idx]
-    {
-        // Store values for ditto support before moving to node
-        *last_row_values = Some(values.clone());
-        // Create node taking ownership of values - no extra clone needed
-        let mut node = Node::new(&type_name, &id, values);
+        Row {
+            type_name,
+            id,
+            values: &values,
+            child_count,
+            depth,
+            registry: type_registries,
+        },
+    );
+    *last_row_values = Some(values);
 
-        // Store child count from |N| syntax if present
-        if let Some(count) = child_count {
-            node.set_child_count(count);
-        }
+    Ok(())
+}
+
+// --- Parallel Row Runs ---
+
+/// Rows per parallel task; runs shorter than two chunks stay sequential.
+#[cfg(feature = "parallel")]
+const PARALLEL_CHUNK_ROWS: usize = 1024;
+
+/// A row inferred off the parsing thread, waiting for registration.
+#[cfg(feature = "parallel")]
+struct PreparedRow {
+    line_num: usize,
+    child_count: Option<usize>,
+    values: Vec<Value>,
+    /// Ditto columns that copy from the row before the chunk.
+    deferred: Vec<usize>,
+}
+
+/// A chunk's rows up to its first error.
+#[cfg(feature = "parallel")]
+struct PreparedChunk {
+    rows: Vec<PreparedRow>,
+    error: Option<HedlError>,
+}
+
+/// Count the lines at the start of `lines` that are peer rows indented by
+/// exactly `spaces`, or blank and comment lines between them.
+#[cfg(feature = "parallel")]
+fn peer_row_run(lines: &[(usize, &str)], spaces: usize) -> usize {
+    lines
+        .iter()
+        .position(|&(_, line)| {
+            let bytes = line.as_bytes();
+            let is_peer_row = bytes.len() > spaces
+                && bytes[spaces] == b'|'
+                && bytes[..spaces].iter().all(|&b| b == b' ');
+            !(is_peer_row || is_blank_line(line) || is_comment_line(line))
+        })
+        .unwrap_or(lines.len())
+}
+
+/// Parse a run of peer rows of the list on top of `stack`.
+///
+/// The run is processed in windows of a few chunks per thread, bounding the
+/// rows held in flight. Each chunk is inferred in parallel, with dittos at
+/// its start read from a row of nulls and recorded as deferred; the chunks
+/// are then accepted in order, filling deferred dittos from the previous
+/// row. A chunk's first error is returned once all rows before it have been
+/// accepted, which is exactly where a sequential parse fails.
+#[cfg(feature = "parallel")]
+#[allow(clippy::too_many_arguments)]
+fn parse_row_run<S: BodySink>(
+    sink: &mut S,
+    stack: &mut [Frame<S>],
+    run: &[(usize, &str)],
+    spaces: usize,
+    chunk_rows: usize,
+    header: &crate::header::Header,
+    limits: &Limits,
+    type_registries: &mut TypeRegistry,
+    node_count: &mut usize,
+) -> HedlResult<()> {
+    use rayon::prelude::*;
 
-        list.push(node);
+    let list_frame_idx = stack.len() - 1;
+    let (type_name, schema_len, columns) = match &stack[list_frame_idx] {
+        Frame::List {
+            type_name,
+            schema,
+            columns,
+            ..
+        } => (type_name.clone(), schema.len(), columns.clone()),
+        _ => unreachable!(),
+    };
+    let width = columns.as_ref().map_or(schema_len, |c| c.len());
+    let placeholder = vec![Value::Null; width];
+    let window = chunk_rows * 4 * rayon::current_num_threads();
+
+    for window_lines in run.chunks(window) {
+        let slices: Vec<&[(usize, &str)]> = window_lines.chunks(chunk_rows).collect();
+        let chunks: Vec<PreparedChunk> = (0..slices.len())
+            .into_par_iter()
+            .map(|k| {
+                prepare_chunk(
+                    slices[k],
+                    spaces,
+                    &type_name,
+                    schema_len,
+                    columns.as_deref(),
+                    &placeholder,
+                    &header.aliases,
+                )
+            })
+            .collect();
+
+        for chunk in chunks {
+            for mut row in chunk.rows {
+                if !row.deferred.is_empty() {
+                    if let Frame::List {
+                        last_row_values: Some(prev),
+                        ..
+                    } = &stack[list_frame_idx]
+                    {
+                        for &col in &row.deferred {
+                            row.values[col] = prev[col].clone();
+                        }
+                    }
+                }
+                accept_row(
+                    sink,
+                    stack,
+                    list_frame_idx,
+                    row.line_num,
+                    row.child_count,
+                    row.values,
+                    limits,
+                    type_registries,
+                    node_count,
+                )?;
+            }
+            if let Some(e) = chunk.error {
+                return Err(e);
+            }
+        }
     }
 
     Ok(())
 }
 
+/// Infer the rows of one chunk, stopping at its first error.
+#[cfg(feature = "parallel")]
+#[allow(clippy::too_many_arguments)]
+fn prepare_chunk(
+    lines: &[(usize, &str)],
+    spaces: usize,
+    type_name: &str,
+    schema_len: usize,
+    columns: Option<&[usize]>,
+    placeholder: &[Value],
+    aliases: &BTreeMap<String, String>,
+) -> PreparedChunk {
+    let mut rows: Vec<PreparedRow> = Vec::with_capacity(lines.len());
+    for &(line_num, line) in lines {
+        if is_blank_line(line) || is_comment_line(line) {
+            continue;
+        }
+
+        let prev = rows.last();
+        let prev_values = prev.map_or(placeholder, |row| row.values.as_slice());
+        let mut dittos = Vec::new();
+        match infer_row(
+            &line[spaces..],
+            line_num,
+            type_name,
+            schema_len,
+            columns,
+            aliases,
+            Some(prev_values),
+            Some(&mut dittos),
+        ) {
+            Ok((child_count, values)) => {
+                // A ditto is deferred while its chain reaches the chunk start
+                if let Some(prev) = prev {
+                    dittos.retain(|col| prev.deferred.contains(col));
+                }
+                rows.push(PreparedRow {
+                    line_num,
+                    child_count,
+                    values,
+                    deferred: dittos,
+                });
+            }
+            Err(e) => {
+                return PreparedChunk {
+                    rows,
+                    error: Some(e),
+                }
+            }
+        }
+    }
+    PreparedChunk { rows, error: None }
+}
+
 /// Finds the appropriate list frame for a matrix row at the given indent level.
 ///
 /// This function performs critical depth checking to prevent stack overflow attacks
@@ -1089,12 +1710,13 @@ fn parse_matrix_row(
 /// 1, Alice    # depth 0
 ///   1, Main St, NYC    # depth 1 - child of Person row
 /// ```
-fn find_list_frame(
-    stack: &mut Vec<Frame>,
+fn find_list_frame<S: BodySink>(
+    stack: &mut Vec<Frame<S>>,
     indent: usize,
     line_num: usize,
     header: &crate::header::Header,
     limits: &Limits,
+    columns: Option<&ColumnPlan>,
 ) -> HedlResult<usize> {
     // Look for a list frame where this indent makes sense
     for (idx, frame) in stack.iter().enumerate().rev() {
@@ -1111,7 +1733,7 @@ fn find_list_frame(
             } else if indent == *row_indent + 1 {
                 // Child row - need NEST rule
                 // Check if there's a parent row to attach to
-                if list.is_empty() {
+                if S::rows_is_empty(list) {
                     return Err(HedlError::orphan_row(
                         "child row has no parent row",
                         line_num,
@@ -1151,8 +1773,9 @@ fn find_list_frame(
                     row_indent: indent,
                     type_name: child_type.clone(),
                     schema: child_schema.clone(),
+                    columns: columns.and_then(|c| c.get(child_type)),
                     last_row_values: None,
-                    list: Vec::new(),
+                    list: S::Rows::default(),
                     key: child_type.clone(),
                     count_hint: None, // Child lists from NEST don't have count hints
                 });
@@ -1168,7 +1791,7 @@ fn find_list_frame(
     ))
 }
 
-fn validate_indent_for_child(stack: &[Frame], indent: usize, line_num: usize) -> HedlResult<()> {
+fn validate_indent_for_child<S: BodySink>(stack: &[Frame<S>], indent: usize, line_num: usize) -> HedlResult<()> {
     let expected = match stack.last() {
         Some(Frame::Root { .. }) => 0,
         Some(Frame::Object {
@@ -1197,8 +1820,8 @@ fn validate_indent_for_child(stack: &[Frame], indent: usize, line_num: usize) ->
 /// Validate indent for nested list declarations inside a list context.
 /// Unlike scalar key-values, nested list declarations ARE allowed inside lists.
 /// Returns the parent list frame index if valid, or error if invalid.
-fn validate_nested_list_indent(
-    stack: &[Frame],
+fn validate_nested_list_indent<S: BodySink>(
+    stack: &[Frame<S>],
     indent: usize,
     line_num: usize,
 ) -> HedlResult<Option<usize>> {
@@ -1209,7 +1832,7 @@ fn validate_nested_list_indent(
                 // Nested list declaration should be at row_indent + 1 (child level)
                 if indent == *row_indent + 1 {
                     // Must have a parent row to attach to
-                    if list.is_empty() {
+                    if S::rows_is_empty(list) {
                         return Err(HedlError::orphan_row(
                             "nested list declaration has no parent row",
                             line_num,
@@ -1249,8 +1872,8 @@ fn validate_nested_list_indent(
 /// The total_keys counter prevents DoS attacks where an attacker creates many small
 /// objects, each under the max_object_keys limit, but collectively consuming excessive
 /// memory. This provides defense-in-depth against memory exhaustion attacks.
-fn check_duplicate_key(
-    stack: &[Frame],
+fn check_duplicate_key<S: BodySink>(
+    stack: &[Frame<S>],
     key: &str,
     line_num: usize,
     limits: &Limits,
@@ -1263,7 +1886,7 @@ fn check_duplicate_key(
 
     if let Some(object) = object_opt {
         // Check for duplicate key
-        if object.contains_key(key) {
+        if S::object_contains(object, key) {
             return Err(HedlError::semantic(
                 format!("duplicate key: {}", key),
                 line_num,
@@ -1271,11 +1894,11 @@ fn check_duplicate_key(
         }
 
         // Security: Enforce max_object_keys limit to prevent memory exhaustion per object
-        if object.len() >= limits.max_object_keys {
+        if S::object_len(object) >= limits.max_object_keys {
             return Err(HedlError::security(
                 format!(
                     "object has too many keys: {} (max: {})",
-                    object.len() + 1,
+                    S::object_len(object) + 1,
                     limits.max_object_keys
                 ),
                 line_num,
@@ -1301,9 +1924,9 @@ fn check_duplicate_key(
     Ok(())
 }
 
-fn insert_into_current(stack: &mut [Frame], key: String, item: Item) {
+fn insert_into_current<S: BodySink>(sink: &mut S, stack: &mut [Frame<S>], key: String, value: Value) {
     if let Some(Frame::Root { object } | Frame::Object { object, .. }) = stack.last_mut() {
-        object.insert(key, item);
+        sink.insert_scalar(object, key, value);
     }
 }
 
@@ -1333,15 +1956,19 @@ fn parse_quoted_string(s: &str, line_num: usize) -> HedlResult<String> {
     Err(HedlError::syntax("unclosed quoted string", line_num))
 }
 
-fn finalize_stack(mut stack: Vec<Frame>) -> HedlResult<BTreeMap<String, Item>> {
+fn finalize_stack<S: BodySink>(
+    sink: &mut S,
+    mut stack: Vec<Frame<S>>,
+    at_end: bool,
+) -> HedlResult<S::Object> {
     // Per SPEC Section 14.5: Detect truncated input.
     // Check only the DEEPEST (last) non-Root frame for truncation.
     // Intermediate frames will be empty until children are attached during pop.
     // Only if the deepest frame is an empty Object do we have actual truncation.
     // Note: Empty lists declared with @TypeName are allowed.
-    if stack.len() > 1 {
+    if at_end && stack.len() > 1 {
         if let Some(Frame::Object { key, object, .. }) = stack.last() {
-            if object.is_empty() {
+            if S::object_len(object) == 0 {
                 return Err(HedlError::syntax(
                     format!("truncated input: object '{}' has no children", key),
                     0,
@@ -1353,19 +1980,20 @@ fn finalize_stack(mut stack: Vec<Frame>) -> HedlResult<BTreeMap<String, Item>> {
     // Pop all frames back to root
     while stack.len() > 1 {
         let frame = stack.pop().unwrap();
-        attach_frame_to_parent(&mut stack, frame);
+        attach_frame_to_parent(sink, &mut stack, frame);
     }
 
     // Extract root object
     match stack.pop() {
         Some(Frame::Root { object }) => Ok(object),
-        _ => Ok(BTreeMap::new()),
+        _ => Ok(S::Object::default()),
     }
 }
 
 #[cfg(test)]
 mod tests {
     use super::*;
+    use crate::error::HedlErrorKind;
 
     // ==================== ParseOptionsBuilder::new() tests ====================
 
@@ -1692,4 +2320,208 @@ mod tests {
         assert_eq!(opts.limits.max_nodes, 1000);
         assert!(opts.strict_refs);
     }
+
+    // ==================== Projected parsing ====================
+
+    const PROJECTED: &str = concat!(
+        "%VERSION: 1.0\n",
+        "%STRUCT: User: [id, name, role, manager]\n",
+        "%STRUCT: Post: [id, title, body]\n",
+        "%NEST: User > Post\n",
+        "---\n",
+        "users: @User\n",
+        "  |[1] u1, Alice, admin, ~\n",
+        "    | p1, Hello, \"first post\"\n",
+        "  | u2, Bob, ^, @u1\n",
+        "config:\n",
+        "  owner: @User:u2\n",
+        "  notes: \"\"\"\n",
+        "owner: not a key\n",
+        "  \"\"\"\n",
+        "  limits:\n",
+        "    rows: 10\n",
+        "    cols: 4\n",
+    );
+
+    fn parse_projection(input: &str, strict: bool, projection: &Projection) -> HedlResult<Document> {
+        let options = ParseOptions::builder().strict(strict).build();
+        parse_projected(input.as_bytes(), options, projection)
+    }
+
+    #[test]
+    fn test_parse_projected_keys() {
+        let full = parse(PROJECTED.as_bytes()).unwrap();
+        let projection = Projection::new().key("users").key("config.limits.rows");
+        let doc = parse_projection(PROJECTED, true, &projection).unwrap();
+
+        assert_eq!(doc.root.len(), 2);
+        assert_eq!(doc.root.get("users"), full.root.get("users"));
+        let Some(Item::Object(config)) = doc.root.get("config") else {
+            panic!("config not kept")
+        };
+        assert_eq!(config.len(), 1);
+        let Some(Item::Object(limits)) = config.get("limits") else {
+            panic!("limits not kept")
+        };
+        assert_eq!(limits.len(), 1);
+        assert_eq!(limits.get("rows"), Some(&Item::Scalar(Value::Int(10))));
+
+        // No key paths keeps everything
+        let doc = parse_projection(PROJECTED, true, &Projection::new()).unwrap();
+        assert_eq!(doc, full);
+    }
+
+    #[test]
+    fn test_parse_projected_columns() {
+        let projection = Projection::new()
+            .columns("User", ["role"])
+            .columns("Post", ["title"]);
+        let doc = parse_projection(PROJECTED, true, &projection).unwrap();
+
+        assert_eq!(doc.structs["User"], ["id", "role"]);
+        assert_eq!(doc.structs["Post"], ["id", "title"]);
+        let Some(Item::List(users)) = doc.root.get("users") else {
+            panic!("users not kept")
+        };
+        assert_eq!(users.schema, ["id", "role"]);
+        assert_eq!(
+            users.rows[1].fields,
+            [Value::String("u2".into()), Value::String("admin".into())]
+        );
+
+        let posts = &users.rows[0].children["Post"];
+        assert_eq!(
+            posts[0].fields,
+            [Value::String("p1".into()), Value::String("Hello".into())]
+        );
+
+        let unknown = Projection::new().columns("User", ["email"]);
+        let err = parse_projection(PROJECTED, true, &unknown).unwrap_err();
+        assert_eq!(err.kind, HedlErrorKind::Schema);
+    }
+
+    #[test]
+    fn test_parse_projected_references() {
+        // @User:u2 resolves against the skipped users list
+        let projection = Projection::new().key("config.owner");
+        let doc = parse_projection(PROJECTED, true, &projection).unwrap();
+        let Some(Item::Object(config)) = doc.root.get("config") else {
+            panic!("config not kept")
+        };
+        assert_eq!(config.len(), 1);
+
+        let dangling = PROJECTED.replace("@User:u2", "@User:u9");
+        let err = parse_projection(&dangling, true, &projection).unwrap_err();
+        assert_eq!(err.kind, HedlErrorKind::Reference);
+        assert!(parse_projection(&dangling, false, &projection).is_ok());
+    }
+
+    // ==================== Parallel row runs ====================
+
+    #[cfg(feature = "parallel")]
+    mod parallel {
+        use super::*;
+
+        const HEADER: &str = "%VERSION: 1.0\n\
+            %STRUCT: User: [id, name, role, manager]\n\
+            %STRUCT: Post: [id, title]\n\
+            %NEST: User > Post\n\
+            ---\n";
+
+        /// Parse `body` sequentially and with several small chunk sizes,
+        /// checking every parallel result against the sequential one.
+        fn assert_same_parse(body: &str, limits: Limits) {
+            let input = format!("{}{}", HEADER, body);
+            let options = || ParseOptions {
+                limits: limits.clone(),
+                strict_refs: true,
+            };
+            let debug = |e: HedlError| format!("{:?}", e);
+            let expected = parse_with_limits(input.as_bytes(), options()).map_err(debug);
+            for chunk_rows in [1, 2, 3, 7] {
+                let actual = parse_document(
+                    input.as_bytes(),
+                    options(),
+                    RowMode::Parallel { chunk_rows },
+                )
+                .map_err(debug);
+                assert_eq!(actual, expected, "chunk_rows {}:\n{}", chunk_rows, input);
+            }
+        }
+
+        fn users(count: usize, row: impl Fn(usize) -> String) -> String {
+            let mut body = String::from("users: @User\n");
+            for i in 0..count {
+                body.push_str(&row(i));
+            }
+            body
+        }
+
+        #[test]
+        fn test_plain_rows() {
+            let body = users(40, |i| format!("  | u{i}, \"User {i}\", admin, ~\n"));
+            assert_same_parse(&body, Limits::default());
+        }
+
+        #[test]
+        fn test_dittos_across_chunks() {
+            // Long ditto chains must reach back past the start of a chunk
+            let body = users(40, |i| match i % 9 {
+                0 => format!("  | u{i}, Name{i}, role{i}, @u0\n"),
+                _ => format!("  | u{i}, ^, ^, ^\n"),
+            });
+            assert_same_parse(&body, Limits::default());
+            let body = users(40, |i| match i {
+                0 => "  | u0, First, admin, ~\n".to_string(),
+                _ => format!("  | u{i}, N{i}, ^, ^\n"),
+            });
+            assert_same_parse(&body, Limits::default());
+        }
+
+        #[test]
+        fn test_blank_lines_comments_and_children() {
+            let body = users(30, |i| match i % 5 {
+                0 => format!("  | u{i}, A, b, ~\n\n"),
+                1 => format!("  # note {i}\n  | u{i}, ^, ^, ^\n"),
+                2 => format!("  |[1] u{i}, C, d, ~\n    | p{i}, Title\n"),
+                _ => format!("  | u{i}, ^, x, @u0\n"),
+            });
+            assert_same_parse(&format!("{}after: 1\n", body), Limits::default());
+        }
+
+        #[test]
+        fn test_first_error_wins() {
+            for bad in [0, 1, 5, 17, 39] {
+                let shape = users(40, |i| match i {
+                    _ if i == bad => format!("  | u{i}, short\n"),
+                    _ => format!("  | u{i}, N, r, ~\n"),
+                });
+                assert_same_parse(&shape, Limits::default());
+
+                let duplicate = users(40, |i| match i {
+                    _ if i == bad => "  | u3, Dup, r, ~\n".to_string(),
+                    _ => format!("  | u{i}, N, r, ~\n"),
+                });
+                assert_same_parse(&duplicate, Limits::default());
+
+                let id = users(40, |i| match i {
+                    _ if i == bad => "  | 42, N, r, ~\n".to_string(),
+                    _ => format!("  | u{i}, ^, r, ~\n"),
+                });
+                assert_same_parse(&id, Limits::default());
+            }
+        }
+
+        #[test]
+        fn test_node_limit() {
+            let body = users(40, |i| format!("  | u{i}, N, r, ~\n"));
+            for max_nodes in [0, 1, 13, 39, 40] {
+                let limits = Limits {
+                    max_nodes,
+                    ..Limits::default()
+                };
+                assert_same_parse(&body, limits);
+            }
+        }
+    }
 }
@@ -24,14 +24,14 @@ use std::borrow::Cow;
 /// Preprocessed input ready for parsing.
 /// Uses zero-copy design - stores normalized text and line offsets.
 #[derive(Debug)]
-pub struct PreprocessedInput {
+pub struct PreprocessedInput<'a> {
     /// The normalized text (owned if CRLF conversion was needed, borrowed otherwise)
-    text: String,
+    text: Cow<'a, str>,
     /// Line boundaries: Vec of (line_number, start_offset, end_offset)
     line_offsets: Vec<(usize, usize, usize)>,
 }
 
-impl PreprocessedInput {
+impl PreprocessedInput<'_> {
     /// Get lines as (line_num, &str) iterator - zero allocation
     #[inline]
     pub fn lines(&self) -> impl Iterator<Item = (usize, &str)> {
@@ -50,7 +50,7 @@ impl PreprocessedInput {
 /// - Bare CR rejection
 /// - Control character validation
 /// - Size and line length limits
-pub fn preprocess(input: &[u8], limits: &Limits) -> HedlResult<PreprocessedInput> {
+pub fn preprocess<'a>(input: &'a [u8], limits: &Limits) -> HedlResult<PreprocessedInput<'a>> {
     // Check file size (don't reveal exact input size to avoid information disclosure)
     if input.len() > limits.max_file_size {
         return Err(HedlError::security(
@@ -143,13 +143,8 @@ pub fn preprocess(input: &[u8], limits: &Limits) -> HedlResult<PreprocessedInput
         line_offsets.push((line_num, start, bytes.len()));
     }
 
-    // Convert Cow to owned String for storage
-    let text_owned = text.into_owned();
-
-    Ok(PreprocessedInput {
-        text: text_owned,
-        line_offsets,
-    })
+    // Keep the Cow: LF-only input stays borrowed from the caller's buffer
+    Ok(PreprocessedInput { text, line_offsets })
 }
 
 /// Check if a line is blank (empty or whitespace only).
@@ -270,6 +265,22 @@ mod tests {
         assert_eq!(lines.len(), 2);
     }
 
+    #[test]
+    fn test_preprocess_lf_input_is_borrowed() {
+        let input = b"%VERSION: 1.0\n---\nkey: value\n";
+        let result = preprocess(input, &default_limits()).unwrap();
+        assert!(matches!(result.text, Cow::Borrowed(_)));
+        let lines: Vec<_> = result.lines().collect();
+        assert_eq!(lines[0].1.as_ptr(), input.as_ptr());
+    }
+
+    #[test]
+    fn test_preprocess_crlf_input_is_owned() {
+        let input = b"%VERSION: 1.0\r\n---\r\n";
+        let result = preprocess(input, &default_limits()).unwrap();
+        assert!(matches!(result.text, Cow::Owned(_)));
+    }
+
     // ==================== BOM tests ====================
 
     #[test]
@@ -0,0 +1,511 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Projections: parse only the keys and columns a caller asks for.
+//!
+//! [`crate::parse_projected`] hands the body parser the lines of the selected
+//! key paths only. Everything else is scanned for indentation and block
+//! strings, never parsed: no values are inferred and no nodes are built. In
+//! strict mode the skipped matrix rows are still read far enough to register
+//! their IDs, so references from the projected data into skipped lists
+//! resolve as they would in a full parse.
+//!
+//! Column projections are applied as rows are inferred: cells outside the
+//! projection are split off the row but never turned into values.
+//!
+//! # Example
+//!
+//! ```
+//! use hedl_core::{parse_projected, Item, ParseOptions, Projection};
+//!
+//! let input = b"%VERSION: 1.0\n%STRUCT: User: [id,name,email]\n---\n\
+//!     users: @User\n  | u1, Alice, alice@example.com\n\
+//!     settings:\n  theme: dark\n  debug: true\n";
+//! let projection = Projection::new()
+//!     .key("users")
+//!     .key("settings.theme")
+//!     .columns("User", ["name"]);
+//! let doc = parse_projected(input, ParseOptions::default(), &projection).unwrap();
+//!
+//! let Some(Item::List(users)) = doc.root.get("users") else { panic!() };
+//! assert_eq!(users.schema, ["id", "name"]);
+//! assert_eq!(users.rows[0].fields.len(), 2);
+//! let Some(Item::Object(settings)) = doc.root.get("settings") else { panic!() };
+//! assert!(settings.contains_key("theme") && !settings.contains_key("debug"));
+//! ```
+
+use crate::block_string::{try_start_block_string, BlockStringResult};
+use crate::document::{Item, Node};
+use crate::error::{HedlError, HedlResult};
+use crate::lex::{calculate_indent, strip_comment};
+use crate::preprocess::{is_blank_line, is_comment_line};
+use crate::reference::{register_node, TypeRegistry};
+use crate::value::Value;
+use std::collections::{BTreeMap, HashMap};
+use std::sync::Arc;
+
+// =============================================================================
+// Projection
+// =============================================================================
+
+/// The key paths and columns to materialize.
+///
+/// A key path names a root key, or a key inside nested objects with its
+/// segments separated by dots (`config.database.host`). A path ending at a
+/// matrix list, scalar or block string keeps it whole; a path ending at an
+/// object keeps the object with everything below it. With no key paths every
+/// root key is kept.
+///
+/// Column projections apply to `%STRUCT` types and keep the ID column
+/// whatever the column list says; the projected document's schemas list the
+/// kept columns only.
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct Projection {
+    keys: Vec<String>,
+    columns: BTreeMap<String, Vec<String>>,
+}
+
+impl Projection {
+    /// An empty projection, which keeps everything.
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Keep the item at a dotted key path.
+    pub fn key(mut self, path: impl Into<String>) -> Self {
+        self.keys.push(path.into());
+        self
+    }
+
+    /// Keep only `columns` (plus the ID column) in rows of `type_name`.
+    ///
+    /// Calling this again for the same type adds to its columns.
+    pub fn columns<I, S>(mut self, type_name: impl Into<String>, columns: I) -> Self
+    where
+        I: IntoIterator<Item = S>,
+        S: Into<String>,
+    {
+        self.columns
+            .entry(type_name.into())
+            .or_default()
+            .extend(columns.into_iter().map(Into::into));
+        self
+    }
+
+    /// The key paths, in the order they were added.
+    pub fn keys(&self) -> &[String] {
+        &self.keys
+    }
+
+    /// Projected columns by type name.
+    pub fn projected_columns(&self) -> &BTreeMap<String, Vec<String>> {
+        &self.columns
+    }
+}
+
+// =============================================================================
+// Column Plan
+// =============================================================================
+
+/// Column projections resolved against the header schemas.
+#[derive(Debug)]
+pub(crate) struct ColumnPlan {
+    /// Indices of the kept columns in schema order, starting with the ID.
+    by_type: HashMap<String, Arc<[usize]>>,
+}
+
+impl ColumnPlan {
+    /// Resolve column names to indices; `None` when nothing is projected.
+    pub(crate) fn compile(
+        projection: &Projection,
+        structs: &BTreeMap<String, Vec<String>>,
+    ) -> HedlResult<Option<Self>> {
+        if projection.columns.is_empty() {
+            return Ok(None);
+        }
+
+        let mut by_type = HashMap::with_capacity(projection.columns.len());
+        for (type_name, columns) in &projection.columns {
+            let schema = structs.get(type_name).ok_or_else(|| {
+                HedlError::schema(format!("projection: undefined type: {}", type_name), 0)
+            })?;
+
+            let mut kept = vec![0];
+            for column in columns {
+                let idx = schema.iter().position(|c| c == column).ok_or_else(|| {
+                    HedlError::schema(
+                        format!(
+                            "projection: type '{}' has no column '{}'",
+                            type_name, column
+                        ),
+                        0,
+                    )
+                })?;
+                kept.push(idx);
+            }
+            kept.sort_unstable();
+            kept.dedup();
+            by_type.insert(type_name.clone(), kept.into());
+        }
+
+        Ok(Some(Self { by_type }))
+    }
+
+    /// Kept column indices for rows of `type_name`, if it is projected.
+    pub(crate) fn get(&self, type_name: &str) -> Option<Arc<[usize]>> {
+        self.by_type.get(type_name).cloned()
+    }
+
+    /// Reduce the projected `%STRUCT` schemas to their kept columns.
+    pub(crate) fn project_structs(&self, structs: &mut BTreeMap<String, Vec<String>>) {
+        for (type_name, kept) in &self.by_type {
+            if let Some(schema) = structs.get_mut(type_name) {
+                *schema = project_schema(std::mem::take(schema), kept);
+            }
+        }
+    }
+}
+
+/// The columns of `schema` at the `kept` indices.
+pub(crate) fn project_schema(schema: Vec<String>, kept: &[usize]) -> Vec<String> {
+    kept.iter().map(|&i| schema[i].clone()).collect()
+}
+
+// =============================================================================
+// Line Selection
+// =============================================================================
+
+/// Body lines split by a projection's key paths.
+#[derive(Debug, Default)]
+pub(crate) struct Selection<'a> {
+    /// Lines to parse, unchanged and in document order.
+    pub kept: Vec<(usize, &'a str)>,
+    /// Structural lines left out: line number, indent level and content
+    /// after the indentation. Blank, comment and block string lines are
+    /// dropped.
+    pub skipped: Vec<(usize, usize, &'a str)>,
+}
+
+/// A body line with its indentation resolved.
+struct BodyLine<'a> {
+    num: usize,
+    raw: &'a str,
+    /// Indent level and content, or `None` for blank and comment lines and
+    /// the inside of block strings.
+    at: Option<(usize, &'a str)>,
+}
+
+/// One node of the compiled key paths.
+#[derive(Debug, Default)]
+struct PathNode {
+    /// A path ends here: keep the whole item.
+    whole: bool,
+    children: HashMap<String, PathNode>,
+}
+
+impl PathNode {
+    fn compile(keys: &[String]) -> HedlResult<Self> {
+        let mut root = Self::default();
+        for path in keys {
+            let mut node = &mut root;
+            for segment in path.split('.') {
+                let segment = segment.trim();
+                if segment.is_empty() {
+                    return Err(HedlError::syntax(
+                        format!("projection: invalid key path '{}'", path),
+                        0,
+                    ));
+                }
+                node = node.children.entry(segment.to_string()).or_default();
+            }
+            node.whole = true;
+        }
+        Ok(root)
+    }
+}
+
+/// Split `lines` into the lines under the projection's key paths and the
+/// rest; `None` when the projection has no key paths and keeps all lines.
+///
+/// Lines that cannot belong to any key (rows outside a list, lines without
+/// a colon, indentation without a parent) are kept so that the body parser
+/// reports them as it would without a projection.
+pub(crate) fn select_lines<'a>(
+    lines: &[(usize, &'a str)],
+    projection: &Projection,
+) -> HedlResult<Option<Selection<'a>>> {
+    if projection.keys.is_empty() {
+        return Ok(None);
+    }
+    let paths = PathNode::compile(&projection.keys)?;
+
+    let mut body = Vec::with_capacity(lines.len());
+    let mut in_block = false;
+    for &(num, raw) in lines {
+        let mut at = None;
+        if in_block {
+            in_block = !raw.contains("\"\"\"");
+        } else if !is_blank_line(raw) && !is_comment_line(raw) {
+            let indent = calculate_indent(raw, num as u32)
+                .map_err(|e| HedlError::syntax(e.to_string(), num))?;
+            if let Some(info) = indent {
+                let content = &raw[info.spaces..];
+                if !content.starts_with('|') {
+                    in_block = matches!(
+                        try_start_block_string(content, info.level, num)?,
+                        BlockStringResult::MultiLineStarted(_)
+                    );
+                }
+                at = Some((info.level, content));
+            }
+        }
+        body.push(BodyLine { num, raw, at });
+    }
+
+    let mut selection = Selection::default();
+    select_items(&body, 0, &paths, &mut selection);
+    Ok(Some(selection))
+}
+
+/// Select among the items at indent `level`; each item is a key line and
+/// the lines indented below it.
+fn select_items<'a>(
+    lines: &[BodyLine<'a>],
+    level: usize,
+    paths: &PathNode,
+    out: &mut Selection<'a>,
+) {
+    let starts_item = |line: &BodyLine<'_>| matches!(line.at, Some((l, _)) if l <= level);
+
+    let mut start = lines.iter().position(starts_item).unwrap_or(lines.len());
+    keep(&lines[..start], out);
+
+    while start < lines.len() {
+        let end = lines[start + 1..]
+            .iter()
+            .position(starts_item)
+            .map_or(lines.len(), |n| start + 1 + n);
+        let item = &lines[start..end];
+        start = end;
+
+        let Some((_, content)) = item[0].at else {
+            unreachable!("items start at structural lines")
+        };
+        let Some((key, opens_object)) = item_key(content) else {
+            keep(item, out);
+            continue;
+        };
+        match paths.children.get(key) {
+            None => skip(item, out),
+            Some(node) if node.whole || !opens_object => keep(item, out),
+            Some(node) => {
+                // Keep the object line only if some path below it matched
+                let mark = out.kept.len();
+                out.kept.push((item[0].num, item[0].raw));
+                select_items(&item[1..], level + 1, node, out);
+                if out.kept.len() == mark + 1 {
+                    out.kept.pop();
+                }
+            }
+        }
+    }
+}
+
+fn keep<'a>(lines: &[BodyLine<'a>], out: &mut Selection<'a>) {
+    out.kept.extend(lines.iter().map(|l| (l.num, l.raw)));
+}
+
+fn skip<'a>(lines: &[BodyLine<'a>], out: &mut Selection<'a>) {
+    out.skipped.extend(
+        lines
+            .iter()
+            .filter_map(|l| l.at.map(|(level, content)| (l.num, level, content))),
+    );
+}
+
+/// The key of a key line, without its count hint, and whether the line
+/// opens an object.
+fn item_key(content: &str) -> Option<(&str, bool)> {
+    if content.starts_with('|') {
+        return None;
+    }
+    let content = strip_comment(content);
+    let colon = content.find(':')?;
+    let key = content[..colon].trim();
+    let key = key.split_once('(').map_or(key, |(k, _)| k);
+    Some((key, content[colon + 1..].trim().is_empty()))
+}
+
+// =============================================================================
+// Skipped Regions
+// =============================================================================
+
+/// Whether any value in `items` is a reference.
+pub(crate) fn has_references(items: &BTreeMap<String, Item>) -> bool {
+    fn node_has_references(node: &Node) -> bool {
+        node.fields.iter().any(|v| matches!(v, Value::Reference(_)))
+            || node.children.values().flatten().any(node_has_references)
+    }
+
+    items.values().any(|item| match item {
+        Item::Scalar(value) => matches!(value, Value::Reference(_)),
+        Item::Object(object) => has_references(object),
+        Item::List(list) => list.rows.iter().any(node_has_references),
+    })
+}
+
+/// Register the IDs of the matrix rows among `skipped` lines.
+///
+/// Rows are matched to their list by indentation, with child rows typed by
+/// the `%NEST` rules, exactly as the body parser does; IDs are the first
+/// CSV field. Nothing else on the lines is checked, so a skipped region
+/// that would fail to parse only fails here if its IDs collide.
+pub(crate) fn register_skipped_ids(
+    skipped: &[(usize, usize, &str)],
+    nests: &BTreeMap<String, String>,
+    registry: &mut TypeRegistry,
+) -> HedlResult<()> {
+    // Open lists: row indent level and type
+    let mut lists: Vec<(usize, &str)> = Vec::new();
+
+    for &(line_num, level, content) in skipped {
+        while lists.last().is_some_and(|&(rows, _)| rows > level) {
+            lists.pop();
+        }
+
+        if let Some(row) = content.strip_prefix('|') {
+            let type_name = match lists.last() {
+                Some(&(rows, type_name)) if rows == level => type_name,
+                Some(&(rows, type_name)) if rows + 1 == level => match nests.get(type_name) {
+                    Some(child) => {
+                        lists.push((level, child));
+                        child
+                    }
+                    None => continue,
+                },
+                _ => continue,
+            };
+            if let Some(id) = row_id(row) {
+                register_node(registry, type_name, &id, line_num)?;
+            }
+        } else if let Some(type_name) = list_type(content) {
+            lists.push((level + 1, type_name));
+        }
+    }
+
+    Ok(())
+}
+
+/// The type of a list start line (`key: @Type` or `key: @Type[a, b]`).
+fn list_type(content: &str) -> Option<&str> {
+    let content = strip_comment(content);
+    let (_, value) = content.split_once(':')?;
+    let rest = value.trim().strip_prefix('@')?;
+    let end = rest
+        .find(|c: char| c == '[' || c.is_whitespace())
+        .unwrap_or(rest.len());
+    Some(&rest[..end]).filter(|t| !t.is_empty())
+}
+
+/// The ID cell of a row, without the leading `|` and any `[N]` child count.
+fn row_id(row: &str) -> Option<String> {
+    let row = match row.strip_prefix('[') {
+        Some(rest) => rest.split_once(']').map_or(row, |(_, data)| data),
+        None => row,
+    };
+    let row = strip_comment(row).trim();
+    if row.starts_with('"') {
+        let fields = crate::lex::row::parse_csv_row_ref(row).ok()?;
+        return fields.first().map(|f| f.value.to_string());
+    }
+    let id = row.split(',').next()?.trim();
+    Some(id.to_string()).filter(|id| !id.is_empty())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn lines(body: &str) -> Vec<(usize, &str)> {
+        body.lines().enumerate().map(|(i, l)| (i + 1, l)).collect()
+    }
+
+    fn kept(body: &str, projection: &Projection) -> Vec<usize> {
+        let lines = lines(body);
+        let selection = select_lines(&lines, projection).unwrap().unwrap();
+        selection.kept.iter().map(|&(n, _)| n).collect()
+    }
+
+    #[test]
+    fn test_select_lines_by_path() {
+        let body =
+            "a: 1\nb:\n  c: 2\n  d:\n    e: 3\n  f: \"\"\"\nf: x\n  \"\"\"\ng: @T\n  | t1, 1\n";
+        let projection = Projection::new().key("b.d").key("b.f").key("g");
+        assert_eq!(kept(body, &projection), [2, 4, 5, 6, 7, 8, 9, 10]);
+
+        // A path with no match drops its parent too
+        let projection = Projection::new().key("b.missing");
+        assert!(kept(body, &projection).is_empty());
+
+        assert!(select_lines(&lines(body), &Projection::new())
+            .unwrap()
+            .is_none());
+        assert!(select_lines(&lines(body), &Projection::new().key("b..c")).is_err());
+    }
+
+    #[test]
+    fn test_register_skipped_ids() {
+        let body = "users: @User\n  | u1, Alice\n  |[1] u2, Bob\n    | p1, Hello\nnames:\n  x: \"\"\"\n  | fake, row\n  \"\"\"\n";
+        let lines = lines(body);
+        let selection = select_lines(&lines, &Projection::new().key("none"))
+            .unwrap()
+            .unwrap();
+        assert!(selection.kept.is_empty());
+
+        let nests = BTreeMap::from([("User".to_string(), "Post".to_string())]);
+        let mut registry = TypeRegistry::new();
+        register_skipped_ids(&selection.skipped, &nests, &mut registry).unwrap();
+        assert!(registry.contains_in_type("User", "u1"));
+        assert!(registry.contains_in_type("User", "u2"));
+        assert!(registry.contains_in_type("Post", "p1"));
+        assert!(!registry.contains_in_type("User", "fake"));
+    }
+
+    #[test]
+    fn test_column_plan() {
+        let structs = BTreeMap::from([(
+            "User".to_string(),
+            vec!["id".to_string(), "name".to_string(), "email".to_string()],
+        )]);
+        let projection = Projection::new().columns("User", ["email", "id"]);
+        let plan = ColumnPlan::compile(&projection, &structs).unwrap().unwrap();
+        assert_eq!(&*plan.get("User").unwrap(), &[0, 2]);
+        assert!(plan.get("Post").is_none());
+
+        let mut projected = structs.clone();
+        plan.project_structs(&mut projected);
+        assert_eq!(projected["User"], ["id", "email"]);
+
+        assert!(
+            ColumnPlan::compile(&Projection::new().columns("User", ["age"]), &structs).is_err()
+        );
+        assert!(ColumnPlan::compile(&Projection::new().columns("Post", ["id"]), &structs).is_err());
+        assert!(ColumnPlan::compile(&Projection::new(), &structs)
+            .unwrap()
+            .is_none());
+    }
+}
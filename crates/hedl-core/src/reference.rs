@@ -20,72 +20,159 @@
 use crate::document::{Document, Item, MatrixList, Node};
 use crate::error::{HedlError, HedlResult};
 use crate::limits::Limits;
-use crate::value::Value;
+use crate::symbol::{Symbol, SymbolTable};
+use crate::value::{Reference, Value};
+use std::collections::hash_map::Entry;
 use std::collections::{BTreeMap, HashMap};
 
-/// Type registries with both forward and inverted indices for efficient lookups.
+/// Registry of node IDs by type.
+///
+/// Type names and IDs are interned in a [`SymbolTable`], so each distinct
+/// string is stored once however many rows repeat it, and lookups compare
+/// `u32` symbols instead of strings.
 ///
 /// P0 OPTIMIZATION: Inverted index for unqualified references (100-1000x speedup)
-/// - Forward index: type -> (id -> line_num) for qualified lookups (O(log n))
-/// - Inverted index: id -> [types] for unqualified lookups (O(1))
+/// - Keyed by ID: qualified lookups scan the (usually single) defining type
+/// - Unqualified lookups get every defining type from one hash lookup
 pub struct TypeRegistry {
-    /// Forward index: type_name -> (id -> line_number)
-    by_type: BTreeMap<String, BTreeMap<String, usize>>,
-    /// Inverted index: id -> list of type names containing that ID
-    by_id: HashMap<String, Vec<String>>,
+    symbols: SymbolTable,
+    /// id -> types defining it
+    by_id: HashMap<Symbol, Definitions>,
+}
+
+/// Types defining one ID, with the line of each definition.
+enum Definitions {
+    /// The common case: one type defines the ID.
+    One((Symbol, usize)),
+    /// The ID is defined by several types.
+    Many(Vec<(Symbol, usize)>),
+}
+
+impl Definitions {
+    fn as_slice(&self) -> &[(Symbol, usize)] {
+        match self {
+            Definitions::One(def) => std::slice::from_ref(def),
+            Definitions::Many(defs) => defs,
+        }
+    }
+
+    /// Line where `type_name` defines the ID, if it does.
+    fn line_in(&self, type_name: Symbol) -> Option<usize> {
+        self.as_slice()
+            .iter()
+            .find(|&&(t, _)| t == type_name)
+            .map(|&(_, line)| line)
+    }
+
+    fn push(&mut self, type_name: Symbol, line: usize) {
+        match self {
+            Definitions::One(first) => *self = Definitions::Many(vec![*first, (type_name, line)]),
+            Definitions::Many(defs) => defs.push((type_name, line)),
+        }
+    }
 }
 
 impl TypeRegistry {
     /// Create a new empty registry
     pub fn new() -> Self {
         Self {
-            by_type: BTreeMap::new(),
+            symbols: SymbolTable::new(),
             by_id: HashMap::new(),
         }
     }
 
-    /// Register an ID in a type, maintaining both indices
+    /// Register an ID in a type
     pub fn register(
         &mut self,
         type_name: &str,
         id: &str,
         line_num: usize,
     ) -> HedlResult<()> {
-        let type_registry = self.by_type.entry(type_name.to_string()).or_default();
-
-        if let Some(&prev_line) = type_registry.get(id) {
-            return Err(HedlError::collision(
-                format!(
-                    "duplicate ID '{}' in type '{}', previously defined at line {}",
-                    id, type_name, prev_line
-                ),
-                line_num,
-            ));
-        }
-
-        type_registry.insert(id.to_string(), line_num);
+        let type_symbol = self.symbols.intern(type_name);
+        let id_symbol = self.symbols.intern(id);
 
-        // Update inverted index
-        self.by_id
-            .entry(id.to_string())
-            .or_default()
-            .push(type_name.to_string());
+        match self.by_id.entry(id_symbol) {
+            Entry::Vacant(slot) => {
+                slot.insert(Definitions::One((type_symbol, line_num)));
+            }
+            Entry::Occupied(mut slot) => {
+                if let Some(prev_line) = slot.get().line_in(type_symbol) {
+                    return Err(HedlError::collision(
+                        format!(
+                            "duplicate ID '{}' in type '{}', previously defined at line {}",
+                            id, type_name, prev_line
+                        ),
+                        line_num,
+                    ));
+                }
+                slot.get_mut().push(type_symbol, line_num);
+            }
+        }
 
         Ok(())
     }
 
     /// Look up ID in a specific type (qualified reference)
     pub fn contains_in_type(&self, type_name: &str, id: &str) -> bool {
-        self.by_type
-            .get(type_name)
-            .map(|r| r.contains_key(id))
-            .unwrap_or(false)
+        let (Some(type_symbol), Some(id_symbol)) =
+            (self.symbols.get(type_name), self.symbols.get(id))
+        else {
+            return false;
+        };
+        self.by_id
+            .get(&id_symbol)
+            .is_some_and(|defs| defs.line_in(type_symbol).is_some())
     }
 
     /// Look up ID across all types (unqualified reference)
-    /// Returns list of types containing this ID
-    pub fn lookup_unqualified(&self, id: &str) -> Option<&[String]> {
-        self.by_id.get(id).map(|v| v.as_slice())
+    /// Returns the types containing this ID, in registration order
+    pub fn lookup_unqualified(&self, id: &str) -> Vec<&str> {
+        self.symbols
+            .get(id)
+            .and_then(|id_symbol| self.by_id.get(&id_symbol))
+            .map_or_else(Vec::new, |defs| {
+                defs.as_slice()
+                    .iter()
+                    .map(|&(type_name, _)| self.symbols.resolve(type_name))
+                    .collect()
+            })
+    }
+
+    /// Registered `(type, id, line)` entries, sorted by type then ID.
+    pub(crate) fn entries(&self) -> impl Iterator<Item = (&str, &str, usize)> {
+        let mut entries: Vec<(&str, &str, usize)> = self
+            .by_id
+            .iter()
+            .flat_map(|(&id, defs)| {
+                let id = self.symbols.resolve(id);
+                defs.as_slice()
+                    .iter()
+                    .map(move |&(type_name, line)| (self.symbols.resolve(type_name), id, line))
+            })
+            .collect();
+        entries.sort_unstable();
+        entries.into_iter()
+    }
+}
+
+/// ID lookups needed to resolve a reference.
+///
+/// Implemented by [`TypeRegistry`] and by the live index that
+/// [`crate::IncrementalDocument`] keeps across edits.
+pub(crate) trait IdIndex {
+    /// Whether `type_name` defines `id`.
+    fn contains_in_type(&self, type_name: &str, id: &str) -> bool;
+    /// Every type defining `id`.
+    fn types_with_id(&self, id: &str) -> Vec<&str>;
+}
+
+impl IdIndex for TypeRegistry {
+    fn contains_in_type(&self, type_name: &str, id: &str) -> bool {
+        TypeRegistry::contains_in_type(self, type_name, id)
+    }
+
+    fn types_with_id(&self, id: &str) -> Vec<&str> {
+        self.lookup_unqualified(id)
     }
 }
 
@@ -98,7 +185,7 @@ impl Default for TypeRegistry {
 /// Check NEST hierarchy depth against security limit.
 ///
 /// Returns an error if the depth exceeds the maximum allowed depth.
-fn check_nest_depth(depth: usize, max_depth: usize) -> HedlResult<()> {
+pub(crate) fn check_nest_depth(depth: usize, max_depth: usize) -> HedlResult<()> {
     if depth > max_depth {
         return Err(HedlError::security(
             format!(
@@ -140,6 +227,17 @@ pub fn resolve_references_with_limits(
     validate_references(&doc.root, &registries, strict, None, 0, limits.max_nest_depth)
 }
 
+/// Validate the references in a document against IDs registered elsewhere,
+/// such as by the parser itself.
+pub(crate) fn validate_references_with(
+    doc: &Document,
+    registries: &TypeRegistry,
+    strict: bool,
+    limits: &Limits,
+) -> HedlResult<()> {
+    validate_references(&doc.root, registries, strict, None, 0, limits.max_nest_depth)
+}
+
 fn collect_node_ids(
     items: &BTreeMap<String, Item>,
     registries: &mut TypeRegistry,
@@ -255,55 +353,130 @@ fn validate_node_references(
     Ok(())
 }
 
-fn validate_value_reference(
+pub(crate) fn validate_value_reference<I: IdIndex + ?Sized>(
     value: &Value,
-    registries: &TypeRegistry,
+    registries: &I,
     strict: bool,
     current_type: Option<&str>,
 ) -> HedlResult<()> {
     if let Value::Reference(ref_val) = value {
-        // If reference has explicit type (@User:u1), look only in that type's registry
-        let resolved = match &ref_val.type_name {
-            Some(t) => registries.contains_in_type(t, &ref_val.id),
-            None => {
-                // No type qualifier - behavior depends on context
-                match current_type {
-                    // SPEC 10.2, 10.3: In matrix context, search ONLY current type
-                    Some(type_name) => registries.contains_in_type(type_name, &ref_val.id),
-                    // SPEC 10.3.1: In Key-Value context, search all types but detect ambiguity
-                    // P0 OPTIMIZATION: Use inverted index for O(1) lookup instead of O(m) scan
-                    None => {
-                        let matching_types = registries
-                            .lookup_unqualified(&ref_val.id)
-                            .unwrap_or(&[]);
-
-                        match matching_types.len() {
-                            0 => false, // Not found
-                            1 => true,  // Unambiguous match
-                            _ => {
-                                // Multiple matches - ambiguous reference
-                                return Err(HedlError::reference(
-                                    format!(
-                                        "Ambiguous unqualified reference '@{}' matches multiple types: [{}]",
-                                        ref_val.id,
-                                        matching_types.join(", ")
-                                    ),
-                                    0, // Line number lost at this point
-                                ));
-                            }
+        check_reference(ref_val, registries, strict, current_type)?;
+    }
+
+    Ok(())
+}
+
+/// Resolve one reference; `current_type` is the row type in matrix context.
+pub(crate) fn check_reference<I: IdIndex + ?Sized>(
+    ref_val: &Reference,
+    registries: &I,
+    strict: bool,
+    current_type: Option<&str>,
+) -> HedlResult<()> {
+    // If reference has explicit type (@User:u1), look only in that type's registry
+    let resolved = match &ref_val.type_name {
+        Some(t) => registries.contains_in_type(t, &ref_val.id),
+        None => {
+            // No type qualifier - behavior depends on context
+            match current_type {
+                // SPEC 10.2, 10.3: In matrix context, search ONLY current type
+                Some(type_name) => registries.contains_in_type(type_name, &ref_val.id),
+                // SPEC 10.3.1: In Key-Value context, search all types but detect ambiguity
+                // P0 OPTIMIZATION: Use inverted index for O(1) lookup instead of O(m) scan
+                None => {
+                    let matching_types = registries.types_with_id(&ref_val.id);
+
+                    match matching_types.len() {
+                        0 => false, // Not found
+                        1 => true,  // Unambiguous match
+                        _ => {
+                            // Multiple matches - ambiguous reference. Sorted so the
+                            // message doesn't depend on registration order.
+                            let mut types = matching_types;
+                            types.sort_unstable();
+                            return Err(HedlError::reference(
+                                format!(
+                                    "Ambiguous unqualified reference '@{}' matches multiple types: [{}]",
+                                    ref_val.id,
+                                    types.join(", ")
+                                ),
+                                0, // Line number lost at this point
+                            ));
                         }
                     }
                 }
             }
-        };
-
-        if !resolved && strict {
-            return Err(HedlError::reference(
-                format!("unresolved reference {}", ref_val.to_ref_string()),
-                0, // Line number lost at this point
-            ));
         }
+    };
+
+    if !resolved && strict {
+        return Err(HedlError::reference(
+            format!("unresolved reference {}", ref_val.to_ref_string()),
+            0, // Line number lost at this point
+        ));
     }
 
     Ok(())
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_register_and_lookup() {
+        let mut registry = TypeRegistry::new();
+        registry.register("User", "alice", 3).unwrap();
+        registry.register("Team", "alice", 7).unwrap();
+        registry.register("User", "bob", 4).unwrap();
+
+        assert!(registry.contains_in_type("User", "alice"));
+        assert!(registry.contains_in_type("Team", "alice"));
+        assert!(!registry.contains_in_type("Team", "bob"));
+        assert!(!registry.contains_in_type("Post", "alice"));
+        assert!(!registry.contains_in_type("User", "carol"));
+
+        assert_eq!(registry.lookup_unqualified("alice"), vec!["User", "Team"]);
+        assert_eq!(registry.lookup_unqualified("bob"), vec!["User"]);
+        assert!(registry.lookup_unqualified("carol").is_empty());
+    }
+
+    #[test]
+    fn test_duplicate_id_in_type() {
+        let mut registry = TypeRegistry::new();
+        registry.register("User", "alice", 3).unwrap();
+        registry.register("Team", "alice", 5).unwrap();
+        let err = registry.register("Team", "alice", 9).unwrap_err();
+        assert_eq!(err.line, 9);
+        assert!(
+            err.message.contains("duplicate ID 'alice' in type 'Team'")
+                && err.message.contains("line 5"),
+            "{}",
+            err.message
+        );
+    }
+
+    #[test]
+    fn test_type_names_and_ids_share_symbols() {
+        let mut registry = TypeRegistry::new();
+        // A type name reused as an ID is still a distinct definition
+        registry.register("User", "User", 1).unwrap();
+        registry.register("User", "Team", 2).unwrap();
+        assert!(registry.contains_in_type("User", "User"));
+        assert!(!registry.contains_in_type("Team", "User"));
+        assert_eq!(registry.lookup_unqualified("Team"), vec!["User"]);
+    }
+
+    #[test]
+    fn test_entries_sorted() {
+        let mut registry = TypeRegistry::new();
+        registry.register("User", "bob", 2).unwrap();
+        registry.register("Team", "t1", 5).unwrap();
+        registry.register("User", "alice", 1).unwrap();
+        let entries: Vec<_> = registry.entries().collect();
+        assert_eq!(
+            entries,
+            vec![("Team", "t1", 5), ("User", "alice", 1), ("User", "bob", 2)]
+        );
+    }
+}
@@ -0,0 +1,912 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Binary snapshots of parsed documents.
+//!
+//! A snapshot stores a [`Document`] exactly as the parser left it (aliases,
+//! schemas, nest rules, inferred values and references) so it can be
+//! reloaded without lexing, inference or reference resolution. Loading is a
+//! single forward pass over the bytes that only allocates the document
+//! itself; the input is never copied, so a memory-mapped file works as-is.
+//!
+//! # Layout
+//!
+//! All integers are little-endian; every section starts on an 8-byte boundary.
+//!
+//! ```text
+//! offset  size  field
+//!      0     8  magic "HEDLSNAP"
+//!      8     4  format version (SNAPSHOT_FORMAT_VERSION)
+//!     12     4  flags (reserved, 0)
+//!     16     8  string count N
+//!     24     8  string bytes B
+//!     32     8  tree words W
+//!     40     8  checksum of everything after the header
+//!     48    16  reserved (0)
+//!     64        N + 1 u64 string offsets into the string bytes
+//!               B bytes of UTF-8 strings, zero-padded to 8
+//!               W u32 tree words, zero-padded to 8
+//! ```
+//!
+//! Strings are deduplicated and referenced from the tree by index, so the
+//! tree is a flat run of fixed-width words: counts, tags, string indices and
+//! 64-bit scalars as two words (low first). The checksum is FNV-1a over the
+//! body's 64-bit words; a truncated or corrupted file fails to load instead
+//! of producing a different document.
+//!
+//! Snapshots are a cache, not an interchange format: readers only accept
+//! their own format version, and a rejected snapshot should be rebuilt from
+//! the HEDL source.
+
+use crate::lex::{SourcePos, Span};
+use crate::{Document, ExprLiteral, Expression, HedlError, HedlResult, Item, MatrixList, Node};
+use crate::{Reference, Tensor, Value};
+use std::collections::{BTreeMap, HashMap};
+
+/// Leading bytes of every snapshot.
+pub const SNAPSHOT_MAGIC: [u8; 8] = *b"HEDLSNAP";
+
+/// Layout version written by [`to_snapshot`] and required by [`from_snapshot`].
+pub const SNAPSHOT_FORMAT_VERSION: u32 = 1;
+
+const HEADER_LEN: usize = 64;
+
+/// Deepest nesting accepted on load (objects, node children, tensors and
+/// expressions each count one level per nesting step).
+const MAX_DEPTH: usize = 512;
+
+/// String index meaning "absent" (unqualified references).
+pub(crate) const NO_STRING: u32 = u32::MAX;
+
+// Item tags
+const ITEM_SCALAR: u32 = 0;
+const ITEM_OBJECT: u32 = 1;
+const ITEM_LIST: u32 = 2;
+
+// Value tags
+const VALUE_NULL: u32 = 0;
+const VALUE_BOOL: u32 = 1;
+const VALUE_INT: u32 = 2;
+const VALUE_FLOAT: u32 = 3;
+const VALUE_STRING: u32 = 4;
+const VALUE_TENSOR: u32 = 5;
+const VALUE_REFERENCE: u32 = 6;
+const VALUE_EXPRESSION: u32 = 7;
+
+// Tensor tags
+const TENSOR_SCALAR: u32 = 0;
+const TENSOR_ARRAY: u32 = 1;
+
+// Expression tags
+const EXPR_LITERAL: u32 = 0;
+const EXPR_IDENTIFIER: u32 = 1;
+const EXPR_CALL: u32 = 2;
+const EXPR_ACCESS: u32 = 3;
+
+// Expression literal tags
+const LIT_INT: u32 = 0;
+const LIT_FLOAT: u32 = 1;
+const LIT_STRING: u32 = 2;
+const LIT_BOOL: u32 = 3;
+
+// =============================================================================
+// Writing
+// =============================================================================
+
+/// Serialize a document into a snapshot.
+///
+/// Equal documents produce identical bytes.
+///
+/// # Errors
+///
+/// A conversion error if a collection or the string table has more entries
+/// than the format's 32-bit lengths can describe.
+pub fn to_snapshot(doc: &Document) -> HedlResult<Vec<u8>> {
+    let mut w = Writer::default();
+    w.document(doc);
+    seal(&w, SNAPSHOT_MAGIC, SNAPSHOT_FORMAT_VERSION, "snapshot")
+}
+
+/// Lay out a finished [`Writer`] in the snapshot container under `magic`.
+///
+/// Shared with other binary images (see [`crate::diff`]) so they get the
+/// same string table, alignment and checksum. `what` names the image in
+/// error messages.
+pub(crate) fn seal(
+    w: &Writer<'_>,
+    magic: [u8; 8],
+    version: u32,
+    what: &str,
+) -> HedlResult<Vec<u8>> {
+    if w.too_large {
+        return Err(HedlError::conversion(format!(
+            "Cannot write {}: more than {} entries in one collection or the string table",
+            what,
+            NO_STRING - 1
+        )));
+    }
+    let strings_len: usize = w.strings.iter().map(|s| s.len()).sum();
+    let offsets_len = (w.strings.len() + 1) * 8;
+    let total = HEADER_LEN + offsets_len + pad8(strings_len) + pad8(w.tree.len() * 4);
+
+    let mut out = Vec::with_capacity(total);
+    out.extend_from_slice(&magic);
+    out.extend_from_slice(&version.to_le_bytes());
+    out.extend_from_slice(&0u32.to_le_bytes());
+    out.extend_from_slice(&(w.strings.len() as u64).to_le_bytes());
+    out.extend_from_slice(&(strings_len as u64).to_le_bytes());
+    out.extend_from_slice(&(w.tree.len() as u64).to_le_bytes());
+    out.resize(HEADER_LEN, 0); // checksum and reserved
+
+    let mut offset = 0u64;
+    out.extend_from_slice(&offset.to_le_bytes());
+    for s in &w.strings {
+        offset += s.len() as u64;
+        out.extend_from_slice(&offset.to_le_bytes());
+    }
+    for s in &w.strings {
+        out.extend_from_slice(s.as_bytes());
+    }
+    out.resize(pad8(out.len()), 0);
+    for word in &w.tree {
+        out.extend_from_slice(&word.to_le_bytes());
+    }
+    out.resize(pad8(out.len()), 0);
+    debug_assert_eq!(out.len(), total);
+
+    let checksum = checksum(&out[HEADER_LEN..]);
+    out[40..48].copy_from_slice(&checksum.to_le_bytes());
+    Ok(out)
+}
+
+fn pad8(len: usize) -> usize {
+    (len + 7) & !7
+}
+
+/// FNV-1a over 64-bit little-endian words; `body` is a multiple of 8 bytes.
+fn checksum(body: &[u8]) -> u64 {
+    const OFFSET_BASIS: u64 = 0xcbf2_9ce4_8422_2325;
+    const PRIME: u64 = 0x0000_0100_0000_01b3;
+    body.chunks_exact(8).fold(OFFSET_BASIS, |hash, chunk| {
+        let mut word = [0u8; 8];
+        word.copy_from_slice(chunk);
+        (hash ^ u64::from_le_bytes(word)).wrapping_mul(PRIME)
+    })
+}
+
+/// Accumulates the string table and the tree words.
+///
+/// A length that does not fit the format sets `too_large` instead of
+/// failing each call; [`seal`] then refuses the image.
+#[derive(Default)]
+pub(crate) struct Writer<'a> {
+    strings: Vec<&'a str>,
+    index: HashMap<&'a str, u32>,
+    tree: Vec<u32>,
+    too_large: bool,
+}
+
+impl<'a> Writer<'a> {
+    pub(crate) fn word(&mut self, word: u32) {
+        self.tree.push(word);
+    }
+
+    pub(crate) fn u64(&mut self, value: u64) {
+        self.tree.push(value as u32);
+        self.tree.push((value >> 32) as u32);
+    }
+
+    pub(crate) fn count(&mut self, n: usize) {
+        match u32::try_from(n) {
+            Ok(n) => self.word(n),
+            Err(_) => {
+                self.too_large = true;
+                self.word(0);
+            }
+        }
+    }
+
+    pub(crate) fn string(&mut self, s: &'a str) {
+        // NO_STRING stays reserved for absent optional strings
+        let next = match u32::try_from(self.strings.len()) {
+            Ok(next) if next != NO_STRING => next,
+            _ => {
+                self.too_large = true;
+                return self.word(0);
+            }
+        };
+        let index = *self.index.entry(s).or_insert(next);
+        if index == next {
+            self.strings.push(s);
+        }
+        self.word(index);
+    }
+
+    pub(crate) fn opt_usize(&mut self, value: Option<usize>) {
+        match value {
+            Some(n) => {
+                self.word(1);
+                self.u64(n as u64);
+            }
+            None => self.word(0),
+        }
+    }
+
+    fn document(&mut self, doc: &'a Document) {
+        self.word(doc.version.0);
+        self.word(doc.version.1);
+        self.string_map(&doc.aliases);
+        self.count(doc.structs.len());
+        for (name, columns) in &doc.structs {
+            self.string(name);
+            self.strings_list(columns);
+        }
+        self.string_map(&doc.nests);
+        self.object(&doc.root);
+    }
+
+    pub(crate) fn string_map(&mut self, map: &'a BTreeMap<String, String>) {
+        self.count(map.len());
+        for (key, value) in map {
+            self.string(key);
+            self.string(value);
+        }
+    }
+
+    pub(crate) fn strings_list(&mut self, list: &'a [String]) {
+        self.count(list.len());
+        for s in list {
+            self.string(s);
+        }
+    }
+
+    pub(crate) fn object(&mut self, object: &'a BTreeMap<String, Item>) {
+        self.count(object.len());
+        for (key, item) in object {
+            self.string(key);
+            self.item(item);
+        }
+    }
+
+    pub(crate) fn item(&mut self, item: &'a Item) {
+        match item {
+            Item::Scalar(value) => {
+                self.word(ITEM_SCALAR);
+                self.value(value);
+            }
+            Item::Object(object) => {
+                self.word(ITEM_OBJECT);
+                self.object(object);
+            }
+            Item::List(list) => {
+                self.word(ITEM_LIST);
+                self.string(&list.type_name);
+                self.strings_list(&list.schema);
+                self.opt_usize(list.count_hint);
+                self.nodes(&list.rows);
+            }
+        }
+    }
+
+    pub(crate) fn nodes(&mut self, nodes: &'a [Node]) {
+        self.count(nodes.len());
+        for node in nodes {
+            self.node(node);
+        }
+    }
+
+    pub(crate) fn node(&mut self, node: &'a Node) {
+        self.string(&node.type_name);
+        self.string(&node.id);
+        self.count(node.fields.len());
+        for value in &node.fields {
+            self.value(value);
+        }
+        self.opt_usize(node.child_count);
+        self.count(node.children.len());
+        for (type_name, children) in &node.children {
+            self.string(type_name);
+            self.nodes(children);
+        }
+    }
+
+    fn value(&mut self, value: &'a Value) {
+        match value {
+            Value::Null => self.word(VALUE_NULL),
+            Value::Bool(b) => {
+                self.word(VALUE_BOOL);
+                self.word(*b as u32);
+            }
+            Value::Int(n) => {
+                self.word(VALUE_INT);
+                self.u64(*n as u64);
+            }
+            Value::Float(f) => {
+                self.word(VALUE_FLOAT);
+                self.u64(f.to_bits());
+            }
+            Value::String(s) => {
+                self.word(VALUE_STRING);
+                self.string(s);
+            }
+            Value::Tensor(t) => {
+                self.word(VALUE_TENSOR);
+                self.tensor(t);
+            }
+            Value::Reference(r) => {
+                self.word(VALUE_REFERENCE);
+                match &r.type_name {
+                    Some(t) => self.string(t),
+                    None => self.word(NO_STRING),
+                }
+                self.string(&r.id);
+            }
+            Value::Expression(e) => {
+                self.word(VALUE_EXPRESSION);
+                self.expression(e);
+            }
+        }
+    }
+
+    fn tensor(&mut self, tensor: &'a Tensor) {
+        match tensor {
+            Tensor::Scalar(f) => {
+                self.word(TENSOR_SCALAR);
+                self.u64(f.to_bits());
+            }
+            Tensor::Array(items) => {
+                self.word(TENSOR_ARRAY);
+                self.count(items.len());
+                for item in items {
+                    self.tensor(item);
+                }
+            }
+        }
+    }
+
+    fn expression(&mut self, expr: &'a Expression) {
+        match expr {
+            Expression::Literal { value, span } => {
+                self.word(EXPR_LITERAL);
+                match value {
+                    ExprLiteral::Int(n) => {
+                        self.word(LIT_INT);
+                        self.u64(*n as u64);
+                    }
+                    ExprLiteral::Float(f) => {
+                        self.word(LIT_FLOAT);
+                        self.u64(f.to_bits());
+                    }
+                    ExprLiteral::String(s) => {
+                        self.word(LIT_STRING);
+                        self.string(s);
+                    }
+                    ExprLiteral::Bool(b) => {
+                        self.word(LIT_BOOL);
+                        self.word(*b as u32);
+                    }
+                }
+                self.span(span);
+            }
+            Expression::Identifier { name, span } => {
+                self.word(EXPR_IDENTIFIER);
+                self.string(name);
+                self.span(span);
+            }
+            Expression::Call { name, args, span } => {
+                self.word(EXPR_CALL);
+                self.string(name);
+                self.count(args.len());
+                for arg in args {
+                    self.expression(arg);
+                }
+                self.span(span);
+            }
+            Expression::Access {
+                target,
+                field,
+                span,
+            } => {
+                self.word(EXPR_ACCESS);
+                self.expression(target);
+                self.string(field);
+                self.span(span);
+            }
+        }
+    }
+
+    fn span(&mut self, span: &Span) {
+        for pos in [span.start(), span.end()] {
+            self.u64(pos.line() as u64);
+            self.u64(pos.column() as u64);
+        }
+    }
+}
+
+// =============================================================================
+// Reading
+// =============================================================================
+
+/// Load a document from a snapshot written by [`to_snapshot`].
+///
+/// `bytes` may be any alignment (a memory-mapped file is fine) and is only
+/// borrowed for the duration of the call.
+///
+/// # Errors
+///
+/// A conversion error if the bytes are not a snapshot, have another format
+/// version, fail the checksum or are malformed.
+pub fn from_snapshot(bytes: &[u8]) -> HedlResult<Document> {
+    unseal(bytes, SNAPSHOT_MAGIC, SNAPSHOT_FORMAT_VERSION, "snapshot", |r| r.document())
+}
+
+/// Check a container written by [`seal`] and decode its tree with `read`.
+///
+/// `what` names the image in error messages ("Invalid {what}: ...").
+pub(crate) fn unseal<'a, T>(
+    bytes: &'a [u8],
+    magic: [u8; 8],
+    version: u32,
+    what: &'static str,
+    read: impl FnOnce(&mut Reader<'a>) -> HedlResult<T>,
+) -> HedlResult<T> {
+    let invalid = |reason: &str| invalid(what, reason);
+    if bytes.len() < HEADER_LEN || bytes[..8] != magic {
+        return Err(invalid(&format!("not a HEDL {}", what)));
+    }
+    let format = u32::from_le_bytes(array(&bytes[8..12]));
+    if format != version {
+        return Err(invalid(&format!(
+            "format version {} (expected {})",
+            format, version
+        )));
+    }
+    let header_u64 = |at: usize| u64::from_le_bytes(array(&bytes[at..at + 8]));
+    let (string_count, strings_len, tree_words) = (header_u64(16), header_u64(24), header_u64(32));
+
+    // Section sizes must account for the file exactly
+    let sizes = (|| {
+        let offsets_len = string_count.checked_add(1)?.checked_mul(8)?;
+        let strings_at = (HEADER_LEN as u64).checked_add(offsets_len)?;
+        let tree_at = strings_at.checked_add(strings_len.checked_add(7)? & !7)?;
+        let end = tree_at.checked_add(tree_words.checked_mul(4)?.checked_add(7)? & !7)?;
+        Some((strings_at as usize, tree_at as usize, end))
+    })();
+    let (strings_at, tree_at) = match sizes {
+        Some((strings_at, tree_at, end)) if end == bytes.len() as u64 => (strings_at, tree_at),
+        _ => return Err(invalid("truncated or inconsistent section sizes")),
+    };
+    if checksum(&bytes[HEADER_LEN..]) != header_u64(40) {
+        return Err(invalid("checksum mismatch"));
+    }
+
+    let blob = &bytes[strings_at..strings_at + strings_len as usize];
+    let blob = std::str::from_utf8(blob).map_err(|_| invalid("string table is not UTF-8"))?;
+    let offsets = &bytes[HEADER_LEN..strings_at];
+    let mut strings = Vec::with_capacity(string_count as usize);
+    let mut start = 0usize;
+    for end in offsets.chunks_exact(8).skip(1) {
+        let end = u64::from_le_bytes(array(end)) as usize;
+        let s = blob
+            .get(start..end)
+            .ok_or_else(|| invalid("string offsets out of order"))?;
+        strings.push(s);
+        start = end;
+    }
+
+    let tree = &bytes[tree_at..tree_at + tree_words as usize * 4];
+    let mut reader = Reader {
+        words: tree,
+        pos: 0,
+        strings,
+        depth: 0,
+        what,
+    };
+    let value = read(&mut reader)?;
+    if reader.pos != tree.len() {
+        return Err(invalid("trailing tree words"));
+    }
+    Ok(value)
+}
+
+/// Error for a malformed image; `what` names it ("snapshot", "diff").
+pub(crate) fn invalid(what: &str, reason: &str) -> HedlError {
+    HedlError::conversion(format!("Invalid {}: {}", what, reason))
+}
+
+fn array<const N: usize>(bytes: &[u8]) -> [u8; N] {
+    let mut out = [0u8; N];
+    out.copy_from_slice(bytes);
+    out
+}
+
+/// Cursor over the tree words.
+pub(crate) struct Reader<'a> {
+    words: &'a [u8],
+    /// Byte offset of the next word.
+    pos: usize,
+    strings: Vec<&'a str>,
+    depth: usize,
+    /// Name of the image for error messages.
+    what: &'static str,
+}
+
+impl<'a> Reader<'a> {
+    pub(crate) fn invalid(&self, reason: &str) -> HedlError {
+        invalid(self.what, reason)
+    }
+
+    pub(crate) fn word(&mut self) -> HedlResult<u32> {
+        let bytes = self
+            .words
+            .get(self.pos..self.pos + 4)
+            .ok_or_else(|| self.invalid("unexpected end of tree"))?;
+        self.pos += 4;
+        Ok(u32::from_le_bytes(array(bytes)))
+    }
+
+    pub(crate) fn u64(&mut self) -> HedlResult<u64> {
+        let low = self.word()? as u64;
+        let high = self.word()? as u64;
+        Ok(low | (high << 32))
+    }
+
+    /// A collection length; every element takes at least one word, which
+    /// bounds preallocation by the remaining input.
+    pub(crate) fn count(&mut self) -> HedlResult<usize> {
+        let n = self.word()? as usize;
+        if n > (self.words.len() - self.pos) / 4 {
+            return Err(self.invalid("collection length exceeds input"));
+        }
+        Ok(n)
+    }
+
+    fn str(&mut self) -> HedlResult<&'a str> {
+        let index = self.word()?;
+        self.string_at(index)
+    }
+
+    pub(crate) fn string_at(&self, index: u32) -> HedlResult<&'a str> {
+        self.strings
+            .get(index as usize)
+            .copied()
+            .ok_or_else(|| self.invalid("string index out of range"))
+    }
+
+    pub(crate) fn string(&mut self) -> HedlResult<String> {
+        self.str().map(str::to_owned)
+    }
+
+    pub(crate) fn bool(&mut self) -> HedlResult<bool> {
+        match self.word()? {
+            0 => Ok(false),
+            1 => Ok(true),
+            _ => Err(self.invalid("bad boolean")),
+        }
+    }
+
+    pub(crate) fn opt_usize(&mut self) -> HedlResult<Option<usize>> {
+        if self.bool()? {
+            let n = self.u64()?;
+            usize::try_from(n)
+                .map(Some)
+                .map_err(|_| self.invalid("count out of range"))
+        } else {
+            Ok(None)
+        }
+    }
+
+    /// Run `f` one nesting level deeper.
+    pub(crate) fn nested<T>(&mut self, f: impl FnOnce(&mut Self) -> HedlResult<T>) -> HedlResult<T> {
+        if self.depth == MAX_DEPTH {
+            return Err(self.invalid("nesting too deep"));
+        }
+        self.depth += 1;
+        let result = f(self);
+        self.depth -= 1;
+        result
+    }
+
+    fn document(&mut self) -> HedlResult<Document> {
+        let mut doc = Document::new((self.word()?, self.word()?));
+        doc.aliases = self.string_map()?;
+        let n = self.count()?;
+        let mut structs = Vec::with_capacity(n);
+        for _ in 0..n {
+            structs.push((self.string()?, self.strings_list()?));
+        }
+        doc.structs = self.sorted_map(structs)?;
+        doc.nests = self.string_map()?;
+        doc.root = self.object()?;
+        Ok(doc)
+    }
+
+    pub(crate) fn string_map(&mut self) -> HedlResult<BTreeMap<String, String>> {
+        let n = self.count()?;
+        let mut entries = Vec::with_capacity(n);
+        for _ in 0..n {
+            entries.push((self.string()?, self.string()?));
+        }
+        self.sorted_map(entries)
+    }
+
+    pub(crate) fn strings_list(&mut self) -> HedlResult<Vec<String>> {
+        let n = self.count()?;
+        let mut list = Vec::with_capacity(n);
+        for _ in 0..n {
+            list.push(self.string()?);
+        }
+        Ok(list)
+    }
+
+    pub(crate) fn object(&mut self) -> HedlResult<BTreeMap<String, Item>> {
+        let n = self.count()?;
+        let mut entries = Vec::with_capacity(n);
+        for _ in 0..n {
+            let key = self.string()?;
+            entries.push((key, self.item()?));
+        }
+        self.sorted_map(entries)
+    }
+
+    pub(crate) fn item(&mut self) -> HedlResult<Item> {
+        match self.word()? {
+            ITEM_SCALAR => Ok(Item::Scalar(self.value()?)),
+            ITEM_OBJECT => self.nested(|r| r.object()).map(Item::Object),
+            ITEM_LIST => {
+                let type_name = self.string()?;
+                let schema = self.strings_list()?;
+                let count_hint = self.opt_usize()?;
+                let rows = self.nodes()?;
+                Ok(Item::List(MatrixList {
+                    type_name,
+                    schema,
+                    rows,
+                    count_hint,
+                }))
+            }
+            _ => Err(self.invalid("bad item tag")),
+        }
+    }
+
+    pub(crate) fn nodes(&mut self) -> HedlResult<Vec<Node>> {
+        let n = self.count()?;
+        let mut nodes = Vec::with_capacity(n);
+        for _ in 0..n {
+            nodes.push(self.node()?);
+        }
+        Ok(nodes)
+    }
+
+    pub(crate) fn node(&mut self) -> HedlResult<Node> {
+        let type_name = self.string()?;
+        let id = self.string()?;
+        let field_count = self.count()?;
+        let mut fields = Vec::with_capacity(field_count);
+        for _ in 0..field_count {
+            fields.push(self.value()?);
+        }
+        let child_count = self.opt_usize()?;
+        let group_count = self.count()?;
+        let mut groups = Vec::with_capacity(group_count);
+        for _ in 0..group_count {
+            let key = self.string()?;
+            groups.push((key, self.nested(|r| r.nodes())?));
+        }
+        Ok(Node {
+            type_name,
+            id,
+            fields,
+            children: self.sorted_map(groups)?,
+            child_count,
+        })
+    }
+
+    fn value(&mut self) -> HedlResult<Value> {
+        Ok(match self.word()? {
+            VALUE_NULL => Value::Null,
+            VALUE_BOOL => Value::Bool(self.bool()?),
+            VALUE_INT => Value::Int(self.u64()? as i64),
+            VALUE_FLOAT => Value::Float(f64::from_bits(self.u64()?)),
+            VALUE_STRING => Value::String(self.string()?),
+            VALUE_TENSOR => Value::Tensor(self.tensor()?),
+            VALUE_REFERENCE => {
+                let type_name = match self.word()? {
+                    NO_STRING => None,
+                    index => Some(self.string_at(index)?.to_owned()),
+                };
+                Value::Reference(Reference {
+                    type_name,
+                    id: self.string()?,
+                })
+            }
+            VALUE_EXPRESSION => Value::Expression(self.expression()?),
+            _ => return Err(self.invalid("bad value tag")),
+        })
+    }
+    fn tensor(&mut self) -> HedlResult<Tensor> {
+        match self.word()? {
+            TENSOR_SCALAR => Ok(Tensor::Scalar(f64::from_bits(self.u64()?))),
+            TENSOR_ARRAY => self.nested(|r| {
+                let n = r.count()?;
+                let mut items = Vec::with_capacity(n);
+                for _ in 0..n {
+                    items.push(r.tensor()?);
+                }
+                Ok(Tensor::Array(items))
+            }),
+            _ => Err(self.invalid("bad tensor tag")),
+        }
+    }
+
+    fn expression(&mut self) -> HedlResult<Expression> {
+        self.nested(|r| match r.word()? {
+            EXPR_LITERAL => {
+                let value = match r.word()? {
+                    LIT_INT => ExprLiteral::Int(r.u64()? as i64),
+                    LIT_FLOAT => ExprLiteral::Float(f64::from_bits(r.u64()?)),
+                    LIT_STRING => ExprLiteral::String(r.string()?),
+                    LIT_BOOL => ExprLiteral::Bool(r.bool()?),
+                    _ => return Err(r.invalid("bad literal tag")),
+                };
+                Ok(Expression::Literal {
+                    value,
+                    span: r.span()?,
+                })
+            }
+            EXPR_IDENTIFIER => Ok(Expression::Identifier {
+                name: r.string()?,
+                span: r.span()?,
+            }),
+            EXPR_CALL => {
+                let name = r.string()?;
+                let n = r.count()?;
+                let mut args = Vec::with_capacity(n);
+                for _ in 0..n {
+                    args.push(r.expression()?);
+                }
+                Ok(Expression::Call {
+                    name,
+                    args,
+                    span: r.span()?,
+                })
+            }
+            EXPR_ACCESS => Ok(Expression::Access {
+                target: Box::new(r.expression()?),
+                field: r.string()?,
+                span: r.span()?,
+            }),
+            _ => Err(r.invalid("bad expression tag")),
+        })
+    }
+
+    /// Build a map from entries that were written in key order.
+    ///
+    /// Checking the order keeps maps from a malformed image well-formed and
+    /// lets the standard library build the tree in linear time.
+    fn sorted_map<V>(&self, entries: Vec<(String, V)>) -> HedlResult<BTreeMap<String, V>> {
+        if entries.windows(2).any(|pair| pair[0].0 >= pair[1].0) {
+            return Err(self.invalid("map keys out of order"));
+        }
+        Ok(entries.into_iter().collect())
+    }
+
+    fn span(&mut self) -> HedlResult<Span> {
+        let mut pos = || -> HedlResult<SourcePos> {
+            let line = usize::try_from(self.u64()?).map_err(|_| self.invalid("bad span"))?;
+            let column = usize::try_from(self.u64()?).map_err(|_| self.invalid("bad span"))?;
+            Ok(SourcePos::new(line, column))
+        };
+        Ok(Span::new(pos()?, pos()?))
+    }
+}
+
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::parse;
+
+    const SAMPLE: &str = "%VERSION: 1.0
+%ALIAS: %active: \"Active\"
+%STRUCT: Team: [id, name]
+%STRUCT: User: [id, name, team, score, tags]
+%NEST: Team > User
+---
+config:
+  title: Reference data
+  limit: 42
+  ratio: 0.5
+  enabled: true
+  missing: ~
+  matrix: [[1, 2], [3, 4]]
+  formula: $(sum(a.b, 2, \"x\"))
+teams(2): @Team
+  | t1, Platform
+    | u1, Alice, @Team:t1, 9.5, [1, 2]
+    | u2, Bob, @u1, 7, ~
+  | t2, Data
+";
+
+    #[test]
+    fn test_round_trip_preserves_document() {
+        let doc = parse(SAMPLE.as_bytes()).unwrap();
+        let config = doc.get("config").and_then(Item::as_object).unwrap();
+        assert!(matches!(config["formula"], Item::Scalar(Value::Expression(_))));
+        assert!(matches!(config["matrix"], Item::Scalar(Value::Tensor(_))));
+
+        let snapshot = to_snapshot(&doc).unwrap();
+        assert_eq!(&snapshot[..8], &SNAPSHOT_MAGIC);
+        assert_eq!(snapshot.len() % 8, 0);
+        assert_eq!(from_snapshot(&snapshot).unwrap(), doc);
+    }
+
+    #[test]
+    fn test_snapshot_is_deterministic() {
+        let doc = parse(SAMPLE.as_bytes()).unwrap();
+        assert_eq!(to_snapshot(&doc).unwrap(), to_snapshot(&doc.clone()).unwrap());
+    }
+
+    #[test]
+    fn test_empty_document_round_trip() {
+        let doc = Document::new((1, 0));
+        assert_eq!(from_snapshot(&to_snapshot(&doc).unwrap()).unwrap(), doc);
+    }
+
+    #[test]
+    fn test_rejects_corruption() {
+        let doc = parse(SAMPLE.as_bytes()).unwrap();
+        let snapshot = to_snapshot(&doc).unwrap();
+
+        assert!(from_snapshot(b"%VERSION: 1.0\n---\n").is_err());
+        assert!(from_snapshot(&snapshot[..snapshot.len() - 8]).is_err());
+
+        let mut flipped = snapshot.clone();
+        let last = flipped.len() - 9;
+        flipped[last] ^= 0x40;
+        let err = from_snapshot(&flipped).unwrap_err();
+        assert!(err.message.contains("checksum"), "{}", err);
+
+        let mut newer = snapshot;
+        newer[8] = 2;
+        let err = from_snapshot(&newer).unwrap_err();
+        assert!(err.message.contains("format version 2"), "{}", err);
+    }
+
+    #[test]
+    fn test_rejects_malformed_tree_with_valid_checksum() {
+        let doc = parse(SAMPLE.as_bytes()).unwrap();
+        let mut snapshot = to_snapshot(&doc).unwrap();
+        // Point the first tree word past the end, then re-seal
+        let tree_words = u64::from_le_bytes(array(&snapshot[32..40])) as usize;
+        let tree_at = snapshot.len() - pad8(tree_words * 4);
+        // Alias count: third tree word
+        snapshot[tree_at + 8..tree_at + 12].copy_from_slice(&u32::MAX.to_le_bytes());
+        let sum = checksum(&snapshot[HEADER_LEN..]);
+        snapshot[40..48].copy_from_slice(&sum.to_le_bytes());
+        assert!(from_snapshot(&snapshot).is_err());
+    }
+
+    #[test]
+    #[cfg(target_pointer_width = "64")]
+    fn test_oversized_collection_is_an_error() {
+        let mut w = Writer::default();
+        w.count(u32::MAX as usize + 1);
+        let err = seal(&w, SNAPSHOT_MAGIC, SNAPSHOT_FORMAT_VERSION, "snapshot").unwrap_err();
+        assert!(err.message.starts_with("Cannot write snapshot"), "{}", err.message);
+    }
+}
@@ -0,0 +1,102 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Interned strings for the ID registry.
+//!
+//! A [`SymbolTable`] stores each distinct string once and hands out `u32`
+//! [`Symbol`] handles, so a type name shared by millions of rows costs one
+//! allocation and comparing two names is an integer comparison.
+
+use std::collections::HashMap;
+use std::sync::Arc;
+
+/// Handle to a string in a [`SymbolTable`].
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash, PartialOrd, Ord)]
+pub(crate) struct Symbol(u32);
+
+/// Interner mapping strings to [`Symbol`]s and back.
+#[derive(Debug, Default)]
+pub(crate) struct SymbolTable {
+    /// string -> symbol; shares each allocation with `names`
+    symbols: HashMap<Arc<str>, Symbol>,
+    /// symbol -> string
+    names: Vec<Arc<str>>,
+}
+
+impl SymbolTable {
+    /// Create an empty table.
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Get the symbol for `name`, adding it if it is new.
+    ///
+    /// # Panics
+    /// After `u32::MAX` distinct strings.
+    pub fn intern(&mut self, name: &str) -> Symbol {
+        if let Some(&symbol) = self.symbols.get(name) {
+            return symbol;
+        }
+        let symbol = Symbol(u32::try_from(self.names.len()).expect("symbol table full"));
+        let name: Arc<str> = Arc::from(name);
+        self.names.push(Arc::clone(&name));
+        self.symbols.insert(name, symbol);
+        symbol
+    }
+
+    /// Get the symbol for `name` without adding it.
+    pub fn get(&self, name: &str) -> Option<Symbol> {
+        self.symbols.get(name).copied()
+    }
+
+    /// Get the string behind `symbol`.
+    pub fn resolve(&self, symbol: Symbol) -> &str {
+        &self.names[symbol.0 as usize]
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_intern_is_idempotent() {
+        let mut table = SymbolTable::new();
+        let user = table.intern("User");
+        let post = table.intern("Post");
+        assert_ne!(user, post);
+        assert_eq!(table.intern("User"), user);
+        assert_eq!(table.names.len(), 2);
+    }
+
+    #[test]
+    fn test_get_and_resolve() {
+        let mut table = SymbolTable::new();
+        assert_eq!(table.get("alice"), None);
+        let alice = table.intern("alice");
+        assert_eq!(table.get("alice"), Some(alice));
+        assert_eq!(table.resolve(alice), "alice");
+    }
+
+    #[test]
+    fn test_names_share_one_allocation() {
+        let mut table = SymbolTable::new();
+        let symbol = table.intern("User");
+        let (key, _) = table.symbols.get_key_value("User").unwrap();
+        assert!(Arc::ptr_eq(key, &table.names[symbol.0 as usize]));
+    }
+}
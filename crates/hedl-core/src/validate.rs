@@ -0,0 +1,322 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Validation without building a document.
+//!
+//! [`validate`] runs the same preprocessing, header and body rules as
+//! [`parse_with_limits`](crate::parse_with_limits), but the body parser's
+//! frames only hold object keys and row counts. The node ID registry is the
+//! one piece of state that grows with the input; references that cannot be
+//! settled when they are read are queued and checked against the complete
+//! registry once the body ends, so forward references and the ambiguity
+//! rule behave exactly as in a full parse.
+
+use crate::error::HedlResult;
+use crate::header::parse_header;
+use crate::limits::Limits;
+use crate::parser::{parse_body, BodySink, ClosedList, ParseOptions, Row, RowMode};
+use crate::preprocess::preprocess;
+use crate::reference::{check_nest_depth, validate_value_reference, TypeRegistry};
+use crate::value::Value;
+use std::collections::HashSet;
+
+/// Check that `input` is a valid HEDL document without materializing it.
+///
+/// Accepts exactly the inputs [`parse_with_limits`](crate::parse_with_limits)
+/// accepts with the same `options`, and otherwise fails with the error it
+/// would report. The one difference is which error wins when a document has
+/// several unresolved or ambiguous references: this pass reports the first in
+/// document order, a full parse the first in key order.
+///
+/// Memory is bounded by the line index, the registered node IDs and, in
+/// strict mode, the references still unresolved when they were read.
+///
+/// # Examples
+///
+/// ```
+/// use hedl_core::{validate, ParseOptions};
+///
+/// let input = b"%VERSION: 1.0\n%STRUCT: User: [id, name]\n---\n\
+///     users: @User\n  | alice, Alice\nowner: @alice\n";
+/// assert!(validate(input, ParseOptions::default()).is_ok());
+///
+/// let dangling = b"%VERSION: 1.0\n---\nowner: @nobody\n";
+/// assert!(validate(dangling, ParseOptions::default()).is_err());
+/// ```
+pub fn validate(input: &[u8], options: ParseOptions) -> HedlResult<()> {
+    let preprocessed = preprocess(input, &options.limits)?;
+    let lines: Vec<(usize, &str)> = preprocessed.lines().collect();
+    let (header, body_start_idx) = parse_header(&lines, &options.limits)?;
+
+    let mut registry = TypeRegistry::new();
+    let mut sink = ValidateSink::new(options.strict_refs);
+    parse_body(
+        &mut sink,
+        &lines[body_start_idx..],
+        &header,
+        &options.limits,
+        &mut registry,
+        true,
+        RowMode::Sequential,
+        None,
+    )?;
+    sink.finish(&registry)
+}
+
+/// Body sink that keeps keys and row counts instead of items and nodes.
+struct ValidateSink {
+    strict: bool,
+    /// Depth limit that reference resolution applies after a full parse.
+    max_nest_depth: usize,
+    /// First depth past `max_nest_depth`; reported only if the body parses.
+    depth_error: Option<usize>,
+    /// References to check once every ID is known, with the type of the
+    /// row they appear in (`None` in key-value context).
+    pending: Vec<(Value, Option<String>)>,
+}
+
+impl ValidateSink {
+    fn new(strict: bool) -> Self {
+        Self {
+            strict,
+            max_nest_depth: Limits::default().max_nest_depth,
+            depth_error: None,
+            pending: Vec::new(),
+        }
+    }
+
+    fn note_depth(&mut self, depth: usize) {
+        if depth > self.max_nest_depth && self.depth_error.is_none() {
+            self.depth_error = Some(depth);
+        }
+    }
+
+    fn finish(self, registry: &TypeRegistry) -> HedlResult<()> {
+        // A full parse collects IDs (and hits the depth limit) before it
+        // validates a single reference
+        if let Some(depth) = self.depth_error {
+            check_nest_depth(depth, self.max_nest_depth)?;
+        }
+        for (value, current_type) in &self.pending {
+            validate_value_reference(value, registry, self.strict, current_type.as_deref())?;
+        }
+        Ok(())
+    }
+}
+
+impl BodySink for ValidateSink {
+    type Object = HashSet<String>;
+    type Rows = usize;
+
+    fn object_len(object: &Self::Object) -> usize {
+        object.len()
+    }
+
+    fn object_contains(object: &Self::Object, key: &str) -> bool {
+        object.contains(key)
+    }
+
+    fn rows_is_empty(rows: &Self::Rows) -> bool {
+        *rows == 0
+    }
+
+    fn insert_scalar(&mut self, object: &mut Self::Object, key: String, value: Value) {
+        object.insert(key);
+        if let Value::Reference(reference) = &value {
+            // An unqualified reference can still become ambiguous as later
+            // rows register, so it is checked at the end even when lenient
+            if self.strict || reference.type_name.is_none() {
+                self.pending.push((value, None));
+            }
+        }
+    }
+
+    fn insert_object(&mut self, parent: &mut Self::Object, key: String, _object: Self::Object) {
+        parent.insert(key);
+    }
+
+    fn insert_list(
+        &mut self,
+        parent: &mut Self::Object,
+        key: String,
+        _list: ClosedList<Self::Rows>,
+    ) {
+        parent.insert(key);
+    }
+
+    fn push_row(&mut self, rows: &mut Self::Rows, row: Row<'_>) {
+        *rows += 1;
+        self.note_depth(row.depth);
+
+        // Matrix references are scoped to one type and only fail when strict;
+        // most point backwards and resolve against the registry right away
+        if !self.strict {
+            return;
+        }
+        for value in row.values {
+            if let Value::Reference(reference) = value {
+                let type_name = reference.type_name.as_deref().unwrap_or(row.type_name);
+                if !row.registry.contains_in_type(type_name, &reference.id) {
+                    self.pending
+                        .push((value.clone(), Some(row.type_name.to_string())));
+                }
+            }
+        }
+    }
+
+    fn attach_children(&mut self, _rows: &mut Self::Rows, _list: ClosedList<Self::Rows>) {}
+
+    fn open_object(&mut self, depth: usize) {
+        self.note_depth(depth);
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::parser::parse_with_limits;
+
+    fn verdict(result: HedlResult<()>) -> Result<(), String> {
+        result.map_err(|e| e.to_string())
+    }
+
+    /// Assert that validation and a full parse agree on `input`.
+    fn assert_same_verdict(input: &str, strict: bool) {
+        let options = || ParseOptions::builder().strict(strict).build();
+        let parsed = verdict(parse_with_limits(input.as_bytes(), options()).map(|_| ()));
+        let validated = verdict(validate(input.as_bytes(), options()));
+        assert_eq!(validated, parsed, "verdicts differ for:\n{}", input);
+    }
+
+    const HEADER: &str = "%VERSION: 1.0\n\
+        %STRUCT: User: [id, name, manager]\n\
+        %STRUCT: Team: [id, lead]\n\
+        %STRUCT: Post: [id, author]\n\
+        %NEST: User > Post\n\
+        ---\n";
+
+    fn doc(body: &str) -> String {
+        format!("{}{}", HEADER, body)
+    }
+
+    #[test]
+    fn test_valid_documents() {
+        let bodies = [
+            "",
+            "name: demo\ncount: 3\n",
+            "config:\n  db:\n    host: localhost\n  port: 5432\n",
+            "users: @User\n  | alice, Alice, ~\n  | bob, Bob, @alice\n",
+            "users: @User\n  | alice, Alice, @bob\n  | bob, Bob, @alice\n",
+            "users: @User\n  | alice, Alice, ~\n    | p1, @User:alice\n  | bob, Bob, ^\n",
+            "owner: @User:carol\nusers: @User\n  | carol, Carol, ~\n",
+            "teams: @Team\n  | t1, @User:alice\nusers: @User\n  | alice, Alice, ~\n",
+            "empty: @User\n",
+            "text: \"\"\"\n  line one\n  line two\n  \"\"\"\n",
+        ];
+        for body in bodies {
+            let input = doc(body);
+            for strict in [true, false] {
+                assert_same_verdict(&input, strict);
+            }
+            assert!(
+                validate(input.as_bytes(), ParseOptions::default()).is_ok(),
+                "{}",
+                input
+            );
+        }
+    }
+
+    #[test]
+    fn test_invalid_documents() {
+        let bodies = [
+            "a: 1\na: 2\n",
+            "obj:\n",
+            "users: @User\n  | alice, Alice\n",
+            "users: @User\n  | alice, Alice, ~\n  | alice, Again, ~\n",
+            "  | orphan, Row, ~\n",
+            "list: @Missing\n",
+            "users: @User\n  | alice, Alice, @nobody\n",
+            "users: @User\n  | alice, Alice, @Team:alice\n",
+            "owner: @nobody\n",
+            "owner: @User:nobody\n",
+            "text: \"\"\"\n  never closed\n",
+            "teams: @Team\n    | t1, ~\n",
+        ];
+        for body in bodies {
+            let input = doc(body);
+            for strict in [true, false] {
+                assert_same_verdict(&input, strict);
+            }
+        }
+    }
+
+    #[test]
+    fn test_forward_references_resolve() {
+        let input = doc("owner: @dave\nusers: @User\n  | bob, Bob, @dave\n  | dave, Dave, ~\n");
+        assert_same_verdict(&input, true);
+        assert!(validate(input.as_bytes(), ParseOptions::default()).is_ok());
+    }
+
+    #[test]
+    fn test_ambiguous_reference_fails_even_when_lenient() {
+        let input = doc("owner: @x1\nusers: @User\n  | x1, X, ~\nteams: @Team\n  | x1, ~\n");
+        for strict in [true, false] {
+            assert_same_verdict(&input, strict);
+            let err = validate(
+                input.as_bytes(),
+                ParseOptions::builder().strict(strict).build(),
+            )
+            .unwrap_err();
+            assert!(err.message.contains("Ambiguous"), "{}", err.message);
+        }
+    }
+
+    #[test]
+    fn test_lenient_mode_accepts_dangling_references() {
+        let input = doc("owner: @User:ghost\nusers: @User\n  | alice, Alice, @ghost\n");
+        let lenient = ParseOptions::builder().strict(false).build();
+        assert!(validate(input.as_bytes(), lenient).is_ok());
+        assert_same_verdict(&input, true);
+        assert_same_verdict(&input, false);
+    }
+
+    #[test]
+    fn test_preprocess_and_header_errors() {
+        for input in [
+            "",
+            "---\n",
+            "%VERSION: 1.0\r---\n",
+            "%VERSION: 1.0\n%BOGUS\n---\n",
+        ] {
+            assert_same_verdict(input, true);
+        }
+        assert_eq!(
+            verdict(validate(&[0xff, 0xfe], ParseOptions::default())),
+            verdict(parse_with_limits(&[0xff, 0xfe], ParseOptions::default()).map(|_| ()))
+        );
+    }
+
+    #[test]
+    fn test_limits_are_enforced() {
+        let input = doc("users: @User\n  | a, A, ~\n  | b, B, ~\n  | c, C, ~\n");
+        let mut options = ParseOptions::default();
+        options.limits.max_nodes = 2;
+        let parsed = verdict(parse_with_limits(input.as_bytes(), options.clone()).map(|_| ()));
+        assert!(parsed.is_err());
+        assert_eq!(verdict(validate(input.as_bytes(), options)), parsed);
+    }
+}
@@ -20,6 +20,11 @@
  * - Documents must be freed with hedl_free_document()
  * - Diagnostics must be freed with hedl_free_diagnostics()
  * - Byte arrays must be freed with hedl_free_bytes()
+ * - Streams must be closed with hedl_stream_close()
+ * - Push parsers must be freed with hedl_push_parser_free()
+ * - Asynchronous operations must be freed with hedl_async_free()
+ * - Traversal handles (HedlObject, HedlItem, HedlList, HedlNode) are borrowed
+ *   from their document and must NOT be freed
  */
 
 #ifndef HEDL_H
@@ -48,6 +53,14 @@ extern "C" {
 #define HEDL_ERR_CSV         -9
 #define HEDL_ERR_PARQUET     -10
 #define HEDL_ERR_LINT        -11
+#define HEDL_ERR_NEO4J       -12
+#define HEDL_ERR_IO          -13
+#define HEDL_ERR_NOT_FOUND   -14
+#define HEDL_ERR_BUFFER_TOO_SMALL -15
+#define HEDL_ERR_TYPE_MISMATCH -16
+#define HEDL_ERR_CANCELLED   -17
+#define HEDL_ERR_SNAPSHOT    -18
+#define HEDL_ERR_PATCH       -19
 
 /* ==========================================================================
  * Opaque Types
@@ -59,6 +72,71 @@ typedef struct HedlDocument HedlDocument;
 /** Opaque handle to lint diagnostics */
 typedef struct HedlDiagnostics HedlDiagnostics;
 
+/** Opaque handle to a streaming parser */
+typedef struct HedlStream HedlStream;
+
+/** Opaque handle to a reusable parser that owns the documents it parses */
+typedef struct HedlParser HedlParser;
+
+/** Opaque handle to a push parser fed with input chunks */
+typedef struct HedlPushParser HedlPushParser;
+
+/** Opaque handle to a streaming importer of JSON object rows */
+typedef struct HedlJsonImporter HedlJsonImporter;
+
+/** Opaque handle to a document kept in sync with line-based text edits */
+typedef struct HedlIncremental HedlIncremental;
+
+/** Opaque handle to canonical digests of a document and its root entries */
+typedef struct HedlDigests HedlDigests;
+
+/** Opaque handle to an asynchronous parse or export */
+typedef struct HedlAsyncOp HedlAsyncOp;
+
+/** Borrowed handles into a document (see Document Traversal) */
+typedef struct HedlObject HedlObject;
+typedef struct HedlItem HedlItem;
+typedef struct HedlList HedlList;
+typedef struct HedlNode HedlNode;
+
+/* ==========================================================================
+ * Value Views
+ * ========================================================================== */
+
+#define HEDL_VALUE_NULL       0
+#define HEDL_VALUE_BOOL       1
+#define HEDL_VALUE_INT        2
+#define HEDL_VALUE_FLOAT      3
+#define HEDL_VALUE_STRING     4
+#define HEDL_VALUE_TENSOR     5
+#define HEDL_VALUE_REFERENCE  6
+#define HEDL_VALUE_EXPRESSION 7
+
+/**
+ * Borrowed view of a HEDL value.
+ *
+ * Only the members matching kind are meaningful:
+ * - HEDL_VALUE_BOOL: bool_value (0 or 1)
+ * - HEDL_VALUE_INT: int_value
+ * - HEDL_VALUE_FLOAT: float_value
+ * - HEDL_VALUE_STRING: str_ptr/str_len
+ * - HEDL_VALUE_REFERENCE: str_ptr/str_len hold the target ID,
+ *   ref_type_ptr/ref_type_len the type (NULL for local references)
+ *
+ * Strings are NOT null-terminated and point into the object the view was
+ * read from. Do NOT free them.
+ */
+typedef struct HedlValueView {
+    int kind;
+    int bool_value;
+    int64_t int_value;
+    double float_value;
+    const char* str_ptr;
+    size_t str_len;
+    const char* ref_type_ptr;
+    size_t ref_type_len;
+} HedlValueView;
+
 /* ==========================================================================
  * Error Management
  * ========================================================================== */
@@ -92,6 +170,7 @@ void hedl_free_bytes(uint8_t* data, size_t len);
 
 /**
  * Parse a HEDL document from a string.
+ * The input is read in place; it is not copied.
  * @param input UTF-8 encoded HEDL document
  * @param input_len Length in bytes, or -1 for null-terminated
  * @param strict Non-zero for strict mode (validate references)
@@ -100,12 +179,233 @@ void hedl_free_bytes(uint8_t* data, size_t len);
  */
 int hedl_parse(const char* input, int input_len, int strict, HedlDocument** out_doc);
 
+/**
+ * Parse a HEDL document from a buffer with a size_t length.
+ * Like hedl_parse, but the buffer need not be null-terminated and is not
+ * limited to INT_MAX bytes.
+ * @param input UTF-8 encoded HEDL bytes
+ * @param input_len Length in bytes
+ * @param max_size Largest input accepted in bytes, or 0 for the default
+ *        (1 GB). Raising it raises the node and key limits in proportion.
+ */
+int hedl_parse_sized(const char* input, size_t input_len, int strict, size_t max_size,
+                     HedlDocument** out_doc);
+
+/**
+ * Parse a HEDL document from a file.
+ * The file is memory-mapped and parsed in place (no heap copy of the input);
+ * the mapping is released before returning. The file must not be modified
+ * or truncated during the call.
+ * @param path Null-terminated UTF-8 file path
+ * @param max_size Largest file accepted in bytes, or 0 for the default
+ *        (1 GB); as in hedl_parse_sized
+ * @return HEDL_OK on success, HEDL_ERR_IO if the file cannot be opened or
+ *         mapped, error code on other failures
+ */
+int hedl_parse_file(const char* path, int strict, size_t max_size, HedlDocument** out_doc);
+
 /**
  * Validate a HEDL document string.
+ *
+ * Runs the same checks as hedl_parse, including strict reference
+ * resolution, without building a document, so memory stays proportional
+ * to the number of node IDs rather than the document size.
  * @return HEDL_OK if valid, error code if invalid
  */
 int hedl_validate(const char* input, int input_len, int strict);
 
+/** Validate a HEDL document buffer with a size_t length; max_size as in hedl_parse_sized. */
+int hedl_validate_sized(const char* input, size_t input_len, int strict, size_t max_size);
+
+/* ==========================================================================
+ * Reusable Parser
+ * ========================================================================== */
+
+/**
+ * Create a parser whose documents are released together.
+ * @param strict Non-zero for strict mode on every parse
+ * @param out_parser Pointer to store the parser handle
+ * @return HEDL_OK on success, error code on failure
+ */
+int hedl_parser_new(int strict, HedlParser** out_parser);
+
+/**
+ * Parse a document into the parser.
+ * The document is owned by the parser: do NOT pass it to hedl_free_document.
+ * It stays valid until hedl_parser_reset or hedl_parser_free.
+ * @param input UTF-8 encoded HEDL bytes (need not be null-terminated)
+ * @param input_len Length in bytes
+ * @param out_doc Pointer to store the borrowed document handle
+ * @return HEDL_OK on success, error code on failure
+ */
+int hedl_parser_parse(HedlParser* parser, const char* input, size_t input_len,
+                      const HedlDocument** out_doc);
+
+/** Get the number of documents currently owned by the parser. */
+size_t hedl_parser_document_count(const HedlParser* parser);
+
+/**
+ * Release every document owned by the parser in O(1); teardown happens on a
+ * background thread, or on the caller's if the previous reset's teardown is
+ * still running. Invalidates all documents returned by hedl_parser_parse.
+ */
+void hedl_parser_reset(HedlParser* parser);
+
+/** Free the parser and every document it owns. Safe to call with NULL. */
+void hedl_parser_free(HedlParser* parser);
+
+/* ==========================================================================
+ * Incremental Re-parsing
+ * ========================================================================== */
+
+/**
+ * Parse a document and open a handle that applies line edits to it.
+ * Fails exactly when hedl_parse_sized fails for the same input (max_size 0).
+ * @param input UTF-8 encoded HEDL bytes (need not be null-terminated)
+ * @param input_len Length in bytes
+ * @param strict Non-zero for strict mode on every edit
+ * @param out_inc Pointer to store the handle
+ * @return HEDL_OK on success, error code on failure
+ */
+int hedl_incremental_open(const char* input, size_t input_len, int strict,
+                          HedlIncremental** out_inc);
+
+/**
+ * Replace lines [start_line, end_line) (0-indexed) with the lines of text and
+ * re-parse only the top-level entries the edit touches. A trailing newline in
+ * text adds no empty line; empty text (may be NULL) deletes the range.
+ * On error (HEDL_ERR_PARSE for a bad range or text that does not parse) the
+ * document is unchanged. On success, handles and strings obtained through
+ * hedl_incremental_document are invalidated (the document pointer is not).
+ */
+int hedl_incremental_apply_edit(HedlIncremental* inc, size_t start_line, size_t end_line,
+                                const char* text, size_t text_len);
+
+/**
+ * Get the current document. It is owned by the handle: do NOT pass it to
+ * hedl_free_document. The same pointer is returned for the handle's lifetime.
+ */
+const HedlDocument* hedl_incremental_document(const HedlIncremental* inc);
+
+/** Get the number of lines in the current text (a trailing newline ends an empty last line). */
+size_t hedl_incremental_line_count(const HedlIncremental* inc);
+
+/** Close the handle and free its document. Safe to call with NULL. */
+void hedl_incremental_close(HedlIncremental* inc);
+
+/* ==========================================================================
+ * Batch Parsing
+ * ========================================================================== */
+
+/**
+ * Parse many HEDL documents in parallel on a work-stealing thread pool.
+ * Slot i of each output array receives the result for inputs[i]; errors are
+ * reported per slot, not through hedl_get_last_error.
+ * @param inputs Array of n UTF-8 HEDL inputs (read in place, not copied)
+ * @param lens Array of n byte lengths, or NULL if every input is null-terminated
+ * @param n Number of inputs
+ * @param strict Non-zero for strict mode (validate references)
+ * @param out_docs Receives n document handles (NULL for failed slots);
+ *                 free each with hedl_free_document
+ * @param out_codes Receives n status codes
+ * @param out_errors Receives n error messages (NULL for successful slots), or
+ *                   pass NULL to skip them; free each with hedl_free_string
+ * @param threads Worker count: 0 for one per core, 1 for the calling thread
+ *                only; larger counts are capped at the core count
+ * @return HEDL_OK if every input parsed, else the code of the first failed slot
+ */
+int hedl_parse_batch(const char* const* inputs, const size_t* lens, size_t n, int strict,
+                     HedlDocument** out_docs, int* out_codes, char** out_errors,
+                     int threads);
+
+/**
+ * Parse one document, splitting long matrix lists into row chunks that are
+ * parsed in parallel. The result, or the error, is the same as
+ * hedl_parse_sized; lists shorter than a few thousand rows gain nothing.
+ * @param input UTF-8 encoded HEDL bytes (need not be null-terminated)
+ * @param input_len Length in bytes
+ * @param threads Worker count: 0 for one per core, 1 for the calling thread
+ *                only; larger counts are capped at the core count
+ * @return HEDL_OK on success, HEDL_ERR_ALLOC if the thread pool cannot be
+ *         created, error code on other failures
+ */
+int hedl_parse_parallel(const char* input, size_t input_len, int strict, int threads,
+                        HedlDocument** out_doc);
+
+/**
+ * Parse only the listed keys and columns. Other items are skipped without
+ * being parsed (errors inside them are not reported) and cells of other
+ * columns are never converted; strict mode still resolves references into
+ * skipped lists.
+ * @param keys Dotted key paths to keep ("config.database"), or NULL for all
+ * @param n_keys Number of entries in keys
+ * @param columns "Type.column" entries to keep for %STRUCT types, or NULL for
+ *                all; projected types keep their ID column and their schemas
+ *                list the kept columns only
+ * @param n_columns Number of entries in columns
+ * @return HEDL_OK on success, HEDL_ERR_PARSE for parse errors and unknown
+ *         projected types or columns, error code on other failures
+ */
+int hedl_parse_projected(const char* input, size_t input_len, int strict,
+                         const char* const* keys, size_t n_keys,
+                         const char* const* columns, size_t n_columns,
+                         HedlDocument** out_doc);
+
+/* ==========================================================================
+ * Binary Snapshots
+ *
+ * A snapshot is a versioned binary image of a parsed document. Loading one
+ * skips lexing, inference and reference resolution. Snapshots from another
+ * format version, or that fail their checksum, are rejected with
+ * HEDL_ERR_SNAPSHOT: rebuild them from the HEDL source.
+ * ========================================================================== */
+
+/**
+ * Serialize a document into a snapshot.
+ * @param out_data Receives the bytes (must free with hedl_free_bytes)
+ * @return HEDL_OK, HEDL_ERR_SNAPSHOT if a collection or the string table
+ *         exceeds the format's 32-bit lengths
+ */
+int hedl_to_snapshot(const HedlDocument* doc, uint8_t** out_data, size_t* out_len);
+
+/** Write a document's snapshot to a file, replacing any existing file. */
+int hedl_save_snapshot(const HedlDocument* doc, const char* path);
+
+/** Load a document from snapshot bytes (read in place, any alignment). */
+int hedl_from_snapshot(const uint8_t* data, size_t len, HedlDocument** out_doc);
+
+/**
+ * Load a document from a snapshot file. The file is memory-mapped and
+ * decoded straight from the mapping.
+ * @return HEDL_OK, HEDL_ERR_IO if the file cannot be opened or mapped,
+ *         HEDL_ERR_SNAPSHOT if it is not a valid snapshot
+ */
+int hedl_load_snapshot(const char* path, HedlDocument** out_doc);
+
+/* ==========================================================================
+ * Structural Diffs
+ *
+ * A delta records only what changed between two documents; matrix list rows
+ * are matched by node ID. Deltas that are malformed or do not fit the target
+ * are rejected with HEDL_ERR_PATCH and leave the target unchanged.
+ * ========================================================================== */
+
+/**
+ * Encode the changes that turn old_doc into new_doc.
+ * @param out_delta Receives the bytes (must free with hedl_free_bytes)
+ * @return HEDL_OK, HEDL_ERR_PATCH if the delta exceeds the format's 32-bit
+ *         lengths
+ */
+int hedl_diff(const HedlDocument* old_doc, const HedlDocument* new_doc,
+              uint8_t** out_delta, size_t* out_len);
+
+/**
+ * Apply a delta from hedl_diff to a document in place. doc must not be a
+ * shared handle.
+ * @return HEDL_OK, HEDL_ERR_PATCH if the delta does not apply
+ */
+int hedl_apply_patch(HedlDocument* doc, const uint8_t* delta, size_t len);
+
 /* ==========================================================================
  * Document Information
  * ========================================================================== */
@@ -122,6 +422,139 @@ int hedl_alias_count(const HedlDocument* doc);
 /** Get the number of root items. Returns -1 on error. */
 int hedl_root_item_count(const HedlDocument* doc);
 
+/* ==========================================================================
+ * Document Traversal
+ *
+ * Read-only access to a parsed document. Handles, strings and value views
+ * point into the document and stay valid until it is freed; none of them
+ * is freed by the caller. Strings are NOT null-terminated. Key and name
+ * arguments are length-delimited.
+ * ========================================================================== */
+
+#define HEDL_ITEM_SCALAR 0
+#define HEDL_ITEM_OBJECT 1
+#define HEDL_ITEM_LIST   2
+
+/** Root object of a document. Returns NULL on error. */
+const HedlObject* hedl_document_root(const HedlDocument* doc);
+
+/** Number of entries in an object (0 for NULL). */
+size_t hedl_object_len(const HedlObject* obj);
+
+/** Look up an entry by key. Returns HEDL_ERR_NOT_FOUND for a missing key. */
+int hedl_object_get(const HedlObject* obj, const char* key, size_t key_len,
+                    const HedlItem** out_item);
+
+/**
+ * Key cursor over an object's entries in key order.
+ * Pass after_key = NULL for the first entry, then the previously returned key.
+ * @return HEDL_OK, or HEDL_ERR_NOT_FOUND past the last entry
+ */
+int hedl_object_next(const HedlObject* obj, const char* after_key, size_t after_len,
+                     const char** out_key, size_t* out_key_len, const HedlItem** out_item);
+
+/** Kind of an item (HEDL_ITEM_*). Returns -1 for NULL. */
+int hedl_item_kind(const HedlItem* item);
+
+/** Value of a scalar item. Returns HEDL_ERR_TYPE_MISMATCH for other kinds. */
+int hedl_item_value(const HedlItem* item, HedlValueView* out_value);
+
+/** Object of an object item, or NULL. */
+const HedlObject* hedl_item_object(const HedlItem* item);
+
+/** Matrix list of a list item, or NULL. */
+const HedlList* hedl_item_list(const HedlItem* item);
+
+/** Entity type name of a list. */
+int hedl_list_type_name(const HedlList* list, const char** out_type, size_t* out_len);
+
+/** Number of schema columns (the ID is column 0). */
+size_t hedl_list_column_count(const HedlList* list);
+
+/** Schema column name at index. */
+int hedl_list_column(const HedlList* list, size_t index, const char** out_name, size_t* out_len);
+
+/** Index of the schema column with the given name. */
+int hedl_list_column_index(const HedlList* list, const char* name, size_t name_len,
+                           size_t* out_index);
+
+/** Number of rows in a list. */
+size_t hedl_list_row_count(const HedlList* list);
+
+/** Row at index, or NULL if out of range. */
+const HedlNode* hedl_list_row(const HedlList* list, size_t index);
+
+/** Entity type name of a node. */
+int hedl_node_type_name(const HedlNode* node, const char** out_type, size_t* out_len);
+
+/** ID of a node. */
+int hedl_node_id(const HedlNode* node, const char** out_id, size_t* out_len);
+
+/** Number of fields of a node (aligned with the list schema). */
+size_t hedl_node_field_count(const HedlNode* node);
+
+/** Field at index as a value view. */
+int hedl_node_field(const HedlNode* node, size_t index, HedlValueView* out_value);
+
+/*
+ * Typed field getters. Each returns HEDL_ERR_NOT_FOUND for an out-of-range
+ * index and HEDL_ERR_TYPE_MISMATCH if the field has another kind (a null
+ * field matches no type). hedl_node_field_float also accepts integers.
+ */
+int hedl_node_field_int(const HedlNode* node, size_t index, int64_t* out_value);
+int hedl_node_field_float(const HedlNode* node, size_t index, double* out_value);
+int hedl_node_field_bool(const HedlNode* node, size_t index, int* out_value);
+int hedl_node_field_string(const HedlNode* node, size_t index,
+                           const char** out_str, size_t* out_len);
+
+/** Reference field; *out_type is NULL (length 0) for local references. */
+int hedl_node_field_reference(const HedlNode* node, size_t index,
+                              const char** out_type, size_t* out_type_len,
+                              const char** out_id, size_t* out_id_len);
+
+/** Number of child type groups of a node. */
+size_t hedl_node_child_group_count(const HedlNode* node);
+
+/**
+ * Key cursor over a node's child groups in type-name order.
+ * Pass after_type = NULL for the first group, then the previously returned type.
+ * @param out_count Number of children in the group
+ * @return HEDL_OK, or HEDL_ERR_NOT_FOUND past the last group
+ */
+int hedl_node_children_next(const HedlNode* node, const char* after_type, size_t after_len,
+                            const char** out_type, size_t* out_type_len, size_t* out_count);
+
+/** Child at index within the given type group, or NULL. */
+const HedlNode* hedl_node_child(const HedlNode* node, const char* type_name, size_t type_len,
+                                size_t index);
+
+/* ==========================================================================
+ * Node Lookup
+ *
+ * The first lookup on a document indexes every node by type and ID in one
+ * pass; later lookups are a single hash probe. The index is freed with the
+ * document (and rebuilt after an incremental edit).
+ * ========================================================================== */
+
+/**
+ * Find the node of a type with a given ID (nested children included).
+ * @return HEDL_OK, or HEDL_ERR_NOT_FOUND if no node of that type has the ID
+ */
+int hedl_find_node(const HedlDocument* doc, const char* type_name, size_t type_len,
+                   const char* id, size_t id_len, const HedlNode** out_node);
+
+/**
+ * Find the node a reference value points to, with strict-parsing scoping:
+ * a qualified reference looks only in its type, an unqualified one in the
+ * type of context, or in every type for a key-value reference.
+ * @param reference View of a reference (from hedl_node_field or hedl_item_value)
+ * @param context Node the reference was read from, or NULL for a key-value reference
+ * @return HEDL_OK, HEDL_ERR_TYPE_MISMATCH if the view is not a reference, or
+ *         HEDL_ERR_NOT_FOUND if it does not name exactly one node
+ */
+int hedl_resolve_reference(const HedlDocument* doc, const HedlValueView* reference,
+                           const HedlNode* context, const HedlNode** out_node);
+
 /* ==========================================================================
  * Callback Type for Zero-Copy Output
  * ========================================================================== */
@@ -130,10 +563,16 @@ int hedl_root_item_count(const HedlDocument* doc);
  * Output callback function type for zero-copy string return.
  *
  * The callback receives:
- * - data: Pointer to output data (valid only during callback)
- * - len: Length of data in bytes (NOT null-terminated)
+ * - data: Pointer to the next chunk of output (valid only during callback)
+ * - len: Length of the chunk in bytes (NOT null-terminated)
  * - user_data: User-provided context pointer
  *
+ * Output is streamed: the callback is invoked once per chunk, in order (at
+ * least once; empty output arrives as a single zero-length call), and
+ * the full output is never held in memory. Every chunk except the last is
+ * exactly the chunk size. Chunks are split on byte boundaries, so a UTF-8
+ * sequence may straddle two calls.
+ *
  * CRITICAL: The data pointer is only valid during the callback execution.
  * Do NOT store the pointer for later use. If you need to keep the data,
  * copy it within the callback.
@@ -142,6 +581,9 @@ int hedl_root_item_count(const HedlDocument* doc);
  */
 typedef void (*hedl_output_callback)(const char* data, size_t len, void* user_data);
 
+/** Chunk size used by the hedl_*_callback functions (64 KiB). */
+#define HEDL_DEFAULT_CHUNK_SIZE 65536
+
 /* ==========================================================================
  * Canonicalization
  * ========================================================================== */
@@ -154,12 +596,75 @@ int hedl_canonicalize(const HedlDocument* doc, char** out_str);
 
 /**
  * Canonicalize a HEDL document using zero-copy callback.
- * Recommended for large outputs (>1MB) to avoid memory allocation.
+ * Output is streamed in HEDL_DEFAULT_CHUNK_SIZE chunks; recommended for large outputs.
  * @param callback Function to receive the output data
  * @param user_data User context pointer passed to callback
  */
 int hedl_canonicalize_callback(const HedlDocument* doc, hedl_output_callback callback, void* user_data);
 
+/**
+ * Canonicalize a HEDL document, streaming chunks of at most chunk_size bytes.
+ * @param chunk_size Maximum bytes per callback call (0 for HEDL_DEFAULT_CHUNK_SIZE)
+ */
+int hedl_canonicalize_callback_chunked(const HedlDocument* doc, size_t chunk_size, hedl_output_callback callback, void* user_data);
+
+/* ==========================================================================
+ * Canonical Digests
+ * ==========================================================================
+ * Digests are computed by streaming the canonical form into the hasher; no
+ * canonical text is allocated. A document digest equals hashing the output
+ * of hedl_canonicalize. The document digest and the per-entry digests are
+ * computed together and cached on the document until it is edited or
+ * patched.
+ */
+
+/** BLAKE3, 32-byte digests. */
+#define HEDL_HASH_BLAKE3 0
+/** XXH3 128-bit, 16-byte digests (big-endian). Fast, not cryptographic. */
+#define HEDL_HASH_XXH3_128 1
+/** Size of the largest digest; always enough for out_digest. */
+#define HEDL_HASH_MAX_SIZE 32
+
+/**
+ * Hash the canonical form of a document.
+ * @param algo HEDL_HASH_BLAKE3 or HEDL_HASH_XXH3_128
+ * @param out_digest Receives the digest (32 or 16 bytes)
+ * @return HEDL_OK, HEDL_ERR_NOT_FOUND for an unknown algo,
+ *         HEDL_ERR_CANONICALIZE if the document cannot be canonicalized
+ */
+int hedl_canonical_hash(const HedlDocument* doc, int algo, uint8_t* out_digest);
+
+/**
+ * Get the document digest and one digest per root entry (cached, see above).
+ * Entry digests cover that entry's canonical lines alone: equal digests under
+ * the same key in two documents mean the entry is unchanged. The handle does
+ * not reference the document and stays valid after it is freed.
+ * @param out_digests Pointer to store the handle (must free with hedl_digests_free)
+ */
+int hedl_digests_new(const HedlDocument* doc, int algo, HedlDigests** out_digests);
+
+/** Copy the whole-document digest (same as hedl_canonical_hash). */
+int hedl_digests_document(const HedlDigests* digests, uint8_t* out_digest);
+
+/** Number of root entries. */
+size_t hedl_digests_count(const HedlDigests* digests);
+
+/**
+ * Copy the digest of the root entry key.
+ * @return HEDL_OK, or HEDL_ERR_NOT_FOUND if there is no such entry
+ */
+int hedl_digests_get(const HedlDigests* digests, const char* key, size_t key_len, uint8_t* out_digest);
+
+/**
+ * Get the index-th root entry in key order and its digest. The key is not
+ * null-terminated and lives as long as the handle.
+ * @return HEDL_OK, or HEDL_ERR_NOT_FOUND if index is out of range
+ */
+int hedl_digests_entry(const HedlDigests* digests, size_t index, const char** out_key, size_t* out_key_len, uint8_t* out_digest);
+
+/** Free a digests handle. NULL is ignored. */
+void hedl_digests_free(HedlDigests* digests);
+
 /* ==========================================================================
  * JSON Conversion
  * ========================================================================== */
@@ -173,19 +678,28 @@ int hedl_to_json(const HedlDocument* doc, int include_metadata, char** out_str);
 
 /**
  * Convert a HEDL document to JSON using zero-copy callback.
- * Recommended for large outputs (>1MB) to avoid memory allocation.
+ * Output is streamed in HEDL_DEFAULT_CHUNK_SIZE chunks; recommended for large outputs.
  * @param include_metadata Non-zero to include HEDL metadata
  * @param callback Function to receive the output data
  * @param user_data User context pointer passed to callback
  */
 int hedl_to_json_callback(const HedlDocument* doc, int include_metadata, hedl_output_callback callback, void* user_data);
 
+/**
+ * Convert a HEDL document to JSON, streaming chunks of at most chunk_size bytes.
+ * @param chunk_size Maximum bytes per callback call (0 for HEDL_DEFAULT_CHUNK_SIZE)
+ */
+int hedl_to_json_callback_chunked(const HedlDocument* doc, int include_metadata, size_t chunk_size, hedl_output_callback callback, void* user_data);
+
 /**
  * Parse JSON into a HEDL document.
  * @param json_len Length in bytes, or -1 for null-terminated
  */
 int hedl_from_json(const char* json, int json_len, HedlDocument** out_doc);
 
+/** Parse JSON from a buffer with a size_t length (need not be null-terminated). */
+int hedl_from_json_sized(const char* json, size_t json_len, HedlDocument** out_doc);
+
 /* ==========================================================================
  * YAML Conversion
  * ========================================================================== */
@@ -199,19 +713,28 @@ int hedl_to_yaml(const HedlDocument* doc, int include_metadata, char** out_str);
 
 /**
  * Convert a HEDL document to YAML using zero-copy callback.
- * Recommended for large outputs (>1MB) to avoid memory allocation.
+ * Output is streamed in HEDL_DEFAULT_CHUNK_SIZE chunks; recommended for large outputs.
  * @param include_metadata Non-zero to include HEDL metadata
  * @param callback Function to receive the output data
  * @param user_data User context pointer passed to callback
  */
 int hedl_to_yaml_callback(const HedlDocument* doc, int include_metadata, hedl_output_callback callback, void* user_data);
 
+/**
+ * Convert a HEDL document to YAML, streaming chunks of at most chunk_size bytes.
+ * @param chunk_size Maximum bytes per callback call (0 for HEDL_DEFAULT_CHUNK_SIZE)
+ */
+int hedl_to_yaml_callback_chunked(const HedlDocument* doc, int include_metadata, size_t chunk_size, hedl_output_callback callback, void* user_data);
+
 /**
  * Parse YAML into a HEDL document.
  * @param yaml_len Length in bytes, or -1 for null-terminated
  */
 int hedl_from_yaml(const char* yaml, int yaml_len, HedlDocument** out_doc);
 
+/** Parse YAML from a buffer with a size_t length (need not be null-terminated). */
+int hedl_from_yaml_sized(const char* yaml, size_t yaml_len, HedlDocument** out_doc);
+
 /* ==========================================================================
  * XML Conversion
  * ========================================================================== */
@@ -224,18 +747,27 @@ int hedl_to_xml(const HedlDocument* doc, char** out_str);
 
 /**
  * Convert a HEDL document to XML using zero-copy callback.
- * Recommended for large outputs (>1MB) to avoid memory allocation.
+ * Output is streamed in HEDL_DEFAULT_CHUNK_SIZE chunks; recommended for large outputs.
  * @param callback Function to receive the output data
  * @param user_data User context pointer passed to callback
  */
 int hedl_to_xml_callback(const HedlDocument* doc, hedl_output_callback callback, void* user_data);
 
+/**
+ * Convert a HEDL document to XML, streaming chunks of at most chunk_size bytes.
+ * @param chunk_size Maximum bytes per callback call (0 for HEDL_DEFAULT_CHUNK_SIZE)
+ */
+int hedl_to_xml_callback_chunked(const HedlDocument* doc, size_t chunk_size, hedl_output_callback callback, void* user_data);
+
 /**
  * Parse XML into a HEDL document.
  * @param xml_len Length in bytes, or -1 for null-terminated
  */
 int hedl_from_xml(const char* xml, int xml_len, HedlDocument** out_doc);
 
+/** Parse XML from a buffer with a size_t length (need not be null-terminated). */
+int hedl_from_xml_sized(const char* xml, size_t xml_len, HedlDocument** out_doc);
+
 /* ==========================================================================
  * CSV Conversion
  * ========================================================================== */
@@ -250,12 +782,19 @@ int hedl_to_csv(const HedlDocument* doc, char** out_str);
 /**
  * Convert a HEDL document to CSV using zero-copy callback.
  * Note: Only works for documents with matrix lists.
- * Recommended for large outputs (>1MB) to avoid memory allocation.
+ * Output is streamed in HEDL_DEFAULT_CHUNK_SIZE chunks; recommended for large outputs.
  * @param callback Function to receive the output data
  * @param user_data User context pointer passed to callback
  */
 int hedl_to_csv_callback(const HedlDocument* doc, hedl_output_callback callback, void* user_data);
 
+/**
+ * Convert a HEDL document to CSV, streaming chunks of at most chunk_size bytes.
+ * Rows are written as they are serialized, so memory use does not grow with row count.
+ * @param chunk_size Maximum bytes per callback call (0 for HEDL_DEFAULT_CHUNK_SIZE)
+ */
+int hedl_to_csv_callback_chunked(const HedlDocument* doc, size_t chunk_size, hedl_output_callback callback, void* user_data);
+
 /* ==========================================================================
  * Parquet Conversion
  * ========================================================================== */
@@ -275,6 +814,88 @@ int hedl_to_parquet(const HedlDocument* doc, uint8_t** out_data, size_t* out_len
  */
 int hedl_from_parquet(const uint8_t* data, size_t len, HedlDocument** out_doc);
 
+/**
+ * Read a Parquet file, decoding only the selected columns and row groups.
+ * The file is memory-mapped; only the footer and the selected column chunks
+ * are paged in and decompressed.
+ * @param path Null-terminated UTF-8 file path
+ * @param columns Top-level column names, or NULL for all. Selected columns
+ *                keep file order; the first becomes the node ID.
+ * @param n_columns Number of entries in columns
+ * @param row_groups Row group indices, or NULL for all
+ * @param n_row_groups Number of entries in row_groups
+ * @return HEDL_OK on success, HEDL_ERR_IO if the file cannot be opened,
+ *         HEDL_ERR_PARQUET for unknown columns, out-of-range row groups or
+ *         invalid data
+ */
+int hedl_from_parquet_file(const char* path, const char* const* columns, size_t n_columns,
+                           const size_t* row_groups, size_t n_row_groups,
+                           HedlDocument** out_doc);
+
+/* ==========================================================================
+ * Arrow C Data Interface
+ * ========================================================================== */
+
+/* Standard definitions from the Apache Arrow C Data Interface specification. */
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+    void (*release)(struct ArrowSchema*);
+    void* private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+    void (*release)(struct ArrowArray*);
+    void* private_data;
+};
+
+#endif /* ARROW_C_DATA_INTERFACE */
+
+/**
+ * Export the matrix list of type type_name as an Arrow struct array, built
+ * directly from its rows (no Parquet round trip). Column types match
+ * hedl_to_parquet. The outputs own their buffers independently of doc;
+ * release them with their release callbacks (or hand them to a consumer
+ * such as DuckDB or Polars, which takes them over).
+ * @param type_name Null-terminated type name (root items, then nested objects)
+ * @param out_schema Receives the schema (written only on success)
+ * @param out_array Receives the rows (written only on success)
+ * @return HEDL_OK on success, HEDL_ERR_NOT_FOUND if there is no such list,
+ *         HEDL_ERR_PARQUET if the data cannot be exported
+ */
+int hedl_to_arrow(const HedlDocument* doc, const char* type_name,
+                  struct ArrowSchema* out_schema, struct ArrowArray* out_array);
+
+/**
+ * Import an Arrow struct array as a document with one matrix list (the first
+ * column provides node IDs). The array is moved: HEDL releases it and marks
+ * *array released, even on failure. The schema is borrowed.
+ * @return HEDL_OK on success, HEDL_ERR_PARQUET if the array is released,
+ *         not a struct array, or cannot be converted
+ */
+int hedl_from_arrow(const struct ArrowSchema* schema, struct ArrowArray* array,
+                    HedlDocument** out_doc);
+
 /* ==========================================================================
  * Neo4j/Cypher Conversion
  * ========================================================================== */
@@ -289,13 +910,90 @@ int hedl_to_neo4j_cypher(const HedlDocument* doc, int use_merge, char** out_str)
 
 /**
  * Convert a HEDL document to Cypher queries using zero-copy callback.
- * Recommended for large outputs (>1MB) to avoid memory allocation.
+ * Output is streamed in HEDL_DEFAULT_CHUNK_SIZE chunks; recommended for large outputs.
  * @param use_merge Non-zero to use MERGE (idempotent), zero for CREATE
  * @param callback Function to receive the output data
  * @param user_data User context pointer passed to callback
  */
 int hedl_to_neo4j_cypher_callback(const HedlDocument* doc, int use_merge, hedl_output_callback callback, void* user_data);
 
+/**
+ * Convert a HEDL document to Cypher, streaming chunks of at most chunk_size bytes.
+ * @param chunk_size Maximum bytes per callback call (0 for HEDL_DEFAULT_CHUNK_SIZE)
+ */
+int hedl_to_neo4j_cypher_callback_chunked(const HedlDocument* doc, int use_merge, size_t chunk_size, hedl_output_callback callback, void* user_data);
+
+/**
+ * Convert a HEDL document to parameterized Cypher batches for bulk import.
+ * Output is one JSON object per line: {"statement": "...", "parameters": {...}}.
+ * Nodes (by label) and relationships (by type) are grouped into
+ * "UNWIND $rows AS row" statements whose rows travel in parameters.rows, so
+ * Neo4j plans each statement text once. Run each line with the driver's
+ * run(statement, parameters).
+ * @param use_merge Non-zero to use MERGE (idempotent), zero for CREATE
+ * @param batch_size Maximum rows per UNWIND statement (0 for the default of 1000)
+ * @param out_str Pointer to store output (must free with hedl_free_string)
+ */
+int hedl_to_neo4j_batches(const HedlDocument* doc, int use_merge, size_t batch_size, char** out_str);
+
+/**
+ * Stream the output of hedl_to_neo4j_batches in chunks of at most chunk_size bytes.
+ * Lines are generated one batch at a time; a line may span several callbacks.
+ * @param batch_size Maximum rows per UNWIND statement (0 for the default of 1000)
+ * @param chunk_size Maximum bytes per callback call (0 for HEDL_DEFAULT_CHUNK_SIZE)
+ */
+int hedl_to_neo4j_batches_callback(const HedlDocument* doc, int use_merge, size_t batch_size,
+                                   size_t chunk_size, hedl_output_callback callback,
+                                   void* user_data);
+
+/* ==========================================================================
+ * Caller-Buffer Export
+ * ========================================================================== */
+
+/*
+ * The hedl_*_into functions write the NUL-terminated output into buf and
+ * allocate nothing for it, so no hedl_free_string call is needed.
+ *
+ * - out_needed (may be NULL) receives the exact size required, including
+ *   the terminator, whenever serialization succeeds
+ * - Returns HEDL_OK when the output fits, or HEDL_ERR_BUFFER_TOO_SMALL with
+ *   buf holding an empty string (if cap > 0); retry with out_needed bytes
+ * - buf may be NULL when cap is 0, which makes the call a pure size query
+ */
+
+/** Canonicalize a HEDL document into a caller buffer of cap bytes. */
+int hedl_canonicalize_into(const HedlDocument* doc, char* buf, size_t cap, size_t* out_needed);
+
+/** Convert a HEDL document to JSON in a caller buffer (requires "json" feature). */
+int hedl_to_json_into(const HedlDocument* doc, int include_metadata, char* buf, size_t cap, size_t* out_needed);
+
+/** Convert a HEDL document to YAML in a caller buffer (requires "yaml" feature). */
+int hedl_to_yaml_into(const HedlDocument* doc, int include_metadata, char* buf, size_t cap, size_t* out_needed);
+
+/** Convert a HEDL document to XML in a caller buffer (requires "xml" feature). */
+int hedl_to_xml_into(const HedlDocument* doc, char* buf, size_t cap, size_t* out_needed);
+
+/** Convert a HEDL document to CSV in a caller buffer (requires "csv" feature). */
+int hedl_to_csv_into(const HedlDocument* doc, char* buf, size_t cap, size_t* out_needed);
+
+/** Convert a HEDL document to Cypher in a caller buffer (requires "neo4j" feature). */
+int hedl_to_neo4j_cypher_into(const HedlDocument* doc, int use_merge, char* buf, size_t cap, size_t* out_needed);
+
+/**
+ * Upper bound on the buffer size needed to export a document, without
+ * serializing it.
+ *
+ * Guaranteed: the matching _into call with cap >= *out_size never returns
+ * HEDL_ERR_BUFFER_TOO_SMALL. Computed from value lengths, nesting depth and
+ * the format's worst-case escape factor, so it can be several times the
+ * real output.
+ * @param format HEDL_FORMAT_* (defined below); Parquet has no text form
+ * @param flags HEDL_EXPORT_METADATA for JSON/YAML; Cypher covers both modes
+ * @param out_size Receives the bound in bytes, including the terminator
+ * @return HEDL_OK, or HEDL_ERR_NOT_FOUND if the format is not built in
+ */
+int hedl_estimate_output_size(const HedlDocument* doc, int format, uint32_t flags, size_t* out_size);
+
 /* ==========================================================================
  * Linting
  * ========================================================================== */
@@ -306,6 +1004,24 @@ int hedl_to_neo4j_cypher_callback(const HedlDocument* doc, int use_merge, hedl_o
  */
 int hedl_lint(const HedlDocument* doc, HedlDiagnostics** out_diag);
 
+/** Lint rule bits for hedl_lint_with_rules. */
+#define HEDL_LINT_RULE_ID_NAMING          (1u << 0)
+#define HEDL_LINT_RULE_UNUSED_SCHEMA      (1u << 1)
+#define HEDL_LINT_RULE_EMPTY_LIST         (1u << 2)
+#define HEDL_LINT_RULE_UNQUALIFIED_KV_REF (1u << 3)
+#define HEDL_LINT_RULES_ALL               0xFu
+
+/**
+ * Lint with a subset of rules, run in parallel. Diagnostics are identical to
+ * a sequential run with the same settings.
+ * @param rules HEDL_LINT_RULE_* mask of rules to run
+ * @param error_rules Rules whose warnings are reported as errors
+ * @param max_diagnostics Stop after this many diagnostics (0 for the default limit)
+ * @param stop_on_error Non-zero to skip remaining rules once one reports an error
+ * @param out_diag Pointer to store diagnostics handle (must free with hedl_free_diagnostics)
+ */
+int hedl_lint_with_rules(const HedlDocument* doc, uint32_t rules, uint32_t error_rules, size_t max_diagnostics, int stop_on_error, HedlDiagnostics** out_diag);
+
 /** Get the number of diagnostics. Returns -1 on error. */
 int hedl_diagnostics_count(const HedlDiagnostics* diag);
 
@@ -321,6 +1037,390 @@ int hedl_diagnostics_get(const HedlDiagnostics* diag, int index, char** out_str)
  */
 int hedl_diagnostics_severity(const HedlDiagnostics* diag, int index);
 
+/* ==========================================================================
+ * Streaming Parser
+ * ========================================================================== */
+
+#define HEDL_EVENT_END          0
+#define HEDL_EVENT_LIST_START   1
+#define HEDL_EVENT_NODE         2
+#define HEDL_EVENT_LIST_END     3
+#define HEDL_EVENT_SCALAR       4
+#define HEDL_EVENT_OBJECT_START 5
+#define HEDL_EVENT_OBJECT_END   6
+
+/**
+ * Read callback for streaming input.
+ * Copy at most cap bytes into buf and return the number written,
+ * 0 at end of input, or a negative value on error.
+ */
+typedef ptrdiff_t (*hedl_read_callback)(char* buf, size_t cap, void* user_data);
+
+/**
+ * Open a streaming parser that pulls input through a read callback.
+ * The header is parsed before returning; the body is read lazily.
+ * @param out_stream Pointer to store stream handle (must close with hedl_stream_close)
+ */
+int hedl_stream_open(hedl_read_callback read, void* user_data, HedlStream** out_stream);
+
+/**
+ * Open a streaming parser over a caller-owned buffer (not copied).
+ * The buffer must stay valid until hedl_stream_close().
+ */
+int hedl_stream_open_buffer(const char* input, size_t input_len, HedlStream** out_stream);
+
+/**
+ * Advance to the next event.
+ * @param out_event Receives a HEDL_EVENT_* kind; HEDL_EVENT_END when exhausted
+ * @return HEDL_OK on success, error code on failure (the stream is then finished)
+ */
+int hedl_stream_next(HedlStream* stream, int* out_event);
+
+/** Close a stream handle. NULL is ignored. */
+void hedl_stream_close(HedlStream* stream);
+
+/** Get the %VERSION of the stream header. */
+int hedl_stream_version(const HedlStream* stream, int* major, int* minor);
+
+/** Get the number of %STRUCT definitions. Returns -1 on error. */
+int hedl_stream_struct_count(const HedlStream* stream);
+
+/**
+ * Get a %STRUCT definition by index (type-name order).
+ * @param out_column_count Optional; receives the number of columns
+ */
+int hedl_stream_struct_get(const HedlStream* stream, size_t index,
+                           const char** out_name, size_t* out_name_len,
+                           size_t* out_column_count);
+
+/*
+ * Event accessors. Returned strings are NOT null-terminated, borrowed from the
+ * current event, and invalidated by the next hedl_stream_next() call.
+ * Accessors that do not apply to the current event return HEDL_ERR_NOT_FOUND
+ * (or -1 for the integer-returning ones).
+ */
+
+/** Key of a LIST_START, LIST_END, SCALAR, OBJECT_START or OBJECT_END event. */
+int hedl_stream_event_key(const HedlStream* stream, const char** out_key, size_t* out_len);
+
+/** Type name of a LIST_START, LIST_END or NODE event. */
+int hedl_stream_event_type_name(const HedlStream* stream, const char** out_type, size_t* out_len);
+
+/** ID of a NODE event. */
+int hedl_stream_event_id(const HedlStream* stream, const char** out_id, size_t* out_len);
+
+/** Parent type and ID of a nested NODE event. */
+int hedl_stream_event_parent(const HedlStream* stream,
+                             const char** out_type, size_t* out_type_len,
+                             const char** out_id, size_t* out_id_len);
+
+/** Source line of the current event, or -1. */
+int64_t hedl_stream_event_line(const HedlStream* stream);
+
+/** Nesting depth of a NODE event (0 = top-level), or -1. */
+int64_t hedl_stream_event_depth(const HedlStream* stream);
+
+/** Row count of a LIST_END event, or -1. */
+int64_t hedl_stream_event_row_count(const HedlStream* stream);
+
+/** Field count of a NODE, column count of a LIST_START, 1 for SCALAR, or -1. */
+int64_t hedl_stream_event_field_count(const HedlStream* stream);
+
+/** Schema column name of a LIST_START event. */
+int hedl_stream_event_column(const HedlStream* stream, size_t index,
+                             const char** out_name, size_t* out_len);
+
+/** Field of a NODE event, or the value of a SCALAR event (index 0). */
+int hedl_stream_event_value(const HedlStream* stream, size_t index, HedlValueView* out_value);
+
+/* ==========================================================================
+ * Push Parser
+ * ========================================================================== */
+
+/**
+ * Event callback for the push parser.
+ * stream works with the header and hedl_stream_event_* accessors; it and all
+ * pointers obtained from it are valid only during the call. Do NOT call
+ * hedl_stream_next(), hedl_stream_close() or hedl_push_parser_*() from it.
+ */
+typedef void (*hedl_push_event_callback)(const HedlStream* stream, int event, void* user_data);
+
+/**
+ * Create a push parser.
+ * @param out_parser Pointer to store the handle (must free with hedl_push_parser_free)
+ */
+int hedl_push_parser_new(hedl_push_event_callback callback, void* user_data, HedlPushParser** out_parser);
+
+/**
+ * Feed the next chunk of input (split anywhere; copied, so buf may be reused).
+ * Events completed by the chunk are delivered before returning.
+ * @return HEDL_OK on success; after an error the parser rejects further input
+ */
+int hedl_push_parser_feed(HedlPushParser* parser, const char* chunk, size_t len);
+
+/**
+ * Signal end of input: parses any unterminated last line, closes open lists
+ * and delivers HEDL_EVENT_END.
+ */
+int hedl_push_parser_finish(HedlPushParser* parser);
+
+/** Free a push parser. NULL is ignored. */
+void hedl_push_parser_free(HedlPushParser* parser);
+
+/* ==========================================================================
+ * Streaming JSON Row Import (requires "json" feature)
+ * ==========================================================================
+ * Imports a top-level JSON array of objects, or JSON Lines, as one matrix
+ * list without holding the whole JSON text. Each object becomes a row of the
+ * list stored under key; the row type is derived from the key as in
+ * hedl_from_json ("users" -> User). The schema is inferred from the first
+ * sample_rows objects; later objects may omit columns but not add new ones.
+ * Arrays of objects nested in a row are skipped.
+ */
+
+/**
+ * Create a push-based JSON row importer.
+ * @param key Root key of the list, or NULL for "rows"
+ * @param sample_rows Objects sampled to infer the schema, or 0 for 100
+ * @param out_importer Pointer to store the handle (must free with hedl_json_importer_free)
+ */
+int hedl_json_importer_new(const char* key, size_t sample_rows, HedlJsonImporter** out_importer);
+
+/**
+ * Feed the next chunk of JSON input (split anywhere; copied, so buf may be reused).
+ * @return HEDL_OK on success, HEDL_ERR_JSON on malformed input; after an error
+ *         the importer rejects further input
+ */
+int hedl_json_importer_feed(HedlJsonImporter* importer, const char* chunk, size_t len);
+
+/**
+ * Signal end of input and return the imported document.
+ * The importer still has to be freed afterwards.
+ * @param out_doc Pointer to store document (must free with hedl_free_document)
+ */
+int hedl_json_importer_finish(HedlJsonImporter* importer, HedlDocument** out_doc);
+
+/** Free a JSON row importer. NULL is ignored. */
+void hedl_json_importer_free(HedlJsonImporter* importer);
+
+/**
+ * Import JSON object rows pulled through a read callback.
+ * The callback must not call back into HEDL functions.
+ * @return HEDL_OK on success, HEDL_ERR_IO if the callback fails,
+ *         HEDL_ERR_JSON on malformed input
+ */
+int hedl_from_json_reader(hedl_read_callback read, void* user_data, const char* key,
+                          size_t sample_rows, HedlDocument** out_doc);
+
+/* ==========================================================================
+ * Call Metrics
+ * ==========================================================================
+ * Per-function counters for every audited hedl_* call, summed over all
+ * threads. Recording is lock-free (one atomic shard per thread) and off by
+ * default; while off it costs one relaxed load per call.
+ */
+
+/** Number of latency histogram buckets. */
+#define HEDL_METRICS_BUCKETS 32
+
+/**
+ * Counters for one function. Durations are in nanoseconds; min_ns is 0 when
+ * no call was recorded. latency_buckets[i] counts calls below 2^(i+10) ns
+ * that did not fit a lower bucket; the last bucket also holds slower calls.
+ * function is null-terminated and valid for the life of the process.
+ */
+typedef struct HedlFunctionMetrics {
+    const char* function;
+    uint64_t calls;
+    uint64_t failures;
+    uint64_t total_ns;
+    uint64_t min_ns;
+    uint64_t max_ns;
+    uint64_t bytes_in;
+    uint64_t bytes_out;
+    uint64_t latency_buckets[HEDL_METRICS_BUCKETS];
+} HedlFunctionMetrics;
+
+/**
+ * Turn metrics on (non-zero) or off (0). Collected counters are kept.
+ * @return The previous setting (1 or 0)
+ */
+int hedl_metrics_enable(int enabled);
+
+/**
+ * Copy the counters of every function called since the last reset, sorted by
+ * name. Like snprintf: *out_count always receives the number of functions;
+ * pass cap = 0 (out may be NULL) to size the array.
+ * @return HEDL_OK, or HEDL_ERR_BUFFER_TOO_SMALL if more than cap functions
+ *         have counters (the first cap are still written)
+ */
+int hedl_metrics_snapshot(HedlFunctionMetrics* out, size_t cap, size_t* out_count);
+
+/** Clear all counters on every thread. */
+void hedl_metrics_reset(void);
+
+/* ==========================================================================
+ * Asynchronous Operations
+ *
+ * The *_async functions queue work for the library's async worker threads
+ * (one per core, separate from the parsing pools) and return at once. The
+ * completion callback fires exactly once with the final status; collect the
+ * result from the handle. *out_op is set before the work is queued, so the
+ * callback may run before the submitting call returns. The callback may call
+ * any hedl_* function, including hedl_async_free(op).
+ *
+ * hedl_async_wait and hedl_async_free run an operation no worker has started
+ * yet on the calling thread, callback included. A callback may therefore
+ * wait for or free other operations without starving the workers; only a
+ * cycle of callbacks waiting on each other's operations blocks. The callback
+ * runs on a worker or on such a waiting thread.
+ *
+ * Inputs and documents are borrowed: keep them alive and unmodified until
+ * the callback has returned. Errors of the work are reported by
+ * hedl_async_error, not hedl_get_last_error.
+ * ========================================================================== */
+
+/** Status of an operation that has not completed yet. */
+#define HEDL_ASYNC_PENDING 1
+
+/**
+ * Completion callback.
+ * @param op The operation's handle
+ * @param status HEDL_OK, HEDL_ERR_CANCELLED or the error of the work
+ */
+typedef void (*hedl_async_callback)(HedlAsyncOp* op, int status, void* user_data);
+
+/**
+ * Parse a document on the worker pool; take it with hedl_async_take_document.
+ * @return HEDL_OK if queued, HEDL_ERR_NULL_PTR for a NULL argument or
+ *         HEDL_ERR_ALLOC if the worker threads cannot start (no callback
+ *         will fire)
+ */
+int hedl_parse_async(const char* input, size_t input_len, int strict,
+                     hedl_async_callback callback, void* user_data, HedlAsyncOp** out_op);
+
+/** Parse a file on the worker pool; max_size as in hedl_parse_file. The path is copied. */
+int hedl_parse_file_async(const char* path, int strict, size_t max_size,
+                          hedl_async_callback callback, void* user_data, HedlAsyncOp** out_op);
+
+/**
+ * Export a document on the worker pool; take the string with
+ * hedl_async_take_string. The output equals the blocking variant's.
+ */
+int hedl_to_json_async(const HedlDocument* doc, int include_metadata,
+                       hedl_async_callback callback, void* user_data, HedlAsyncOp** out_op);
+int hedl_to_yaml_async(const HedlDocument* doc, int include_metadata,
+                       hedl_async_callback callback, void* user_data, HedlAsyncOp** out_op);
+int hedl_to_xml_async(const HedlDocument* doc,
+                      hedl_async_callback callback, void* user_data, HedlAsyncOp** out_op);
+int hedl_to_csv_async(const HedlDocument* doc,
+                      hedl_async_callback callback, void* user_data, HedlAsyncOp** out_op);
+int hedl_canonicalize_async(const HedlDocument* doc,
+                            hedl_async_callback callback, void* user_data, HedlAsyncOp** out_op);
+/** Requires the "neo4j" feature. */
+int hedl_to_neo4j_cypher_async(const HedlDocument* doc, int use_merge,
+                               hedl_async_callback callback, void* user_data,
+                               HedlAsyncOp** out_op);
+
+/**
+ * Export to Parquet on the worker pool; take the bytes with
+ * hedl_async_take_bytes. The file is built in one piece, so cancelling while
+ * it runs only discards the result. Requires the "parquet" feature.
+ */
+int hedl_to_parquet_async(const HedlDocument* doc,
+                          hedl_async_callback callback, void* user_data, HedlAsyncOp** out_op);
+
+/**
+ * Request cancellation; never blocks. Queued work is dropped, exports stop at
+ * their next write, a running parse has its document discarded. The callback
+ * still fires, with HEDL_ERR_CANCELLED unless the work had already finished.
+ */
+int hedl_async_cancel(HedlAsyncOp* op);
+
+/** HEDL_ASYNC_PENDING until the work completes, then its final status. */
+int hedl_async_status(const HedlAsyncOp* op);
+
+/**
+ * Block until the callback has returned, then return the final status.
+ * Runs the operation here if no worker has started it. Returns at once when
+ * called from the operation's own callback.
+ */
+int hedl_async_wait(const HedlAsyncOp* op);
+
+/** Error message of a failed operation, or NULL. Valid until hedl_async_free. */
+const char* hedl_async_error(const HedlAsyncOp* op);
+
+/**
+ * Take the parsed document (free with hedl_free_document).
+ * @return HEDL_OK, HEDL_ASYNC_PENDING, the operation's error status,
+ *         HEDL_ERR_TYPE_MISMATCH for an export, HEDL_ERR_NOT_FOUND if taken
+ */
+int hedl_async_take_document(HedlAsyncOp* op, HedlDocument** out_doc);
+
+/** Take the exported string (free with hedl_free_string). Codes as above. */
+int hedl_async_take_string(HedlAsyncOp* op, char** out_str);
+
+/** Take the Parquet bytes (free with hedl_free_bytes). Codes as above. */
+int hedl_async_take_bytes(HedlAsyncOp* op, uint8_t** out_data, size_t* out_len);
+
+/**
+ * Free the handle and any result not taken. A pending operation is cancelled
+ * and the call blocks until its callback has returned (except from inside
+ * that callback); one no worker has started completes as cancelled on the
+ * calling thread. NULL is ignored.
+ */
+void hedl_async_free(HedlAsyncOp* op);
+
+/* ==========================================================================
+ * Shared Documents and Multi-format Export
+ *
+ * Read-only calls (everything taking a const HedlDocument*) never modify
+ * the document, so any number of threads may call them on one document at
+ * once. A shared handle adds a thread-safe reference count so the last
+ * reader frees it. It is an ordinary const HedlDocument*: every exporter,
+ * accessor and *_async function accepts it. Release it with
+ * hedl_document_release, never hedl_free_document.
+ * ========================================================================== */
+
+/**
+ * Move an owned document into a shared handle holding one reference.
+ * doc must not be used afterwards. Not for documents owned by a HedlParser
+ * or HedlIncremental, nor for handles that are already shared.
+ */
+int hedl_document_share(HedlDocument* doc, const HedlDocument** out_shared);
+
+/** Take another reference to a shared document. NULL is ignored. */
+void hedl_document_retain(const HedlDocument* doc);
+
+/** Drop a reference; the last one frees the document. NULL is ignored. */
+void hedl_document_release(const HedlDocument* doc);
+
+#define HEDL_FORMAT_HEDL    0  /* Canonical HEDL text */
+#define HEDL_FORMAT_JSON    1
+#define HEDL_FORMAT_YAML    2
+#define HEDL_FORMAT_XML     3
+#define HEDL_FORMAT_CSV     4
+#define HEDL_FORMAT_PARQUET 5
+#define HEDL_FORMAT_CYPHER  6  /* Neo4j Cypher statements */
+
+/** Include HEDL metadata in JSON and YAML output. */
+#define HEDL_EXPORT_METADATA     (1u << 0)
+/** Emit Cypher MERGE instead of CREATE statements. */
+#define HEDL_EXPORT_CYPHER_MERGE (1u << 1)
+
+/**
+ * Export one document to several formats in parallel on the worker pool.
+ * Slot i of each array receives the result for formats[i]: the output (free
+ * with hedl_free_bytes(out_data[i], out_lens[i]); text is UTF-8 without a
+ * terminator), its status code and, if out_errors is not NULL, the error
+ * message (free with hedl_free_string). Failed slots get NULL and 0.
+ * HEDL_ERR_NOT_FOUND in a slot marks a format not enabled in this build.
+ * @param flags HEDL_EXPORT_* flags
+ * @return HEDL_OK if every format was exported, else the first failed slot's code
+ */
+int hedl_export_multi(const HedlDocument* doc, const int* formats, size_t n, uint32_t flags,
+                      uint8_t** out_data, size_t* out_lens, int* out_codes, char** out_errors);
+
 #ifdef __cplusplus
 }
 #endif
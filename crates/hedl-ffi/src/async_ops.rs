@@ -0,0 +1,1188 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//! Asynchronous parse and export with completion callbacks.
+//!
+//! The `*_async` functions validate their arguments, queue the work for the
+//! library's async workers (one `hedl-async-N` thread per core, separate from
+//! the rayon pools used for parsing) and return at once with a `HedlAsyncOp`
+//! handle. When the work finishes the completion callback runs with the final
+//! status, and the result is collected from the handle with
+//! `hedl_async_take_document`, `hedl_async_take_string` or
+//! `hedl_async_take_bytes`.
+//!
+//! # Waiting
+//!
+//! `hedl_async_wait` and `hedl_async_free` block until the operation's
+//! callback has returned. If no worker has started the operation yet, the
+//! blocking call claims it and runs the work and callback on its own thread
+//! instead. A callback that waits for, or frees, another operation therefore
+//! never sits on a worker while that operation is stuck behind it in the
+//! queue, so blocking calls from callbacks cannot starve the workers. Only a
+//! cycle of callbacks waiting on each other's operations can block.
+//!
+//! # Cancellation
+//!
+//! `hedl_async_cancel` is a request, never a wait. An operation that has not
+//! started yet is dropped without running; an export stops at the next write
+//! of its serializer; a parse that is already running completes and its
+//! document is discarded. Either way the callback still fires exactly once,
+//! with `HEDL_ERR_CANCELLED` unless the work had already finished.
+//!
+//! # Lifetimes
+//!
+//! - The input buffer of `hedl_parse_async` and the document of a
+//!   `hedl_*_async` export are borrowed, not copied: keep them alive and
+//!   unmodified until the callback has returned. Read-only calls on the
+//!   document from other threads remain safe meanwhile.
+//! - `*out_op` is stored before the operation is queued, so the callback may
+//!   run before the submitting call returns.
+//! - `hedl_async_free` on a pending operation cancels it and blocks until its
+//!   callback has returned. The callback itself may free its own operation.
+//! - The callback runs on a worker, or on the thread that waited for or freed
+//!   the operation before a worker started it (see Waiting).
+//!
+//! Errors of the work itself are reported through the handle
+//! (`hedl_async_error`), not the thread-local last error, which belongs to
+//! the worker thread.
+//!
+//! # Usage Example (C)
+//!
+//! ```c
+//! void on_parsed(HedlAsyncOp* op, int status, void* user_data) {
+//!     HedlDocument* doc = NULL;
+//!     if (status == HEDL_OK && hedl_async_take_document(op, &doc) == HEDL_OK) {
+//!         post_to_event_loop(user_data, doc);
+//!     }
+//!     hedl_async_free(op);
+//! }
+//!
+//! HedlAsyncOp* op = NULL;
+//! hedl_parse_async(buf, buf_len, 1, on_parsed, loop, &op);
+//! ```
+
+use crate::audit::{audit_call_failure, audit_call_success, sanitize_pointer, AuditTimer};
+use crate::audit_start;
+#[cfg(feature = "csv")]
+use crate::conversions::to_formats_callback::write_csv;
+#[cfg(feature = "json")]
+use crate::conversions::to_formats_callback::write_json;
+#[cfg(feature = "neo4j")]
+use crate::conversions::to_formats_callback::write_neo4j_cypher;
+#[cfg(feature = "xml")]
+use crate::conversions::to_formats_callback::write_xml;
+#[cfg(feature = "yaml")]
+use crate::conversions::to_formats_callback::write_yaml;
+use crate::conversions::to_formats_callback::{write_canonical, HEDL_DEFAULT_CHUNK_SIZE};
+use crate::error::{clear_error, get_thread_local_error, set_error};
+use crate::memory::is_valid_document_ptr;
+use crate::metrics::{note_input, note_output};
+use crate::types::{
+    HedlDocument, HEDL_ERR_ALLOC, HEDL_ERR_CANCELLED, HEDL_ERR_NOT_FOUND, HEDL_ERR_NULL_PTR,
+    HEDL_ERR_PARSE, HEDL_ERR_TYPE_MISMATCH, HEDL_OK,
+};
+use crate::parsing::input_limits;
+use crate::utils::{borrow_input_sized, map_input_file};
+use hedl_core::{parse_with_limits, Document, ParseOptions};
+use std::cell::Cell;
+use std::collections::VecDeque;
+use std::ffi::{CStr, CString};
+use std::io;
+use std::os::raw::{c_char, c_int, c_void};
+use std::ptr;
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::{Arc, Condvar, Mutex, MutexGuard, OnceLock};
+use std::thread;
+
+// =============================================================================
+// Operation Handle
+// =============================================================================
+
+/// Completion callback of an asynchronous operation.
+///
+/// Runs exactly once, with the operation's final status, on a worker thread
+/// or on a thread that waited for the operation before it started. It may
+/// call any `hedl_*` function, including `hedl_async_free(op)` and blocking
+/// calls on other operations.
+pub type HedlAsyncCallback =
+    unsafe extern "C" fn(op: *mut HedlAsyncOp, status: c_int, user_data: *mut c_void);
+
+/// Status of an operation that has not completed yet.
+pub const HEDL_ASYNC_PENDING: c_int = 1;
+
+/// Result of a finished operation, until it is taken.
+enum Output {
+    Document(Box<HedlDocument>),
+    Text(CString),
+    #[cfg_attr(not(feature = "parquet"), allow(dead_code))]
+    Bytes(Vec<u8>),
+    Taken,
+}
+
+struct Outcome {
+    status: c_int,
+    output: Output,
+    error: Option<CString>,
+}
+
+#[derive(Default)]
+struct State {
+    /// Set when the work has finished, before the callback runs.
+    outcome: Option<Outcome>,
+    /// Set once the callback has returned.
+    done: bool,
+}
+
+/// Work of an operation, run at most once.
+type Work = Box<dyn FnOnce(&AtomicBool) -> Result<Output, (c_int, String)> + Send>;
+
+/// An operation nobody has started yet.
+struct Task {
+    op: *mut HedlAsyncOp,
+    work: Work,
+}
+
+/// State shared between the handle and the thread running the operation.
+struct Shared {
+    cancelled: AtomicBool,
+    /// Taken by the first thread to start the operation.
+    task: Mutex<Option<Task>>,
+    state: Mutex<State>,
+    done: Condvar,
+    callback: HedlAsyncCallback,
+    user_data: *mut c_void,
+}
+
+// SAFETY: `user_data` is never dereferenced, only handed back to the
+// caller's callback, which the caller has made safe to run on any thread.
+// The handle pointer in `task` is only passed to that callback; the handle
+// is not freed before the callback returns (see `hedl_async_free`).
+unsafe impl Send for Shared {}
+unsafe impl Sync for Shared {}
+
+impl Shared {
+    fn lock(&self) -> MutexGuard<'_, State> {
+        self.state.lock().unwrap_or_else(|e| e.into_inner())
+    }
+
+    fn is_cancelled(&self) -> bool {
+        self.cancelled.load(Ordering::Relaxed)
+    }
+}
+
+/// Opaque handle to an asynchronous operation.
+///
+/// The worker keeps its own reference to the shared state, so freeing the
+/// handle from inside the callback is safe.
+pub struct HedlAsyncOp {
+    shared: Arc<Shared>,
+}
+
+thread_local! {
+    /// Operation whose callback is running on this thread, if any.
+    static IN_CALLBACK: Cell<*const Shared> = const { Cell::new(ptr::null()) };
+}
+
+fn in_own_callback(shared: &Arc<Shared>) -> bool {
+    IN_CALLBACK.with(|current| current.get() == Arc::as_ptr(shared))
+}
+
+// =============================================================================
+// Executor
+// =============================================================================
+
+/// Submitted operations, oldest first. Entries already started by a waiting
+/// thread are skipped when a worker reaches them.
+static QUEUE: Mutex<VecDeque<Arc<Shared>>> = Mutex::new(VecDeque::new());
+static QUEUED: Condvar = Condvar::new();
+
+/// Start the worker threads on first use; returns how many are running.
+fn workers() -> usize {
+    static WORKERS: OnceLock<usize> = OnceLock::new();
+    *WORKERS.get_or_init(|| {
+        let n = thread::available_parallelism().map_or(1, |n| n.get());
+        (0..n)
+            .filter(|i| {
+                thread::Builder::new()
+                    .name(format!("hedl-async-{}", i))
+                    .spawn(worker_loop)
+                    .is_ok()
+            })
+            .count()
+    })
+}
+
+fn worker_loop() {
+    loop {
+        let shared = {
+            let mut queue = QUEUE.lock().unwrap_or_else(|e| e.into_inner());
+            loop {
+                if let Some(shared) = queue.pop_front() {
+                    break shared;
+                }
+                queue = QUEUED.wait(queue).unwrap_or_else(|e| e.into_inner());
+            }
+        };
+        run(&shared);
+    }
+}
+
+/// Register a new operation in `*out_op` and queue `work` for the workers.
+///
+/// `work` returns the status and output; a cancellation observed after it
+/// finished still turns the status into `HEDL_ERR_CANCELLED`. Fails with
+/// HEDL_ERR_ALLOC, before touching `*out_op`, if no worker thread can be
+/// started.
+unsafe fn submit<W>(
+    callback: HedlAsyncCallback,
+    user_data: *mut c_void,
+    out_op: *mut *mut HedlAsyncOp,
+    work: W,
+) -> Result<(), (c_int, String)>
+where
+    W: FnOnce(&AtomicBool) -> Result<Output, (c_int, String)> + Send + 'static,
+{
+    if workers() == 0 {
+        return Err((
+            HEDL_ERR_ALLOC,
+            "Failed to start async worker threads".to_string(),
+        ));
+    }
+
+    let shared = Arc::new(Shared {
+        cancelled: AtomicBool::new(false),
+        task: Mutex::new(None),
+        state: Mutex::new(State::default()),
+        done: Condvar::new(),
+        callback,
+        user_data,
+    });
+    let op = Box::into_raw(Box::new(HedlAsyncOp {
+        shared: Arc::clone(&shared),
+    }));
+    *out_op = op;
+    *shared.task.lock().unwrap_or_else(|e| e.into_inner()) = Some(Task {
+        op,
+        work: Box::new(work),
+    });
+
+    QUEUE
+        .lock()
+        .unwrap_or_else(|e| e.into_inner())
+        .push_back(shared);
+    QUEUED.notify_one();
+    Ok(())
+}
+
+/// Run the operation's work and callback on this thread, unless another
+/// thread has already started it.
+fn run(shared: &Arc<Shared>) {
+    let task = shared.task.lock().unwrap_or_else(|e| e.into_inner()).take();
+    let Some(task) = task else {
+        return;
+    };
+    let result = if shared.is_cancelled() {
+        Err((HEDL_ERR_CANCELLED, "Operation cancelled".to_string()))
+    } else {
+        (task.work)(&shared.cancelled)
+    };
+    complete(shared, task.op, result);
+}
+
+/// Store the outcome, run the callback and wake any waiter.
+fn complete(shared: &Arc<Shared>, op: *mut HedlAsyncOp, result: Result<Output, (c_int, String)>) {
+    let outcome = match result {
+        Ok(_) if shared.is_cancelled() => cancelled(),
+        Ok(output) => Outcome {
+            status: HEDL_OK,
+            output,
+            error: None,
+        },
+        Err(_) if shared.is_cancelled() => cancelled(),
+        Err((status, msg)) => Outcome {
+            status,
+            output: Output::Taken,
+            error: CString::new(msg).ok(),
+        },
+    };
+    let status = outcome.status;
+    shared.lock().outcome = Some(outcome);
+
+    // A waiting callback may run another operation's callback nested in it
+    let outer = IN_CALLBACK.with(|current| current.replace(Arc::as_ptr(shared)));
+    // SAFETY: the caller guaranteed the callback is safe to call with
+    // `user_data`; the handle outlives the call (see `hedl_async_free`).
+    unsafe { (shared.callback)(op, status, shared.user_data) };
+    IN_CALLBACK.with(|current| current.set(outer));
+
+    let mut state = shared.lock();
+    state.done = true;
+    shared.done.notify_all();
+}
+
+fn cancelled() -> Outcome {
+    Outcome {
+        status: HEDL_ERR_CANCELLED,
+        output: Output::Taken,
+        error: CString::new("Operation cancelled").ok(),
+    }
+}
+
+/// Shared argument check of the submitting functions.
+///
+/// Records the failure on the calling thread, where no callback will fire.
+fn reject(fn_name: &'static str, code: c_int, msg: &str, start: &AuditTimer) -> c_int {
+    set_error(msg);
+    audit_call_failure(fn_name, code, msg, start.elapsed());
+    code
+}
+
+/// Record the outcome of the work as one call of `fn_name`.
+fn audited<T>(
+    fn_name: &'static str,
+    start: AuditTimer,
+    result: Result<T, (c_int, String)>,
+) -> Result<T, (c_int, String)> {
+    match &result {
+        Ok(_) => audit_call_success(fn_name, start.elapsed()),
+        Err((code, msg)) => audit_call_failure(fn_name, *code, msg, start.elapsed()),
+    }
+    result
+}
+
+// =============================================================================
+// Asynchronous Parsing
+// =============================================================================
+
+/// Pointer to a caller buffer that outlives the operation.
+struct Borrowed(*const c_char);
+
+// SAFETY: the buffer is only read, and the caller keeps it alive and
+// unmodified until the callback returns.
+unsafe impl Send for Borrowed {}
+
+fn parse_document(
+    text: &str,
+    strict: c_int,
+    max_size: usize,
+    cancelled: &AtomicBool,
+) -> Result<Output, (c_int, String)> {
+    let options = ParseOptions {
+        limits: input_limits(max_size),
+        strict_refs: strict != 0,
+    };
+    let doc = parse_with_limits(text.as_bytes(), options)
+        .map_err(|e| (HEDL_ERR_PARSE, format!("Parse error: {}", e)))?;
+    if cancelled.load(Ordering::Relaxed) {
+        // Discarded by `complete`; drop the document here, still off the caller's thread
+        drop(doc);
+        return Ok(Output::Taken);
+    }
+    Ok(Output::Document(Box::new(HedlDocument::new(doc))))
+}
+
+/// Parse a HEDL document on the worker pool.
+///
+/// # Arguments
+/// * `input` - UTF-8 encoded HEDL bytes (need not be null-terminated)
+/// * `input_len` - Length of input in bytes
+/// * `strict` - Non-zero for strict mode (validate references)
+/// * `callback` - Completion callback
+/// * `user_data` - Passed to the callback
+/// * `out_op` - Receives the operation handle
+///
+/// On completion take the document with `hedl_async_take_document`.
+///
+/// # Returns
+/// HEDL_OK if the operation was queued (the callback will fire), or
+/// HEDL_ERR_NULL_PTR for a NULL argument and HEDL_ERR_ALLOC if the worker
+/// threads cannot be started (it will not).
+///
+/// # Safety
+/// `input` must point to at least `input_len` readable bytes that stay valid
+/// and unmodified until the callback has returned. `callback` must be safe to
+/// call with `user_data` from any thread.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_parse_async(
+    input: *const c_char,
+    input_len: usize,
+    strict: c_int,
+    callback: Option<HedlAsyncCallback>,
+    user_data: *mut c_void,
+    out_op: *mut *mut HedlAsyncOp,
+) -> c_int {
+    const FN: &str = "hedl_parse_async";
+    let start = AuditTimer::start();
+    clear_error();
+
+    let Some(callback) = callback else {
+        return reject(FN, HEDL_ERR_NULL_PTR, "Null callback", &start);
+    };
+    if input.is_null() || out_op.is_null() {
+        return reject(FN, HEDL_ERR_NULL_PTR, "Null pointer argument", &start);
+    }
+
+    let input = Borrowed(input);
+    let queued = submit(callback, user_data, out_op, move |cancelled| {
+        let input = input;
+        let start = AuditTimer::start();
+        audit_start!(
+            FN,
+            "input_ptr" => sanitize_pointer(input.0),
+            "input_len" => input_len.to_string(),
+            "strict" => strict.to_string(),
+        );
+        note_input(input_len);
+        let result = borrow_input_sized(input.0, input_len)
+            .and_then(|text| parse_document(text, strict, 0, cancelled));
+        audited(FN, start, result)
+    });
+    match queued {
+        Ok(()) => HEDL_OK,
+        Err((code, msg)) => reject(FN, code, &msg, &start),
+    }
+}
+
+/// Parse a HEDL file on the worker pool.
+///
+/// The path is copied, so it need not outlive the call. The file is
+/// memory-mapped on the worker as in `hedl_parse_file`, and `max_size`
+/// limits it the same way.
+///
+/// # Returns
+/// HEDL_OK if the operation was queued, HEDL_ERR_NULL_PTR for a NULL
+/// argument. Open and read failures complete the operation with
+/// HEDL_ERR_IO.
+///
+/// # Safety
+/// `path` must be a valid null-terminated string. The file must not be
+/// truncated while the operation runs. `callback` must be safe to call with
+/// `user_data` from any thread.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_parse_file_async(
+    path: *const c_char,
+    strict: c_int,
+    max_size: usize,
+    callback: Option<HedlAsyncCallback>,
+    user_data: *mut c_void,
+    out_op: *mut *mut HedlAsyncOp,
+) -> c_int {
+    const FN: &str = "hedl_parse_file_async";
+    let start = AuditTimer::start();
+    clear_error();
+
+    let Some(callback) = callback else {
+        return reject(FN, HEDL_ERR_NULL_PTR, "Null callback", &start);
+    };
+    if path.is_null() || out_op.is_null() {
+        return reject(FN, HEDL_ERR_NULL_PTR, "Null pointer argument", &start);
+    }
+
+    let path = CStr::from_ptr(path).to_owned();
+    let queued = submit(callback, user_data, out_op, move |cancelled| {
+        let start = AuditTimer::start();
+        audit_start!(
+            FN,
+            "strict" => strict.to_string(),
+            "max_size" => max_size.to_string(),
+        );
+        let result = map_input_file(path.as_ptr())
+            .map_err(|code| (code, get_thread_local_error()))
+            .and_then(|file| {
+                let text = std::str::from_utf8(file.bytes()).map_err(|e| {
+                    (
+                        crate::types::HEDL_ERR_INVALID_UTF8,
+                        format!("Invalid UTF-8: {}", e),
+                    )
+                })?;
+                parse_document(text, strict, max_size, cancelled)
+            });
+        audited(FN, start, result)
+    });
+    match queued {
+        Ok(()) => HEDL_OK,
+        Err((code, msg)) => reject(FN, code, &msg, &start),
+    }
+}
+
+// =============================================================================
+// Asynchronous Export
+// =============================================================================
+
+/// Document handle that outlives the operation.
+struct SharedDocument(*const HedlDocument);
+
+// SAFETY: the document is only read, and the caller keeps it alive and
+// unmodified until the callback returns.
+unsafe impl Send for SharedDocument {}
+
+/// In-memory sink that fails the serializer's next write once cancelled.
+struct CancellableBuffer<'a> {
+    buf: Vec<u8>,
+    cancelled: &'a AtomicBool,
+}
+
+impl io::Write for CancellableBuffer<'_> {
+    fn write(&mut self, data: &[u8]) -> io::Result<usize> {
+        if self.cancelled.load(Ordering::Relaxed) {
+            return Err(io::Error::new(io::ErrorKind::Other, "operation cancelled"));
+        }
+        self.buf.extend_from_slice(data);
+        Ok(data.len())
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        Ok(())
+    }
+}
+
+/// Shared body of the export functions: validate, then run `export` on the
+/// document in the background.
+unsafe fn submit_export<F>(
+    fn_name: &'static str,
+    doc: *const HedlDocument,
+    callback: Option<HedlAsyncCallback>,
+    user_data: *mut c_void,
+    out_op: *mut *mut HedlAsyncOp,
+    export: F,
+) -> c_int
+where
+    F: FnOnce(&Document, &AtomicBool) -> Result<Output, (c_int, String)> + Send + 'static,
+{
+    let start = AuditTimer::start();
+    clear_error();
+
+    let Some(callback) = callback else {
+        return reject(fn_name, HEDL_ERR_NULL_PTR, "Null callback", &start);
+    };
+    if !is_valid_document_ptr(doc) || out_op.is_null() {
+        return reject(fn_name, HEDL_ERR_NULL_PTR, "Null pointer argument", &start);
+    }
+
+    let doc = SharedDocument(doc);
+    let queued = submit(callback, user_data, out_op, move |cancelled| {
+        let doc = doc;
+        let start = AuditTimer::start();
+        audit_start!(fn_name, "doc_ptr" => sanitize_pointer(doc.0));
+        let result = export(&(*doc.0).inner, cancelled);
+        audited(fn_name, start, result)
+    });
+    match queued {
+        Ok(()) => HEDL_OK,
+        Err((code, msg)) => reject(fn_name, code, &msg, &start),
+    }
+}
+
+/// Text exports: serialize with `export` into a string taken with
+/// `hedl_async_take_string`.
+unsafe fn export_async<F>(
+    fn_name: &'static str,
+    doc: *const HedlDocument,
+    callback: Option<HedlAsyncCallback>,
+    user_data: *mut c_void,
+    out_op: *mut *mut HedlAsyncOp,
+    export: F,
+) -> c_int
+where
+    F: FnOnce(&Document, &mut CancellableBuffer<'_>) -> Result<(), (c_int, String)>
+        + Send
+        + 'static,
+{
+    submit_export(
+        fn_name,
+        doc,
+        callback,
+        user_data,
+        out_op,
+        move |doc, cancelled| {
+            let mut sink = CancellableBuffer {
+                buf: Vec::new(),
+                cancelled,
+            };
+            export(doc, &mut sink)?;
+            note_output(sink.buf.len());
+            CString::new(sink.buf)
+                .map(Output::Text)
+                .map_err(|e| (HEDL_ERR_ALLOC, format!("String allocation failed: {}", e)))
+        },
+    )
+}
+
+/// Convert a document to JSON on the worker pool.
+///
+/// Same output as `hedl_to_json`; take it with `hedl_async_take_string`.
+///
+/// # Returns
+/// HEDL_OK if the operation was queued, HEDL_ERR_NULL_PTR for a NULL
+/// argument, HEDL_ERR_ALLOC if the worker threads cannot be started.
+///
+/// # Safety
+/// `doc` must stay valid and unmodified until the callback has returned.
+/// `callback` must be safe to call with `user_data` from any thread.
+///
+/// # Feature
+/// Requires the "json" feature to be enabled.
+#[cfg(feature = "json")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_to_json_async(
+    doc: *const HedlDocument,
+    include_metadata: c_int,
+    callback: Option<HedlAsyncCallback>,
+    user_data: *mut c_void,
+    out_op: *mut *mut HedlAsyncOp,
+) -> c_int {
+    export_async(
+        "hedl_to_json_async",
+        doc,
+        callback,
+        user_data,
+        out_op,
+        move |doc, sink| write_json(doc, include_metadata, sink),
+    )
+}
+
+/// Convert a document to YAML on the worker pool.
+///
+/// Same output as `hedl_to_yaml`; take it with `hedl_async_take_string`.
+///
+/// # Safety
+/// As for [`hedl_to_json_async`].
+///
+/// # Feature
+/// Requires the "yaml" feature to be enabled.
+#[cfg(feature = "yaml")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_to_yaml_async(
+    doc: *const HedlDocument,
+    include_metadata: c_int,
+    callback: Option<HedlAsyncCallback>,
+    user_data: *mut c_void,
+    out_op: *mut *mut HedlAsyncOp,
+) -> c_int {
+    export_async(
+        "hedl_to_yaml_async",
+        doc,
+        callback,
+        user_data,
+        out_op,
+        move |doc, sink| write_yaml(doc, include_metadata, sink),
+    )
+}
+
+/// Convert a document to XML on the worker pool.
+///
+/// Same output as `hedl_to_xml`; take it with `hedl_async_take_string`.
+///
+/// # Safety
+/// As for [`hedl_to_json_async`].
+///
+/// # Feature
+/// Requires the "xml" feature to be enabled.
+#[cfg(feature = "xml")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_to_xml_async(
+    doc: *const HedlDocument,
+    callback: Option<HedlAsyncCallback>,
+    user_data: *mut c_void,
+    out_op: *mut *mut HedlAsyncOp,
+) -> c_int {
+    export_async(
+        "hedl_to_xml_async",
+        doc,
+        callback,
+        user_data,
+        out_op,
+        |doc, sink| write_xml(doc, sink),
+    )
+}
+
+/// Convert a document to CSV on the worker pool.
+///
+/// Same output as `hedl_to_csv`; take it with `hedl_async_take_string`.
+///
+/// # Safety
+/// As for [`hedl_to_json_async`].
+///
+/// # Feature
+/// Requires the "csv" feature to be enabled.
+#[cfg(feature = "csv")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_to_csv_async(
+    doc: *const HedlDocument,
+    callback: Option<HedlAsyncCallback>,
+    user_data: *mut c_void,
+    out_op: *mut *mut HedlAsyncOp,
+) -> c_int {
+    export_async(
+        "hedl_to_csv_async",
+        doc,
+        callback,
+        user_data,
+        out_op,
+        |doc, sink| write_csv(doc, sink),
+    )
+}
+
+/// Convert a document to Neo4j Cypher on the worker pool.
+///
+/// Same output as `hedl_to_neo4j_cypher`; take it with
+/// `hedl_async_take_string`.
+///
+/// # Safety
+/// As for [`hedl_to_json_async`].
+///
+/// # Feature
+/// Requires the "neo4j" feature to be enabled.
+#[cfg(feature = "neo4j")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_to_neo4j_cypher_async(
+    doc: *const HedlDocument,
+    use_merge: c_int,
+    callback: Option<HedlAsyncCallback>,
+    user_data: *mut c_void,
+    out_op: *mut *mut HedlAsyncOp,
+) -> c_int {
+    export_async(
+        "hedl_to_neo4j_cypher_async",
+        doc,
+        callback,
+        user_data,
+        out_op,
+        move |doc, sink| write_neo4j_cypher(doc, use_merge, sink),
+    )
+}
+
+/// Convert a document to Parquet on the worker pool.
+///
+/// Same bytes as `hedl_to_parquet`; take them with `hedl_async_take_bytes`.
+/// The Parquet writer builds the file in one piece, so a cancellation while
+/// it runs only discards the result.
+///
+/// # Safety
+/// As for [`hedl_to_json_async`].
+///
+/// # Feature
+/// Requires the "parquet" feature to be enabled.
+#[cfg(feature = "parquet")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_to_parquet_async(
+    doc: *const HedlDocument,
+    callback: Option<HedlAsyncCallback>,
+    user_data: *mut c_void,
+    out_op: *mut *mut HedlAsyncOp,
+) -> c_int {
+    submit_export(
+        "hedl_to_parquet_async",
+        doc,
+        callback,
+        user_data,
+        out_op,
+        |doc, _cancelled| {
+            let bytes = hedl_parquet::to_parquet_bytes(doc).map_err(|e| {
+                (
+                    crate::types::HEDL_ERR_PARQUET,
+                    format!("Parquet conversion error: {}", e),
+                )
+            })?;
+            note_output(bytes.len());
+            Ok(Output::Bytes(bytes))
+        },
+    )
+}
+
+/// Canonicalize a document on the worker pool.
+///
+/// Same output as `hedl_canonicalize`; take it with `hedl_async_take_string`.
+///
+/// # Safety
+/// As for [`hedl_to_json_async`].
+#[no_mangle]
+pub unsafe extern "C" fn hedl_canonicalize_async(
+    doc: *const HedlDocument,
+    callback: Option<HedlAsyncCallback>,
+    user_data: *mut c_void,
+    out_op: *mut *mut HedlAsyncOp,
+) -> c_int {
+    export_async(
+        "hedl_canonicalize_async",
+        doc,
+        callback,
+        user_data,
+        out_op,
+        |doc, sink| write_canonical(doc, HEDL_DEFAULT_CHUNK_SIZE, sink),
+    )
+}
+
+// =============================================================================
+// Operation Control
+// =============================================================================
+
+/// Request cancellation of an operation.
+///
+/// Never blocks. Has no effect once the operation has completed.
+///
+/// # Returns
+/// HEDL_OK, or HEDL_ERR_NULL_PTR for a NULL handle.
+///
+/// # Safety
+/// `op` must be NULL or a live handle from a `*_async` function.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_async_cancel(op: *mut HedlAsyncOp) -> c_int {
+    if op.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    let shared = &(*op).shared;
+    shared.cancelled.store(true, Ordering::Relaxed);
+    HEDL_OK
+}
+
+/// Status of an operation: `HEDL_ASYNC_PENDING` until it completes, then
+/// the status passed to its callback.
+///
+/// # Safety
+/// `op` must be NULL or a live handle from a `*_async` function.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_async_status(op: *const HedlAsyncOp) -> c_int {
+    if op.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    let shared = &(*op).shared;
+    let state = shared.lock();
+    state
+        .outcome
+        .as_ref()
+        .map_or(HEDL_ASYNC_PENDING, |outcome| outcome.status)
+}
+
+/// Run `shared` here if no worker has started it, then block until its
+/// callback has returned.
+fn finish(shared: &Arc<Shared>) -> MutexGuard<'_, State> {
+    run(shared);
+    let mut state = shared.lock();
+    while !state.done {
+        state = shared.done.wait(state).unwrap_or_else(|e| e.into_inner());
+    }
+    state
+}
+
+/// Block until an operation's callback has returned, then return its status.
+///
+/// An operation no worker has started yet runs on the calling thread,
+/// callback included, so this is safe to call from another operation's
+/// callback. Called from the operation's own callback it returns the status
+/// at once.
+///
+/// # Safety
+/// `op` must be NULL or a live handle from a `*_async` function.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_async_wait(op: *const HedlAsyncOp) -> c_int {
+    if op.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    let shared = &(*op).shared;
+    let state = if in_own_callback(shared) {
+        shared.lock()
+    } else {
+        finish(shared)
+    };
+    state
+        .outcome
+        .as_ref()
+        .map_or(HEDL_ASYNC_PENDING, |outcome| outcome.status)
+}
+
+/// Error message of a failed operation, or NULL.
+///
+/// The string is owned by the handle and valid until `hedl_async_free`.
+///
+/// # Safety
+/// `op` must be NULL or a live handle from a `*_async` function.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_async_error(op: *const HedlAsyncOp) -> *const c_char {
+    if op.is_null() {
+        return ptr::null();
+    }
+    let shared = &(*op).shared;
+    let state = shared.lock();
+    // The message is set once, before the callback, and never moved afterwards
+    match state
+        .outcome
+        .as_ref()
+        .and_then(|outcome| outcome.error.as_ref())
+    {
+        Some(msg) => msg.as_ptr(),
+        None => ptr::null(),
+    }
+}
+
+/// Take the output of a finished operation, checking its kind with `take`.
+unsafe fn take_output<T>(
+    op: *const HedlAsyncOp,
+    take: impl FnOnce(Output) -> Result<T, Output>,
+) -> Result<T, c_int> {
+    let shared = &(*op).shared;
+    let mut state = shared.lock();
+    let Some(outcome) = state.outcome.as_mut() else {
+        return Err(HEDL_ASYNC_PENDING);
+    };
+    if outcome.status != HEDL_OK {
+        return Err(outcome.status);
+    }
+    match std::mem::replace(&mut outcome.output, Output::Taken) {
+        Output::Taken => Err(HEDL_ERR_NOT_FOUND),
+        output => take(output).map_err(|output| {
+            outcome.output = output;
+            HEDL_ERR_TYPE_MISMATCH
+        }),
+    }
+}
+
+/// Take the document produced by `hedl_parse_async` or `hedl_parse_file_async`.
+///
+/// The caller owns the document and frees it with `hedl_free_document`.
+///
+/// # Returns
+/// HEDL_OK, `HEDL_ASYNC_PENDING` if the operation has not completed, the
+/// operation's error status if it failed, HEDL_ERR_TYPE_MISMATCH for an
+/// export, HEDL_ERR_NOT_FOUND if the document was already taken.
+///
+/// # Safety
+/// `op` must be NULL or a live handle; `out_doc` must be valid for writes.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_async_take_document(
+    op: *mut HedlAsyncOp,
+    out_doc: *mut *mut HedlDocument,
+) -> c_int {
+    if op.is_null() || out_doc.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    *out_doc = ptr::null_mut();
+    match take_output(op, |output| match output {
+        Output::Document(doc) => Ok(doc),
+        other => Err(other),
+    }) {
+        Ok(doc) => {
+            *out_doc = Box::into_raw(doc);
+            HEDL_OK
+        }
+        Err(code) => code,
+    }
+}
+
+/// Take the string produced by a `hedl_*_async` export.
+///
+/// The caller owns the string and frees it with `hedl_free_string`.
+///
+/// # Returns
+/// As for [`hedl_async_take_document`], with HEDL_ERR_TYPE_MISMATCH for a
+/// parse or a Parquet export.
+///
+/// # Safety
+/// `op` must be NULL or a live handle; `out_str` must be valid for writes.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_async_take_string(
+    op: *mut HedlAsyncOp,
+    out_str: *mut *mut c_char,
+) -> c_int {
+    if op.is_null() || out_str.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    *out_str = ptr::null_mut();
+    match take_output(op, |output| match output {
+        Output::Text(text) => Ok(text),
+        other => Err(other),
+    }) {
+        Ok(text) => {
+            *out_str = text.into_raw();
+            HEDL_OK
+        }
+        Err(code) => code,
+    }
+}
+
+/// Take the bytes produced by `hedl_to_parquet_async`.
+///
+/// The caller owns the bytes and frees them with `hedl_free_bytes`.
+///
+/// # Returns
+/// As for [`hedl_async_take_document`], with HEDL_ERR_TYPE_MISMATCH for a
+/// parse or a text export.
+///
+/// # Safety
+/// `op` must be NULL or a live handle; `out_data` and `out_len` must be
+/// valid for writes.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_async_take_bytes(
+    op: *mut HedlAsyncOp,
+    out_data: *mut *mut u8,
+    out_len: *mut usize,
+) -> c_int {
+    if op.is_null() || out_data.is_null() || out_len.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    *out_data = ptr::null_mut();
+    *out_len = 0;
+    match take_output(op, |output| match output {
+        Output::Bytes(bytes) => Ok(bytes),
+        other => Err(other),
+    }) {
+        Ok(bytes) => {
+            *out_len = bytes.len();
+            *out_data = Box::into_raw(bytes.into_boxed_slice()) as *mut u8;
+            HEDL_OK
+        }
+        Err(code) => code,
+    }
+}
+
+/// Free an operation handle and any result not taken.
+///
+/// A pending operation is cancelled first, and the call blocks until its
+/// callback has returned; an operation no worker has started completes as
+/// cancelled on the calling thread, callback included. From inside the
+/// operation's own callback the handle is freed at once. NULL is ignored.
+///
+/// # Safety
+/// `op` must be NULL or a live handle from a `*_async` function, freed once.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_async_free(op: *mut HedlAsyncOp) {
+    if op.is_null() {
+        return;
+    }
+    let shared = Arc::clone(&(*op).shared);
+    if !in_own_callback(&shared) {
+        shared.cancelled.store(true, Ordering::Relaxed);
+        drop(finish(&shared));
+    }
+    // Freed only now: a callback run by `finish` still receives `op`
+    drop(Box::from_raw(op));
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::sync::mpsc;
+
+    unsafe extern "C" fn send_status(_op: *mut HedlAsyncOp, status: c_int, user_data: *mut c_void) {
+        let tx = &*(user_data as *const mpsc::Sender<c_int>);
+        tx.send(status).unwrap();
+    }
+
+    #[test]
+    fn test_cancel_while_running_discards_result() {
+        let (tx, rx) = mpsc::channel::<c_int>();
+        let (started_tx, started) = mpsc::channel::<()>();
+        let (release, resume) = mpsc::channel::<()>();
+        let user_data = &tx as *const mpsc::Sender<c_int> as *mut c_void;
+
+        unsafe {
+            let mut op: *mut HedlAsyncOp = ptr::null_mut();
+            submit(send_status, user_data, &mut op, move |_| {
+                started_tx.send(()).unwrap();
+                resume.recv().unwrap();
+                Ok(Output::Text(CString::new("done").unwrap()))
+            })
+            .unwrap();
+            started.recv().unwrap();
+            assert_eq!(hedl_async_status(op), HEDL_ASYNC_PENDING);
+            assert_eq!(hedl_async_cancel(op), HEDL_OK);
+            release.send(()).unwrap();
+
+            assert_eq!(hedl_async_wait(op), HEDL_ERR_CANCELLED);
+            assert_eq!(rx.recv().unwrap(), HEDL_ERR_CANCELLED);
+            let mut out: *mut c_char = ptr::null_mut();
+            assert_eq!(hedl_async_take_string(op, &mut out), HEDL_ERR_CANCELLED);
+            hedl_async_free(op);
+        }
+    }
+
+    /// Operation whose callback waits for another one, set after submission.
+    struct Waiter {
+        other: std::sync::atomic::AtomicPtr<HedlAsyncOp>,
+        tx: Mutex<mpsc::Sender<c_int>>,
+    }
+
+    unsafe extern "C" fn wait_for_other(_op: *mut HedlAsyncOp, _: c_int, user_data: *mut c_void) {
+        let waiter = &*(user_data as *const Waiter);
+        let mut other = waiter.other.load(Ordering::Acquire);
+        while other.is_null() {
+            thread::yield_now();
+            other = waiter.other.load(Ordering::Acquire);
+        }
+        let status = hedl_async_wait(other);
+        waiter.tx.lock().unwrap().send(status).unwrap();
+    }
+
+    unsafe extern "C" fn ignore(_: *mut HedlAsyncOp, _: c_int, _: *mut c_void) {}
+
+    fn text() -> Result<Output, (c_int, String)> {
+        Ok(Output::Text(CString::new("done").unwrap()))
+    }
+
+    #[test]
+    fn test_callbacks_waiting_on_queued_ops_do_not_starve_workers() {
+        // More waiting callbacks than workers, each waiting for an operation
+        // queued behind all of them
+        let n = 2 * workers() + 1;
+        let (tx, rx) = mpsc::channel::<c_int>();
+        let waiters: Vec<Box<Waiter>> = (0..n)
+            .map(|_| {
+                Box::new(Waiter {
+                    other: Default::default(),
+                    tx: Mutex::new(tx.clone()),
+                })
+            })
+            .collect();
+
+        unsafe {
+            let mut ops = Vec::new();
+            for waiter in &waiters {
+                let mut op = ptr::null_mut();
+                let user_data = &**waiter as *const Waiter as *mut c_void;
+                submit(wait_for_other, user_data, &mut op, |_| text()).unwrap();
+                ops.push(op);
+            }
+            for waiter in &waiters {
+                let mut op = ptr::null_mut();
+                submit(ignore, ptr::null_mut(), &mut op, |_| text()).unwrap();
+                waiter.other.store(op, Ordering::Release);
+                ops.push(op);
+            }
+
+            for _ in 0..n {
+                let status = rx.recv_timeout(std::time::Duration::from_secs(30));
+                assert_eq!(status, Ok(HEDL_OK));
+            }
+            for op in ops {
+                hedl_async_free(op);
+            }
+        }
+    }
+
+    #[test]
+    fn test_cancellable_buffer_stops_writes() {
+        use std::io::Write;
+        let cancelled = AtomicBool::new(false);
+        let mut sink = CancellableBuffer {
+            buf: Vec::new(),
+            cancelled: &cancelled,
+        };
+        sink.write_all(b"abc").unwrap();
+        cancelled.store(true, Ordering::Relaxed);
+        assert!(sink.write_all(b"def").is_err());
+        assert_eq!(sink.buf, b"abc");
+    }
+}
@@ -37,15 +37,27 @@
 //! Sensitive information (raw pointer addresses, full input data) is sanitized
 //! or redacted from logs to prevent information leakage.
 //!
+//! # Overhead
+//!
+//! When no subscriber is interested in the `hedl_ffi::audit` target, every
+//! entry point here returns before touching the clock, the thread-local
+//! context, or any formatting. Use [`audit_start!`](crate::audit_start) so
+//! that parameter strings are only built when DEBUG output is wanted, and
+//! [`AuditTimer`] instead of `Instant::now()`. Building without the `audit`
+//! cargo feature turns the whole module into no-ops.
+//!
+//! The success and failure hooks also feed the per-function counters read by
+//! `hedl_metrics_snapshot`, which work with or without this feature.
+//!
 //! # Examples
 //!
 //! ```rust,no_run
-//! use hedl_ffi::audit::{audit_call_start, audit_call_success, audit_call_failure};
-//! use std::time::Instant;
+//! use hedl_ffi::audit::{audit_call_success, audit_call_failure, AuditTimer};
+//! use hedl_ffi::audit_start;
 //!
 //! unsafe fn my_ffi_function(input: *const i8) -> i32 {
-//!     let start = Instant::now();
-//!     audit_call_start("my_ffi_function", &[("input_ptr", "sanitized")]);
+//!     let start = AuditTimer::start();
+//!     audit_start!("my_ffi_function", "input_ptr" => "sanitized");
 //!
 //!     // ... perform operation ...
 //!     let result = 0;
@@ -61,9 +73,67 @@
 //! ```
 
 use std::os::raw::{c_char, c_int};
-use std::time::Duration;
+use std::time::{Duration, Instant};
 use tracing::{debug, error, info, warn};
 
+// =============================================================================
+// Enablement
+// =============================================================================
+
+/// Check whether audit events would currently be recorded.
+///
+/// This is the cheap guard every audit entry point runs first. It always
+/// returns `false` when the crate is built without the `audit` feature.
+#[inline]
+pub fn audit_enabled() -> bool {
+    #[cfg(feature = "audit")]
+    {
+        tracing::enabled!(target: "hedl_ffi::audit", tracing::Level::ERROR)
+    }
+    #[cfg(not(feature = "audit"))]
+    {
+        false
+    }
+}
+
+/// Check whether DEBUG-level parameter logging would currently be recorded.
+#[inline]
+pub fn audit_params_enabled() -> bool {
+    #[cfg(feature = "audit")]
+    {
+        tracing::enabled!(target: "hedl_ffi::audit", tracing::Level::DEBUG)
+    }
+    #[cfg(not(feature = "audit"))]
+    {
+        false
+    }
+}
+
+/// Call timer that only reads the clock while auditing or metrics are enabled.
+///
+/// [`elapsed`](AuditTimer::elapsed) returns `Duration::ZERO` for a timer
+/// started while both were disabled.
+#[derive(Debug, Clone, Copy)]
+pub struct AuditTimer(Option<Instant>);
+
+impl AuditTimer {
+    /// Start timing an FFI call.
+    #[inline]
+    pub fn start() -> Self {
+        if audit_enabled() || crate::metrics::metrics_enabled() {
+            Self(Some(Instant::now()))
+        } else {
+            Self(None)
+        }
+    }
+
+    /// Time elapsed since [`start`](AuditTimer::start).
+    #[inline]
+    pub fn elapsed(&self) -> Duration {
+        self.0.map_or(Duration::ZERO, |start| start.elapsed())
+    }
+}
+
 // =============================================================================
 // Audit Context
 // =============================================================================
@@ -197,6 +267,10 @@ pub fn sanitize_bytes(data: &[u8], preview_len: usize) -> String {
 /// }
 /// ```
 pub fn audit_call_start(function: &'static str, params: &[(&str, &str)]) {
+    if !audit_enabled() {
+        return;
+    }
+
     let thread_id = std::thread::current().id();
     let depth = get_audit_context().map(|ctx| ctx.depth + 1).unwrap_or(0);
 
@@ -246,6 +320,11 @@ pub fn audit_call_start(function: &'static str, params: &[(&str, &str)]) {
 /// }
 /// ```
 pub fn audit_call_success(function: &'static str, duration: Duration) {
+    crate::metrics::record(function, false, duration);
+    if !audit_enabled() {
+        return;
+    }
+
     let duration_ms = duration.as_secs_f64() * 1000.0;
 
     info!(
@@ -288,6 +367,11 @@ pub fn audit_call_failure(
     error_message: &str,
     duration: Duration,
 ) {
+    crate::metrics::record(function, true, duration);
+    if !audit_enabled() {
+        return;
+    }
+
     let duration_ms = duration.as_secs_f64() * 1000.0;
 
     error!(
@@ -327,6 +411,10 @@ pub fn audit_call_failure(
 /// }
 /// ```
 pub fn audit_warning(function: &'static str, message: &str) {
+    if !audit_enabled() {
+        return;
+    }
+
     warn!(
         target: "hedl_ffi::audit",
         function = function,
@@ -339,6 +427,41 @@ pub fn audit_warning(function: &'static str, message: &str) {
 // Audit Macros
 // =============================================================================
 
+/// Log the start of an FFI call, building parameter strings lazily.
+///
+/// Expands to [`audit_call_start`](crate::audit::audit_call_start), but the
+/// value expressions are only evaluated when DEBUG-level auditing is enabled,
+/// and nothing at all runs when auditing is disabled.
+///
+/// # Examples
+///
+/// ```rust,no_run
+/// use hedl_ffi::audit::sanitize_pointer;
+/// use hedl_ffi::audit_start;
+///
+/// unsafe fn hedl_parse(input: *const i8, len: i32) -> i32 {
+///     audit_start!(
+///         "hedl_parse",
+///         "input_ptr" => sanitize_pointer(input),
+///         "input_len" => len.to_string(),
+///     );
+///     // ... function implementation ...
+///     0
+/// }
+/// ```
+#[macro_export]
+macro_rules! audit_start {
+    ($function:expr $(, $key:expr => $value:expr)* $(,)?) => {
+        if $crate::audit::audit_enabled() {
+            if $crate::audit::audit_params_enabled() {
+                $crate::audit::audit_call_start($function, &[$(($key, &$value)),*]);
+            } else {
+                $crate::audit::audit_call_start($function, &[]);
+            }
+        }
+    };
+}
+
 /// Helper macro to wrap an FFI function with audit logging.
 ///
 /// This macro automatically handles timing, success/failure logging,
@@ -364,18 +487,17 @@ pub fn audit_warning(function: &'static str, message: &str) {
 #[macro_export]
 macro_rules! audit_ffi_call {
     ($function:expr, $body:expr) => {{
-        use std::time::Instant;
-        use $crate::audit::{audit_call_failure, audit_call_start, audit_call_success};
+        use $crate::audit::{audit_call_failure, audit_call_start, audit_call_success, AuditTimer};
 
         audit_call_start($function, &[]);
-        let start = Instant::now();
+        let start = AuditTimer::start();
 
         let result = $body;
         let duration = start.elapsed();
 
         if result == $crate::types::HEDL_OK {
             audit_call_success($function, duration);
-        } else {
+        } else if $crate::audit::audit_enabled() {
             let error_msg = $crate::error::get_thread_local_error();
             audit_call_failure($function, result, &error_msg, duration);
         }
@@ -552,6 +674,42 @@ mod tests {
         audit_call_failure("test_function_2", -1, "Test error", duration);
     }
 
+    #[test]
+    #[cfg(feature = "audit")]
+    fn test_audit_disabled_without_subscriber() {
+        assert!(!audit_enabled());
+        assert!(!audit_params_enabled());
+        assert_eq!(AuditTimer::start().elapsed(), Duration::ZERO);
+
+        audit_call_start("test_disabled", &[]);
+        assert!(get_audit_context().is_none());
+
+        let subscriber = tracing_subscriber::fmt()
+            .with_max_level(tracing::Level::DEBUG)
+            .with_writer(std::io::sink)
+            .finish();
+        tracing::subscriber::with_default(subscriber, || {
+            assert!(audit_enabled());
+            assert!(audit_params_enabled());
+            assert!(AuditTimer::start().0.is_some());
+
+            crate::audit_start!("test_enabled", "param" => 42.to_string());
+            assert_eq!(get_audit_context().unwrap().function, "test_enabled");
+            audit_call_success("test_enabled", Duration::ZERO);
+            assert!(get_audit_context().is_none());
+        });
+    }
+
+    #[test]
+    fn test_audit_start_skips_params_when_disabled() {
+        let mut evaluated = false;
+        crate::audit_start!("test_lazy", "param" => {
+            evaluated = true;
+            String::new()
+        });
+        assert!(!evaluated);
+    }
+
     #[test]
     fn test_audit_warning() {
         // Test that warning logging doesn't panic
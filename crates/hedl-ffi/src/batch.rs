@@ -0,0 +1,295 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//! Batch parsing across a work-stealing thread pool.
+//!
+//! `hedl_parse_batch` parses many independent inputs in a single FFI call.
+//! Every slot gets its own document, status code and, optionally, error
+//! message, so per-item results never go through the thread-local last error
+//! (which would be meaningless on the pool's worker threads).
+//!
+//! # Thread Pools
+//!
+//! - `threads <= 0` uses rayon's global pool (one worker per core).
+//! - `threads == 1` parses on the calling thread without any pool.
+//! - `threads > 1` uses a dedicated pool of that size, built on first use and
+//!   reused by later calls with the same thread count. Counts above the
+//!   machine's available parallelism are clamped to it, and only the most
+//!   recently used pools are kept, so varying the count per call cannot pile
+//!   up idle worker threads.
+
+use crate::audit::{audit_call_failure, audit_call_success, sanitize_pointer, AuditTimer};
+use crate::audit_start;
+use crate::error::{clear_error, set_error};
+use crate::types::{HedlDocument, HEDL_ERR_ALLOC, HEDL_ERR_NULL_PTR, HEDL_ERR_PARSE, HEDL_OK};
+use crate::utils::{borrow_c_str, borrow_input_sized};
+use hedl_core::{parse_with_limits, Document, ParseOptions};
+use rayon::prelude::*;
+use rayon::ThreadPool;
+use std::ffi::CString;
+use std::os::raw::{c_char, c_int};
+use std::ptr;
+use std::slice;
+use std::sync::{Arc, Mutex};
+
+// =============================================================================
+// Batch Inputs
+// =============================================================================
+
+/// Outcome of one slot: the document, or its error code and message.
+type SlotResult = Result<Document, (c_int, String)>;
+
+/// Caller-owned input arrays, shared read-only with the pool's workers.
+struct BatchInputs<'a> {
+    inputs: &'a [*const c_char],
+    /// Per-input lengths, or `None` when every input is null-terminated.
+    lens: Option<&'a [usize]>,
+    strict: bool,
+}
+
+// SAFETY: the input pointers are only ever read, and the caller guarantees
+// the buffers stay valid and unmodified until `hedl_parse_batch` returns.
+unsafe impl Sync for BatchInputs<'_> {}
+
+impl BatchInputs<'_> {
+    /// Parse slot `index`.
+    ///
+    /// # Safety
+    /// The slot's pointer (and length, if given) must satisfy the contract
+    /// of [`hedl_parse_batch`].
+    unsafe fn parse(&self, index: usize) -> SlotResult {
+        let input = self.inputs[index];
+        if input.is_null() {
+            return Err((HEDL_ERR_NULL_PTR, "Null input pointer".to_string()));
+        }
+
+        let text = match self.lens {
+            Some(lens) => borrow_input_sized(input, lens[index])?,
+            None => borrow_c_str(input)?,
+        };
+
+        let options = ParseOptions {
+            strict_refs: self.strict,
+            ..Default::default()
+        };
+        parse_with_limits(text.as_bytes(), options)
+            .map_err(|e| (HEDL_ERR_PARSE, format!("Parse error: {}", e)))
+    }
+
+    /// Parse every slot, fanning out according to `threads`.
+    ///
+    /// Fails only if a dedicated thread pool cannot be created.
+    fn parse_all(&self, threads: c_int) -> Result<Vec<SlotResult>, String> {
+        let n = self.inputs.len();
+        let parallel = || {
+            (0..n)
+                .into_par_iter()
+                .map(|i| unsafe { self.parse(i) })
+                .collect()
+        };
+
+        if threads == 1 || n == 1 {
+            Ok((0..n).map(|i| unsafe { self.parse(i) }).collect())
+        } else if threads <= 0 {
+            Ok(parallel())
+        } else {
+            Ok(worker_pool(threads as usize)?.install(parallel))
+        }
+    }
+}
+
+// =============================================================================
+// Thread Pools
+// =============================================================================
+
+/// Most dedicated pools kept alive at once.
+const MAX_WORKER_POOLS: usize = 4;
+
+/// Dedicated pools keyed by thread count, least recently used first.
+///
+/// An evicted pool shuts its workers down once the calls still running on it
+/// release their handle.
+static WORKER_POOLS: Mutex<Vec<(usize, Arc<ThreadPool>)>> = Mutex::new(Vec::new());
+
+/// Get (or build) the dedicated pool for `threads` workers.
+///
+/// `threads` is clamped to the available parallelism. Shared by every entry
+/// point that takes a `threads` argument.
+pub(crate) fn worker_pool(threads: usize) -> Result<Arc<ThreadPool>, String> {
+    let cores = std::thread::available_parallelism().map_or(1, |n| n.get());
+    let threads = threads.clamp(1, cores);
+
+    let mut pools = WORKER_POOLS.lock().unwrap_or_else(|e| e.into_inner());
+    if let Some(i) = pools.iter().position(|(n, _)| *n == threads) {
+        let entry = pools.remove(i);
+        let pool = Arc::clone(&entry.1);
+        pools.push(entry);
+        return Ok(pool);
+    }
+
+    let pool = rayon::ThreadPoolBuilder::new()
+        .num_threads(threads)
+        .thread_name(|i| format!("hedl-worker-{}", i))
+        .build()
+        .map_err(|e| format!("Failed to create thread pool: {}", e))?;
+    let pool = Arc::new(pool);
+    if pools.len() == MAX_WORKER_POOLS {
+        pools.remove(0);
+    }
+    pools.push((threads, Arc::clone(&pool)));
+    Ok(pool)
+}
+
+// =============================================================================
+// Batch Parsing
+// =============================================================================
+
+/// Parse many HEDL documents in parallel.
+///
+/// Slot `i` of every output array receives the result for `inputs[i]`:
+/// the document handle (NULL on failure), the status code, and the error
+/// message (NULL on success). Each document must be freed with
+/// `hedl_free_document` and each message with `hedl_free_string`.
+///
+/// # Arguments
+/// * `inputs` - Array of `n` UTF-8 HEDL inputs
+/// * `lens` - Array of `n` byte lengths, or NULL if every input is null-terminated
+/// * `n` - Number of inputs
+/// * `strict` - Non-zero for strict mode (validate references)
+/// * `out_docs` - Array of `n` slots for document handles
+/// * `out_codes` - Array of `n` slots for per-input status codes
+/// * `out_errors` - Array of `n` slots for per-input error messages, or NULL
+/// * `threads` - Worker count: 0 for one per core, 1 for the calling thread only;
+///   larger counts are capped at the core count
+///
+/// # Returns
+/// HEDL_OK if every input parsed. Otherwise the code of the first failed
+/// slot; the thread-local last error then only summarizes the batch.
+/// HEDL_ERR_NULL_PTR if a required array is NULL (outputs untouched), and
+/// HEDL_ERR_ALLOC if the thread pool cannot be created.
+///
+/// # Safety
+/// Every array must hold at least `n` elements, and each input must stay
+/// valid and unmodified until the call returns.
+#[allow(clippy::too_many_arguments)]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_parse_batch(
+    inputs: *const *const c_char,
+    lens: *const usize,
+    n: usize,
+    strict: c_int,
+    out_docs: *mut *mut HedlDocument,
+    out_codes: *mut c_int,
+    out_errors: *mut *mut c_char,
+    threads: c_int,
+) -> c_int {
+    let start = AuditTimer::start();
+
+    audit_start!(
+        "hedl_parse_batch",
+        "inputs" => sanitize_pointer(inputs),
+        "lens" => sanitize_pointer(lens),
+        "n" => n.to_string(),
+        "strict" => strict.to_string(),
+        "threads" => threads.to_string(),
+    );
+
+    clear_error();
+
+    if n == 0 {
+        audit_call_success("hedl_parse_batch", start.elapsed());
+        return HEDL_OK;
+    }
+
+    if inputs.is_null() || out_docs.is_null() || out_codes.is_null() {
+        let duration = start.elapsed();
+        set_error("Null pointer argument");
+        audit_call_failure("hedl_parse_batch", HEDL_ERR_NULL_PTR, "Null pointer argument", duration);
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    let batch = BatchInputs {
+        inputs: slice::from_raw_parts(inputs, n),
+        lens: (!lens.is_null()).then(|| slice::from_raw_parts(lens, n)),
+        strict: strict != 0,
+    };
+
+    let results = match batch.parse_all(threads) {
+        Ok(results) => results,
+        Err(msg) => {
+            let duration = start.elapsed();
+            set_error(&msg);
+            audit_call_failure("hedl_parse_batch", HEDL_ERR_ALLOC, &msg, duration);
+            return HEDL_ERR_ALLOC;
+        }
+    };
+
+    let mut failed = 0usize;
+    let mut first_code = HEDL_OK;
+    for (i, result) in results.into_iter().enumerate() {
+        let (doc, code, error) = match result {
+            Ok(doc) => {
+                let handle = Box::into_raw(Box::new(HedlDocument::new(doc)));
+                (handle, HEDL_OK, ptr::null_mut())
+            }
+            Err((code, msg)) => {
+                failed += 1;
+                if first_code == HEDL_OK {
+                    first_code = code;
+                }
+                let error = if out_errors.is_null() {
+                    ptr::null_mut()
+                } else {
+                    CString::new(msg).map_or(ptr::null_mut(), CString::into_raw)
+                };
+                (ptr::null_mut(), code, error)
+            }
+        };
+
+        *out_docs.add(i) = doc;
+        *out_codes.add(i) = code;
+        if !out_errors.is_null() {
+            *out_errors.add(i) = error;
+        }
+    }
+
+    if failed == 0 {
+        audit_call_success("hedl_parse_batch", start.elapsed());
+        HEDL_OK
+    } else {
+        let duration = start.elapsed();
+        let msg = format!("{} of {} inputs failed to parse", failed, n);
+        set_error(&msg);
+        audit_call_failure("hedl_parse_batch", first_code, &msg, duration);
+        first_code
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_worker_pools_are_bounded() {
+        for threads in 2..64 {
+            worker_pool(threads).unwrap();
+        }
+        let pools = WORKER_POOLS.lock().unwrap();
+        let cores = std::thread::available_parallelism().map_or(1, |n| n.get());
+        assert!(pools.len() <= MAX_WORKER_POOLS);
+        assert!(pools.iter().all(|(n, _)| *n <= cores));
+    }
+}
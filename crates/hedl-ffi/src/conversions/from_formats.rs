@@ -18,95 +18,184 @@
 //! Import functions (from_*) for FFI.
 
 use crate::error::{clear_error, set_error};
-use crate::types::{
-    HedlDocument, HEDL_ERR_JSON, HEDL_ERR_NULL_PTR, HEDL_ERR_PARQUET, HEDL_ERR_XML, HEDL_ERR_YAML,
-    HEDL_OK,
-};
-use crate::utils::get_input_string;
+use crate::types::{HedlDocument, HEDL_ERR_NULL_PTR, HEDL_ERR_PARQUET, HEDL_OK};
+#[cfg(feature = "json")]
+use crate::types::HEDL_ERR_JSON;
+#[cfg(feature = "xml")]
+use crate::types::HEDL_ERR_XML;
+#[cfg(feature = "yaml")]
+use crate::types::HEDL_ERR_YAML;
+#[cfg(any(feature = "json", feature = "yaml", feature = "xml"))]
+use crate::utils::{get_input_str, get_input_str_sized};
+use hedl_core::Document;
 use std::os::raw::{c_char, c_int};
 use std::ptr;
 use std::slice;
 
 // =============================================================================
-// JSON Conversion (requires "json" feature)
+// Shared Text Import
 // =============================================================================
 
-/// Parse JSON into a HEDL document.
+/// Common body of the text-based `hedl_from_*` functions.
 ///
-/// # Arguments
-/// * `json` - UTF-8 encoded JSON string
-/// * `json_len` - Length of input in bytes, or -1 for null-terminated
-/// * `out_doc` - Pointer to store document handle
-///
-/// # Returns
-/// HEDL_OK on success, error code on failure.
+/// `read_input` borrows the caller's buffer (no copy) and `convert` parses it.
+/// Validation failures from `read_input` have already set the thread-local error.
+/// `audit_keys` name the pointer and length parameters in the audit log.
 ///
 /// # Safety
-/// All pointers must be valid.
-///
-/// # Feature
-/// Requires the "json" feature to be enabled.
-#[cfg(feature = "json")]
-#[no_mangle]
-pub unsafe extern "C" fn hedl_from_json(
-    json: *const c_char,
-    json_len: c_int,
+/// `input` and `out_doc` must satisfy the contract of the public entry point
+/// that calls this helper.
+#[allow(clippy::too_many_arguments)]
+#[cfg(any(feature = "json", feature = "yaml", feature = "xml"))]
+unsafe fn import_text<'a, R, F>(
+    fn_name: &'static str,
+    audit_keys: [&str; 2],
+    input_len: &dyn std::fmt::Display,
+    input: *const c_char,
     out_doc: *mut *mut HedlDocument,
-) -> c_int {
-    use crate::audit::{audit_call_failure, audit_call_start, audit_call_success, sanitize_pointer};
-    use std::time::Instant;
+    read_input: R,
+    convert: F,
+    error_code: c_int,
+    error_label: &str,
+) -> c_int
+where
+    R: FnOnce() -> Result<&'a str, c_int>,
+    F: FnOnce(&str) -> Result<Document, String>,
+{
+    use crate::audit::{audit_call_failure, audit_call_success, sanitize_pointer, AuditTimer};
+    use crate::audit_start;
 
-    let start = Instant::now();
-    let json_ptr_str = sanitize_pointer(json);
-    let json_len_str = json_len.to_string();
-    audit_call_start("hedl_from_json", &[
-        ("json_ptr", &json_ptr_str),
-        ("json_len", &json_len_str),
-    ]);
+    let start = AuditTimer::start();
+    audit_start!(
+        fn_name,
+        audit_keys[0] => sanitize_pointer(input),
+        audit_keys[1] => input_len.to_string(),
+    );
 
     clear_error();
 
-    if json.is_null() || out_doc.is_null() {
+    if input.is_null() || out_doc.is_null() {
         let duration = start.elapsed();
         set_error("Null pointer argument");
-        audit_call_failure("hedl_from_json", HEDL_ERR_NULL_PTR, "NULL pointer", duration);
+        audit_call_failure(fn_name, HEDL_ERR_NULL_PTR, "NULL pointer", duration);
         return HEDL_ERR_NULL_PTR;
     }
 
-    let json_str = match get_input_string(json, json_len) {
+    let text = match read_input() {
         Ok(s) => s,
         Err(code) => {
             let duration = start.elapsed();
             let msg = crate::error::get_thread_local_error();
-            audit_call_failure("hedl_from_json", code, &msg, duration);
+            audit_call_failure(fn_name, code, &msg, duration);
             return code;
         }
     };
 
-    match hedl_json::json_to_hedl(&json_str) {
+    match convert(text) {
         Ok(doc) => {
-            let handle = Box::new(HedlDocument { inner: doc });
+            let handle = Box::new(HedlDocument::new(doc));
             *out_doc = Box::into_raw(handle);
-            audit_call_success("hedl_from_json", start.elapsed());
+            audit_call_success(fn_name, start.elapsed());
             HEDL_OK
         }
         Err(e) => {
             let duration = start.elapsed();
-            let msg = format!("JSON parse error: {}", e);
+            let msg = format!("{} parse error: {}", error_label, e);
             set_error(&msg);
             *out_doc = ptr::null_mut();
-            audit_call_failure("hedl_from_json", HEDL_ERR_JSON, &msg, duration);
-            HEDL_ERR_JSON
+            audit_call_failure(fn_name, error_code, &msg, duration);
+            error_code
         }
     }
 }
 
+// =============================================================================
+// JSON Conversion (requires "json" feature)
+// =============================================================================
+
+/// Parse JSON into a HEDL document.
+///
+/// The input is borrowed for the duration of the call, never copied.
+///
+/// # Arguments
+/// * `json` - UTF-8 encoded JSON string
+/// * `json_len` - Length of input in bytes, or -1 for null-terminated
+/// * `out_doc` - Pointer to store document handle
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure.
+///
+/// # Safety
+/// All pointers must be valid.
+///
+/// # Feature
+/// Requires the "json" feature to be enabled.
+#[cfg(feature = "json")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_from_json(
+    json: *const c_char,
+    json_len: c_int,
+    out_doc: *mut *mut HedlDocument,
+) -> c_int {
+    import_text(
+        "hedl_from_json",
+        ["json_ptr", "json_len"],
+        &json_len,
+        json,
+        out_doc,
+        || get_input_str(json, json_len),
+        hedl_json::json_to_hedl,
+        HEDL_ERR_JSON,
+        "JSON",
+    )
+}
+
+/// Parse JSON into a HEDL document, taking a `size_t` length.
+///
+/// Same as [`hedl_from_json`] but without the `int` length limit or the
+/// null-terminated mode.
+///
+/// # Arguments
+/// * `json` - UTF-8 encoded JSON bytes (need not be null-terminated)
+/// * `json_len` - Length of input in bytes
+/// * `out_doc` - Pointer to store document handle
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure.
+///
+/// # Safety
+/// `json` must point to at least `json_len` readable bytes.
+///
+/// # Feature
+/// Requires the "json" feature to be enabled.
+#[cfg(feature = "json")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_from_json_sized(
+    json: *const c_char,
+    json_len: usize,
+    out_doc: *mut *mut HedlDocument,
+) -> c_int {
+    import_text(
+        "hedl_from_json_sized",
+        ["json_ptr", "json_len"],
+        &json_len,
+        json,
+        out_doc,
+        || get_input_str_sized(json, json_len),
+        hedl_json::json_to_hedl,
+        HEDL_ERR_JSON,
+        "JSON",
+    )
+}
+
 // =============================================================================
 // YAML Conversion (requires "yaml" feature)
 // =============================================================================
 
 /// Parse YAML into a HEDL document.
 ///
+/// The input is borrowed for the duration of the call, never copied.
+///
 /// # Arguments
 /// * `yaml` - UTF-8 encoded YAML string
 /// * `yaml_len` - Length of input in bytes, or -1 for null-terminated
@@ -127,49 +216,55 @@ pub unsafe extern "C" fn hedl_from_yaml(
     yaml_len: c_int,
     out_doc: *mut *mut HedlDocument,
 ) -> c_int {
-    use crate::audit::{audit_call_failure, audit_call_start, audit_call_success, sanitize_pointer};
-    use std::time::Instant;
-
-    let start = Instant::now();
-    let yaml_ptr_str = sanitize_pointer(yaml);
-    let yaml_len_str = yaml_len.to_string();
-    audit_call_start("hedl_from_yaml", &[("yaml_ptr", &yaml_ptr_str), ("yaml_len", &yaml_len_str)]);
-
-    clear_error();
-
-    if yaml.is_null() || out_doc.is_null() {
-        let duration = start.elapsed();
-        set_error("Null pointer argument");
-        audit_call_failure("hedl_from_yaml", HEDL_ERR_NULL_PTR, "NULL pointer", duration);
-        return HEDL_ERR_NULL_PTR;
-    }
-
-    let yaml_str = match get_input_string(yaml, yaml_len) {
-        Ok(s) => s,
-        Err(code) => {
-            let duration = start.elapsed();
-            let msg = crate::error::get_thread_local_error();
-            audit_call_failure("hedl_from_yaml", code, &msg, duration);
-            return code;
-        }
-    };
+    import_text(
+        "hedl_from_yaml",
+        ["yaml_ptr", "yaml_len"],
+        &yaml_len,
+        yaml,
+        out_doc,
+        || get_input_str(yaml, yaml_len),
+        hedl_yaml::yaml_to_hedl,
+        HEDL_ERR_YAML,
+        "YAML",
+    )
+}
 
-    match hedl_yaml::yaml_to_hedl(&yaml_str) {
-        Ok(doc) => {
-            let handle = Box::new(HedlDocument { inner: doc });
-            *out_doc = Box::into_raw(handle);
-            audit_call_success("hedl_from_yaml", start.elapsed());
-            HEDL_OK
-        }
-        Err(e) => {
-            let duration = start.elapsed();
-            let msg = format!("YAML parse error: {}", e);
-            set_error(&msg);
-            *out_doc = ptr::null_mut();
-            audit_call_failure("hedl_from_yaml", HEDL_ERR_YAML, &msg, duration);
-            HEDL_ERR_YAML
-        }
-    }
+/// Parse YAML into a HEDL document, taking a `size_t` length.
+///
+/// Same as [`hedl_from_yaml`] but without the `int` length limit or the
+/// null-terminated mode.
+///
+/// # Arguments
+/// * `yaml` - UTF-8 encoded YAML bytes (need not be null-terminated)
+/// * `yaml_len` - Length of input in bytes
+/// * `out_doc` - Pointer to store document handle
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure.
+///
+/// # Safety
+/// `yaml` must point to at least `yaml_len` readable bytes.
+///
+/// # Feature
+/// Requires the "yaml" feature to be enabled.
+#[cfg(feature = "yaml")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_from_yaml_sized(
+    yaml: *const c_char,
+    yaml_len: usize,
+    out_doc: *mut *mut HedlDocument,
+) -> c_int {
+    import_text(
+        "hedl_from_yaml_sized",
+        ["yaml_ptr", "yaml_len"],
+        &yaml_len,
+        yaml,
+        out_doc,
+        || get_input_str_sized(yaml, yaml_len),
+        hedl_yaml::yaml_to_hedl,
+        HEDL_ERR_YAML,
+        "YAML",
+    )
 }
 
 // =============================================================================
@@ -178,6 +273,8 @@ pub unsafe extern "C" fn hedl_from_yaml(
 
 /// Parse XML into a HEDL document.
 ///
+/// The input is borrowed for the duration of the call, never copied.
+///
 /// # Arguments
 /// * `xml` - UTF-8 encoded XML string
 /// * `xml_len` - Length of input in bytes, or -1 for null-terminated
@@ -198,49 +295,55 @@ pub unsafe extern "C" fn hedl_from_xml(
     xml_len: c_int,
     out_doc: *mut *mut HedlDocument,
 ) -> c_int {
-    use crate::audit::{audit_call_failure, audit_call_start, audit_call_success, sanitize_pointer};
-    use std::time::Instant;
-
-    let start = Instant::now();
-    let xml_ptr_str = sanitize_pointer(xml);
-    let xml_len_str = xml_len.to_string();
-    audit_call_start("hedl_from_xml", &[("xml_ptr", &xml_ptr_str), ("xml_len", &xml_len_str)]);
-
-    clear_error();
-
-    if xml.is_null() || out_doc.is_null() {
-        let duration = start.elapsed();
-        set_error("Null pointer argument");
-        audit_call_failure("hedl_from_xml", HEDL_ERR_NULL_PTR, "NULL pointer", duration);
-        return HEDL_ERR_NULL_PTR;
-    }
-
-    let xml_str = match get_input_string(xml, xml_len) {
-        Ok(s) => s,
-        Err(code) => {
-            let duration = start.elapsed();
-            let msg = crate::error::get_thread_local_error();
-            audit_call_failure("hedl_from_xml", code, &msg, duration);
-            return code;
-        }
-    };
+    import_text(
+        "hedl_from_xml",
+        ["xml_ptr", "xml_len"],
+        &xml_len,
+        xml,
+        out_doc,
+        || get_input_str(xml, xml_len),
+        hedl_xml::xml_to_hedl,
+        HEDL_ERR_XML,
+        "XML",
+    )
+}
 
-    match hedl_xml::xml_to_hedl(&xml_str) {
-        Ok(doc) => {
-            let handle = Box::new(HedlDocument { inner: doc });
-            *out_doc = Box::into_raw(handle);
-            audit_call_success("hedl_from_xml", start.elapsed());
-            HEDL_OK
-        }
-        Err(e) => {
-            let duration = start.elapsed();
-            let msg = format!("XML parse error: {}", e);
-            set_error(&msg);
-            *out_doc = ptr::null_mut();
-            audit_call_failure("hedl_from_xml", HEDL_ERR_XML, &msg, duration);
-            HEDL_ERR_XML
-        }
-    }
+/// Parse XML into a HEDL document, taking a `size_t` length.
+///
+/// Same as [`hedl_from_xml`] but without the `int` length limit or the
+/// null-terminated mode.
+///
+/// # Arguments
+/// * `xml` - UTF-8 encoded XML bytes (need not be null-terminated)
+/// * `xml_len` - Length of input in bytes
+/// * `out_doc` - Pointer to store document handle
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure.
+///
+/// # Safety
+/// `xml` must point to at least `xml_len` readable bytes.
+///
+/// # Feature
+/// Requires the "xml" feature to be enabled.
+#[cfg(feature = "xml")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_from_xml_sized(
+    xml: *const c_char,
+    xml_len: usize,
+    out_doc: *mut *mut HedlDocument,
+) -> c_int {
+    import_text(
+        "hedl_from_xml_sized",
+        ["xml_ptr", "xml_len"],
+        &xml_len,
+        xml,
+        out_doc,
+        || get_input_str_sized(xml, xml_len),
+        hedl_xml::xml_to_hedl,
+        HEDL_ERR_XML,
+        "XML",
+    )
 }
 
 // =============================================================================
@@ -269,13 +372,15 @@ pub unsafe extern "C" fn hedl_from_parquet(
     len: usize,
     out_doc: *mut *mut HedlDocument,
 ) -> c_int {
-    use crate::audit::{audit_call_failure, audit_call_start, audit_call_success, sanitize_pointer};
-    use std::time::Instant;
+    use crate::audit::{audit_call_failure, audit_call_success, sanitize_pointer, AuditTimer};
+    use crate::audit_start;
 
-    let start = Instant::now();
-    let data_ptr_str = sanitize_pointer(data);
-    let len_str = len.to_string();
-    audit_call_start("hedl_from_parquet", &[("data_ptr", &data_ptr_str), ("len", &len_str)]);
+    let start = AuditTimer::start();
+    audit_start!(
+        "hedl_from_parquet",
+        "data_ptr" => sanitize_pointer(data),
+        "len" => len.to_string(),
+    );
 
     clear_error();
 
@@ -287,10 +392,11 @@ pub unsafe extern "C" fn hedl_from_parquet(
     }
 
     let bytes = slice::from_raw_parts(data, len);
+    crate::metrics::note_input(len);
 
     match hedl_parquet::from_parquet_bytes(bytes) {
         Ok(doc) => {
-            let handle = Box::new(HedlDocument { inner: doc });
+            let handle = Box::new(HedlDocument::new(doc));
             *out_doc = Box::into_raw(handle);
             audit_call_success("hedl_from_parquet", start.elapsed());
             HEDL_OK
@@ -305,3 +411,188 @@ pub unsafe extern "C" fn hedl_from_parquet(
         }
     }
 }
+
+/// Read a Parquet file into a HEDL document, decoding only what is selected.
+///
+/// The file is memory-mapped; only the footer and the column chunks of the
+/// selected row groups are paged in, so unselected data is never read from
+/// disk or decompressed.
+///
+/// # Arguments
+/// * `path` - Null-terminated UTF-8 file path
+/// * `columns` - Top-level column names to read, or NULL for all columns.
+///   Selected columns keep their file order; the first becomes the node ID.
+/// * `n_columns` - Number of entries in `columns`
+/// * `row_groups` - Row group indices to read, or NULL for all row groups
+/// * `n_row_groups` - Number of entries in `row_groups`
+/// * `out_doc` - Pointer to store document handle
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_IO if the file cannot be opened or mapped,
+/// HEDL_ERR_PARQUET for unknown columns, out-of-range row groups or
+/// invalid data.
+///
+/// # Safety
+/// `path` and every `columns` entry must be valid null-terminated strings;
+/// non-NULL arrays must hold at least their stated number of elements. The
+/// file must not be modified or truncated while the call is running.
+///
+/// # Feature
+/// Requires the "parquet" feature to be enabled.
+#[cfg(feature = "parquet")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_from_parquet_file(
+    path: *const c_char,
+    columns: *const *const c_char,
+    n_columns: usize,
+    row_groups: *const usize,
+    n_row_groups: usize,
+    out_doc: *mut *mut HedlDocument,
+) -> c_int {
+    use crate::audit::{audit_call_failure, audit_call_success, sanitize_pointer, AuditTimer};
+    use crate::audit_start;
+    use crate::types::HEDL_ERR_IO;
+    use crate::utils::borrow_c_str;
+    use hedl_core::HedlErrorKind;
+    use hedl_parquet::ParquetReadOptions;
+
+    const FN_NAME: &str = "hedl_from_parquet_file";
+
+    let start = AuditTimer::start();
+    audit_start!(
+        FN_NAME,
+        "path_ptr" => sanitize_pointer(path),
+        "n_columns" => n_columns.to_string(),
+        "n_row_groups" => n_row_groups.to_string(),
+    );
+
+    clear_error();
+
+    let fail = |code: c_int, msg: String| {
+        set_error(&msg);
+        audit_call_failure(FN_NAME, code, &msg, start.elapsed());
+        code
+    };
+
+    if path.is_null() || out_doc.is_null() {
+        return fail(HEDL_ERR_NULL_PTR, "Null pointer argument".to_string());
+    }
+    *out_doc = ptr::null_mut();
+
+    let path = match borrow_c_str(path) {
+        Ok(p) => p,
+        Err((code, msg)) => return fail(code, msg),
+    };
+
+    let mut options = ParquetReadOptions::default();
+
+    if !columns.is_null() {
+        let mut names = Vec::with_capacity(n_columns);
+        for &name in slice::from_raw_parts(columns, n_columns) {
+            if name.is_null() {
+                return fail(HEDL_ERR_NULL_PTR, "Null column name".to_string());
+            }
+            match borrow_c_str(name) {
+                Ok(n) => names.push(n.to_string()),
+                Err((code, msg)) => return fail(code, msg),
+            }
+        }
+        options.columns = Some(names);
+    }
+
+    if !row_groups.is_null() {
+        options.row_groups = Some(slice::from_raw_parts(row_groups, n_row_groups).to_vec());
+    }
+
+    match hedl_parquet::from_parquet_mmap(std::path::Path::new(path), &options) {
+        Ok(doc) => {
+            let handle = Box::new(HedlDocument::new(doc));
+            *out_doc = Box::into_raw(handle);
+            audit_call_success(FN_NAME, start.elapsed());
+            HEDL_OK
+        }
+        Err(e) if matches!(e.kind, HedlErrorKind::IO) => {
+            fail(HEDL_ERR_IO, format!("Parquet I/O error: {}", e))
+        }
+        Err(e) => fail(HEDL_ERR_PARQUET, format!("Parquet parse error: {}", e)),
+    }
+}
+
+// =============================================================================
+// Arrow C Data Interface (requires "parquet" feature)
+// =============================================================================
+
+/// Import a struct array from the Arrow C Data Interface as a document.
+///
+/// Inverse of `hedl_to_arrow`: each child array becomes a column of one
+/// matrix list, the first column providing node IDs. Type name and list
+/// key are restored from the schema's `hedl:type_name` / `hedl:key`
+/// metadata when present.
+///
+/// The array is moved: HEDL releases it, and marks the caller's structure
+/// released, whether or not the import succeeds. The schema is borrowed and
+/// stays owned by the caller.
+///
+/// # Arguments
+/// * `schema` - Schema describing `array` (a struct type)
+/// * `array` - Struct array to import
+/// * `out_doc` - Pointer to store document handle
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_PARQUET if the array is already released,
+/// is not a struct array, or cannot be converted.
+///
+/// # Safety
+/// `schema` and `array` must be valid C Data Interface structures that
+/// describe the same data.
+///
+/// # Feature
+/// Requires the "parquet" feature to be enabled.
+#[cfg(feature = "parquet")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_from_arrow(
+    schema: *const hedl_parquet::FFI_ArrowSchema,
+    array: *mut hedl_parquet::FFI_ArrowArray,
+    out_doc: *mut *mut HedlDocument,
+) -> c_int {
+    use crate::audit::{audit_call_failure, audit_call_success, sanitize_pointer, AuditTimer};
+    use crate::audit_start;
+    use hedl_parquet::FFI_ArrowArray;
+
+    const FN_NAME: &str = "hedl_from_arrow";
+
+    let start = AuditTimer::start();
+    audit_start!(
+        FN_NAME,
+        "schema" => sanitize_pointer(schema),
+        "array" => sanitize_pointer(array),
+    );
+
+    clear_error();
+
+    let fail = |code: c_int, msg: String| {
+        set_error(&msg);
+        audit_call_failure(FN_NAME, code, &msg, start.elapsed());
+        code
+    };
+
+    if schema.is_null() || array.is_null() || out_doc.is_null() {
+        return fail(HEDL_ERR_NULL_PTR, "Null pointer argument".to_string());
+    }
+    *out_doc = ptr::null_mut();
+
+    if (*array).is_released() {
+        return fail(HEDL_ERR_PARQUET, "Arrow array is already released".to_string());
+    }
+    // Move the array out, leaving a released one behind
+    let array = ptr::replace(array, FFI_ArrowArray::empty());
+
+    match hedl_parquet::from_arrow_c(array, &*schema) {
+        Ok(doc) => {
+            *out_doc = Box::into_raw(Box::new(HedlDocument::new(doc)));
+            audit_call_success(FN_NAME, start.elapsed());
+            HEDL_OK
+        }
+        Err(e) => fail(HEDL_ERR_PARQUET, format!("Arrow import error: {}", e)),
+    }
+}
@@ -0,0 +1,406 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Streaming JSON row import for FFI.
+//!
+//! `hedl_from_json` needs the whole JSON text in memory and builds a full
+//! JSON value tree before converting it. For large exports of table rows
+//! (a top-level array of objects, or JSON Lines) that doubles the peak
+//! memory for no benefit. The importer here decodes each object straight
+//! into a matrix list row as its bytes arrive, either pushed in chunks with
+//! `hedl_json_importer_feed` or pulled through a read callback with
+//! `hedl_from_json_reader`.
+//!
+//! The schema is inferred from the first `sample_rows` objects (keys sorted
+//! with `id` first, as `hedl_from_json` does); later objects may omit
+//! columns but not introduce new ones.
+//!
+//! # Usage Example (C)
+//!
+//! ```c
+//! HedlJsonImporter* importer = NULL;
+//! hedl_json_importer_new("users", 0, &importer);
+//! while ((n = recv(sock, frame, sizeof(frame), 0)) > 0) {
+//!     if (hedl_json_importer_feed(importer, frame, (size_t)n) != HEDL_OK) break;
+//! }
+//! HedlDocument* doc = NULL;
+//! if (hedl_json_importer_finish(importer, &doc) == HEDL_OK) {
+//!     // ... users is a matrix list of User rows
+//!     hedl_free_document(doc);
+//! }
+//! hedl_json_importer_free(importer);
+//! ```
+
+use crate::audit::{audit_call_failure, audit_call_success, sanitize_pointer, AuditTimer};
+use crate::audit_start;
+use crate::error::{clear_error, set_error};
+use crate::streaming::{CallbackReader, HedlReadCallback};
+use crate::types::{HedlDocument, HEDL_ERR_IO, HEDL_ERR_JSON, HEDL_ERR_NULL_PTR, HEDL_OK};
+use crate::utils::borrow_c_str;
+use hedl_json::streaming::{import_json_rows, JsonRowImporter, RowImportConfig, StreamError};
+use std::os::raw::{c_char, c_int, c_void};
+use std::ptr;
+use std::slice;
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+/// Build the import configuration from the C arguments.
+///
+/// # Safety
+/// `key` must be NULL or a valid null-terminated string.
+unsafe fn row_config(
+    key: *const c_char,
+    sample_rows: usize,
+) -> Result<RowImportConfig, (c_int, String)> {
+    let mut config = RowImportConfig::default();
+    if !key.is_null() {
+        config.key = borrow_c_str(key)?.to_string();
+    }
+    if sample_rows != 0 {
+        config.sample_rows = sample_rows;
+    }
+    Ok(config)
+}
+
+fn import_error(e: &StreamError) -> (c_int, String) {
+    let code = match e {
+        StreamError::Io(_) => HEDL_ERR_IO,
+        _ => HEDL_ERR_JSON,
+    };
+    (code, format!("JSON import error: {}", e))
+}
+
+// =============================================================================
+// Opaque Importer Handle
+// =============================================================================
+
+/// Opaque handle to a push-based JSON row importer.
+pub struct HedlJsonImporter {
+    /// Taken by `hedl_json_importer_finish`.
+    importer: Option<JsonRowImporter>,
+    /// First error code; the importer refuses further input once set.
+    error: c_int,
+}
+
+impl HedlJsonImporter {
+    /// Reject calls after a failure or after finishing.
+    fn check_usable(&mut self) -> Result<&mut JsonRowImporter, c_int> {
+        if self.error != HEDL_OK {
+            set_error("JSON importer stopped after an earlier error");
+            return Err(self.error);
+        }
+        match self.importer.as_mut() {
+            Some(importer) => Ok(importer),
+            None => {
+                set_error("JSON importer is already finished");
+                Err(HEDL_ERR_IO)
+            }
+        }
+    }
+}
+
+// =============================================================================
+// Importer API
+// =============================================================================
+
+/// Create a push-based importer for an array of JSON objects.
+///
+/// The input may be a top-level JSON array of objects or JSON Lines. Each
+/// object becomes one row of the matrix list stored under `key`; the row
+/// type is derived from the key as in `hedl_from_json` ("users" -> User).
+///
+/// # Arguments
+/// * `key` - Root key of the list, or NULL for "rows"
+/// * `sample_rows` - Objects sampled to infer the schema, or 0 for the default (100)
+/// * `out_importer` - Pointer to store the handle (free with hedl_json_importer_free)
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure.
+///
+/// # Safety
+/// - `key` must be NULL or a valid null-terminated string
+/// - `out_importer` must be valid
+///
+/// # Feature
+/// Requires the "json" feature to be enabled.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_json_importer_new(
+    key: *const c_char,
+    sample_rows: usize,
+    out_importer: *mut *mut HedlJsonImporter,
+) -> c_int {
+    let start = AuditTimer::start();
+
+    audit_start!(
+        "hedl_json_importer_new",
+        "key" => sanitize_pointer(key),
+        "sample_rows" => sample_rows.to_string(),
+        "out_importer" => sanitize_pointer(out_importer),
+    );
+
+    clear_error();
+
+    if out_importer.is_null() {
+        set_error("Null pointer argument");
+        audit_call_failure(
+            "hedl_json_importer_new",
+            HEDL_ERR_NULL_PTR,
+            "Null pointer argument",
+            start.elapsed(),
+        );
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    let config = match row_config(key, sample_rows) {
+        Ok(config) => config,
+        Err((code, msg)) => {
+            set_error(&msg);
+            audit_call_failure("hedl_json_importer_new", code, &msg, start.elapsed());
+            return code;
+        }
+    };
+
+    let importer = Box::new(HedlJsonImporter {
+        importer: Some(JsonRowImporter::new(config)),
+        error: HEDL_OK,
+    });
+    *out_importer = Box::into_raw(importer);
+
+    audit_call_success("hedl_json_importer_new", start.elapsed());
+    HEDL_OK
+}
+
+/// Feed the next chunk of JSON input.
+///
+/// Chunks may split anywhere. Objects completed by this chunk are converted
+/// before the function returns; only a trailing partial object is buffered.
+///
+/// # Arguments
+/// * `importer` - Importer handle
+/// * `chunk` - Input bytes (may be NULL if `len` is 0)
+/// * `len` - Number of bytes in `chunk`
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_JSON on malformed input. After an error the
+/// importer rejects further input and only `hedl_json_importer_free` is
+/// meaningful.
+///
+/// # Safety
+/// `chunk` must point to at least `len` readable bytes.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_json_importer_feed(
+    importer: *mut HedlJsonImporter,
+    chunk: *const c_char,
+    len: usize,
+) -> c_int {
+    if importer.is_null() || (chunk.is_null() && len != 0) {
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    clear_error();
+
+    let handle = &mut *importer;
+    let rows = match handle.check_usable() {
+        Ok(rows) => rows,
+        Err(code) => return code,
+    };
+    if len == 0 {
+        return HEDL_OK;
+    }
+
+    let bytes = slice::from_raw_parts(chunk as *const u8, len);
+    match rows.feed(bytes) {
+        Ok(()) => HEDL_OK,
+        Err(e) => {
+            let (code, msg) = import_error(&e);
+            set_error(&msg);
+            handle.error = code;
+            code
+        }
+    }
+}
+
+/// Signal end of input and return the imported document.
+///
+/// The importer is finished afterwards whatever the outcome; it still has to
+/// be released with `hedl_json_importer_free`.
+///
+/// # Arguments
+/// * `importer` - Importer handle
+/// * `out_doc` - Pointer to store document handle
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_JSON if the input ends inside an object or
+/// array.
+///
+/// # Safety
+/// All pointers must be valid.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_json_importer_finish(
+    importer: *mut HedlJsonImporter,
+    out_doc: *mut *mut HedlDocument,
+) -> c_int {
+    let start = AuditTimer::start();
+
+    audit_start!(
+        "hedl_json_importer_finish",
+        "importer" => sanitize_pointer(importer),
+        "out_doc" => sanitize_pointer(out_doc),
+    );
+
+    clear_error();
+
+    if importer.is_null() || out_doc.is_null() {
+        set_error("Null pointer argument");
+        audit_call_failure(
+            "hedl_json_importer_finish",
+            HEDL_ERR_NULL_PTR,
+            "Null pointer argument",
+            start.elapsed(),
+        );
+        return HEDL_ERR_NULL_PTR;
+    }
+    *out_doc = ptr::null_mut();
+
+    let handle = &mut *importer;
+    if let Err(code) = handle.check_usable() {
+        let msg = crate::error::get_thread_local_error();
+        audit_call_failure("hedl_json_importer_finish", code, &msg, start.elapsed());
+        return code;
+    }
+
+    let result = match handle.importer.take() {
+        Some(rows) => rows.finish(),
+        None => unreachable!("checked by check_usable"),
+    };
+    finish_import("hedl_json_importer_finish", result, out_doc, start)
+}
+
+/// Free an importer handle. Rows not yet returned by
+/// `hedl_json_importer_finish` are discarded.
+///
+/// # Safety
+/// The pointer must have been returned by `hedl_json_importer_new`. NULL is ignored.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_json_importer_free(importer: *mut HedlJsonImporter) {
+    if !importer.is_null() {
+        let _ = Box::from_raw(importer);
+    }
+}
+
+/// Import an array of JSON objects pulled through a read callback.
+///
+/// Equivalent to feeding everything the callback returns to a
+/// `hedl_json_importer_new(key, sample_rows, ...)` importer. The input is
+/// never held in full: memory stays at the document plus one read buffer.
+///
+/// # Arguments
+/// * `read` - Callback supplying input bytes
+/// * `user_data` - User context pointer passed to the callback
+/// * `key` - Root key of the list, or NULL for "rows"
+/// * `sample_rows` - Objects sampled to infer the schema, or 0 for the default (100)
+/// * `out_doc` - Pointer to store document handle
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_IO if the callback fails, HEDL_ERR_JSON on
+/// malformed input.
+///
+/// # Safety
+/// - `key` must be NULL or a valid null-terminated string
+/// - `out_doc` must be valid
+/// - The callback MUST NOT call back into HEDL functions
+///
+/// # Feature
+/// Requires the "json" feature to be enabled.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_from_json_reader(
+    read: Option<HedlReadCallback>,
+    user_data: *mut c_void,
+    key: *const c_char,
+    sample_rows: usize,
+    out_doc: *mut *mut HedlDocument,
+) -> c_int {
+    let start = AuditTimer::start();
+
+    audit_start!(
+        "hedl_from_json_reader",
+        "user_data" => sanitize_pointer(user_data),
+        "key" => sanitize_pointer(key),
+        "sample_rows" => sample_rows.to_string(),
+        "out_doc" => sanitize_pointer(out_doc),
+    );
+
+    clear_error();
+
+    let callback = match read {
+        Some(cb) if !out_doc.is_null() => cb,
+        _ => {
+            set_error("Null pointer argument");
+            audit_call_failure(
+                "hedl_from_json_reader",
+                HEDL_ERR_NULL_PTR,
+                "Null pointer argument",
+                start.elapsed(),
+            );
+            return HEDL_ERR_NULL_PTR;
+        }
+    };
+    *out_doc = ptr::null_mut();
+
+    let config = match row_config(key, sample_rows) {
+        Ok(config) => config,
+        Err((code, msg)) => {
+            set_error(&msg);
+            audit_call_failure("hedl_from_json_reader", code, &msg, start.elapsed());
+            return code;
+        }
+    };
+
+    let reader = CallbackReader {
+        callback,
+        user_data,
+    };
+    let result = import_json_rows(reader, config);
+    finish_import("hedl_from_json_reader", result, out_doc, start)
+}
+
+/// Hand the imported document to the caller, or report the error.
+///
+/// # Safety
+/// `out_doc` must be valid.
+unsafe fn finish_import(
+    fn_name: &'static str,
+    result: Result<hedl_core::Document, StreamError>,
+    out_doc: *mut *mut HedlDocument,
+    start: AuditTimer,
+) -> c_int {
+    match result {
+        Ok(doc) => {
+            *out_doc = Box::into_raw(Box::new(HedlDocument::new(doc)));
+            audit_call_success(fn_name, start.elapsed());
+            HEDL_OK
+        }
+        Err(e) => {
+            let (code, msg) = import_error(&e);
+            set_error(&msg);
+            audit_call_failure(fn_name, code, &msg, start.elapsed());
+            code
+        }
+    }
+}
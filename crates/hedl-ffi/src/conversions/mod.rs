@@ -18,5 +18,9 @@
 //! Conversion functions for FFI.
 
 pub mod from_formats;
+#[cfg(feature = "json")]
+pub mod json_import;
+mod output_bound;
 pub mod to_formats;
 pub mod to_formats_callback;
+pub mod to_formats_into;
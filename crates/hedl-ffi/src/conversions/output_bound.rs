@@ -0,0 +1,949 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Upper bounds on exporter output size, computed without serializing.
+//!
+//! Each text format gets its own walk that mirrors the structure its writer
+//! emits: every key, tag, separator and indentation run is charged at its
+//! longest, and every string is charged at the format's worst-case escape
+//! factor, so the result is never below the real output. The walks read
+//! lengths only; the one exception is `Display`-formatted numbers and
+//! expressions, whose length is measured with a counting sink.
+//!
+//! Worst-case escape factors, in output bytes per input byte:
+//!
+//! | Format    | Factor | Longest escape                               |
+//! |-----------|--------|----------------------------------------------|
+//! | canonical | 2      | `""` for `"`, `\n` for a newline             |
+//! | JSON      | 6      | `\u00XX` for a control character             |
+//! | YAML      | 4      | `\xXX`, plus a line break at folded spaces   |
+//! | XML       | 6      | `&quot;` / `&apos;`                          |
+//! | CSV       | 2      | `""` for `"`                                 |
+//! | Cypher    | 6      | `\u0000`; identifiers grow 3x under NFC      |
+//!
+//! The bounds follow the configurations the FFI exporters use, so they must
+//! change together with `to_formats_callback`'s `write_*` functions.
+
+#[cfg(any(feature = "json", feature = "yaml"))]
+use crate::shared::HEDL_EXPORT_METADATA;
+#[cfg(feature = "csv")]
+use crate::shared::HEDL_FORMAT_CSV;
+#[cfg(feature = "neo4j")]
+use crate::shared::HEDL_FORMAT_CYPHER;
+use crate::shared::HEDL_FORMAT_HEDL;
+#[cfg(feature = "json")]
+use crate::shared::HEDL_FORMAT_JSON;
+#[cfg(feature = "xml")]
+use crate::shared::HEDL_FORMAT_XML;
+#[cfg(feature = "yaml")]
+use crate::shared::HEDL_FORMAT_YAML;
+#[cfg(any(feature = "json", feature = "yaml"))]
+use hedl_core::MatrixList;
+use hedl_core::{Document, Item, Node, Reference, Tensor, Value};
+use std::collections::BTreeMap;
+use std::fmt;
+use std::os::raw::c_int;
+
+/// Upper bound on the bytes `format` produces for `doc`, terminator included.
+///
+/// Returns `None` for formats without a text exporter in this build. Only the
+/// JSON and YAML bounds read `flags`; the Cypher bound charges the longer of
+/// `MERGE` and `CREATE`, so it covers both.
+#[cfg_attr(not(any(feature = "json", feature = "yaml")), allow(unused_variables))]
+pub(crate) fn output_bound(doc: &Document, format: c_int, flags: u32) -> Option<usize> {
+    let bytes = match format {
+        HEDL_FORMAT_HEDL => canonical_bound(doc),
+        #[cfg(feature = "json")]
+        HEDL_FORMAT_JSON => {
+            TreeBound::new(doc, JsonLayout, flags & HEDL_EXPORT_METADATA != 0).document()
+        }
+        #[cfg(feature = "yaml")]
+        HEDL_FORMAT_YAML => {
+            TreeBound::new(doc, YamlLayout, flags & HEDL_EXPORT_METADATA != 0).document()
+        }
+        #[cfg(feature = "xml")]
+        HEDL_FORMAT_XML => xml_bound(doc),
+        #[cfg(feature = "csv")]
+        HEDL_FORMAT_CSV => csv_bound(doc),
+        #[cfg(feature = "neo4j")]
+        HEDL_FORMAT_CYPHER => cypher::bound(doc),
+        _ => return None,
+    };
+    // Computed in 64 bits; a bound past the address space still reads as "too big"
+    Some(usize::try_from(bytes + 1).unwrap_or(usize::MAX))
+}
+
+// =============================================================================
+// Scalar Lengths
+// =============================================================================
+
+/// Longest `i64` in decimal: `-9223372036854775808`.
+const INT_LEN: u64 = 20;
+
+/// Longest `true` / `false` / `null` / `~` literal.
+const WORD_LEN: u64 = 5;
+
+/// `fmt::Write` sink that only counts bytes, for sizing `Display` values.
+struct CountingWriter(usize);
+
+impl fmt::Write for CountingWriter {
+    fn write_str(&mut self, s: &str) -> fmt::Result {
+        self.0 += s.len();
+        Ok(())
+    }
+}
+
+fn display_len(value: &dyn fmt::Display) -> u64 {
+    let mut counter = CountingWriter(0);
+    let _ = fmt::write(&mut counter, format_args!("{}", value));
+    counter.0 as u64
+}
+
+fn len(s: &str) -> u64 {
+    s.len() as u64
+}
+
+/// Longest rendering of a float in any exporter.
+///
+/// `Display` never uses an exponent, so `1e300` is 301 digits; the shortest
+/// round-trip form (serde's) is at most 24 bytes. Two more cover the `.0`
+/// that canonical and Cypher output append to whole numbers.
+fn float_len(f: f64) -> u64 {
+    display_len(&f).max(24) + 2
+}
+
+/// `@Type:id` or `@id`.
+fn ref_len(r: &Reference) -> u64 {
+    1 + r.type_name.as_deref().map_or(0, |t| len(t) + 1) + len(&r.id)
+}
+
+/// Expressions render as `$(...)`.
+fn expr_len(value: &dyn fmt::Display) -> u64 {
+    display_len(value) + 3
+}
+
+/// A tensor as bracketed, `sep`-separated numbers.
+fn tensor_len(tensor: &Tensor, sep: u64) -> u64 {
+    match tensor {
+        Tensor::Scalar(f) => float_len(*f),
+        Tensor::Array(items) => 2 + items.iter().map(|t| tensor_len(t, sep) + sep).sum::<u64>(),
+    }
+}
+
+#[cfg(any(feature = "json", feature = "yaml", feature = "neo4j"))]
+fn decimal_len(n: usize) -> u64 {
+    display_len(&n)
+}
+
+// =============================================================================
+// Canonical HEDL
+// =============================================================================
+
+/// Canonical output: `%` header lines, then two-space indented entries and
+/// `|`-prefixed rows, with quotes doubled and control characters escaped.
+fn canonical_bound(doc: &Document) -> u64 {
+    // "%VERSION: a.b\n" with two u32s, and the "---\n" separator
+    let mut total = 12 + 2 * 10 + 4;
+    for (key, value) in &doc.aliases {
+        // %ALIAS: %key: "value"\n
+        total += 14 + len(key) + 2 * len(value);
+    }
+    for (name, columns) in &doc.structs {
+        total += canonical_struct_line(name, columns);
+    }
+    for (parent, child) in &doc.nests {
+        // %NEST: parent > child\n
+        total += 11 + len(parent) + len(child);
+    }
+    total + canonical_items(&doc.root, 0)
+}
+
+/// `%STRUCT: T (count): [a,b]\n`; every list type gets one.
+fn canonical_struct_line(name: &str, columns: &[String]) -> u64 {
+    16 + len(name) + INT_LEN + columns.iter().map(|c| len(c) + 1).sum::<u64>()
+}
+
+fn canonical_items(items: &BTreeMap<String, Item>, indent: u64) -> u64 {
+    items
+        .iter()
+        .map(|(key, item)| {
+            let prefix = 2 * indent + len(key);
+            match item {
+                // key: value\n, or a """ block for multi-line strings
+                Item::Scalar(value) => prefix + 3 + canonical_value(value),
+                Item::Object(fields) => prefix + 2 + canonical_items(fields, indent + 1),
+                Item::List(list) => {
+                    // key: @Type\n
+                    prefix
+                        + 4
+                        + len(&list.type_name)
+                        + canonical_struct_line(&list.type_name, &list.schema)
+                        + list
+                            .rows
+                            .iter()
+                            .map(|row| canonical_row(row, indent + 1))
+                            .sum::<u64>()
+                }
+            }
+        })
+        .sum()
+}
+
+/// `|[count] a,b\n` at `indent`, then child rows one level deeper.
+fn canonical_row(row: &Node, indent: u64) -> u64 {
+    // Each cell also pays for its comma; a ditto `^` is never longer than the cell
+    let cells: u64 = row.fields.iter().map(|v| canonical_value(v) + 1).sum();
+    let children: u64 = row
+        .children
+        .values()
+        .flatten()
+        .map(|child| canonical_row(child, indent + 1))
+        .sum();
+    2 * indent + 5 + INT_LEN + cells + children
+}
+
+/// A value in key-value or cell position, whichever is longer.
+fn canonical_value(value: &Value) -> u64 {
+    match value {
+        Value::Null | Value::Bool(_) => WORD_LEN,
+        Value::Int(_) => INT_LEN,
+        Value::Float(f) => float_len(*f),
+        // Quoted with every byte escaped, or a """ block with a break per byte
+        Value::String(s) => 2 * len(s) + 8,
+        Value::Tensor(t) => tensor_len(t, 2),
+        Value::Reference(r) => ref_len(r),
+        Value::Expression(e) => expr_len(e),
+    }
+}
+
+// =============================================================================
+// JSON and YAML
+// =============================================================================
+
+/// Text of a string scalar as far as layout is concerned.
+#[cfg(any(feature = "json", feature = "yaml"))]
+#[derive(Clone, Copy)]
+struct Text {
+    len: u64,
+    /// Bytes where YAML may break the line: spaces, newlines, non-ASCII.
+    breaks: u64,
+}
+
+#[cfg(any(feature = "json", feature = "yaml"))]
+impl Text {
+    fn of(s: &str) -> Self {
+        let breaks = s
+            .bytes()
+            .filter(|&b| matches!(b, b' ' | b'\n' | b'\r') || b >= 0x80);
+        Text {
+            len: len(s),
+            breaks: breaks.count() as u64,
+        }
+    }
+
+    /// Text known only by length; every byte may break.
+    fn opaque(len: u64) -> Self {
+        Text { len, breaks: len }
+    }
+}
+
+/// Byte costs of one tree serializer, by nesting level.
+///
+/// The JSON and YAML exporters build the same value tree, so one walk
+/// ([`TreeBound`]) serves both and only the layout differs.
+#[cfg(any(feature = "json", feature = "yaml"))]
+trait TreeLayout {
+    /// A mapping or sequence at `level`, excluding its entries.
+    fn container(&self, level: u64) -> u64;
+    /// A mapping entry at `level`, excluding its value.
+    fn member(&self, level: u64, key: Text) -> u64;
+    /// A sequence element at `level`, excluding its value.
+    fn element(&self, level: u64) -> u64;
+    /// A string scalar at `level`.
+    fn string(&self, level: u64, text: Text) -> u64;
+}
+
+/// `serde_json` pretty printing with two-space indentation.
+#[cfg(feature = "json")]
+struct JsonLayout;
+
+#[cfg(feature = "json")]
+impl TreeLayout for JsonLayout {
+    fn container(&self, level: u64) -> u64 {
+        // Brackets, and the newline and indentation before the closing one
+        3 + 2 * level
+    }
+
+    fn member(&self, level: u64, key: Text) -> u64 {
+        // Newline, indentation, `: ` and trailing comma
+        4 + 2 * level + self.string(level, key)
+    }
+
+    fn element(&self, level: u64) -> u64 {
+        2 + 2 * level
+    }
+
+    fn string(&self, _level: u64, text: Text) -> u64 {
+        2 + 6 * text.len
+    }
+}
+
+/// `serde_yaml` block style: two spaces per level, indentless sequences.
+#[cfg(feature = "yaml")]
+struct YamlLayout;
+
+#[cfg(feature = "yaml")]
+impl YamlLayout {
+    fn indent(level: u64) -> u64 {
+        2 * level + 2
+    }
+}
+
+#[cfg(feature = "yaml")]
+impl TreeLayout for YamlLayout {
+    fn container(&self, level: u64) -> u64 {
+        // `{}` or `[]` when empty, and the line break after the key
+        3 + Self::indent(level)
+    }
+
+    fn member(&self, level: u64, key: Text) -> u64 {
+        // Long keys take the `? key` / `: value` form, indented twice
+        2 * Self::indent(level) + 8 + self.string(level, key)
+    }
+
+    fn element(&self, level: u64) -> u64 {
+        Self::indent(level) + 4
+    }
+
+    fn string(&self, level: u64, text: Text) -> u64 {
+        // Double-quoted escapes are at most `\xXX` per byte; every break in a
+        // folded or literal scalar adds a newline and indentation, and a
+        // literal block adds its `|-` header line
+        let indent = Self::indent(level);
+        4 * text.len + text.breaks * (indent + 4) + indent + 16
+    }
+}
+
+/// Walk of the value tree `hedl_json` and `hedl_yaml` build from a document.
+///
+/// Where the two differ (child-node keys, the `__type__` of first-level
+/// children, `__count_hint__`), the longer variant is charged.
+#[cfg(any(feature = "json", feature = "yaml"))]
+struct TreeBound<'a, L> {
+    doc: &'a Document,
+    layout: L,
+    metadata: bool,
+}
+
+#[cfg(any(feature = "json", feature = "yaml"))]
+impl<'a, L: TreeLayout> TreeBound<'a, L> {
+    fn new(doc: &'a Document, layout: L, metadata: bool) -> Self {
+        TreeBound {
+            doc,
+            layout,
+            metadata,
+        }
+    }
+
+    fn document(&self) -> u64 {
+        self.mapping(&self.doc.root, 0)
+    }
+
+    fn mapping(&self, items: &BTreeMap<String, Item>, level: u64) -> u64 {
+        let entries: u64 = items
+            .iter()
+            .map(|(key, item)| {
+                self.layout.member(level + 1, Text::of(key)) + self.item(item, level + 1)
+            })
+            .sum();
+        self.layout.container(level) + entries
+    }
+
+    fn item(&self, item: &Item, level: u64) -> u64 {
+        match item {
+            Item::Scalar(value) => self.value(value, level),
+            Item::Object(fields) => self.mapping(fields, level),
+            Item::List(list) => self.list(list, level),
+        }
+    }
+
+    fn value(&self, value: &Value, level: u64) -> u64 {
+        match value {
+            Value::Null | Value::Bool(_) => WORD_LEN,
+            Value::Int(_) => INT_LEN,
+            Value::Float(f) => float_len(*f),
+            Value::String(s) => self.layout.string(level, Text::of(s)),
+            Value::Tensor(t) => self.tensor(t, level),
+            // {"@ref": "@Type:id"}
+            Value::Reference(r) => {
+                let breaks =
+                    Text::of(r.type_name.as_deref().unwrap_or("")).breaks + Text::of(&r.id).breaks;
+                let target = Text {
+                    len: ref_len(r),
+                    breaks,
+                };
+                self.layout.container(level)
+                    + self.layout.member(level + 1, Text::of("@ref"))
+                    + self.layout.string(level + 1, target)
+            }
+            Value::Expression(e) => self.layout.string(level, Text::opaque(expr_len(e))),
+        }
+    }
+
+    fn tensor(&self, tensor: &Tensor, level: u64) -> u64 {
+        match tensor {
+            Tensor::Scalar(f) => float_len(*f),
+            Tensor::Array(items) => {
+                let elements: u64 = items
+                    .iter()
+                    .map(|t| self.layout.element(level + 1) + self.tensor(t, level + 1))
+                    .sum();
+                self.layout.container(level) + elements
+            }
+        }
+    }
+
+    fn list(&self, list: &MatrixList, level: u64) -> u64 {
+        if !self.metadata {
+            return self.rows(list, level);
+        }
+        // {"__type__", "__schema__", "items", "__count_hint__"}
+        let inner = level + 1;
+        let schema: u64 = list
+            .schema
+            .iter()
+            .map(|c| self.layout.element(inner + 1) + self.layout.string(inner + 1, Text::of(c)))
+            .sum();
+        self.layout.container(level)
+            + self.layout.member(inner, Text::of("__type__"))
+            + self.layout.string(inner, Text::of(&list.type_name))
+            + self.layout.member(inner, Text::of("__schema__"))
+            + self.layout.container(inner)
+            + schema
+            + self.layout.member(inner, Text::of("__count_hint__"))
+            + INT_LEN
+            + self.layout.member(inner, Text::of("items"))
+            + self.rows(list, inner)
+    }
+
+    fn rows(&self, list: &MatrixList, level: u64) -> u64 {
+        let rows: u64 = list
+            .rows
+            .iter()
+            .map(|row| self.layout.element(level + 1) + self.row(row, list, level + 1))
+            .sum();
+        self.layout.container(level) + rows
+    }
+
+    fn row(&self, row: &Node, list: &MatrixList, level: u64) -> u64 {
+        let fields: u64 = list
+            .schema
+            .iter()
+            .zip(&row.fields)
+            .map(|(column, value)| {
+                self.layout.member(level + 1, Text::of(column)) + self.value(value, level + 1)
+            })
+            .sum();
+        self.layout.container(level)
+            + fields
+            + self.type_tag(&list.type_name, &list.type_name, level + 1)
+            + self.children(row, &list.type_name, level)
+    }
+
+    /// The `__type__` entry, charged at the longer of the names it may carry.
+    fn type_tag(&self, name: &str, alt: &str, level: u64) -> u64 {
+        if !self.metadata {
+            return 0;
+        }
+        let longer = if alt.len() > name.len() { alt } else { name };
+        self.layout.member(level, Text::of("__type__"))
+            + self.layout.string(level, Text::of(longer))
+    }
+
+    /// Child groups of a node object at `level`, one array-valued entry each.
+    fn children(&self, node: &Node, list_type: &str, level: u64) -> u64 {
+        let member = level + 1;
+        node.children
+            .iter()
+            .map(|(child_type, nodes)| {
+                let items: u64 = nodes
+                    .iter()
+                    .map(|child| {
+                        self.layout.element(member + 1)
+                            + self.child(child, child_type, list_type, member + 1)
+                    })
+                    .sum();
+                self.layout.member(member, Text::of(child_type))
+                    + self.layout.container(member)
+                    + items
+            })
+            .sum()
+    }
+
+    /// A child node: schema keys if the type has a `%STRUCT`, else `id` and `field_N`.
+    fn child(&self, node: &Node, child_type: &str, list_type: &str, level: u64) -> u64 {
+        let member = level + 1;
+        let schema = self.doc.get_schema(child_type);
+        let fields: u64 = node
+            .fields
+            .iter()
+            .enumerate()
+            .map(|(i, value)| {
+                let positional = Text {
+                    len: 6 + decimal_len(i),
+                    breaks: 0,
+                };
+                let named = schema
+                    .and_then(|s| s.get(i))
+                    .map_or(0, |c| self.layout.member(member, Text::of(c)));
+                named.max(self.layout.member(member, positional)) + self.value(value, member)
+            })
+            .sum();
+        self.layout.container(level)
+            + self.layout.member(member, Text::of("id"))
+            + self.layout.string(member, Text::of(&node.id))
+            + fields
+            + self.type_tag(child_type, list_type, member)
+            + self.children(node, list_type, level)
+    }
+}
+
+// =============================================================================
+// XML
+// =============================================================================
+
+/// `<?xml version="1.0" encoding="UTF-8"?>`.
+#[cfg(feature = "xml")]
+const XML_DECL_LEN: u64 = 38;
+
+/// ` __hedl_type__="ref"` on reference elements.
+#[cfg(feature = "xml")]
+const XML_REF_ATTR_LEN: u64 = 20;
+
+/// ` __hedl_child__="true"` on child-node elements.
+#[cfg(feature = "xml")]
+const XML_CHILD_ATTR_LEN: u64 = 22;
+
+/// `quick_xml` with two-space indentation under a `<hedl>` root.
+#[cfg(feature = "xml")]
+fn xml_bound(doc: &Document) -> u64 {
+    let items: u64 = doc.root.iter().map(|(k, item)| xml_item(k, item, 1)).sum();
+    XML_DECL_LEN + xml_element(0, 4) + items
+}
+
+/// Open and close tags, each after a newline and indentation.
+#[cfg(feature = "xml")]
+fn xml_element(depth: u64, name_len: u64) -> u64 {
+    7 + 4 * depth + 2 * name_len
+}
+
+#[cfg(feature = "xml")]
+fn xml_item(key: &str, item: &Item, depth: u64) -> u64 {
+    match item {
+        Item::Scalar(value) => xml_scalar(len(key), value, depth),
+        Item::Object(fields) => {
+            let children: u64 = fields.iter().map(|(k, v)| xml_item(k, v, depth + 1)).sum();
+            xml_element(depth, len(key)) + children
+        }
+        Item::List(list) => {
+            // Rows are named after the lowercased type, which can grow 3x
+            let row_name = 3 * len(&list.type_name);
+            let rows: u64 = list
+                .rows
+                .iter()
+                .map(|row| {
+                    let fields: u64 = list
+                        .schema
+                        .iter()
+                        .zip(&row.fields)
+                        .map(|(column, value)| xml_scalar(len(column), value, depth + 2))
+                        .sum();
+                    xml_element(depth + 1, row_name) + fields + xml_children(row, depth + 2)
+                })
+                .sum();
+            xml_element(depth, len(key)) + rows
+        }
+    }
+}
+
+/// Child nodes carry only their `id` field.
+#[cfg(feature = "xml")]
+fn xml_children(node: &Node, depth: u64) -> u64 {
+    node.children
+        .iter()
+        .flat_map(|(child_type, nodes)| nodes.iter().map(move |n| (child_type, n)))
+        .map(|(child_type, child)| {
+            let id: u64 = child
+                .fields
+                .iter()
+                .take(1)
+                .map(|v| xml_scalar(2, v, depth + 1))
+                .sum();
+            xml_element(depth, len(child_type))
+                + XML_CHILD_ATTR_LEN
+                + id
+                + xml_children(child, depth + 1)
+        })
+        .sum()
+}
+
+#[cfg(feature = "xml")]
+fn xml_scalar(name_len: u64, value: &Value, depth: u64) -> u64 {
+    let text = match value {
+        Value::Null => 0,
+        Value::Bool(_) => WORD_LEN,
+        Value::Int(_) => INT_LEN,
+        Value::Float(f) => float_len(*f),
+        Value::String(s) => 6 * len(s),
+        Value::Tensor(t) => xml_tensor(t, depth + 1),
+        Value::Reference(r) => XML_REF_ATTR_LEN + 6 * ref_len(r),
+        Value::Expression(e) => 6 * expr_len(e),
+    };
+    xml_element(depth, name_len) + text
+}
+
+/// Tensors nest as `<item>` elements.
+#[cfg(feature = "xml")]
+fn xml_tensor(tensor: &Tensor, depth: u64) -> u64 {
+    match tensor {
+        Tensor::Scalar(f) => float_len(*f),
+        Tensor::Array(items) => items
+            .iter()
+            .map(|t| xml_element(depth, 4) + xml_tensor(t, depth + 1))
+            .sum(),
+    }
+}
+
+// =============================================================================
+// CSV
+// =============================================================================
+
+/// Header and records of the first top-level list, in the `csv` crate's
+/// minimal quoting.
+#[cfg(feature = "csv")]
+fn csv_bound(doc: &Document) -> u64 {
+    let Some(list) = doc.root.values().find_map(Item::as_list) else {
+        return 0;
+    };
+    // Quoted with every quote doubled, plus the delimiter; CRLF per record
+    let field = |n: u64| 2 * n + 3;
+    let header: u64 = list.schema.iter().map(|c| field(len(c))).sum::<u64>() + 2;
+    let records: u64 = list
+        .rows
+        .iter()
+        .map(|row| row.fields.iter().map(|v| field(csv_value(v))).sum::<u64>() + 2)
+        .sum();
+    header + records
+}
+
+#[cfg(feature = "csv")]
+fn csv_value(value: &Value) -> u64 {
+    match value {
+        Value::Null => 0,
+        Value::Bool(_) => WORD_LEN,
+        Value::Int(_) => INT_LEN,
+        Value::Float(f) => float_len(*f),
+        Value::String(s) => len(s),
+        Value::Tensor(t) => tensor_len(t, 1),
+        Value::Reference(r) => ref_len(r),
+        Value::Expression(e) => expr_len(e),
+    }
+}
+
+// =============================================================================
+// Cypher
+// =============================================================================
+
+#[cfg(feature = "neo4j")]
+mod cypher {
+    //! Constraints, batched `UNWIND` node statements and batched relationship
+    //! statements, as `hedl_neo4j::to_cypher_stream` emits them with
+    //! `ToCypherConfig::default()`. The `MERGE` flag only swaps a keyword, and
+    //! the fixed allowances charge the longer `CREATE`.
+
+    use super::{expr_len, float_len, len, tensor_len, INT_LEN, WORD_LEN};
+    use hedl_core::{Document, Item, Node, Value};
+    use hedl_neo4j::cypher::to_relationship_type;
+    use hedl_neo4j::ToCypherConfig;
+    use std::collections::{BTreeMap, BTreeSet};
+
+    /// Separator, comment and keywords of a constraint statement.
+    const CONSTRAINT_FIXED: u64 = 96;
+
+    /// Separator, comment, keywords and `[]` of a node statement.
+    const NODE_STATEMENT_FIXED: u64 = 96;
+
+    /// Separator, comment, keywords and `[]` of a relationship statement.
+    const REL_STATEMENT_FIXED: u64 = 160;
+
+    /// `\nSET rel._nest_key = row._nest_key, rel._nest_order = row._nest_order`.
+    const NEST_SET_LEN: u64 = 80;
+
+    /// The unresolved-reference warning comment.
+    const WARNING_LEN: u64 = 128;
+
+    /// `{from_id: '', from_label: '', to_id: '', to_label: ''}` and its `, `.
+    const REL_ROW_FIXED: u64 = 58;
+
+    /// `, _nest_key: '', _nest_order: N` on NEST relationships.
+    const NEST_ROW_FIXED: u64 = 32 + INT_LEN;
+
+    /// `escape_identifier`: NFC can triple the bytes, then backticks wrap it.
+    fn ident(n: u64) -> u64 {
+        3 * n + 2
+    }
+
+    /// `escape_label`: an identifier after `:`.
+    fn label(n: u64) -> u64 {
+        ident(n) + 1
+    }
+
+    /// `quote_string`: `\u0000` is the longest escape.
+    fn quoted(n: u64) -> u64 {
+        2 + 6 * n
+    }
+
+    /// `$` bytes in a name; each could start a `$rows` that inlining also replaces.
+    fn dollars(s: &str) -> u64 {
+        s.bytes().filter(|&b| b == b'$').count() as u64
+    }
+
+    /// Statements needed for `count` rows (`u64::div_ceil` is past the MSRV).
+    fn batches(count: u64, batch: u64) -> u64 {
+        (count + batch - 1) / batch
+    }
+
+    fn literal(value: &Value) -> u64 {
+        match value {
+            Value::Null | Value::Bool(_) => WORD_LEN,
+            Value::Int(_) => INT_LEN,
+            Value::Float(f) => float_len(*f),
+            Value::String(s) => quoted(len(s)),
+            // Compact JSON of numbers needs no escaping
+            Value::Tensor(t) => 2 + tensor_len(t, 1),
+            Value::Expression(e) => quoted(expr_len(e)),
+            // Becomes a relationship instead of a property
+            Value::Reference(_) => 0,
+        }
+    }
+
+    /// Nodes sharing one run of `UNWIND` statements.
+    #[derive(Default)]
+    struct NodeGroup {
+        count: u64,
+        /// Longest label and comment key.
+        label: u64,
+        key: u64,
+        /// Row maps plus separators, over all nodes.
+        rows: u64,
+        /// Longest `SET` clause and its `$` count, over possible first nodes.
+        set: u64,
+        dollars: u64,
+    }
+
+    impl NodeGroup {
+        fn add(&mut self, node: &Node, names: &dyn Fn(usize) -> Option<(u64, u64)>, id: u64) {
+            // {_hedl_id: 'id', name: value, ...}
+            let mut map = 2 + id + 4 + quoted(len(&node.id));
+            let mut set = 5;
+            let mut set_dollars = dollars(&node.type_name);
+            for (i, value) in node.fields.iter().enumerate().skip(1) {
+                if matches!(value, Value::Reference(_)) {
+                    continue;
+                }
+                if let Some((name, name_dollars)) = names(i) {
+                    map += ident(name) + 4 + literal(value);
+                    // n.name = row.name,
+                    set += 2 * ident(name) + 12;
+                    set_dollars += 2 * name_dollars;
+                }
+            }
+            self.count += 1;
+            self.label = self.label.max(len(&node.type_name));
+            self.rows += map + 2;
+            self.set = self.set.max(set);
+            self.dollars = self.dollars.max(set_dollars);
+        }
+
+        fn bound(&self, batch: u64, id: u64) -> u64 {
+            if self.count == 0 {
+                return 0;
+            }
+            let statements = batches(self.count, batch);
+            let statement = NODE_STATEMENT_FIXED
+                + self.label
+                + label(self.label)
+                + self.key
+                + 2 * id
+                + self.set;
+            statements * statement + (1 + self.dollars) * self.rows
+        }
+    }
+
+    /// Relationships of one type, batched and then split by label pair.
+    #[derive(Default)]
+    struct RelGroup<'a> {
+        count: u64,
+        rows: u64,
+        pairs: BTreeSet<(&'a str, &'a str)>,
+        label: u64,
+        dollars: u64,
+        nest: bool,
+    }
+
+    impl<'a> RelGroup<'a> {
+        fn add(&mut self, from: (&'a str, &str), to: (&'a str, &str), nest_key: Option<&str>) {
+            self.count += 1;
+            self.rows += REL_ROW_FIXED
+                + quoted(len(from.0))
+                + quoted(len(from.1))
+                + quoted(len(to.0))
+                + quoted(len(to.1))
+                + nest_key.map_or(0, |k| NEST_ROW_FIXED + quoted(len(k)));
+            self.pairs.insert((from.0, to.0));
+            self.label = self.label.max(len(from.0)).max(len(to.0));
+            self.dollars = self.dollars.max(dollars(from.0) + dollars(to.0));
+            self.nest |= nest_key.is_some();
+        }
+
+        /// Each batch is written once per label pair in it, each time with all its rows.
+        fn bound(&self, rel_type: &str, batch: u64, id: u64) -> u64 {
+            let pairs = self.pairs.len() as u64;
+            let statements = self.count.min(batches(self.count, batch) * pairs);
+            let statement = REL_STATEMENT_FIXED
+                + len(rel_type)
+                + ident(len(rel_type))
+                + 2 * (self.label + label(self.label))
+                + 2 * id
+                + if self.nest { NEST_SET_LEN } else { 0 };
+            let copies = batch.min(pairs) * (1 + self.dollars + dollars(rel_type));
+            statements * statement + copies * self.rows
+        }
+    }
+
+    /// Everything one walk over the top-level lists collects.
+    struct Walk<'a> {
+        doc: &'a Document,
+        id: u64,
+        types: BTreeSet<&'a str>,
+        children: BTreeMap<&'a str, NodeGroup>,
+        rels: BTreeMap<String, RelGroup<'a>>,
+    }
+
+    impl<'a> Walk<'a> {
+        fn rel(&mut self, rel_type: String) -> &mut RelGroup<'a> {
+            self.rels.entry(rel_type).or_default()
+        }
+
+        /// Children of `node`: their node groups, references and NEST edges.
+        fn children(&mut self, node: &'a Node) {
+            let nested = self.doc.nests.get(&node.type_name);
+            for (child_key, children) in &node.children {
+                for child in children {
+                    self.types.insert(&child.type_name);
+                    let schema = self.doc.structs.get(&child.type_name);
+                    let names = |i: usize| match schema {
+                        Some(columns) => columns.get(i).map(|c| (len(c), dollars(c))),
+                        None => Some((6 + super::decimal_len(i), 0)),
+                    };
+                    let group = self.children.entry(&child.type_name).or_default();
+                    group.add(child, &names, self.id);
+                    group.key = group.key.max(3 * len(&child.type_name));
+
+                    for (i, field) in child.fields.iter().enumerate() {
+                        if let Value::Reference(r) = field {
+                            let rel_type = to_relationship_type(&format!("{}_{}", child_key, i));
+                            let target = r.type_name.as_deref().unwrap_or(&child.type_name);
+                            let from = (child.type_name.as_str(), child.id.as_str());
+                            self.rel(rel_type).add(from, (target, &r.id), None);
+                        }
+                    }
+
+                    if nested == Some(&child.type_name) {
+                        let rel_type = format!("HAS_{}", child.type_name.to_uppercase());
+                        let from = (node.type_name.as_str(), node.id.as_str());
+                        let to = (child.type_name.as_str(), child.id.as_str());
+                        self.rel(rel_type).add(from, to, Some(child_key));
+                    }
+
+                    self.children(child);
+                }
+            }
+        }
+    }
+
+    pub(super) fn bound(doc: &Document) -> u64 {
+        let config = ToCypherConfig::default();
+        let batch = config.batch_size.max(1) as u64;
+        let id_raw = len(&config.id_property);
+        let id = ident(id_raw);
+        let mut walk = Walk {
+            doc,
+            id,
+            types: BTreeSet::new(),
+            children: BTreeMap::new(),
+            rels: BTreeMap::new(),
+        };
+
+        let mut total = WARNING_LEN;
+        for (key, item) in &doc.root {
+            let Item::List(list) = item else { continue };
+            walk.types.insert(&list.type_name);
+            let names = |i: usize| list.schema.get(i).map(|c| (len(c), dollars(c)));
+            let mut rows = NodeGroup {
+                key: len(key),
+                ..NodeGroup::default()
+            };
+            for row in &list.rows {
+                rows.add(row, &names, id);
+                for (i, field) in row.fields.iter().enumerate() {
+                    if let Value::Reference(r) = field {
+                        let column = list.schema.get(i).map_or("", String::as_str);
+                        let target = r.type_name.as_deref().unwrap_or(&list.type_name);
+                        let from = (list.type_name.as_str(), row.id.as_str());
+                        walk.rel(to_relationship_type(column))
+                            .add(from, (target, &r.id), None);
+                    }
+                }
+                walk.children(row);
+            }
+            total += rows.bound(batch, id);
+            // Child nodes are batched per top-level list
+            total += walk
+                .children
+                .values()
+                .map(|g| g.bound(batch, id))
+                .sum::<u64>();
+            walk.children.clear();
+        }
+
+        // CREATE CONSTRAINT <lower(T)_id> IF NOT EXISTS FOR (n:T) REQUIRE n.id IS UNIQUE
+        total += walk
+            .types
+            .iter()
+            .map(|t| {
+                CONSTRAINT_FIXED + len(t) + ident(3 * len(t) + 1 + id_raw) + label(len(t)) + id
+            })
+            .sum::<u64>();
+        total += walk
+            .rels
+            .iter()
+            .map(|(rel_type, group)| group.bound(rel_type, batch, id))
+            .sum::<u64>();
+        total
+    }
+}
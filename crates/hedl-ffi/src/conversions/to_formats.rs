@@ -17,19 +17,19 @@
 
 //! Export functions (to_*) for FFI.
 
-use crate::audit::{
-    audit_call_failure, audit_call_start, audit_call_success, sanitize_pointer,
-};
+use crate::audit::{audit_call_failure, audit_call_success, sanitize_pointer, AuditTimer};
+use crate::audit_start;
 use crate::error::{clear_error, set_error};
 use crate::memory::is_valid_document_ptr;
 use crate::types::{
     HedlDocument, HEDL_ERR_CSV, HEDL_ERR_JSON, HEDL_ERR_NEO4J, HEDL_ERR_NULL_PTR,
     HEDL_ERR_PARQUET, HEDL_ERR_XML, HEDL_ERR_YAML, HEDL_OK,
 };
+#[cfg(feature = "neo4j")]
+use super::to_formats_callback::write_neo4j_batches;
 use crate::utils::allocate_output_string;
 use std::os::raw::{c_char, c_int};
 use std::ptr;
-use std::time::Instant;
 
 // =============================================================================
 // JSON Conversion (requires "json" feature)
@@ -57,15 +57,13 @@ pub unsafe extern "C" fn hedl_to_json(
     include_metadata: c_int,
     out_str: *mut *mut c_char,
 ) -> c_int {
-    let start = Instant::now();
+    let start = AuditTimer::start();
 
-    audit_call_start(
+    audit_start!(
         "hedl_to_json",
-        &[
-            ("doc", &sanitize_pointer(doc)),
-            ("include_metadata", &include_metadata.to_string()),
-            ("out_str", &sanitize_pointer(out_str)),
-        ],
+        "doc" => sanitize_pointer(doc),
+        "include_metadata" => include_metadata.to_string(),
+        "out_str" => sanitize_pointer(out_str),
     );
 
     clear_error();
@@ -85,7 +83,7 @@ pub unsafe extern "C" fn hedl_to_json(
 
     match hedl_json::to_json(doc_ref, &config) {
         Ok(json) => {
-            let result = allocate_output_string(&json, out_str, HEDL_ERR_JSON);
+            let result = allocate_output_string(json, out_str, HEDL_ERR_JSON);
             if result == HEDL_OK {
                 audit_call_success("hedl_to_json", start.elapsed());
             } else {
@@ -132,15 +130,13 @@ pub unsafe extern "C" fn hedl_to_yaml(
     include_metadata: c_int,
     out_str: *mut *mut c_char,
 ) -> c_int {
-    let start = Instant::now();
+    let start = AuditTimer::start();
 
-    audit_call_start(
+    audit_start!(
         "hedl_to_yaml",
-        &[
-            ("doc", &sanitize_pointer(doc)),
-            ("include_metadata", &include_metadata.to_string()),
-            ("out_str", &sanitize_pointer(out_str)),
-        ],
+        "doc" => sanitize_pointer(doc),
+        "include_metadata" => include_metadata.to_string(),
+        "out_str" => sanitize_pointer(out_str),
     );
 
     clear_error();
@@ -160,7 +156,7 @@ pub unsafe extern "C" fn hedl_to_yaml(
 
     match hedl_yaml::to_yaml(doc_ref, &config) {
         Ok(yaml) => {
-            let result = allocate_output_string(&yaml, out_str, HEDL_ERR_YAML);
+            let result = allocate_output_string(yaml, out_str, HEDL_ERR_YAML);
             if result == HEDL_OK {
                 audit_call_success("hedl_to_yaml", start.elapsed());
             } else {
@@ -202,14 +198,12 @@ pub unsafe extern "C" fn hedl_to_yaml(
 #[cfg(feature = "xml")]
 #[no_mangle]
 pub unsafe extern "C" fn hedl_to_xml(doc: *const HedlDocument, out_str: *mut *mut c_char) -> c_int {
-    let start = Instant::now();
+    let start = AuditTimer::start();
 
-    audit_call_start(
+    audit_start!(
         "hedl_to_xml",
-        &[
-            ("doc", &sanitize_pointer(doc)),
-            ("out_str", &sanitize_pointer(out_str)),
-        ],
+        "doc" => sanitize_pointer(doc),
+        "out_str" => sanitize_pointer(out_str),
     );
 
     clear_error();
@@ -225,7 +219,7 @@ pub unsafe extern "C" fn hedl_to_xml(doc: *const HedlDocument, out_str: *mut *mu
 
     match hedl_xml::hedl_to_xml(doc_ref) {
         Ok(xml) => {
-            let result = allocate_output_string(&xml, out_str, HEDL_ERR_XML);
+            let result = allocate_output_string(xml, out_str, HEDL_ERR_XML);
             if result == HEDL_OK {
                 audit_call_success("hedl_to_xml", start.elapsed());
             } else {
@@ -269,14 +263,12 @@ pub unsafe extern "C" fn hedl_to_xml(doc: *const HedlDocument, out_str: *mut *mu
 #[cfg(feature = "csv")]
 #[no_mangle]
 pub unsafe extern "C" fn hedl_to_csv(doc: *const HedlDocument, out_str: *mut *mut c_char) -> c_int {
-    let start = Instant::now();
+    let start = AuditTimer::start();
 
-    audit_call_start(
+    audit_start!(
         "hedl_to_csv",
-        &[
-            ("doc", &sanitize_pointer(doc)),
-            ("out_str", &sanitize_pointer(out_str)),
-        ],
+        "doc" => sanitize_pointer(doc),
+        "out_str" => sanitize_pointer(out_str),
     );
 
     clear_error();
@@ -292,7 +284,7 @@ pub unsafe extern "C" fn hedl_to_csv(doc: *const HedlDocument, out_str: *mut *mu
 
     match hedl_csv::to_csv(doc_ref) {
         Ok(csv) => {
-            let result = allocate_output_string(&csv, out_str, HEDL_ERR_CSV);
+            let result = allocate_output_string(csv, out_str, HEDL_ERR_CSV);
             if result == HEDL_OK {
                 audit_call_success("hedl_to_csv", start.elapsed());
             } else {
@@ -342,15 +334,13 @@ pub unsafe extern "C" fn hedl_to_parquet(
     out_data: *mut *mut u8,
     out_len: *mut usize,
 ) -> c_int {
-    let start = Instant::now();
+    let start = AuditTimer::start();
 
-    audit_call_start(
+    audit_start!(
         "hedl_to_parquet",
-        &[
-            ("doc", &sanitize_pointer(doc)),
-            ("out_data", &sanitize_pointer(out_data)),
-            ("out_len", &sanitize_pointer(out_len)),
-        ],
+        "doc" => sanitize_pointer(doc),
+        "out_data" => sanitize_pointer(out_data),
+        "out_len" => sanitize_pointer(out_len),
     );
 
     clear_error();
@@ -370,6 +360,7 @@ pub unsafe extern "C" fn hedl_to_parquet(
             let ptr = Box::into_raw(bytes.into_boxed_slice()) as *mut u8;
             *out_data = ptr;
             *out_len = len;
+            crate::metrics::note_output(len);
             audit_call_success("hedl_to_parquet", start.elapsed());
             HEDL_OK
         }
@@ -385,6 +376,93 @@ pub unsafe extern "C" fn hedl_to_parquet(
     }
 }
 
+// =============================================================================
+// Arrow C Data Interface (requires "parquet" feature)
+// =============================================================================
+
+/// Export a matrix list through the Arrow C Data Interface.
+///
+/// Builds Arrow arrays directly from the rows of the matrix list of type
+/// `type_name` (searched in root items, then nested objects), using the
+/// column types `hedl_to_parquet` would write, and moves them into the
+/// caller's structures as one struct array. No Parquet encoding happens.
+///
+/// The exported structures own their buffers and are independent of `doc`;
+/// the consumer frees them by calling their `release` callbacks.
+///
+/// # Arguments
+/// * `doc` - Document handle
+/// * `type_name` - Null-terminated type name of the matrix list
+/// * `out_schema` - Uninitialized `struct ArrowSchema` to receive the schema
+/// * `out_array` - Uninitialized `struct ArrowArray` to receive the rows
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_NOT_FOUND if there is no matrix list of
+/// that type, HEDL_ERR_PARQUET if the data cannot be exported. The output
+/// structures are only written on success.
+///
+/// # Safety
+/// All pointers must be valid; `type_name` must be null-terminated.
+///
+/// # Feature
+/// Requires the "parquet" feature to be enabled.
+#[cfg(feature = "parquet")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_to_arrow(
+    doc: *const HedlDocument,
+    type_name: *const c_char,
+    out_schema: *mut hedl_parquet::FFI_ArrowSchema,
+    out_array: *mut hedl_parquet::FFI_ArrowArray,
+) -> c_int {
+    use crate::types::HEDL_ERR_NOT_FOUND;
+    use crate::utils::borrow_c_str;
+    use hedl_core::HedlErrorKind;
+
+    const FN_NAME: &str = "hedl_to_arrow";
+
+    let start = AuditTimer::start();
+    audit_start!(
+        FN_NAME,
+        "doc" => sanitize_pointer(doc),
+        "type_name" => sanitize_pointer(type_name),
+    );
+
+    clear_error();
+
+    let fail = |code: c_int, msg: String| {
+        set_error(&msg);
+        audit_call_failure(FN_NAME, code, &msg, start.elapsed());
+        code
+    };
+
+    if !is_valid_document_ptr(doc)
+        || type_name.is_null()
+        || out_schema.is_null()
+        || out_array.is_null()
+    {
+        return fail(HEDL_ERR_NULL_PTR, "Null pointer argument".to_string());
+    }
+
+    let type_name = match borrow_c_str(type_name) {
+        Ok(t) => t,
+        Err((code, msg)) => return fail(code, msg),
+    };
+
+    match hedl_parquet::to_arrow_c(&(*doc).inner, type_name) {
+        Ok((array, schema)) => {
+            // The caller's structures are uninitialized: write, don't drop
+            ptr::write(out_schema, schema);
+            ptr::write(out_array, array);
+            audit_call_success(FN_NAME, start.elapsed());
+            HEDL_OK
+        }
+        Err(e) if matches!(e.kind, HedlErrorKind::Schema) => {
+            fail(HEDL_ERR_NOT_FOUND, format!("Arrow export error: {}", e))
+        }
+        Err(e) => fail(HEDL_ERR_PARQUET, format!("Arrow export error: {}", e)),
+    }
+}
+
 // =============================================================================
 // Neo4j/Cypher Conversion (requires "neo4j" feature)
 // =============================================================================
@@ -413,15 +491,13 @@ pub unsafe extern "C" fn hedl_to_neo4j_cypher(
     use_merge: c_int,
     out_str: *mut *mut c_char,
 ) -> c_int {
-    let start = Instant::now();
+    let start = AuditTimer::start();
 
-    audit_call_start(
+    audit_start!(
         "hedl_to_neo4j_cypher",
-        &[
-            ("doc", &sanitize_pointer(doc)),
-            ("use_merge", &use_merge.to_string()),
-            ("out_str", &sanitize_pointer(out_str)),
-        ],
+        "doc" => sanitize_pointer(doc),
+        "use_merge" => use_merge.to_string(),
+        "out_str" => sanitize_pointer(out_str),
     );
 
     clear_error();
@@ -442,7 +518,7 @@ pub unsafe extern "C" fn hedl_to_neo4j_cypher(
 
     match hedl_neo4j::to_cypher(doc_ref, &config) {
         Ok(cypher) => {
-            let result = allocate_output_string(&cypher.to_string(), out_str, HEDL_ERR_NEO4J);
+            let result = allocate_output_string(cypher, out_str, HEDL_ERR_NEO4J);
             if result == HEDL_OK {
                 audit_call_success("hedl_to_neo4j_cypher", start.elapsed());
             } else {
@@ -462,3 +538,80 @@ pub unsafe extern "C" fn hedl_to_neo4j_cypher(
         }
     }
 }
+
+/// Convert a HEDL document to parameterized Cypher batches for bulk import.
+///
+/// The output is one JSON object per line, `{"statement": "...", "parameters": {...}}`,
+/// in the same order as [`hedl_to_neo4j_cypher`]. Node and relationship rows are carried
+/// in `parameters.rows` of `UNWIND $rows AS row` statements instead of being inlined, so
+/// Neo4j plans each statement text once and reuses the plan for every batch.
+///
+/// # Arguments
+/// * `doc` - Document handle from hedl_parse
+/// * `use_merge` - Non-zero to use MERGE (idempotent), zero for CREATE
+/// * `batch_size` - Maximum rows per `UNWIND` statement (0 for the default of 1000)
+/// * `out_str` - Pointer to store the JSON lines (must be freed with hedl_free_string)
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure.
+///
+/// # Safety
+/// All pointers must be valid.
+///
+/// # Feature
+/// Requires the "neo4j" feature to be enabled.
+#[cfg(feature = "neo4j")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_to_neo4j_batches(
+    doc: *const HedlDocument,
+    use_merge: c_int,
+    batch_size: usize,
+    out_str: *mut *mut c_char,
+) -> c_int {
+    let start = AuditTimer::start();
+
+    audit_start!(
+        "hedl_to_neo4j_batches",
+        "doc" => sanitize_pointer(doc),
+        "use_merge" => use_merge.to_string(),
+        "batch_size" => batch_size.to_string(),
+        "out_str" => sanitize_pointer(out_str),
+    );
+
+    clear_error();
+
+    if !is_valid_document_ptr(doc) || out_str.is_null() {
+        let duration = start.elapsed();
+        set_error("Null pointer argument");
+        audit_call_failure("hedl_to_neo4j_batches", HEDL_ERR_NULL_PTR, "Null pointer argument", duration);
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    let mut payload = Vec::new();
+    let written = write_neo4j_batches(&(*doc).inner, use_merge, batch_size, &mut payload)
+        .and_then(|()| {
+            String::from_utf8(payload)
+                .map_err(|e| (HEDL_ERR_NEO4J, format!("Neo4j conversion error: {}", e)))
+        });
+
+    match written {
+        Ok(lines) => {
+            let result = allocate_output_string(lines, out_str, HEDL_ERR_NEO4J);
+            if result == HEDL_OK {
+                audit_call_success("hedl_to_neo4j_batches", start.elapsed());
+            } else {
+                let duration = start.elapsed();
+                let msg = crate::error::get_thread_local_error();
+                audit_call_failure("hedl_to_neo4j_batches", result, &msg, duration);
+            }
+            result
+        }
+        Err((code, msg)) => {
+            let duration = start.elapsed();
+            set_error(&msg);
+            *out_str = ptr::null_mut();
+            audit_call_failure("hedl_to_neo4j_batches", code, &msg, duration);
+            code
+        }
+    }
+}
@@ -15,11 +15,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-//! Zero-copy export functions using callback pattern for large outputs.
+//! Streaming export functions using the callback pattern for large outputs.
 //!
-//! These functions avoid allocating memory for large string outputs (>1MB)
-//! by using a callback mechanism that allows the caller to process the data
-//! in-place without copying.
+//! These functions never materialize the full serialized output. Each
+//! serializer writes into a bounded buffer that is handed to the callback
+//! every time it fills up, so peak memory for the output side stays at one
+//! chunk regardless of document size.
 //!
 //! # Callback Pattern
 //!
@@ -29,10 +30,22 @@
 //! ```
 //!
 //! The callback receives:
-//! - `data`: Pointer to the output data (valid only during the callback)
-//! - `len`: Length of the data in bytes
+//! - `data`: Pointer to the next chunk of output (valid only during the callback)
+//! - `len`: Length of the chunk in bytes (at most the chunk size)
 //! - `user_data`: User-provided context pointer
 //!
+//! The callback is invoked one or more times, in output order (an empty
+//! output is delivered as a single zero-length call). Concatenating
+//! all chunks yields exactly the output of the non-callback variant. Chunk
+//! boundaries are byte offsets: a multi-byte UTF-8 sequence may be split
+//! across two calls.
+//!
+//! # Chunk Size
+//!
+//! The `hedl_*_callback` functions use [`HEDL_DEFAULT_CHUNK_SIZE`]. The
+//! `hedl_*_callback_chunked` variants take the chunk size explicitly; passing
+//! 0 selects the default.
+//!
 //! # Memory Management
 //!
 //! **CRITICAL**: The data pointer is only valid during the callback execution.
@@ -47,17 +60,27 @@
 //!     fwrite(data, 1, len, f);
 //! }
 //!
-//! FILE* output = fopen("output.json", "w");
-//! int result = hedl_to_json_callback(doc, 0, my_callback, output);
+//! FILE* output = fopen("output.csv", "w");
+//! int result = hedl_to_csv_callback_chunked(doc, 1 << 20, my_callback, output);
 //! fclose(output);
 //! ```
 
 use crate::error::{clear_error, set_error};
 use crate::memory::is_valid_document_ptr;
-use crate::types::{
-    HedlDocument, HEDL_ERR_CSV, HEDL_ERR_JSON, HEDL_ERR_NEO4J, HEDL_ERR_NULL_PTR, HEDL_ERR_XML,
-    HEDL_ERR_YAML, HEDL_OK,
-};
+use crate::metrics::note_output;
+use crate::types::{HedlDocument, HEDL_ERR_NULL_PTR, HEDL_OK};
+#[cfg(feature = "csv")]
+use crate::types::HEDL_ERR_CSV;
+#[cfg(feature = "json")]
+use crate::types::HEDL_ERR_JSON;
+#[cfg(feature = "neo4j")]
+use crate::types::HEDL_ERR_NEO4J;
+#[cfg(feature = "xml")]
+use crate::types::HEDL_ERR_XML;
+#[cfg(feature = "yaml")]
+use crate::types::HEDL_ERR_YAML;
+use hedl_core::Document;
+use std::io;
 use std::os::raw::{c_char, c_int, c_void};
 
 // =============================================================================
@@ -73,30 +96,284 @@ use std::os::raw::{c_char, c_int, c_void};
 /// - The callback MUST NOT call back into HEDL functions
 pub type HedlOutputCallback = unsafe extern "C" fn(data: *const c_char, len: usize, user_data: *mut c_void);
 
+/// Chunk size used by the `hedl_*_callback` functions (64 KiB).
+pub const HEDL_DEFAULT_CHUNK_SIZE: usize = 64 * 1024;
+
 // =============================================================================
-// Helper Functions
+// Chunked Callback Writer
 // =============================================================================
 
-/// Helper to invoke callback with output data
-#[inline]
-unsafe fn invoke_callback(
-    output: &str,
+/// `io::Write` adapter that forwards output to a C callback in fixed-size chunks.
+///
+/// Every callback invocation except the last carries exactly `chunk_size`
+/// bytes. Large writes are forwarded straight from the caller's slice when the
+/// internal buffer is empty, so no byte is copied more than once.
+///
+/// `flush()` is deliberately a no-op: serializers flush at arbitrary points and
+/// we do not want that to shrink chunks. Call [`CallbackWriter::finish`] to emit
+/// the trailing partial chunk.
+struct CallbackWriter {
     callback: HedlOutputCallback,
     user_data: *mut c_void,
+    buf: Vec<u8>,
+    chunk_size: usize,
+    total: usize,
+}
+
+impl CallbackWriter {
+    /// # Safety
+    /// `callback` must be safe to call with `user_data` for the writer's lifetime.
+    unsafe fn new(chunk_size: usize, callback: HedlOutputCallback, user_data: *mut c_void) -> Self {
+        let chunk_size = if chunk_size == 0 {
+            HEDL_DEFAULT_CHUNK_SIZE
+        } else {
+            chunk_size
+        };
+        Self {
+            callback,
+            user_data,
+            buf: Vec::with_capacity(chunk_size),
+            chunk_size,
+            total: 0,
+        }
+    }
+
+    fn emit(&self, chunk: &[u8]) {
+        // SAFETY: upheld by the contract of `CallbackWriter::new`; `chunk` stays
+        // alive for the duration of the call.
+        unsafe { (self.callback)(chunk.as_ptr() as *const c_char, chunk.len(), self.user_data) }
+    }
+
+    /// Emit any buffered bytes as the final (possibly short) chunk.
+    ///
+    /// The callback always fires at least once, matching the behaviour of the
+    /// original single-shot exporters for empty output.
+    fn finish(mut self) {
+        if !self.buf.is_empty() || self.total == 0 {
+            self.emit(&self.buf);
+            self.buf.clear();
+        }
+    }
+}
+
+impl io::Write for CallbackWriter {
+    fn write(&mut self, mut data: &[u8]) -> io::Result<usize> {
+        let written = data.len();
+        self.total += written;
+
+        if !self.buf.is_empty() {
+            let take = (self.chunk_size - self.buf.len()).min(data.len());
+            self.buf.extend_from_slice(&data[..take]);
+            data = &data[take..];
+            if self.buf.len() < self.chunk_size {
+                return Ok(written);
+            }
+            self.emit(&self.buf);
+            self.buf.clear();
+        }
+
+        while data.len() >= self.chunk_size {
+            let (chunk, rest) = data.split_at(self.chunk_size);
+            self.emit(chunk);
+            data = rest;
+        }
+        self.buf.extend_from_slice(data);
+
+        Ok(written)
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        Ok(())
+    }
+}
+
+/// Record the start of an exporter call.
+///
+/// `flags` are the exporter's integer options and `size` its buffer-size
+/// parameter; both are formatted only when DEBUG audits are enabled.
+pub(super) fn audit_export_start(
+    fn_name: &'static str,
+    doc: *const HedlDocument,
+    flags: &[(&str, c_int)],
+    size: (&str, usize),
 ) {
-    let data = output.as_ptr() as *const c_char;
-    let len = output.len();
-    callback(data, len, user_data);
+    use crate::audit::{audit_call_start, audit_params_enabled, sanitize_pointer};
+    if !audit_params_enabled() {
+        audit_call_start(fn_name, &[]);
+        return;
+    }
+
+    let doc_ptr_str = sanitize_pointer(doc);
+    let flag_strs: Vec<String> = flags.iter().map(|(_, value)| value.to_string()).collect();
+    let size_str = size.1.to_string();
+    let mut audit_params = Vec::with_capacity(flags.len() + 2);
+    audit_params.push(("doc_ptr", doc_ptr_str.as_str()));
+    audit_params.extend(
+        flags
+            .iter()
+            .zip(&flag_strs)
+            .map(|((key, _), value)| (*key, value.as_str())),
+    );
+    audit_params.push((size.0, size_str.as_str()));
+    audit_call_start(fn_name, &audit_params);
+}
+
+/// Shared driver for every callback exporter: audit, validate, stream, report.
+///
+/// `export` writes the serialized document into the provided sink and returns
+/// `(error_code, message)` on failure. Chunks already delivered before a
+/// failure are not retracted; the callback simply sees no further data.
+///
+/// # Safety
+/// Same requirements as the public callback functions.
+#[allow(clippy::too_many_arguments)]
+unsafe fn export_chunked<F>(
+    fn_name: &'static str,
+    doc: *const HedlDocument,
+    flags: &[(&str, c_int)],
+    chunk_size: usize,
+    callback: HedlOutputCallback,
+    user_data: *mut c_void,
+    export: F,
+) -> c_int
+where
+    F: FnOnce(&Document, &mut CallbackWriter) -> Result<(), (c_int, String)>,
+{
+    use crate::audit::{audit_call_failure, audit_call_success, AuditTimer};
+    let start = AuditTimer::start();
+    audit_export_start(fn_name, doc, flags, ("chunk_size", chunk_size));
+
+    clear_error();
+
+    if !is_valid_document_ptr(doc) {
+        set_error("Null or invalid document pointer");
+        let duration = start.elapsed();
+        audit_call_failure(fn_name, HEDL_ERR_NULL_PTR, "NULL or invalid pointer", duration);
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    let doc_ref = &(*doc).inner;
+    let mut sink = CallbackWriter::new(chunk_size, callback, user_data);
+
+    match export(doc_ref, &mut sink) {
+        Ok(()) => {
+            note_output(sink.total);
+            sink.finish();
+            audit_call_success(fn_name, start.elapsed());
+            HEDL_OK
+        }
+        Err((code, msg)) => {
+            set_error(&msg);
+            audit_call_failure(fn_name, code, &msg, start.elapsed());
+            code
+        }
+    }
+}
+
+// =============================================================================
+// Serializers
+// =============================================================================
+//
+// Format writers shared by the callback and caller-buffer (`*_into`)
+// exporters. Each maps its format error to the exporter's error code.
+
+#[cfg(feature = "json")]
+pub(crate) fn write_json<W: io::Write>(
+    doc: &Document,
+    include_metadata: c_int,
+    sink: &mut W,
+) -> Result<(), (c_int, String)> {
+    let config = hedl_json::ToJsonConfig {
+        include_metadata: include_metadata != 0,
+        ..Default::default()
+    };
+    hedl_json::to_json_writer(doc, &config, sink)
+        .map_err(|e| (HEDL_ERR_JSON, format!("JSON conversion error: {}", e)))
+}
+
+#[cfg(feature = "yaml")]
+pub(crate) fn write_yaml<W: io::Write>(
+    doc: &Document,
+    include_metadata: c_int,
+    sink: &mut W,
+) -> Result<(), (c_int, String)> {
+    let config = hedl_yaml::ToYamlConfig {
+        include_metadata: include_metadata != 0,
+        ..Default::default()
+    };
+    hedl_yaml::to_yaml_writer(doc, &config, sink)
+        .map_err(|e| (HEDL_ERR_YAML, format!("YAML conversion error: {}", e)))
+}
+
+#[cfg(feature = "xml")]
+pub(crate) fn write_xml<W: io::Write>(doc: &Document, sink: &mut W) -> Result<(), (c_int, String)> {
+    hedl_xml::to_xml_writer(doc, &hedl_xml::ToXmlConfig::default(), sink)
+        .map_err(|e| (HEDL_ERR_XML, format!("XML conversion error: {}", e)))
+}
+
+#[cfg(feature = "csv")]
+pub(crate) fn write_csv<W: io::Write>(doc: &Document, sink: &mut W) -> Result<(), (c_int, String)> {
+    hedl_csv::to_csv_writer(doc, sink)
+        .map_err(|e| (HEDL_ERR_CSV, format!("CSV conversion error: {}", e)))
+}
+
+#[cfg(feature = "neo4j")]
+pub(crate) fn write_neo4j_cypher<W: io::Write>(
+    doc: &Document,
+    use_merge: c_int,
+    sink: &mut W,
+) -> Result<(), (c_int, String)> {
+    let config = if use_merge != 0 {
+        hedl_neo4j::ToCypherConfig::default()
+    } else {
+        hedl_neo4j::ToCypherConfig::new().with_create()
+    };
+    hedl_neo4j::to_cypher_stream(doc, &config, sink)
+        .map_err(|e| (HEDL_ERR_NEO4J, format!("Neo4j conversion error: {}", e)))
+}
+
+/// Parameterized `UNWIND` batches as JSON lines; `batch_size` 0 keeps the default.
+#[cfg(feature = "neo4j")]
+pub(super) fn write_neo4j_batches<W: io::Write>(
+    doc: &Document,
+    use_merge: c_int,
+    batch_size: usize,
+    sink: &mut W,
+) -> Result<(), (c_int, String)> {
+    let mut config = if use_merge != 0 {
+        hedl_neo4j::ToCypherConfig::default()
+    } else {
+        hedl_neo4j::ToCypherConfig::new().with_create()
+    };
+    if batch_size != 0 {
+        config = config.with_batch_size(batch_size);
+    }
+    hedl_neo4j::to_cypher_batches(doc, &config, sink)
+        .map_err(|e| (HEDL_ERR_NEO4J, format!("Neo4j conversion error: {}", e)))
+}
+
+/// `threshold` is the canonical writer's staging size before it flushes to `sink`.
+pub(crate) fn write_canonical<W: io::Write>(
+    doc: &Document,
+    threshold: usize,
+    sink: &mut W,
+) -> Result<(), (c_int, String)> {
+    hedl_c14n::canonicalize_to_writer(doc, &hedl_c14n::CanonicalConfig::default(), sink, threshold)
+        .map_err(|e| {
+            (
+                crate::types::HEDL_ERR_CANONICALIZE,
+                format!("Canonicalization error: {}", e),
+            )
+        })
 }
 
 // =============================================================================
 // JSON Conversion with Callback
 // =============================================================================
 
-/// Convert a HEDL document to JSON using zero-copy callback pattern.
+/// Convert a HEDL document to JSON, streaming the output through a callback.
 ///
-/// For outputs >1MB, this avoids memory allocation by passing data directly
-/// to the callback. For smaller outputs, consider using `hedl_to_json`.
+/// Equivalent to [`hedl_to_json_callback_chunked`] with [`HEDL_DEFAULT_CHUNK_SIZE`].
 ///
 /// # Arguments
 /// * `doc` - Document handle from hedl_parse
@@ -122,55 +399,58 @@ pub unsafe extern "C" fn hedl_to_json_callback(
     callback: HedlOutputCallback,
     user_data: *mut c_void,
 ) -> c_int {
-    use crate::audit::{audit_call_failure, audit_call_start, audit_call_success, sanitize_pointer};
-    use std::time::Instant;
-    let start = Instant::now();
-    let doc_ptr_str = sanitize_pointer(doc);
-    let include_metadata_str = include_metadata.to_string();
-    audit_call_start("hedl_to_json_callback", &[
-        ("doc_ptr", &doc_ptr_str),
-        ("include_metadata", &include_metadata_str),
-    ]);
-
-    clear_error();
-
-    if !is_valid_document_ptr(doc) {
-        set_error("Null or invalid document pointer");
-        let duration = start.elapsed();
-        audit_call_failure("hedl_to_json_callback", HEDL_ERR_NULL_PTR, "NULL or invalid pointer", duration);
-        return HEDL_ERR_NULL_PTR;
-    }
-
-    let doc_ref = &(*doc).inner;
-    let config = hedl_json::ToJsonConfig {
-        include_metadata: include_metadata != 0,
-        ..Default::default()
-    };
+    hedl_to_json_callback_chunked(doc, include_metadata, HEDL_DEFAULT_CHUNK_SIZE, callback, user_data)
+}
 
-    match hedl_json::to_json(doc_ref, &config) {
-        Ok(json) => {
-            invoke_callback(&json, callback, user_data);
-            audit_call_success("hedl_to_json_callback", start.elapsed());
-            HEDL_OK
-        }
-        Err(e) => {
-            set_error(&format!("JSON conversion error: {}", e));
-            let duration = start.elapsed();
-            let msg = e.to_string();
-            audit_call_failure("hedl_to_json_callback", HEDL_ERR_JSON, &msg, duration);
-            HEDL_ERR_JSON
-        }
-    }
+/// Convert a HEDL document to JSON, streaming chunks of at most `chunk_size` bytes.
+///
+/// The JSON value tree is still built in memory, but the serialized text is
+/// never held as a whole.
+///
+/// # Arguments
+/// * `doc` - Document handle from hedl_parse
+/// * `include_metadata` - Non-zero to include HEDL metadata (__type__, __schema__)
+/// * `chunk_size` - Maximum bytes per callback invocation (0 for the default)
+/// * `callback` - Function to receive the output data
+/// * `user_data` - User context pointer passed to callback
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure.
+///
+/// # Safety
+/// - All pointers must be valid
+/// - The callback MUST NOT call back into HEDL functions
+/// - The data pointer passed to callback is only valid during the callback
+///
+/// # Feature
+/// Requires the "json" feature to be enabled.
+#[cfg(feature = "json")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_to_json_callback_chunked(
+    doc: *const HedlDocument,
+    include_metadata: c_int,
+    chunk_size: usize,
+    callback: HedlOutputCallback,
+    user_data: *mut c_void,
+) -> c_int {
+    export_chunked(
+        "hedl_to_json_callback_chunked",
+        doc,
+        &[("include_metadata", include_metadata)],
+        chunk_size,
+        callback,
+        user_data,
+        |doc, sink| write_json(doc, include_metadata, sink),
+    )
 }
 
 // =============================================================================
 // YAML Conversion with Callback
 // =============================================================================
 
-/// Convert a HEDL document to YAML using zero-copy callback pattern.
+/// Convert a HEDL document to YAML, streaming the output through a callback.
 ///
-/// For outputs >1MB, this avoids memory allocation by passing data directly
-/// to the callback. For smaller outputs, consider using `hedl_to_yaml`.
+/// Equivalent to [`hedl_to_yaml_callback_chunked`] with [`HEDL_DEFAULT_CHUNK_SIZE`].
 ///
 /// # Arguments
 /// * `doc` - Document handle from hedl_parse
@@ -196,55 +476,58 @@ pub unsafe extern "C" fn hedl_to_yaml_callback(
     callback: HedlOutputCallback,
     user_data: *mut c_void,
 ) -> c_int {
-    use crate::audit::{audit_call_failure, audit_call_start, audit_call_success, sanitize_pointer};
-    use std::time::Instant;
-    let start = Instant::now();
-    let doc_ptr_str = sanitize_pointer(doc);
-    let include_metadata_str = include_metadata.to_string();
-    audit_call_start("hedl_to_yaml_callback", &[
-        ("doc_ptr", &doc_ptr_str),
-        ("include_metadata", &include_metadata_str),
-    ]);
-
-    clear_error();
-
-    if !is_valid_document_ptr(doc) {
-        set_error("Null or invalid document pointer");
-        let duration = start.elapsed();
-        audit_call_failure("hedl_to_yaml_callback", HEDL_ERR_NULL_PTR, "NULL or invalid pointer", duration);
-        return HEDL_ERR_NULL_PTR;
-    }
-
-    let doc_ref = &(*doc).inner;
-    let config = hedl_yaml::ToYamlConfig {
-        include_metadata: include_metadata != 0,
-        ..Default::default()
-    };
+    hedl_to_yaml_callback_chunked(doc, include_metadata, HEDL_DEFAULT_CHUNK_SIZE, callback, user_data)
+}
 
-    match hedl_yaml::to_yaml(doc_ref, &config) {
-        Ok(yaml) => {
-            invoke_callback(&yaml, callback, user_data);
-            audit_call_success("hedl_to_yaml_callback", start.elapsed());
-            HEDL_OK
-        }
-        Err(e) => {
-            set_error(&format!("YAML conversion error: {}", e));
-            let duration = start.elapsed();
-            let msg = e.to_string();
-            audit_call_failure("hedl_to_yaml_callback", HEDL_ERR_JSON, &msg, duration);
-            HEDL_ERR_YAML
-        }
-    }
+/// Convert a HEDL document to YAML, streaming chunks of at most `chunk_size` bytes.
+///
+/// The YAML value tree is still built in memory, but the serialized text is
+/// never held as a whole.
+///
+/// # Arguments
+/// * `doc` - Document handle from hedl_parse
+/// * `include_metadata` - Non-zero to include HEDL metadata
+/// * `chunk_size` - Maximum bytes per callback invocation (0 for the default)
+/// * `callback` - Function to receive the output data
+/// * `user_data` - User context pointer passed to callback
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure.
+///
+/// # Safety
+/// - All pointers must be valid
+/// - The callback MUST NOT call back into HEDL functions
+/// - The data pointer passed to callback is only valid during the callback
+///
+/// # Feature
+/// Requires the "yaml" feature to be enabled.
+#[cfg(feature = "yaml")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_to_yaml_callback_chunked(
+    doc: *const HedlDocument,
+    include_metadata: c_int,
+    chunk_size: usize,
+    callback: HedlOutputCallback,
+    user_data: *mut c_void,
+) -> c_int {
+    export_chunked(
+        "hedl_to_yaml_callback_chunked",
+        doc,
+        &[("include_metadata", include_metadata)],
+        chunk_size,
+        callback,
+        user_data,
+        |doc, sink| write_yaml(doc, include_metadata, sink),
+    )
 }
 
 // =============================================================================
 // XML Conversion with Callback
 // =============================================================================
 
-/// Convert a HEDL document to XML using zero-copy callback pattern.
+/// Convert a HEDL document to XML, streaming the output through a callback.
 ///
-/// For outputs >1MB, this avoids memory allocation by passing data directly
-/// to the callback. For smaller outputs, consider using `hedl_to_xml`.
+/// Equivalent to [`hedl_to_xml_callback_chunked`] with [`HEDL_DEFAULT_CHUNK_SIZE`].
 ///
 /// # Arguments
 /// * `doc` - Document handle from hedl_parse
@@ -268,49 +551,58 @@ pub unsafe extern "C" fn hedl_to_xml_callback(
     callback: HedlOutputCallback,
     user_data: *mut c_void,
 ) -> c_int {
-    use crate::audit::{audit_call_failure, audit_call_start, audit_call_success, sanitize_pointer};
-    use std::time::Instant;
-    let start = Instant::now();
-    let doc_ptr_str = sanitize_pointer(doc);
-    audit_call_start("hedl_to_xml_callback", &[("doc_ptr", &doc_ptr_str)]);
-
-    clear_error();
-
-    if !is_valid_document_ptr(doc) {
-        set_error("Null or invalid document pointer");
-        let duration = start.elapsed();
-        audit_call_failure("hedl_to_xml_callback", HEDL_ERR_NULL_PTR, "NULL or invalid pointer", duration);
-        return HEDL_ERR_NULL_PTR;
-    }
-
-    let doc_ref = &(*doc).inner;
+    hedl_to_xml_callback_chunked(doc, HEDL_DEFAULT_CHUNK_SIZE, callback, user_data)
+}
 
-    match hedl_xml::hedl_to_xml(doc_ref) {
-        Ok(xml) => {
-            invoke_callback(&xml, callback, user_data);
-            audit_call_success("hedl_to_xml_callback", start.elapsed());
-            HEDL_OK
-        }
-        Err(e) => {
-            set_error(&format!("XML conversion error: {}", e));
-            let duration = start.elapsed();
-            let msg = e.to_string();
-            audit_call_failure("hedl_to_xml_callback", HEDL_ERR_JSON, &msg, duration);
-            HEDL_ERR_XML
-        }
-    }
+/// Convert a HEDL document to XML, streaming chunks of at most `chunk_size` bytes.
+///
+/// XML events are written as the document is walked; nothing is buffered
+/// beyond the current chunk.
+///
+/// # Arguments
+/// * `doc` - Document handle from hedl_parse
+/// * `chunk_size` - Maximum bytes per callback invocation (0 for the default)
+/// * `callback` - Function to receive the output data
+/// * `user_data` - User context pointer passed to callback
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure.
+///
+/// # Safety
+/// - All pointers must be valid
+/// - The callback MUST NOT call back into HEDL functions
+/// - The data pointer passed to callback is only valid during the callback
+///
+/// # Feature
+/// Requires the "xml" feature to be enabled.
+#[cfg(feature = "xml")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_to_xml_callback_chunked(
+    doc: *const HedlDocument,
+    chunk_size: usize,
+    callback: HedlOutputCallback,
+    user_data: *mut c_void,
+) -> c_int {
+    export_chunked(
+        "hedl_to_xml_callback_chunked",
+        doc,
+        &[],
+        chunk_size,
+        callback,
+        user_data,
+        |doc, sink| write_xml(doc, sink),
+    )
 }
 
 // =============================================================================
 // CSV Conversion with Callback
 // =============================================================================
 
-/// Convert a HEDL document to CSV using zero-copy callback pattern.
+/// Convert a HEDL document to CSV, streaming the output through a callback.
 ///
 /// Note: Only works for documents with matrix lists.
 ///
-/// For outputs >1MB, this avoids memory allocation by passing data directly
-/// to the callback. For smaller outputs, consider using `hedl_to_csv`.
+/// Equivalent to [`hedl_to_csv_callback_chunked`] with [`HEDL_DEFAULT_CHUNK_SIZE`].
 ///
 /// # Arguments
 /// * `doc` - Document handle from hedl_parse
@@ -334,49 +626,60 @@ pub unsafe extern "C" fn hedl_to_csv_callback(
     callback: HedlOutputCallback,
     user_data: *mut c_void,
 ) -> c_int {
-    use crate::audit::{audit_call_failure, audit_call_start, audit_call_success, sanitize_pointer};
-    use std::time::Instant;
-    let start = Instant::now();
-    let doc_ptr_str = sanitize_pointer(doc);
-    audit_call_start("hedl_to_csv_callback", &[("doc_ptr", &doc_ptr_str)]);
-
-    clear_error();
-
-    if !is_valid_document_ptr(doc) {
-        set_error("Null or invalid document pointer");
-        let duration = start.elapsed();
-        audit_call_failure("hedl_to_csv_callback", HEDL_ERR_NULL_PTR, "NULL or invalid pointer", duration);
-        return HEDL_ERR_NULL_PTR;
-    }
-
-    let doc_ref = &(*doc).inner;
+    hedl_to_csv_callback_chunked(doc, HEDL_DEFAULT_CHUNK_SIZE, callback, user_data)
+}
 
-    match hedl_csv::to_csv(doc_ref) {
-        Ok(csv) => {
-            invoke_callback(&csv, callback, user_data);
-            audit_call_success("hedl_to_csv_callback", start.elapsed());
-            HEDL_OK
-        }
-        Err(e) => {
-            set_error(&format!("CSV conversion error: {}", e));
-            let duration = start.elapsed();
-            let msg = e.to_string();
-            audit_call_failure("hedl_to_csv_callback", HEDL_ERR_JSON, &msg, duration);
-            HEDL_ERR_CSV
-        }
-    }
+/// Convert a HEDL document to CSV, streaming chunks of at most `chunk_size` bytes.
+///
+/// Note: Only works for documents with matrix lists.
+///
+/// Rows are written one at a time, so peak memory is independent of the
+/// number of rows.
+///
+/// # Arguments
+/// * `doc` - Document handle from hedl_parse
+/// * `chunk_size` - Maximum bytes per callback invocation (0 for the default)
+/// * `callback` - Function to receive the output data
+/// * `user_data` - User context pointer passed to callback
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure.
+///
+/// # Safety
+/// - All pointers must be valid
+/// - The callback MUST NOT call back into HEDL functions
+/// - The data pointer passed to callback is only valid during the callback
+///
+/// # Feature
+/// Requires the "csv" feature to be enabled.
+#[cfg(feature = "csv")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_to_csv_callback_chunked(
+    doc: *const HedlDocument,
+    chunk_size: usize,
+    callback: HedlOutputCallback,
+    user_data: *mut c_void,
+) -> c_int {
+    export_chunked(
+        "hedl_to_csv_callback_chunked",
+        doc,
+        &[],
+        chunk_size,
+        callback,
+        user_data,
+        |doc, sink| write_csv(doc, sink),
+    )
 }
 
 // =============================================================================
 // Neo4j/Cypher Conversion with Callback
 // =============================================================================
 
-/// Convert a HEDL document to Cypher queries using zero-copy callback pattern.
+/// Convert a HEDL document to Cypher queries, streaming the output through a callback.
 ///
 /// Generates CREATE/MERGE statements, constraints, and relationships.
 ///
-/// For outputs >1MB, this avoids memory allocation by passing data directly
-/// to the callback. For smaller outputs, consider using `hedl_to_neo4j_cypher`.
+/// Equivalent to [`hedl_to_neo4j_cypher_callback_chunked`] with [`HEDL_DEFAULT_CHUNK_SIZE`].
 ///
 /// # Arguments
 /// * `doc` - Document handle from hedl_parse
@@ -402,57 +705,108 @@ pub unsafe extern "C" fn hedl_to_neo4j_cypher_callback(
     callback: HedlOutputCallback,
     user_data: *mut c_void,
 ) -> c_int {
-    use crate::audit::{audit_call_failure, audit_call_start, audit_call_success, sanitize_pointer};
-    use std::time::Instant;
-    let start = Instant::now();
-    let doc_ptr_str = sanitize_pointer(doc);
-    let use_merge_str = use_merge.to_string();
-    audit_call_start("hedl_to_neo4j_cypher_callback", &[
-        ("doc_ptr", &doc_ptr_str),
-        ("use_merge", &use_merge_str),
-    ]);
-
-    clear_error();
-
-    if !is_valid_document_ptr(doc) {
-        set_error("Null or invalid document pointer");
-        let duration = start.elapsed();
-        audit_call_failure("hedl_to_neo4j_cypher_callback", HEDL_ERR_NULL_PTR, "NULL or invalid pointer", duration);
-        return HEDL_ERR_NULL_PTR;
-    }
+    hedl_to_neo4j_cypher_callback_chunked(doc, use_merge, HEDL_DEFAULT_CHUNK_SIZE, callback, user_data)
+}
 
-    let doc_ref = &(*doc).inner;
-    let config = if use_merge != 0 {
-        hedl_neo4j::ToCypherConfig::default()
-    } else {
-        hedl_neo4j::ToCypherConfig::new().with_create()
-    };
+/// Convert a HEDL document to Cypher queries, streaming chunks of at most `chunk_size` bytes.
+///
+/// Statements are written as they are generated rather than collected into a
+/// script first.
+///
+/// # Arguments
+/// * `doc` - Document handle from hedl_parse
+/// * `use_merge` - Non-zero to use MERGE (idempotent), zero for CREATE
+/// * `chunk_size` - Maximum bytes per callback invocation (0 for the default)
+/// * `callback` - Function to receive the output data
+/// * `user_data` - User context pointer passed to callback
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure.
+///
+/// # Safety
+/// - All pointers must be valid
+/// - The callback MUST NOT call back into HEDL functions
+/// - The data pointer passed to callback is only valid during the callback
+///
+/// # Feature
+/// Requires the "neo4j" feature to be enabled.
+#[cfg(feature = "neo4j")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_to_neo4j_cypher_callback_chunked(
+    doc: *const HedlDocument,
+    use_merge: c_int,
+    chunk_size: usize,
+    callback: HedlOutputCallback,
+    user_data: *mut c_void,
+) -> c_int {
+    export_chunked(
+        "hedl_to_neo4j_cypher_callback_chunked",
+        doc,
+        &[("use_merge", use_merge)],
+        chunk_size,
+        callback,
+        user_data,
+        |doc, sink| write_neo4j_cypher(doc, use_merge, sink),
+    )
+}
 
-    match hedl_neo4j::to_cypher(doc_ref, &config) {
-        Ok(cypher) => {
-            let cypher_str = cypher.to_string();
-            invoke_callback(&cypher_str, callback, user_data);
-            audit_call_success("hedl_to_neo4j_cypher_callback", start.elapsed());
-            HEDL_OK
-        }
-        Err(e) => {
-            set_error(&format!("Neo4j conversion error: {}", e));
-            let duration = start.elapsed();
-            let msg = e.to_string();
-            audit_call_failure("hedl_to_neo4j_cypher_callback", HEDL_ERR_JSON, &msg, duration);
-            HEDL_ERR_NEO4J
-        }
-    }
+/// Convert a HEDL document to parameterized Cypher batches, streamed through a callback.
+///
+/// The output is one JSON object per line, `{"statement": "...", "parameters": {...}}`.
+/// Nodes are grouped by label and relationships by type into `UNWIND $rows AS row`
+/// statements of at most `batch_size` rows, and the rows travel in `parameters.rows`
+/// rather than in the statement text. Executing each line with a driver's
+/// `run(statement, parameters)` lets Neo4j plan each statement text once.
+///
+/// Lines are produced batch by batch, so only one batch is held at a time; a
+/// line may span several callback invocations.
+///
+/// # Arguments
+/// * `doc` - Document handle from hedl_parse
+/// * `use_merge` - Non-zero to use MERGE (idempotent), zero for CREATE
+/// * `batch_size` - Maximum rows per `UNWIND` statement (0 for the default of 1000)
+/// * `chunk_size` - Maximum bytes per callback invocation (0 for the default)
+/// * `callback` - Function to receive the output data
+/// * `user_data` - User context pointer passed to callback
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure.
+///
+/// # Safety
+/// - All pointers must be valid
+/// - The callback MUST NOT call back into HEDL functions
+/// - The data pointer passed to callback is only valid during the callback
+///
+/// # Feature
+/// Requires the "neo4j" feature to be enabled.
+#[cfg(feature = "neo4j")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_to_neo4j_batches_callback(
+    doc: *const HedlDocument,
+    use_merge: c_int,
+    batch_size: usize,
+    chunk_size: usize,
+    callback: HedlOutputCallback,
+    user_data: *mut c_void,
+) -> c_int {
+    export_chunked(
+        "hedl_to_neo4j_batches_callback",
+        doc,
+        &[("use_merge", use_merge)],
+        chunk_size,
+        callback,
+        user_data,
+        |doc, sink| write_neo4j_batches(doc, use_merge, batch_size, sink),
+    )
 }
 
 // =============================================================================
 // Canonicalize with Callback
 // =============================================================================
 
-/// Canonicalize a HEDL document using zero-copy callback pattern.
+/// Canonicalize a HEDL document, streaming the output through a callback.
 ///
-/// For outputs >1MB, this avoids memory allocation by passing data directly
-/// to the callback. For smaller outputs, consider using `hedl_canonicalize`.
+/// Equivalent to [`hedl_canonicalize_callback_chunked`] with [`HEDL_DEFAULT_CHUNK_SIZE`].
 ///
 /// # Arguments
 /// * `doc` - Document handle from hedl_parse
@@ -472,35 +826,84 @@ pub unsafe extern "C" fn hedl_canonicalize_callback(
     callback: HedlOutputCallback,
     user_data: *mut c_void,
 ) -> c_int {
-    use crate::audit::{audit_call_failure, audit_call_start, audit_call_success, sanitize_pointer};
-    use std::time::Instant;
-    let start = Instant::now();
-    let doc_ptr_str = sanitize_pointer(doc);
-    audit_call_start("hedl_canonicalize_callback", &[("doc_ptr", &doc_ptr_str)]);
+    hedl_canonicalize_callback_chunked(doc, HEDL_DEFAULT_CHUNK_SIZE, callback, user_data)
+}
 
-    clear_error();
+/// Canonicalize a HEDL document, streaming chunks of at most `chunk_size` bytes.
+///
+/// # Arguments
+/// * `doc` - Document handle from hedl_parse
+/// * `chunk_size` - Maximum bytes per callback invocation (0 for the default)
+/// * `callback` - Function to receive the output data
+/// * `user_data` - User context pointer passed to callback
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure.
+///
+/// # Safety
+/// - All pointers must be valid
+/// - The callback MUST NOT call back into HEDL functions
+/// - The data pointer passed to callback is only valid during the callback
+#[no_mangle]
+pub unsafe extern "C" fn hedl_canonicalize_callback_chunked(
+    doc: *const HedlDocument,
+    chunk_size: usize,
+    callback: HedlOutputCallback,
+    user_data: *mut c_void,
+) -> c_int {
+    export_chunked(
+        "hedl_canonicalize_callback_chunked",
+        doc,
+        &[],
+        chunk_size,
+        callback,
+        user_data,
+        |doc, sink| {
+            let threshold = sink.chunk_size;
+            write_canonical(doc, threshold, sink)
+        },
+    )
+}
 
-    if !is_valid_document_ptr(doc) {
-        set_error("Null or invalid document pointer");
-        let duration = start.elapsed();
-        audit_call_failure("hedl_canonicalize_callback", HEDL_ERR_NULL_PTR, "NULL or invalid pointer", duration);
-        return HEDL_ERR_NULL_PTR;
-    }
+// =============================================================================
+// Tests
+// =============================================================================
 
-    let doc_ref = &(*doc).inner;
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::io::Write;
 
-    match hedl_c14n::canonicalize(doc_ref) {
-        Ok(canonical) => {
-            invoke_callback(&canonical, callback, user_data);
-            audit_call_success("hedl_canonicalize_callback", start.elapsed());
-            HEDL_OK
+    unsafe extern "C" fn record_chunk(data: *const c_char, len: usize, user_data: *mut c_void) {
+        let chunks = &mut *(user_data as *mut Vec<Vec<u8>>);
+        chunks.push(std::slice::from_raw_parts(data as *const u8, len).to_vec());
+    }
+
+    #[test]
+    fn test_callback_writer_emits_full_chunks() {
+        let mut chunks: Vec<Vec<u8>> = Vec::new();
+        unsafe {
+            let mut writer = CallbackWriter::new(4, record_chunk, &mut chunks as *mut _ as *mut c_void);
+            writer.write_all(b"ab").unwrap();
+            writer.write_all(b"cdefghij").unwrap();
+            writer.flush().unwrap();
+            writer.write_all(b"k").unwrap();
+            writer.finish();
         }
-        Err(e) => {
-            set_error(&format!("Canonicalization error: {}", e));
-            let duration = start.elapsed();
-            let msg = e.to_string();
-            audit_call_failure("hedl_canonicalize_callback", HEDL_ERR_JSON, &msg, duration);
-            crate::types::HEDL_ERR_CANONICALIZE
+        let sizes: Vec<usize> = chunks.iter().map(Vec::len).collect();
+        assert_eq!(sizes, vec![4, 4, 3]);
+        assert_eq!(chunks.concat(), b"abcdefghijk");
+    }
+
+    #[test]
+    fn test_callback_writer_zero_chunk_size_uses_default() {
+        let mut chunks: Vec<Vec<u8>> = Vec::new();
+        unsafe {
+            let writer = CallbackWriter::new(0, record_chunk, &mut chunks as *mut _ as *mut c_void);
+            assert_eq!(writer.chunk_size, HEDL_DEFAULT_CHUNK_SIZE);
+            writer.finish();
         }
+        // Empty output is still reported once, as a zero-length chunk
+        assert_eq!(chunks, vec![Vec::<u8>::new()]);
     }
 }
@@ -0,0 +1,539 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Export functions that serialize into a caller-provided buffer.
+//!
+//! The `hedl_*_into` functions write the output plus a NUL terminator into
+//! `buf` and never allocate the output on the library side, so services with
+//! preallocated per-request buffers can serialize without a
+//! `hedl_free_string` round trip.
+//!
+//! # Buffer Contract
+//!
+//! Modelled on `snprintf`:
+//!
+//! - `*out_needed` (optional) always receives the exact size the output
+//!   requires, including the terminator, whenever serialization succeeds
+//! - If it fits (`*out_needed <= cap`), the NUL-terminated output is in `buf`
+//!   and HEDL_OK is returned
+//! - Otherwise HEDL_ERR_BUFFER_TOO_SMALL is returned and `buf` holds an empty
+//!   string (when `cap > 0`); retry with a buffer of `*out_needed` bytes
+//! - `buf` may be NULL when `cap` is 0, which turns the call into a pure
+//!   size query
+//!
+//! [`hedl_estimate_output_size`] gives a guaranteed capacity for a format
+//! from a walk of the document, without serializing it: an `_into` call with
+//! at least that capacity always fits.
+//!
+//! # Usage Example (C)
+//!
+//! ```c
+//! char buf[64 * 1024];
+//! size_t needed = 0;
+//! int rc = hedl_to_json_into(doc, 0, buf, sizeof(buf), &needed);
+//! if (rc == HEDL_ERR_BUFFER_TOO_SMALL) {
+//!     char* big = malloc(needed);
+//!     rc = hedl_to_json_into(doc, 0, big, needed, &needed);
+//! }
+//! ```
+
+use super::output_bound::output_bound;
+#[cfg(feature = "csv")]
+use super::to_formats_callback::write_csv;
+#[cfg(feature = "json")]
+use super::to_formats_callback::write_json;
+#[cfg(feature = "neo4j")]
+use super::to_formats_callback::write_neo4j_cypher;
+#[cfg(feature = "xml")]
+use super::to_formats_callback::write_xml;
+#[cfg(feature = "yaml")]
+use super::to_formats_callback::write_yaml;
+use super::to_formats_callback::{audit_export_start, write_canonical, HEDL_DEFAULT_CHUNK_SIZE};
+use crate::audit::{audit_call_failure, audit_call_success, AuditTimer};
+use crate::audit_start;
+use crate::error::{clear_error, set_error};
+use crate::memory::is_valid_document_ptr;
+use crate::metrics::note_output;
+use crate::types::{
+    HedlDocument, HEDL_ERR_BUFFER_TOO_SMALL, HEDL_ERR_NOT_FOUND, HEDL_ERR_NULL_PTR, HEDL_OK,
+};
+use hedl_core::Document;
+use std::io;
+use std::os::raw::{c_char, c_int};
+use std::slice;
+
+// =============================================================================
+// Caller Buffer Writer
+// =============================================================================
+
+/// `io::Write` adapter that fills a fixed caller buffer.
+///
+/// Bytes past the end of the buffer are dropped but still counted, so a
+/// single pass reports the exact size even when the output does not fit.
+/// One byte is always left for the terminator.
+struct BufferWriter<'a> {
+    buf: &'a mut [u8],
+    len: usize,
+}
+
+impl<'a> BufferWriter<'a> {
+    fn new(buf: &'a mut [u8]) -> Self {
+        Self { buf, len: 0 }
+    }
+
+    /// Bytes required to hold the whole output plus its terminator.
+    fn needed(&self) -> usize {
+        self.len + 1
+    }
+
+    /// Terminate the output; returns false if it did not fit.
+    fn finish(self) -> bool {
+        if self.len < self.buf.len() {
+            self.buf[self.len] = 0;
+            true
+        } else {
+            if let Some(first) = self.buf.first_mut() {
+                *first = 0;
+            }
+            false
+        }
+    }
+}
+
+impl io::Write for BufferWriter<'_> {
+    fn write(&mut self, data: &[u8]) -> io::Result<usize> {
+        let capacity = self.buf.len().saturating_sub(1);
+        if self.len < capacity {
+            let take = (capacity - self.len).min(data.len());
+            self.buf[self.len..self.len + take].copy_from_slice(&data[..take]);
+        }
+        self.len += data.len();
+        Ok(data.len())
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        Ok(())
+    }
+}
+
+/// Shared driver for every `*_into` exporter: audit, validate, serialize, report.
+///
+/// # Safety
+/// Same requirements as the public `*_into` functions.
+#[allow(clippy::too_many_arguments)]
+unsafe fn export_into<F>(
+    fn_name: &'static str,
+    doc: *const HedlDocument,
+    flags: &[(&str, c_int)],
+    buf: *mut c_char,
+    cap: usize,
+    out_needed: *mut usize,
+    export: F,
+) -> c_int
+where
+    F: FnOnce(&Document, &mut BufferWriter<'_>) -> Result<(), (c_int, String)>,
+{
+    let start = AuditTimer::start();
+    audit_export_start(fn_name, doc, flags, ("cap", cap));
+
+    clear_error();
+
+    if !is_valid_document_ptr(doc) || (buf.is_null() && cap != 0) {
+        set_error("Null pointer argument");
+        let duration = start.elapsed();
+        audit_call_failure(
+            fn_name,
+            HEDL_ERR_NULL_PTR,
+            "Null pointer argument",
+            duration,
+        );
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    let target: &mut [u8] = if cap == 0 {
+        &mut []
+    } else {
+        slice::from_raw_parts_mut(buf as *mut u8, cap)
+    };
+    let mut sink = BufferWriter::new(target);
+
+    if let Err((code, msg)) = export(&(*doc).inner, &mut sink) {
+        set_error(&msg);
+        audit_call_failure(fn_name, code, &msg, start.elapsed());
+        return code;
+    }
+
+    let needed = sink.needed();
+    if !out_needed.is_null() {
+        *out_needed = needed;
+    }
+
+    if sink.finish() {
+        note_output(needed - 1);
+        audit_call_success(fn_name, start.elapsed());
+        HEDL_OK
+    } else {
+        let msg = format!("Output needs {} bytes but the buffer holds {}", needed, cap);
+        set_error(&msg);
+        audit_call_failure(fn_name, HEDL_ERR_BUFFER_TOO_SMALL, &msg, start.elapsed());
+        HEDL_ERR_BUFFER_TOO_SMALL
+    }
+}
+
+// =============================================================================
+// Exporters
+// =============================================================================
+
+/// Convert a HEDL document to JSON in a caller-provided buffer.
+///
+/// # Arguments
+/// * `doc` - Document handle from hedl_parse
+/// * `include_metadata` - Non-zero to include HEDL metadata (__type__, __schema__)
+/// * `buf` - Destination buffer (may be NULL if `cap` is 0)
+/// * `cap` - Size of `buf` in bytes
+/// * `out_needed` - Receives the required size including the terminator (may be NULL)
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_BUFFER_TOO_SMALL if the output did not fit,
+/// or another error code on failure.
+///
+/// # Safety
+/// `buf` must be valid for writes of `cap` bytes; other pointers must be valid.
+///
+/// # Feature
+/// Requires the "json" feature to be enabled.
+#[cfg(feature = "json")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_to_json_into(
+    doc: *const HedlDocument,
+    include_metadata: c_int,
+    buf: *mut c_char,
+    cap: usize,
+    out_needed: *mut usize,
+) -> c_int {
+    export_into(
+        "hedl_to_json_into",
+        doc,
+        &[("include_metadata", include_metadata)],
+        buf,
+        cap,
+        out_needed,
+        |doc, sink| write_json(doc, include_metadata, sink),
+    )
+}
+
+/// Convert a HEDL document to YAML in a caller-provided buffer.
+///
+/// # Arguments
+/// * `doc` - Document handle from hedl_parse
+/// * `include_metadata` - Non-zero to include HEDL metadata
+/// * `buf` - Destination buffer (may be NULL if `cap` is 0)
+/// * `cap` - Size of `buf` in bytes
+/// * `out_needed` - Receives the required size including the terminator (may be NULL)
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_BUFFER_TOO_SMALL if the output did not fit,
+/// or another error code on failure.
+///
+/// # Safety
+/// `buf` must be valid for writes of `cap` bytes; other pointers must be valid.
+///
+/// # Feature
+/// Requires the "yaml" feature to be enabled.
+#[cfg(feature = "yaml")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_to_yaml_into(
+    doc: *const HedlDocument,
+    include_metadata: c_int,
+    buf: *mut c_char,
+    cap: usize,
+    out_needed: *mut usize,
+) -> c_int {
+    export_into(
+        "hedl_to_yaml_into",
+        doc,
+        &[("include_metadata", include_metadata)],
+        buf,
+        cap,
+        out_needed,
+        |doc, sink| write_yaml(doc, include_metadata, sink),
+    )
+}
+
+/// Convert a HEDL document to XML in a caller-provided buffer.
+///
+/// # Arguments
+/// * `doc` - Document handle from hedl_parse
+/// * `buf` - Destination buffer (may be NULL if `cap` is 0)
+/// * `cap` - Size of `buf` in bytes
+/// * `out_needed` - Receives the required size including the terminator (may be NULL)
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_BUFFER_TOO_SMALL if the output did not fit,
+/// or another error code on failure.
+///
+/// # Safety
+/// `buf` must be valid for writes of `cap` bytes; other pointers must be valid.
+///
+/// # Feature
+/// Requires the "xml" feature to be enabled.
+#[cfg(feature = "xml")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_to_xml_into(
+    doc: *const HedlDocument,
+    buf: *mut c_char,
+    cap: usize,
+    out_needed: *mut usize,
+) -> c_int {
+    export_into(
+        "hedl_to_xml_into",
+        doc,
+        &[],
+        buf,
+        cap,
+        out_needed,
+        |doc, sink| write_xml(doc, sink),
+    )
+}
+
+/// Convert a HEDL document to CSV in a caller-provided buffer.
+///
+/// Note: Only works for documents with matrix lists.
+///
+/// # Arguments
+/// * `doc` - Document handle from hedl_parse
+/// * `buf` - Destination buffer (may be NULL if `cap` is 0)
+/// * `cap` - Size of `buf` in bytes
+/// * `out_needed` - Receives the required size including the terminator (may be NULL)
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_BUFFER_TOO_SMALL if the output did not fit,
+/// or another error code on failure.
+///
+/// # Safety
+/// `buf` must be valid for writes of `cap` bytes; other pointers must be valid.
+///
+/// # Feature
+/// Requires the "csv" feature to be enabled.
+#[cfg(feature = "csv")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_to_csv_into(
+    doc: *const HedlDocument,
+    buf: *mut c_char,
+    cap: usize,
+    out_needed: *mut usize,
+) -> c_int {
+    export_into(
+        "hedl_to_csv_into",
+        doc,
+        &[],
+        buf,
+        cap,
+        out_needed,
+        |doc, sink| write_csv(doc, sink),
+    )
+}
+
+/// Convert a HEDL document to Cypher queries in a caller-provided buffer.
+///
+/// # Arguments
+/// * `doc` - Document handle from hedl_parse
+/// * `use_merge` - Non-zero to use MERGE (idempotent), zero for CREATE
+/// * `buf` - Destination buffer (may be NULL if `cap` is 0)
+/// * `cap` - Size of `buf` in bytes
+/// * `out_needed` - Receives the required size including the terminator (may be NULL)
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_BUFFER_TOO_SMALL if the output did not fit,
+/// or another error code on failure.
+///
+/// # Safety
+/// `buf` must be valid for writes of `cap` bytes; other pointers must be valid.
+///
+/// # Feature
+/// Requires the "neo4j" feature to be enabled.
+#[cfg(feature = "neo4j")]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_to_neo4j_cypher_into(
+    doc: *const HedlDocument,
+    use_merge: c_int,
+    buf: *mut c_char,
+    cap: usize,
+    out_needed: *mut usize,
+) -> c_int {
+    export_into(
+        "hedl_to_neo4j_cypher_into",
+        doc,
+        &[("use_merge", use_merge)],
+        buf,
+        cap,
+        out_needed,
+        |doc, sink| write_neo4j_cypher(doc, use_merge, sink),
+    )
+}
+
+/// Canonicalize a HEDL document into a caller-provided buffer.
+///
+/// # Arguments
+/// * `doc` - Document handle from hedl_parse
+/// * `buf` - Destination buffer (may be NULL if `cap` is 0)
+/// * `cap` - Size of `buf` in bytes
+/// * `out_needed` - Receives the required size including the terminator (may be NULL)
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_BUFFER_TOO_SMALL if the output did not fit,
+/// or another error code on failure.
+///
+/// # Safety
+/// `buf` must be valid for writes of `cap` bytes; other pointers must be valid.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_canonicalize_into(
+    doc: *const HedlDocument,
+    buf: *mut c_char,
+    cap: usize,
+    out_needed: *mut usize,
+) -> c_int {
+    export_into(
+        "hedl_canonicalize_into",
+        doc,
+        &[],
+        buf,
+        cap,
+        out_needed,
+        |doc, sink| write_canonical(doc, HEDL_DEFAULT_CHUNK_SIZE, sink),
+    )
+}
+
+// =============================================================================
+// Size Bound
+// =============================================================================
+
+/// Compute a buffer size that is guaranteed to hold an export of a document.
+///
+/// Walks the document once without serializing it and charges every key,
+/// tag, separator and indentation run at its longest and every string at the
+/// format's worst-case escape factor (6x for JSON, XML and Cypher, 4x for
+/// YAML, 2x for canonical and CSV). The bound is never exceeded: the matching
+/// `*_into` call with `cap >= *out_size` always fits and never returns
+/// HEDL_ERR_BUFFER_TOO_SMALL. It is not tight; heavily escaped or deeply
+/// nested documents get the most headroom.
+///
+/// # Arguments
+/// * `doc` - Document handle from hedl_parse
+/// * `format` - `HEDL_FORMAT_*` value of the exporter to size for
+/// * `flags` - `HEDL_EXPORT_*` flags the export will use
+/// * `out_size` - Receives the bound in bytes, including the terminator
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_NULL_PTR if a pointer is invalid,
+/// HEDL_ERR_NOT_FOUND for Parquet, unknown formats and formats not in this build.
+///
+/// # Safety
+/// All pointers must be valid.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_estimate_output_size(
+    doc: *const HedlDocument,
+    format: c_int,
+    flags: u32,
+    out_size: *mut usize,
+) -> c_int {
+    let start = AuditTimer::start();
+
+    audit_start!(
+        "hedl_estimate_output_size",
+        "doc" => crate::audit::sanitize_pointer(doc),
+        "format" => format.to_string(),
+        "flags" => flags.to_string(),
+    );
+
+    clear_error();
+
+    if !is_valid_document_ptr(doc) || out_size.is_null() {
+        let duration = start.elapsed();
+        set_error("Null pointer argument");
+        audit_call_failure(
+            "hedl_estimate_output_size",
+            HEDL_ERR_NULL_PTR,
+            "Null pointer argument",
+            duration,
+        );
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    match output_bound(&(*doc).inner, format, flags) {
+        Some(bound) => *out_size = bound,
+        None => {
+            let msg = format!("Export format {} is not available in this build", format);
+            let duration = start.elapsed();
+            set_error(&msg);
+            audit_call_failure(
+                "hedl_estimate_output_size",
+                HEDL_ERR_NOT_FOUND,
+                &msg,
+                duration,
+            );
+            return HEDL_ERR_NOT_FOUND;
+        }
+    }
+    audit_call_success("hedl_estimate_output_size", start.elapsed());
+    HEDL_OK
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::io::Write;
+
+    #[test]
+    fn test_buffer_writer_fits() {
+        let mut buf = [0xffu8; 8];
+        let mut writer = BufferWriter::new(&mut buf);
+        writer.write_all(b"abc").unwrap();
+        writer.write_all(b"de").unwrap();
+        assert_eq!(writer.needed(), 6);
+        assert!(writer.finish());
+        assert_eq!(&buf[..6], b"abcde\0");
+    }
+
+    #[test]
+    fn test_buffer_writer_counts_past_capacity() {
+        let mut buf = [0xffu8; 4];
+        let mut writer = BufferWriter::new(&mut buf);
+        writer.write_all(b"abcdefgh").unwrap();
+        assert_eq!(writer.needed(), 9);
+        assert!(!writer.finish());
+        assert_eq!(buf[0], 0);
+    }
+
+    #[test]
+    fn test_buffer_writer_exact_fit_needs_terminator() {
+        let mut buf = [0xffu8; 4];
+        let mut writer = BufferWriter::new(&mut buf);
+        writer.write_all(b"abcd").unwrap();
+        assert!(!writer.finish());
+
+        let mut buf = [0xffu8; 5];
+        let mut writer = BufferWriter::new(&mut buf);
+        writer.write_all(b"abcd").unwrap();
+        assert!(writer.finish());
+        assert_eq!(&buf, b"abcd\0");
+    }
+}
@@ -70,7 +70,7 @@ pub unsafe extern "C" fn hedl_diagnostics_get(
     }
 
     let msg = diagnostics[index as usize].to_string();
-    allocate_output_string(&msg, out_str, HEDL_ERR_LINT)
+    allocate_output_string(msg, out_str, HEDL_ERR_LINT)
 }
 
 /// Get a diagnostic severity (0=Hint, 1=Warning, 2=Error).
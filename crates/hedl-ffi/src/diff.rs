@@ -0,0 +1,181 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//! Structural diffs and patches for FFI.
+//!
+//! `hedl_diff` encodes the changes between two documents with
+//! `hedl_core::diff`: rows of a matrix list are matched by node ID, so a
+//! change to a few rows of a large list costs those rows, not the list.
+//! `hedl_apply_patch` brings another copy of the old document up to date.
+//! A delta that is malformed, from another format version, or does not fit
+//! the target is rejected with `HEDL_ERR_PATCH` and the target is left
+//! unchanged.
+//!
+//! # Usage Example (C)
+//!
+//! ```c
+//! uint8_t* delta = NULL;
+//! size_t len = 0;
+//! if (hedl_diff(old_doc, new_doc, &delta, &len) == HEDL_OK) {
+//!     send_to_replica(delta, len);
+//!     hedl_free_bytes(delta, len);
+//! }
+//!
+//! // On the replica, holding its own copy of old_doc:
+//! hedl_apply_patch(replica_doc, delta, len);
+//! ```
+
+use crate::audit::{audit_call_failure, audit_call_success, sanitize_pointer, AuditTimer};
+use crate::audit_start;
+use crate::error::{clear_error, set_error};
+use crate::memory::is_valid_document_ptr;
+use crate::metrics::{note_input, note_output};
+use crate::types::{HedlDocument, HEDL_ERR_NULL_PTR, HEDL_ERR_PATCH, HEDL_OK};
+use hedl_core::{diff_documents, DocumentDiff};
+use std::os::raw::c_int;
+use std::slice;
+
+/// Encode the changes that turn `old_doc` into `new_doc`.
+///
+/// The delta is deterministic: equal documents give the same bytes.
+///
+/// # Arguments
+/// * `old_doc` - Document the delta applies to
+/// * `new_doc` - Document the delta produces
+/// * `out_delta` - Receives the delta bytes (free with `hedl_free_bytes`)
+/// * `out_len` - Receives the delta length
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_PATCH if the delta is too large for the
+/// format, HEDL_ERR_NULL_PTR for a NULL argument.
+///
+/// # Safety
+/// All pointers must be valid.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_diff(
+    old_doc: *const HedlDocument,
+    new_doc: *const HedlDocument,
+    out_delta: *mut *mut u8,
+    out_len: *mut usize,
+) -> c_int {
+    let start = AuditTimer::start();
+    audit_start!(
+        "hedl_diff",
+        "old_doc" => sanitize_pointer(old_doc),
+        "new_doc" => sanitize_pointer(new_doc),
+        "out_delta" => sanitize_pointer(out_delta),
+        "out_len" => sanitize_pointer(out_len),
+    );
+
+    clear_error();
+
+    if !is_valid_document_ptr(old_doc)
+        || !is_valid_document_ptr(new_doc)
+        || out_delta.is_null()
+        || out_len.is_null()
+    {
+        set_error("Null pointer argument");
+        let duration = start.elapsed();
+        audit_call_failure(
+            "hedl_diff",
+            HEDL_ERR_NULL_PTR,
+            "Null pointer argument",
+            duration,
+        );
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    match diff_documents(&(*old_doc).inner, &(*new_doc).inner).to_bytes() {
+        Ok(bytes) => {
+            let len = bytes.len();
+            *out_delta = Box::into_raw(bytes.into_boxed_slice()) as *mut u8;
+            *out_len = len;
+            note_output(len);
+            audit_call_success("hedl_diff", start.elapsed());
+            HEDL_OK
+        }
+        Err(e) => {
+            set_error(&e.message);
+            audit_call_failure("hedl_diff", HEDL_ERR_PATCH, &e.message, start.elapsed());
+            HEDL_ERR_PATCH
+        }
+    }
+}
+
+/// Apply a delta from `hedl_diff` to a document in place.
+///
+/// # Arguments
+/// * `doc` - Document to update; must not be a shared handle
+/// * `delta` - Delta bytes
+/// * `len` - Delta length
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_PATCH if the delta is malformed, from another
+/// format version, or does not fit `doc` (which is then left unchanged),
+/// HEDL_ERR_NULL_PTR for a NULL argument.
+///
+/// # Safety
+/// `doc` must be a valid, exclusively owned document handle and `delta` must
+/// point to at least `len` readable bytes.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_apply_patch(
+    doc: *mut HedlDocument,
+    delta: *const u8,
+    len: usize,
+) -> c_int {
+    let start = AuditTimer::start();
+    audit_start!(
+        "hedl_apply_patch",
+        "doc" => sanitize_pointer(doc),
+        "delta" => sanitize_pointer(delta),
+        "len" => len.to_string(),
+    );
+
+    clear_error();
+
+    if !is_valid_document_ptr(doc) || delta.is_null() || len > isize::MAX as usize {
+        set_error("Null pointer argument");
+        let duration = start.elapsed();
+        audit_call_failure(
+            "hedl_apply_patch",
+            HEDL_ERR_NULL_PTR,
+            "Null pointer argument",
+            duration,
+        );
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    note_input(len);
+    let result = DocumentDiff::from_bytes(slice::from_raw_parts(delta, len))
+        .and_then(|diff| diff.apply((*doc).document_mut()));
+
+    match result {
+        Ok(()) => {
+            audit_call_success("hedl_apply_patch", start.elapsed());
+            HEDL_OK
+        }
+        Err(e) => {
+            set_error(&e.message);
+            audit_call_failure(
+                "hedl_apply_patch",
+                HEDL_ERR_PATCH,
+                &e.message,
+                start.elapsed(),
+            );
+            HEDL_ERR_PATCH
+        }
+    }
+}
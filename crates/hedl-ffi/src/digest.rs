@@ -0,0 +1,360 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//! Canonical content digests for FFI.
+//!
+//! `hedl_canonical_hash` fingerprints a document by streaming its canonical
+//! form straight into an incremental hasher, so no canonical text is built or
+//! returned. The digest equals hashing the output of `hedl_canonicalize`.
+//!
+//! The same single pass also digests each root entry. Both are cached on the
+//! document handle, next to its node index, and dropped by the same changes
+//! (incremental edits and `hedl_apply_patch`), so fingerprinting an unchanged
+//! document again is free. `hedl_digests_new` hands out the cached digests
+//! as a `HedlDigests` handle; comparing the entry digests of two documents
+//! finds the changed entries without rendering either of them.
+//!
+//! # Usage Example (C)
+//!
+//! ```c
+//! uint8_t digest[HEDL_HASH_MAX_SIZE];
+//! hedl_canonical_hash(doc, HEDL_HASH_XXH3_128, digest);   // 16 bytes
+//!
+//! HedlDigests* digests = NULL;
+//! hedl_digests_new(doc, HEDL_HASH_BLAKE3, &digests);
+//! for (size_t i = 0; i < hedl_digests_count(digests); i++) {
+//!     const char* key; size_t key_len;
+//!     hedl_digests_entry(digests, i, &key, &key_len, digest);  // 32 bytes
+//! }
+//! hedl_digests_free(digests);
+//! ```
+
+use crate::audit::{audit_call_failure, audit_call_success, sanitize_pointer, AuditTimer};
+use crate::audit_start;
+use crate::error::{clear_error, set_error};
+use crate::memory::is_valid_document_ptr;
+use crate::types::{
+    HedlDocument, HEDL_ERR_CANONICALIZE, HEDL_ERR_NOT_FOUND, HEDL_ERR_NULL_PTR, HEDL_OK,
+};
+use crate::utils::borrow_input_sized;
+use crate::values::write_str_view;
+use hedl_c14n::{Digest, DigestAlgorithm, DocumentDigests};
+use std::os::raw::{c_char, c_int};
+use std::ptr;
+use std::sync::Arc;
+
+// =============================================================================
+// Algorithms
+// =============================================================================
+
+/// BLAKE3, 32-byte digests.
+pub const HEDL_HASH_BLAKE3: c_int = 0;
+/// XXH3 128-bit, 16-byte digests (big-endian). Fast, not cryptographic.
+pub const HEDL_HASH_XXH3_128: c_int = 1;
+/// Size of the largest digest; always enough for `out_digest`.
+pub const HEDL_HASH_MAX_SIZE: usize = hedl_c14n::MAX_DIGEST_LEN;
+
+fn algorithm(algo: c_int) -> Option<DigestAlgorithm> {
+    match algo {
+        HEDL_HASH_BLAKE3 => Some(DigestAlgorithm::Blake3),
+        HEDL_HASH_XXH3_128 => Some(DigestAlgorithm::Xxh3_128),
+        _ => None,
+    }
+}
+
+unsafe fn write_digest(digest: &Digest, out_digest: *mut u8) {
+    let bytes = digest.as_bytes();
+    ptr::copy_nonoverlapping(bytes.as_ptr(), out_digest, bytes.len());
+}
+
+/// Validate the arguments shared by the digest entry points.
+///
+/// Returns the algorithm, or the error code after recording the failure.
+unsafe fn check_args(
+    fn_name: &'static str,
+    doc: *const HedlDocument,
+    algo: c_int,
+    out_ok: bool,
+    start: &AuditTimer,
+) -> Result<DigestAlgorithm, c_int> {
+    if !is_valid_document_ptr(doc) || !out_ok {
+        set_error("Null pointer argument");
+        audit_call_failure(
+            fn_name,
+            HEDL_ERR_NULL_PTR,
+            "Null pointer argument",
+            start.elapsed(),
+        );
+        return Err(HEDL_ERR_NULL_PTR);
+    }
+    algorithm(algo).ok_or_else(|| {
+        let msg = format!("Unknown hash algorithm {}", algo);
+        set_error(&msg);
+        audit_call_failure(fn_name, HEDL_ERR_NOT_FOUND, &msg, start.elapsed());
+        HEDL_ERR_NOT_FOUND
+    })
+}
+
+// =============================================================================
+// Document Digest
+// =============================================================================
+
+/// Hash the canonical form of a document without materializing it.
+///
+/// The result equals hashing the string returned by `hedl_canonicalize` but
+/// needs no output allocation: the canonical writer feeds the hasher in
+/// bounded chunks. The digest is cached on the document until it changes.
+///
+/// # Arguments
+/// * `doc` - Document handle
+/// * `algo` - `HEDL_HASH_BLAKE3` (32 bytes) or `HEDL_HASH_XXH3_128` (16 bytes)
+/// * `out_digest` - Receives the digest; must hold the algorithm's digest size
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_NULL_PTR for a NULL pointer,
+/// HEDL_ERR_NOT_FOUND for an unknown algorithm, HEDL_ERR_CANONICALIZE if the
+/// document cannot be canonicalized.
+///
+/// # Safety
+/// `doc` must be a valid document handle and `out_digest` valid for writes of
+/// the digest size (`HEDL_HASH_MAX_SIZE` always suffices).
+#[no_mangle]
+pub unsafe extern "C" fn hedl_canonical_hash(
+    doc: *const HedlDocument,
+    algo: c_int,
+    out_digest: *mut u8,
+) -> c_int {
+    let start = AuditTimer::start();
+    audit_start!(
+        "hedl_canonical_hash",
+        "doc" => sanitize_pointer(doc),
+        "algo" => algo.to_string(),
+    );
+
+    clear_error();
+
+    let algorithm = match check_args(
+        "hedl_canonical_hash",
+        doc,
+        algo,
+        !out_digest.is_null(),
+        &start,
+    ) {
+        Ok(algorithm) => algorithm,
+        Err(code) => return code,
+    };
+
+    match (*doc).digests(algorithm) {
+        Ok(digests) => {
+            write_digest(&digests.document, out_digest);
+            audit_call_success("hedl_canonical_hash", start.elapsed());
+            HEDL_OK
+        }
+        Err(e) => {
+            let msg = format!("Canonicalization error: {}", e);
+            set_error(&msg);
+            audit_call_failure(
+                "hedl_canonical_hash",
+                HEDL_ERR_CANONICALIZE,
+                &msg,
+                start.elapsed(),
+            );
+            HEDL_ERR_CANONICALIZE
+        }
+    }
+}
+
+// =============================================================================
+// Per-Entry Digests
+// =============================================================================
+
+/// Opaque handle holding a document digest and one digest per root entry.
+///
+/// Shares the digests cached on the document, but not the document: it
+/// stays valid after the document is freed and does not follow later edits.
+pub struct HedlDigests {
+    inner: Arc<DocumentDigests>,
+}
+
+/// Get the document digest and every root entry's digest.
+///
+/// They are computed in one pass on first use and cached on the document,
+/// like the digest of `hedl_canonical_hash`. Entry digests cover the
+/// canonical lines of that entry alone, so two documents with equal digests
+/// under the same key have identical entries.
+///
+/// # Arguments
+/// * `doc` - Document handle
+/// * `algo` - `HEDL_HASH_BLAKE3` or `HEDL_HASH_XXH3_128`
+/// * `out_digests` - Receives the handle (free with hedl_digests_free)
+///
+/// # Returns
+/// The same codes as `hedl_canonical_hash`.
+///
+/// # Safety
+/// `doc` must be a valid document handle and `out_digests` valid for writes.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_digests_new(
+    doc: *const HedlDocument,
+    algo: c_int,
+    out_digests: *mut *mut HedlDigests,
+) -> c_int {
+    let start = AuditTimer::start();
+    audit_start!(
+        "hedl_digests_new",
+        "doc" => sanitize_pointer(doc),
+        "algo" => algo.to_string(),
+    );
+
+    clear_error();
+
+    let algorithm = match check_args(
+        "hedl_digests_new",
+        doc,
+        algo,
+        !out_digests.is_null(),
+        &start,
+    ) {
+        Ok(algorithm) => algorithm,
+        Err(code) => return code,
+    };
+
+    match (*doc).digests(algorithm) {
+        Ok(inner) => {
+            *out_digests = Box::into_raw(Box::new(HedlDigests { inner }));
+            audit_call_success("hedl_digests_new", start.elapsed());
+            HEDL_OK
+        }
+        Err(e) => {
+            let msg = format!("Canonicalization error: {}", e);
+            set_error(&msg);
+            *out_digests = ptr::null_mut();
+            audit_call_failure(
+                "hedl_digests_new",
+                HEDL_ERR_CANONICALIZE,
+                &msg,
+                start.elapsed(),
+            );
+            HEDL_ERR_CANONICALIZE
+        }
+    }
+}
+
+/// Copy the whole-document digest (equal to `hedl_canonical_hash`).
+///
+/// # Safety
+/// `digests` must be a live handle and `out_digest` valid for writes of the
+/// digest size.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_digests_document(
+    digests: *const HedlDigests,
+    out_digest: *mut u8,
+) -> c_int {
+    if digests.is_null() || out_digest.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    let digests = &*digests;
+    write_digest(&digests.inner.document, out_digest);
+    HEDL_OK
+}
+
+/// Number of root entries with a digest.
+///
+/// # Safety
+/// `digests` must be a live handle or NULL (returns 0).
+#[no_mangle]
+pub unsafe extern "C" fn hedl_digests_count(digests: *const HedlDigests) -> usize {
+    if digests.is_null() {
+        return 0;
+    }
+    let digests = &*digests;
+    digests.inner.entries.len()
+}
+
+/// Copy the digest of the root entry `key`.
+///
+/// # Returns
+/// HEDL_OK, or HEDL_ERR_NOT_FOUND if the document had no such root entry.
+///
+/// # Safety
+/// `digests` must be a live handle, `key` must point to at least `key_len`
+/// bytes and `out_digest` must be valid for writes of the digest size.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_digests_get(
+    digests: *const HedlDigests,
+    key: *const c_char,
+    key_len: usize,
+    out_digest: *mut u8,
+) -> c_int {
+    if digests.is_null() || key.is_null() || out_digest.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    let key = match borrow_input_sized(key, key_len) {
+        Ok(key) => key,
+        Err((code, _)) => return code,
+    };
+    let digests = &*digests;
+    match digests.inner.get(key) {
+        Some(digest) => {
+            write_digest(digest, out_digest);
+            HEDL_OK
+        }
+        None => HEDL_ERR_NOT_FOUND,
+    }
+}
+
+/// Get the `index`-th root entry (in key order) and its digest.
+///
+/// The key view is not null-terminated and stays valid until the handle is
+/// freed. `out_key_len` may be NULL.
+///
+/// # Returns
+/// HEDL_OK, or HEDL_ERR_NOT_FOUND if `index` is out of range.
+///
+/// # Safety
+/// `digests` must be a live handle; the out pointers must be valid for writes.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_digests_entry(
+    digests: *const HedlDigests,
+    index: usize,
+    out_key: *mut *const c_char,
+    out_key_len: *mut usize,
+    out_digest: *mut u8,
+) -> c_int {
+    if digests.is_null() || out_key.is_null() || out_digest.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    let digests = &*digests;
+    let entries = &digests.inner.entries;
+    match entries.get(index) {
+        Some((key, digest)) => {
+            write_digest(digest, out_digest);
+            write_str_view(key, out_key, out_key_len)
+        }
+        None => HEDL_ERR_NOT_FOUND,
+    }
+}
+
+/// Free a digests handle.
+///
+/// # Safety
+/// The pointer must have been returned by `hedl_digests_new`. NULL is ignored.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_digests_free(digests: *mut HedlDigests) {
+    if !digests.is_null() {
+        let _ = Box::from_raw(digests);
+    }
+}
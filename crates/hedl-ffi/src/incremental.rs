@@ -0,0 +1,281 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//! Incremental re-parsing handles for FFI.
+//!
+//! A `HedlIncremental` keeps a parsed document in sync with line-based text
+//! edits. Each edit re-parses only the top-level entries it touches (see
+//! [`hedl_core::IncrementalDocument`]); the resulting document is identical
+//! to a full parse of the edited text.
+//!
+//! # Usage Example (C)
+//!
+//! ```c
+//! HedlIncremental* inc = NULL;
+//! if (hedl_incremental_open(text, text_len, 1, &inc) != HEDL_OK) {
+//!     fprintf(stderr, "%s\n", hedl_get_last_error());
+//!     return;
+//! }
+//!
+//! // Replace line 4 (0-indexed) with a new row
+//! const char* row = "  | u3, Carol\n";
+//! if (hedl_incremental_apply_edit(inc, 4, 5, row, strlen(row)) != HEDL_OK) {
+//!     // Rejected: the document is unchanged
+//! }
+//!
+//! const HedlDocument* doc = hedl_incremental_document(inc);
+//! // ... read doc ...
+//! hedl_incremental_close(inc);
+//! ```
+//!
+//! # Lifetime
+//!
+//! The document returned by `hedl_incremental_document` is owned by the
+//! handle and must NOT be freed. The pointer itself stays the same for the
+//! life of the handle, but traversal handles, value views and strings
+//! obtained through it are invalidated by the next successful edit.
+
+use crate::audit::{audit_call_failure, audit_call_success, sanitize_pointer, AuditTimer};
+use crate::audit_start;
+use crate::error::{clear_error, set_error};
+use crate::types::{HedlDocument, HEDL_ERR_NULL_PTR, HEDL_ERR_PARSE, HEDL_OK};
+use crate::utils::get_input_str_sized;
+use hedl_core::lex::TextEdit;
+use hedl_core::{IncrementalDocument, ParseOptions};
+use std::os::raw::{c_char, c_int};
+use std::ptr;
+
+// =============================================================================
+// Opaque Incremental Handle
+// =============================================================================
+
+/// Opaque handle to a document that is updated in place by text edits.
+///
+/// The document is held in a `HedlDocument`, whose cached lookups each edit
+/// drops.
+pub struct HedlIncremental {
+    inner: IncrementalDocument<HedlDocument>,
+}
+
+/// Parse a document and open an incremental handle on it.
+///
+/// # Arguments
+/// * `input` - UTF-8 encoded HEDL bytes (need not be null-terminated)
+/// * `input_len` - Length of input in bytes
+/// * `strict` - Non-zero for strict mode (validate references) on every edit
+/// * `out_inc` - Pointer to store the handle
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure. Fails exactly when
+/// `hedl_parse_sized` fails for the same input.
+///
+/// # Safety
+/// `input` must point to at least `input_len` readable bytes and `out_inc`
+/// must be valid for writes.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_incremental_open(
+    input: *const c_char,
+    input_len: usize,
+    strict: c_int,
+    out_inc: *mut *mut HedlIncremental,
+) -> c_int {
+    let start = AuditTimer::start();
+
+    audit_start!(
+        "hedl_incremental_open",
+        "input_ptr" => sanitize_pointer(input),
+        "input_len" => input_len.to_string(),
+        "strict" => strict.to_string(),
+        "out_inc" => sanitize_pointer(out_inc),
+    );
+
+    clear_error();
+
+    if input.is_null() || out_inc.is_null() {
+        set_error("Null pointer argument");
+        audit_call_failure(
+            "hedl_incremental_open",
+            HEDL_ERR_NULL_PTR,
+            "Null pointer argument",
+            start.elapsed(),
+        );
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    let input_str = match get_input_str_sized(input, input_len) {
+        Ok(s) => s,
+        Err(code) => {
+            let msg = crate::error::get_thread_local_error();
+            audit_call_failure("hedl_incremental_open", code, &msg, start.elapsed());
+            return code;
+        }
+    };
+
+    let options = ParseOptions {
+        strict_refs: strict != 0,
+        ..Default::default()
+    };
+
+    match IncrementalDocument::new_in(input_str.as_bytes(), options) {
+        Ok(inner) => {
+            *out_inc = Box::into_raw(Box::new(HedlIncremental { inner }));
+            audit_call_success("hedl_incremental_open", start.elapsed());
+            HEDL_OK
+        }
+        Err(e) => {
+            let msg = format!("Parse error: {}", e);
+            set_error(&msg);
+            *out_inc = ptr::null_mut();
+            audit_call_failure(
+                "hedl_incremental_open",
+                HEDL_ERR_PARSE,
+                &msg,
+                start.elapsed(),
+            );
+            HEDL_ERR_PARSE
+        }
+    }
+}
+
+/// Replace a range of lines and re-parse the affected part of the document.
+///
+/// Lines `start_line..end_line` (0-indexed, end exclusive) are replaced with
+/// the lines of `text`. A trailing newline in `text` does not add an empty
+/// line; an empty `text` (which may then be NULL) deletes the range.
+///
+/// # Arguments
+/// * `inc` - Handle from hedl_incremental_open
+/// * `start_line` - First line to replace
+/// * `end_line` - Line after the last one to replace (equal to `start_line`
+///   to insert)
+/// * `text` - UTF-8 replacement text (need not be null-terminated)
+/// * `text_len` - Length of text in bytes
+///
+/// # Returns
+/// HEDL_OK on success. HEDL_ERR_PARSE if the range is out of bounds or the
+/// edited text does not parse; the document and text are then unchanged.
+///
+/// # Safety
+/// `inc` must be a live handle and `text` must point to at least `text_len`
+/// readable bytes. On success every handle previously obtained through
+/// `hedl_incremental_document` other than the document itself is invalidated.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_incremental_apply_edit(
+    inc: *mut HedlIncremental,
+    start_line: usize,
+    end_line: usize,
+    text: *const c_char,
+    text_len: usize,
+) -> c_int {
+    let start = AuditTimer::start();
+
+    audit_start!(
+        "hedl_incremental_apply_edit",
+        "inc" => sanitize_pointer(inc),
+        "start_line" => start_line.to_string(),
+        "end_line" => end_line.to_string(),
+        "text_ptr" => sanitize_pointer(text),
+        "text_len" => text_len.to_string(),
+    );
+
+    clear_error();
+
+    if inc.is_null() || (text.is_null() && text_len != 0) {
+        set_error("Null pointer argument");
+        audit_call_failure(
+            "hedl_incremental_apply_edit",
+            HEDL_ERR_NULL_PTR,
+            "Null pointer argument",
+            start.elapsed(),
+        );
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    let new_text = if text_len == 0 {
+        ""
+    } else {
+        match get_input_str_sized(text, text_len) {
+            Ok(s) => s,
+            Err(code) => {
+                let msg = crate::error::get_thread_local_error();
+                audit_call_failure("hedl_incremental_apply_edit", code, &msg, start.elapsed());
+                return code;
+            }
+        }
+    };
+
+    let edit = TextEdit::replace(start_line, end_line, new_text);
+    match (*inc).inner.apply(&edit) {
+        Ok(()) => {
+            audit_call_success("hedl_incremental_apply_edit", start.elapsed());
+            HEDL_OK
+        }
+        Err(e) => {
+            let msg = format!("Parse error: {}", e);
+            set_error(&msg);
+            audit_call_failure(
+                "hedl_incremental_apply_edit",
+                HEDL_ERR_PARSE,
+                &msg,
+                start.elapsed(),
+            );
+            HEDL_ERR_PARSE
+        }
+    }
+}
+
+/// Get the handle's current document.
+///
+/// The document is owned by the handle: it can be passed to every function
+/// taking a `const HedlDocument*`, but must NOT be freed.
+///
+/// # Safety
+/// `inc` must be a live handle. Returns NULL if it is NULL.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_incremental_document(
+    inc: *const HedlIncremental,
+) -> *const HedlDocument {
+    if inc.is_null() {
+        return ptr::null();
+    }
+    (*inc).inner.holder()
+}
+
+/// Get the number of lines in the handle's current text.
+///
+/// A trailing newline ends an empty last line, so `"a: 1\n"` has two.
+///
+/// # Safety
+/// `inc` must be a live handle. Returns 0 if it is NULL.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_incremental_line_count(inc: *const HedlIncremental) -> usize {
+    if inc.is_null() {
+        return 0;
+    }
+    (*inc).inner.line_count()
+}
+
+/// Close an incremental handle and free its document.
+///
+/// # Safety
+/// The pointer must have been returned by `hedl_incremental_open`. NULL is
+/// ignored.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_incremental_close(inc: *mut HedlIncremental) {
+    if !inc.is_null() {
+        let _ = Box::from_raw(inc);
+    }
+}
@@ -25,9 +25,14 @@
 //! **IMPORTANT:** Memory ownership follows strict rules:
 //!
 //! - Strings returned by `hedl_*` functions MUST be freed with `hedl_free_string`
-//! - Byte arrays returned by `hedl_to_parquet` MUST be freed with `hedl_free_bytes`
+//! - Byte arrays returned by `hedl_to_parquet` and `hedl_to_snapshot` MUST be freed with
+//!   `hedl_free_bytes`
 //! - Documents MUST be freed with `hedl_free_document`
 //! - Diagnostics MUST be freed with `hedl_free_diagnostics`
+//! - Streams MUST be closed with `hedl_stream_close`
+//! - Asynchronous operations MUST be freed with `hedl_async_free`
+//! - Traversal handles (`HedlObject`, `HedlItem`, `HedlList`, `HedlNode`) are
+//!   borrowed from their document and are never freed
 //!
 //! **WARNING - Memory Safety Requirements:**
 //!
@@ -114,6 +119,14 @@
 //! - All functions return error codes (HEDL_OK on success)
 //! - Use `hedl_get_last_error` to get the error message for the current thread
 //!
+//! # Asynchronous Operations
+//!
+//! `hedl_parse_async`, `hedl_parse_file_async` and the `hedl_*_async`
+//! exporters run on the library's async worker threads and report through a
+//! completion callback, so an event loop never blocks on a large parse or
+//! export. Each returns a `HedlAsyncOp` handle for cancellation,
+//! the result and its error message; free it with `hedl_async_free`.
+//!
 //! # Security
 //!
 //! ## Poison Pointers
@@ -129,6 +142,16 @@
 //! after freeing. However, we can detect if a freed pointer is passed back to us
 //! by checking for the poison value in accessor functions.
 //!
+//! # Call Metrics
+//!
+//! `hedl_metrics_enable(1)` starts per-function counters for every audited
+//! entry point: calls, failures, latency bounds and a log2 latency histogram,
+//! plus input and output bytes. Recording uses per-thread atomic shards and
+//! takes no lock on the call path. Read the totals with
+//! `hedl_metrics_snapshot` and clear them with `hedl_metrics_reset`. Metrics
+//! are independent of the `audit` feature and cost one relaxed load per call
+//! while disabled.
+//!
 //! # Audit Logging
 //!
 //! This library provides comprehensive audit logging for all FFI function calls
@@ -200,14 +223,27 @@
 // =============================================================================
 
 pub mod audit;
+mod async_ops;
+mod batch;
 mod conversions;
 mod diagnostics;
+mod diff;
+mod digest;
 mod error;
+mod incremental;
 mod memory;
+mod metrics;
 mod operations;
+mod parser;
 mod parsing;
+mod push;
+mod shared;
+mod snapshot;
+mod streaming;
+mod traversal;
 mod types;
 mod utils;
+mod values;
 
 // =============================================================================
 // Re-exports
@@ -215,9 +251,17 @@ mod utils;
 
 // Types and error codes
 pub use types::{
-    HedlDiagnostics, HedlDocument, HEDL_ERR_ALLOC, HEDL_ERR_CANONICALIZE, HEDL_ERR_CSV,
-    HEDL_ERR_INVALID_UTF8, HEDL_ERR_JSON, HEDL_ERR_LINT, HEDL_ERR_NEO4J, HEDL_ERR_NULL_PTR,
-    HEDL_ERR_PARQUET, HEDL_ERR_PARSE, HEDL_ERR_XML, HEDL_ERR_YAML, HEDL_OK,
+    HedlDiagnostics, HedlDocument, HEDL_ERR_ALLOC, HEDL_ERR_BUFFER_TOO_SMALL, HEDL_ERR_CANCELLED,
+    HEDL_ERR_CANONICALIZE, HEDL_ERR_CSV, HEDL_ERR_INVALID_UTF8, HEDL_ERR_IO, HEDL_ERR_JSON,
+    HEDL_ERR_LINT, HEDL_ERR_NEO4J, HEDL_ERR_NOT_FOUND, HEDL_ERR_NULL_PTR, HEDL_ERR_PARQUET,
+    HEDL_ERR_PARSE, HEDL_ERR_PATCH, HEDL_ERR_SNAPSHOT, HEDL_ERR_TYPE_MISMATCH, HEDL_ERR_XML,
+    HEDL_ERR_YAML, HEDL_OK,
+};
+
+// Borrowed value views
+pub use values::{
+    HedlValueView, HEDL_VALUE_BOOL, HEDL_VALUE_EXPRESSION, HEDL_VALUE_FLOAT, HEDL_VALUE_INT,
+    HEDL_VALUE_NULL, HEDL_VALUE_REFERENCE, HEDL_VALUE_STRING, HEDL_VALUE_TENSOR,
 };
 
 // Error handling
@@ -230,12 +274,113 @@ pub use memory::{hedl_free_bytes, hedl_free_diagnostics, hedl_free_document, hed
 
 // Parsing functions
 pub use parsing::{
-    hedl_alias_count, hedl_get_version, hedl_parse, hedl_root_item_count, hedl_schema_count,
-    hedl_validate,
+    hedl_alias_count, hedl_get_version, hedl_parse, hedl_parse_file, hedl_parse_parallel,
+    hedl_parse_projected, hedl_parse_sized, hedl_root_item_count, hedl_schema_count, hedl_validate,
+    hedl_validate_sized,
+};
+
+// Batch parsing
+pub use batch::hedl_parse_batch;
+
+// Shared documents and multi-format export
+pub use shared::{
+    hedl_document_release, hedl_document_retain, hedl_document_share, hedl_export_multi,
+    HEDL_EXPORT_CYPHER_MERGE, HEDL_EXPORT_METADATA, HEDL_FORMAT_CSV, HEDL_FORMAT_CYPHER,
+    HEDL_FORMAT_HEDL, HEDL_FORMAT_JSON, HEDL_FORMAT_PARQUET, HEDL_FORMAT_XML, HEDL_FORMAT_YAML,
+};
+
+// Binary snapshots
+pub use snapshot::{hedl_from_snapshot, hedl_load_snapshot, hedl_save_snapshot, hedl_to_snapshot};
+
+// Structural diffs
+pub use diff::{hedl_apply_patch, hedl_diff};
+
+// Asynchronous operations
+pub use async_ops::{
+    hedl_async_cancel, hedl_async_error, hedl_async_free, hedl_async_status, hedl_async_take_bytes,
+    hedl_async_take_document, hedl_async_take_string, hedl_async_wait, hedl_canonicalize_async,
+    hedl_parse_async, hedl_parse_file_async, HedlAsyncCallback, HedlAsyncOp, HEDL_ASYNC_PENDING,
+};
+
+#[cfg(feature = "json")]
+pub use async_ops::hedl_to_json_async;
+
+#[cfg(feature = "yaml")]
+pub use async_ops::hedl_to_yaml_async;
+
+#[cfg(feature = "xml")]
+pub use async_ops::hedl_to_xml_async;
+
+#[cfg(feature = "csv")]
+pub use async_ops::hedl_to_csv_async;
+
+#[cfg(feature = "neo4j")]
+pub use async_ops::hedl_to_neo4j_cypher_async;
+
+#[cfg(feature = "parquet")]
+pub use async_ops::hedl_to_parquet_async;
+
+// Reusable parser handles
+pub use parser::{
+    hedl_parser_document_count, hedl_parser_free, hedl_parser_new, hedl_parser_parse,
+    hedl_parser_reset, HedlParser,
+};
+
+// Incremental re-parsing
+pub use incremental::{
+    hedl_incremental_apply_edit, hedl_incremental_close, hedl_incremental_document,
+    hedl_incremental_line_count, hedl_incremental_open, HedlIncremental,
+};
+
+// Streaming parser
+pub use streaming::{
+    hedl_stream_close, hedl_stream_event_column, hedl_stream_event_depth,
+    hedl_stream_event_field_count, hedl_stream_event_id, hedl_stream_event_key,
+    hedl_stream_event_line, hedl_stream_event_parent, hedl_stream_event_row_count,
+    hedl_stream_event_type_name, hedl_stream_event_value, hedl_stream_next, hedl_stream_open,
+    hedl_stream_open_buffer, hedl_stream_struct_count, hedl_stream_struct_get,
+    hedl_stream_version, HedlReadCallback, HedlStream, HEDL_EVENT_END, HEDL_EVENT_LIST_END,
+    HEDL_EVENT_LIST_START, HEDL_EVENT_NODE, HEDL_EVENT_OBJECT_END, HEDL_EVENT_OBJECT_START,
+    HEDL_EVENT_SCALAR,
+};
+
+// Push parser
+pub use push::{
+    hedl_push_parser_feed, hedl_push_parser_finish, hedl_push_parser_free, hedl_push_parser_new,
+    HedlPushEventCallback, HedlPushParser,
+};
+
+// Document traversal
+pub use traversal::{
+    hedl_document_root, hedl_find_node, hedl_item_kind, hedl_item_list, hedl_item_object,
+    hedl_item_value, hedl_list_column, hedl_list_column_count, hedl_list_column_index,
+    hedl_list_row, hedl_list_row_count, hedl_list_type_name, hedl_node_child,
+    hedl_node_child_group_count, hedl_node_children_next, hedl_node_field, hedl_node_field_bool,
+    hedl_node_field_count, hedl_node_field_float, hedl_node_field_int, hedl_node_field_reference,
+    hedl_node_field_string, hedl_node_id, hedl_node_type_name, hedl_object_get, hedl_object_len,
+    hedl_object_next, hedl_resolve_reference, HedlItem, HedlList, HedlNode, HedlObject,
+    HEDL_ITEM_LIST, HEDL_ITEM_OBJECT, HEDL_ITEM_SCALAR,
+};
+
+// Call metrics
+pub use metrics::{
+    hedl_metrics_enable, hedl_metrics_reset, hedl_metrics_snapshot, HedlFunctionMetrics,
+    HEDL_METRICS_BUCKETS,
 };
 
 // Operations
-pub use operations::{hedl_canonicalize, hedl_lint};
+pub use operations::{
+    hedl_canonicalize, hedl_lint, hedl_lint_with_rules, HEDL_LINT_RULES_ALL,
+    HEDL_LINT_RULE_EMPTY_LIST, HEDL_LINT_RULE_ID_NAMING, HEDL_LINT_RULE_UNQUALIFIED_KV_REF,
+    HEDL_LINT_RULE_UNUSED_SCHEMA,
+};
+
+// Canonical digests
+pub use digest::{
+    hedl_canonical_hash, hedl_digests_count, hedl_digests_document, hedl_digests_entry,
+    hedl_digests_free, hedl_digests_get, hedl_digests_new, HedlDigests, HEDL_HASH_BLAKE3,
+    HEDL_HASH_MAX_SIZE, HEDL_HASH_XXH3_128,
+};
 
 // Diagnostics
 pub use diagnostics::{hedl_diagnostics_count, hedl_diagnostics_get, hedl_diagnostics_severity};
@@ -254,43 +399,72 @@ pub use conversions::to_formats::hedl_to_xml;
 pub use conversions::to_formats::hedl_to_csv;
 
 #[cfg(feature = "parquet")]
-pub use conversions::to_formats::hedl_to_parquet;
+pub use conversions::to_formats::{hedl_to_arrow, hedl_to_parquet};
 
 #[cfg(feature = "neo4j")]
-pub use conversions::to_formats::hedl_to_neo4j_cypher;
+pub use conversions::to_formats::{hedl_to_neo4j_batches, hedl_to_neo4j_cypher};
 
 // Zero-copy callback functions (to_*_callback)
-pub use conversions::to_formats_callback::HedlOutputCallback;
+pub use conversions::to_formats_callback::{HedlOutputCallback, HEDL_DEFAULT_CHUNK_SIZE};
 
 #[cfg(feature = "json")]
-pub use conversions::to_formats_callback::hedl_to_json_callback;
+pub use conversions::to_formats_callback::{hedl_to_json_callback, hedl_to_json_callback_chunked};
 
 #[cfg(feature = "yaml")]
-pub use conversions::to_formats_callback::hedl_to_yaml_callback;
+pub use conversions::to_formats_callback::{hedl_to_yaml_callback, hedl_to_yaml_callback_chunked};
 
 #[cfg(feature = "xml")]
-pub use conversions::to_formats_callback::hedl_to_xml_callback;
+pub use conversions::to_formats_callback::{hedl_to_xml_callback, hedl_to_xml_callback_chunked};
 
 #[cfg(feature = "csv")]
-pub use conversions::to_formats_callback::hedl_to_csv_callback;
+pub use conversions::to_formats_callback::{hedl_to_csv_callback, hedl_to_csv_callback_chunked};
 
 #[cfg(feature = "neo4j")]
-pub use conversions::to_formats_callback::hedl_to_neo4j_cypher_callback;
+pub use conversions::to_formats_callback::{
+    hedl_to_neo4j_batches_callback, hedl_to_neo4j_cypher_callback,
+    hedl_to_neo4j_cypher_callback_chunked,
+};
+
+pub use conversions::to_formats_callback::{
+    hedl_canonicalize_callback, hedl_canonicalize_callback_chunked,
+};
+
+// Caller-buffer export functions (to_*_into)
+pub use conversions::to_formats_into::{hedl_canonicalize_into, hedl_estimate_output_size};
+
+#[cfg(feature = "json")]
+pub use conversions::to_formats_into::hedl_to_json_into;
+
+#[cfg(feature = "yaml")]
+pub use conversions::to_formats_into::hedl_to_yaml_into;
+
+#[cfg(feature = "xml")]
+pub use conversions::to_formats_into::hedl_to_xml_into;
+
+#[cfg(feature = "csv")]
+pub use conversions::to_formats_into::hedl_to_csv_into;
 
-pub use conversions::to_formats_callback::hedl_canonicalize_callback;
+#[cfg(feature = "neo4j")]
+pub use conversions::to_formats_into::hedl_to_neo4j_cypher_into;
 
 // Conversion functions (from_*)
 #[cfg(feature = "json")]
-pub use conversions::from_formats::hedl_from_json;
+pub use conversions::from_formats::{hedl_from_json, hedl_from_json_sized};
+
+#[cfg(feature = "json")]
+pub use conversions::json_import::{
+    hedl_from_json_reader, hedl_json_importer_feed, hedl_json_importer_finish,
+    hedl_json_importer_free, hedl_json_importer_new, HedlJsonImporter,
+};
 
 #[cfg(feature = "yaml")]
-pub use conversions::from_formats::hedl_from_yaml;
+pub use conversions::from_formats::{hedl_from_yaml, hedl_from_yaml_sized};
 
 #[cfg(feature = "xml")]
-pub use conversions::from_formats::hedl_from_xml;
+pub use conversions::from_formats::{hedl_from_xml, hedl_from_xml_sized};
 
 #[cfg(feature = "parquet")]
-pub use conversions::from_formats::hedl_from_parquet;
+pub use conversions::from_formats::{hedl_from_arrow, hedl_from_parquet, hedl_from_parquet_file};
 
 // =============================================================================
 // Tests
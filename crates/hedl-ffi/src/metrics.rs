@@ -0,0 +1,545 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//! Per-function call metrics for FFI.
+//!
+//! Every entry point that reports through [`audit_call_success`] or
+//! [`audit_call_failure`] is also counted here once metrics are switched on
+//! with [`hedl_metrics_enable`]: calls, failures, latency (total, bounds and a
+//! log2 histogram) and the bytes it read from or handed back to the caller.
+//!
+//! # Sharding
+//!
+//! Each calling thread owns a shard of atomic counters, one slot per function,
+//! so recording a call is a handful of uncontended relaxed atomic operations
+//! and never takes a lock. The registry lock is taken only when a thread makes
+//! its first call or first sees a function, when it exits, and by
+//! [`hedl_metrics_snapshot`] / [`hedl_metrics_reset`], which sum or clear the
+//! shards of the live threads. An exiting thread folds its counters into a
+//! retired shard and leaves the registry, so hosts that churn through
+//! threads keep one shard per live thread.
+//!
+//! # Bytes
+//!
+//! The shared input and output helpers note byte counts in thread-local
+//! pending totals ([`note_input`], [`note_output`]); the next recorded call on
+//! that thread claims them.
+//!
+//! [`audit_call_success`]: crate::audit::audit_call_success
+//! [`audit_call_failure`]: crate::audit::audit_call_failure
+
+use crate::types::{HEDL_ERR_BUFFER_TOO_SMALL, HEDL_ERR_NULL_PTR, HEDL_OK};
+use std::cell::{Cell, RefCell};
+use std::collections::HashMap;
+use std::ffi::{CStr, CString};
+use std::os::raw::{c_char, c_int};
+use std::sync::atomic::{AtomicBool, AtomicU64, Ordering};
+use std::sync::{Arc, Mutex, OnceLock};
+use std::time::Duration;
+
+/// Number of latency histogram buckets in [`HedlFunctionMetrics`].
+///
+/// Bucket `i` counts calls faster than `2^(i + 10)` nanoseconds that did not
+/// fit a lower bucket: bucket 0 is below ~1 µs, each further bucket doubles
+/// the bound, and the last also holds everything slower.
+pub const HEDL_METRICS_BUCKETS: usize = 32;
+
+/// log2 of the upper bound of bucket 0, in nanoseconds.
+const BUCKET_SHIFT: u32 = 10;
+
+/// Distinct function names a shard can hold; later names are not recorded.
+const MAX_FUNCTIONS: usize = 512;
+
+// =============================================================================
+// Snapshot Record
+// =============================================================================
+
+/// Counters for one FFI function, summed over all threads.
+///
+/// `function` is a null-terminated name that stays valid for the life of the
+/// process. Durations are in nanoseconds; `min_ns` is 0 when no call was
+/// recorded. `bytes_in` counts input text or bytes the call read from the
+/// caller and `bytes_out` the serialized output it returned or streamed.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct HedlFunctionMetrics {
+    pub function: *const c_char,
+    pub calls: u64,
+    pub failures: u64,
+    pub total_ns: u64,
+    pub min_ns: u64,
+    pub max_ns: u64,
+    pub bytes_in: u64,
+    pub bytes_out: u64,
+    pub latency_buckets: [u64; HEDL_METRICS_BUCKETS],
+}
+
+// =============================================================================
+// Registry
+// =============================================================================
+
+static ENABLED: AtomicBool = AtomicBool::new(false);
+
+/// Function names by slot index, the shard of every live recording thread,
+/// and the counters left by threads that have exited.
+struct Registry {
+    names: Vec<(&'static str, &'static CStr)>,
+    index: HashMap<&'static str, usize>,
+    shards: Vec<Arc<Shard>>,
+    retired: Shard,
+}
+
+fn registry() -> &'static Mutex<Registry> {
+    static REGISTRY: OnceLock<Mutex<Registry>> = OnceLock::new();
+    REGISTRY.get_or_init(|| {
+        Mutex::new(Registry {
+            names: Vec::new(),
+            index: HashMap::new(),
+            shards: Vec::new(),
+            retired: Shard::new(),
+        })
+    })
+}
+
+fn lock_registry() -> std::sync::MutexGuard<'static, Registry> {
+    // Counters stay meaningful even if a holder panicked
+    registry().lock().unwrap_or_else(|e| e.into_inner())
+}
+
+impl Registry {
+    /// Slot index for `function`, assigning the next one on first sight.
+    fn intern(&mut self, function: &'static str) -> Option<usize> {
+        if let Some(&id) = self.index.get(function) {
+            return Some(id);
+        }
+        if self.names.len() == MAX_FUNCTIONS {
+            return None;
+        }
+        // Names are static and few, so the C copy is leaked deliberately
+        let c_name: &'static CStr = match CString::new(function) {
+            Ok(c_name) => Box::leak(c_name.into_boxed_c_str()),
+            Err(_) => return None,
+        };
+        let id = self.names.len();
+        self.names.push((function, c_name));
+        self.index.insert(function, id);
+        Some(id)
+    }
+
+    /// Every shard holding counters: live threads' and the retired one.
+    fn all_shards(&self) -> impl Iterator<Item = &Shard> {
+        self.shards
+            .iter()
+            .map(|shard| &**shard)
+            .chain(std::iter::once(&self.retired))
+    }
+}
+
+/// Counters of one function on one thread.
+struct Slot {
+    calls: AtomicU64,
+    failures: AtomicU64,
+    total_ns: AtomicU64,
+    min_ns: AtomicU64,
+    max_ns: AtomicU64,
+    bytes_in: AtomicU64,
+    bytes_out: AtomicU64,
+    buckets: [AtomicU64; HEDL_METRICS_BUCKETS],
+}
+
+impl Slot {
+    fn new() -> Self {
+        Self {
+            calls: AtomicU64::new(0),
+            failures: AtomicU64::new(0),
+            total_ns: AtomicU64::new(0),
+            min_ns: AtomicU64::new(u64::MAX),
+            max_ns: AtomicU64::new(0),
+            bytes_in: AtomicU64::new(0),
+            bytes_out: AtomicU64::new(0),
+            buckets: std::array::from_fn(|_| AtomicU64::new(0)),
+        }
+    }
+
+    fn record(&self, failed: bool, ns: u64, bytes_in: u64, bytes_out: u64) {
+        self.calls.fetch_add(1, Ordering::Relaxed);
+        if failed {
+            self.failures.fetch_add(1, Ordering::Relaxed);
+        }
+        self.total_ns.fetch_add(ns, Ordering::Relaxed);
+        self.min_ns.fetch_min(ns, Ordering::Relaxed);
+        self.max_ns.fetch_max(ns, Ordering::Relaxed);
+        if bytes_in != 0 {
+            self.bytes_in.fetch_add(bytes_in, Ordering::Relaxed);
+        }
+        if bytes_out != 0 {
+            self.bytes_out.fetch_add(bytes_out, Ordering::Relaxed);
+        }
+        self.buckets[bucket(ns)].fetch_add(1, Ordering::Relaxed);
+    }
+
+    fn add_to(&self, out: &mut HedlFunctionMetrics) {
+        out.calls += self.calls.load(Ordering::Relaxed);
+        out.failures += self.failures.load(Ordering::Relaxed);
+        out.total_ns += self.total_ns.load(Ordering::Relaxed);
+        out.min_ns = out.min_ns.min(self.min_ns.load(Ordering::Relaxed));
+        out.max_ns = out.max_ns.max(self.max_ns.load(Ordering::Relaxed));
+        out.bytes_in += self.bytes_in.load(Ordering::Relaxed);
+        out.bytes_out += self.bytes_out.load(Ordering::Relaxed);
+        for (total, bucket) in out.latency_buckets.iter_mut().zip(&self.buckets) {
+            *total += bucket.load(Ordering::Relaxed);
+        }
+    }
+
+    /// Add another slot's counters into this one.
+    fn absorb(&self, other: &Slot) {
+        let load = |counter: &AtomicU64| counter.load(Ordering::Relaxed);
+        self.calls.fetch_add(load(&other.calls), Ordering::Relaxed);
+        self.failures
+            .fetch_add(load(&other.failures), Ordering::Relaxed);
+        self.total_ns
+            .fetch_add(load(&other.total_ns), Ordering::Relaxed);
+        self.min_ns
+            .fetch_min(load(&other.min_ns), Ordering::Relaxed);
+        self.max_ns
+            .fetch_max(load(&other.max_ns), Ordering::Relaxed);
+        self.bytes_in
+            .fetch_add(load(&other.bytes_in), Ordering::Relaxed);
+        self.bytes_out
+            .fetch_add(load(&other.bytes_out), Ordering::Relaxed);
+        for (total, bucket) in self.buckets.iter().zip(&other.buckets) {
+            total.fetch_add(load(bucket), Ordering::Relaxed);
+        }
+    }
+
+    fn reset(&self) {
+        self.calls.store(0, Ordering::Relaxed);
+        self.failures.store(0, Ordering::Relaxed);
+        self.total_ns.store(0, Ordering::Relaxed);
+        self.min_ns.store(u64::MAX, Ordering::Relaxed);
+        self.max_ns.store(0, Ordering::Relaxed);
+        self.bytes_in.store(0, Ordering::Relaxed);
+        self.bytes_out.store(0, Ordering::Relaxed);
+        for bucket in &self.buckets {
+            bucket.store(0, Ordering::Relaxed);
+        }
+    }
+}
+
+/// Histogram bucket for a duration in nanoseconds.
+fn bucket(ns: u64) -> usize {
+    let bits = u64::BITS - ns.leading_zeros();
+    (bits.saturating_sub(BUCKET_SHIFT) as usize).min(HEDL_METRICS_BUCKETS - 1)
+}
+
+/// One thread's slots, allocated on the function's first call.
+struct Shard {
+    slots: Box<[OnceLock<Box<Slot>>]>,
+}
+
+impl Shard {
+    fn new() -> Self {
+        Self {
+            slots: (0..MAX_FUNCTIONS).map(|_| OnceLock::new()).collect(),
+        }
+    }
+}
+
+/// The calling thread's shard, slot lookup cache and pending byte counts.
+struct Local {
+    shard: Arc<Shard>,
+    ids: RefCell<HashMap<&'static str, Option<usize>>>,
+    pending_in: Cell<u64>,
+    pending_out: Cell<u64>,
+}
+
+impl Local {
+    fn register() -> Self {
+        let shard = Arc::new(Shard::new());
+        lock_registry().shards.push(Arc::clone(&shard));
+        Self {
+            shard,
+            ids: RefCell::new(HashMap::new()),
+            pending_in: Cell::new(0),
+            pending_out: Cell::new(0),
+        }
+    }
+
+    fn slot(&self, function: &'static str) -> Option<&Slot> {
+        let cached = self.ids.borrow().get(function).copied();
+        let id = match cached {
+            Some(id) => id,
+            None => {
+                let id = lock_registry().intern(function);
+                self.ids.borrow_mut().insert(function, id);
+                id
+            }
+        }?;
+        Some(self.shard.slots[id].get_or_init(|| Box::new(Slot::new())))
+    }
+}
+
+impl Drop for Local {
+    /// Retire the exiting thread's shard, keeping its counters.
+    fn drop(&mut self) {
+        let mut registry = lock_registry();
+        for (id, slot) in self.shard.slots.iter().enumerate() {
+            if let Some(slot) = slot.get() {
+                registry.retired.slots[id]
+                    .get_or_init(|| Box::new(Slot::new()))
+                    .absorb(slot);
+            }
+        }
+        registry
+            .shards
+            .retain(|shard| !Arc::ptr_eq(shard, &self.shard));
+    }
+}
+
+thread_local! {
+    static LOCAL: Local = Local::register();
+}
+
+// =============================================================================
+// Recording
+// =============================================================================
+
+/// Check whether calls are currently being counted.
+#[inline]
+pub fn metrics_enabled() -> bool {
+    ENABLED.load(Ordering::Relaxed)
+}
+
+/// Count one completed call of `function`, claiming the pending byte counts.
+pub(crate) fn record(function: &'static str, failed: bool, duration: Duration) {
+    if !metrics_enabled() {
+        return;
+    }
+    let ns = u64::try_from(duration.as_nanos()).unwrap_or(u64::MAX);
+    // Threads being torn down have no shard left to record into
+    let _ = LOCAL.try_with(|local| {
+        let bytes_in = local.pending_in.replace(0);
+        let bytes_out = local.pending_out.replace(0);
+        if let Some(slot) = local.slot(function) {
+            slot.record(failed, ns, bytes_in, bytes_out);
+        }
+    });
+}
+
+/// Note input bytes read by the call in progress on this thread.
+#[inline]
+pub(crate) fn note_input(bytes: usize) {
+    if metrics_enabled() {
+        let _ = LOCAL.try_with(|local| local.pending_in.set(local.pending_in.get() + bytes as u64));
+    }
+}
+
+/// Note output bytes produced by the call in progress on this thread.
+#[inline]
+pub(crate) fn note_output(bytes: usize) {
+    if metrics_enabled() {
+        let _ = LOCAL.try_with(|local| {
+            local
+                .pending_out
+                .set(local.pending_out.get() + bytes as u64)
+        });
+    }
+}
+
+// =============================================================================
+// C API
+// =============================================================================
+
+/// Turn call metrics on (non-zero) or off (zero).
+///
+/// Metrics start disabled. While disabled, the audit hooks skip the clock and
+/// recording entirely. Counters already collected are kept across toggles.
+///
+/// # Returns
+/// The previous setting (1 if metrics were enabled, 0 if not).
+#[no_mangle]
+pub extern "C" fn hedl_metrics_enable(enabled: c_int) -> c_int {
+    ENABLED.swap(enabled != 0, Ordering::Relaxed) as c_int
+}
+
+/// Copy the counters of every function called since the last reset.
+///
+/// Writes up to `cap` records to `out`, one per function with at least one
+/// recorded call, sorted by function name, and stores the total number of such
+/// functions in `out_count`. Call with `cap` 0 to size the buffer.
+///
+/// Counters are read without stopping recording threads, so a snapshot taken
+/// during concurrent calls may split a call's counters across two snapshots.
+///
+/// # Arguments
+/// * `out` - Destination array (may be NULL if `cap` is 0)
+/// * `cap` - Number of records `out` can hold
+/// * `out_count` - Receives the number of functions with counters
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_BUFFER_TOO_SMALL if more than `cap` functions
+/// have counters (the first `cap` are still written), HEDL_ERR_NULL_PTR if
+/// `out_count` is NULL or `out` is NULL with a non-zero `cap`.
+///
+/// # Safety
+/// `out` must be valid for writes of `cap` records.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_metrics_snapshot(
+    out: *mut HedlFunctionMetrics,
+    cap: usize,
+    out_count: *mut usize,
+) -> c_int {
+    if out_count.is_null() || (out.is_null() && cap != 0) {
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    let mut records: Vec<(&'static str, HedlFunctionMetrics)> = {
+        let registry = lock_registry();
+        registry
+            .names
+            .iter()
+            .enumerate()
+            .filter_map(|(id, &(name, c_name))| {
+                let mut record = HedlFunctionMetrics {
+                    function: c_name.as_ptr(),
+                    calls: 0,
+                    failures: 0,
+                    total_ns: 0,
+                    min_ns: u64::MAX,
+                    max_ns: 0,
+                    bytes_in: 0,
+                    bytes_out: 0,
+                    latency_buckets: [0; HEDL_METRICS_BUCKETS],
+                };
+                for shard in registry.all_shards() {
+                    if let Some(slot) = shard.slots[id].get() {
+                        slot.add_to(&mut record);
+                    }
+                }
+                if record.calls == 0 {
+                    return None;
+                }
+                Some((name, record))
+            })
+            .collect()
+    };
+    records.sort_unstable_by_key(|&(name, _)| name);
+
+    *out_count = records.len();
+    for (i, (_, mut record)) in records.iter().copied().take(cap).enumerate() {
+        if record.min_ns == u64::MAX {
+            record.min_ns = 0;
+        }
+        out.add(i).write(record);
+    }
+
+    if records.len() > cap {
+        HEDL_ERR_BUFFER_TOO_SMALL
+    } else {
+        HEDL_OK
+    }
+}
+
+/// Clear every function's counters on every thread.
+///
+/// Calls completing while the reset runs may be partly kept.
+#[no_mangle]
+pub extern "C" fn hedl_metrics_reset() {
+    let registry = lock_registry();
+    for shard in registry.all_shards() {
+        for slot in shard.slots.iter().filter_map(OnceLock::get) {
+            slot.reset();
+        }
+    }
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_bucket_bounds() {
+        assert_eq!(bucket(0), 0);
+        assert_eq!(bucket(1023), 0);
+        assert_eq!(bucket(1024), 1);
+        assert_eq!(bucket(2047), 1);
+        assert_eq!(bucket(2048), 2);
+        assert_eq!(bucket(u64::MAX), HEDL_METRICS_BUCKETS - 1);
+    }
+
+    #[test]
+    fn test_slot_record_and_reset() {
+        let slot = Slot::new();
+        slot.record(false, 500, 10, 0);
+        slot.record(true, 5000, 0, 20);
+
+        let mut record = HedlFunctionMetrics {
+            function: std::ptr::null(),
+            calls: 0,
+            failures: 0,
+            total_ns: 0,
+            min_ns: u64::MAX,
+            max_ns: 0,
+            bytes_in: 0,
+            bytes_out: 0,
+            latency_buckets: [0; HEDL_METRICS_BUCKETS],
+        };
+        slot.add_to(&mut record);
+        assert_eq!((record.calls, record.failures), (2, 1));
+        assert_eq!(
+            (record.min_ns, record.max_ns, record.total_ns),
+            (500, 5000, 5500)
+        );
+        assert_eq!((record.bytes_in, record.bytes_out), (10, 20));
+        assert_eq!(record.latency_buckets[0], 1);
+        assert_eq!(record.latency_buckets[bucket(5000)], 1);
+
+        slot.reset();
+        assert_eq!(slot.calls.load(Ordering::Relaxed), 0);
+        assert_eq!(slot.min_ns.load(Ordering::Relaxed), u64::MAX);
+    }
+
+    #[test]
+    fn test_exited_threads_retire_their_shards() {
+        const THREADS: usize = 64;
+        let was_enabled = hedl_metrics_enable(1);
+        for _ in 0..THREADS {
+            std::thread::spawn(|| record("test_retired_shard", false, Duration::from_nanos(50)))
+                .join()
+                .unwrap();
+        }
+        hedl_metrics_enable(was_enabled);
+
+        let registry = lock_registry();
+        // Only threads still running (this one and concurrent tests) keep a shard
+        assert!(
+            registry.shards.len() < THREADS,
+            "{} shards",
+            registry.shards.len()
+        );
+        let id = registry.index["test_retired_shard"];
+        let calls: u64 = registry
+            .all_shards()
+            .filter_map(|shard| shard.slots[id].get())
+            .map(|slot| slot.calls.load(Ordering::Relaxed))
+            .sum();
+        assert_eq!(calls, THREADS as u64);
+    }
+}
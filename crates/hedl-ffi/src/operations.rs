@@ -17,18 +17,17 @@
 
 //! Operations (canonicalize, lint, validate) for FFI.
 
-use crate::audit::{
-    audit_call_failure, audit_call_start, audit_call_success, sanitize_pointer,
-};
+use crate::audit::{audit_call_failure, audit_call_success, sanitize_pointer, AuditTimer};
+use crate::audit_start;
 use crate::error::{clear_error, set_error};
 use crate::memory::is_valid_document_ptr;
 use crate::types::{
     HedlDiagnostics, HedlDocument, HEDL_ERR_CANONICALIZE, HEDL_ERR_NULL_PTR, HEDL_OK,
 };
+use hedl_lint::LintConfig;
 use crate::utils::allocate_output_string;
 use std::os::raw::{c_char, c_int};
 use std::ptr;
-use std::time::Instant;
 
 // =============================================================================
 // Canonicalization
@@ -50,14 +49,12 @@ pub unsafe extern "C" fn hedl_canonicalize(
     doc: *const HedlDocument,
     out_str: *mut *mut c_char,
 ) -> c_int {
-    let start = Instant::now();
+    let start = AuditTimer::start();
 
-    audit_call_start(
+    audit_start!(
         "hedl_canonicalize",
-        &[
-            ("doc", &sanitize_pointer(doc)),
-            ("out_str", &sanitize_pointer(out_str)),
-        ],
+        "doc" => sanitize_pointer(doc),
+        "out_str" => sanitize_pointer(out_str),
     );
 
     clear_error();
@@ -78,7 +75,7 @@ pub unsafe extern "C" fn hedl_canonicalize(
 
     match hedl_c14n::canonicalize(doc_ref) {
         Ok(canonical) => {
-            let result = allocate_output_string(&canonical, out_str, HEDL_ERR_CANONICALIZE);
+            let result = allocate_output_string(canonical, out_str, HEDL_ERR_CANONICALIZE);
             if result == HEDL_OK {
                 audit_call_success("hedl_canonicalize", start.elapsed());
             } else {
@@ -119,14 +116,12 @@ pub unsafe extern "C" fn hedl_lint(
     doc: *const HedlDocument,
     out_diag: *mut *mut HedlDiagnostics,
 ) -> c_int {
-    let start = Instant::now();
+    let start = AuditTimer::start();
 
-    audit_call_start(
+    audit_start!(
         "hedl_lint",
-        &[
-            ("doc", &sanitize_pointer(doc)),
-            ("out_diag", &sanitize_pointer(out_diag)),
-        ],
+        "doc" => sanitize_pointer(doc),
+        "out_diag" => sanitize_pointer(out_diag),
     );
 
     clear_error();
@@ -146,3 +141,107 @@ pub unsafe extern "C" fn hedl_lint(
     audit_call_success("hedl_lint", start.elapsed());
     HEDL_OK
 }
+
+// =============================================================================
+// Rule Selection
+// =============================================================================
+
+/// Rule bit for `id-naming` (short or numeric-only IDs).
+pub const HEDL_LINT_RULE_ID_NAMING: u32 = 1 << 0;
+/// Rule bit for `unused-schema` (%STRUCT never used).
+pub const HEDL_LINT_RULE_UNUSED_SCHEMA: u32 = 1 << 1;
+/// Rule bit for `empty-list` (matrix list without rows).
+pub const HEDL_LINT_RULE_EMPTY_LIST: u32 = 1 << 2;
+/// Rule bit for `unqualified-kv-ref` (`@id` without a type in key-value context).
+pub const HEDL_LINT_RULE_UNQUALIFIED_KV_REF: u32 = 1 << 3;
+/// Every default rule.
+pub const HEDL_LINT_RULES_ALL: u32 = HEDL_LINT_RULE_ID_NAMING
+    | HEDL_LINT_RULE_UNUSED_SCHEMA
+    | HEDL_LINT_RULE_EMPTY_LIST
+    | HEDL_LINT_RULE_UNQUALIFIED_KV_REF;
+
+/// Rule IDs by mask bit.
+const LINT_RULE_IDS: [(u32, &str); 4] = [
+    (HEDL_LINT_RULE_ID_NAMING, "id-naming"),
+    (HEDL_LINT_RULE_UNUSED_SCHEMA, "unused-schema"),
+    (HEDL_LINT_RULE_EMPTY_LIST, "empty-list"),
+    (HEDL_LINT_RULE_UNQUALIFIED_KV_REF, "unqualified-kv-ref"),
+];
+
+/// Lint with a subset of rules, running them in parallel with early exit.
+///
+/// Rules run concurrently on the global rayon pool; the diagnostics are the
+/// same, in the same order, as a sequential run with the same settings.
+///
+/// # Arguments
+/// * `doc` - Document handle from hedl_parse
+/// * `rules` - `HEDL_LINT_RULE_*` mask of rules to run (`HEDL_LINT_RULES_ALL`)
+/// * `error_rules` - Rules whose warnings are reported as errors
+/// * `max_diagnostics` - Stop after this many diagnostics (0 for the default
+///   limit); a final warning notes that the limit was hit
+/// * `stop_on_error` - Non-zero to skip the remaining rules once one has
+///   reported an error
+/// * `out_diag` - Pointer to store diagnostics handle
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_NULL_PTR for a NULL or poisoned pointer.
+///
+/// # Safety
+/// All pointers must be valid.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_lint_with_rules(
+    doc: *const HedlDocument,
+    rules: u32,
+    error_rules: u32,
+    max_diagnostics: usize,
+    stop_on_error: c_int,
+    out_diag: *mut *mut HedlDiagnostics,
+) -> c_int {
+    let start = AuditTimer::start();
+
+    audit_start!(
+        "hedl_lint_with_rules",
+        "doc" => sanitize_pointer(doc),
+        "rules" => format!("{:#x}", rules),
+        "error_rules" => format!("{:#x}", error_rules),
+        "max_diagnostics" => max_diagnostics.to_string(),
+        "stop_on_error" => stop_on_error.to_string(),
+    );
+
+    clear_error();
+
+    if !is_valid_document_ptr(doc) || out_diag.is_null() {
+        let duration = start.elapsed();
+        set_error("Null pointer argument");
+        audit_call_failure(
+            "hedl_lint_with_rules",
+            HEDL_ERR_NULL_PTR,
+            "Null pointer argument",
+            duration,
+        );
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    let mut config = LintConfig {
+        stop_on_error: stop_on_error != 0,
+        parallel: true,
+        ..LintConfig::default()
+    };
+    if max_diagnostics != 0 {
+        config.max_diagnostics = max_diagnostics;
+    }
+    for (bit, rule_id) in LINT_RULE_IDS {
+        if rules & bit == 0 {
+            config.disable_rule(rule_id);
+        } else if error_rules & bit != 0 {
+            config.set_rule_error(rule_id);
+        }
+    }
+
+    let diagnostics = hedl_lint::lint_with_config(&(*doc).inner, config);
+
+    let handle = Box::new(HedlDiagnostics { inner: diagnostics });
+    *out_diag = Box::into_raw(handle);
+    audit_call_success("hedl_lint_with_rules", start.elapsed());
+    HEDL_OK
+}
@@ -0,0 +1,284 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//! Reusable parser handles with bulk document release.
+//!
+//! A `HedlParser` owns every document parsed through it. Handles returned by
+//! `hedl_parser_parse` stay valid until the next `hedl_parser_reset` or
+//! `hedl_parser_free`, and are never freed individually.
+//!
+//! # Release Cost
+//!
+//! Documents are ordinary heap structures (`BTreeMap`, `Vec`, `String`), so
+//! their memory cannot come from a bump arena (see
+//! `hedl_core::lex::ExpressionArena` for why that does not pay off). Instead,
+//! `hedl_parser_reset` detaches the parser's documents in O(1) and hands the
+//! teardown to a background worker, keeping `free()` traffic off the caller's
+//! parse loop.
+//!
+//! At most one batch is torn down in the background at a time: a reset that
+//! finds the previous batch still being dropped drops its own documents on
+//! the calling thread, so a fast reset loop cannot pile up retired documents
+//! or flood the rayon pool that `hedl_parse_batch` and `hedl_export_multi`
+//! share. The worker hands the emptied document table back, so the parser
+//! alternates between two tables instead of allocating one per cycle. The
+//! documents' own allocations are not recycled: the parser builds every
+//! document from fresh collections.
+//!
+//! # Usage Example (C)
+//!
+//! ```c
+//! HedlParser* parser = NULL;
+//! hedl_parser_new(0, &parser);
+//!
+//! for (;;) {
+//!     const HedlDocument* doc = NULL;
+//!     if (hedl_parser_parse(parser, msg, msg_len, &doc) == HEDL_OK) {
+//!         handle(doc);
+//!     }
+//!     if (++n % 1024 == 0) {
+//!         hedl_parser_reset(parser);  // invalidates every doc above
+//!     }
+//! }
+//! hedl_parser_free(parser);
+//! ```
+
+use crate::error::{clear_error, set_error};
+use crate::parsing::parse_input;
+use crate::types::{HedlDocument, HEDL_ERR_NULL_PTR, HEDL_OK};
+use crate::utils::get_input_str_sized;
+use std::os::raw::{c_char, c_int};
+use std::ptr;
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::{Arc, Mutex};
+
+// =============================================================================
+// Opaque Parser Handle
+// =============================================================================
+
+/// Opaque handle to a reusable parser that owns its documents.
+pub struct HedlParser {
+    strict: c_int,
+    docs: Vec<Box<HedlDocument>>,
+    retired: Arc<Retired>,
+}
+
+/// Background teardown shared between a parser and its worker.
+#[derive(Default)]
+struct Retired {
+    /// Set while the worker is dropping a batch.
+    busy: AtomicBool,
+    /// Emptied table handed back by the worker for the next cycle.
+    spare: Mutex<Vec<Box<HedlDocument>>>,
+}
+
+impl HedlParser {
+    /// Detach every owned document and drop them, off the calling thread
+    /// unless the previous batch is still being dropped.
+    fn release(&mut self) {
+        if self.docs.is_empty() {
+            return;
+        }
+        let mut batch = std::mem::take(&mut self.docs);
+        if self.retired.busy.swap(true, Ordering::AcqRel) {
+            batch.clear();
+            self.docs = batch;
+            return;
+        }
+
+        let capacity = batch.len();
+        let spare = &mut *self.retired.spare.lock().unwrap_or_else(|e| e.into_inner());
+        self.docs = std::mem::take(spare);
+        self.docs.reserve(capacity);
+        let retired = Arc::clone(&self.retired);
+        rayon::spawn(move || {
+            batch.clear();
+            *retired.spare.lock().unwrap_or_else(|e| e.into_inner()) = batch;
+            retired.busy.store(false, Ordering::Release);
+        });
+    }
+}
+
+impl Drop for HedlParser {
+    fn drop(&mut self) {
+        self.release();
+    }
+}
+
+/// Create a parser handle.
+///
+/// # Arguments
+/// * `strict` - Non-zero for strict mode (validate references) on every parse
+/// * `out_parser` - Pointer to store the parser handle
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_NULL_PTR if `out_parser` is NULL.
+///
+/// # Safety
+/// `out_parser` must be valid for writes.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_parser_new(strict: c_int, out_parser: *mut *mut HedlParser) -> c_int {
+    clear_error();
+
+    if out_parser.is_null() {
+        set_error("Null pointer argument");
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    *out_parser = Box::into_raw(Box::new(HedlParser {
+        strict,
+        docs: Vec::new(),
+        retired: Arc::default(),
+    }));
+    HEDL_OK
+}
+
+/// Parse a document into the parser.
+///
+/// The returned document is owned by the parser: it can be passed to every
+/// function taking a `const HedlDocument*`, but must NOT be freed with
+/// `hedl_free_document`. It is released by `hedl_parser_reset` or
+/// `hedl_parser_free`.
+///
+/// # Arguments
+/// * `parser` - Parser handle from hedl_parser_new
+/// * `input` - UTF-8 encoded HEDL bytes (need not be null-terminated)
+/// * `input_len` - Length of input in bytes
+/// * `out_doc` - Pointer to store the borrowed document handle
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure.
+///
+/// # Safety
+/// `parser` must be a live parser handle and `input` must point to at least
+/// `input_len` readable bytes.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_parser_parse(
+    parser: *mut HedlParser,
+    input: *const c_char,
+    input_len: usize,
+    out_doc: *mut *const HedlDocument,
+) -> c_int {
+    if parser.is_null() || out_doc.is_null() {
+        set_error("Null pointer argument");
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    let parser = &mut *parser;
+    let mut doc: *mut HedlDocument = ptr::null_mut();
+    let result = parse_input(
+        "hedl_parser_parse",
+        input,
+        Some(input_len),
+        &input_len,
+        parser.strict,
+        0,
+        &mut doc,
+        || get_input_str_sized(input, input_len),
+    );
+
+    if result == HEDL_OK {
+        parser.docs.push(Box::from_raw(doc));
+    }
+    *out_doc = doc;
+    result
+}
+
+/// Get the number of documents currently owned by a parser.
+///
+/// # Safety
+/// `parser` must be a live parser handle. Returns 0 if it is NULL.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_parser_document_count(parser: *const HedlParser) -> usize {
+    if parser.is_null() {
+        return 0;
+    }
+    (*parser).docs.len()
+}
+
+/// Release every document owned by a parser, keeping the parser usable.
+///
+/// Runs in O(1) on the calling thread; the documents are torn down in the
+/// background, or right away if the previous reset's batch is still being
+/// torn down. All handles previously returned by `hedl_parser_parse`
+/// become invalid.
+///
+/// # Safety
+/// `parser` must be a live parser handle. NULL is ignored.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_parser_reset(parser: *mut HedlParser) {
+    if !parser.is_null() {
+        (*parser).release();
+    }
+}
+
+/// Free a parser handle together with every document it owns.
+///
+/// # Safety
+/// The pointer must have been returned by `hedl_parser_new`. NULL is ignored.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_parser_free(parser: *mut HedlParser) {
+    if !parser.is_null() {
+        let _ = Box::from_raw(parser);
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn parser_with_docs(count: usize) -> HedlParser {
+        let mut parser = HedlParser {
+            strict: 0,
+            docs: Vec::new(),
+            retired: Arc::default(),
+        };
+        for i in 0..count {
+            let input = format!("%VERSION: 1.0\n---\nid: {}\n", i);
+            let doc = hedl_core::parse(input.as_bytes()).unwrap();
+            parser.docs.push(Box::new(HedlDocument::new(doc)));
+        }
+        parser
+    }
+
+    #[test]
+    fn test_release_drops_inline_while_a_batch_is_pending() {
+        let mut parser = parser_with_docs(8);
+        let table = parser.docs.as_ptr();
+        parser.retired.busy.store(true, Ordering::Release);
+
+        parser.release();
+        assert!(parser.docs.is_empty());
+        // Dropped here, keeping the table
+        assert_eq!(parser.docs.as_ptr(), table);
+        assert!(parser.docs.capacity() >= 8);
+    }
+
+    #[test]
+    fn test_release_reuses_the_workers_table() {
+        let mut parser = parser_with_docs(8);
+        let table = parser.docs.as_ptr();
+        parser.release();
+
+        // Wait for the worker to hand the emptied table back
+        while parser.retired.busy.load(Ordering::Acquire) {
+            std::thread::yield_now();
+        }
+        let spare = parser.retired.spare.lock().unwrap();
+        assert!(spare.is_empty());
+        assert_eq!(spare.as_ptr(), table);
+    }
+}
@@ -18,23 +18,35 @@
 //! Parsing functions for FFI.
 
 use crate::audit::{
-    audit_call_failure, audit_call_start, audit_call_success, sanitize_c_string, sanitize_pointer,
+    audit_call_failure, audit_call_success, sanitize_c_string, sanitize_pointer, AuditTimer,
 };
+use crate::audit_start;
+use crate::batch::worker_pool;
 use crate::error::{clear_error, set_error};
-use crate::memory::{hedl_free_document, is_valid_document_ptr};
-use crate::types::{HedlDocument, HEDL_ERR_NULL_PTR, HEDL_ERR_PARSE, HEDL_OK};
-use crate::utils::get_input_string;
-use hedl_core::{parse_with_limits, ParseOptions};
+use crate::memory::is_valid_document_ptr;
+use crate::types::{
+    HedlDocument, HEDL_ERR_ALLOC, HEDL_ERR_INVALID_UTF8, HEDL_ERR_NULL_PTR, HEDL_ERR_PARSE,
+    HEDL_OK,
+};
+use crate::utils::{borrow_c_str, get_input_str, get_input_str_sized, map_input_file};
+use hedl_core::{
+    parse_parallel, parse_projected, parse_with_limits, validate, Document, HedlError, Limits,
+    ParseOptions, Projection,
+};
 use std::os::raw::{c_char, c_int};
-use std::ptr;
-use std::time::Instant;
+use std::{ptr, slice};
 
 // =============================================================================
 // Parsing and Validation
 // =============================================================================
 
+/// Number of input bytes shown in audit log previews.
+const INPUT_PREVIEW_LEN: usize = 64;
+
 /// Parse a HEDL document from a string.
 ///
+/// The input is borrowed for the duration of the call, never copied.
+///
 /// # Arguments
 /// * `input` - UTF-8 encoded HEDL document
 /// * `input_len` - Length of input in bytes, or -1 for null-terminated
@@ -53,18 +65,178 @@ pub unsafe extern "C" fn hedl_parse(
     strict: c_int,
     out_doc: *mut *mut HedlDocument,
 ) -> c_int {
-    let start = Instant::now();
-    let input_preview = sanitize_c_string(input, 64);
-
-    audit_call_start(
+    parse_input(
         "hedl_parse",
-        &[
-            ("input_ptr", &sanitize_pointer(input)),
-            ("input_preview", &input_preview),
-            ("input_len", &input_len.to_string()),
-            ("strict", &strict.to_string()),
-            ("out_doc", &sanitize_pointer(out_doc)),
-        ],
+        input,
+        usize::try_from(input_len).ok(),
+        &input_len,
+        strict,
+        0,
+        out_doc,
+        || get_input_str(input, input_len),
+    )
+}
+
+/// Parse a HEDL document from a buffer with a `size_t` length.
+///
+/// Same as [`hedl_parse`] but without the `int` length limit or the
+/// null-terminated mode, and with a caller-chosen input size limit.
+///
+/// # Arguments
+/// * `input` - UTF-8 encoded HEDL bytes (need not be null-terminated)
+/// * `input_len` - Length of input in bytes
+/// * `strict` - Non-zero for strict mode (validate references)
+/// * `max_size` - Largest input accepted in bytes, or 0 for the default
+///   `Limits::max_file_size` (1GB); see [`input_limits`]
+/// * `out_doc` - Pointer to store document handle
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure.
+///
+/// # Safety
+/// `input` must point to at least `input_len` readable bytes.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_parse_sized(
+    input: *const c_char,
+    input_len: usize,
+    strict: c_int,
+    max_size: usize,
+    out_doc: *mut *mut HedlDocument,
+) -> c_int {
+    parse_input(
+        "hedl_parse_sized",
+        input,
+        Some(input_len),
+        &input_len,
+        strict,
+        max_size,
+        out_doc,
+        || get_input_str_sized(input, input_len),
+    )
+}
+
+/// Parse a HEDL document from a file.
+///
+/// The file is memory-mapped and parsed in place, so large documents are
+/// never copied onto the heap. The mapping is released before returning.
+///
+/// # Arguments
+/// * `path` - Null-terminated UTF-8 file path
+/// * `strict` - Non-zero for strict mode (validate references)
+/// * `max_size` - Largest file accepted in bytes, or 0 for the default
+///   `Limits::max_file_size` (1GB); see [`input_limits`]
+/// * `out_doc` - Pointer to store document handle
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_IO if the file cannot be opened or mapped,
+/// error code on other failures.
+///
+/// # Safety
+/// `path` must be a valid null-terminated string. The file must not be
+/// modified or truncated while the call is running.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_parse_file(
+    path: *const c_char,
+    strict: c_int,
+    max_size: usize,
+    out_doc: *mut *mut HedlDocument,
+) -> c_int {
+    // Outlives parse_input so the parser can borrow the mapped bytes
+    let mut mapping = None;
+    let slot = &mut mapping;
+
+    parse_input(
+        "hedl_parse_file",
+        path,
+        None,
+        &"<file>",
+        strict,
+        max_size,
+        out_doc,
+        move || {
+            let bytes = slot.insert(map_input_file(path)?).bytes();
+            std::str::from_utf8(bytes).map_err(|e| {
+                let msg = format!("Invalid UTF-8: {}", e);
+                set_error(&msg);
+                HEDL_ERR_INVALID_UTF8
+            })
+        },
+    )
+}
+
+/// Audit preview of the input.
+///
+/// Null-terminated input (`len == None`) keeps the quoted string preview.
+/// Length-delimited buffers need not contain a terminator and the length has
+/// not been validated yet, so only the size is logged.
+unsafe fn input_preview(input: *const c_char, len: Option<usize>) -> String {
+    match len {
+        Some(len) => format!("<{} bytes>", len),
+        None => sanitize_c_string(input, INPUT_PREVIEW_LEN),
+    }
+}
+
+/// Shared body of `hedl_parse`, `hedl_parse_sized` and `hedl_parser_parse`.
+///
+/// `read_input` borrows the caller's buffer; the parser works on those bytes
+/// directly, so peak memory is the input plus the resulting document.
+/// `preview_len` and `input_len` are only formatted when auditing is enabled.
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn parse_input<'a, R>(
+    fn_name: &'static str,
+    input: *const c_char,
+    preview_len: Option<usize>,
+    input_len: &dyn std::fmt::Display,
+    strict: c_int,
+    max_size: usize,
+    out_doc: *mut *mut HedlDocument,
+    read_input: R,
+) -> c_int
+where
+    R: FnOnce() -> Result<&'a str, c_int>,
+{
+    parse_input_with(
+        fn_name,
+        input,
+        preview_len,
+        input_len,
+        strict,
+        max_size,
+        out_doc,
+        read_input,
+        |bytes, options| parse_with_limits(bytes, options).map_err(parse_failure),
+    )
+}
+
+/// [`parse_input`] with the parse step supplied by the caller.
+///
+/// `parse` reports failures as a status code and message.
+#[allow(clippy::too_many_arguments)]
+unsafe fn parse_input_with<'a, R, P>(
+    fn_name: &'static str,
+    input: *const c_char,
+    preview_len: Option<usize>,
+    input_len: &dyn std::fmt::Display,
+    strict: c_int,
+    max_size: usize,
+    out_doc: *mut *mut HedlDocument,
+    read_input: R,
+    parse: P,
+) -> c_int
+where
+    R: FnOnce() -> Result<&'a str, c_int>,
+    P: FnOnce(&[u8], ParseOptions) -> Result<Document, (c_int, String)>,
+{
+    let start = AuditTimer::start();
+
+    audit_start!(
+        fn_name,
+        "input_ptr" => sanitize_pointer(input),
+        "input_preview" => input_preview(input, preview_len),
+        "input_len" => input_len.to_string(),
+        "strict" => strict.to_string(),
+        "max_size" => max_size.to_string(),
+        "out_doc" => sanitize_pointer(out_doc),
     );
 
     clear_error();
@@ -72,45 +244,225 @@ pub unsafe extern "C" fn hedl_parse(
     if input.is_null() || out_doc.is_null() {
         let duration = start.elapsed();
         set_error("Null pointer argument");
-        audit_call_failure("hedl_parse", HEDL_ERR_NULL_PTR, "Null pointer argument", duration);
+        audit_call_failure(fn_name, HEDL_ERR_NULL_PTR, "Null pointer argument", duration);
         return HEDL_ERR_NULL_PTR;
     }
 
-    let input_str = match get_input_string(input, input_len) {
+    let input_str = match read_input() {
         Ok(s) => s,
         Err(code) => {
             let duration = start.elapsed();
             let msg = crate::error::get_thread_local_error();
-            audit_call_failure("hedl_parse", code, &msg, duration);
+            audit_call_failure(fn_name, code, &msg, duration);
             return code;
         }
     };
 
     let options = ParseOptions {
+        limits: input_limits(max_size),
         strict_refs: strict != 0,
-        ..Default::default()
     };
 
-    match parse_with_limits(input_str.as_bytes(), options) {
+    match parse(input_str.as_bytes(), options) {
         Ok(doc) => {
-            let handle = Box::new(HedlDocument { inner: doc });
+            let handle = Box::new(HedlDocument::new(doc));
             *out_doc = Box::into_raw(handle);
-            audit_call_success("hedl_parse", start.elapsed());
+            audit_call_success(fn_name, start.elapsed());
             HEDL_OK
         }
-        Err(e) => {
+        Err((code, msg)) => {
             let duration = start.elapsed();
-            let msg = format!("Parse error: {}", e);
             set_error(&msg);
             *out_doc = ptr::null_mut();
-            audit_call_failure("hedl_parse", HEDL_ERR_PARSE, &msg, duration);
-            HEDL_ERR_PARSE
+            audit_call_failure(fn_name, code, &msg, duration);
+            code
         }
     }
 }
 
+/// Parse limits for a caller-chosen input size limit of `max_size` bytes.
+///
+/// 0 keeps [`Limits::default`]. The default node and key budgets are sized
+/// for the default 1GB input, so a larger `max_size` raises them by the same
+/// factor; otherwise a file that fits the size limit would still be rejected
+/// for its row count.
+pub(crate) fn input_limits(max_size: usize) -> Limits {
+    let mut limits = Limits::default();
+    if max_size == 0 {
+        return limits;
+    }
+    let scale = max_size / limits.max_file_size + 1;
+    if scale > 1 {
+        limits.max_nodes = limits.max_nodes.saturating_mul(scale);
+        limits.max_total_keys = limits.max_total_keys.saturating_mul(scale);
+    }
+    limits.max_file_size = max_size;
+    limits
+}
+
+/// Status code and message for a failed parse.
+fn parse_failure(e: HedlError) -> (c_int, String) {
+    (HEDL_ERR_PARSE, format!("Parse error: {}", e))
+}
+
+// =============================================================================
+// Parallel Parsing
+// =============================================================================
+
+/// Parse a HEDL document, spreading long matrix lists across threads.
+///
+/// Produces the same document, or the same error, as [`hedl_parse_sized`].
+/// Matrix lists of a few thousand rows or more are split into chunks whose
+/// rows are parsed in parallel; everything else is parsed sequentially.
+///
+/// # Arguments
+/// * `input` - UTF-8 encoded HEDL bytes (need not be null-terminated)
+/// * `input_len` - Length of input in bytes
+/// * `strict` - Non-zero for strict mode (validate references)
+/// * `threads` - Worker count: 0 for one per core, 1 for the calling thread only;
+///   larger counts are capped at the core count
+/// * `out_doc` - Pointer to store document handle
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_ALLOC if the thread pool cannot be created,
+/// error code on other failures.
+///
+/// # Safety
+/// `input` must point to at least `input_len` readable bytes.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_parse_parallel(
+    input: *const c_char,
+    input_len: usize,
+    strict: c_int,
+    threads: c_int,
+    out_doc: *mut *mut HedlDocument,
+) -> c_int {
+    parse_input_with(
+        "hedl_parse_parallel",
+        input,
+        Some(input_len),
+        &input_len,
+        strict,
+        0,
+        out_doc,
+        || get_input_str_sized(input, input_len),
+        |bytes, options| match threads {
+            1 => parse_with_limits(bytes, options).map_err(parse_failure),
+            t if t <= 0 => parse_parallel(bytes, options).map_err(parse_failure),
+            t => {
+                let pool = worker_pool(t as usize).map_err(|msg| (HEDL_ERR_ALLOC, msg))?;
+                pool.install(|| parse_parallel(bytes, options)).map_err(parse_failure)
+            }
+        },
+    )
+}
+
+// =============================================================================
+// Projected Parsing
+// =============================================================================
+
+/// Parse only some keys and columns of a HEDL document.
+///
+/// Items outside `keys` are skipped over without being parsed, and cells
+/// outside `columns` are never converted to values, so the cost follows the
+/// size of the projected data rather than of the document. In strict mode,
+/// references from the kept data into skipped lists still resolve: the IDs
+/// of skipped rows are read when a kept value is a reference. Errors inside
+/// skipped items are not reported.
+///
+/// # Arguments
+/// * `input` - UTF-8 encoded HEDL bytes (need not be null-terminated)
+/// * `input_len` - Length of input in bytes
+/// * `strict` - Non-zero for strict mode (validate references)
+/// * `keys` - Dotted key paths to keep (`"config.database"`), or NULL to
+///   keep every root key
+/// * `n_keys` - Number of entries in `keys`
+/// * `columns` - `"Type.column"` entries naming the columns to keep for
+///   `%STRUCT` types, or NULL for all columns. Projected types keep their
+///   ID column and their schemas list the kept columns only.
+/// * `n_columns` - Number of entries in `columns`
+/// * `out_doc` - Pointer to store document handle
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_PARSE for parse errors and for column
+/// entries naming an unknown type or column, error code on other failures.
+///
+/// # Safety
+/// `input` must point to at least `input_len` readable bytes. Every `keys`
+/// and `columns` entry must be a valid null-terminated string; non-NULL
+/// arrays must hold at least their stated number of elements.
+#[no_mangle]
+#[allow(clippy::too_many_arguments)]
+pub unsafe extern "C" fn hedl_parse_projected(
+    input: *const c_char,
+    input_len: usize,
+    strict: c_int,
+    keys: *const *const c_char,
+    n_keys: usize,
+    columns: *const *const c_char,
+    n_columns: usize,
+    out_doc: *mut *mut HedlDocument,
+) -> c_int {
+    parse_input_with(
+        "hedl_parse_projected",
+        input,
+        Some(input_len),
+        &input_len,
+        strict,
+        0,
+        out_doc,
+        || get_input_str_sized(input, input_len),
+        |bytes, options| {
+            let projection = read_projection(keys, n_keys, columns, n_columns)?;
+            parse_projected(bytes, options, &projection).map_err(parse_failure)
+        },
+    )
+}
+
+/// Build a [`Projection`] from the C arrays of [`hedl_parse_projected`].
+unsafe fn read_projection(
+    keys: *const *const c_char,
+    n_keys: usize,
+    columns: *const *const c_char,
+    n_columns: usize,
+) -> Result<Projection, (c_int, String)> {
+    let entries = |array: *const *const c_char, len: usize| {
+        if array.is_null() {
+            return Ok(Vec::new());
+        }
+        slice::from_raw_parts(array, len)
+            .iter()
+            .map(|&entry| {
+                if entry.is_null() {
+                    return Err((HEDL_ERR_NULL_PTR, "Null projection entry".to_string()));
+                }
+                borrow_c_str(entry)
+            })
+            .collect::<Result<Vec<&str>, _>>()
+    };
+
+    let mut projection = Projection::new();
+    for key in entries(keys, n_keys)? {
+        projection = projection.key(key);
+    }
+    for column in entries(columns, n_columns)? {
+        let Some((type_name, name)) = column.split_once('.') else {
+            return Err((
+                HEDL_ERR_PARSE,
+                format!("Invalid column projection '{}': expected Type.column", column),
+            ));
+        };
+        projection = projection.columns(type_name, [name]);
+    }
+    Ok(projection)
+}
+
 /// Validate a HEDL document string.
 ///
+/// Runs every check [`hedl_parse`] runs, including strict reference
+/// resolution, without building a document: memory stays proportional to
+/// the number of node IDs rather than the size of the document tree.
+///
 /// # Arguments
 /// * `input` - UTF-8 encoded HEDL document
 /// * `input_len` - Length of input in bytes, or -1 for null-terminated
@@ -127,12 +479,115 @@ pub unsafe extern "C" fn hedl_validate(
     input_len: c_int,
     strict: c_int,
 ) -> c_int {
-    let mut doc: *mut HedlDocument = ptr::null_mut();
-    let result = hedl_parse(input, input_len, strict, &mut doc);
-    if !doc.is_null() {
-        hedl_free_document(doc);
+    validate_input(
+        "hedl_validate",
+        input,
+        usize::try_from(input_len).ok(),
+        &input_len,
+        strict,
+        0,
+        || get_input_str(input, input_len),
+    )
+}
+
+/// Validate a HEDL document buffer with a `size_t` length.
+///
+/// Same as [`hedl_validate`] but without the `int` length limit or the
+/// null-terminated mode, and with a caller-chosen input size limit.
+///
+/// # Arguments
+/// * `input` - UTF-8 encoded HEDL bytes (need not be null-terminated)
+/// * `input_len` - Length of input in bytes
+/// * `strict` - Non-zero for strict mode
+/// * `max_size` - Largest input accepted in bytes, or 0 for the default (1GB)
+///
+/// # Returns
+/// HEDL_OK if valid, error code if invalid.
+///
+/// # Safety
+/// `input` must point to at least `input_len` readable bytes.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_validate_sized(
+    input: *const c_char,
+    input_len: usize,
+    strict: c_int,
+    max_size: usize,
+) -> c_int {
+    validate_input(
+        "hedl_validate_sized",
+        input,
+        Some(input_len),
+        &input_len,
+        strict,
+        max_size,
+        || get_input_str_sized(input, input_len),
+    )
+}
+
+/// Shared body of `hedl_validate` and `hedl_validate_sized`.
+///
+/// Reports the same codes and messages as [`parse_input`] would for the
+/// same input.
+unsafe fn validate_input<'a, R>(
+    fn_name: &'static str,
+    input: *const c_char,
+    preview_len: Option<usize>,
+    input_len: &dyn std::fmt::Display,
+    strict: c_int,
+    max_size: usize,
+    read_input: R,
+) -> c_int
+where
+    R: FnOnce() -> Result<&'a str, c_int>,
+{
+    let start = AuditTimer::start();
+
+    audit_start!(
+        fn_name,
+        "input_ptr" => sanitize_pointer(input),
+        "input_preview" => input_preview(input, preview_len),
+        "input_len" => input_len.to_string(),
+        "strict" => strict.to_string(),
+        "max_size" => max_size.to_string(),
+    );
+
+    clear_error();
+
+    if input.is_null() {
+        let duration = start.elapsed();
+        set_error("Null pointer argument");
+        audit_call_failure(fn_name, HEDL_ERR_NULL_PTR, "Null pointer argument", duration);
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    let input_str = match read_input() {
+        Ok(s) => s,
+        Err(code) => {
+            let duration = start.elapsed();
+            let msg = crate::error::get_thread_local_error();
+            audit_call_failure(fn_name, code, &msg, duration);
+            return code;
+        }
+    };
+
+    let options = ParseOptions {
+        limits: input_limits(max_size),
+        strict_refs: strict != 0,
+    };
+
+    match validate(input_str.as_bytes(), options) {
+        Ok(()) => {
+            audit_call_success(fn_name, start.elapsed());
+            HEDL_OK
+        }
+        Err(e) => {
+            let duration = start.elapsed();
+            let msg = format!("Parse error: {}", e);
+            set_error(&msg);
+            audit_call_failure(fn_name, HEDL_ERR_PARSE, &msg, duration);
+            HEDL_ERR_PARSE
+        }
     }
-    result
 }
 
 // =============================================================================
@@ -0,0 +1,506 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Push-based streaming parser for FFI.
+//!
+//! The pull parser in [`crate::streaming`] asks for input through a read
+//! callback. Network code usually works the other way round: frames arrive
+//! and must be handed over as they come. A push parser accepts input in
+//! arbitrary chunks via `hedl_push_parser_feed` and fires an event callback
+//! for every event those chunks complete, so parsing keeps pace with the
+//! socket instead of waiting for the whole message.
+//!
+//! # Chunk Boundaries
+//!
+//! Chunks can split anywhere, including inside a line or a multi-byte UTF-8
+//! sequence. Only complete lines are released to the underlying
+//! [`StreamingParser`]; the trailing partial line waits for the next chunk.
+//! The parser consumes exactly one line per step and signals "no input yet"
+//! before touching any state, so its indentation and list context carry over
+//! unchanged from one chunk to the next. The same holds for a block string
+//! (`key: """`): its lines are collected in that state and the scalar event
+//! fires once the chunk holding the closing `"""` arrives.
+//!
+//! # Usage Example (C)
+//!
+//! ```c
+//! void on_event(const HedlStream* stream, int event, void* user_data) {
+//!     if (event == HEDL_EVENT_NODE) {
+//!         const char* id;
+//!         size_t id_len;
+//!         hedl_stream_event_id(stream, &id, &id_len);
+//!         // ...
+//!     }
+//! }
+//!
+//! HedlPushParser* parser = NULL;
+//! hedl_push_parser_new(on_event, &ctx, &parser);
+//! while ((n = recv(sock, frame, sizeof(frame), 0)) > 0) {
+//!     if (hedl_push_parser_feed(parser, frame, (size_t)n) != HEDL_OK) break;
+//! }
+//! hedl_push_parser_finish(parser);   // delivers the final events and HEDL_EVENT_END
+//! hedl_push_parser_free(parser);
+//! ```
+
+use crate::audit::{audit_call_failure, audit_call_success, sanitize_pointer, AuditTimer};
+use crate::audit_start;
+use crate::error::{clear_error, set_error};
+use crate::streaming::{event_kind, stream_error_code, HedlStream, HEDL_EVENT_END};
+use crate::types::{HEDL_ERR_IO, HEDL_ERR_NULL_PTR, HEDL_ERR_PARSE, HEDL_OK};
+use hedl_stream::{StreamError, StreamingParser, StreamingParserConfig};
+use std::cell::RefCell;
+use std::io::{self, Read};
+use std::os::raw::{c_char, c_int, c_void};
+use std::rc::Rc;
+use std::slice;
+
+/// Event callback invoked by the push parser.
+///
+/// `stream` can be passed to the `hedl_stream_event_*` and header accessors;
+/// it and every pointer obtained from it are only valid during the call. The
+/// callback MUST NOT call `hedl_stream_next`, `hedl_stream_close` or any
+/// `hedl_push_parser_*` function.
+pub type HedlPushEventCallback =
+    unsafe extern "C" fn(stream: *const HedlStream, event: c_int, user_data: *mut c_void);
+
+// =============================================================================
+// Input Buffer
+// =============================================================================
+
+/// Bytes fed so far that the parser has not consumed yet.
+struct Feed {
+    data: Vec<u8>,
+    /// Read position of the parser.
+    pos: usize,
+    /// End of the last complete line; bytes past it are a partial line.
+    line_end: usize,
+    /// Header scan position (only used before the parser exists).
+    scan_pos: usize,
+    /// Set by `hedl_push_parser_finish`: the partial line becomes readable.
+    finished: bool,
+}
+
+impl Feed {
+    fn push(&mut self, chunk: &[u8]) {
+        if let Some(last_newline) = chunk.iter().rposition(|&b| b == b'\n') {
+            self.line_end = self.data.len() + last_newline + 1;
+        }
+        self.data.extend_from_slice(chunk);
+    }
+
+    fn readable_end(&self) -> usize {
+        if self.finished {
+            self.data.len()
+        } else {
+            self.line_end
+        }
+    }
+
+    fn pending_line_len(&self) -> usize {
+        self.data.len() - self.line_end
+    }
+
+    /// Whether the header is complete, so constructing the parser (which
+    /// reads the header eagerly) cannot run out of input.
+    ///
+    /// Mirrors the header rules of `StreamingParser`: the header ends at
+    /// `---` or at the first line that is not blank, a comment or a directive.
+    fn header_ready(&mut self) -> bool {
+        if self.finished {
+            return true;
+        }
+        while let Some(len) = self.data[self.scan_pos..self.line_end]
+            .iter()
+            .position(|&b| b == b'\n')
+        {
+            let line = &self.data[self.scan_pos..self.scan_pos + len];
+            self.scan_pos += len + 1;
+            let trimmed = trim_ascii(line);
+            if trimmed == b"---"
+                || !(trimmed.is_empty() || trimmed[0] == b'#' || trimmed[0] == b'%')
+            {
+                return true;
+            }
+        }
+        false
+    }
+
+    /// Drop consumed bytes once they make up at least half the buffer.
+    fn compact(&mut self) {
+        if self.pos > 0 && self.pos * 2 >= self.data.len() {
+            self.data.drain(..self.pos);
+            self.line_end = self.line_end.saturating_sub(self.pos);
+            self.scan_pos = self.scan_pos.saturating_sub(self.pos);
+            self.pos = 0;
+        }
+    }
+}
+
+fn trim_ascii(mut bytes: &[u8]) -> &[u8] {
+    while let [first, rest @ ..] = bytes {
+        if !first.is_ascii_whitespace() {
+            break;
+        }
+        bytes = rest;
+    }
+    while let [rest @ .., last] = bytes {
+        if !last.is_ascii_whitespace() {
+            break;
+        }
+        bytes = rest;
+    }
+    bytes
+}
+
+/// `Read` over the complete lines of a [`Feed`].
+///
+/// Reports `WouldBlock` when it runs out of complete lines before
+/// `hedl_push_parser_finish`, and end of input afterwards.
+struct FeedReader(Rc<RefCell<Feed>>);
+
+impl Read for FeedReader {
+    fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+        let mut feed = self.0.borrow_mut();
+        let available = feed.readable_end() - feed.pos;
+        if available == 0 {
+            return if feed.finished || buf.is_empty() {
+                Ok(0)
+            } else {
+                Err(io::ErrorKind::WouldBlock.into())
+            };
+        }
+        let n = available.min(buf.len());
+        let start = feed.pos;
+        buf[..n].copy_from_slice(&feed.data[start..start + n]);
+        feed.pos += n;
+        Ok(n)
+    }
+}
+
+// =============================================================================
+// Opaque Push Parser Handle
+// =============================================================================
+
+/// Opaque handle to a push parser.
+pub struct HedlPushParser {
+    feed: Rc<RefCell<Feed>>,
+    /// Created once the header has fully arrived.
+    stream: Option<HedlStream>,
+    callback: HedlPushEventCallback,
+    user_data: *mut c_void,
+    max_line_length: usize,
+    /// First error code; the parser refuses further input once set.
+    error: c_int,
+    /// `HEDL_EVENT_END` has been delivered.
+    done: bool,
+}
+
+impl HedlPushParser {
+    fn fail(&mut self, code: c_int) -> c_int {
+        self.error = code;
+        code
+    }
+
+    /// Run the parser over all complete lines fed so far.
+    fn drive(&mut self) -> c_int {
+        if self.stream.is_none() {
+            if !self.feed.borrow_mut().header_ready() {
+                return HEDL_OK;
+            }
+            let reader: Box<dyn Read> = Box::new(FeedReader(Rc::clone(&self.feed)));
+            match StreamingParser::new(reader) {
+                Ok(parser) => self.stream = Some(HedlStream::new(parser)),
+                Err(e) => return self.fail(stream_error_code(&e)),
+            }
+        }
+
+        let mut result = HEDL_OK;
+        if let Some(stream) = self.stream.as_mut() {
+            while !self.done {
+                match stream.parser.next() {
+                    Some(Ok(event)) => {
+                        let kind = event_kind(&event);
+                        stream.current = Some(event);
+                        // SAFETY: upheld by the contract of `hedl_push_parser_new`.
+                        unsafe { (self.callback)(stream as *const HedlStream, kind, self.user_data) };
+                        stream.current = None;
+                    }
+                    Some(Err(StreamError::Io(ref e))) if e.kind() == io::ErrorKind::WouldBlock => {
+                        break;
+                    }
+                    Some(Err(e)) => {
+                        result = stream_error_code(&e);
+                        break;
+                    }
+                    None => {
+                        self.done = true;
+                        // SAFETY: as above.
+                        unsafe {
+                            (self.callback)(stream as *const HedlStream, HEDL_EVENT_END, self.user_data)
+                        };
+                    }
+                }
+            }
+        }
+
+        self.feed.borrow_mut().compact();
+        if result != HEDL_OK {
+            return self.fail(result);
+        }
+        HEDL_OK
+    }
+
+    /// Reject calls after a failure or after finishing.
+    fn check_usable(&self) -> Result<(), c_int> {
+        if self.error != HEDL_OK {
+            set_error("Push parser stopped after an earlier error");
+            return Err(self.error);
+        }
+        if self.feed.borrow().finished {
+            set_error("Push parser is already finished");
+            return Err(HEDL_ERR_IO);
+        }
+        Ok(())
+    }
+}
+
+// =============================================================================
+// Push Parser API
+// =============================================================================
+
+/// Create a push parser that reports events through a callback.
+///
+/// # Arguments
+/// * `callback` - Function receiving each event
+/// * `user_data` - User context pointer passed to the callback
+/// * `out_parser` - Pointer to store the handle (free with hedl_push_parser_free)
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure.
+///
+/// # Safety
+/// - `out_parser` must be valid
+/// - `user_data` must remain valid until `hedl_push_parser_free`
+/// - The callback must follow the rules of [`HedlPushEventCallback`]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_push_parser_new(
+    callback: Option<HedlPushEventCallback>,
+    user_data: *mut c_void,
+    out_parser: *mut *mut HedlPushParser,
+) -> c_int {
+    let start = AuditTimer::start();
+
+    audit_start!(
+        "hedl_push_parser_new",
+        "user_data" => sanitize_pointer(user_data),
+        "out_parser" => sanitize_pointer(out_parser),
+    );
+
+    clear_error();
+
+    let callback = match callback {
+        Some(cb) if !out_parser.is_null() => cb,
+        _ => {
+            set_error("Null pointer argument");
+            audit_call_failure(
+                "hedl_push_parser_new",
+                HEDL_ERR_NULL_PTR,
+                "Null pointer argument",
+                start.elapsed(),
+            );
+            return HEDL_ERR_NULL_PTR;
+        }
+    };
+
+    let parser = Box::new(HedlPushParser {
+        feed: Rc::new(RefCell::new(Feed {
+            data: Vec::new(),
+            pos: 0,
+            line_end: 0,
+            scan_pos: 0,
+            finished: false,
+        })),
+        stream: None,
+        callback,
+        user_data,
+        max_line_length: StreamingParserConfig::default().max_line_length,
+        error: HEDL_OK,
+        done: false,
+    });
+    *out_parser = Box::into_raw(parser);
+
+    audit_call_success("hedl_push_parser_new", start.elapsed());
+    HEDL_OK
+}
+
+/// Feed the next chunk of input.
+///
+/// The chunk is copied, so the caller may reuse its buffer immediately.
+/// Events completed by this chunk are delivered before the function returns;
+/// a trailing partial line is held until more input or
+/// `hedl_push_parser_finish` arrives.
+///
+/// # Arguments
+/// * `parser` - Push parser handle
+/// * `chunk` - Input bytes (may be NULL if `len` is 0)
+/// * `len` - Number of bytes in `chunk`
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure. After an error the parser
+/// rejects further input and only `hedl_push_parser_free` is meaningful.
+///
+/// # Safety
+/// `chunk` must point to at least `len` readable bytes.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_push_parser_feed(
+    parser: *mut HedlPushParser,
+    chunk: *const c_char,
+    len: usize,
+) -> c_int {
+    if parser.is_null() || (chunk.is_null() && len != 0) {
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    clear_error();
+
+    let p = &mut *parser;
+    if let Err(code) = p.check_usable() {
+        return code;
+    }
+    if len == 0 {
+        return HEDL_OK;
+    }
+
+    let bytes = slice::from_raw_parts(chunk as *const u8, len);
+    let pending = {
+        let mut feed = p.feed.borrow_mut();
+        feed.push(bytes);
+        feed.pending_line_len()
+    };
+    if pending > p.max_line_length {
+        set_error(&format!(
+            "Line exceeds maximum length of {} bytes",
+            p.max_line_length
+        ));
+        return p.fail(HEDL_ERR_PARSE);
+    }
+
+    p.drive()
+}
+
+/// Signal end of input and deliver the remaining events.
+///
+/// Any trailing line without a newline is parsed, open lists are closed and
+/// `HEDL_EVENT_END` is delivered as the last event.
+///
+/// # Arguments
+/// * `parser` - Push parser handle
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure.
+///
+/// # Safety
+/// `parser` must be valid.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_push_parser_finish(parser: *mut HedlPushParser) -> c_int {
+    if parser.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    clear_error();
+
+    let p = &mut *parser;
+    if let Err(code) = p.check_usable() {
+        return code;
+    }
+
+    p.feed.borrow_mut().finished = true;
+    p.drive()
+}
+
+/// Free a push parser handle. Events not yet delivered are discarded.
+///
+/// # Safety
+/// The pointer must have been returned by `hedl_push_parser_new`. NULL is ignored.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_push_parser_free(parser: *mut HedlPushParser) {
+    if !parser.is_null() {
+        let _ = Box::from_raw(parser);
+    }
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn feed_with(chunks: &[&[u8]]) -> Rc<RefCell<Feed>> {
+        let feed = Rc::new(RefCell::new(Feed {
+            data: Vec::new(),
+            pos: 0,
+            line_end: 0,
+            scan_pos: 0,
+            finished: false,
+        }));
+        for chunk in chunks {
+            feed.borrow_mut().push(chunk);
+        }
+        feed
+    }
+
+    #[test]
+    fn test_feed_reader_holds_partial_line() {
+        let feed = feed_with(&[b"ab\ncd", b"e"]);
+        let mut reader = FeedReader(Rc::clone(&feed));
+        let mut buf = [0u8; 16];
+
+        assert_eq!(reader.read(&mut buf).unwrap(), 3);
+        assert_eq!(&buf[..3], b"ab\n");
+        let err = reader.read(&mut buf).unwrap_err();
+        assert_eq!(err.kind(), io::ErrorKind::WouldBlock);
+
+        feed.borrow_mut().finished = true;
+        assert_eq!(reader.read(&mut buf).unwrap(), 3);
+        assert_eq!(&buf[..3], b"cde");
+        assert_eq!(reader.read(&mut buf).unwrap(), 0);
+    }
+
+    #[test]
+    fn test_header_ready_waits_for_separator() {
+        let feed = feed_with(&[b"%VERSION: 1.0\n%STRUCT: A: [id]\n-"]);
+        assert!(!feed.borrow_mut().header_ready());
+        feed.borrow_mut().push(b"--\n");
+        assert!(feed.borrow_mut().header_ready());
+
+        let feed = feed_with(&[b"%VERSION: 1.0\n# comment\nkey: 1\n"]);
+        assert!(feed.borrow_mut().header_ready());
+    }
+
+    #[test]
+    fn test_compact_keeps_unread_bytes() {
+        let feed = feed_with(&[b"aaaa\nbb"]);
+        feed.borrow_mut().pos = 5;
+        feed.borrow_mut().compact();
+        let feed = feed.borrow();
+        assert_eq!(feed.data, b"bb");
+        assert_eq!(feed.pos, 0);
+        assert_eq!(feed.line_end, 0);
+    }
+}
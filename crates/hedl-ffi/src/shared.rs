@@ -0,0 +1,360 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Reference-counted shared documents and concurrent multi-format export.
+//!
+//! Every read-only call takes a `const HedlDocument*` and never mutates the
+//! document (lookups cache their index behind a lock, errors are
+//! thread-local), so one document may be read by any number of threads at
+//! once. What C code lacks is a way to know when the last reader is done.
+//! `hedl_document_share` turns an owned document into a shared handle with
+//! a reference count: each thread takes a reference with
+//! `hedl_document_retain` and drops it with `hedl_document_release`, and the
+//! document is freed with the last release.
+//!
+//! A shared handle is an ordinary `const HedlDocument*`, so every exporter,
+//! accessor and `*_async` function accepts it unchanged.
+//!
+//! # Multi-format Export
+//!
+//! `hedl_export_multi` serializes one document to several formats in a
+//! single call, running the formats in parallel on the worker pool. Results
+//! are returned per slot, as in `hedl_parse_batch`.
+//!
+//! # Usage Example (C)
+//!
+//! ```c
+//! const HedlDocument* shared = NULL;
+//! hedl_document_share(doc, &shared);          // doc now belongs to shared
+//!
+//! hedl_document_retain(shared);               // one reference per thread
+//! start_worker(shared);                       // worker calls hedl_document_release
+//!
+//! int formats[] = {HEDL_FORMAT_JSON, HEDL_FORMAT_PARQUET, HEDL_FORMAT_CYPHER};
+//! uint8_t* data[3];
+//! size_t lens[3];
+//! int codes[3];
+//! hedl_export_multi(shared, formats, 3, HEDL_EXPORT_CYPHER_MERGE, data, lens, codes, NULL);
+//! for (int i = 0; i < 3; i++) hedl_free_bytes(data[i], lens[i]);
+//!
+//! hedl_document_release(shared);
+//! ```
+
+use crate::audit::{audit_call_failure, audit_call_success, sanitize_pointer, AuditTimer};
+use crate::audit_start;
+#[cfg(feature = "csv")]
+use crate::conversions::to_formats_callback::write_csv;
+#[cfg(feature = "json")]
+use crate::conversions::to_formats_callback::write_json;
+#[cfg(feature = "neo4j")]
+use crate::conversions::to_formats_callback::write_neo4j_cypher;
+#[cfg(feature = "xml")]
+use crate::conversions::to_formats_callback::write_xml;
+#[cfg(feature = "yaml")]
+use crate::conversions::to_formats_callback::write_yaml;
+use crate::conversions::to_formats_callback::{write_canonical, HEDL_DEFAULT_CHUNK_SIZE};
+use crate::error::{clear_error, set_error};
+use crate::memory::is_valid_document_ptr;
+use crate::metrics::note_output;
+use crate::types::{HedlDocument, HEDL_ERR_NOT_FOUND, HEDL_ERR_NULL_PTR, HEDL_OK};
+use hedl_core::Document;
+use rayon::prelude::*;
+use std::ffi::CString;
+use std::os::raw::{c_char, c_int};
+use std::ptr;
+use std::slice;
+use std::sync::Arc;
+
+// Shared handles are read from many threads at once.
+const _: () = {
+    const fn assert_send_sync<T: Send + Sync>() {}
+    assert_send_sync::<HedlDocument>();
+};
+
+// =============================================================================
+// Export Formats
+// =============================================================================
+
+/// Canonical HEDL text (as `hedl_canonicalize`).
+pub const HEDL_FORMAT_HEDL: c_int = 0;
+/// JSON (as `hedl_to_json`).
+pub const HEDL_FORMAT_JSON: c_int = 1;
+/// YAML (as `hedl_to_yaml`).
+pub const HEDL_FORMAT_YAML: c_int = 2;
+/// XML (as `hedl_to_xml`).
+pub const HEDL_FORMAT_XML: c_int = 3;
+/// CSV (as `hedl_to_csv`).
+pub const HEDL_FORMAT_CSV: c_int = 4;
+/// Parquet bytes (as `hedl_to_parquet`).
+pub const HEDL_FORMAT_PARQUET: c_int = 5;
+/// Neo4j Cypher statements (as `hedl_to_neo4j_cypher`).
+pub const HEDL_FORMAT_CYPHER: c_int = 6;
+
+/// Export flag: include HEDL metadata in JSON and YAML output.
+pub const HEDL_EXPORT_METADATA: u32 = 1 << 0;
+/// Export flag: emit Cypher `MERGE` instead of `CREATE` statements.
+pub const HEDL_EXPORT_CYPHER_MERGE: u32 = 1 << 1;
+
+/// Outcome of one slot: the serialized bytes, or its error code and message.
+type SlotResult = Result<Vec<u8>, (c_int, String)>;
+
+/// Serialize `doc` to `format`.
+#[allow(unused_variables)]
+fn export_one(doc: &Document, format: c_int, flags: u32) -> SlotResult {
+    let metadata = (flags & HEDL_EXPORT_METADATA != 0) as c_int;
+    let mut out = Vec::new();
+    match format {
+        HEDL_FORMAT_HEDL => write_canonical(doc, HEDL_DEFAULT_CHUNK_SIZE, &mut out)?,
+        #[cfg(feature = "json")]
+        HEDL_FORMAT_JSON => write_json(doc, metadata, &mut out)?,
+        #[cfg(feature = "yaml")]
+        HEDL_FORMAT_YAML => write_yaml(doc, metadata, &mut out)?,
+        #[cfg(feature = "xml")]
+        HEDL_FORMAT_XML => write_xml(doc, &mut out)?,
+        #[cfg(feature = "csv")]
+        HEDL_FORMAT_CSV => write_csv(doc, &mut out)?,
+        #[cfg(feature = "parquet")]
+        HEDL_FORMAT_PARQUET => {
+            out = hedl_parquet::to_parquet_bytes(doc).map_err(|e| {
+                (
+                    crate::types::HEDL_ERR_PARQUET,
+                    format!("Parquet conversion error: {}", e),
+                )
+            })?
+        }
+        #[cfg(feature = "neo4j")]
+        HEDL_FORMAT_CYPHER => {
+            let merge = (flags & HEDL_EXPORT_CYPHER_MERGE != 0) as c_int;
+            write_neo4j_cypher(doc, merge, &mut out)?
+        }
+        _ => {
+            return Err((
+                HEDL_ERR_NOT_FOUND,
+                format!("Export format {} is not available in this build", format),
+            ))
+        }
+    }
+    Ok(out)
+}
+
+// =============================================================================
+// Shared Documents
+// =============================================================================
+
+/// Turn an owned document into a shared, reference-counted handle.
+///
+/// The document moves into the handle, which starts with one reference.
+/// `doc` must not be used or freed afterwards; use `*out_shared` instead
+/// and drop references with `hedl_document_release`, never
+/// `hedl_free_document`.
+///
+/// # Arguments
+/// * `doc` - Owned document (from hedl_parse and friends)
+/// * `out_shared` - Pointer to store the shared handle
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_NULL_PTR for a NULL argument (`doc` is then
+/// left untouched).
+///
+/// # Safety
+/// `doc` must be a document the caller owns, i.e. one it would otherwise
+/// free with `hedl_free_document`. Documents owned by a `HedlParser` or a
+/// `HedlIncremental`, and handles that are already shared, are not allowed.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_document_share(
+    doc: *mut HedlDocument,
+    out_shared: *mut *const HedlDocument,
+) -> c_int {
+    if !is_valid_document_ptr(doc) || out_shared.is_null() {
+        set_error("Null pointer argument");
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    // The document moves to a new address, so lookups cached against the old
+    // one must go first
+    (*doc).document_mut();
+    let shared = Arc::new(*Box::from_raw(doc));
+    *out_shared = Arc::into_raw(shared);
+    HEDL_OK
+}
+
+/// Take another reference to a shared document.
+///
+/// Safe to call from any thread, concurrently with readers and with other
+/// retains and releases.
+///
+/// # Safety
+/// `doc` must be a shared handle from `hedl_document_share` on which the
+/// caller holds a reference. NULL is ignored.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_document_retain(doc: *const HedlDocument) {
+    if is_valid_document_ptr(doc) {
+        Arc::increment_strong_count(doc);
+    }
+}
+
+/// Drop a reference to a shared document, freeing it with the last one.
+///
+/// # Safety
+/// `doc` must be a shared handle from `hedl_document_share`, and the
+/// caller must not use it after giving up its reference. NULL is ignored.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_document_release(doc: *const HedlDocument) {
+    if is_valid_document_ptr(doc) {
+        Arc::decrement_strong_count(doc);
+    }
+}
+
+// =============================================================================
+// Multi-format Export
+// =============================================================================
+
+/// Export one document to several formats in parallel.
+///
+/// Slot `i` of every output array receives the result for `formats[i]`:
+/// the output bytes and their length (NULL and 0 on failure), the status
+/// code, and the error message (NULL on success). Text formats are UTF-8
+/// without a terminating NUL. Free each output with `hedl_free_bytes` and
+/// each message with `hedl_free_string`.
+///
+/// # Arguments
+/// * `doc` - Document handle (owned or shared)
+/// * `formats` - Array of `n` `HEDL_FORMAT_*` values
+/// * `n` - Number of formats
+/// * `flags` - `HEDL_EXPORT_*` flags
+/// * `out_data` - Array of `n` slots for output buffers
+/// * `out_lens` - Array of `n` slots for output lengths
+/// * `out_codes` - Array of `n` slots for per-format status codes
+/// * `out_errors` - Array of `n` slots for per-format error messages, or NULL
+///
+/// # Returns
+/// HEDL_OK if every format was exported. Otherwise the code of the first
+/// failed slot; the thread-local last error then only summarizes the call.
+/// HEDL_ERR_NOT_FOUND in a slot marks a format unknown to or not enabled in
+/// this build. HEDL_ERR_NULL_PTR if a required argument is NULL (outputs
+/// untouched).
+///
+/// # Safety
+/// Every array must hold at least `n` elements. `doc` must stay valid and
+/// unmodified until the call returns.
+#[allow(clippy::too_many_arguments)]
+#[no_mangle]
+pub unsafe extern "C" fn hedl_export_multi(
+    doc: *const HedlDocument,
+    formats: *const c_int,
+    n: usize,
+    flags: u32,
+    out_data: *mut *mut u8,
+    out_lens: *mut usize,
+    out_codes: *mut c_int,
+    out_errors: *mut *mut c_char,
+) -> c_int {
+    let start = AuditTimer::start();
+
+    audit_start!(
+        "hedl_export_multi",
+        "doc" => sanitize_pointer(doc),
+        "formats" => sanitize_pointer(formats),
+        "n" => n.to_string(),
+        "flags" => flags.to_string(),
+    );
+
+    clear_error();
+
+    if !is_valid_document_ptr(doc) {
+        let duration = start.elapsed();
+        set_error("Null pointer argument");
+        audit_call_failure(
+            "hedl_export_multi",
+            HEDL_ERR_NULL_PTR,
+            "Null pointer argument",
+            duration,
+        );
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    if n == 0 {
+        audit_call_success("hedl_export_multi", start.elapsed());
+        return HEDL_OK;
+    }
+
+    if formats.is_null() || out_data.is_null() || out_lens.is_null() || out_codes.is_null() {
+        let duration = start.elapsed();
+        set_error("Null pointer argument");
+        audit_call_failure(
+            "hedl_export_multi",
+            HEDL_ERR_NULL_PTR,
+            "Null pointer argument",
+            duration,
+        );
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    let doc_ref = &(*doc).inner;
+    let formats = slice::from_raw_parts(formats, n);
+    let results: Vec<SlotResult> = if n == 1 {
+        vec![export_one(doc_ref, formats[0], flags)]
+    } else {
+        (0..n)
+            .into_par_iter()
+            .map(|i| export_one(doc_ref, formats[i], flags))
+            .collect()
+    };
+
+    let mut failed = 0usize;
+    let mut first_code = HEDL_OK;
+    for (i, result) in results.into_iter().enumerate() {
+        let (data, len, code, error) = match result {
+            Ok(bytes) => {
+                note_output(bytes.len());
+                let len = bytes.len();
+                let data = Box::into_raw(bytes.into_boxed_slice()) as *mut u8;
+                (data, len, HEDL_OK, ptr::null_mut())
+            }
+            Err((code, msg)) => {
+                failed += 1;
+                if first_code == HEDL_OK {
+                    first_code = code;
+                }
+                let error = if out_errors.is_null() {
+                    ptr::null_mut()
+                } else {
+                    CString::new(msg).map_or(ptr::null_mut(), CString::into_raw)
+                };
+                (ptr::null_mut(), 0, code, error)
+            }
+        };
+
+        *out_data.add(i) = data;
+        *out_lens.add(i) = len;
+        *out_codes.add(i) = code;
+        if !out_errors.is_null() {
+            *out_errors.add(i) = error;
+        }
+    }
+
+    if failed == 0 {
+        audit_call_success("hedl_export_multi", start.elapsed());
+        HEDL_OK
+    } else {
+        let duration = start.elapsed();
+        let msg = format!("{} of {} formats failed to export", failed, n);
+        set_error(&msg);
+        audit_call_failure("hedl_export_multi", first_code, &msg, duration);
+        first_code
+    }
+}
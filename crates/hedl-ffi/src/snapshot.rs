@@ -0,0 +1,302 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//! Binary document snapshots for FFI.
+//!
+//! A snapshot is `hedl_core::snapshot`'s versioned binary image of a parsed
+//! document. Loading one skips lexing, inference and reference resolution:
+//! `hedl_load_snapshot` memory-maps the file and builds the document in a
+//! single pass over the mapped pages, so a warm restart costs roughly a
+//! page-in plus the document's allocations instead of a full parse.
+//!
+//! Snapshots are a cache. A snapshot from another format version, or one that
+//! fails its checksum, is rejected with `HEDL_ERR_SNAPSHOT`; rebuild it from
+//! the HEDL source.
+//!
+//! # Usage Example (C)
+//!
+//! ```c
+//! HedlDocument* doc = NULL;
+//! if (hedl_load_snapshot("reference.hedlsnap", &doc) != HEDL_OK) {
+//!     hedl_parse_file("reference.hedl", 1, 0, &doc);
+//!     hedl_save_snapshot(doc, "reference.hedlsnap");
+//! }
+//! ```
+
+use crate::audit::{audit_call_failure, audit_call_success, sanitize_pointer, AuditTimer};
+use crate::audit_start;
+use crate::error::{clear_error, get_thread_local_error, set_error};
+use crate::memory::is_valid_document_ptr;
+use crate::metrics::{note_input, note_output};
+use crate::types::{HedlDocument, HEDL_ERR_IO, HEDL_ERR_NULL_PTR, HEDL_ERR_SNAPSHOT, HEDL_OK};
+use crate::utils::{borrow_c_str, map_input_file};
+use hedl_core::{from_snapshot, to_snapshot, Document};
+use std::os::raw::{c_char, c_int};
+use std::ptr;
+use std::slice;
+
+// =============================================================================
+// Saving
+// =============================================================================
+
+/// Serialize a document into a snapshot buffer.
+///
+/// # Arguments
+/// * `doc` - Document handle
+/// * `out_data` - Receives the snapshot bytes (free with `hedl_free_bytes`)
+/// * `out_len` - Receives the snapshot length
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_SNAPSHOT if the document is too large for
+/// the format, HEDL_ERR_NULL_PTR for a NULL argument.
+///
+/// # Safety
+/// All pointers must be valid.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_to_snapshot(
+    doc: *const HedlDocument,
+    out_data: *mut *mut u8,
+    out_len: *mut usize,
+) -> c_int {
+    let start = AuditTimer::start();
+    audit_start!(
+        "hedl_to_snapshot",
+        "doc" => sanitize_pointer(doc),
+        "out_data" => sanitize_pointer(out_data),
+        "out_len" => sanitize_pointer(out_len),
+    );
+
+    clear_error();
+
+    if !is_valid_document_ptr(doc) || out_data.is_null() || out_len.is_null() {
+        set_error("Null pointer argument");
+        let duration = start.elapsed();
+        audit_call_failure(
+            "hedl_to_snapshot",
+            HEDL_ERR_NULL_PTR,
+            "Null pointer argument",
+            duration,
+        );
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    match to_snapshot(&(*doc).inner) {
+        Ok(bytes) => {
+            let len = bytes.len();
+            *out_data = Box::into_raw(bytes.into_boxed_slice()) as *mut u8;
+            *out_len = len;
+            note_output(len);
+            audit_call_success("hedl_to_snapshot", start.elapsed());
+            HEDL_OK
+        }
+        Err(e) => {
+            set_error(&e.message);
+            let duration = start.elapsed();
+            audit_call_failure("hedl_to_snapshot", HEDL_ERR_SNAPSHOT, &e.message, duration);
+            HEDL_ERR_SNAPSHOT
+        }
+    }
+}
+
+/// Write a document's snapshot to a file, replacing any existing file.
+///
+/// # Arguments
+/// * `doc` - Document handle
+/// * `path` - Null-terminated UTF-8 file path
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_IO if the file cannot be written,
+/// HEDL_ERR_SNAPSHOT if the document is too large for the format, error
+/// code on other failures.
+///
+/// # Safety
+/// `doc` must be a valid document handle and `path` a valid null-terminated
+/// string.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_save_snapshot(
+    doc: *const HedlDocument,
+    path: *const c_char,
+) -> c_int {
+    let start = AuditTimer::start();
+    audit_start!(
+        "hedl_save_snapshot",
+        "doc" => sanitize_pointer(doc),
+        "path" => sanitize_pointer(path),
+    );
+
+    clear_error();
+
+    if !is_valid_document_ptr(doc) || path.is_null() {
+        set_error("Null pointer argument");
+        let duration = start.elapsed();
+        audit_call_failure(
+            "hedl_save_snapshot",
+            HEDL_ERR_NULL_PTR,
+            "Null pointer argument",
+            duration,
+        );
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    let result = borrow_c_str(path).and_then(|path| {
+        let bytes = to_snapshot(&(*doc).inner).map_err(|e| (HEDL_ERR_SNAPSHOT, e.message))?;
+        std::fs::write(path, &bytes)
+            .map(|()| note_output(bytes.len()))
+            .map_err(|e| (HEDL_ERR_IO, format!("Failed to write '{}': {}", path, e)))
+    });
+
+    match result {
+        Ok(()) => {
+            audit_call_success("hedl_save_snapshot", start.elapsed());
+            HEDL_OK
+        }
+        Err((code, msg)) => {
+            set_error(&msg);
+            audit_call_failure("hedl_save_snapshot", code, &msg, start.elapsed());
+            code
+        }
+    }
+}
+
+// =============================================================================
+// Loading
+// =============================================================================
+
+/// Store a loaded document in `*out_doc`, or record the failure.
+unsafe fn finish_load(
+    fn_name: &'static str,
+    start: AuditTimer,
+    result: Result<Document, (c_int, String)>,
+    out_doc: *mut *mut HedlDocument,
+) -> c_int {
+    match result {
+        Ok(doc) => {
+            *out_doc = Box::into_raw(Box::new(HedlDocument::new(doc)));
+            audit_call_success(fn_name, start.elapsed());
+            HEDL_OK
+        }
+        Err((code, msg)) => {
+            set_error(&msg);
+            *out_doc = ptr::null_mut();
+            audit_call_failure(fn_name, code, &msg, start.elapsed());
+            code
+        }
+    }
+}
+
+fn load(bytes: &[u8]) -> Result<Document, (c_int, String)> {
+    from_snapshot(bytes).map_err(|e| (HEDL_ERR_SNAPSHOT, e.message))
+}
+
+/// Load a document from a snapshot buffer.
+///
+/// The buffer is read in place and need not be aligned.
+///
+/// # Arguments
+/// * `data` - Snapshot bytes from `hedl_to_snapshot` or a snapshot file
+/// * `len` - Length in bytes
+/// * `out_doc` - Receives the document (free with `hedl_free_document`)
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_SNAPSHOT if the bytes are not a valid
+/// snapshot of this format version, HEDL_ERR_NULL_PTR for a NULL argument.
+///
+/// # Safety
+/// `data` must point to at least `len` readable bytes.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_from_snapshot(
+    data: *const u8,
+    len: usize,
+    out_doc: *mut *mut HedlDocument,
+) -> c_int {
+    let start = AuditTimer::start();
+    audit_start!(
+        "hedl_from_snapshot",
+        "data" => sanitize_pointer(data),
+        "len" => len.to_string(),
+        "out_doc" => sanitize_pointer(out_doc),
+    );
+
+    clear_error();
+
+    if data.is_null() || out_doc.is_null() || len > isize::MAX as usize {
+        set_error("Null pointer argument");
+        let duration = start.elapsed();
+        audit_call_failure(
+            "hedl_from_snapshot",
+            HEDL_ERR_NULL_PTR,
+            "Null pointer argument",
+            duration,
+        );
+        if !out_doc.is_null() {
+            *out_doc = ptr::null_mut();
+        }
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    note_input(len);
+    let result = load(slice::from_raw_parts(data, len));
+    finish_load("hedl_from_snapshot", start, result, out_doc)
+}
+
+/// Load a document from a snapshot file.
+///
+/// The file is memory-mapped and decoded straight from the mapping, which is
+/// released before returning.
+///
+/// # Arguments
+/// * `path` - Null-terminated UTF-8 file path
+/// * `out_doc` - Receives the document (free with `hedl_free_document`)
+///
+/// # Returns
+/// HEDL_OK on success, HEDL_ERR_IO if the file cannot be opened or mapped,
+/// HEDL_ERR_SNAPSHOT if it is not a valid snapshot of this format version.
+///
+/// # Safety
+/// `path` must be a valid null-terminated string. The file must not be
+/// modified or truncated while the call is running.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_load_snapshot(
+    path: *const c_char,
+    out_doc: *mut *mut HedlDocument,
+) -> c_int {
+    let start = AuditTimer::start();
+    audit_start!(
+        "hedl_load_snapshot",
+        "path" => sanitize_pointer(path),
+        "out_doc" => sanitize_pointer(out_doc),
+    );
+
+    clear_error();
+
+    if path.is_null() || out_doc.is_null() {
+        set_error("Null pointer argument");
+        let duration = start.elapsed();
+        audit_call_failure(
+            "hedl_load_snapshot",
+            HEDL_ERR_NULL_PTR,
+            "Null pointer argument",
+            duration,
+        );
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    let result = match map_input_file(path) {
+        Ok(file) => load(file.bytes()),
+        Err(code) => Err((code, get_thread_local_error())),
+    };
+    finish_load("hedl_load_snapshot", start, result, out_doc)
+}
@@ -0,0 +1,651 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Pull-based streaming parser for FFI.
+//!
+//! Exposes the incremental parser from `hedl-stream` so that C callers can
+//! consume a HEDL document event by event. Memory use is bounded by the
+//! header, the nesting stack and the current row, independent of document
+//! size, and parsing starts as soon as the first bytes are available.
+//!
+//! # Usage Example (C)
+//!
+//! ```c
+//! HedlStream* stream = NULL;
+//! if (hedl_stream_open(read_from_socket, &conn, &stream) != HEDL_OK) {
+//!     fprintf(stderr, "%s\n", hedl_get_last_error());
+//!     return;
+//! }
+//!
+//! int event;
+//! while (hedl_stream_next(stream, &event) == HEDL_OK && event != HEDL_EVENT_END) {
+//!     if (event == HEDL_EVENT_NODE) {
+//!         const char* id;
+//!         size_t id_len;
+//!         hedl_stream_event_id(stream, &id, &id_len);
+//!         // ...
+//!     }
+//! }
+//! hedl_stream_close(stream);
+//! ```
+//!
+//! # Lifetime
+//!
+//! Every pointer handed out by an event accessor refers to the current
+//! event and is invalidated by the next `hedl_stream_next` or by
+//! `hedl_stream_close`.
+
+use crate::audit::{audit_call_failure, audit_call_success, sanitize_pointer, AuditTimer};
+use crate::audit_start;
+use crate::error::{clear_error, set_error};
+use crate::types::{
+    HEDL_ERR_INVALID_UTF8, HEDL_ERR_IO, HEDL_ERR_NOT_FOUND, HEDL_ERR_NULL_PTR, HEDL_ERR_PARSE,
+    HEDL_OK,
+};
+use crate::values::{write_str_view, HedlValueView};
+use hedl_stream::{NodeEvent, StreamError, StreamingParser};
+use std::io::{self, Cursor, Read};
+use std::os::raw::{c_char, c_int, c_void};
+use std::ptr;
+use std::slice;
+
+// =============================================================================
+// Event Kinds
+// =============================================================================
+
+pub const HEDL_EVENT_END: c_int = 0;
+pub const HEDL_EVENT_LIST_START: c_int = 1;
+pub const HEDL_EVENT_NODE: c_int = 2;
+pub const HEDL_EVENT_LIST_END: c_int = 3;
+pub const HEDL_EVENT_SCALAR: c_int = 4;
+pub const HEDL_EVENT_OBJECT_START: c_int = 5;
+pub const HEDL_EVENT_OBJECT_END: c_int = 6;
+
+// =============================================================================
+// Input Sources
+// =============================================================================
+
+/// Read callback used to pull input into the streaming parser.
+///
+/// The callback must copy at most `cap` bytes into `buf` and return the
+/// number of bytes written, 0 at end of input, or a negative value on error.
+/// Returning fewer than `cap` bytes is fine; the parser calls again as needed.
+pub type HedlReadCallback =
+    unsafe extern "C" fn(buf: *mut c_char, cap: usize, user_data: *mut c_void) -> isize;
+
+/// Adapts a C read callback to `std::io::Read`.
+pub(crate) struct CallbackReader {
+    pub(crate) callback: HedlReadCallback,
+    pub(crate) user_data: *mut c_void,
+}
+
+impl Read for CallbackReader {
+    fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+        if buf.is_empty() {
+            return Ok(0);
+        }
+        let n =
+            unsafe { (self.callback)(buf.as_mut_ptr() as *mut c_char, buf.len(), self.user_data) };
+        if n < 0 {
+            return Err(io::Error::new(
+                io::ErrorKind::Other,
+                format!("read callback returned {}", n),
+            ));
+        }
+        if n as usize > buf.len() {
+            return Err(io::Error::new(
+                io::ErrorKind::InvalidData,
+                "read callback reported more bytes than requested",
+            ));
+        }
+        Ok(n as usize)
+    }
+}
+
+// =============================================================================
+// Opaque Stream Handle
+// =============================================================================
+
+/// Opaque handle to a streaming parser.
+pub struct HedlStream {
+    pub(crate) parser: StreamingParser<Box<dyn Read>>,
+    pub(crate) current: Option<NodeEvent>,
+    finished: bool,
+}
+
+impl HedlStream {
+    pub(crate) fn new(parser: StreamingParser<Box<dyn Read>>) -> Self {
+        Self {
+            parser,
+            current: None,
+            finished: false,
+        }
+    }
+}
+
+/// Map a streaming error onto an FFI error code and record its message.
+pub(crate) fn stream_error_code(e: &StreamError) -> c_int {
+    set_error(&format!("Stream error: {}", e));
+    match e {
+        StreamError::Io(io_err) if io_err.kind() == io::ErrorKind::InvalidData => {
+            HEDL_ERR_INVALID_UTF8
+        }
+        StreamError::Io(_) => HEDL_ERR_IO,
+        StreamError::Utf8 { .. } => HEDL_ERR_INVALID_UTF8,
+        _ => HEDL_ERR_PARSE,
+    }
+}
+
+unsafe fn open_stream(
+    function: &'static str,
+    reader: Box<dyn Read>,
+    out_stream: *mut *mut HedlStream,
+    start: AuditTimer,
+) -> c_int {
+    match StreamingParser::new(reader) {
+        Ok(parser) => {
+            let handle = Box::new(HedlStream::new(parser));
+            *out_stream = Box::into_raw(handle);
+            audit_call_success(function, start.elapsed());
+            HEDL_OK
+        }
+        Err(e) => {
+            let code = stream_error_code(&e);
+            *out_stream = ptr::null_mut();
+            let msg = crate::error::get_thread_local_error();
+            audit_call_failure(function, code, &msg, start.elapsed());
+            code
+        }
+    }
+}
+
+/// Open a streaming parser that pulls input through a read callback.
+///
+/// The header (everything up to `---`) is read and validated before this
+/// function returns; the body is read lazily by `hedl_stream_next`.
+///
+/// # Arguments
+/// * `read` - Callback supplying input bytes
+/// * `user_data` - User context pointer passed to the callback
+/// * `out_stream` - Pointer to store the stream handle (free with hedl_stream_close)
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure.
+///
+/// # Safety
+/// - `out_stream` must be valid
+/// - `user_data` must remain valid until `hedl_stream_close`
+/// - The callback MUST NOT call back into HEDL functions
+#[no_mangle]
+pub unsafe extern "C" fn hedl_stream_open(
+    read: Option<HedlReadCallback>,
+    user_data: *mut c_void,
+    out_stream: *mut *mut HedlStream,
+) -> c_int {
+    let start = AuditTimer::start();
+
+    audit_start!(
+        "hedl_stream_open",
+        "user_data" => sanitize_pointer(user_data),
+        "out_stream" => sanitize_pointer(out_stream),
+    );
+
+    clear_error();
+
+    let callback = match read {
+        Some(cb) if !out_stream.is_null() => cb,
+        _ => {
+            set_error("Null pointer argument");
+            audit_call_failure(
+                "hedl_stream_open",
+                HEDL_ERR_NULL_PTR,
+                "Null pointer argument",
+                start.elapsed(),
+            );
+            return HEDL_ERR_NULL_PTR;
+        }
+    };
+
+    let reader: Box<dyn Read> = Box::new(CallbackReader {
+        callback,
+        user_data,
+    });
+    open_stream("hedl_stream_open", reader, out_stream, start)
+}
+
+/// Open a streaming parser over a caller-owned buffer.
+///
+/// The buffer is NOT copied: it is read in place, so it must stay alive and
+/// unmodified until `hedl_stream_close`. Useful for memory-mapped files.
+///
+/// # Arguments
+/// * `input` - UTF-8 encoded HEDL document
+/// * `input_len` - Length of input in bytes
+/// * `out_stream` - Pointer to store the stream handle (free with hedl_stream_close)
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure.
+///
+/// # Safety
+/// `input` must point to at least `input_len` readable bytes for the
+/// lifetime of the stream.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_stream_open_buffer(
+    input: *const c_char,
+    input_len: usize,
+    out_stream: *mut *mut HedlStream,
+) -> c_int {
+    let start = AuditTimer::start();
+
+    audit_start!(
+        "hedl_stream_open_buffer",
+        "input_ptr" => sanitize_pointer(input),
+        "input_len" => input_len.to_string(),
+        "out_stream" => sanitize_pointer(out_stream),
+    );
+
+    clear_error();
+
+    if input.is_null() || out_stream.is_null() {
+        set_error("Null pointer argument");
+        audit_call_failure(
+            "hedl_stream_open_buffer",
+            HEDL_ERR_NULL_PTR,
+            "Null pointer argument",
+            start.elapsed(),
+        );
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    // The caller guarantees the buffer outlives the stream handle.
+    let bytes: &'static [u8] = slice::from_raw_parts(input as *const u8, input_len);
+    let reader: Box<dyn Read> = Box::new(Cursor::new(bytes));
+    open_stream("hedl_stream_open_buffer", reader, out_stream, start)
+}
+
+/// Advance the stream to the next event.
+///
+/// # Arguments
+/// * `stream` - Stream handle
+/// * `out_event` - Pointer to store the event kind (`HEDL_EVENT_*`).
+///   `HEDL_EVENT_END` is reported once the document is exhausted and on
+///   every call afterwards.
+///
+/// # Returns
+/// HEDL_OK on success, error code on failure. After an error the stream is
+/// finished and only `hedl_stream_close` is meaningful.
+///
+/// # Safety
+/// All pointers must be valid.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_stream_next(stream: *mut HedlStream, out_event: *mut c_int) -> c_int {
+    if stream.is_null() || out_event.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+
+    let s = &mut *stream;
+    s.current = None;
+
+    if s.finished {
+        *out_event = HEDL_EVENT_END;
+        return HEDL_OK;
+    }
+
+    match s.parser.next() {
+        Some(Ok(event)) => {
+            *out_event = event_kind(&event);
+            s.current = Some(event);
+            HEDL_OK
+        }
+        Some(Err(e)) => {
+            s.finished = true;
+            *out_event = HEDL_EVENT_END;
+            stream_error_code(&e)
+        }
+        None => {
+            s.finished = true;
+            *out_event = HEDL_EVENT_END;
+            HEDL_OK
+        }
+    }
+}
+
+/// Close a stream handle and release its resources.
+///
+/// # Safety
+/// The pointer must have been returned by `hedl_stream_open*`. NULL is ignored.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_stream_close(stream: *mut HedlStream) {
+    if !stream.is_null() {
+        let _ = Box::from_raw(stream);
+    }
+}
+
+#[inline]
+pub(crate) fn event_kind(event: &NodeEvent) -> c_int {
+    match event {
+        NodeEvent::ListStart { .. } => HEDL_EVENT_LIST_START,
+        NodeEvent::Node(_) => HEDL_EVENT_NODE,
+        NodeEvent::ListEnd { .. } => HEDL_EVENT_LIST_END,
+        NodeEvent::Scalar { .. } => HEDL_EVENT_SCALAR,
+        NodeEvent::ObjectStart { .. } => HEDL_EVENT_OBJECT_START,
+        NodeEvent::ObjectEnd { .. } => HEDL_EVENT_OBJECT_END,
+        NodeEvent::Header(_) | NodeEvent::EndOfDocument => HEDL_EVENT_END,
+    }
+}
+
+#[inline]
+unsafe fn current_event<'a>(stream: *const HedlStream) -> Option<&'a NodeEvent> {
+    if stream.is_null() {
+        None
+    } else {
+        (*stream).current.as_ref()
+    }
+}
+
+// =============================================================================
+// Header Accessors
+// =============================================================================
+
+/// Get the `%VERSION` declared in the stream header.
+///
+/// # Safety
+/// All pointers must be valid.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_stream_version(
+    stream: *const HedlStream,
+    major: *mut c_int,
+    minor: *mut c_int,
+) -> c_int {
+    if stream.is_null() || major.is_null() || minor.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    let header = match (*stream).parser.header() {
+        Some(h) => h,
+        None => return HEDL_ERR_NOT_FOUND,
+    };
+    *major = header.version.0 as c_int;
+    *minor = header.version.1 as c_int;
+    HEDL_OK
+}
+
+/// Get the number of `%STRUCT` definitions in the stream header.
+///
+/// # Safety
+/// Stream pointer must be valid. Returns -1 if stream is NULL.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_stream_struct_count(stream: *const HedlStream) -> c_int {
+    if stream.is_null() {
+        return -1;
+    }
+    (*stream)
+        .parser
+        .header()
+        .map(|h| h.structs.len() as c_int)
+        .unwrap_or(0)
+}
+
+/// Get the type name and column count of a `%STRUCT` definition.
+///
+/// Structs are reported in type-name order.
+///
+/// # Arguments
+/// * `index` - Struct index in `[0, hedl_stream_struct_count)`
+/// * `out_name` / `out_name_len` - Borrowed type name (not null-terminated)
+/// * `out_column_count` - Optional; receives the number of columns
+///
+/// # Safety
+/// All non-optional pointers must be valid. Borrowed pointers stay valid
+/// until `hedl_stream_close`.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_stream_struct_get(
+    stream: *const HedlStream,
+    index: usize,
+    out_name: *mut *const c_char,
+    out_name_len: *mut usize,
+    out_column_count: *mut usize,
+) -> c_int {
+    if stream.is_null() || out_name.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    let entry = (*stream)
+        .parser
+        .header()
+        .and_then(|h| h.structs.iter().nth(index));
+    match entry {
+        Some((name, columns)) => {
+            if !out_column_count.is_null() {
+                *out_column_count = columns.len();
+            }
+            write_str_view(name, out_name, out_name_len)
+        }
+        None => {
+            set_error("Struct index out of range");
+            HEDL_ERR_NOT_FOUND
+        }
+    }
+}
+
+// =============================================================================
+// Event Accessors
+// =============================================================================
+
+/// Get the key of the current event.
+///
+/// Available for `LIST_START`, `LIST_END`, `SCALAR`, `OBJECT_START` and
+/// `OBJECT_END` events; returns HEDL_ERR_NOT_FOUND otherwise.
+///
+/// # Safety
+/// `stream` and `out_key` must be valid; `out_len` may be NULL.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_stream_event_key(
+    stream: *const HedlStream,
+    out_key: *mut *const c_char,
+    out_len: *mut usize,
+) -> c_int {
+    if stream.is_null() || out_key.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    let key = match current_event(stream) {
+        Some(NodeEvent::ListStart { key, .. })
+        | Some(NodeEvent::ListEnd { key, .. })
+        | Some(NodeEvent::Scalar { key, .. })
+        | Some(NodeEvent::ObjectStart { key, .. })
+        | Some(NodeEvent::ObjectEnd { key }) => key,
+        _ => return HEDL_ERR_NOT_FOUND,
+    };
+    write_str_view(key, out_key, out_len)
+}
+
+/// Get the entity type name of the current event.
+///
+/// Available for `LIST_START`, `LIST_END` and `NODE` events.
+///
+/// # Safety
+/// `stream` and `out_type` must be valid; `out_len` may be NULL.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_stream_event_type_name(
+    stream: *const HedlStream,
+    out_type: *mut *const c_char,
+    out_len: *mut usize,
+) -> c_int {
+    if stream.is_null() || out_type.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    let type_name = match current_event(stream) {
+        Some(NodeEvent::ListStart { type_name, .. })
+        | Some(NodeEvent::ListEnd { type_name, .. }) => type_name,
+        Some(NodeEvent::Node(node)) => &node.type_name,
+        _ => return HEDL_ERR_NOT_FOUND,
+    };
+    write_str_view(type_name, out_type, out_len)
+}
+
+/// Get the ID of the current `NODE` event.
+///
+/// # Safety
+/// `stream` and `out_id` must be valid; `out_len` may be NULL.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_stream_event_id(
+    stream: *const HedlStream,
+    out_id: *mut *const c_char,
+    out_len: *mut usize,
+) -> c_int {
+    if stream.is_null() || out_id.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    match current_event(stream) {
+        Some(NodeEvent::Node(node)) => write_str_view(&node.id, out_id, out_len),
+        _ => HEDL_ERR_NOT_FOUND,
+    }
+}
+
+/// Get the parent of the current `NODE` event.
+///
+/// Returns HEDL_ERR_NOT_FOUND for top-level nodes and non-node events.
+///
+/// # Safety
+/// `stream`, `out_type` and `out_id` must be valid; length pointers may be NULL.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_stream_event_parent(
+    stream: *const HedlStream,
+    out_type: *mut *const c_char,
+    out_type_len: *mut usize,
+    out_id: *mut *const c_char,
+    out_id_len: *mut usize,
+) -> c_int {
+    if stream.is_null() || out_type.is_null() || out_id.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    match current_event(stream) {
+        Some(NodeEvent::Node(node)) => match (&node.parent_type, &node.parent_id) {
+            (Some(parent_type), Some(parent_id)) => {
+                write_str_view(parent_type, out_type, out_type_len);
+                write_str_view(parent_id, out_id, out_id_len)
+            }
+            _ => HEDL_ERR_NOT_FOUND,
+        },
+        _ => HEDL_ERR_NOT_FOUND,
+    }
+}
+
+/// Get the source line of the current event.
+///
+/// # Safety
+/// Stream pointer must be valid. Returns -1 if unavailable.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_stream_event_line(stream: *const HedlStream) -> i64 {
+    current_event(stream)
+        .and_then(|e| e.line())
+        .map(|l| l as i64)
+        .unwrap_or(-1)
+}
+
+/// Get the nesting depth of the current `NODE` event (0 = top-level).
+///
+/// # Safety
+/// Stream pointer must be valid. Returns -1 for non-node events.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_stream_event_depth(stream: *const HedlStream) -> i64 {
+    match current_event(stream) {
+        Some(NodeEvent::Node(node)) => node.depth as i64,
+        _ => -1,
+    }
+}
+
+/// Get the number of rows reported by the current `LIST_END` event.
+///
+/// # Safety
+/// Stream pointer must be valid. Returns -1 for other events.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_stream_event_row_count(stream: *const HedlStream) -> i64 {
+    match current_event(stream) {
+        Some(NodeEvent::ListEnd { count, .. }) => *count as i64,
+        _ => -1,
+    }
+}
+
+/// Get the number of values (or columns) carried by the current event.
+///
+/// - `NODE`: number of fields (the ID is field 0)
+/// - `LIST_START`: number of schema columns
+/// - `SCALAR`: 1
+///
+/// # Safety
+/// Stream pointer must be valid. Returns -1 for other events.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_stream_event_field_count(stream: *const HedlStream) -> i64 {
+    match current_event(stream) {
+        Some(NodeEvent::Node(node)) => node.fields.len() as i64,
+        Some(NodeEvent::ListStart { schema, .. }) => schema.len() as i64,
+        Some(NodeEvent::Scalar { .. }) => 1,
+        _ => -1,
+    }
+}
+
+/// Get a schema column name of the current `LIST_START` event.
+///
+/// # Safety
+/// `stream` and `out_name` must be valid; `out_len` may be NULL.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_stream_event_column(
+    stream: *const HedlStream,
+    index: usize,
+    out_name: *mut *const c_char,
+    out_len: *mut usize,
+) -> c_int {
+    if stream.is_null() || out_name.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    match current_event(stream) {
+        Some(NodeEvent::ListStart { schema, .. }) => match schema.get(index) {
+            Some(col) => write_str_view(col, out_name, out_len),
+            None => HEDL_ERR_NOT_FOUND,
+        },
+        _ => HEDL_ERR_NOT_FOUND,
+    }
+}
+
+/// Get a value of the current event without copying.
+///
+/// - `NODE`: field `index` (aligned with the list schema)
+/// - `SCALAR`: the scalar value (`index` must be 0)
+///
+/// # Safety
+/// All pointers must be valid.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_stream_event_value(
+    stream: *const HedlStream,
+    index: usize,
+    out_value: *mut HedlValueView,
+) -> c_int {
+    if stream.is_null() || out_value.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    let value = match current_event(stream) {
+        Some(NodeEvent::Node(node)) => node.fields.get(index),
+        Some(NodeEvent::Scalar { value, .. }) if index == 0 => Some(value),
+        _ => None,
+    };
+    match value {
+        Some(v) => {
+            *out_value = HedlValueView::from_value(v);
+            HEDL_OK
+        }
+        None => HEDL_ERR_NOT_FOUND,
+    }
+}
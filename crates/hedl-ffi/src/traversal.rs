@@ -0,0 +1,835 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Read-only document traversal for FFI.
+//!
+//! Borrowed handles let C callers walk a parsed [`Document`] directly
+//! instead of exporting it to JSON and parsing that again:
+//!
+//! - [`HedlObject`]: a map of named items (the document root or a nested object)
+//! - [`HedlItem`]: one entry of an object (scalar, object or matrix list)
+//! - [`HedlList`]: a matrix list (type name, schema columns and rows)
+//! - [`HedlNode`]: a row of a list, with its fields and nested children
+//!
+//! Handles, strings and value views all point into the document; nothing is
+//! allocated or copied. Strings are NOT null-terminated.
+//!
+//! # Usage Example (C)
+//!
+//! ```c
+//! const HedlItem* item;
+//! if (hedl_object_get(hedl_document_root(doc), "users", 5, &item) == HEDL_OK) {
+//!     const HedlList* users = hedl_item_list(item);
+//!     size_t age_col;
+//!     hedl_list_column_index(users, "age", 3, &age_col);
+//!     for (size_t i = 0; i < hedl_list_row_count(users); i++) {
+//!         int64_t age;
+//!         if (hedl_node_field_int(hedl_list_row(users, i), age_col, &age) == HEDL_OK) {
+//!             // ...
+//!         }
+//!     }
+//! }
+//! ```
+//!
+//! Object entries and child groups are iterated with a key cursor: pass NULL
+//! to get the first entry and the previous key to get the next one.
+//!
+//! # Lifetime
+//!
+//! Every handle and pointer is valid until the document is freed (or, for
+//! parser-owned documents, until the parser is reset or freed). None of
+//! them is freed by the caller.
+
+use crate::memory::is_valid_document_ptr;
+use crate::types::{
+    HedlDocument, HEDL_ERR_NOT_FOUND, HEDL_ERR_NULL_PTR, HEDL_ERR_TYPE_MISMATCH, HEDL_OK,
+};
+use crate::utils::borrow_input_sized;
+use crate::values::{write_str_view, HedlValueView, HEDL_VALUE_REFERENCE};
+use hedl_core::{Document, Item, MatrixList, Node, Value};
+use std::collections::BTreeMap;
+use std::ops::Bound;
+use std::os::raw::{c_char, c_double, c_int};
+use std::ptr;
+
+// =============================================================================
+// Item Kinds
+// =============================================================================
+
+pub const HEDL_ITEM_SCALAR: c_int = 0;
+pub const HEDL_ITEM_OBJECT: c_int = 1;
+pub const HEDL_ITEM_LIST: c_int = 2;
+
+// =============================================================================
+// Borrowed Handles
+// =============================================================================
+
+/// Borrowed handle to a map of named items (document root or object).
+#[repr(transparent)]
+pub struct HedlObject {
+    inner: BTreeMap<String, Item>,
+}
+
+/// Borrowed handle to an item.
+#[repr(transparent)]
+pub struct HedlItem {
+    inner: Item,
+}
+
+/// Borrowed handle to a matrix list.
+#[repr(transparent)]
+pub struct HedlList {
+    inner: MatrixList,
+}
+
+/// Borrowed handle to a node (list row or nested child).
+#[repr(transparent)]
+pub struct HedlNode {
+    inner: Node,
+}
+
+// `repr(transparent)` makes each cast a reinterpretation of the same object.
+
+fn object_handle(map: &BTreeMap<String, Item>) -> *const HedlObject {
+    map as *const BTreeMap<String, Item> as *const HedlObject
+}
+
+fn item_handle(item: &Item) -> *const HedlItem {
+    item as *const Item as *const HedlItem
+}
+
+fn list_handle(list: &MatrixList) -> *const HedlList {
+    list as *const MatrixList as *const HedlList
+}
+
+fn node_handle(node: &Node) -> *const HedlNode {
+    node as *const Node as *const HedlNode
+}
+
+/// Borrow a length-delimited key, or `Err(code)` for a NULL or non-UTF-8 key.
+unsafe fn borrow_key<'a>(key: *const c_char, key_len: usize) -> Result<&'a str, c_int> {
+    if key.is_null() {
+        return Err(HEDL_ERR_NULL_PTR);
+    }
+    borrow_input_sized(key, key_len).map_err(|(code, _)| code)
+}
+
+/// First entry of `map` strictly after `after` (or the first entry for NULL).
+unsafe fn next_entry<'a, V>(
+    map: &'a BTreeMap<String, V>,
+    after: *const c_char,
+    after_len: usize,
+) -> Result<Option<(&'a String, &'a V)>, c_int> {
+    if after.is_null() {
+        return Ok(map.iter().next());
+    }
+    let after = borrow_input_sized(after, after_len).map_err(|(code, _)| code)?;
+    Ok(map
+        .range::<str, _>((Bound::Excluded(after), Bound::Unbounded))
+        .next())
+}
+
+// =============================================================================
+// Objects
+// =============================================================================
+
+/// Get the root object of a document.
+///
+/// # Safety
+/// Doc pointer must be valid. Returns NULL if doc is NULL or poisoned.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_document_root(doc: *const HedlDocument) -> *const HedlObject {
+    if !is_valid_document_ptr(doc) {
+        return ptr::null();
+    }
+    let document: &Document = &(*doc).inner;
+    object_handle(&document.root)
+}
+
+/// Get the number of entries in an object.
+///
+/// # Safety
+/// Object pointer must be valid or NULL (returns 0).
+#[no_mangle]
+pub unsafe extern "C" fn hedl_object_len(obj: *const HedlObject) -> usize {
+    if obj.is_null() {
+        return 0;
+    }
+    (*obj).inner.len()
+}
+
+/// Look up an entry by key.
+///
+/// # Returns
+/// HEDL_OK, or HEDL_ERR_NOT_FOUND if the object has no such key.
+///
+/// # Safety
+/// `obj`, `key` and `out_item` must be valid; `key` must point to at least
+/// `key_len` bytes.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_object_get(
+    obj: *const HedlObject,
+    key: *const c_char,
+    key_len: usize,
+    out_item: *mut *const HedlItem,
+) -> c_int {
+    if obj.is_null() || out_item.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    let key = match borrow_key(key, key_len) {
+        Ok(k) => k,
+        Err(code) => return code,
+    };
+    match (*obj).inner.get(key) {
+        Some(item) => {
+            *out_item = item_handle(item);
+            HEDL_OK
+        }
+        None => HEDL_ERR_NOT_FOUND,
+    }
+}
+
+/// Advance a key cursor over an object's entries in key order.
+///
+/// Pass `after_key = NULL` for the first entry, then the key returned by the
+/// previous call. Each step is a single ordered-map lookup.
+///
+/// # Returns
+/// HEDL_OK with the entry, or HEDL_ERR_NOT_FOUND past the last entry.
+///
+/// # Safety
+/// `obj`, `out_key` and `out_item` must be valid; `out_key_len` may be NULL.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_object_next(
+    obj: *const HedlObject,
+    after_key: *const c_char,
+    after_len: usize,
+    out_key: *mut *const c_char,
+    out_key_len: *mut usize,
+    out_item: *mut *const HedlItem,
+) -> c_int {
+    if obj.is_null() || out_key.is_null() || out_item.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    match next_entry(&(*obj).inner, after_key, after_len) {
+        Ok(Some((key, item))) => {
+            *out_item = item_handle(item);
+            write_str_view(key, out_key, out_key_len)
+        }
+        Ok(None) => HEDL_ERR_NOT_FOUND,
+        Err(code) => code,
+    }
+}
+
+// =============================================================================
+// Items
+// =============================================================================
+
+/// Get the kind of an item (`HEDL_ITEM_*`).
+///
+/// # Safety
+/// Item pointer must be valid. Returns -1 if item is NULL.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_item_kind(item: *const HedlItem) -> c_int {
+    if item.is_null() {
+        return -1;
+    }
+    match (*item).inner {
+        Item::Scalar(_) => HEDL_ITEM_SCALAR,
+        Item::Object(_) => HEDL_ITEM_OBJECT,
+        Item::List(_) => HEDL_ITEM_LIST,
+    }
+}
+
+/// Get the value of a scalar item without copying.
+///
+/// # Returns
+/// HEDL_OK, or HEDL_ERR_TYPE_MISMATCH if the item is not a scalar.
+///
+/// # Safety
+/// All pointers must be valid.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_item_value(
+    item: *const HedlItem,
+    out_value: *mut HedlValueView,
+) -> c_int {
+    if item.is_null() || out_value.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    match &(*item).inner {
+        Item::Scalar(v) => {
+            *out_value = HedlValueView::from_value(v);
+            HEDL_OK
+        }
+        _ => HEDL_ERR_TYPE_MISMATCH,
+    }
+}
+
+/// Get an object item as an object handle.
+///
+/// # Safety
+/// Item pointer must be valid. Returns NULL if item is NULL or not an object.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_item_object(item: *const HedlItem) -> *const HedlObject {
+    if item.is_null() {
+        return ptr::null();
+    }
+    match &(*item).inner {
+        Item::Object(map) => object_handle(map),
+        _ => ptr::null(),
+    }
+}
+
+/// Get a list item as a list handle.
+///
+/// # Safety
+/// Item pointer must be valid. Returns NULL if item is NULL or not a list.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_item_list(item: *const HedlItem) -> *const HedlList {
+    if item.is_null() {
+        return ptr::null();
+    }
+    match &(*item).inner {
+        Item::List(list) => list_handle(list),
+        _ => ptr::null(),
+    }
+}
+
+// =============================================================================
+// Matrix Lists
+// =============================================================================
+
+/// Get the entity type name of a list.
+///
+/// # Safety
+/// `list` and `out_type` must be valid; `out_len` may be NULL.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_list_type_name(
+    list: *const HedlList,
+    out_type: *mut *const c_char,
+    out_len: *mut usize,
+) -> c_int {
+    if list.is_null() || out_type.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    write_str_view(&(*list).inner.type_name, out_type, out_len)
+}
+
+/// Get the number of schema columns of a list (the ID is column 0).
+///
+/// # Safety
+/// List pointer must be valid or NULL (returns 0).
+#[no_mangle]
+pub unsafe extern "C" fn hedl_list_column_count(list: *const HedlList) -> usize {
+    if list.is_null() {
+        return 0;
+    }
+    (*list).inner.schema.len()
+}
+
+/// Get a schema column name of a list.
+///
+/// # Safety
+/// `list` and `out_name` must be valid; `out_len` may be NULL.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_list_column(
+    list: *const HedlList,
+    index: usize,
+    out_name: *mut *const c_char,
+    out_len: *mut usize,
+) -> c_int {
+    if list.is_null() || out_name.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    match (&(*list).inner.schema).get(index) {
+        Some(col) => write_str_view(col, out_name, out_len),
+        None => HEDL_ERR_NOT_FOUND,
+    }
+}
+
+/// Find the index of a schema column by name.
+///
+/// Resolve column names once per list and then read fields by index.
+///
+/// # Safety
+/// `list`, `name` and `out_index` must be valid; `name` must point to at
+/// least `name_len` bytes.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_list_column_index(
+    list: *const HedlList,
+    name: *const c_char,
+    name_len: usize,
+    out_index: *mut usize,
+) -> c_int {
+    if list.is_null() || out_index.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    let name = match borrow_key(name, name_len) {
+        Ok(n) => n,
+        Err(code) => return code,
+    };
+    match (*list).inner.schema.iter().position(|col| col == name) {
+        Some(index) => {
+            *out_index = index;
+            HEDL_OK
+        }
+        None => HEDL_ERR_NOT_FOUND,
+    }
+}
+
+/// Get the number of rows in a list.
+///
+/// # Safety
+/// List pointer must be valid or NULL (returns 0).
+#[no_mangle]
+pub unsafe extern "C" fn hedl_list_row_count(list: *const HedlList) -> usize {
+    if list.is_null() {
+        return 0;
+    }
+    (*list).inner.rows.len()
+}
+
+/// Get a row of a list.
+///
+/// # Safety
+/// List pointer must be valid. Returns NULL if list is NULL or `index` is
+/// out of range.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_list_row(list: *const HedlList, index: usize) -> *const HedlNode {
+    if list.is_null() {
+        return ptr::null();
+    }
+    match (&(*list).inner.rows).get(index) {
+        Some(node) => node_handle(node),
+        None => ptr::null(),
+    }
+}
+
+// =============================================================================
+// Nodes
+// =============================================================================
+
+/// Get the entity type name of a node.
+///
+/// # Safety
+/// `node` and `out_type` must be valid; `out_len` may be NULL.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_node_type_name(
+    node: *const HedlNode,
+    out_type: *mut *const c_char,
+    out_len: *mut usize,
+) -> c_int {
+    if node.is_null() || out_type.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    write_str_view(&(*node).inner.type_name, out_type, out_len)
+}
+
+/// Get the ID of a node.
+///
+/// # Safety
+/// `node` and `out_id` must be valid; `out_len` may be NULL.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_node_id(
+    node: *const HedlNode,
+    out_id: *mut *const c_char,
+    out_len: *mut usize,
+) -> c_int {
+    if node.is_null() || out_id.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    write_str_view(&(*node).inner.id, out_id, out_len)
+}
+
+/// Get the number of fields of a node (aligned with the list schema).
+///
+/// # Safety
+/// Node pointer must be valid or NULL (returns 0).
+#[no_mangle]
+pub unsafe extern "C" fn hedl_node_field_count(node: *const HedlNode) -> usize {
+    if node.is_null() {
+        return 0;
+    }
+    (*node).inner.fields.len()
+}
+
+/// Field `index` of `node`, or `Err(code)` for NULL / out of range.
+unsafe fn node_field<'a>(node: *const HedlNode, index: usize) -> Result<&'a Value, c_int> {
+    if node.is_null() {
+        return Err(HEDL_ERR_NULL_PTR);
+    }
+    (&(*node).inner.fields).get(index).ok_or(HEDL_ERR_NOT_FOUND)
+}
+
+/// Get a field of a node without copying.
+///
+/// # Safety
+/// All pointers must be valid.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_node_field(
+    node: *const HedlNode,
+    index: usize,
+    out_value: *mut HedlValueView,
+) -> c_int {
+    if out_value.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    match node_field(node, index) {
+        Ok(v) => {
+            *out_value = HedlValueView::from_value(v);
+            HEDL_OK
+        }
+        Err(code) => code,
+    }
+}
+
+/// Get an integer field.
+///
+/// # Returns
+/// HEDL_OK, HEDL_ERR_NOT_FOUND if `index` is out of range, or
+/// HEDL_ERR_TYPE_MISMATCH if the field is not an integer (including null).
+///
+/// # Safety
+/// All pointers must be valid.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_node_field_int(
+    node: *const HedlNode,
+    index: usize,
+    out_value: *mut i64,
+) -> c_int {
+    if out_value.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    match node_field(node, index).map(Value::as_int) {
+        Ok(Some(n)) => {
+            *out_value = n;
+            HEDL_OK
+        }
+        Ok(None) => HEDL_ERR_TYPE_MISMATCH,
+        Err(code) => code,
+    }
+}
+
+/// Get a numeric field as a double (integers are converted).
+///
+/// # Returns
+/// HEDL_OK, HEDL_ERR_NOT_FOUND if `index` is out of range, or
+/// HEDL_ERR_TYPE_MISMATCH if the field is not a number.
+///
+/// # Safety
+/// All pointers must be valid.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_node_field_float(
+    node: *const HedlNode,
+    index: usize,
+    out_value: *mut c_double,
+) -> c_int {
+    if out_value.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    match node_field(node, index).map(Value::as_float) {
+        Ok(Some(f)) => {
+            *out_value = f;
+            HEDL_OK
+        }
+        Ok(None) => HEDL_ERR_TYPE_MISMATCH,
+        Err(code) => code,
+    }
+}
+
+/// Get a boolean field (stored as 0 or 1).
+///
+/// # Returns
+/// HEDL_OK, HEDL_ERR_NOT_FOUND if `index` is out of range, or
+/// HEDL_ERR_TYPE_MISMATCH if the field is not a boolean.
+///
+/// # Safety
+/// All pointers must be valid.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_node_field_bool(
+    node: *const HedlNode,
+    index: usize,
+    out_value: *mut c_int,
+) -> c_int {
+    if out_value.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    match node_field(node, index).map(Value::as_bool) {
+        Ok(Some(b)) => {
+            *out_value = b as c_int;
+            HEDL_OK
+        }
+        Ok(None) => HEDL_ERR_TYPE_MISMATCH,
+        Err(code) => code,
+    }
+}
+
+/// Get a string field as a borrowed view.
+///
+/// # Returns
+/// HEDL_OK, HEDL_ERR_NOT_FOUND if `index` is out of range, or
+/// HEDL_ERR_TYPE_MISMATCH if the field is not a string.
+///
+/// # Safety
+/// `node` and `out_str` must be valid; `out_len` may be NULL.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_node_field_string(
+    node: *const HedlNode,
+    index: usize,
+    out_str: *mut *const c_char,
+    out_len: *mut usize,
+) -> c_int {
+    if out_str.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    match node_field(node, index).map(Value::as_str) {
+        Ok(Some(s)) => write_str_view(s, out_str, out_len),
+        Ok(None) => HEDL_ERR_TYPE_MISMATCH,
+        Err(code) => code,
+    }
+}
+
+/// Get a reference field as borrowed views of its type and target ID.
+///
+/// `*out_type` is set to NULL (length 0) for local references.
+///
+/// # Returns
+/// HEDL_OK, HEDL_ERR_NOT_FOUND if `index` is out of range, or
+/// HEDL_ERR_TYPE_MISMATCH if the field is not a reference.
+///
+/// # Safety
+/// `node`, `out_type` and `out_id` must be valid; length pointers may be NULL.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_node_field_reference(
+    node: *const HedlNode,
+    index: usize,
+    out_type: *mut *const c_char,
+    out_type_len: *mut usize,
+    out_id: *mut *const c_char,
+    out_id_len: *mut usize,
+) -> c_int {
+    if out_type.is_null() || out_id.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    match node_field(node, index).map(Value::as_reference) {
+        Ok(Some(r)) => {
+            match &r.type_name {
+                Some(t) => {
+                    write_str_view(t, out_type, out_type_len);
+                }
+                None => {
+                    *out_type = ptr::null();
+                    if !out_type_len.is_null() {
+                        *out_type_len = 0;
+                    }
+                }
+            }
+            write_str_view(&r.id, out_id, out_id_len)
+        }
+        Ok(None) => HEDL_ERR_TYPE_MISMATCH,
+        Err(code) => code,
+    }
+}
+
+// =============================================================================
+// Node Children
+// =============================================================================
+
+/// Get the number of child type groups of a node.
+///
+/// # Safety
+/// Node pointer must be valid or NULL (returns 0).
+#[no_mangle]
+pub unsafe extern "C" fn hedl_node_child_group_count(node: *const HedlNode) -> usize {
+    if node.is_null() {
+        return 0;
+    }
+    (*node).inner.children.len()
+}
+
+/// Advance a key cursor over a node's child groups in type-name order.
+///
+/// Pass `after_type = NULL` for the first group, then the type returned by
+/// the previous call. Children of a group are read with
+/// [`hedl_node_child`].
+///
+/// # Returns
+/// HEDL_OK with the group, or HEDL_ERR_NOT_FOUND past the last group.
+///
+/// # Safety
+/// `node`, `out_type` and `out_count` must be valid; `out_type_len` may be NULL.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_node_children_next(
+    node: *const HedlNode,
+    after_type: *const c_char,
+    after_len: usize,
+    out_type: *mut *const c_char,
+    out_type_len: *mut usize,
+    out_count: *mut usize,
+) -> c_int {
+    if node.is_null() || out_type.is_null() || out_count.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    match next_entry(&(*node).inner.children, after_type, after_len) {
+        Ok(Some((type_name, children))) => {
+            *out_count = children.len();
+            write_str_view(type_name, out_type, out_type_len)
+        }
+        Ok(None) => HEDL_ERR_NOT_FOUND,
+        Err(code) => code,
+    }
+}
+
+/// Get child `index` of the given type.
+///
+/// # Safety
+/// `node` must be valid; `type_name` must point to at least `type_len`
+/// bytes. Returns NULL if there is no such child.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_node_child(
+    node: *const HedlNode,
+    type_name: *const c_char,
+    type_len: usize,
+    index: usize,
+) -> *const HedlNode {
+    if node.is_null() {
+        return ptr::null();
+    }
+    let type_name = match borrow_key(type_name, type_len) {
+        Ok(t) => t,
+        Err(_) => return ptr::null(),
+    };
+    match (*node)
+        .inner
+        .children
+        .get(type_name)
+        .and_then(|c| c.get(index))
+    {
+        Some(child) => node_handle(child),
+        None => ptr::null(),
+    }
+}
+
+// =============================================================================
+// Node Lookup
+// =============================================================================
+
+/// Find the node of a type with a given ID.
+///
+/// The first lookup on a document indexes all of its nodes, nested children
+/// included, in one pass; every later lookup is a single hash probe. The
+/// index is kept with the document and dropped when the document changes.
+///
+/// # Returns
+/// HEDL_OK, or HEDL_ERR_NOT_FOUND if no node of that type has the ID.
+///
+/// # Safety
+/// `doc` and `out_node` must be valid; `type_name` and `id` must point to at
+/// least `type_len` and `id_len` bytes.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_find_node(
+    doc: *const HedlDocument,
+    type_name: *const c_char,
+    type_len: usize,
+    id: *const c_char,
+    id_len: usize,
+    out_node: *mut *const HedlNode,
+) -> c_int {
+    if !is_valid_document_ptr(doc) || out_node.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    let (type_name, id) = match (borrow_key(type_name, type_len), borrow_key(id, id_len)) {
+        (Ok(t), Ok(i)) => (t, i),
+        (Err(code), _) | (_, Err(code)) => return code,
+    };
+    match (*doc).node_index().get(type_name, id).map(node_handle) {
+        Some(node) => {
+            *out_node = node;
+            HEDL_OK
+        }
+        None => HEDL_ERR_NOT_FOUND,
+    }
+}
+
+/// Find the node a reference value points to.
+///
+/// Resolution follows strict parsing: a qualified reference looks only in
+/// its type; an unqualified one looks in the type of `context` (the node the
+/// reference was read from) or, for a key-value reference (`context` NULL),
+/// in every type. Uses the same index as [`hedl_find_node`].
+///
+/// # Arguments
+/// * `doc` - Document the reference was read from
+/// * `reference` - View of a reference value (from `hedl_node_field` or
+///   `hedl_item_value`)
+/// * `context` - Node holding the reference, or NULL for a key-value reference
+/// * `out_node` - Receives the target node
+///
+/// # Returns
+/// HEDL_OK, HEDL_ERR_TYPE_MISMATCH if the view is not a reference, or
+/// HEDL_ERR_NOT_FOUND if the reference does not name exactly one node (the
+/// ID is undefined, or an unqualified key-value reference matches several
+/// types).
+///
+/// # Safety
+/// `doc`, `reference` and `out_node` must be valid; `context` must be valid
+/// or NULL.
+#[no_mangle]
+pub unsafe extern "C" fn hedl_resolve_reference(
+    doc: *const HedlDocument,
+    reference: *const HedlValueView,
+    context: *const HedlNode,
+    out_node: *mut *const HedlNode,
+) -> c_int {
+    if !is_valid_document_ptr(doc) || reference.is_null() || out_node.is_null() {
+        return HEDL_ERR_NULL_PTR;
+    }
+    let view = &*reference;
+    if view.kind != HEDL_VALUE_REFERENCE {
+        return HEDL_ERR_TYPE_MISMATCH;
+    }
+    let id = match borrow_key(view.str_ptr, view.str_len) {
+        Ok(id) => id,
+        Err(code) => return code,
+    };
+    let type_name = if view.ref_type_ptr.is_null() {
+        None
+    } else {
+        match borrow_key(view.ref_type_ptr, view.ref_type_len) {
+            Ok(t) => Some(t),
+            Err(code) => return code,
+        }
+    };
+    let current_type = if context.is_null() {
+        None
+    } else {
+        Some((*context).inner.type_name.as_str())
+    };
+    let target = (*doc)
+        .node_index()
+        .resolve_id(type_name, id, current_type)
+        .ok()
+        .flatten()
+        .map(node_handle);
+    match target {
+        Some(node) => {
+            *out_node = node;
+            HEDL_OK
+        }
+        None => HEDL_ERR_NOT_FOUND,
+    }
+}
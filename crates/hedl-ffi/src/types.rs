@@ -17,8 +17,11 @@
 
 //! FFI type definitions and error codes.
 
-use hedl_core::Document;
+use hedl_c14n::{CanonicalConfig, DigestAlgorithm, DocumentDigests};
+use hedl_core::{Document, HedlError, NodeIndex};
+use std::borrow::{Borrow, BorrowMut};
 use std::os::raw::c_int;
+use std::sync::{Arc, OnceLock};
 
 // =============================================================================
 // Error Codes
@@ -37,16 +40,104 @@ pub const HEDL_ERR_CSV: c_int = -9;
 pub const HEDL_ERR_PARQUET: c_int = -10;
 pub const HEDL_ERR_LINT: c_int = -11;
 pub const HEDL_ERR_NEO4J: c_int = -12;
+pub const HEDL_ERR_IO: c_int = -13;
+pub const HEDL_ERR_NOT_FOUND: c_int = -14;
+pub const HEDL_ERR_BUFFER_TOO_SMALL: c_int = -15;
+pub const HEDL_ERR_TYPE_MISMATCH: c_int = -16;
+pub const HEDL_ERR_CANCELLED: c_int = -17;
+pub const HEDL_ERR_SNAPSHOT: c_int = -18;
+pub const HEDL_ERR_PATCH: c_int = -19;
 
 // =============================================================================
 // Opaque Types
 // =============================================================================
 
 /// Opaque handle to a HEDL document
+///
+/// Read `inner` freely, but change it only through
+/// [`HedlDocument::document_mut`], which drops the cached lookups.
 pub struct HedlDocument {
+    // Declared first so the cache is dropped before the document it borrows
+    cache: DocCache,
     pub(crate) inner: Document,
 }
 
+/// Lookups built from a document on first use and kept next to it.
+///
+/// The cached values borrow the document. They stay valid because the
+/// handle is never moved once it is in use (handles live on the heap, and
+/// `hedl_document_share` clears the cache before moving one), and because
+/// every change goes through `&mut` access that clears the cache first.
+#[derive(Default)]
+struct DocCache {
+    node_index: OnceLock<NodeIndex<'static>>,
+    /// Canonical digests of the document and its root entries, one slot per
+    /// algorithm (see `HedlDocument::digests`).
+    digests: [OnceLock<Arc<DocumentDigests>>; 2],
+}
+
+impl HedlDocument {
+    pub(crate) fn new(inner: Document) -> Self {
+        Self {
+            cache: DocCache::default(),
+            inner,
+        }
+    }
+
+    /// Index of the document's nodes by type and ID, built on first use.
+    pub(crate) fn node_index(&self) -> &NodeIndex<'_> {
+        self.cache.node_index.get_or_init(|| {
+            // SAFETY: the index lives in `self.cache`, which is cleared
+            // before `self.inner` is changed, moved or dropped (see DocCache)
+            let doc: &'static Document = unsafe { &*(&self.inner as *const Document) };
+            doc.node_index()
+        })
+    }
+
+    /// Canonical digests of the document and each root entry, computed in
+    /// one pass on first use.
+    pub(crate) fn digests(
+        &self,
+        algorithm: DigestAlgorithm,
+    ) -> Result<Arc<DocumentDigests>, HedlError> {
+        let slot = &self.cache.digests[match algorithm {
+            DigestAlgorithm::Blake3 => 0,
+            DigestAlgorithm::Xxh3_128 => 1,
+        }];
+        if let Some(digests) = slot.get() {
+            return Ok(Arc::clone(digests));
+        }
+        let digests =
+            hedl_c14n::canonical_digests(&self.inner, &CanonicalConfig::default(), algorithm)?;
+        Ok(Arc::clone(slot.get_or_init(|| Arc::new(digests))))
+    }
+
+    /// Mutable access to the document, dropping every cached lookup.
+    pub(crate) fn document_mut(&mut self) -> &mut Document {
+        self.cache = DocCache::default();
+        &mut self.inner
+    }
+}
+
+impl From<Document> for HedlDocument {
+    fn from(inner: Document) -> Self {
+        Self::new(inner)
+    }
+}
+
+impl Borrow<Document> for HedlDocument {
+    fn borrow(&self) -> &Document {
+        &self.inner
+    }
+}
+
+// Lets `IncrementalDocument` own a handle: its edits clear the cache
+impl BorrowMut<Document> for HedlDocument {
+    fn borrow_mut(&mut self) -> &mut Document {
+        self.document_mut()
+    }
+}
+
 /// Opaque handle to lint diagnostics
 pub struct HedlDiagnostics {
     pub(crate) inner: Vec<hedl_lint::Diagnostic>,
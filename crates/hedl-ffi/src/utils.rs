@@ -18,8 +18,11 @@
 //! Utility functions for FFI.
 
 use crate::error::set_error;
-use crate::types::{HEDL_ERR_INVALID_UTF8, HEDL_OK};
+use crate::metrics::{note_input, note_output};
+use crate::types::{HEDL_ERR_INVALID_UTF8, HEDL_ERR_IO, HEDL_OK};
+use memmap2::Mmap;
 use std::ffi::{CStr, CString};
+use std::fs::File;
 use std::os::raw::{c_char, c_int};
 use std::ptr;
 use std::slice;
@@ -32,27 +35,28 @@ use std::slice;
 /// This prevents extreme values that could cause memory issues.
 const MAX_FFI_INPUT_LEN: usize = 1024 * 1024 * 1024;
 
-/// Helper to get input string from C pointer.
+/// Helper to borrow the input string behind a C pointer.
+///
+/// The returned slice points straight into the caller's buffer; no copy is
+/// made. Inputs passed with an explicit `c_int` length are capped at
+/// `MAX_FFI_INPUT_LEN`; use [`get_input_str_sized`] for the `size_t` entry points.
 ///
 /// # Arguments
 /// * `input` - Pointer to input string
 /// * `input_len` - Length in bytes, or -1 for null-terminated
 ///
 /// # Safety
-/// The caller MUST ensure `input_len` matches the actual buffer size.
+/// The caller MUST ensure `input_len` matches the actual buffer size and that
+/// the buffer outlives every use of the returned slice (`'a` is unbounded).
 /// Passing an incorrect length causes undefined behavior.
-pub(crate) unsafe fn get_input_string(
+pub(crate) unsafe fn get_input_str<'a>(
     input: *const c_char,
     input_len: c_int,
-) -> Result<String, c_int> {
+) -> Result<&'a str, c_int> {
     if input_len < 0 {
-        match CStr::from_ptr(input).to_str() {
-            Ok(s) => Ok(s.to_string()),
-            Err(e) => {
-                set_error(&format!("Invalid UTF-8: {}", e));
-                Err(HEDL_ERR_INVALID_UTF8)
-            }
-        }
+        let input = borrow_c_str(input).map_err(report)?;
+        note_input(input.len());
+        Ok(input)
     } else {
         let len = input_len as usize;
 
@@ -65,25 +69,132 @@ pub(crate) unsafe fn get_input_string(
             return Err(HEDL_ERR_INVALID_UTF8);
         }
 
-        let bytes = slice::from_raw_parts(input as *const u8, len);
-        match std::str::from_utf8(bytes) {
-            Ok(s) => Ok(s.to_string()),
-            Err(e) => {
-                set_error(&format!("Invalid UTF-8: {}", e));
-                Err(HEDL_ERR_INVALID_UTF8)
-            }
+        get_input_str_sized(input, len)
+    }
+}
+
+/// Helper to borrow an input buffer with an explicit `size_t` length.
+///
+/// Unlike [`get_input_str`] there is no null-terminated mode and no 1GB cap;
+/// parser limits (e.g. `Limits::max_file_size`) still apply downstream.
+///
+/// # Safety
+/// `input` must point to at least `input_len` readable bytes that outlive
+/// every use of the returned slice.
+pub(crate) unsafe fn get_input_str_sized<'a>(
+    input: *const c_char,
+    input_len: usize,
+) -> Result<&'a str, c_int> {
+    let input = borrow_input_sized(input, input_len).map_err(report)?;
+    note_input(input.len());
+    Ok(input)
+}
+
+/// Borrow a null-terminated C string as UTF-8.
+///
+/// Like the `get_input_str*` helpers but returns the error message instead
+/// of storing it in the thread-local last error, for callers that report
+/// errors per item.
+///
+/// # Safety
+/// `input` must be a valid null-terminated string that outlives `'a`.
+pub(crate) unsafe fn borrow_c_str<'a>(input: *const c_char) -> Result<&'a str, (c_int, String)> {
+    CStr::from_ptr(input)
+        .to_str()
+        .map_err(|e| (HEDL_ERR_INVALID_UTF8, format!("Invalid UTF-8: {}", e)))
+}
+
+/// Borrow a length-delimited buffer as UTF-8, returning the error message.
+///
+/// # Safety
+/// `input` must point to at least `input_len` readable bytes that outlive `'a`.
+pub(crate) unsafe fn borrow_input_sized<'a>(
+    input: *const c_char,
+    input_len: usize,
+) -> Result<&'a str, (c_int, String)> {
+    // slice::from_raw_parts requires len <= isize::MAX
+    if input_len > isize::MAX as usize {
+        return Err((
+            HEDL_ERR_INVALID_UTF8,
+            format!("Input length {} exceeds address space", input_len),
+        ));
+    }
+
+    let bytes = slice::from_raw_parts(input as *const u8, input_len);
+    std::str::from_utf8(bytes)
+        .map_err(|e| (HEDL_ERR_INVALID_UTF8, format!("Invalid UTF-8: {}", e)))
+}
+
+/// Store a borrow error in the thread-local last error and return its code.
+fn report((code, msg): (c_int, String)) -> c_int {
+    set_error(&msg);
+    code
+}
+
+/// Read-only contents of an input file.
+///
+/// Non-empty files are memory-mapped, so the parser reads pages straight from
+/// the OS page cache without a heap copy. Empty files cannot be mapped on
+/// every platform and are represented without a mapping.
+pub(crate) enum MappedFile {
+    Mapped(Mmap),
+    Empty,
+}
+
+impl MappedFile {
+    pub(crate) fn bytes(&self) -> &[u8] {
+        match self {
+            MappedFile::Mapped(map) => map,
+            MappedFile::Empty => &[],
         }
     }
 }
 
+/// Open and memory-map the file named by a null-terminated UTF-8 path.
+///
+/// Errors are stored in the thread-local last error: `HEDL_ERR_INVALID_UTF8`
+/// for a bad path, `HEDL_ERR_IO` if the file cannot be opened or mapped.
+///
+/// # Safety
+/// `path` must be a valid null-terminated string. The file must not be
+/// truncated while the mapping is alive.
+pub(crate) unsafe fn map_input_file(path: *const c_char) -> Result<MappedFile, c_int> {
+    let path = borrow_c_str(path).map_err(report)?;
+
+    let io_error = |what: &str, e: std::io::Error| {
+        report((HEDL_ERR_IO, format!("Failed to {} '{}': {}", what, path, e)))
+    };
+
+    let file = File::open(path).map_err(|e| io_error("open", e))?;
+    let len = file.metadata().map_err(|e| io_error("stat", e))?.len();
+    note_input(len as usize);
+    if len == 0 {
+        return Ok(MappedFile::Empty);
+    }
+
+    // SAFETY: read-only mapping; the caller guarantees the file is not
+    // truncated while it is mapped.
+    let map = Mmap::map(&file).map_err(|e| io_error("map", e))?;
+
+    // The parser makes a single forward pass
+    #[cfg(unix)]
+    let _ = map.advise(memmap2::Advice::Sequential);
+
+    Ok(MappedFile::Mapped(map))
+}
+
 /// Helper to allocate output string
+///
+/// Takes the serialized output by value so its buffer becomes the C string
+/// (at most one reallocation for the terminator) instead of being copied.
 pub(crate) unsafe fn allocate_output_string(
-    s: &str,
+    s: String,
     out_str: *mut *mut c_char,
     err_code: c_int,
 ) -> c_int {
     match CString::new(s) {
         Ok(cstr) => {
+            note_output(cstr.as_bytes().len());
             *out_str = cstr.into_raw();
             HEDL_OK
         }
@@ -0,0 +1,196 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Borrowed value views for FFI.
+//!
+//! Accessors that hand values back to C fill a [`HedlValueView`] instead of
+//! allocating. String payloads point directly into the owning object (a
+//! document or the current stream event) and are NOT null-terminated.
+
+use crate::types::HEDL_OK;
+use hedl_core::Value;
+use std::os::raw::{c_char, c_int};
+use std::ptr;
+
+// =============================================================================
+// Value Kinds
+// =============================================================================
+
+pub const HEDL_VALUE_NULL: c_int = 0;
+pub const HEDL_VALUE_BOOL: c_int = 1;
+pub const HEDL_VALUE_INT: c_int = 2;
+pub const HEDL_VALUE_FLOAT: c_int = 3;
+pub const HEDL_VALUE_STRING: c_int = 4;
+pub const HEDL_VALUE_TENSOR: c_int = 5;
+pub const HEDL_VALUE_REFERENCE: c_int = 6;
+pub const HEDL_VALUE_EXPRESSION: c_int = 7;
+
+// =============================================================================
+// Value View
+// =============================================================================
+
+/// Borrowed view of a HEDL value.
+///
+/// Only the members matching `kind` are meaningful:
+///
+/// - `HEDL_VALUE_BOOL`: `bool_value` (0 or 1)
+/// - `HEDL_VALUE_INT`: `int_value`
+/// - `HEDL_VALUE_FLOAT`: `float_value`
+/// - `HEDL_VALUE_STRING`: `str_ptr`/`str_len`
+/// - `HEDL_VALUE_REFERENCE`: `str_ptr`/`str_len` hold the target ID and
+///   `ref_type_ptr`/`ref_type_len` the qualifying type (NULL for local references)
+///
+/// Tensors and expressions only report their kind.
+///
+/// # Lifetime
+///
+/// Pointers are borrowed from the object the view was read from and become
+/// invalid when that object is modified or freed.
+#[repr(C)]
+pub struct HedlValueView {
+    pub kind: c_int,
+    pub bool_value: c_int,
+    pub int_value: i64,
+    pub float_value: f64,
+    pub str_ptr: *const c_char,
+    pub str_len: usize,
+    pub ref_type_ptr: *const c_char,
+    pub ref_type_len: usize,
+}
+
+impl HedlValueView {
+    /// Build a view borrowing from `value`.
+    pub(crate) fn from_value(value: &Value) -> Self {
+        let mut view = HedlValueView {
+            kind: HEDL_VALUE_NULL,
+            bool_value: 0,
+            int_value: 0,
+            float_value: 0.0,
+            str_ptr: ptr::null(),
+            str_len: 0,
+            ref_type_ptr: ptr::null(),
+            ref_type_len: 0,
+        };
+
+        match value {
+            Value::Null => {}
+            Value::Bool(b) => {
+                view.kind = HEDL_VALUE_BOOL;
+                view.bool_value = *b as c_int;
+            }
+            Value::Int(n) => {
+                view.kind = HEDL_VALUE_INT;
+                view.int_value = *n;
+            }
+            Value::Float(f) => {
+                view.kind = HEDL_VALUE_FLOAT;
+                view.float_value = *f;
+            }
+            Value::String(s) => {
+                view.kind = HEDL_VALUE_STRING;
+                view.str_ptr = s.as_ptr() as *const c_char;
+                view.str_len = s.len();
+            }
+            Value::Tensor(_) => view.kind = HEDL_VALUE_TENSOR,
+            Value::Reference(r) => {
+                view.kind = HEDL_VALUE_REFERENCE;
+                view.str_ptr = r.id.as_ptr() as *const c_char;
+                view.str_len = r.id.len();
+                if let Some(t) = &r.type_name {
+                    view.ref_type_ptr = t.as_ptr() as *const c_char;
+                    view.ref_type_len = t.len();
+                }
+            }
+            Value::Expression(_) => view.kind = HEDL_VALUE_EXPRESSION,
+        }
+
+        view
+    }
+}
+
+/// Store a borrowed `(ptr, len)` view of `s` into the caller's out-parameters.
+///
+/// # Safety
+/// `out_ptr` must be valid; `out_len` may be NULL.
+#[inline]
+pub(crate) unsafe fn write_str_view(
+    s: &str,
+    out_ptr: *mut *const c_char,
+    out_len: *mut usize,
+) -> c_int {
+    *out_ptr = s.as_ptr() as *const c_char;
+    if !out_len.is_null() {
+        *out_len = s.len();
+    }
+    HEDL_OK
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use hedl_core::Reference;
+    use std::slice;
+
+    unsafe fn view_str(ptr: *const c_char, len: usize) -> &'static str {
+        std::str::from_utf8(slice::from_raw_parts(ptr as *const u8, len)).unwrap()
+    }
+
+    #[test]
+    fn test_scalar_views() {
+        assert_eq!(
+            HedlValueView::from_value(&Value::Null).kind,
+            HEDL_VALUE_NULL
+        );
+
+        let v = HedlValueView::from_value(&Value::Bool(true));
+        assert_eq!(v.kind, HEDL_VALUE_BOOL);
+        assert_eq!(v.bool_value, 1);
+
+        let v = HedlValueView::from_value(&Value::Int(-42));
+        assert_eq!(v.kind, HEDL_VALUE_INT);
+        assert_eq!(v.int_value, -42);
+
+        let v = HedlValueView::from_value(&Value::Float(2.5));
+        assert_eq!(v.kind, HEDL_VALUE_FLOAT);
+        assert_eq!(v.float_value, 2.5);
+    }
+
+    #[test]
+    fn test_string_view_borrows() {
+        let value = Value::String("hello".to_string());
+        let v = HedlValueView::from_value(&value);
+        assert_eq!(v.kind, HEDL_VALUE_STRING);
+        assert_eq!(v.str_ptr as *const u8, value.as_str().unwrap().as_ptr());
+        assert_eq!(unsafe { view_str(v.str_ptr, v.str_len) }, "hello");
+    }
+
+    #[test]
+    fn test_reference_view() {
+        let value = Value::Reference(Reference::qualified("User", "alice"));
+        let v = HedlValueView::from_value(&value);
+        assert_eq!(v.kind, HEDL_VALUE_REFERENCE);
+        unsafe {
+            assert_eq!(view_str(v.str_ptr, v.str_len), "alice");
+            assert_eq!(view_str(v.ref_type_ptr, v.ref_type_len), "User");
+        }
+
+        let local = Value::Reference(Reference::local("bob"));
+        let v = HedlValueView::from_value(&local);
+        assert!(v.ref_type_ptr.is_null());
+        assert_eq!(v.ref_type_len, 0);
+    }
+}
@@ -0,0 +1,158 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//! Tests for the Arrow C Data Interface functions.
+
+#![cfg(feature = "parquet")]
+
+use hedl_ffi::*;
+use hedl_parquet::{FFI_ArrowArray, FFI_ArrowSchema};
+use std::ffi::CStr;
+use std::os::raw::c_char;
+use std::ptr;
+
+const USERS: &str = concat!(
+    "%VERSION: 1.0\n",
+    "%STRUCT: User: [id, name, age]\n",
+    "---\n",
+    "users: @User\n",
+    "  | alice, Alice, 30\n",
+    "  | bob, Bob, 25\n",
+);
+
+unsafe fn parse(input: &str) -> *mut HedlDocument {
+    let mut doc: *mut HedlDocument = ptr::null_mut();
+    assert_eq!(
+        hedl_parse(
+            input.as_ptr() as *const c_char,
+            input.len() as i32,
+            1,
+            &mut doc
+        ),
+        HEDL_OK
+    );
+    doc
+}
+
+/// Export the list of `type_name` (null-terminated).
+unsafe fn export(doc: *const HedlDocument, type_name: &[u8]) -> (FFI_ArrowSchema, FFI_ArrowArray) {
+    let mut schema = FFI_ArrowSchema::empty();
+    let mut array = FFI_ArrowArray::empty();
+    let rc = hedl_to_arrow(
+        doc,
+        type_name.as_ptr() as *const c_char,
+        &mut schema,
+        &mut array,
+    );
+    assert_eq!(rc, HEDL_OK);
+    (schema, array)
+}
+
+#[test]
+fn test_export_import_round_trip() {
+    unsafe {
+        let doc = parse(USERS);
+        let (schema, mut array) = export(doc, b"User\0");
+        // Exported buffers do not borrow the document
+        hedl_free_document(doc);
+
+        assert_eq!(array.len(), 2);
+        assert_eq!(schema.format(), "+s");
+        assert_eq!(schema.child(1).name(), Some("name"));
+
+        let mut back: *mut HedlDocument = ptr::null_mut();
+        assert_eq!(hedl_from_arrow(&schema, &mut array, &mut back), HEDL_OK);
+        assert!(array.is_released());
+        assert_eq!(hedl_root_item_count(back), 1);
+
+        let mut canonical: *mut c_char = ptr::null_mut();
+        assert_eq!(hedl_canonicalize(back, &mut canonical), HEDL_OK);
+        let text = CStr::from_ptr(canonical).to_str().unwrap();
+        assert!(text.contains("users: @User"), "{}", text);
+        assert!(text.contains("bob, Bob, 25"), "{}", text);
+        hedl_free_string(canonical);
+        hedl_free_document(back);
+    }
+}
+
+#[test]
+fn test_unknown_type_is_not_found() {
+    unsafe {
+        let doc = parse(USERS);
+        let mut schema = FFI_ArrowSchema::empty();
+        let mut array = FFI_ArrowArray::empty();
+        let rc = hedl_to_arrow(
+            doc,
+            b"Post\0".as_ptr() as *const c_char,
+            &mut schema,
+            &mut array,
+        );
+        assert_eq!(rc, HEDL_ERR_NOT_FOUND);
+        assert!(array.is_released());
+        hedl_free_document(doc);
+    }
+}
+
+#[test]
+fn test_import_rejects_released_array() {
+    unsafe {
+        let doc = parse(USERS);
+        let (schema, mut array) = export(doc, b"User\0");
+        let mut back: *mut HedlDocument = ptr::null_mut();
+        assert_eq!(hedl_from_arrow(&schema, &mut array, &mut back), HEDL_OK);
+        hedl_free_document(back);
+
+        // The first import moved the array out
+        assert_eq!(
+            hedl_from_arrow(&schema, &mut array, &mut back),
+            HEDL_ERR_PARQUET
+        );
+        assert!(back.is_null());
+        hedl_free_document(doc);
+    }
+}
+
+#[test]
+fn test_null_pointers() {
+    unsafe {
+        let doc = parse(USERS);
+        let mut schema = FFI_ArrowSchema::empty();
+        let mut array = FFI_ArrowArray::empty();
+        let mut out: *mut HedlDocument = ptr::null_mut();
+        assert_eq!(
+            hedl_to_arrow(
+                ptr::null(),
+                b"User\0".as_ptr() as *const c_char,
+                &mut schema,
+                &mut array
+            ),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(
+            hedl_to_arrow(doc, ptr::null(), &mut schema, &mut array),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(
+            hedl_from_arrow(ptr::null(), &mut array, &mut out),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(
+            hedl_from_arrow(&schema, ptr::null_mut(), &mut out),
+            HEDL_ERR_NULL_PTR
+        );
+        hedl_free_document(doc);
+    }
+}
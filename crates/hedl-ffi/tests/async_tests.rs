@@ -0,0 +1,293 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Tests for asynchronous operations (hedl_*_async, hedl_async_*)
+
+use hedl_ffi::*;
+use std::ffi::CStr;
+use std::os::raw::{c_char, c_int, c_void};
+use std::ptr;
+use std::sync::mpsc;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+const DOC: &str = "%VERSION: 1.0\n%STRUCT: User: [id,name]\n---\nname: Alice\nusers: @User\n  | u1, Alice\n  | u2, Bob\n";
+
+type Completions = mpsc::Receiver<(usize, c_int)>;
+
+/// Sends `(op, status)` for every completion.
+unsafe extern "C" fn record(op: *mut HedlAsyncOp, status: c_int, user_data: *mut c_void) {
+    let tx = &*(user_data as *const mpsc::Sender<(usize, c_int)>);
+    tx.send((op as usize, status)).unwrap();
+}
+
+/// Like `record`, but frees its own operation first.
+unsafe extern "C" fn record_and_free(op: *mut HedlAsyncOp, status: c_int, user_data: *mut c_void) {
+    assert_eq!(hedl_async_wait(op), status);
+    hedl_async_free(op);
+    record(op, status, user_data);
+}
+
+/// Callback context; leaked so it outlives every worker.
+fn completions() -> (*mut c_void, Completions) {
+    let (tx, rx) = mpsc::channel();
+    (Box::into_raw(Box::new(tx)) as *mut c_void, rx)
+}
+
+fn parse(input: &str) -> *mut HedlDocument {
+    let mut doc: *mut HedlDocument = ptr::null_mut();
+    let rc = unsafe { hedl_parse_sized(input.as_ptr() as *const c_char, input.len(), 0, 0, &mut doc) };
+    assert_eq!(rc, HEDL_OK);
+    doc
+}
+
+fn parse_async(
+    input: &'static str,
+    callback: HedlAsyncCallback,
+) -> (*mut HedlAsyncOp, Completions) {
+    let (user_data, rx) = completions();
+    let mut op: *mut HedlAsyncOp = ptr::null_mut();
+    let rc = unsafe {
+        hedl_parse_async(
+            input.as_ptr() as *const c_char,
+            input.len(),
+            1,
+            Some(callback),
+            user_data,
+            &mut op,
+        )
+    };
+    assert_eq!(rc, HEDL_OK);
+    assert!(!op.is_null());
+    (op, rx)
+}
+
+// =============================================================================
+// Parsing
+// =============================================================================
+
+#[test]
+fn test_parse_async_delivers_document() {
+    let (op, rx) = parse_async(DOC, record);
+    assert_eq!(rx.recv().unwrap(), (op as usize, HEDL_OK));
+    unsafe {
+        assert_eq!(hedl_async_wait(op), HEDL_OK);
+        assert_eq!(hedl_async_status(op), HEDL_OK);
+        assert!(hedl_async_error(op).is_null());
+
+        let mut text: *mut c_char = ptr::null_mut();
+        assert_eq!(
+            hedl_async_take_string(op, &mut text),
+            HEDL_ERR_TYPE_MISMATCH
+        );
+        assert!(text.is_null());
+
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        assert_eq!(hedl_async_take_document(op, &mut doc), HEDL_OK);
+        let mut again: *mut HedlDocument = ptr::null_mut();
+        assert_eq!(hedl_async_take_document(op, &mut again), HEDL_ERR_NOT_FOUND);
+        hedl_async_free(op);
+
+        // The document outlives its operation
+        assert_eq!(hedl_root_item_count(doc), 2);
+        hedl_free_document(doc);
+    }
+}
+
+#[test]
+fn test_parse_async_reports_error_on_handle() {
+    let (op, rx) = parse_async("%VERSION: 1.0\n---\nusers: @Missing\n  | u1\n", record);
+    assert_eq!(rx.recv().unwrap(), (op as usize, HEDL_ERR_PARSE));
+    unsafe {
+        assert_eq!(hedl_async_wait(op), HEDL_ERR_PARSE);
+        let msg = CStr::from_ptr(hedl_async_error(op)).to_str().unwrap();
+        assert!(msg.starts_with("Parse error"), "{}", msg);
+
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        assert_eq!(hedl_async_take_document(op, &mut doc), HEDL_ERR_PARSE);
+        assert!(doc.is_null());
+        hedl_async_free(op);
+    }
+}
+
+#[test]
+fn test_parse_file_async_missing_file() {
+    let (user_data, rx) = completions();
+    let mut op: *mut HedlAsyncOp = ptr::null_mut();
+    let path = b"/nonexistent/hedl-async-test.hedl\0";
+    unsafe {
+        let rc = hedl_parse_file_async(
+            path.as_ptr() as *const c_char,
+            0,
+            0,
+            Some(record),
+            user_data,
+            &mut op,
+        );
+        assert_eq!(rc, HEDL_OK);
+        assert_eq!(rx.recv().unwrap().1, HEDL_ERR_IO);
+        hedl_async_free(op);
+    }
+}
+
+#[test]
+fn test_callback_may_free_its_operation() {
+    let (op, rx) = parse_async(DOC, record_and_free);
+    // The document was never taken; freeing the handle released it
+    assert_eq!(rx.recv().unwrap(), (op as usize, HEDL_OK));
+}
+
+// =============================================================================
+// Export
+// =============================================================================
+
+#[test]
+fn test_canonicalize_async_matches_sync() {
+    let doc = parse(DOC);
+    let (user_data, rx) = completions();
+    unsafe {
+        let mut expected: *mut c_char = ptr::null_mut();
+        assert_eq!(hedl_canonicalize(doc, &mut expected), HEDL_OK);
+
+        let mut op: *mut HedlAsyncOp = ptr::null_mut();
+        assert_eq!(
+            hedl_canonicalize_async(doc, Some(record), user_data, &mut op),
+            HEDL_OK
+        );
+        assert_eq!(rx.recv().unwrap().1, HEDL_OK);
+
+        let mut out: *mut c_char = ptr::null_mut();
+        assert_eq!(hedl_async_take_string(op, &mut out), HEDL_OK);
+        assert_eq!(CStr::from_ptr(out), CStr::from_ptr(expected));
+
+        hedl_free_string(out);
+        hedl_free_string(expected);
+        hedl_async_free(op);
+        hedl_free_document(doc);
+    }
+}
+
+#[cfg(feature = "json")]
+#[test]
+fn test_to_json_async_matches_sync() {
+    let doc = parse(DOC);
+    let (user_data, rx) = completions();
+    unsafe {
+        let mut expected: *mut c_char = ptr::null_mut();
+        assert_eq!(hedl_to_json(doc, 1, &mut expected), HEDL_OK);
+
+        let mut op: *mut HedlAsyncOp = ptr::null_mut();
+        assert_eq!(
+            hedl_to_json_async(doc, 1, Some(record), user_data, &mut op),
+            HEDL_OK
+        );
+        assert_eq!(hedl_async_wait(op), HEDL_OK);
+        assert_eq!(rx.recv().unwrap().1, HEDL_OK);
+
+        let mut out: *mut c_char = ptr::null_mut();
+        assert_eq!(hedl_async_take_string(op, &mut out), HEDL_OK);
+        assert_eq!(CStr::from_ptr(out), CStr::from_ptr(expected));
+
+        hedl_free_string(out);
+        hedl_free_string(expected);
+        hedl_async_free(op);
+        hedl_free_document(doc);
+    }
+}
+
+// =============================================================================
+// Cancellation and Argument Checks
+// =============================================================================
+
+#[test]
+fn test_cancel_completes_exactly_once() {
+    let doc = parse(DOC);
+    let (user_data, rx) = completions();
+    unsafe {
+        let mut op: *mut HedlAsyncOp = ptr::null_mut();
+        assert_eq!(
+            hedl_canonicalize_async(doc, Some(record), user_data, &mut op),
+            HEDL_OK
+        );
+        assert_eq!(hedl_async_cancel(op), HEDL_OK);
+
+        // Whichever wins the race, the callback fires once with a final status
+        let status = hedl_async_wait(op);
+        assert!(
+            status == HEDL_OK || status == HEDL_ERR_CANCELLED,
+            "{}",
+            status
+        );
+        assert_eq!(rx.recv().unwrap(), (op as usize, status));
+        hedl_async_free(op);
+        assert!(rx.try_recv().is_err());
+
+        // Freeing a live operation cancels it and waits for its callback
+        let mut op: *mut HedlAsyncOp = ptr::null_mut();
+        assert_eq!(
+            hedl_canonicalize_async(doc, Some(record), user_data, &mut op),
+            HEDL_OK
+        );
+        hedl_async_free(op);
+        assert_eq!(rx.try_recv().unwrap().0, op as usize);
+
+        hedl_free_document(doc);
+    }
+}
+
+#[test]
+fn test_async_null_arguments() {
+    let doc = parse(DOC);
+    let (user_data, _rx) = completions();
+    unsafe {
+        let mut op: *mut HedlAsyncOp = ptr::null_mut();
+        assert_eq!(
+            hedl_parse_async(ptr::null(), 0, 0, Some(record), user_data, &mut op),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(
+            hedl_parse_async(
+                DOC.as_ptr() as *const c_char,
+                DOC.len(),
+                0,
+                None,
+                user_data,
+                &mut op
+            ),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(
+            hedl_canonicalize_async(ptr::null(), Some(record), user_data, &mut op),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(
+            hedl_canonicalize_async(doc, Some(record), user_data, ptr::null_mut()),
+            HEDL_ERR_NULL_PTR
+        );
+        assert!(op.is_null());
+
+        assert_eq!(hedl_async_cancel(ptr::null_mut()), HEDL_ERR_NULL_PTR);
+        assert_eq!(hedl_async_status(ptr::null()), HEDL_ERR_NULL_PTR);
+        assert_eq!(hedl_async_wait(ptr::null()), HEDL_ERR_NULL_PTR);
+        assert!(hedl_async_error(ptr::null()).is_null());
+        hedl_async_free(ptr::null_mut());
+
+        hedl_free_document(doc);
+    }
+}
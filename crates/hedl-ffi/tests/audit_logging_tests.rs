@@ -17,6 +17,8 @@
 
 //! Tests for audit logging functionality in FFI calls.
 
+#![cfg(feature = "audit")]
+
 use hedl_ffi::audit::{
     audit_call_failure, audit_call_start, audit_call_success, get_audit_context, sanitize_bytes,
     sanitize_c_string, sanitize_pointer, sanitize_string, PerformanceMetrics,
@@ -0,0 +1,236 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//! Tests for `hedl_parse_batch`.
+
+use hedl_ffi::*;
+use std::ffi::CStr;
+use std::os::raw::{c_char, c_int};
+use std::ptr;
+
+const VALID_HEDL: &str = "%VERSION: 1.0\n---\nkey: value\n";
+const INVALID_HEDL: &str = "not valid hedl";
+
+/// Per-slot outputs of one batch call.
+struct BatchOutput {
+    result: c_int,
+    docs: Vec<*mut HedlDocument>,
+    codes: Vec<c_int>,
+    errors: Vec<*mut c_char>,
+}
+
+impl Drop for BatchOutput {
+    fn drop(&mut self) {
+        unsafe {
+            for &doc in &self.docs {
+                hedl_free_document(doc);
+            }
+            for &error in &self.errors {
+                hedl_free_string(error);
+            }
+        }
+    }
+}
+
+fn parse_batch(inputs: &[&str], threads: c_int) -> BatchOutput {
+    let ptrs: Vec<*const c_char> = inputs.iter().map(|s| s.as_ptr() as *const c_char).collect();
+    let lens: Vec<usize> = inputs.iter().map(|s| s.len()).collect();
+    let mut out = BatchOutput {
+        result: HEDL_OK,
+        docs: vec![ptr::null_mut(); inputs.len()],
+        codes: vec![i32::MIN; inputs.len()],
+        errors: vec![ptr::null_mut(); inputs.len()],
+    };
+    out.result = unsafe {
+        hedl_parse_batch(
+            ptrs.as_ptr(),
+            lens.as_ptr(),
+            inputs.len(),
+            0,
+            out.docs.as_mut_ptr(),
+            out.codes.as_mut_ptr(),
+            out.errors.as_mut_ptr(),
+            threads,
+        )
+    };
+    out
+}
+
+fn numbered_doc(i: usize) -> String {
+    format!("%VERSION: 1.0\n---\nid: {}\nname: item{}\n", i, i)
+}
+
+#[test]
+fn test_batch_all_valid() {
+    for threads in [0, 1, 4] {
+        let docs: Vec<String> = (0..64).map(numbered_doc).collect();
+        let inputs: Vec<&str> = docs.iter().map(String::as_str).collect();
+        let out = parse_batch(&inputs, threads);
+
+        assert_eq!(out.result, HEDL_OK, "threads = {}", threads);
+        for i in 0..inputs.len() {
+            assert_eq!(out.codes[i], HEDL_OK);
+            assert!(!out.docs[i].is_null());
+            assert!(out.errors[i].is_null());
+            assert_eq!(unsafe { hedl_root_item_count(out.docs[i]) }, 2);
+        }
+    }
+}
+
+#[test]
+fn test_batch_per_slot_errors() {
+    let inputs = [VALID_HEDL, INVALID_HEDL, VALID_HEDL, "\u{0}"];
+    let out = parse_batch(&inputs, 2);
+
+    assert_eq!(out.result, HEDL_ERR_PARSE);
+    assert_eq!(out.codes, vec![HEDL_OK, HEDL_ERR_PARSE, HEDL_OK, HEDL_ERR_PARSE]);
+    assert!(!out.docs[0].is_null() && !out.docs[2].is_null());
+    assert!(out.docs[1].is_null() && out.docs[3].is_null());
+
+    assert!(out.errors[0].is_null());
+    let msg = unsafe { CStr::from_ptr(out.errors[1]) }.to_str().unwrap();
+    assert!(msg.starts_with("Parse error"), "{}", msg);
+
+    let summary = unsafe { CStr::from_ptr(hedl_get_last_error()) }.to_str().unwrap();
+    assert_eq!(summary, "2 of 4 inputs failed to parse");
+}
+
+#[test]
+fn test_batch_invalid_utf8_slot() {
+    let bad = [0xffu8, 0xfe];
+    let ptrs = [VALID_HEDL.as_ptr() as *const c_char, bad.as_ptr() as *const c_char];
+    let lens = [VALID_HEDL.len(), bad.len()];
+    let mut docs = [ptr::null_mut(); 2];
+    let mut codes = [0; 2];
+
+    unsafe {
+        let result = hedl_parse_batch(
+            ptrs.as_ptr(),
+            lens.as_ptr(),
+            2,
+            0,
+            docs.as_mut_ptr(),
+            codes.as_mut_ptr(),
+            ptr::null_mut(),
+            1,
+        );
+        assert_eq!(result, HEDL_ERR_INVALID_UTF8);
+        assert_eq!(codes, [HEDL_OK, HEDL_ERR_INVALID_UTF8]);
+        assert!(docs[1].is_null());
+        hedl_free_document(docs[0]);
+    }
+}
+
+#[test]
+fn test_batch_null_terminated_inputs() {
+    let a = b"%VERSION: 1.0\n---\na: 1\0";
+    let b = b"%VERSION: 1.0\n---\nb: 2\nc: 3\0";
+    let ptrs = [a.as_ptr() as *const c_char, ptr::null(), b.as_ptr() as *const c_char];
+    let mut docs = [ptr::null_mut(); 3];
+    let mut codes = [0; 3];
+
+    unsafe {
+        let result = hedl_parse_batch(
+            ptrs.as_ptr(),
+            ptr::null(),
+            3,
+            0,
+            docs.as_mut_ptr(),
+            codes.as_mut_ptr(),
+            ptr::null_mut(),
+            0,
+        );
+        assert_eq!(result, HEDL_ERR_NULL_PTR);
+        assert_eq!(codes, [HEDL_OK, HEDL_ERR_NULL_PTR, HEDL_OK]);
+        assert_eq!(hedl_root_item_count(docs[0]), 1);
+        assert_eq!(hedl_root_item_count(docs[2]), 2);
+        hedl_free_document(docs[0]);
+        hedl_free_document(docs[2]);
+    }
+}
+
+#[test]
+fn test_batch_empty_and_null_arrays() {
+    unsafe {
+        let result = hedl_parse_batch(
+            ptr::null(),
+            ptr::null(),
+            0,
+            0,
+            ptr::null_mut(),
+            ptr::null_mut(),
+            ptr::null_mut(),
+            0,
+        );
+        assert_eq!(result, HEDL_OK);
+
+        let input = VALID_HEDL.as_ptr() as *const c_char;
+        let mut codes = [0; 1];
+        let result = hedl_parse_batch(
+            &input,
+            ptr::null(),
+            1,
+            0,
+            ptr::null_mut(),
+            codes.as_mut_ptr(),
+            ptr::null_mut(),
+            0,
+        );
+        assert_eq!(result, HEDL_ERR_NULL_PTR);
+        assert!(!hedl_get_last_error().is_null());
+    }
+}
+
+#[test]
+fn test_batch_strict_mode() {
+    let doc = "%VERSION: 1.0\n---\nref: @Missing:x\n";
+    let ptrs = [doc.as_ptr() as *const c_char];
+    let lens = [doc.len()];
+
+    for (strict, expected) in [(0, HEDL_OK), (1, HEDL_ERR_PARSE)] {
+        let mut docs = [ptr::null_mut(); 1];
+        let mut codes = [0; 1];
+        unsafe {
+            hedl_parse_batch(
+                ptrs.as_ptr(),
+                lens.as_ptr(),
+                1,
+                strict,
+                docs.as_mut_ptr(),
+                codes.as_mut_ptr(),
+                ptr::null_mut(),
+                0,
+            );
+            assert_eq!(codes[0], expected, "strict = {}", strict);
+            hedl_free_document(docs[0]);
+        }
+    }
+}
+
+#[test]
+fn test_batch_matches_single_parse() {
+    let inputs = [VALID_HEDL, INVALID_HEDL];
+    let out = parse_batch(&inputs, 0);
+
+    for (i, input) in inputs.iter().enumerate() {
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        unsafe {
+            let code = hedl_parse_sized(input.as_ptr() as *const c_char, input.len(), 0, 0, &mut doc);
+            assert_eq!(code, out.codes[i]);
+            hedl_free_document(doc);
+        }
+    }
+}
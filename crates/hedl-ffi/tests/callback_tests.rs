@@ -281,6 +281,51 @@ fn test_neo4j_callback() {
     }
 }
 
+#[cfg(feature = "neo4j")]
+#[test]
+fn test_neo4j_batches_callback_matches_allocating() {
+    unsafe {
+        let mut hedl = String::from("%VERSION: 1.0\n%STRUCT: User: [id, name]\n---\nusers: @User\n");
+        for i in 0..5 {
+            hedl.push_str(&format!("  | u{}, User {}\n", i, i));
+        }
+        hedl.push('\0');
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        assert_eq!(hedl_parse(hedl.as_ptr() as *const c_char, -1, 0, &mut doc), HEDL_OK);
+
+        let mut out_str: *mut c_char = ptr::null_mut();
+        assert_eq!(hedl_to_neo4j_batches(doc, 1, 2, &mut out_str), HEDL_OK);
+        let lines = CStr::from_ptr(out_str).to_str().unwrap().to_owned();
+        hedl_free_string(out_str);
+
+        let mut ctx = CallbackContext::new();
+        let result = hedl_to_neo4j_batches_callback(
+            doc,
+            1, // use_merge
+            2, // batch_size
+            16,
+            test_callback,
+            &mut ctx as *mut _ as *mut c_void,
+        );
+        assert_eq!(result, HEDL_OK);
+        assert!(ctx.call_count > 1);
+        assert_eq!(ctx.as_string(), lines);
+
+        // 5 users in batches of 2, rows passed as parameters
+        let batches: Vec<&str> = lines
+            .lines()
+            .filter(|l| l.starts_with("{\"statement\":\"UNWIND $rows AS row"))
+            .collect();
+        assert_eq!(batches.len(), 3);
+        assert!(batches.iter().all(|l| l.contains("\"parameters\":{\"rows\":[")));
+        let (statement, params) = batches[0].split_at(batches[0].find("\"parameters\"").unwrap());
+        assert!(!statement.contains("User 0"));
+        assert!(params.contains("\"User 0\""));
+
+        hedl_free_document(doc);
+    }
+}
+
 // =============================================================================
 // Error Handling Tests
 // =============================================================================
@@ -426,10 +471,11 @@ fn test_large_json_callback() {
         );
 
         assert_eq!(result, HEDL_OK);
-        assert_eq!(ctx.call_count, 1);
 
         // Verify the output is large (>1MB would be ideal but depends on JSON size)
         assert!(ctx.data.len() > 10000, "Expected large output, got {} bytes", ctx.data.len());
+        let expected_calls = (ctx.data.len() + HEDL_DEFAULT_CHUNK_SIZE - 1) / HEDL_DEFAULT_CHUNK_SIZE;
+        assert_eq!(ctx.call_count, expected_calls, "Output should arrive in default-size chunks");
 
         hedl_free_document(doc);
     }
@@ -447,10 +493,166 @@ fn test_large_canonicalize_callback() {
             &mut ctx as *mut _ as *mut c_void,
         );
 
+        assert_eq!(result, HEDL_OK);
+        assert!(ctx.data.len() > HEDL_DEFAULT_CHUNK_SIZE);
+        let expected_calls = (ctx.data.len() + HEDL_DEFAULT_CHUNK_SIZE - 1) / HEDL_DEFAULT_CHUNK_SIZE;
+        assert_eq!(ctx.call_count, expected_calls, "Output should arrive in default-size chunks");
+
+        hedl_free_document(doc);
+    }
+}
+
+// =============================================================================
+// Chunked Streaming Tests
+// =============================================================================
+
+/// Context that records every chunk separately
+struct ChunkContext {
+    chunks: Vec<Vec<u8>>,
+}
+
+unsafe extern "C" fn chunk_callback(data: *const c_char, len: usize, user_data: *mut c_void) {
+    let ctx = &mut *(user_data as *mut ChunkContext);
+    ctx.chunks.push(slice::from_raw_parts(data as *const u8, len).to_vec());
+}
+
+/// Assert every chunk but the last is exactly `chunk_size`, and return the joined output
+fn assert_bounded_chunks(ctx: &ChunkContext, chunk_size: usize) -> String {
+    assert!(ctx.chunks.len() > 1, "Expected several chunks, got {}", ctx.chunks.len());
+    let (last, full) = ctx.chunks.split_last().unwrap();
+    assert!(full.iter().all(|c| c.len() == chunk_size));
+    assert!(!last.is_empty() && last.len() <= chunk_size);
+    String::from_utf8(ctx.chunks.concat()).unwrap()
+}
+
+#[test]
+fn test_canonicalize_callback_chunked_matches_regular() {
+    unsafe {
+        let doc = create_large_document();
+        let mut ctx = ChunkContext { chunks: Vec::new() };
+
+        let result = hedl_canonicalize_callback_chunked(
+            doc,
+            4096,
+            chunk_callback,
+            &mut ctx as *mut _ as *mut c_void,
+        );
+        assert_eq!(result, HEDL_OK);
+        let streamed = assert_bounded_chunks(&ctx, 4096);
+
+        let mut regular: *mut c_char = ptr::null_mut();
+        assert_eq!(hedl_canonicalize(doc, &mut regular), HEDL_OK);
+        assert_eq!(streamed, CStr::from_ptr(regular).to_str().unwrap());
+
+        hedl_free_string(regular);
+        hedl_free_document(doc);
+    }
+}
+
+#[test]
+fn test_callback_chunked_zero_uses_default() {
+    unsafe {
+        let doc = create_test_document();
+        let mut ctx = CallbackContext::new();
+
+        let result = hedl_canonicalize_callback_chunked(
+            doc,
+            0,
+            test_callback,
+            &mut ctx as *mut _ as *mut c_void,
+        );
+
         assert_eq!(result, HEDL_OK);
         assert_eq!(ctx.call_count, 1);
-        assert!(ctx.data.len() > 10000);
+        assert!(ctx.as_string().contains("Alice"));
+
+        hedl_free_document(doc);
+    }
+}
+
+#[cfg(feature = "json")]
+#[test]
+fn test_json_callback_chunked_matches_regular() {
+    unsafe {
+        let doc = create_large_document();
+        let mut ctx = ChunkContext { chunks: Vec::new() };
+
+        let result = hedl_to_json_callback_chunked(
+            doc,
+            0,
+            1000,
+            chunk_callback,
+            &mut ctx as *mut _ as *mut c_void,
+        );
+        assert_eq!(result, HEDL_OK);
+        let streamed = assert_bounded_chunks(&ctx, 1000);
+
+        let mut regular: *mut c_char = ptr::null_mut();
+        assert_eq!(hedl_to_json(doc, 0, &mut regular), HEDL_OK);
+        assert_eq!(streamed, CStr::from_ptr(regular).to_str().unwrap());
+
+        hedl_free_string(regular);
+        hedl_free_document(doc);
+    }
+}
+
+#[cfg(feature = "csv")]
+#[test]
+fn test_csv_callback_chunked_matches_regular() {
+    unsafe {
+        let mut hedl = String::from("%VERSION: 1.0\n%STRUCT: Row: [id,name]\n---\nrows: @Row\n");
+        for i in 0..2000 {
+            hedl.push_str(&format!("  | r{}, name {}\n", i, i));
+        }
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        assert_eq!(hedl_parse(hedl.as_ptr() as *const c_char, hedl.len() as i32, 0, &mut doc), HEDL_OK);
+
+        let mut ctx = ChunkContext { chunks: Vec::new() };
+        let result = hedl_to_csv_callback_chunked(
+            doc,
+            512,
+            chunk_callback,
+            &mut ctx as *mut _ as *mut c_void,
+        );
+        assert_eq!(result, HEDL_OK);
+        let streamed = assert_bounded_chunks(&ctx, 512);
+
+        let mut regular: *mut c_char = ptr::null_mut();
+        assert_eq!(hedl_to_csv(doc, &mut regular), HEDL_OK);
+        assert_eq!(streamed, CStr::from_ptr(regular).to_str().unwrap());
+
+        hedl_free_string(regular);
+        hedl_free_document(doc);
+    }
+}
+
+#[cfg(feature = "neo4j")]
+#[test]
+fn test_neo4j_callback_chunked_matches_regular() {
+    unsafe {
+        let mut hedl = String::from("%VERSION: 1.0\n%STRUCT: User: [id,name]\n---\nusers: @User\n");
+        for i in 0..500 {
+            hedl.push_str(&format!("  | u{}, User {}\n", i, i));
+        }
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        assert_eq!(hedl_parse(hedl.as_ptr() as *const c_char, hedl.len() as i32, 0, &mut doc), HEDL_OK);
+
+        let mut ctx = ChunkContext { chunks: Vec::new() };
+        let result = hedl_to_neo4j_cypher_callback_chunked(
+            doc,
+            1,
+            777,
+            chunk_callback,
+            &mut ctx as *mut _ as *mut c_void,
+        );
+        assert_eq!(result, HEDL_OK);
+        let streamed = assert_bounded_chunks(&ctx, 777);
+
+        let mut regular: *mut c_char = ptr::null_mut();
+        assert_eq!(hedl_to_neo4j_cypher(doc, 1, &mut regular), HEDL_OK);
+        assert_eq!(streamed, CStr::from_ptr(regular).to_str().unwrap());
 
+        hedl_free_string(regular);
         hedl_free_document(doc);
     }
 }
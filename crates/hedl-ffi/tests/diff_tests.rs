@@ -0,0 +1,171 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//! Tests for `hedl_diff` and `hedl_apply_patch`
+
+use hedl_ffi::*;
+use std::ffi::CStr;
+use std::os::raw::c_char;
+use std::ptr;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+const OLD: &str = concat!(
+    "%VERSION: 1.0\n",
+    "%STRUCT: User: [id, name]\n",
+    "---\n",
+    "title: Users\n",
+    "users: @User\n",
+    "  | u1, Alice\n",
+    "  | u2, Bob\n",
+    "  | u3, Carol\n",
+);
+
+const NEW: &str = concat!(
+    "%VERSION: 1.0\n",
+    "%STRUCT: User: [id, name]\n",
+    "---\n",
+    "title: Members\n",
+    "users: @User\n",
+    "  | u1, Alice\n",
+    "  | u4, Dave\n",
+    "  | u3, Caroline\n",
+);
+
+fn parse(input: &str) -> *mut HedlDocument {
+    unsafe {
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        assert_eq!(
+            hedl_parse_sized(input.as_ptr() as *const c_char, input.len(), 1, 0, &mut doc),
+            HEDL_OK
+        );
+        doc
+    }
+}
+
+unsafe fn canonical(doc: *const HedlDocument) -> String {
+    let mut out: *mut c_char = ptr::null_mut();
+    assert_eq!(hedl_canonicalize(doc, &mut out), HEDL_OK);
+    let text = CStr::from_ptr(out).to_str().unwrap().to_string();
+    hedl_free_string(out);
+    text
+}
+
+unsafe fn diff(old: *const HedlDocument, new: *const HedlDocument) -> Vec<u8> {
+    let mut data: *mut u8 = ptr::null_mut();
+    let mut len = 0;
+    assert_eq!(hedl_diff(old, new, &mut data, &mut len), HEDL_OK);
+    let bytes = std::slice::from_raw_parts(data, len).to_vec();
+    hedl_free_bytes(data, len);
+    bytes
+}
+
+unsafe fn has_user(doc: *const HedlDocument, id: &str) -> bool {
+    let mut node: *const HedlNode = ptr::null();
+    let rc = hedl_find_node(
+        doc,
+        b"User".as_ptr() as *const c_char,
+        4,
+        id.as_ptr() as *const c_char,
+        id.len(),
+        &mut node,
+    );
+    rc == HEDL_OK
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+#[test]
+fn test_patch_reproduces_new_document() {
+    unsafe {
+        let old = parse(OLD);
+        let new = parse(NEW);
+        let replica = parse(OLD);
+
+        // Build the ID index before patching; it must not go stale
+        assert!(has_user(replica, "u2"));
+
+        let delta = diff(old, new);
+        assert_eq!(delta, diff(old, new));
+        assert_eq!(
+            hedl_apply_patch(replica, delta.as_ptr(), delta.len()),
+            HEDL_OK
+        );
+        assert_eq!(canonical(replica), canonical(new));
+        assert!(!has_user(replica, "u2"));
+        assert!(has_user(replica, "u4"));
+
+        hedl_free_document(old);
+        hedl_free_document(new);
+        hedl_free_document(replica);
+    }
+}
+
+#[test]
+fn test_mismatched_patch_leaves_document_unchanged() {
+    unsafe {
+        let old = parse(OLD);
+        let new = parse(NEW);
+        let delta = diff(old, new);
+        let (old_text, new_text) = (canonical(old), canonical(new));
+
+        // The removed row is already gone from the patched document
+        assert_eq!(
+            hedl_apply_patch(new, delta.as_ptr(), delta.len()),
+            HEDL_ERR_PATCH
+        );
+        let msg = CStr::from_ptr(hedl_get_last_error()).to_str().unwrap();
+        assert!(msg.contains("does not apply"), "{}", msg);
+        assert_eq!(canonical(new), new_text);
+
+        let garbage = b"not a delta";
+        assert_eq!(
+            hedl_apply_patch(old, garbage.as_ptr(), garbage.len()),
+            HEDL_ERR_PATCH
+        );
+        assert_eq!(canonical(old), old_text);
+
+        hedl_free_document(old);
+        hedl_free_document(new);
+    }
+}
+
+#[test]
+fn test_null_arguments() {
+    unsafe {
+        let doc = parse(OLD);
+        let mut data: *mut u8 = ptr::null_mut();
+        let mut len = 0;
+        assert_eq!(
+            hedl_diff(doc, ptr::null(), &mut data, &mut len),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(
+            hedl_diff(doc, doc, ptr::null_mut(), &mut len),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(hedl_apply_patch(doc, ptr::null(), 0), HEDL_ERR_NULL_PTR);
+        assert_eq!(
+            hedl_apply_patch(ptr::null_mut(), data, 0),
+            HEDL_ERR_NULL_PTR
+        );
+        hedl_free_document(doc);
+    }
+}
@@ -0,0 +1,253 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Tests for canonical digests (hedl_canonical_hash, hedl_digests_*)
+
+use hedl_ffi::*;
+use std::ffi::CStr;
+use std::os::raw::c_char;
+use std::ptr;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+const DOC_A: &str = "%VERSION: 1.0\n%STRUCT: User: [id,name]\n---\nname: Alice\nusers: @User\n  | u1, Alice\n  | u2, Bob\nversion: 3\n";
+const DOC_B: &str = "%VERSION: 1.0\n%STRUCT: User: [id,name]\n---\nname: Alice\nusers: @User\n  | u1, Alice\n  | u2, Bob\nversion: 4\n";
+
+fn parse(input: &str) -> *mut HedlDocument {
+    let mut doc: *mut HedlDocument = ptr::null_mut();
+    let rc = unsafe { hedl_parse_sized(input.as_ptr() as *const c_char, input.len(), 0, 0, &mut doc) };
+    assert_eq!(rc, HEDL_OK);
+    doc
+}
+
+fn hash(doc: *const HedlDocument, algo: i32) -> Vec<u8> {
+    let mut digest = [0u8; HEDL_HASH_MAX_SIZE];
+    assert_eq!(
+        unsafe { hedl_canonical_hash(doc, algo, digest.as_mut_ptr()) },
+        HEDL_OK
+    );
+    let len = if algo == HEDL_HASH_BLAKE3 { 32 } else { 16 };
+    digest[..len].to_vec()
+}
+
+fn entry_digests(doc: *const HedlDocument, algo: i32) -> Vec<(String, [u8; HEDL_HASH_MAX_SIZE])> {
+    unsafe {
+        let mut digests: *mut HedlDigests = ptr::null_mut();
+        assert_eq!(hedl_digests_new(doc, algo, &mut digests), HEDL_OK);
+
+        let entries = (0..hedl_digests_count(digests))
+            .map(|i| {
+                let mut key: *const c_char = ptr::null();
+                let mut key_len = 0usize;
+                let mut digest = [0u8; HEDL_HASH_MAX_SIZE];
+                let rc =
+                    hedl_digests_entry(digests, i, &mut key, &mut key_len, digest.as_mut_ptr());
+                assert_eq!(rc, HEDL_OK);
+                let key = std::slice::from_raw_parts(key as *const u8, key_len);
+                (String::from_utf8(key.to_vec()).unwrap(), digest)
+            })
+            .collect();
+
+        hedl_digests_free(digests);
+        entries
+    }
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+#[test]
+fn test_hash_is_stable_and_sensitive() {
+    let a = parse(DOC_A);
+    let a_again = parse(DOC_A);
+    let b = parse(DOC_B);
+
+    for algo in [HEDL_HASH_BLAKE3, HEDL_HASH_XXH3_128] {
+        assert_eq!(hash(a, algo), hash(a_again, algo));
+        assert_ne!(hash(a, algo), hash(b, algo));
+    }
+    assert_ne!(
+        hash(a, HEDL_HASH_BLAKE3)[..16],
+        hash(a, HEDL_HASH_XXH3_128)[..]
+    );
+
+    unsafe {
+        hedl_free_document(a);
+        hedl_free_document(a_again);
+        hedl_free_document(b);
+    }
+}
+
+#[test]
+fn test_hash_matches_reparsed_canonical_form() {
+    let doc = parse(DOC_A);
+    unsafe {
+        let mut canonical: *mut c_char = ptr::null_mut();
+        assert_eq!(hedl_canonicalize(doc, &mut canonical), HEDL_OK);
+        let text = CStr::from_ptr(canonical).to_str().unwrap().to_string();
+        hedl_free_string(canonical);
+
+        // Canonicalization is idempotent, so the round trip keeps the digest
+        let reparsed = parse(&text);
+        assert_eq!(
+            hash(doc, HEDL_HASH_BLAKE3),
+            hash(reparsed, HEDL_HASH_BLAKE3)
+        );
+        hedl_free_document(reparsed);
+        hedl_free_document(doc);
+    }
+}
+
+#[test]
+fn test_entry_digests_locate_changes() {
+    let a = parse(DOC_A);
+    let b = parse(DOC_B);
+
+    let da = entry_digests(a, HEDL_HASH_XXH3_128);
+    let db = entry_digests(b, HEDL_HASH_XXH3_128);
+    let keys: Vec<&str> = da.iter().map(|(k, _)| k.as_str()).collect();
+    assert_eq!(keys, ["name", "users", "version"]);
+
+    let changed: Vec<&str> = da
+        .iter()
+        .zip(&db)
+        .filter(|(x, y)| x != y)
+        .map(|(x, _)| x.0.as_str())
+        .collect();
+    assert_eq!(changed, ["version"]);
+
+    unsafe {
+        let a_hash = hash(a, HEDL_HASH_BLAKE3);
+        let mut digests: *mut HedlDigests = ptr::null_mut();
+        assert_eq!(hedl_digests_new(a, HEDL_HASH_BLAKE3, &mut digests), HEDL_OK);
+        hedl_free_document(a);
+
+        // The handle outlives its document
+        let mut digest = [0u8; HEDL_HASH_MAX_SIZE];
+        assert_eq!(hedl_digests_document(digests, digest.as_mut_ptr()), HEDL_OK);
+        assert_eq!(digest[..], a_hash[..]);
+
+        let key = "users";
+        assert_eq!(
+            hedl_digests_get(
+                digests,
+                key.as_ptr() as *const c_char,
+                key.len(),
+                digest.as_mut_ptr()
+            ),
+            HEDL_OK
+        );
+        let missing = "missing";
+        assert_eq!(
+            hedl_digests_get(
+                digests,
+                missing.as_ptr() as *const c_char,
+                missing.len(),
+                digest.as_mut_ptr()
+            ),
+            HEDL_ERR_NOT_FOUND
+        );
+        let mut key_ptr: *const c_char = ptr::null();
+        assert_eq!(
+            hedl_digests_entry(
+                digests,
+                3,
+                &mut key_ptr,
+                ptr::null_mut(),
+                digest.as_mut_ptr()
+            ),
+            HEDL_ERR_NOT_FOUND
+        );
+
+        hedl_digests_free(digests);
+        hedl_free_document(b);
+    }
+}
+
+#[test]
+fn test_cached_digests_follow_changes() {
+    let b = parse(DOC_B);
+    let expected = hash(b, HEDL_HASH_BLAKE3);
+    let expected_entries = entry_digests(b, HEDL_HASH_XXH3_128);
+
+    unsafe {
+        // Incremental edit
+        let mut inc: *mut HedlIncremental = ptr::null_mut();
+        assert_eq!(
+            hedl_incremental_open(DOC_A.as_ptr() as *const c_char, DOC_A.len(), 1, &mut inc),
+            HEDL_OK
+        );
+        let doc = hedl_incremental_document(inc);
+        let before = hash(doc, HEDL_HASH_BLAKE3);
+        entry_digests(doc, HEDL_HASH_XXH3_128);
+        let edit = "version: 4";
+        assert_eq!(
+            hedl_incremental_apply_edit(inc, 7, 8, edit.as_ptr() as *const c_char, edit.len()),
+            HEDL_OK
+        );
+        let doc = hedl_incremental_document(inc);
+        assert_ne!(hash(doc, HEDL_HASH_BLAKE3), before);
+        assert_eq!(hash(doc, HEDL_HASH_BLAKE3), expected);
+        assert_eq!(entry_digests(doc, HEDL_HASH_XXH3_128), expected_entries);
+        hedl_incremental_close(inc);
+
+        // Patch
+        let a = parse(DOC_A);
+        assert_eq!(hash(a, HEDL_HASH_BLAKE3), before);
+        entry_digests(a, HEDL_HASH_XXH3_128);
+        let mut delta: *mut u8 = ptr::null_mut();
+        let mut len = 0usize;
+        assert_eq!(hedl_diff(a, b, &mut delta, &mut len), HEDL_OK);
+        assert_eq!(hedl_apply_patch(a, delta, len), HEDL_OK);
+        hedl_free_bytes(delta, len);
+        assert_eq!(hash(a, HEDL_HASH_BLAKE3), expected);
+        assert_eq!(entry_digests(a, HEDL_HASH_XXH3_128), expected_entries);
+
+        hedl_free_document(a);
+        hedl_free_document(b);
+    }
+}
+
+#[test]
+fn test_hash_rejects_bad_arguments() {
+    let doc = parse(DOC_A);
+    let mut digest = [0u8; HEDL_HASH_MAX_SIZE];
+    unsafe {
+        assert_eq!(
+            hedl_canonical_hash(ptr::null(), HEDL_HASH_BLAKE3, digest.as_mut_ptr()),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(
+            hedl_canonical_hash(doc, HEDL_HASH_BLAKE3, ptr::null_mut()),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(
+            hedl_canonical_hash(doc, 99, digest.as_mut_ptr()),
+            HEDL_ERR_NOT_FOUND
+        );
+        assert!(!hedl_get_last_error().is_null());
+
+        let mut digests: *mut HedlDigests = ptr::null_mut();
+        assert_eq!(hedl_digests_new(doc, 99, &mut digests), HEDL_ERR_NOT_FOUND);
+        assert_eq!(hedl_digests_count(ptr::null()), 0);
+        hedl_digests_free(ptr::null_mut());
+        hedl_free_document(doc);
+    }
+}
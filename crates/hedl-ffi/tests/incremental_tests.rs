@@ -0,0 +1,201 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//! Tests for the `HedlIncremental` re-parsing handle.
+
+use hedl_ffi::*;
+use std::ffi::CStr;
+use std::os::raw::c_char;
+use std::ptr;
+
+const DOC: &str = concat!(
+    "%VERSION: 1.0\n",
+    "%STRUCT: User: [id, name, manager]\n",
+    "---\n",
+    "title: Team\n",
+    "users: @User\n",
+    "  | alice, Alice, ~\n",
+    "  | bob, Bob, @User:alice\n",
+    "lead: @User:alice\n",
+);
+
+unsafe fn open(input: &str) -> *mut HedlIncremental {
+    let mut inc: *mut HedlIncremental = ptr::null_mut();
+    let rc = hedl_incremental_open(input.as_ptr() as *const c_char, input.len(), 1, &mut inc);
+    assert_eq!(rc, HEDL_OK);
+    assert!(!inc.is_null());
+    inc
+}
+
+unsafe fn edit(inc: *mut HedlIncremental, start: usize, end: usize, text: &str) -> i32 {
+    hedl_incremental_apply_edit(inc, start, end, text.as_ptr() as *const c_char, text.len())
+}
+
+unsafe fn canonical(doc: *const HedlDocument) -> String {
+    let mut out: *mut c_char = ptr::null_mut();
+    assert_eq!(hedl_canonicalize(doc, &mut out), HEDL_OK);
+    let s = CStr::from_ptr(out).to_str().unwrap().to_owned();
+    hedl_free_string(out);
+    s
+}
+
+/// Canonical form of a full strict parse of `input`.
+unsafe fn reparsed(input: &str) -> String {
+    let mut doc: *mut HedlDocument = ptr::null_mut();
+    let rc = hedl_parse_sized(input.as_ptr() as *const c_char, input.len(), 1, 0, &mut doc);
+    assert_eq!(rc, HEDL_OK);
+    let s = canonical(doc);
+    hedl_free_document(doc);
+    s
+}
+
+fn last_error() -> String {
+    unsafe {
+        CStr::from_ptr(hedl_get_last_error())
+            .to_string_lossy()
+            .into_owned()
+    }
+}
+
+#[test]
+fn test_edits_match_full_parse() {
+    unsafe {
+        let inc = open(DOC);
+        let doc = hedl_incremental_document(inc);
+        // The trailing newline ends an empty last line
+        assert_eq!(hedl_incremental_line_count(inc), 9);
+        assert_eq!(canonical(doc), reparsed(DOC));
+
+        // Replace a row, insert one and append a top-level key
+        assert_eq!(edit(inc, 6, 7, "  | bob, Robert, @User:alice\n"), HEDL_OK);
+        assert_eq!(edit(inc, 7, 7, "  | carol, Carol, @User:bob\n"), HEDL_OK);
+        assert_eq!(edit(inc, 9, 9, "size: 3"), HEDL_OK);
+        assert_eq!(hedl_incremental_line_count(inc), 11);
+
+        let expected = concat!(
+            "%VERSION: 1.0\n",
+            "%STRUCT: User: [id, name, manager]\n",
+            "---\n",
+            "title: Team\n",
+            "users: @User\n",
+            "  | alice, Alice, ~\n",
+            "  | bob, Robert, @User:alice\n",
+            "  | carol, Carol, @User:bob\n",
+            "lead: @User:alice\n",
+            "size: 3\n",
+        );
+        // The document pointer is stable across edits
+        assert_eq!(hedl_incremental_document(inc), doc);
+        assert_eq!(canonical(doc), reparsed(expected));
+
+        // Deleting with NULL text
+        assert_eq!(
+            hedl_incremental_apply_edit(inc, 9, 10, ptr::null(), 0),
+            HEDL_OK
+        );
+        assert_eq!(hedl_incremental_line_count(inc), 10);
+
+        hedl_incremental_close(inc);
+    }
+}
+
+#[test]
+fn test_header_edit() {
+    unsafe {
+        let inc = open(DOC);
+        assert_eq!(
+            edit(inc, 1, 2, "%STRUCT: User: [id, name, boss]\n"),
+            HEDL_OK
+        );
+        let expected = DOC.replace("manager", "boss");
+        assert_eq!(
+            canonical(hedl_incremental_document(inc)),
+            reparsed(&expected)
+        );
+        hedl_incremental_close(inc);
+    }
+}
+
+#[test]
+fn test_rejected_edits_leave_document_unchanged() {
+    unsafe {
+        let inc = open(DOC);
+        let doc = hedl_incremental_document(inc);
+        let before = canonical(doc);
+
+        // Dangling reference in strict mode
+        assert_eq!(edit(inc, 7, 8, "lead: @User:nobody\n"), HEDL_ERR_PARSE);
+        assert!(last_error().starts_with("Parse error:"));
+        assert_eq!(canonical(doc), before);
+
+        // Removing a referenced node
+        assert_eq!(edit(inc, 5, 6, ""), HEDL_ERR_PARSE);
+        assert_eq!(canonical(doc), before);
+
+        // Duplicate ID
+        assert_eq!(edit(inc, 7, 7, "  | bob, Bobby, ~\n"), HEDL_ERR_PARSE);
+        assert_eq!(canonical(doc), before);
+
+        // Out-of-range edit
+        assert_eq!(edit(inc, 7, 20, "x: 1\n"), HEDL_ERR_PARSE);
+        assert!(last_error().contains("outside"));
+        assert_eq!(canonical(doc), before);
+        assert_eq!(hedl_incremental_line_count(inc), 9);
+
+        // Still usable after errors
+        assert_eq!(edit(inc, 3, 4, "title: Crew\n"), HEDL_OK);
+        assert_eq!(canonical(doc), reparsed(&DOC.replace("Team", "Crew")));
+
+        hedl_incremental_close(inc);
+    }
+}
+
+#[test]
+fn test_open_failure_and_null_arguments() {
+    unsafe {
+        let mut inc: *mut HedlIncremental = ptr::null_mut();
+        let bad = "%VERSION: 1.0\n---\nlead: @User:nobody\n";
+        assert_eq!(
+            hedl_incremental_open(bad.as_ptr() as *const c_char, bad.len(), 1, &mut inc),
+            HEDL_ERR_PARSE
+        );
+        assert!(inc.is_null());
+        assert_eq!(
+            hedl_incremental_open(ptr::null(), 0, 0, &mut inc),
+            HEDL_ERR_NULL_PTR
+        );
+
+        let inc = open(DOC);
+        assert_eq!(
+            hedl_incremental_apply_edit(inc, 0, 0, ptr::null(), 1),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(
+            hedl_incremental_apply_edit(ptr::null_mut(), 0, 0, ptr::null(), 0),
+            HEDL_ERR_NULL_PTR
+        );
+        let invalid = [0xffu8];
+        assert_eq!(
+            hedl_incremental_apply_edit(inc, 3, 4, invalid.as_ptr() as *const c_char, 1),
+            HEDL_ERR_INVALID_UTF8
+        );
+        hedl_incremental_close(inc);
+
+        assert!(hedl_incremental_document(ptr::null()).is_null());
+        assert_eq!(hedl_incremental_line_count(ptr::null()), 0);
+        hedl_incremental_close(ptr::null_mut());
+    }
+}
@@ -0,0 +1,283 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Tests for caller-buffer (`*_into`) export API
+
+use hedl_ffi::*;
+use std::ffi::CStr;
+use std::os::raw::{c_char, c_int};
+use std::ptr;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+unsafe fn create_test_document() -> *mut HedlDocument {
+    let hedl = b"%VERSION: 1.0\n%STRUCT: User: [id, name]\n---\nusers: @User\n  | alice, \"Alice \\\"A\\\" Smith\"\n  | bob, Bob\nowner:\n  name: Alice\n  age: 30\n\0";
+    let mut doc: *mut HedlDocument = ptr::null_mut();
+    let result = hedl_parse(hedl.as_ptr() as *const c_char, -1, 0, &mut doc);
+    assert_eq!(result, HEDL_OK);
+    doc
+}
+
+unsafe fn canonical_string(doc: *const HedlDocument) -> String {
+    let mut out: *mut c_char = ptr::null_mut();
+    assert_eq!(hedl_canonicalize(doc, &mut out), HEDL_OK);
+    let s = CStr::from_ptr(out).to_str().unwrap().to_owned();
+    hedl_free_string(out);
+    s
+}
+
+// =============================================================================
+// Buffer Contract
+// =============================================================================
+
+#[test]
+fn test_canonicalize_into_matches_allocating_variant() {
+    unsafe {
+        let doc = create_test_document();
+        let expected = canonical_string(doc);
+
+        let mut buf = vec![0x55 as c_char; expected.len() + 16];
+        let mut needed = 0usize;
+        let result = hedl_canonicalize_into(doc, buf.as_mut_ptr(), buf.len(), &mut needed);
+        assert_eq!(result, HEDL_OK);
+        assert_eq!(needed, expected.len() + 1);
+        assert_eq!(CStr::from_ptr(buf.as_ptr()).to_str().unwrap(), expected);
+
+        hedl_free_document(doc);
+    }
+}
+
+#[test]
+fn test_into_size_query_with_null_buffer() {
+    unsafe {
+        let doc = create_test_document();
+        let expected = canonical_string(doc);
+
+        let mut needed = 0usize;
+        let result = hedl_canonicalize_into(doc, ptr::null_mut(), 0, &mut needed);
+        assert_eq!(result, HEDL_ERR_BUFFER_TOO_SMALL);
+        assert_eq!(needed, expected.len() + 1);
+
+        // Exactly `needed` bytes is enough
+        let mut buf = vec![0 as c_char; needed];
+        let result = hedl_canonicalize_into(doc, buf.as_mut_ptr(), buf.len(), &mut needed);
+        assert_eq!(result, HEDL_OK);
+        assert_eq!(CStr::from_ptr(buf.as_ptr()).to_str().unwrap(), expected);
+
+        hedl_free_document(doc);
+    }
+}
+
+#[test]
+fn test_into_too_small_leaves_empty_string() {
+    unsafe {
+        let doc = create_test_document();
+
+        let mut buf = [0x55 as c_char; 8];
+        let mut needed = 0usize;
+        let result = hedl_canonicalize_into(doc, buf.as_mut_ptr(), buf.len(), &mut needed);
+        assert_eq!(result, HEDL_ERR_BUFFER_TOO_SMALL);
+        assert!(needed > buf.len());
+        assert_eq!(buf[0], 0);
+        assert!(!hedl_get_last_error().is_null());
+
+        hedl_free_document(doc);
+    }
+}
+
+#[test]
+fn test_into_null_arguments() {
+    unsafe {
+        let doc = create_test_document();
+        let mut buf = [0 as c_char; 16];
+        let mut needed = 0usize;
+
+        assert_eq!(
+            hedl_canonicalize_into(ptr::null(), buf.as_mut_ptr(), buf.len(), &mut needed),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(
+            hedl_canonicalize_into(doc, ptr::null_mut(), 16, &mut needed),
+            HEDL_ERR_NULL_PTR
+        );
+        // out_needed is optional
+        let mut big = vec![0 as c_char; 4096];
+        assert_eq!(
+            hedl_canonicalize_into(doc, big.as_mut_ptr(), big.len(), ptr::null_mut()),
+            HEDL_OK
+        );
+
+        hedl_free_document(doc);
+    }
+}
+
+#[cfg(feature = "json")]
+#[test]
+fn test_to_json_into_matches_allocating_variant() {
+    unsafe {
+        let doc = create_test_document();
+
+        let mut out: *mut c_char = ptr::null_mut();
+        assert_eq!(hedl_to_json(doc, 1, &mut out), HEDL_OK);
+        let expected = CStr::from_ptr(out).to_str().unwrap().to_owned();
+        hedl_free_string(out);
+
+        let mut buf = vec![0 as c_char; 64 * 1024];
+        let mut needed = 0usize;
+        assert_eq!(
+            hedl_to_json_into(doc, 1, buf.as_mut_ptr(), buf.len(), &mut needed),
+            HEDL_OK
+        );
+        assert_eq!(needed, expected.len() + 1);
+        assert_eq!(CStr::from_ptr(buf.as_ptr()).to_str().unwrap(), expected);
+
+        hedl_free_document(doc);
+    }
+}
+
+// =============================================================================
+// Size Bound
+// =============================================================================
+
+/// Quotes, markup, control characters, whitespace runs, extreme floats,
+/// references, tensors, expressions, deep objects and NEST children.
+const STRESS_DOC: &str = concat!(
+    "%VERSION: 1.0\n",
+    "%STRUCT: User: [id, name, score, friend, data]\n",
+    "%STRUCT: Order: [id, note]\n",
+    "%NEST: User > Order\n",
+    "---\n",
+    "title: \"\"\"\n",
+    "line \"one\" <&>\n",
+    "  two  \\  three\n",
+    "\"\"\"\n",
+    "huge: 1e300\n",
+    "tiny: 5e-324\n",
+    "when: $(now())\n",
+    "deep:\n",
+    "  a:\n",
+    "    b:\n",
+    "      c:\n",
+    "        d: \"<\\\"q\\\"> & 'x'\"\n",
+    "users: @User\n",
+    "  | alice, \"'Alice' \"\"A\"\" <b>&\", 1e300, @User:bob, [[1.5, 2], [3, 4]]\n",
+    "    | o1, \"it's \"\"x\"\", y\"\n",
+    "    | o2, \"  a   b  \"\n",
+    "  | bob, \"  spaced   out  \", 5e-324, @alice, [1]\n",
+    "\0"
+);
+
+/// Export through `into` with exactly the bound as capacity: it must fit.
+unsafe fn assert_bound_fits(
+    doc: *const HedlDocument,
+    format: c_int,
+    flags: u32,
+    into: impl Fn(*mut c_char, usize, *mut usize) -> c_int,
+) {
+    let mut bound = 0usize;
+    assert_eq!(
+        hedl_estimate_output_size(doc, format, flags, &mut bound),
+        HEDL_OK
+    );
+
+    let mut buf = vec![0 as c_char; bound];
+    let mut needed = 0usize;
+    let result = into(buf.as_mut_ptr(), buf.len(), &mut needed);
+    assert_eq!(
+        result, HEDL_OK,
+        "format {} flags {}: {} > bound {}",
+        format, flags, needed, bound
+    );
+    assert!(needed <= bound);
+}
+
+#[test]
+fn test_bound_holds_for_every_format() {
+    unsafe {
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        let result = hedl_parse(STRESS_DOC.as_ptr() as *const c_char, -1, 0, &mut doc);
+        assert_eq!(
+            result,
+            HEDL_OK,
+            "{:?}",
+            CStr::from_ptr(hedl_get_last_error())
+        );
+
+        for d in [doc as *const HedlDocument, create_test_document()] {
+            assert_bound_fits(d, HEDL_FORMAT_HEDL, 0, |b, c, n| {
+                hedl_canonicalize_into(d, b, c, n)
+            });
+            for flags in [0, HEDL_EXPORT_METADATA] {
+                let meta = (flags != 0) as c_int;
+                #[cfg(feature = "json")]
+                assert_bound_fits(d, HEDL_FORMAT_JSON, flags, |b, c, n| {
+                    hedl_to_json_into(d, meta, b, c, n)
+                });
+                #[cfg(feature = "yaml")]
+                assert_bound_fits(d, HEDL_FORMAT_YAML, flags, |b, c, n| {
+                    hedl_to_yaml_into(d, meta, b, c, n)
+                });
+                let _ = meta;
+            }
+            #[cfg(feature = "xml")]
+            assert_bound_fits(d, HEDL_FORMAT_XML, 0, |b, c, n| {
+                hedl_to_xml_into(d, b, c, n)
+            });
+            #[cfg(feature = "csv")]
+            assert_bound_fits(d, HEDL_FORMAT_CSV, 0, |b, c, n| {
+                hedl_to_csv_into(d, b, c, n)
+            });
+            #[cfg(feature = "neo4j")]
+            for flags in [0, HEDL_EXPORT_CYPHER_MERGE] {
+                let merge = (flags != 0) as c_int;
+                assert_bound_fits(d, HEDL_FORMAT_CYPHER, flags, |b, c, n| {
+                    hedl_to_neo4j_cypher_into(d, merge, b, c, n)
+                });
+            }
+            hedl_free_document(d as *mut HedlDocument);
+        }
+    }
+}
+
+#[test]
+fn test_bound_rejects_unavailable_formats() {
+    unsafe {
+        let doc = create_test_document();
+        let mut bound = 0usize;
+
+        assert_eq!(
+            hedl_estimate_output_size(doc, HEDL_FORMAT_PARQUET, 0, &mut bound),
+            HEDL_ERR_NOT_FOUND
+        );
+        assert_eq!(
+            hedl_estimate_output_size(doc, 99, 0, &mut bound),
+            HEDL_ERR_NOT_FOUND
+        );
+        assert_eq!(
+            hedl_estimate_output_size(ptr::null(), HEDL_FORMAT_HEDL, 0, &mut bound),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(
+            hedl_estimate_output_size(doc, HEDL_FORMAT_HEDL, 0, ptr::null_mut()),
+            HEDL_ERR_NULL_PTR
+        );
+
+        hedl_free_document(doc);
+    }
+}
@@ -0,0 +1,207 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//! Tests for the streaming JSON row import API
+
+#![cfg(feature = "json")]
+
+use hedl_ffi::*;
+use std::ffi::{CStr, CString};
+use std::os::raw::{c_char, c_void};
+use std::ptr;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+const ROWS: &str = r#"[
+    {"id": "u1", "name": "Alice", "age": 30},
+    {"id": "u2", "name": "Bob, \"B\"", "age": null},
+    {"age": 41, "name": "Carol", "id": "u3"}
+]"#;
+
+/// Reader context that hands out input in small fixed-size pieces
+struct ChunkedInput {
+    data: Vec<u8>,
+    pos: usize,
+    chunk: usize,
+}
+
+unsafe extern "C" fn chunked_read(buf: *mut c_char, cap: usize, user_data: *mut c_void) -> isize {
+    let input = &mut *(user_data as *mut ChunkedInput);
+    let n = cap.min(input.chunk).min(input.data.len() - input.pos);
+    ptr::copy_nonoverlapping(input.data[input.pos..].as_ptr(), buf as *mut u8, n);
+    input.pos += n;
+    n as isize
+}
+
+unsafe extern "C" fn failing_read(
+    _buf: *mut c_char,
+    _cap: usize,
+    _user_data: *mut c_void,
+) -> isize {
+    -1
+}
+
+/// Canonicalize and free a document
+unsafe fn canonical(doc: *mut HedlDocument) -> String {
+    let mut out: *mut c_char = ptr::null_mut();
+    assert_eq!(hedl_canonicalize(doc, &mut out), HEDL_OK);
+    let text = CStr::from_ptr(out).to_str().unwrap().to_string();
+    hedl_free_string(out);
+    hedl_free_document(doc);
+    text
+}
+
+/// Canonical form of `{"users": ROWS}` imported with `hedl_from_json`
+fn expected() -> String {
+    let json = format!(r#"{{"users": {}}}"#, ROWS);
+    unsafe {
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        assert_eq!(
+            hedl_from_json_sized(json.as_ptr() as *const c_char, json.len(), &mut doc),
+            HEDL_OK
+        );
+        canonical(doc)
+    }
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+#[test]
+fn test_importer_matches_from_json() {
+    let key = CString::new("users").unwrap();
+    for chunk_size in [1, 5, 4096] {
+        unsafe {
+            let mut importer: *mut HedlJsonImporter = ptr::null_mut();
+            assert_eq!(
+                hedl_json_importer_new(key.as_ptr(), 1, &mut importer),
+                HEDL_OK
+            );
+            for chunk in ROWS.as_bytes().chunks(chunk_size) {
+                assert_eq!(
+                    hedl_json_importer_feed(importer, chunk.as_ptr() as *const c_char, chunk.len()),
+                    HEDL_OK
+                );
+            }
+            let mut doc: *mut HedlDocument = ptr::null_mut();
+            assert_eq!(hedl_json_importer_finish(importer, &mut doc), HEDL_OK);
+            assert_eq!(canonical(doc), expected(), "chunk size {}", chunk_size);
+
+            // Finished importers refuse more input
+            assert_eq!(
+                hedl_json_importer_feed(importer, b"{}".as_ptr() as *const c_char, 2),
+                HEDL_ERR_IO
+            );
+            hedl_json_importer_free(importer);
+        }
+    }
+}
+
+#[test]
+fn test_from_json_reader() {
+    let key = CString::new("users").unwrap();
+    let mut input = ChunkedInput {
+        data: ROWS.as_bytes().to_vec(),
+        pos: 0,
+        chunk: 3,
+    };
+    unsafe {
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        let code = hedl_from_json_reader(
+            Some(chunked_read),
+            &mut input as *mut ChunkedInput as *mut c_void,
+            key.as_ptr(),
+            0,
+            &mut doc,
+        );
+        assert_eq!(code, HEDL_OK);
+        assert_eq!(canonical(doc), expected());
+
+        let code = hedl_from_json_reader(
+            Some(failing_read),
+            ptr::null_mut(),
+            ptr::null(),
+            0,
+            &mut doc,
+        );
+        assert_eq!(code, HEDL_ERR_IO);
+        assert!(doc.is_null());
+    }
+}
+
+#[test]
+fn test_importer_errors_are_sticky() {
+    unsafe {
+        let mut importer: *mut HedlJsonImporter = ptr::null_mut();
+        assert_eq!(
+            hedl_json_importer_new(ptr::null(), 0, &mut importer),
+            HEDL_OK
+        );
+
+        let bad = b"[{\"id\": \"a\"}, 42]";
+        let code = hedl_json_importer_feed(importer, bad.as_ptr() as *const c_char, bad.len());
+        assert_eq!(code, HEDL_ERR_JSON);
+        let err = CStr::from_ptr(hedl_get_last_error())
+            .to_string_lossy()
+            .into_owned();
+        assert!(err.contains("JSON import error"), "{}", err);
+
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        assert_eq!(hedl_json_importer_finish(importer, &mut doc), HEDL_ERR_JSON);
+        assert!(doc.is_null());
+        hedl_json_importer_free(importer);
+
+        // Truncated input is reported by finish
+        assert_eq!(
+            hedl_json_importer_new(ptr::null(), 0, &mut importer),
+            HEDL_OK
+        );
+        let partial = b"[{\"id\": \"a\"}";
+        assert_eq!(
+            hedl_json_importer_feed(importer, partial.as_ptr() as *const c_char, partial.len()),
+            HEDL_OK
+        );
+        assert_eq!(hedl_json_importer_finish(importer, &mut doc), HEDL_ERR_JSON);
+        hedl_json_importer_free(importer);
+    }
+}
+
+#[test]
+fn test_importer_null_pointers() {
+    unsafe {
+        assert_eq!(
+            hedl_json_importer_new(ptr::null(), 0, ptr::null_mut()),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(
+            hedl_json_importer_feed(ptr::null_mut(), ptr::null(), 0),
+            HEDL_ERR_NULL_PTR
+        );
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        assert_eq!(
+            hedl_json_importer_finish(ptr::null_mut(), &mut doc),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(
+            hedl_from_json_reader(None, ptr::null_mut(), ptr::null(), 0, &mut doc),
+            HEDL_ERR_NULL_PTR
+        );
+        hedl_json_importer_free(ptr::null_mut());
+    }
+}
@@ -0,0 +1,160 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Tests for the per-function call metrics API.
+//!
+//! Counters are process-wide, so everything that enables, resets or reads
+//! them runs inside a single test.
+
+use hedl_ffi::*;
+use std::ffi::CStr;
+use std::os::raw::c_char;
+use std::ptr;
+use std::thread;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+const INPUT: &[u8] = b"%VERSION: 1.0\n---\nname: Alice\n";
+
+fn parse_once() -> *mut HedlDocument {
+    let mut doc: *mut HedlDocument = ptr::null_mut();
+    let rc = unsafe {
+        hedl_parse(
+            INPUT.as_ptr() as *const c_char,
+            INPUT.len() as i32,
+            0,
+            &mut doc,
+        )
+    };
+    assert_eq!(rc, HEDL_OK);
+    doc
+}
+
+fn snapshot() -> Vec<HedlFunctionMetrics> {
+    unsafe {
+        let mut count = 0usize;
+        let rc = hedl_metrics_snapshot(ptr::null_mut(), 0, &mut count);
+        assert!(rc == HEDL_OK || rc == HEDL_ERR_BUFFER_TOO_SMALL);
+
+        let mut records = Vec::with_capacity(count);
+        let rc = hedl_metrics_snapshot(records.as_mut_ptr(), count, &mut count);
+        assert_eq!(rc, HEDL_OK);
+        records.set_len(count);
+        records
+    }
+}
+
+fn find<'a>(records: &'a [HedlFunctionMetrics], name: &str) -> Option<&'a HedlFunctionMetrics> {
+    records
+        .iter()
+        .find(|r| unsafe { CStr::from_ptr(r.function) }.to_str() == Ok(name))
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+#[test]
+fn test_metrics_lifecycle() {
+    // Disabled by default: calls are not counted
+    hedl_metrics_reset();
+    unsafe { hedl_free_document(parse_once()) };
+    assert!(find(&snapshot(), "hedl_parse").is_none());
+
+    assert_eq!(hedl_metrics_enable(1), 0);
+
+    // Calls from several threads land in one record
+    let handles: Vec<_> = (0..4)
+        .map(|_| {
+            thread::spawn(|| {
+                for _ in 0..5 {
+                    unsafe { hedl_free_document(parse_once()) };
+                }
+            })
+        })
+        .collect();
+    for handle in handles {
+        handle.join().unwrap();
+    }
+
+    let doc = parse_once();
+    let mut out: *mut c_char = ptr::null_mut();
+    let rc = unsafe { hedl_canonicalize(doc, &mut out) };
+    assert_eq!(rc, HEDL_OK);
+    let canonical_len = unsafe { CStr::from_ptr(out) }.to_bytes().len() as u64;
+    unsafe {
+        hedl_free_string(out);
+        hedl_free_document(doc);
+    }
+
+    // A failing call is counted as a failure
+    let rc = unsafe { hedl_canonicalize(ptr::null(), &mut out) };
+    assert_ne!(rc, HEDL_OK);
+
+    let records = snapshot();
+    let names: Vec<&str> = records
+        .iter()
+        .map(|r| unsafe { CStr::from_ptr(r.function) }.to_str().unwrap())
+        .collect();
+    let mut sorted = names.clone();
+    sorted.sort_unstable();
+    assert_eq!(names, sorted);
+
+    let parse = find(&records, "hedl_parse").expect("hedl_parse recorded");
+    assert_eq!(parse.calls, 21);
+    assert_eq!(parse.failures, 0);
+    assert_eq!(parse.bytes_in, 21 * INPUT.len() as u64);
+    assert_eq!(parse.latency_buckets.iter().sum::<u64>(), parse.calls);
+    assert!(parse.min_ns <= parse.max_ns);
+    assert!(parse.total_ns >= parse.max_ns);
+
+    let canonicalize = find(&records, "hedl_canonicalize").expect("hedl_canonicalize recorded");
+    assert_eq!(canonicalize.calls, 2);
+    assert_eq!(canonicalize.failures, 1);
+    assert_eq!(canonicalize.bytes_out, canonical_len);
+
+    // Too small a buffer still reports the full count
+    let mut first = [snapshot()[0]; 1];
+    let mut count = 0usize;
+    let rc = unsafe { hedl_metrics_snapshot(first.as_mut_ptr(), 1, &mut count) };
+    assert_eq!(rc, HEDL_ERR_BUFFER_TOO_SMALL);
+    assert_eq!(count, records.len());
+
+    hedl_metrics_reset();
+    assert!(snapshot().is_empty());
+
+    assert_eq!(hedl_metrics_enable(0), 1);
+    unsafe { hedl_free_document(parse_once()) };
+    assert!(snapshot().is_empty());
+}
+
+#[test]
+fn test_metrics_snapshot_null_args() {
+    let mut count = 0usize;
+    unsafe {
+        assert_eq!(
+            hedl_metrics_snapshot(ptr::null_mut(), 0, ptr::null_mut()),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(
+            hedl_metrics_snapshot(ptr::null_mut(), 1, &mut count),
+            HEDL_ERR_NULL_PTR
+        );
+    }
+}
@@ -0,0 +1,120 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//! Tests for `hedl_parse_parallel`.
+
+use hedl_ffi::*;
+use std::ffi::CStr;
+use std::os::raw::{c_char, c_int};
+use std::ptr;
+
+/// A list long enough to be split into chunks, with dittos throughout.
+fn large_doc(rows: usize) -> String {
+    let mut doc = String::from(
+        "%VERSION: 1.0\n%STRUCT: User: [id, name, team, manager]\n---\nusers: @User\n",
+    );
+    for i in 0..rows {
+        if i % 100 == 0 {
+            doc.push_str(&format!("  | u{}, User {}, team{}, ~\n", i, i, i / 100));
+        } else {
+            doc.push_str(&format!("  | u{}, User {}, ^, @u{}\n", i, i, i - 1));
+        }
+    }
+    doc.push_str("lead: @User:u0\n");
+    doc
+}
+
+unsafe fn canonical(doc: *const HedlDocument) -> String {
+    let mut out: *mut c_char = ptr::null_mut();
+    assert_eq!(hedl_canonicalize(doc, &mut out), HEDL_OK);
+    let s = CStr::from_ptr(out).to_str().unwrap().to_owned();
+    hedl_free_string(out);
+    s
+}
+
+/// Status code and canonical form (or last error) of one parse.
+unsafe fn outcome(input: &str, parallel: Option<c_int>) -> (c_int, String) {
+    let mut doc: *mut HedlDocument = ptr::null_mut();
+    let ptr = input.as_ptr() as *const c_char;
+    let rc = match parallel {
+        Some(threads) => hedl_parse_parallel(ptr, input.len(), 1, threads, &mut doc),
+        None => hedl_parse_sized(ptr, input.len(), 1, 0, &mut doc),
+    };
+    if rc != HEDL_OK {
+        assert!(doc.is_null());
+        let msg = CStr::from_ptr(hedl_get_last_error())
+            .to_string_lossy()
+            .into_owned();
+        return (rc, msg);
+    }
+    let s = canonical(doc);
+    hedl_free_document(doc);
+    (rc, s)
+}
+
+#[test]
+fn test_matches_sequential_parse() {
+    let input = large_doc(10_000);
+    unsafe {
+        let expected = outcome(&input, None);
+        assert_eq!(expected.0, HEDL_OK);
+        for threads in [0, 1, 2, 4] {
+            assert_eq!(
+                outcome(&input, Some(threads)),
+                expected,
+                "threads = {}",
+                threads
+            );
+        }
+    }
+}
+
+#[test]
+fn test_same_error_as_sequential_parse() {
+    let valid = large_doc(10_000);
+    let inputs = [
+        valid.replacen("  | u7000, User 7000, team70, ~\n", "  | u7000, short\n", 1),
+        valid.replacen("  | u9000,", "  | u12,", 1),
+        valid.replacen("@u4998\n", "@nobody\n", 1),
+    ];
+    unsafe {
+        for input in &inputs {
+            assert!(*input != valid);
+            let expected = outcome(input, None);
+            assert_eq!(expected.0, HEDL_ERR_PARSE);
+            for threads in [0, 3] {
+                assert_eq!(outcome(input, Some(threads)), expected);
+            }
+        }
+    }
+}
+
+#[test]
+fn test_null_pointers() {
+    unsafe {
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        assert_eq!(
+            hedl_parse_parallel(ptr::null(), 0, 1, 0, &mut doc),
+            HEDL_ERR_NULL_PTR
+        );
+        let input = "%VERSION: 1.0\n---\n";
+        let ptr = input.as_ptr() as *const c_char;
+        assert_eq!(
+            hedl_parse_parallel(ptr, input.len(), 1, 0, ptr::null_mut()),
+            HEDL_ERR_NULL_PTR
+        );
+    }
+}
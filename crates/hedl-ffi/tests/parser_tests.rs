@@ -0,0 +1,121 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//! Tests for the reusable `HedlParser` handle.
+
+use hedl_ffi::*;
+use std::ffi::CStr;
+use std::os::raw::c_char;
+use std::ptr;
+
+fn new_parser(strict: i32) -> *mut HedlParser {
+    let mut parser: *mut HedlParser = ptr::null_mut();
+    unsafe {
+        assert_eq!(hedl_parser_new(strict, &mut parser), HEDL_OK);
+    }
+    assert!(!parser.is_null());
+    parser
+}
+
+unsafe fn parse_into(parser: *mut HedlParser, input: &str) -> (i32, *const HedlDocument) {
+    let mut doc: *const HedlDocument = ptr::null();
+    let code = hedl_parser_parse(parser, input.as_ptr() as *const c_char, input.len(), &mut doc);
+    (code, doc)
+}
+
+#[test]
+fn test_parser_owns_documents_until_reset() {
+    let parser = new_parser(0);
+    unsafe {
+        for round in 0..3 {
+            let mut docs = Vec::new();
+            for i in 0..100 {
+                let input = format!("%VERSION: 1.0\n---\nround: {}\nid: {}\n", round, i);
+                let (code, doc) = parse_into(parser, &input);
+                assert_eq!(code, HEDL_OK);
+                docs.push(doc);
+            }
+            assert_eq!(hedl_parser_document_count(parser), 100);
+
+            // Every handle stays valid while the parser owns it
+            for &doc in &docs {
+                assert_eq!(hedl_root_item_count(doc), 2);
+            }
+
+            hedl_parser_reset(parser);
+            assert_eq!(hedl_parser_document_count(parser), 0);
+        }
+        hedl_parser_free(parser);
+    }
+}
+
+#[test]
+fn test_parser_failed_parse_is_not_retained() {
+    let parser = new_parser(0);
+    unsafe {
+        let (code, doc) = parse_into(parser, "not valid hedl");
+        assert_eq!(code, HEDL_ERR_PARSE);
+        assert!(doc.is_null());
+        assert_eq!(hedl_parser_document_count(parser), 0);
+
+        let err = CStr::from_ptr(hedl_get_last_error()).to_str().unwrap();
+        assert!(err.contains("Parse error"), "{}", err);
+
+        let (code, _) = parse_into(parser, "%VERSION: 1.0\n---\nkey: value\n");
+        assert_eq!(code, HEDL_OK);
+        assert_eq!(hedl_parser_document_count(parser), 1);
+
+        // Freeing the parser releases the remaining document
+        hedl_parser_free(parser);
+    }
+}
+
+#[test]
+fn test_parser_strict_mode() {
+    let input = "%VERSION: 1.0\n---\nref: @Missing:x\n";
+    unsafe {
+        let lenient = new_parser(0);
+        assert_eq!(parse_into(lenient, input).0, HEDL_OK);
+        hedl_parser_free(lenient);
+
+        let strict = new_parser(1);
+        assert_eq!(parse_into(strict, input).0, HEDL_ERR_PARSE);
+        hedl_parser_free(strict);
+    }
+}
+
+#[test]
+fn test_parser_null_handling() {
+    unsafe {
+        assert_eq!(hedl_parser_new(0, ptr::null_mut()), HEDL_ERR_NULL_PTR);
+
+        let mut doc: *const HedlDocument = ptr::null();
+        let input = "%VERSION: 1.0\n---\n";
+        let code =
+            hedl_parser_parse(ptr::null_mut(), input.as_ptr() as *const c_char, input.len(), &mut doc);
+        assert_eq!(code, HEDL_ERR_NULL_PTR);
+
+        let parser = new_parser(0);
+        let code = hedl_parser_parse(parser, ptr::null(), 0, &mut doc);
+        assert_eq!(code, HEDL_ERR_NULL_PTR);
+        assert_eq!(hedl_parser_document_count(parser), 0);
+        hedl_parser_free(parser);
+
+        assert_eq!(hedl_parser_document_count(ptr::null()), 0);
+        hedl_parser_reset(ptr::null_mut());
+        hedl_parser_free(ptr::null_mut());
+    }
+}
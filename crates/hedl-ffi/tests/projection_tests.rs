@@ -0,0 +1,145 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//! Tests for `hedl_parse_projected`.
+
+use hedl_ffi::*;
+use std::ffi::{CStr, CString};
+use std::os::raw::c_char;
+use std::ptr;
+
+const INPUT: &str = concat!(
+    "%VERSION: 1.0\n",
+    "%STRUCT: User: [id, name, email]\n",
+    "---\n",
+    "users: @User\n",
+    "  | u1, Alice, alice@example.com\n",
+    "  | u2, Bob, bob@example.com\n",
+    "config:\n",
+    "  owner: @User:u2\n",
+    "  theme: dark\n",
+);
+
+/// Parse `input` with the given projection, returning the status code and
+/// the canonical form of the document on success.
+fn parse_projected(input: &str, strict: i32, keys: &[&str], columns: &[&str]) -> (i32, String) {
+    let keys: Vec<CString> = keys.iter().map(|k| CString::new(*k).unwrap()).collect();
+    let columns: Vec<CString> = columns.iter().map(|c| CString::new(*c).unwrap()).collect();
+    let key_ptrs: Vec<*const c_char> = keys.iter().map(|k| k.as_ptr()).collect();
+    let column_ptrs: Vec<*const c_char> = columns.iter().map(|c| c.as_ptr()).collect();
+    let array = |ptrs: &[*const c_char]| {
+        if ptrs.is_empty() {
+            ptr::null()
+        } else {
+            ptrs.as_ptr()
+        }
+    };
+
+    unsafe {
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        let code = hedl_parse_projected(
+            input.as_ptr() as *const c_char,
+            input.len(),
+            strict,
+            array(&key_ptrs),
+            key_ptrs.len(),
+            array(&column_ptrs),
+            column_ptrs.len(),
+            &mut doc,
+        );
+        if code != HEDL_OK {
+            assert!(doc.is_null());
+            return (code, String::new());
+        }
+
+        let mut out: *mut c_char = ptr::null_mut();
+        assert_eq!(hedl_canonicalize(doc, &mut out), HEDL_OK);
+        let text = CStr::from_ptr(out).to_str().unwrap().to_string();
+        hedl_free_string(out);
+        hedl_free_document(doc);
+        (code, text)
+    }
+}
+
+#[test]
+fn test_projected_keys_and_columns() {
+    let (code, text) = parse_projected(INPUT, 1, &[], &[]);
+    assert_eq!(code, HEDL_OK);
+    assert!(
+        text.contains("alice@example.com") && text.contains("theme"),
+        "{}",
+        text
+    );
+
+    let (code, text) = parse_projected(INPUT, 1, &["users"], &["User.email"]);
+    assert_eq!(code, HEDL_OK);
+    assert!(text.contains("alice@example.com"), "{}", text);
+    assert!(
+        !text.contains("Alice") && !text.contains("config"),
+        "{}",
+        text
+    );
+
+    let (code, text) = parse_projected(INPUT, 1, &["config.theme"], &[]);
+    assert_eq!(code, HEDL_OK);
+    assert!(
+        text.contains("theme") && !text.contains("owner"),
+        "{}",
+        text
+    );
+}
+
+#[test]
+fn test_projected_references_into_skipped_lists() {
+    let (code, text) = parse_projected(INPUT, 1, &["config.owner"], &[]);
+    assert_eq!(code, HEDL_OK);
+    assert!(!text.contains("users"), "{}", text);
+
+    let dangling = INPUT.replace("@User:u2", "@User:u9");
+    assert_eq!(
+        parse_projected(&dangling, 1, &["config"], &[]).0,
+        HEDL_ERR_PARSE
+    );
+    assert_eq!(parse_projected(&dangling, 0, &["config"], &[]).0, HEDL_OK);
+}
+
+#[test]
+fn test_projected_errors() {
+    assert_eq!(
+        parse_projected(INPUT, 1, &[], &["User.age"]).0,
+        HEDL_ERR_PARSE
+    );
+    assert_eq!(parse_projected(INPUT, 1, &[], &["email"]).0, HEDL_ERR_PARSE);
+    let err = unsafe { CStr::from_ptr(hedl_get_last_error()).to_str().unwrap() };
+    assert!(err.contains("Type.column"), "{}", err);
+
+    unsafe {
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        let keys = [ptr::null::<c_char>()];
+        let code = hedl_parse_projected(
+            INPUT.as_ptr() as *const c_char,
+            INPUT.len(),
+            1,
+            keys.as_ptr(),
+            1,
+            ptr::null(),
+            0,
+            &mut doc,
+        );
+        assert_eq!(code, HEDL_ERR_NULL_PTR);
+        assert!(doc.is_null());
+    }
+}
@@ -0,0 +1,301 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Tests for the push-based streaming parser API
+
+use hedl_ffi::*;
+use std::os::raw::{c_char, c_int, c_void};
+use std::ptr;
+use std::slice;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+const MATRIX_DOC: &str = concat!(
+    "%VERSION: 1.0\n",
+    "%STRUCT: User: [id, name, age]\n",
+    "%STRUCT: Order: [id, amount]\n",
+    "%NEST: User > Order\n",
+    "---\n",
+    "title: Export\n",
+    "users: @User\n",
+    "  | alice, Alice, 30\n",
+    "    | o1, 9.5\n",
+    "  | bob, \"Bob\", 25\n",
+    "meta:\n",
+    "  owner: Zoë\n",
+);
+
+/// One recorded event: kind, line and its key or id (if any)
+type Recorded = (c_int, i64, String);
+
+unsafe fn describe(stream: *const HedlStream, event: c_int) -> Recorded {
+    let mut ptr: *const c_char = ptr::null();
+    let mut len = 0usize;
+    let text = if hedl_stream_event_id(stream, &mut ptr, &mut len) == HEDL_OK
+        || hedl_stream_event_key(stream, &mut ptr, &mut len) == HEDL_OK
+    {
+        String::from_utf8(slice::from_raw_parts(ptr as *const u8, len).to_vec()).unwrap()
+    } else {
+        String::new()
+    };
+    (event, hedl_stream_event_line(stream), text)
+}
+
+unsafe extern "C" fn record_event(stream: *const HedlStream, event: c_int, user_data: *mut c_void) {
+    let events = &mut *(user_data as *mut Vec<Recorded>);
+    events.push(describe(stream, event));
+}
+
+/// Events of the pull parser over the whole document, for comparison
+unsafe fn pull_events(doc: &str) -> Vec<Recorded> {
+    let mut stream: *mut HedlStream = ptr::null_mut();
+    assert_eq!(
+        hedl_stream_open_buffer(doc.as_ptr() as *const c_char, doc.len(), &mut stream),
+        HEDL_OK
+    );
+    let mut events = Vec::new();
+    loop {
+        let mut event = 0;
+        assert_eq!(hedl_stream_next(stream, &mut event), HEDL_OK);
+        events.push(describe(stream, event));
+        if event == HEDL_EVENT_END {
+            break;
+        }
+    }
+    hedl_stream_close(stream);
+    events
+}
+
+/// Push `doc` in pieces of `chunk` bytes and return the recorded events
+unsafe fn push_events(doc: &str, chunk: usize) -> Vec<Recorded> {
+    let mut events: Vec<Recorded> = Vec::new();
+    let mut parser: *mut HedlPushParser = ptr::null_mut();
+    assert_eq!(
+        hedl_push_parser_new(Some(record_event), &mut events as *mut _ as *mut c_void, &mut parser),
+        HEDL_OK
+    );
+    for piece in doc.as_bytes().chunks(chunk) {
+        assert_eq!(
+            hedl_push_parser_feed(parser, piece.as_ptr() as *const c_char, piece.len()),
+            HEDL_OK
+        );
+    }
+    assert_eq!(hedl_push_parser_finish(parser), HEDL_OK);
+    hedl_push_parser_free(parser);
+    events
+}
+
+// =============================================================================
+// Chunk Boundaries
+// =============================================================================
+
+#[test]
+fn test_push_matches_pull_for_any_chunk_size() {
+    unsafe {
+        let expected = pull_events(MATRIX_DOC);
+        assert_eq!(expected.last().unwrap().0, HEDL_EVENT_END);
+        // 1-byte pieces split every line and the multi-byte 'ë'
+        for chunk in [1, 2, 3, 7, 16, MATRIX_DOC.len()] {
+            assert_eq!(push_events(MATRIX_DOC, chunk), expected, "chunk size {}", chunk);
+        }
+    }
+}
+
+const BLOCK_DOC: &str = concat!(
+    "%VERSION: 1.0\n",
+    "%STRUCT: User: [id, name]\n",
+    "---\n",
+    "users: @User\n",
+    "  | alice, Alice\n",
+    "notes: \"\"\"\n",
+    "  users: @User\n",
+    "  | not, a row\n",
+    "\"\"\"\n",
+    "after: 1\n",
+);
+
+unsafe extern "C" fn record_strings(stream: *const HedlStream, event: c_int, user_data: *mut c_void) {
+    let strings = &mut *(user_data as *mut Vec<String>);
+    let mut view: HedlValueView = std::mem::zeroed();
+    if event == HEDL_EVENT_SCALAR
+        && hedl_stream_event_value(stream, 0, &mut view) == HEDL_OK
+        && view.kind == HEDL_VALUE_STRING
+    {
+        let bytes = slice::from_raw_parts(view.str_ptr as *const u8, view.str_len);
+        strings.push(String::from_utf8(bytes.to_vec()).unwrap());
+    }
+}
+
+#[test]
+fn test_push_carries_block_strings_across_chunks() {
+    unsafe {
+        let expected = pull_events(BLOCK_DOC);
+        let kinds: Vec<c_int> = expected.iter().map(|e| e.0).collect();
+        assert_eq!(
+            kinds,
+            vec![
+                HEDL_EVENT_LIST_START,
+                HEDL_EVENT_NODE,
+                HEDL_EVENT_LIST_END,
+                HEDL_EVENT_SCALAR,
+                HEDL_EVENT_SCALAR,
+                HEDL_EVENT_END
+            ]
+        );
+        assert_eq!(expected[3], (HEDL_EVENT_SCALAR, 6, "notes".to_string()));
+
+        for chunk in [1, 2, 3, 7, 16, BLOCK_DOC.len()] {
+            assert_eq!(push_events(BLOCK_DOC, chunk), expected, "chunk size {}", chunk);
+
+            let mut strings: Vec<String> = Vec::new();
+            let mut parser: *mut HedlPushParser = ptr::null_mut();
+            hedl_push_parser_new(Some(record_strings), &mut strings as *mut _ as *mut c_void, &mut parser);
+            for piece in BLOCK_DOC.as_bytes().chunks(chunk) {
+                hedl_push_parser_feed(parser, piece.as_ptr() as *const c_char, piece.len());
+            }
+            assert_eq!(hedl_push_parser_finish(parser), HEDL_OK);
+            hedl_push_parser_free(parser);
+            assert_eq!(strings, vec!["\n  users: @User\n  | not, a row\n".to_string()]);
+        }
+    }
+}
+
+#[test]
+fn test_push_rejects_unclosed_block_string() {
+    unsafe {
+        let mut events: Vec<Recorded> = Vec::new();
+        let mut parser: *mut HedlPushParser = ptr::null_mut();
+        hedl_push_parser_new(Some(record_event), &mut events as *mut _ as *mut c_void, &mut parser);
+        let doc = "%VERSION: 1.0\n---\nnotes: \"\"\"\nopen\n";
+        assert_eq!(
+            hedl_push_parser_feed(parser, doc.as_ptr() as *const c_char, doc.len()),
+            HEDL_OK
+        );
+        assert_eq!(hedl_push_parser_finish(parser), HEDL_ERR_PARSE);
+        assert!(events.is_empty());
+        hedl_push_parser_free(parser);
+    }
+}
+
+#[test]
+fn test_push_events_arrive_before_finish() {
+    unsafe {
+        let mut events: Vec<Recorded> = Vec::new();
+        let mut parser: *mut HedlPushParser = ptr::null_mut();
+        hedl_push_parser_new(Some(record_event), &mut events as *mut _ as *mut c_void, &mut parser);
+
+        let header = "%VERSION: 1.0\n%STRUCT: User: [id, name]\n---\nusers: @User\n  | alice, Al";
+        hedl_push_parser_feed(parser, header.as_ptr() as *const c_char, header.len());
+        // List start is complete; the alice row is still partial
+        assert_eq!(events.len(), 1);
+        assert_eq!(events[0].0, HEDL_EVENT_LIST_START);
+
+        let rest = "ice\n  | bob, Bob";
+        hedl_push_parser_feed(parser, rest.as_ptr() as *const c_char, rest.len());
+        assert_eq!(events.len(), 2);
+        assert_eq!(events[1], (HEDL_EVENT_NODE, 5, "alice".to_string()));
+
+        // The unterminated last line is parsed on finish
+        assert_eq!(hedl_push_parser_finish(parser), HEDL_OK);
+        let kinds: Vec<c_int> = events.iter().map(|e| e.0).collect();
+        assert_eq!(
+            kinds,
+            vec![
+                HEDL_EVENT_LIST_START,
+                HEDL_EVENT_NODE,
+                HEDL_EVENT_NODE,
+                HEDL_EVENT_LIST_END,
+                HEDL_EVENT_END
+            ]
+        );
+
+        hedl_push_parser_free(parser);
+    }
+}
+
+// =============================================================================
+// Errors
+// =============================================================================
+
+#[test]
+fn test_push_error_is_sticky() {
+    unsafe {
+        let mut events: Vec<Recorded> = Vec::new();
+        let mut parser: *mut HedlPushParser = ptr::null_mut();
+        hedl_push_parser_new(Some(record_event), &mut events as *mut _ as *mut c_void, &mut parser);
+
+        let bad = "%VERSION: 1.0\n---\n  | orphan, row\n";
+        let code = hedl_push_parser_feed(parser, bad.as_ptr() as *const c_char, bad.len());
+        assert_ne!(code, HEDL_OK);
+        assert!(!hedl_get_last_error().is_null());
+
+        let more = "x: 1\n";
+        assert_eq!(
+            hedl_push_parser_feed(parser, more.as_ptr() as *const c_char, more.len()),
+            code
+        );
+        assert_eq!(hedl_push_parser_finish(parser), code);
+
+        hedl_push_parser_free(parser);
+    }
+}
+
+#[test]
+fn test_push_missing_version_reported_on_finish() {
+    unsafe {
+        let mut events: Vec<Recorded> = Vec::new();
+        let mut parser: *mut HedlPushParser = ptr::null_mut();
+        hedl_push_parser_new(Some(record_event), &mut events as *mut _ as *mut c_void, &mut parser);
+
+        let partial = "%STRUCT: User: [id]";
+        assert_eq!(
+            hedl_push_parser_feed(parser, partial.as_ptr() as *const c_char, partial.len()),
+            HEDL_OK
+        );
+        assert_eq!(hedl_push_parser_finish(parser), HEDL_ERR_PARSE);
+        assert!(events.is_empty());
+
+        hedl_push_parser_free(parser);
+    }
+}
+
+#[test]
+fn test_push_feed_after_finish_and_null_args() {
+    unsafe {
+        let mut events: Vec<Recorded> = Vec::new();
+        let mut parser: *mut HedlPushParser = ptr::null_mut();
+        assert_eq!(hedl_push_parser_new(None, ptr::null_mut(), &mut parser), HEDL_ERR_NULL_PTR);
+        hedl_push_parser_new(Some(record_event), &mut events as *mut _ as *mut c_void, &mut parser);
+
+        assert_eq!(hedl_push_parser_feed(parser, ptr::null(), 4), HEDL_ERR_NULL_PTR);
+        assert_eq!(hedl_push_parser_feed(parser, ptr::null(), 0), HEDL_OK);
+
+        let doc = "%VERSION: 1.0\n---\na: 1\n";
+        hedl_push_parser_feed(parser, doc.as_ptr() as *const c_char, doc.len());
+        assert_eq!(hedl_push_parser_finish(parser), HEDL_OK);
+        assert_eq!(events.last().unwrap().0, HEDL_EVENT_END);
+        assert_eq!(
+            hedl_push_parser_feed(parser, doc.as_ptr() as *const c_char, doc.len()),
+            HEDL_ERR_IO
+        );
+
+        hedl_push_parser_free(parser);
+        hedl_push_parser_free(ptr::null_mut());
+    }
+}
@@ -163,6 +163,39 @@ fn test_hedl_lint_null_out_diag() {
     }
 }
 
+#[test]
+fn test_hedl_lint_with_rules_masks_and_early_exit() {
+    // Unused schema (warning) and an empty list (hint)
+    let input = b"%VERSION: 1.0\n%STRUCT: Unused: [id]\n%STRUCT: Row: [id]\n---\nrows: @Row\n\0";
+    unsafe {
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        assert_eq!(hedl_parse(input.as_ptr() as *const c_char, -1, 0, &mut doc), HEDL_OK);
+
+        let lint = |rules: u32, error_rules: u32, stop_on_error: c_int| -> Vec<c_int> {
+            let mut diag: *mut HedlDiagnostics = ptr::null_mut();
+            let rc = hedl_lint_with_rules(doc, rules, error_rules, 0, stop_on_error, &mut diag);
+            assert_eq!(rc, HEDL_OK);
+            let severities = (0..hedl_diagnostics_count(diag))
+                .map(|i| hedl_diagnostics_severity(diag, i))
+                .collect();
+            hedl_free_diagnostics(diag);
+            severities
+        };
+
+        assert_eq!(lint(HEDL_LINT_RULES_ALL, 0, 0), vec![1, 0]);
+        assert_eq!(lint(HEDL_LINT_RULE_EMPTY_LIST, 0, 0), vec![0]);
+        assert_eq!(lint(HEDL_LINT_RULES_ALL, HEDL_LINT_RULE_UNUSED_SCHEMA, 0), vec![2, 0]);
+        // unused-schema runs before empty-list, so its error ends the run
+        assert_eq!(lint(HEDL_LINT_RULES_ALL, HEDL_LINT_RULE_UNUSED_SCHEMA, 1), vec![2]);
+
+        let mut diag: *mut HedlDiagnostics = ptr::null_mut();
+        let rc = hedl_lint_with_rules(ptr::null(), HEDL_LINT_RULES_ALL, 0, 0, 0, &mut diag);
+        assert_eq!(rc, HEDL_ERR_NULL_PTR);
+
+        hedl_free_document(doc);
+    }
+}
+
 #[test]
 fn test_hedl_diagnostics_count_null() {
     unsafe {
@@ -269,6 +302,28 @@ fn test_hedl_validate_invalid_utf8() {
     }
 }
 
+#[test]
+fn test_hedl_validate_matches_parse() {
+    let inputs: [&[u8]; 4] = [
+        b"%VERSION: 1.0\n%STRUCT: User: [id, boss]\n---\nusers: @User\n  | a, @b\n  | b, ~\n",
+        b"%VERSION: 1.0\n%STRUCT: User: [id, boss]\n---\nusers: @User\n  | a, @zz\n",
+        b"%VERSION: 1.0\n---\nowner: @nobody\n",
+        b"%VERSION: 1.0\n---\na: 1\na: 2\n",
+    ];
+    unsafe {
+        for input in inputs {
+            for strict in [0, 1] {
+                let ptr = input.as_ptr() as *const c_char;
+                let mut doc: *mut HedlDocument = ptr::null_mut();
+                let parsed = hedl_parse_sized(ptr, input.len(), strict, 0, &mut doc);
+                hedl_free_document(doc);
+                assert_eq!(hedl_validate_sized(ptr, input.len(), strict, 0), parsed);
+                assert_eq!(hedl_validate(ptr, input.len() as c_int, strict), parsed);
+            }
+        }
+    }
+}
+
 // =============================================================================
 // Double-Free Protection
 // =============================================================================
@@ -774,6 +829,197 @@ fn test_hedl_parse_extremely_large_input() {
     }
 }
 
+#[test]
+fn test_hedl_parse_sized_without_terminator() {
+    unsafe {
+        let input = b"%VERSION: 1.0\n---\nkey: value";
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        let result = hedl_parse_sized(input.as_ptr() as *const c_char, input.len(), 0, 0, &mut doc);
+
+        assert_eq!(result, HEDL_OK);
+        assert!(!doc.is_null());
+        assert_eq!(hedl_root_item_count(doc), 1);
+
+        hedl_free_document(doc);
+    }
+}
+
+#[test]
+fn test_hedl_parse_sized_stops_at_length() {
+    unsafe {
+        // Trailing bytes past input_len must not be read
+        let input = b"%VERSION: 1.0\n---\nkey: value\nother: \xFF\xFF";
+        let len = input.len() - b"other: \xFF\xFF".len();
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        let result = hedl_parse_sized(input.as_ptr() as *const c_char, len, 0, 0, &mut doc);
+
+        assert_eq!(result, HEDL_OK);
+        assert_eq!(hedl_root_item_count(doc), 1);
+
+        hedl_free_document(doc);
+    }
+}
+
+#[test]
+fn test_hedl_parse_sized_invalid_utf8_and_null() {
+    unsafe {
+        let input = b"%VERSION: 1.0\n---\nkey: \xFF";
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        let result = hedl_parse_sized(input.as_ptr() as *const c_char, input.len(), 0, 0, &mut doc);
+        assert_eq!(result, HEDL_ERR_INVALID_UTF8);
+
+        assert_eq!(hedl_parse_sized(ptr::null(), 0, 0, 0, &mut doc), HEDL_ERR_NULL_PTR);
+        assert_eq!(hedl_validate_sized(ptr::null(), 0, 0, 0), HEDL_ERR_NULL_PTR);
+    }
+}
+
+#[test]
+fn test_hedl_parse_sized_max_size() {
+    unsafe {
+        let input = b"%VERSION: 1.0\n---\nkey: value\n";
+        let ptr = input.as_ptr() as *const c_char;
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+
+        // One byte under the input: rejected by both entry points
+        let result = hedl_parse_sized(ptr, input.len(), 0, input.len() - 1, &mut doc);
+        assert_eq!(result, HEDL_ERR_PARSE);
+        assert!(doc.is_null());
+        let err_msg = CStr::from_ptr(hedl_get_last_error()).to_str().unwrap();
+        assert!(err_msg.contains("too large"), "{}", err_msg);
+        assert_eq!(hedl_validate_sized(ptr, input.len(), 0, input.len() - 1), HEDL_ERR_PARSE);
+
+        // Exactly the input, and far past the 1GB default: accepted
+        for max_size in [input.len(), 0, 64 << 30, usize::MAX] {
+            assert_eq!(hedl_parse_sized(ptr, input.len(), 0, max_size, &mut doc), HEDL_OK);
+            hedl_free_document(doc);
+            assert_eq!(hedl_validate_sized(ptr, input.len(), 0, max_size), HEDL_OK);
+        }
+    }
+}
+
+#[test]
+fn test_hedl_validate_sized() {
+    unsafe {
+        let valid = b"%VERSION: 1.0\n---\nkey: value";
+        assert_eq!(hedl_validate_sized(valid.as_ptr() as *const c_char, valid.len(), 0, 0), HEDL_OK);
+
+        let invalid = b"not valid hedl";
+        assert_eq!(
+            hedl_validate_sized(invalid.as_ptr() as *const c_char, invalid.len(), 0, 0),
+            HEDL_ERR_PARSE
+        );
+    }
+}
+
+/// Write `contents` to a per-process temp file and return its C path.
+fn temp_file(name: &str, contents: &[u8]) -> (std::path::PathBuf, std::ffi::CString) {
+    let path = std::env::temp_dir().join(format!("hedl_ffi_{}_{}", std::process::id(), name));
+    std::fs::write(&path, contents).unwrap();
+    let c_path = std::ffi::CString::new(path.to_str().unwrap()).unwrap();
+    (path, c_path)
+}
+
+#[test]
+fn test_hedl_parse_file() {
+    unsafe {
+        let (path, c_path) = temp_file("parse.hedl", b"%VERSION: 1.0\n---\na: 1\nb: 2\n");
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+
+        assert_eq!(hedl_parse_file(c_path.as_ptr(), 1, 0, &mut doc), HEDL_OK);
+        assert_eq!(hedl_root_item_count(doc), 2);
+
+        hedl_free_document(doc);
+        std::fs::remove_file(path).unwrap();
+    }
+}
+
+#[test]
+fn test_hedl_parse_file_errors() {
+    unsafe {
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+
+        assert_eq!(hedl_parse_file(ptr::null(), 0, 0, &mut doc), HEDL_ERR_NULL_PTR);
+
+        let missing = std::ffi::CString::new("/nonexistent/hedl_ffi_missing.hedl").unwrap();
+        assert_eq!(hedl_parse_file(missing.as_ptr(), 0, 0, &mut doc), HEDL_ERR_IO);
+        assert!(doc.is_null());
+
+        // Empty files are not mapped but still reach the parser
+        let (empty, c_empty) = temp_file("empty.hedl", b"");
+        assert_eq!(hedl_parse_file(c_empty.as_ptr(), 0, 0, &mut doc), HEDL_ERR_PARSE);
+        std::fs::remove_file(empty).unwrap();
+
+        let (bad, c_bad) = temp_file("bad.hedl", b"%VERSION: 1.0\n---\nkey: \xFF\n");
+        assert_eq!(hedl_parse_file(c_bad.as_ptr(), 0, 0, &mut doc), HEDL_ERR_INVALID_UTF8);
+        std::fs::remove_file(bad).unwrap();
+    }
+}
+
+#[test]
+fn test_hedl_parse_file_max_size() {
+    unsafe {
+        let contents = b"%VERSION: 1.0\n---\na: 1\n";
+        let (path, c_path) = temp_file("max_size.hedl", contents);
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+
+        let result = hedl_parse_file(c_path.as_ptr(), 0, contents.len() - 1, &mut doc);
+        assert_eq!(result, HEDL_ERR_PARSE);
+        assert!(doc.is_null());
+
+        assert_eq!(hedl_parse_file(c_path.as_ptr(), 0, contents.len(), &mut doc), HEDL_OK);
+        hedl_free_document(doc);
+        std::fs::remove_file(path).unwrap();
+    }
+}
+
+#[test]
+#[ignore = "writes a file just past the 1GB default limit"]
+fn test_hedl_parse_file_past_default_limit() {
+    use std::io::Write;
+
+    const LIMIT: usize = 1024 * 1024 * 1024;
+    let path = std::env::temp_dir().join(format!("hedl_ffi_{}_large.hedl", std::process::id()));
+    {
+        let mut file = std::io::BufWriter::new(std::fs::File::create(&path).unwrap());
+        file.write_all(b"%VERSION: 1.0\n---\na: 1\n").unwrap();
+        // Long comment lines keep the line index small
+        let mut comment = vec![b'x'; 64 * 1024];
+        comment[0] = b'#';
+        *comment.last_mut().unwrap() = b'\n';
+        for _ in 0..=LIMIT / comment.len() {
+            file.write_all(&comment).unwrap();
+        }
+    }
+    assert!(std::fs::metadata(&path).unwrap().len() > LIMIT as u64);
+    let c_path = std::ffi::CString::new(path.to_str().unwrap()).unwrap();
+
+    unsafe {
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        assert_eq!(hedl_parse_file(c_path.as_ptr(), 0, 0, &mut doc), HEDL_ERR_PARSE);
+        assert!(doc.is_null());
+
+        assert_eq!(hedl_parse_file(c_path.as_ptr(), 0, 2 * LIMIT, &mut doc), HEDL_OK);
+        assert_eq!(hedl_root_item_count(doc), 1);
+        hedl_free_document(doc);
+    }
+    std::fs::remove_file(path).unwrap();
+}
+
+#[cfg(feature = "json")]
+#[test]
+fn test_hedl_from_json_sized() {
+    unsafe {
+        let json = br#"{"name": "Alice", "age": 30}"#;
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        let result = hedl_from_json_sized(json.as_ptr() as *const c_char, json.len(), &mut doc);
+
+        assert_eq!(result, HEDL_OK);
+        assert_eq!(hedl_root_item_count(doc), 2);
+
+        hedl_free_document(doc);
+    }
+}
+
 // =============================================================================
 // Error Code Verification
 // =============================================================================
@@ -795,6 +1041,10 @@ fn test_all_error_codes_defined() {
         HEDL_ERR_PARQUET,
         HEDL_ERR_LINT,
         HEDL_ERR_NEO4J,
+        HEDL_ERR_IO,
+        HEDL_ERR_NOT_FOUND,
+        HEDL_ERR_BUFFER_TOO_SMALL,
+        HEDL_ERR_TYPE_MISMATCH,
     ];
 
     for (i, &code1) in codes.iter().enumerate() {
@@ -0,0 +1,273 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//! Tests for shared document handles and `hedl_export_multi`
+
+use hedl_ffi::*;
+use std::ffi::CStr;
+use std::os::raw::{c_char, c_int};
+use std::ptr;
+use std::slice;
+use std::sync::{Arc, Barrier};
+use std::thread;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+const INPUT: &str = concat!(
+    "%VERSION: 1.0\n",
+    "%STRUCT: User: [id, name]\n",
+    "---\n",
+    "users: @User\n",
+    "  | u1, Alice\n",
+    "  | u2, Bob\n",
+    "owner: @User:u2\n",
+);
+
+fn parse(input: &str) -> *mut HedlDocument {
+    unsafe {
+        let mut doc: *mut HedlDocument = ptr::null_mut();
+        assert_eq!(
+            hedl_parse_sized(input.as_ptr() as *const c_char, input.len(), 1, 0, &mut doc),
+            HEDL_OK
+        );
+        doc
+    }
+}
+
+unsafe fn canonical(doc: *const HedlDocument) -> String {
+    let mut out: *mut c_char = ptr::null_mut();
+    assert_eq!(hedl_canonicalize(doc, &mut out), HEDL_OK);
+    let text = CStr::from_ptr(out).to_str().unwrap().to_string();
+    hedl_free_string(out);
+    text
+}
+
+/// Shared handle that can cross threads; the document is only read.
+#[derive(Clone, Copy)]
+struct SendDoc(*const HedlDocument);
+
+unsafe impl Send for SendDoc {}
+
+// =============================================================================
+// Shared Documents
+// =============================================================================
+
+#[test]
+fn test_shared_document_concurrent_readers() {
+    const THREADS: usize = 8;
+
+    let doc = parse(INPUT);
+    let expected = unsafe { canonical(doc) };
+
+    let mut shared: *const HedlDocument = ptr::null();
+    unsafe {
+        assert_eq!(hedl_document_share(doc, &mut shared), HEDL_OK);
+    }
+    assert!(!shared.is_null());
+
+    let barrier = Arc::new(Barrier::new(THREADS));
+    let handles: Vec<_> = (0..THREADS)
+        .map(|_| {
+            // Each reader holds its own reference
+            unsafe { hedl_document_retain(shared) };
+            let doc = SendDoc(shared);
+            let barrier = Arc::clone(&barrier);
+            thread::spawn(move || {
+                let doc = doc;
+                barrier.wait();
+                let mut texts = Vec::new();
+                for _ in 0..20 {
+                    unsafe {
+                        texts.push(canonical(doc.0));
+                        let mut node: *const HedlNode = ptr::null();
+                        assert_eq!(
+                            hedl_find_node(
+                                doc.0,
+                                b"User".as_ptr() as *const c_char,
+                                4,
+                                b"u2".as_ptr() as *const c_char,
+                                2,
+                                &mut node
+                            ),
+                            HEDL_OK
+                        );
+                    }
+                }
+                unsafe { hedl_document_release(doc.0) };
+                texts
+            })
+        })
+        .collect();
+
+    // The creator's reference can go first; readers keep the document alive
+    unsafe { hedl_document_release(shared) };
+
+    for handle in handles {
+        for text in handle.join().unwrap() {
+            assert_eq!(text, expected);
+        }
+    }
+}
+
+#[test]
+fn test_shared_document_null_pointers() {
+    unsafe {
+        let mut shared: *const HedlDocument = ptr::null();
+        assert_eq!(
+            hedl_document_share(ptr::null_mut(), &mut shared),
+            HEDL_ERR_NULL_PTR
+        );
+
+        let doc = parse(INPUT);
+        assert_eq!(hedl_document_share(doc, ptr::null_mut()), HEDL_ERR_NULL_PTR);
+        // Still owned by the caller
+        hedl_free_document(doc);
+
+        hedl_document_retain(ptr::null());
+        hedl_document_release(ptr::null());
+    }
+}
+
+// =============================================================================
+// Multi-format Export
+// =============================================================================
+
+#[test]
+fn test_export_multi_matches_single_exports() {
+    let doc = parse(INPUT);
+    let mut formats = vec![HEDL_FORMAT_HEDL, HEDL_FORMAT_HEDL];
+    if cfg!(feature = "json") {
+        formats.push(HEDL_FORMAT_JSON);
+    }
+    if cfg!(feature = "neo4j") {
+        formats.push(HEDL_FORMAT_CYPHER);
+    }
+    let n = formats.len();
+
+    let mut data = vec![ptr::null_mut::<u8>(); n];
+    let mut lens = vec![0usize; n];
+    let mut codes = vec![-100 as c_int; n];
+    let mut errors = vec![ptr::null_mut::<c_char>(); n];
+    unsafe {
+        let code = hedl_export_multi(
+            doc,
+            formats.as_ptr(),
+            n,
+            0,
+            data.as_mut_ptr(),
+            lens.as_mut_ptr(),
+            codes.as_mut_ptr(),
+            errors.as_mut_ptr(),
+        );
+        assert_eq!(code, HEDL_OK);
+
+        let expected = canonical(doc);
+        for i in 0..n {
+            assert_eq!(codes[i], HEDL_OK);
+            assert!(errors[i].is_null());
+            let text = std::str::from_utf8(slice::from_raw_parts(data[i], lens[i])).unwrap();
+            if formats[i] == HEDL_FORMAT_HEDL {
+                assert_eq!(text, expected);
+            } else {
+                assert!(text.contains("Alice"), "{}", text);
+            }
+            hedl_free_bytes(data[i], lens[i]);
+        }
+        hedl_free_document(doc);
+    }
+}
+
+#[test]
+fn test_export_multi_unknown_format() {
+    let doc = parse(INPUT);
+    let formats = [HEDL_FORMAT_HEDL, 99];
+    let mut data = [ptr::null_mut::<u8>(); 2];
+    let mut lens = [0usize; 2];
+    let mut codes = [0 as c_int; 2];
+    let mut errors = [ptr::null_mut::<c_char>(); 2];
+    unsafe {
+        let code = hedl_export_multi(
+            doc,
+            formats.as_ptr(),
+            2,
+            0,
+            data.as_mut_ptr(),
+            lens.as_mut_ptr(),
+            codes.as_mut_ptr(),
+            errors.as_mut_ptr(),
+        );
+        assert_eq!(code, HEDL_ERR_NOT_FOUND);
+        assert_eq!(codes, [HEDL_OK, HEDL_ERR_NOT_FOUND]);
+        assert!(data[1].is_null());
+        assert_eq!(lens[1], 0);
+        let msg = CStr::from_ptr(errors[1]).to_str().unwrap();
+        assert!(msg.contains("99"), "{}", msg);
+
+        hedl_free_string(errors[1]);
+        hedl_free_bytes(data[0], lens[0]);
+        hedl_free_document(doc);
+    }
+}
+
+#[test]
+fn test_export_multi_null_pointers() {
+    let doc = parse(INPUT);
+    let formats = [HEDL_FORMAT_HEDL];
+    let mut data = [ptr::null_mut::<u8>(); 1];
+    let mut lens = [0usize; 1];
+    let mut codes = [0 as c_int; 1];
+    unsafe {
+        let code = hedl_export_multi(
+            ptr::null(),
+            formats.as_ptr(),
+            1,
+            0,
+            data.as_mut_ptr(),
+            lens.as_mut_ptr(),
+            codes.as_mut_ptr(),
+            ptr::null_mut(),
+        );
+        assert_eq!(code, HEDL_ERR_NULL_PTR);
+        let code = hedl_export_multi(
+            doc,
+            formats.as_ptr(),
+            1,
+            0,
+            data.as_mut_ptr(),
+            lens.as_mut_ptr(),
+            ptr::null_mut(),
+            ptr::null_mut(),
+        );
+        assert_eq!(code, HEDL_ERR_NULL_PTR);
+        // Nothing to export
+        assert_eq!(
+            hedl_export_multi(
+                doc,
+                ptr::null(),
+                0,
+                0,
+                ptr::null_mut(),
+                ptr::null_mut(),
+                ptr::null_mut(),
+                ptr::null_mut()
+            ),
+            HEDL_OK
+        );
+        hedl_free_document(doc);
+    }
+}
@@ -0,0 +1,144 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Tests for binary snapshots (hedl_to_snapshot, hedl_load_snapshot, ...)
+
+use hedl_ffi::*;
+use std::ffi::{CStr, CString};
+use std::os::raw::c_char;
+use std::ptr;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+const DOC: &str = "%VERSION: 1.0\n%STRUCT: Team: [id, name]\n%STRUCT: User: [id, name, team]\n%NEST: Team > User\n---\nname: Reference\nteams: @Team\n  | t1, Platform\n    | u1, Alice, @Team:t1\n  | t2, Data\n";
+
+fn parse(input: &str) -> *mut HedlDocument {
+    let mut doc: *mut HedlDocument = ptr::null_mut();
+    let rc = unsafe { hedl_parse_sized(input.as_ptr() as *const c_char, input.len(), 1, 0, &mut doc) };
+    assert_eq!(rc, HEDL_OK);
+    doc
+}
+
+fn canonical(doc: *const HedlDocument) -> String {
+    unsafe {
+        let mut out: *mut c_char = ptr::null_mut();
+        assert_eq!(hedl_canonicalize(doc, &mut out), HEDL_OK);
+        let text = CStr::from_ptr(out).to_str().unwrap().to_string();
+        hedl_free_string(out);
+        text
+    }
+}
+
+fn temp_path(name: &str) -> CString {
+    let path = std::env::temp_dir().join(format!("hedl_ffi_{}_{}", std::process::id(), name));
+    CString::new(path.to_str().unwrap()).unwrap()
+}
+
+// =============================================================================
+// Round Trips
+// =============================================================================
+
+#[test]
+fn test_snapshot_buffer_round_trip() {
+    let doc = parse(DOC);
+    unsafe {
+        let mut data: *mut u8 = ptr::null_mut();
+        let mut len = 0usize;
+        assert_eq!(hedl_to_snapshot(doc, &mut data, &mut len), HEDL_OK);
+        assert!(len > 64);
+
+        let mut loaded: *mut HedlDocument = ptr::null_mut();
+        assert_eq!(hedl_from_snapshot(data, len, &mut loaded), HEDL_OK);
+        assert_eq!(canonical(loaded), canonical(doc));
+        assert_eq!(hedl_root_item_count(loaded), 2);
+
+        hedl_free_document(loaded);
+        hedl_free_bytes(data, len);
+        hedl_free_document(doc);
+    }
+}
+
+#[test]
+fn test_snapshot_file_round_trip() {
+    let doc = parse(DOC);
+    let path = temp_path("snapshot_round_trip.hedlsnap");
+    unsafe {
+        assert_eq!(hedl_save_snapshot(doc, path.as_ptr()), HEDL_OK);
+
+        let mut loaded: *mut HedlDocument = ptr::null_mut();
+        assert_eq!(hedl_load_snapshot(path.as_ptr(), &mut loaded), HEDL_OK);
+        assert_eq!(canonical(loaded), canonical(doc));
+
+        hedl_free_document(loaded);
+        hedl_free_document(doc);
+    }
+    let _ = std::fs::remove_file(path.to_str().unwrap());
+}
+
+// =============================================================================
+// Errors
+// =============================================================================
+
+#[test]
+fn test_snapshot_rejects_invalid_input() {
+    let doc = parse(DOC);
+    unsafe {
+        let mut data: *mut u8 = ptr::null_mut();
+        let mut len = 0usize;
+        assert_eq!(hedl_to_snapshot(doc, &mut data, &mut len), HEDL_OK);
+
+        let mut loaded: *mut HedlDocument = ptr::null_mut();
+        assert_eq!(
+            hedl_from_snapshot(data, len - 8, &mut loaded),
+            HEDL_ERR_SNAPSHOT
+        );
+        assert!(loaded.is_null());
+        let msg = CStr::from_ptr(hedl_get_last_error()).to_str().unwrap();
+        assert!(msg.starts_with("Invalid snapshot"), "{}", msg);
+
+        // HEDL text is not a snapshot
+        assert_eq!(
+            hedl_from_snapshot(DOC.as_ptr(), DOC.len(), &mut loaded),
+            HEDL_ERR_SNAPSHOT
+        );
+        hedl_free_bytes(data, len);
+
+        let missing = temp_path("snapshot_missing.hedlsnap");
+        assert_eq!(
+            hedl_load_snapshot(missing.as_ptr(), &mut loaded),
+            HEDL_ERR_IO
+        );
+
+        assert_eq!(
+            hedl_to_snapshot(ptr::null(), &mut data, &mut len),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(hedl_save_snapshot(doc, ptr::null()), HEDL_ERR_NULL_PTR);
+        assert_eq!(
+            hedl_from_snapshot(ptr::null(), 0, &mut loaded),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(
+            hedl_load_snapshot(ptr::null(), &mut loaded),
+            HEDL_ERR_NULL_PTR
+        );
+
+        hedl_free_document(doc);
+    }
+}
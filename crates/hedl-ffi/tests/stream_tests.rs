@@ -0,0 +1,365 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Tests for the pull-based streaming parser API
+
+use hedl_ffi::*;
+use std::ffi::CStr;
+use std::os::raw::{c_char, c_int, c_void};
+use std::ptr;
+use std::slice;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+const MATRIX_DOC: &str = concat!(
+    "%VERSION: 1.0\n",
+    "%STRUCT: User: [id, name, age]\n",
+    "%STRUCT: Order: [id, amount]\n",
+    "%NEST: User > Order\n",
+    "---\n",
+    "title: Export\n",
+    "users: @User\n",
+    "  | alice, Alice, 30\n",
+    "    | o1, 9.5\n",
+    "  | bob, \"Bob\", 25\n",
+);
+
+/// Reader context that hands out input in small fixed-size pieces
+struct ChunkedInput {
+    data: Vec<u8>,
+    pos: usize,
+    chunk: usize,
+    calls: usize,
+}
+
+unsafe extern "C" fn chunked_read(buf: *mut c_char, cap: usize, user_data: *mut c_void) -> isize {
+    let input = &mut *(user_data as *mut ChunkedInput);
+    input.calls += 1;
+    let n = cap.min(input.chunk).min(input.data.len() - input.pos);
+    ptr::copy_nonoverlapping(input.data[input.pos..].as_ptr(), buf as *mut u8, n);
+    input.pos += n;
+    n as isize
+}
+
+unsafe extern "C" fn failing_read(
+    _buf: *mut c_char,
+    _cap: usize,
+    _user_data: *mut c_void,
+) -> isize {
+    -1
+}
+
+unsafe fn borrowed(ptr: *const c_char, len: usize) -> String {
+    String::from_utf8(slice::from_raw_parts(ptr as *const u8, len).to_vec()).unwrap()
+}
+
+unsafe fn last_error() -> String {
+    let err = hedl_get_last_error();
+    if err.is_null() {
+        String::new()
+    } else {
+        CStr::from_ptr(err).to_string_lossy().into_owned()
+    }
+}
+
+/// Drain a stream into a compact textual trace of its events
+unsafe fn collect_events(stream: *mut HedlStream) -> Vec<String> {
+    let mut events = Vec::new();
+    loop {
+        let mut kind: c_int = -1;
+        let result = hedl_stream_next(stream, &mut kind);
+        assert_eq!(result, HEDL_OK, "stream error: {}", last_error());
+
+        let mut s: *const c_char = ptr::null();
+        let mut len: usize = 0;
+        match kind {
+            HEDL_EVENT_END => break,
+            HEDL_EVENT_LIST_START => {
+                hedl_stream_event_type_name(stream, &mut s, &mut len);
+                events.push(format!(
+                    "list:{}:{}",
+                    borrowed(s, len),
+                    hedl_stream_event_field_count(stream)
+                ));
+            }
+            HEDL_EVENT_NODE => {
+                hedl_stream_event_id(stream, &mut s, &mut len);
+                events.push(format!(
+                    "node:{}:{}",
+                    borrowed(s, len),
+                    hedl_stream_event_depth(stream)
+                ));
+            }
+            HEDL_EVENT_LIST_END => {
+                events.push(format!("end:{}", hedl_stream_event_row_count(stream)));
+            }
+            HEDL_EVENT_SCALAR => {
+                hedl_stream_event_key(stream, &mut s, &mut len);
+                events.push(format!("scalar:{}", borrowed(s, len)));
+            }
+            other => events.push(format!("other:{}", other)),
+        }
+    }
+    events
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+#[test]
+fn test_stream_buffer_events() {
+    unsafe {
+        let mut stream: *mut HedlStream = ptr::null_mut();
+        let result = hedl_stream_open_buffer(
+            MATRIX_DOC.as_ptr() as *const c_char,
+            MATRIX_DOC.len(),
+            &mut stream,
+        );
+        assert_eq!(result, HEDL_OK);
+        assert!(!stream.is_null());
+
+        let events = collect_events(stream);
+        assert_eq!(events[0], "scalar:title");
+        assert_eq!(events[1], "list:User:3");
+        assert_eq!(events[2], "node:alice:1");
+        assert_eq!(events[3], "node:o1:2");
+        assert!(events.contains(&"node:bob:1".to_string()));
+
+        hedl_stream_close(stream);
+    }
+}
+
+#[test]
+fn test_stream_header_accessors() {
+    unsafe {
+        let mut stream: *mut HedlStream = ptr::null_mut();
+        hedl_stream_open_buffer(
+            MATRIX_DOC.as_ptr() as *const c_char,
+            MATRIX_DOC.len(),
+            &mut stream,
+        );
+
+        let (mut major, mut minor) = (0, 0);
+        assert_eq!(hedl_stream_version(stream, &mut major, &mut minor), HEDL_OK);
+        assert_eq!((major, minor), (1, 0));
+        assert_eq!(hedl_stream_struct_count(stream), 2);
+
+        let mut name: *const c_char = ptr::null();
+        let mut name_len: usize = 0;
+        let mut columns: usize = 0;
+        assert_eq!(
+            hedl_stream_struct_get(stream, 1, &mut name, &mut name_len, &mut columns),
+            HEDL_OK
+        );
+        assert_eq!(borrowed(name, name_len), "User");
+        assert_eq!(columns, 3);
+
+        assert_eq!(
+            hedl_stream_struct_get(stream, 2, &mut name, &mut name_len, ptr::null_mut()),
+            HEDL_ERR_NOT_FOUND
+        );
+
+        hedl_stream_close(stream);
+    }
+}
+
+#[test]
+fn test_stream_field_values() {
+    unsafe {
+        let mut stream: *mut HedlStream = ptr::null_mut();
+        hedl_stream_open_buffer(
+            MATRIX_DOC.as_ptr() as *const c_char,
+            MATRIX_DOC.len(),
+            &mut stream,
+        );
+
+        let mut kind: c_int = -1;
+        let mut view: HedlValueView = std::mem::zeroed();
+
+        // title: Export
+        hedl_stream_next(stream, &mut kind);
+        assert_eq!(kind, HEDL_EVENT_SCALAR);
+        assert_eq!(hedl_stream_event_value(stream, 0, &mut view), HEDL_OK);
+        assert_eq!(view.kind, HEDL_VALUE_STRING);
+        assert_eq!(borrowed(view.str_ptr, view.str_len), "Export");
+        assert_eq!(
+            hedl_stream_event_value(stream, 1, &mut view),
+            HEDL_ERR_NOT_FOUND
+        );
+
+        // users: @User
+        hedl_stream_next(stream, &mut kind);
+        assert_eq!(kind, HEDL_EVENT_LIST_START);
+        let mut col: *const c_char = ptr::null();
+        let mut col_len: usize = 0;
+        assert_eq!(
+            hedl_stream_event_column(stream, 2, &mut col, &mut col_len),
+            HEDL_OK
+        );
+        assert_eq!(borrowed(col, col_len), "age");
+
+        // | alice, Alice, 30
+        hedl_stream_next(stream, &mut kind);
+        assert_eq!(kind, HEDL_EVENT_NODE);
+        assert_eq!(hedl_stream_event_value(stream, 2, &mut view), HEDL_OK);
+        assert_eq!(view.kind, HEDL_VALUE_INT);
+        assert_eq!(view.int_value, 30);
+
+        // | o1, 9.5 (nested under alice)
+        hedl_stream_next(stream, &mut kind);
+        assert_eq!(kind, HEDL_EVENT_NODE);
+        assert_eq!(hedl_stream_event_value(stream, 1, &mut view), HEDL_OK);
+        assert_eq!(view.kind, HEDL_VALUE_FLOAT);
+        assert_eq!(view.float_value, 9.5);
+
+        let mut ptype: *const c_char = ptr::null();
+        let mut pid: *const c_char = ptr::null();
+        let (mut ptype_len, mut pid_len) = (0usize, 0usize);
+        assert_eq!(
+            hedl_stream_event_parent(stream, &mut ptype, &mut ptype_len, &mut pid, &mut pid_len),
+            HEDL_OK
+        );
+        assert_eq!(borrowed(ptype, ptype_len), "User");
+        assert_eq!(borrowed(pid, pid_len), "alice");
+
+        hedl_stream_close(stream);
+    }
+}
+
+#[test]
+fn test_stream_callback_small_chunks() {
+    unsafe {
+        let mut input = ChunkedInput {
+            data: MATRIX_DOC.as_bytes().to_vec(),
+            pos: 0,
+            chunk: 7,
+            calls: 0,
+        };
+
+        let mut stream: *mut HedlStream = ptr::null_mut();
+        let result = hedl_stream_open(
+            Some(chunked_read),
+            &mut input as *mut ChunkedInput as *mut c_void,
+            &mut stream,
+        );
+        assert_eq!(result, HEDL_OK);
+
+        let events = collect_events(stream);
+        assert!(events.contains(&"node:bob:1".to_string()));
+        assert!(input.calls > MATRIX_DOC.len() / 7);
+
+        hedl_stream_close(stream);
+    }
+}
+
+#[test]
+fn test_stream_end_is_sticky() {
+    unsafe {
+        let doc = "%VERSION: 1.0\n---\nkey: value\n";
+        let mut stream: *mut HedlStream = ptr::null_mut();
+        hedl_stream_open_buffer(doc.as_ptr() as *const c_char, doc.len(), &mut stream);
+
+        let events = collect_events(stream);
+        assert_eq!(events, vec!["scalar:key".to_string()]);
+
+        let mut kind: c_int = -1;
+        assert_eq!(hedl_stream_next(stream, &mut kind), HEDL_OK);
+        assert_eq!(kind, HEDL_EVENT_END);
+
+        let mut s: *const c_char = ptr::null();
+        assert_eq!(
+            hedl_stream_event_key(stream, &mut s, ptr::null_mut()),
+            HEDL_ERR_NOT_FOUND
+        );
+        assert_eq!(hedl_stream_event_line(stream), -1);
+
+        hedl_stream_close(stream);
+    }
+}
+
+#[test]
+fn test_stream_missing_version() {
+    unsafe {
+        let doc = "---\nkey: value\n";
+        let mut stream: *mut HedlStream = ptr::null_mut();
+        let result = hedl_stream_open_buffer(doc.as_ptr() as *const c_char, doc.len(), &mut stream);
+        assert_eq!(result, HEDL_ERR_PARSE);
+        assert!(stream.is_null());
+
+        assert!(last_error().contains("VERSION"));
+    }
+}
+
+#[test]
+fn test_stream_body_error() {
+    unsafe {
+        let doc = "%VERSION: 1.0\n---\nusers: @Missing\n";
+        let mut stream: *mut HedlStream = ptr::null_mut();
+        assert_eq!(
+            hedl_stream_open_buffer(doc.as_ptr() as *const c_char, doc.len(), &mut stream),
+            HEDL_OK
+        );
+
+        let mut kind: c_int = -1;
+        assert_eq!(hedl_stream_next(stream, &mut kind), HEDL_ERR_PARSE);
+        assert!(!hedl_get_last_error().is_null());
+
+        // The stream is finished after an error.
+        assert_eq!(hedl_stream_next(stream, &mut kind), HEDL_OK);
+        assert_eq!(kind, HEDL_EVENT_END);
+
+        hedl_stream_close(stream);
+    }
+}
+
+#[test]
+fn test_stream_read_callback_error() {
+    unsafe {
+        let mut stream: *mut HedlStream = ptr::null_mut();
+        let result = hedl_stream_open(Some(failing_read), ptr::null_mut(), &mut stream);
+        assert_eq!(result, HEDL_ERR_IO);
+        assert!(stream.is_null());
+    }
+}
+
+#[test]
+fn test_stream_null_pointers() {
+    unsafe {
+        let mut stream: *mut HedlStream = ptr::null_mut();
+        assert_eq!(
+            hedl_stream_open(None, ptr::null_mut(), &mut stream),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(
+            hedl_stream_open_buffer(ptr::null(), 0, &mut stream),
+            HEDL_ERR_NULL_PTR
+        );
+
+        let mut kind: c_int = 0;
+        assert_eq!(
+            hedl_stream_next(ptr::null_mut(), &mut kind),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(hedl_stream_struct_count(ptr::null()), -1);
+
+        // Closing NULL is a no-op
+        hedl_stream_close(ptr::null_mut());
+    }
+}
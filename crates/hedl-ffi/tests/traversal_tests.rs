@@ -0,0 +1,441 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Tests for the read-only document traversal API
+
+use hedl_ffi::*;
+use std::os::raw::{c_char, c_int};
+use std::ptr;
+use std::slice;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+const DOC: &str = concat!(
+    "%VERSION: 1.0\n",
+    "%STRUCT: User: [id, name, age, active, manager]\n",
+    "%STRUCT: Order: [id, amount]\n",
+    "%NEST: User > Order\n",
+    "---\n",
+    "title: Export\n",
+    "users: @User\n",
+    "  | alice, Alice, 30, true, ~\n",
+    "    | o1, 9.5\n",
+    "    | o2, 12\n",
+    "  | bob, Bob, 25, false, @User:alice\n",
+    "meta:\n",
+    "  owner: Zoë\n",
+    "  revision: 3\n",
+);
+
+unsafe fn parse(input: &str) -> *mut HedlDocument {
+    let mut doc: *mut HedlDocument = ptr::null_mut();
+    let rc = hedl_parse_sized(input.as_ptr() as *const c_char, input.len(), 1, 0, &mut doc);
+    assert_eq!(rc, HEDL_OK);
+    doc
+}
+
+unsafe fn view_str<'a>(ptr: *const c_char, len: usize) -> &'a str {
+    std::str::from_utf8(slice::from_raw_parts(ptr as *const u8, len)).unwrap()
+}
+
+unsafe fn get(obj: *const HedlObject, key: &str) -> *const HedlItem {
+    let mut item: *const HedlItem = ptr::null();
+    assert_eq!(
+        hedl_object_get(obj, key.as_ptr() as *const c_char, key.len(), &mut item),
+        HEDL_OK
+    );
+    item
+}
+
+unsafe fn users(doc: *const HedlDocument) -> *const HedlList {
+    let list = hedl_item_list(get(hedl_document_root(doc), "users"));
+    assert!(!list.is_null());
+    list
+}
+
+/// Collect the keys of an object through the key cursor.
+unsafe fn keys(obj: *const HedlObject) -> Vec<String> {
+    let mut out = Vec::new();
+    let (mut key, mut len): (*const c_char, usize) = (ptr::null(), 0);
+    let mut item: *const HedlItem = ptr::null();
+    while hedl_object_next(obj, key, len, &mut key, &mut len, &mut item) == HEDL_OK {
+        out.push(view_str(key, len).to_string());
+    }
+    out
+}
+
+// =============================================================================
+// Objects and Items
+// =============================================================================
+
+#[test]
+fn test_object_cursor_and_lookup() {
+    unsafe {
+        let doc = parse(DOC);
+        let root = hedl_document_root(doc);
+
+        assert_eq!(hedl_object_len(root), 3);
+        assert_eq!(keys(root), vec!["meta", "title", "users"]);
+
+        let mut item: *const HedlItem = ptr::null();
+        assert_eq!(
+            hedl_object_get(root, b"nope".as_ptr() as *const c_char, 4, &mut item),
+            HEDL_ERR_NOT_FOUND
+        );
+
+        let meta = hedl_item_object(get(root, "meta"));
+        assert_eq!(hedl_item_kind(get(root, "meta")), HEDL_ITEM_OBJECT);
+        assert_eq!(keys(meta), vec!["owner", "revision"]);
+
+        hedl_free_document(doc);
+    }
+}
+
+#[test]
+fn test_scalar_items() {
+    unsafe {
+        let doc = parse(DOC);
+        let root = hedl_document_root(doc);
+        let mut view: HedlValueView = std::mem::zeroed();
+
+        let title = get(root, "title");
+        assert_eq!(hedl_item_kind(title), HEDL_ITEM_SCALAR);
+        assert_eq!(hedl_item_value(title, &mut view), HEDL_OK);
+        assert_eq!(view.kind, HEDL_VALUE_STRING);
+        assert_eq!(view_str(view.str_ptr, view.str_len), "Export");
+
+        let owner = get(hedl_item_object(get(root, "meta")), "owner");
+        assert_eq!(hedl_item_value(owner, &mut view), HEDL_OK);
+        assert_eq!(view_str(view.str_ptr, view.str_len), "Zoë");
+
+        // Kind-specific accessors reject other kinds
+        let list = get(root, "users");
+        assert_eq!(hedl_item_kind(list), HEDL_ITEM_LIST);
+        assert_eq!(hedl_item_value(list, &mut view), HEDL_ERR_TYPE_MISMATCH);
+        assert!(hedl_item_object(list).is_null());
+        assert!(hedl_item_list(title).is_null());
+
+        hedl_free_document(doc);
+    }
+}
+
+// =============================================================================
+// Lists and Nodes
+// =============================================================================
+
+#[test]
+fn test_list_schema_and_rows() {
+    unsafe {
+        let doc = parse(DOC);
+        let list = users(doc);
+        let (mut ptr, mut len): (*const c_char, usize) = (ptr::null(), 0);
+
+        assert_eq!(hedl_list_type_name(list, &mut ptr, &mut len), HEDL_OK);
+        assert_eq!(view_str(ptr, len), "User");
+        assert_eq!(hedl_list_column_count(list), 5);
+        assert_eq!(hedl_list_column(list, 2, &mut ptr, &mut len), HEDL_OK);
+        assert_eq!(view_str(ptr, len), "age");
+        assert_eq!(
+            hedl_list_column(list, 5, &mut ptr, &mut len),
+            HEDL_ERR_NOT_FOUND
+        );
+
+        let mut index = 0usize;
+        assert_eq!(
+            hedl_list_column_index(list, b"active".as_ptr() as *const c_char, 6, &mut index),
+            HEDL_OK
+        );
+        assert_eq!(index, 3);
+
+        assert_eq!(hedl_list_row_count(list), 2);
+        assert!(hedl_list_row(list, 2).is_null());
+
+        let bob = hedl_list_row(list, 1);
+        assert_eq!(hedl_node_id(bob, &mut ptr, &mut len), HEDL_OK);
+        assert_eq!(view_str(ptr, len), "bob");
+        assert_eq!(hedl_node_type_name(bob, &mut ptr, &mut len), HEDL_OK);
+        assert_eq!(view_str(ptr, len), "User");
+        assert_eq!(hedl_node_field_count(bob), 5);
+
+        hedl_free_document(doc);
+    }
+}
+
+#[test]
+fn test_typed_field_getters() {
+    unsafe {
+        let doc = parse(DOC);
+        let list = users(doc);
+        let alice = hedl_list_row(list, 0);
+        let bob = hedl_list_row(list, 1);
+        let (mut ptr, mut len): (*const c_char, usize) = (ptr::null(), 0);
+
+        assert_eq!(
+            hedl_node_field_string(alice, 1, &mut ptr, &mut len),
+            HEDL_OK
+        );
+        assert_eq!(view_str(ptr, len), "Alice");
+
+        let mut n = 0i64;
+        assert_eq!(hedl_node_field_int(alice, 2, &mut n), HEDL_OK);
+        assert_eq!(n, 30);
+        assert_eq!(
+            hedl_node_field_int(alice, 1, &mut n),
+            HEDL_ERR_TYPE_MISMATCH
+        );
+        assert_eq!(hedl_node_field_int(alice, 9, &mut n), HEDL_ERR_NOT_FOUND);
+
+        let mut f = 0.0f64;
+        assert_eq!(hedl_node_field_float(alice, 2, &mut f), HEDL_OK);
+        assert_eq!(f, 30.0);
+
+        let mut b: c_int = -1;
+        assert_eq!(hedl_node_field_bool(alice, 3, &mut b), HEDL_OK);
+        assert_eq!(b, 1);
+        assert_eq!(hedl_node_field_bool(bob, 3, &mut b), HEDL_OK);
+        assert_eq!(b, 0);
+
+        let (mut t, mut t_len): (*const c_char, usize) = (ptr::null(), 0);
+        assert_eq!(
+            hedl_node_field_reference(bob, 4, &mut t, &mut t_len, &mut ptr, &mut len),
+            HEDL_OK
+        );
+        assert_eq!(view_str(t, t_len), "User");
+        assert_eq!(view_str(ptr, len), "alice");
+
+        // Null matches no typed getter but is visible through the view
+        assert_eq!(
+            hedl_node_field_reference(alice, 4, &mut t, &mut t_len, &mut ptr, &mut len),
+            HEDL_ERR_TYPE_MISMATCH
+        );
+        let mut view: HedlValueView = std::mem::zeroed();
+        assert_eq!(hedl_node_field(alice, 4, &mut view), HEDL_OK);
+        assert_eq!(view.kind, HEDL_VALUE_NULL);
+
+        hedl_free_document(doc);
+    }
+}
+
+#[test]
+fn test_node_children() {
+    unsafe {
+        let doc = parse(DOC);
+        let list = users(doc);
+        let alice = hedl_list_row(list, 0);
+        let bob = hedl_list_row(list, 1);
+
+        assert_eq!(hedl_node_child_group_count(alice), 1);
+        assert_eq!(hedl_node_child_group_count(bob), 0);
+
+        let (mut ty, mut ty_len): (*const c_char, usize) = (ptr::null(), 0);
+        let mut count = 0usize;
+        assert_eq!(
+            hedl_node_children_next(alice, ptr::null(), 0, &mut ty, &mut ty_len, &mut count),
+            HEDL_OK
+        );
+        assert_eq!(view_str(ty, ty_len), "Order");
+        assert_eq!(count, 2);
+        assert_eq!(
+            hedl_node_children_next(alice, ty, ty_len, &mut ty, &mut ty_len, &mut count),
+            HEDL_ERR_NOT_FOUND
+        );
+
+        let o2 = hedl_node_child(alice, b"Order".as_ptr() as *const c_char, 5, 1);
+        let mut f = 0.0f64;
+        assert_eq!(hedl_node_field_float(o2, 1, &mut f), HEDL_OK);
+        assert_eq!(f, 12.0);
+        assert!(hedl_node_child(alice, b"Order".as_ptr() as *const c_char, 5, 2).is_null());
+
+        hedl_free_document(doc);
+    }
+}
+
+#[test]
+fn test_null_handles() {
+    unsafe {
+        assert!(hedl_document_root(ptr::null()).is_null());
+        assert_eq!(hedl_object_len(ptr::null()), 0);
+        assert_eq!(hedl_item_kind(ptr::null()), -1);
+        assert_eq!(hedl_list_row_count(ptr::null()), 0);
+        assert!(hedl_list_row(ptr::null(), 0).is_null());
+        assert_eq!(hedl_node_field_count(ptr::null()), 0);
+
+        let mut n = 0i64;
+        assert_eq!(
+            hedl_node_field_int(ptr::null(), 0, &mut n),
+            HEDL_ERR_NULL_PTR
+        );
+
+        let doc = parse(DOC);
+        let mut item: *const HedlItem = ptr::null();
+        assert_eq!(
+            hedl_object_get(hedl_document_root(doc), ptr::null(), 0, &mut item),
+            HEDL_ERR_NULL_PTR
+        );
+        hedl_free_document(doc);
+    }
+}
+
+unsafe fn find(doc: *const HedlDocument, type_name: &str, id: &str) -> Option<*const HedlNode> {
+    let mut node: *const HedlNode = ptr::null();
+    let rc = hedl_find_node(
+        doc,
+        type_name.as_ptr() as *const c_char,
+        type_name.len(),
+        id.as_ptr() as *const c_char,
+        id.len(),
+        &mut node,
+    );
+    match rc {
+        HEDL_OK => Some(node),
+        HEDL_ERR_NOT_FOUND => None,
+        other => panic!("hedl_find_node returned {}", other),
+    }
+}
+
+unsafe fn node_id<'a>(node: *const HedlNode) -> &'a str {
+    let (mut id, mut len): (*const c_char, usize) = (ptr::null(), 0);
+    assert_eq!(hedl_node_id(node, &mut id, &mut len), HEDL_OK);
+    view_str(id, len)
+}
+
+#[test]
+fn test_find_node() {
+    unsafe {
+        let doc = parse(DOC);
+        let list = users(doc);
+
+        assert_eq!(find(doc, "User", "bob"), Some(hedl_list_row(list, 1)));
+        let alice = hedl_list_row(list, 0);
+        let o2 = hedl_node_child(alice, b"Order".as_ptr() as *const c_char, 5, 1);
+        assert_eq!(find(doc, "Order", "o2"), Some(o2));
+        assert_eq!(find(doc, "User", "o2"), None);
+        assert_eq!(find(doc, "Nope", "alice"), None);
+
+        let mut node: *const HedlNode = ptr::null();
+        assert_eq!(
+            hedl_find_node(doc, ptr::null(), 0, b"a".as_ptr() as *const c_char, 1, &mut node),
+            HEDL_ERR_NULL_PTR
+        );
+        assert_eq!(
+            hedl_find_node(ptr::null(), ptr::null(), 0, ptr::null(), 0, &mut node),
+            HEDL_ERR_NULL_PTR
+        );
+
+        hedl_free_document(doc);
+    }
+}
+
+#[test]
+fn test_resolve_reference() {
+    unsafe {
+        let input = concat!(
+            "%VERSION: 1.0\n",
+            "%STRUCT: User: [id, name, manager]\n",
+            "%STRUCT: Team: [id, lead]\n",
+            "---\n",
+            "owner: @t1\n",
+            "users: @User\n",
+            "  | alice, Alice, ~\n",
+            "  | bob, Bob, @alice\n",
+            "teams: @Team\n",
+            "  | t1, @User:bob\n",
+            "  | alice, @User:alice\n",
+        );
+        let doc = parse(input);
+        let bob = find(doc, "User", "bob").unwrap();
+        let t1 = find(doc, "Team", "t1").unwrap();
+        let mut view: HedlValueView = std::mem::zeroed();
+        let mut target: *const HedlNode = ptr::null();
+
+        // Unqualified reference in a row: scoped to the row's type
+        assert_eq!(hedl_node_field(bob, 2, &mut view), HEDL_OK);
+        assert_eq!(hedl_resolve_reference(doc, &view, bob, &mut target), HEDL_OK);
+        assert_eq!(target, find(doc, "User", "alice").unwrap());
+        // Without a context the same ID is ambiguous (User and Team define it)
+        assert_eq!(
+            hedl_resolve_reference(doc, &view, ptr::null(), &mut target),
+            HEDL_ERR_NOT_FOUND
+        );
+
+        // Qualified reference
+        assert_eq!(hedl_node_field(t1, 1, &mut view), HEDL_OK);
+        assert_eq!(hedl_resolve_reference(doc, &view, t1, &mut target), HEDL_OK);
+        assert_eq!(target, bob);
+
+        // Key-value reference
+        assert_eq!(hedl_item_value(get(hedl_document_root(doc), "owner"), &mut view), HEDL_OK);
+        assert_eq!(
+            hedl_resolve_reference(doc, &view, ptr::null(), &mut target),
+            HEDL_OK
+        );
+        assert_eq!(target, t1);
+
+        // Not a reference
+        assert_eq!(hedl_node_field(bob, 1, &mut view), HEDL_OK);
+        assert_eq!(
+            hedl_resolve_reference(doc, &view, bob, &mut target),
+            HEDL_ERR_TYPE_MISMATCH
+        );
+
+        hedl_free_document(doc);
+    }
+}
+
+#[test]
+fn test_node_index_follows_document_lifetime() {
+    unsafe {
+        // Freed documents drop their index, so a new document that lands at
+        // the same address is indexed afresh
+        for i in 0..20 {
+            let input = format!(
+                "%VERSION: 1.0\n%STRUCT: Row: [id, n]\n---\nrows: @Row\n  | r{}, {}\n",
+                i, i
+            );
+            let doc = parse(&input);
+            let node = find(doc, "Row", &format!("r{}", i)).unwrap();
+            let mut n = 0i64;
+            assert_eq!(hedl_node_field_int(node, 1, &mut n), HEDL_OK);
+            assert_eq!(n, i);
+            if i > 0 {
+                assert_eq!(find(doc, "Row", &format!("r{}", i - 1)), None);
+            }
+            hedl_free_document(doc);
+        }
+
+        // Incremental edits rebuild the index of the edited document
+        let input = "%VERSION: 1.0\n%STRUCT: Row: [id, n]\n---\nrows: @Row\n  | a, 1\n";
+        let mut inc: *mut HedlIncremental = ptr::null_mut();
+        assert_eq!(
+            hedl_incremental_open(input.as_ptr() as *const c_char, input.len(), 1, &mut inc),
+            HEDL_OK
+        );
+        let doc = hedl_incremental_document(inc);
+        assert!(find(doc, "Row", "a").is_some());
+        let edit = "  | b, 2";
+        assert_eq!(
+            hedl_incremental_apply_edit(inc, 4, 5, edit.as_ptr() as *const c_char, edit.len()),
+            HEDL_OK
+        );
+        let doc = hedl_incremental_document(inc);
+        assert_eq!(find(doc, "Row", "a"), None);
+        assert_eq!(node_id(find(doc, "Row", "b").unwrap()), "b");
+        hedl_incremental_close(inc);
+    }
+}
@@ -1000,7 +1000,7 @@ fn json_array_to_matrix_list(
     })
 }
 
-fn json_to_value(value: &JsonValue, config: &FromJsonConfig) -> Result<Value, JsonConversionError> {
+pub(crate) fn json_to_value(value: &JsonValue, config: &FromJsonConfig) -> Result<Value, JsonConversionError> {
     Ok(match value {
         JsonValue::Null => Value::Null,
         JsonValue::Bool(b) => Value::Bool(*b),
@@ -151,7 +151,7 @@ pub use from_json::{
     partial_parse_json, partial_parse_json_value, ErrorTolerance, ErrorLocation,
     ParseError, PartialConfig, PartialConfigBuilder, PartialResult,
 };
-pub use to_json::{to_json, to_json_value, ToJsonConfig};
+pub use to_json::{to_json, to_json_value, to_json_writer, ToJsonConfig};
 
 use hedl_core::Document;
 
@@ -70,9 +70,14 @@
 //! }
 //! ```
 
-use crate::from_json::{from_json_value_owned, FromJsonConfig, JsonConversionError};
-use hedl_core::Document;
-use serde_json::Value as JsonValue;
+use crate::from_json::{
+    from_json_value_owned, json_to_value, FromJsonConfig, JsonConversionError,
+};
+use hedl_core::lex::singularize_and_capitalize;
+use hedl_core::{Document, Item, MatrixList, Node, Value};
+use serde::de::{DeserializeSeed, Deserializer, IgnoredAny, MapAccess, Visitor};
+use serde_json::{Map, Value as JsonValue};
+use std::collections::{BTreeSet, HashMap, HashSet};
 use std::io::{BufRead, BufReader, Read};
 use std::marker::PhantomData;
 
@@ -624,6 +629,564 @@ impl<W: std::io::Write> JsonLinesWriter<W> {
     }
 }
 
+// ==================== Row Import ====================
+
+/// Configuration for [`JsonRowImporter`] and [`import_json_rows`]
+#[derive(Debug, Clone)]
+pub struct RowImportConfig {
+    /// Root key of the imported list (default: `"rows"`)
+    ///
+    /// The row type is derived from it as `from_json` derives list types
+    /// from keys: `"users"` gives `User`.
+    pub key: String,
+
+    /// Rows buffered before the schema is fixed (default: 100)
+    ///
+    /// The schema is the union of the keys of these rows. Later rows may
+    /// omit columns (they become null) but may not add new ones.
+    pub sample_rows: usize,
+
+    /// Read buffer size, per-row size limit and value conversion limits
+    ///
+    /// `from_json.max_array_size` caps the number of rows.
+    pub stream: StreamConfig,
+}
+
+impl Default for RowImportConfig {
+    fn default() -> Self {
+        Self {
+            key: "rows".to_string(),
+            sample_rows: 100,
+            stream: StreamConfig::default(),
+        }
+    }
+}
+
+/// Push-based importer for arrays of homogeneous JSON objects
+///
+/// Builds a document with a single matrix list under `config.key`, one row
+/// per object, from either a top-level JSON array or JSON Lines (objects
+/// separated by whitespace). Input arrives in chunks of any size through
+/// [`feed`](Self::feed); only the objects still needed are held as JSON.
+///
+/// The first `sample_rows` objects are buffered to infer the schema, using
+/// the same rules as `from_json` for an array of objects: columns sorted by
+/// name with `id` first, `__`-prefixed keys and arrays of objects left out.
+/// After that each object is decoded straight into its row's values, so
+/// memory stays at the document being built plus one row of JSON.
+///
+/// Nested arrays of objects are skipped, not imported as child lists;
+/// use `from_json` for hierarchical documents.
+///
+/// # Examples
+///
+/// ```rust
+/// use hedl_json::streaming::{JsonRowImporter, RowImportConfig};
+/// use hedl_core::Item;
+///
+/// let mut importer = JsonRowImporter::new(RowImportConfig::default());
+/// importer.feed(br#"{"id": "a", "n": 1}
+/// {"id": "b", "#).unwrap();
+/// importer.feed(br#""n": 2}"#).unwrap();
+/// let doc = importer.finish().unwrap();
+///
+/// let Some(Item::List(rows)) = doc.root.get("rows") else { panic!() };
+/// assert_eq!(rows.schema, ["id", "n"]);
+/// assert_eq!(rows.rows.len(), 2);
+/// ```
+#[derive(Debug)]
+pub struct JsonRowImporter {
+    framer: RowFramer,
+    builder: RowBuilder,
+}
+
+impl JsonRowImporter {
+    /// Create an importer
+    pub fn new(config: RowImportConfig) -> Self {
+        let max_object_bytes = config.stream.max_object_bytes;
+        Self {
+            framer: RowFramer::new(max_object_bytes),
+            builder: RowBuilder::new(config),
+        }
+    }
+
+    /// Import the rows completed by the next chunk of input
+    ///
+    /// Chunks may split anywhere, including inside strings and multi-byte
+    /// UTF-8 sequences. After an error the importer's state is unspecified
+    /// and it should be dropped.
+    pub fn feed(&mut self, chunk: &[u8]) -> Result<(), StreamError> {
+        let builder = &mut self.builder;
+        self.framer.feed(chunk, |object| builder.push(object))
+    }
+
+    /// Number of objects imported so far, including buffered sample rows
+    pub fn row_count(&self) -> usize {
+        self.builder.rows.len() + self.builder.sample.len()
+    }
+
+    /// Finish the input and return the document
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the input ends inside an object or an array.
+    pub fn finish(self) -> Result<Document, StreamError> {
+        self.framer.finish()?;
+        self.builder.finish()
+    }
+}
+
+/// Import rows from a reader with [`JsonRowImporter`]
+///
+/// # Examples
+///
+/// ```rust
+/// use hedl_json::streaming::{import_json_rows, RowImportConfig};
+/// use std::io::Cursor;
+///
+/// let json = r#"[{"id": "u1", "name": "Alice"}, {"id": "u2", "name": "Bob"}]"#;
+/// let config = RowImportConfig {
+///     key: "users".to_string(),
+///     ..RowImportConfig::default()
+/// };
+/// let doc = import_json_rows(Cursor::new(json), config).unwrap();
+/// assert_eq!(doc.structs["User"], ["id", "name"]);
+/// ```
+pub fn import_json_rows<R: Read>(
+    mut reader: R,
+    config: RowImportConfig,
+) -> Result<Document, StreamError> {
+    let mut buffer = vec![0u8; config.stream.buffer_size.max(1)];
+    let mut importer = JsonRowImporter::new(config);
+    loop {
+        match reader.read(&mut buffer) {
+            Ok(0) => break,
+            Ok(n) => importer.feed(&buffer[..n])?,
+            Err(e) if e.kind() == std::io::ErrorKind::Interrupted => {}
+            Err(e) => return Err(e.into()),
+        }
+    }
+    importer.finish()
+}
+
+/// Top-level framing of the input
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum Framing {
+    /// Nothing but whitespace seen yet
+    Detect,
+    /// Objects separated by whitespace (JSON Lines)
+    Lines,
+    /// Inside a top-level array
+    Array,
+    /// After the closing `]`
+    Closed,
+}
+
+/// Splits a byte stream into its row objects without parsing them
+#[derive(Debug)]
+struct RowFramer {
+    framing: Framing,
+    max_object_bytes: Option<usize>,
+    /// Bytes of an object that began in an earlier chunk
+    pending: Vec<u8>,
+    in_object: bool,
+    depth: usize,
+    in_string: bool,
+    escaped: bool,
+    /// Array framing: an element was just read, so `,` or `]` comes next
+    need_separator: bool,
+    /// Array framing: a `,` was just read, so an element comes next
+    need_element: bool,
+}
+
+impl RowFramer {
+    fn new(max_object_bytes: Option<usize>) -> Self {
+        Self {
+            framing: Framing::Detect,
+            max_object_bytes,
+            pending: Vec::new(),
+            in_object: false,
+            depth: 0,
+            in_string: false,
+            escaped: false,
+            need_separator: false,
+            need_element: false,
+        }
+    }
+
+    fn check_size(&self, len: usize) -> Result<(), StreamError> {
+        match self.max_object_bytes {
+            Some(max) if len > max => Err(StreamError::ObjectTooLarge(len, max)),
+            _ => Ok(()),
+        }
+    }
+
+    /// Scan `chunk`, calling `on_object` with each complete object
+    fn feed<F>(&mut self, chunk: &[u8], mut on_object: F) -> Result<(), StreamError>
+    where
+        F: FnMut(&[u8]) -> Result<(), StreamError>,
+    {
+        // Start of the current object within this chunk
+        let mut start = 0;
+        let mut i = 0;
+        while i < chunk.len() {
+            let b = chunk[i];
+            i += 1;
+
+            if self.in_object {
+                if self.in_string {
+                    match b {
+                        _ if self.escaped => self.escaped = false,
+                        b'\\' => self.escaped = true,
+                        b'"' => self.in_string = false,
+                        _ => {}
+                    }
+                    continue;
+                }
+                match b {
+                    b'"' => self.in_string = true,
+                    b'{' | b'[' => self.depth += 1,
+                    b'}' | b']' => {
+                        self.depth -= 1;
+                        if self.depth == 0 {
+                            self.in_object = false;
+                            self.need_separator = self.framing == Framing::Array;
+                            if self.pending.is_empty() {
+                                self.check_size(i - start)?;
+                                on_object(&chunk[start..i])?;
+                            } else {
+                                self.pending.extend_from_slice(&chunk[start..i]);
+                                self.check_size(self.pending.len())?;
+                                let object = std::mem::take(&mut self.pending);
+                                on_object(&object)?;
+                                self.pending = object;
+                                self.pending.clear();
+                            }
+                        }
+                    }
+                    _ => {}
+                }
+                continue;
+            }
+
+            if b.is_ascii_whitespace() {
+                continue;
+            }
+            match (self.framing, b) {
+                (Framing::Detect, b'[') => self.framing = Framing::Array,
+                (Framing::Detect, _) => {
+                    self.framing = Framing::Lines;
+                    // Read the byte again as the start of a row
+                    i -= 1;
+                }
+                (Framing::Array, b',') if self.need_separator => {
+                    self.need_separator = false;
+                    self.need_element = true;
+                }
+                (Framing::Array, b']') if !self.need_element => {
+                    self.framing = Framing::Closed;
+                }
+                (Framing::Lines | Framing::Array, b'{') if !self.need_separator => {
+                    self.in_object = true;
+                    self.need_element = false;
+                    self.depth = 1;
+                    start = i - 1;
+                }
+                (Framing::Closed, _) => {
+                    return Err(StreamError::Json(serde_json::Error::custom(
+                        "trailing characters after JSON array",
+                    )))
+                }
+                _ => {
+                    return Err(StreamError::Json(serde_json::Error::custom(format!(
+                        "expected a JSON object row, found '{}'",
+                        char::from(b).escape_default()
+                    ))))
+                }
+            }
+        }
+
+        if self.in_object {
+            self.pending.extend_from_slice(&chunk[start..]);
+            self.check_size(self.pending.len())?;
+        }
+        Ok(())
+    }
+
+    fn finish(&self) -> Result<(), StreamError> {
+        if self.in_object {
+            return Err(StreamError::Json(serde_json::Error::custom(
+                "input ends inside a JSON object",
+            )));
+        }
+        if self.framing == Framing::Array {
+            return Err(StreamError::Json(serde_json::Error::custom(
+                "input ends inside a JSON array",
+            )));
+        }
+        Ok(())
+    }
+}
+
+/// Column layout fixed from the sample rows
+#[derive(Debug)]
+struct RowSchema {
+    columns: Vec<String>,
+    index: HashMap<String, usize>,
+    /// Keys left out of the schema because they held arrays of objects
+    skipped: HashSet<String>,
+}
+
+impl RowSchema {
+    /// Infer the schema from sample rows, as `from_json` does for the first
+    /// object of an array
+    fn infer(sample: &[Map<String, JsonValue>]) -> Self {
+        let mut keys = BTreeSet::new();
+        let mut skipped = HashSet::new();
+        let mut explicit = None;
+        for (n, row) in sample.iter().enumerate() {
+            for (key, value) in row {
+                if key == "__hedl_schema" && n == 0 {
+                    if let JsonValue::Array(names) = value {
+                        explicit = Some(
+                            names
+                                .iter()
+                                .filter_map(|v| v.as_str().map(String::from))
+                                .collect::<Vec<_>>(),
+                        );
+                    }
+                } else if key.starts_with("__") {
+                    // Metadata, not a column
+                } else if is_object_array(value) {
+                    skipped.insert(key.clone());
+                } else {
+                    keys.insert(key.clone());
+                }
+            }
+        }
+
+        let mut columns = match explicit {
+            Some(columns) => columns,
+            None => {
+                let mut columns: Vec<String> = keys.into_iter().collect();
+                if let Some(pos) = columns.iter().position(|k| k == "id") {
+                    let id = columns.remove(pos);
+                    columns.insert(0, id);
+                }
+                columns
+            }
+        };
+        if columns.is_empty() {
+            columns = crate::DEFAULT_SCHEMA.iter().map(|s| s.to_string()).collect();
+        }
+        for column in &columns {
+            skipped.remove(column);
+        }
+
+        let index = columns
+            .iter()
+            .enumerate()
+            .map(|(i, c)| (c.clone(), i))
+            .collect();
+        Self {
+            columns,
+            index,
+            skipped,
+        }
+    }
+}
+
+fn is_object_array(value: &JsonValue) -> bool {
+    match value {
+        JsonValue::Array(items) => !items.is_empty() && items.iter().all(JsonValue::is_object),
+        _ => false,
+    }
+}
+
+/// Accumulates rows into the matrix list
+#[derive(Debug)]
+struct RowBuilder {
+    config: RowImportConfig,
+    type_name: String,
+    sample: Vec<Map<String, JsonValue>>,
+    schema: Option<RowSchema>,
+    rows: Vec<Node>,
+}
+
+impl RowBuilder {
+    fn new(config: RowImportConfig) -> Self {
+        Self {
+            type_name: singularize_and_capitalize(&config.key),
+            config,
+            sample: Vec::new(),
+            schema: None,
+            rows: Vec::new(),
+        }
+    }
+
+    fn push(&mut self, object: &[u8]) -> Result<(), StreamError> {
+        let count = self.rows.len() + self.sample.len() + 1;
+        if let Some(max) = self.config.stream.from_json.max_array_size {
+            if count > max {
+                return Err(JsonConversionError::MaxArraySizeExceeded(max, count).into());
+            }
+        }
+
+        let Some(schema) = &self.schema else {
+            self.sample.push(serde_json::from_slice(object)?);
+            if self.sample.len() >= self.config.sample_rows {
+                self.fix_schema()?;
+            }
+            return Ok(());
+        };
+
+        let mut de = serde_json::Deserializer::from_slice(object);
+        let cells = RowSeed { schema }.deserialize(&mut de)?;
+        de.end()?;
+        let node = self.node(cells)?;
+        self.rows.push(node);
+        Ok(())
+    }
+
+    /// Fix the schema from the sample and convert the sample rows
+    fn fix_schema(&mut self) -> Result<(), StreamError> {
+        let schema = RowSchema::infer(&self.sample);
+        let sample = std::mem::take(&mut self.sample);
+        self.rows.reserve(sample.len());
+        for mut row in sample {
+            let cells = schema
+                .columns
+                .iter()
+                .map(|c| row.remove(c).unwrap_or(JsonValue::Null))
+                .collect();
+            let node = self.node(cells)?;
+            self.rows.push(node);
+        }
+        self.schema = Some(schema);
+        Ok(())
+    }
+
+    fn node(&self, cells: Vec<JsonValue>) -> Result<Node, StreamError> {
+        let config = &self.config.stream.from_json;
+        let id = cells
+            .first()
+            .and_then(JsonValue::as_str)
+            .unwrap_or("")
+            .to_string();
+        let fields = cells
+            .into_iter()
+            .map(|cell| cell_value(cell, config))
+            .collect::<Result<Vec<_>, _>>()?;
+        Ok(Node::new(self.type_name.clone(), id, fields))
+    }
+
+    fn finish(mut self) -> Result<Document, StreamError> {
+        if self.schema.is_none() {
+            self.fix_schema()?;
+        }
+        let Some(schema) = self.schema else {
+            unreachable!("schema fixed above")
+        };
+
+        let mut list = MatrixList::with_count_hint(
+            self.type_name.clone(),
+            schema.columns.clone(),
+            self.rows.len(),
+        );
+        list.rows = self.rows;
+
+        let mut doc = Document::new(self.config.stream.from_json.version);
+        doc.structs.insert(self.type_name, schema.columns);
+        doc.root.insert(self.config.key, Item::List(list));
+        Ok(doc)
+    }
+}
+
+/// Convert one cell, moving plain strings instead of copying them
+fn cell_value(cell: JsonValue, config: &FromJsonConfig) -> Result<Value, JsonConversionError> {
+    match cell {
+        JsonValue::String(s) if !(s.starts_with("$(") && s.ends_with(')')) => {
+            if let Some(max_len) = config.max_string_length {
+                if s.len() > max_len {
+                    return Err(JsonConversionError::MaxStringLengthExceeded(max_len, s.len()));
+                }
+            }
+            Ok(Value::String(s))
+        }
+        other => json_to_value(&other, config),
+    }
+}
+
+/// Decodes one row object into schema-ordered cells
+struct RowSeed<'a> {
+    schema: &'a RowSchema,
+}
+
+impl<'de> DeserializeSeed<'de> for RowSeed<'_> {
+    type Value = Vec<JsonValue>;
+
+    fn deserialize<D: Deserializer<'de>>(self, deserializer: D) -> Result<Self::Value, D::Error> {
+        deserializer.deserialize_map(self)
+    }
+}
+
+impl<'de> Visitor<'de> for RowSeed<'_> {
+    type Value = Vec<JsonValue>;
+
+    fn expecting(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.write_str("a JSON object row")
+    }
+
+    fn visit_map<A: MapAccess<'de>>(self, mut map: A) -> Result<Self::Value, A::Error> {
+        let mut cells = vec![JsonValue::Null; self.schema.columns.len()];
+        while let Some(column) = map.next_key_seed(ColumnSeed {
+            schema: self.schema,
+        })? {
+            match column {
+                Some(index) => cells[index] = map.next_value()?,
+                None => {
+                    map.next_value::<IgnoredAny>()?;
+                }
+            }
+        }
+        Ok(cells)
+    }
+}
+
+/// Maps a row key to its column index, or `None` for skipped keys
+struct ColumnSeed<'a> {
+    schema: &'a RowSchema,
+}
+
+impl<'de> DeserializeSeed<'de> for ColumnSeed<'_> {
+    type Value = Option<usize>;
+
+    fn deserialize<D: Deserializer<'de>>(self, deserializer: D) -> Result<Self::Value, D::Error> {
+        deserializer.deserialize_str(self)
+    }
+}
+
+impl<'de> Visitor<'de> for ColumnSeed<'_> {
+    type Value = Option<usize>;
+
+    fn expecting(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.write_str("a column name")
+    }
+
+    fn visit_str<E: serde::de::Error>(self, key: &str) -> Result<Self::Value, E> {
+        if let Some(&index) = self.schema.index.get(key) {
+            Ok(Some(index))
+        } else if key.starts_with("__") || self.schema.skipped.contains(key) {
+            Ok(None)
+        } else {
+            Err(E::custom(format!(
+                "key '{}' is not in the schema inferred from the sample rows",
+                key
+            )))
+        }
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -933,4 +1496,123 @@ mod tests {
             &Value::Int(10)
         );
     }
+
+    // ==================== Row import tests ====================
+
+    const ROWS: &str = r#"[
+        {"name": "Alice", "id": "u1", "age": 30, "tags": [1, 2]},
+        {"id": "u2", "name": "Bob \"B\" \\ {[", "age": null, "tags": []},
+        {"id": "u3", "name": "Carol", "age": 41.5, "tags": [3]}
+    ]"#;
+
+    fn rows_config(sample_rows: usize) -> RowImportConfig {
+        RowImportConfig {
+            key: "users".to_string(),
+            sample_rows,
+            ..RowImportConfig::default()
+        }
+    }
+
+    fn expected_rows() -> Document {
+        let json = format!(r#"{{"users": {}}}"#, ROWS);
+        crate::from_json(&json, &FromJsonConfig::default()).unwrap()
+    }
+
+    #[test]
+    fn test_import_rows_matches_from_json() {
+        for sample_rows in [1, 2, 100] {
+            let doc = import_json_rows(Cursor::new(ROWS), rows_config(sample_rows)).unwrap();
+            assert_eq!(doc, expected_rows(), "sample_rows = {}", sample_rows);
+        }
+    }
+
+    #[test]
+    fn test_import_rows_any_chunking() {
+        for chunk_size in [1, 2, 7, 64] {
+            let mut importer = JsonRowImporter::new(rows_config(1));
+            for chunk in ROWS.as_bytes().chunks(chunk_size) {
+                importer.feed(chunk).unwrap();
+            }
+            assert_eq!(importer.row_count(), 3);
+            assert_eq!(importer.finish().unwrap(), expected_rows());
+        }
+    }
+
+    #[test]
+    fn test_import_rows_json_lines() {
+        let lines = "{\"id\": \"a\", \"n\": 1}\n{\"id\": \"b\"}\n\n{\"n\": 3, \"id\": \"c\"}\n";
+        let doc = import_json_rows(Cursor::new(lines), RowImportConfig::default()).unwrap();
+
+        assert_eq!(doc.structs["Row"], ["id", "n"]);
+        let Some(Item::List(list)) = doc.root.get("rows") else {
+            panic!("expected a list");
+        };
+        assert_eq!(list.count_hint, Some(3));
+        let ids: Vec<_> = list.rows.iter().map(|r| r.id.as_str()).collect();
+        assert_eq!(ids, ["a", "b", "c"]);
+        assert_eq!(list.rows[1].fields[1], Value::Null);
+        assert_eq!(list.rows[2].fields[1], Value::Int(3));
+    }
+
+    #[test]
+    fn test_import_rows_schema_is_union_of_sample() {
+        let lines = r#"{"id": "a"} {"id": "b", "extra": true} {"id": "c"}"#;
+        let doc = import_json_rows(Cursor::new(lines), rows_config(2)).unwrap();
+        assert_eq!(doc.structs["User"], ["id", "extra"]);
+
+        // A key first seen after the sample is rejected
+        let err = import_json_rows(Cursor::new(lines), rows_config(1)).unwrap_err();
+        assert!(err.to_string().contains("'extra'"), "{}", err);
+    }
+
+    #[test]
+    fn test_import_rows_empty_input() {
+        for input in ["", "  ", "[]", " [ ] "] {
+            let doc = import_json_rows(Cursor::new(input), RowImportConfig::default()).unwrap();
+            let Some(Item::List(list)) = doc.root.get("rows") else {
+                panic!("expected a list");
+            };
+            assert!(list.rows.is_empty());
+            assert_eq!(list.schema, crate::DEFAULT_SCHEMA);
+        }
+    }
+
+    #[test]
+    fn test_import_rows_framing_errors() {
+        for input in [
+            r#"[{"id": "a"}"#,
+            r#"[{"id": "a"},]"#,
+            r#"[{"id": "a"} {"id": "b"}]"#,
+            r#"[{"id": "a"}, 1]"#,
+            r#"[{"id": "a"}] {"id": "b"}"#,
+            r#"{"id": "a""#,
+            r#"[[{"id": "a"}]]"#,
+        ] {
+            let result = import_json_rows(Cursor::new(input), RowImportConfig::default());
+            assert!(
+                matches!(result, Err(StreamError::Json(_))),
+                "{}: {:?}",
+                input,
+                result
+            );
+        }
+    }
+
+    #[test]
+    fn test_import_rows_limits() {
+        let mut config = RowImportConfig::default();
+        config.stream.max_object_bytes = Some(16);
+        let result = import_json_rows(Cursor::new(r#"[{"id": "a-long-identifier"}]"#), config);
+        assert!(matches!(result, Err(StreamError::ObjectTooLarge(_, 16))));
+
+        let mut config = RowImportConfig::default();
+        config.stream.from_json.max_array_size = Some(1);
+        let result = import_json_rows(Cursor::new(r#"{"id": "a"} {"id": "b"}"#), config);
+        assert!(matches!(
+            result,
+            Err(StreamError::Conversion(
+                JsonConversionError::MaxArraySizeExceeded(1, 2)
+            ))
+        ));
+    }
 }
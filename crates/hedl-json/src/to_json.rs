@@ -60,6 +60,20 @@ pub fn to_json(doc: &Document, config: &ToJsonConfig) -> Result<String, String>
     serde_json::to_string_pretty(&value).map_err(|e| format!("JSON serialization error: {}", e))
 }
 
+/// Convert Document to JSON, writing the pretty-printed output to `writer`
+///
+/// Produces the same bytes as [`to_json`] without holding the serialized
+/// string in memory; the intermediate `serde_json::Value` is still built.
+pub fn to_json_writer<W: std::io::Write>(
+    doc: &Document,
+    config: &ToJsonConfig,
+    writer: W,
+) -> Result<(), String> {
+    let value = to_json_value(doc, config)?;
+    serde_json::to_writer_pretty(writer, &value)
+        .map_err(|e| format!("JSON serialization error: {}", e))
+}
+
 /// Convert Document to serde_json::Value
 pub fn to_json_value(doc: &Document, config: &ToJsonConfig) -> Result<JsonValue, String> {
     root_to_json(&doc.root, doc, config)
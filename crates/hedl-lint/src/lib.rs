@@ -51,6 +51,28 @@
 //! let diagnostics = lint_with_config(&doc, config);
 //! ```
 //!
+//! ## Early Exit and Parallel Rules
+//!
+//! `max_diagnostics` caps the output and `stop_on_error` stops scheduling
+//! rules once one has reported an error, so a bad file is rejected without
+//! running every rule. With the `parallel` feature, `parallel = true` runs the
+//! enabled rules concurrently on the current rayon pool; the output is the
+//! same as a sequential run.
+//!
+//! ```rust
+//! use hedl_lint::{lint_with_config, LintConfig};
+//! use hedl_core::Document;
+//!
+//! let doc = Document::new((1, 0));
+//!
+//! let mut config = LintConfig::default();
+//! config.stop_on_error = true;
+//! config.max_diagnostics = 100;
+//! config.parallel = true;
+//!
+//! let diagnostics = lint_with_config(&doc, config);
+//! ```
+//!
 //! ## Custom Rules
 //!
 //! ```rust
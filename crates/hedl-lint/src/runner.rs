@@ -22,6 +22,7 @@ use crate::rules::{default_rules, LintRule, RuleConfig};
 use hedl_core::Document;
 use std::collections::HashMap;
 use std::path::PathBuf;
+use std::sync::atomic::{AtomicUsize, Ordering};
 
 /// Context passed to lint rules for better error reporting
 ///
@@ -147,6 +148,17 @@ pub struct LintConfig {
     /// reached, no further diagnostics will be collected and a warning will be
     /// issued.
     pub max_diagnostics: usize,
+    /// Stop running further rules once a rule has reported an error
+    ///
+    /// Rules already finished still contribute their diagnostics, so the
+    /// result is the same prefix a sequential run would produce up to and
+    /// including the first rule that found an error.
+    pub stop_on_error: bool,
+    /// Run the enabled rules concurrently on the current rayon pool
+    ///
+    /// Only honoured with the `parallel` cargo feature. Output is identical to
+    /// a sequential run, including ordering and limits.
+    pub parallel: bool,
 }
 
 impl Default for LintConfig {
@@ -155,6 +167,8 @@ impl Default for LintConfig {
             rules: HashMap::new(),
             min_severity: Severity::Hint,
             max_diagnostics: MAX_DIAGNOSTICS,
+            stop_on_error: false,
+            parallel: false,
         }
     }
 }
@@ -289,42 +303,30 @@ impl LintRunner {
         let mut diagnostics = Vec::new();
         let mut limit_exceeded = false;
 
-        for rule in &self.rules {
+        for rule_diagnostics in self.check_rules(doc, &context) {
             // Check diagnostic limit before processing each rule
             if diagnostics.len() >= self.config.max_diagnostics {
                 limit_exceeded = true;
                 break;
             }
 
-            let rule_id = rule.id();
-            let rule_config = self.config.rules.get(rule_id).cloned().unwrap_or_default();
-
-            if !rule_config.enabled {
+            // Disabled, or skipped once an earlier rule ended the run
+            let Some(rule_diagnostics) = rule_diagnostics else {
                 continue;
-            }
-
-            let mut rule_diagnostics = rule.check_with_context(doc, &context as &dyn std::any::Any);
+            };
 
-            // Apply rule configuration
-            for diag in &mut rule_diagnostics {
-                if rule_config.error && diag.severity() == Severity::Warning {
-                    diag.escalate_to_error();
-                }
-            }
-
-            // Filter by minimum severity and apply diagnostic limit
-            for diag in rule_diagnostics
-                .into_iter()
-                .filter(|d| d.severity() >= self.config.min_severity)
-            {
+            // Apply diagnostic limit
+            let mut found_error = false;
+            for diag in rule_diagnostics {
                 if diagnostics.len() >= self.config.max_diagnostics {
                     limit_exceeded = true;
                     break;
                 }
+                found_error |= diag.severity() == Severity::Error;
                 diagnostics.push(diag);
             }
 
-            if limit_exceeded {
+            if limit_exceeded || (self.config.stop_on_error && found_error) {
                 break;
             }
         }
@@ -352,6 +354,63 @@ impl LintRunner {
         diagnostics
     }
 
+    /// Run every rule, returning its configured, severity-filtered diagnostics.
+    ///
+    /// Results are in rule order; `None` marks a disabled rule or one skipped
+    /// because an earlier rule already ends the run (see [`Self::ends_run`]).
+    /// With `parallel`, rules run concurrently; a rule only skips when a rule
+    /// *before* it ended the run, so the merged output matches a sequential run.
+    fn check_rules(&self, doc: &Document, context: &LintContext) -> Vec<Option<Vec<Diagnostic>>> {
+        let stop_at = AtomicUsize::new(usize::MAX);
+
+        let check = |index: usize| -> Option<Vec<Diagnostic>> {
+            if stop_at.load(Ordering::Relaxed) < index {
+                return None;
+            }
+
+            let rule = &self.rules[index];
+            let rule_config = self.config.rules.get(rule.id()).cloned().unwrap_or_default();
+            if !rule_config.enabled {
+                return None;
+            }
+
+            let mut rule_diagnostics = rule.check_with_context(doc, context as &dyn std::any::Any);
+
+            // Apply rule configuration
+            for diag in &mut rule_diagnostics {
+                if rule_config.error && diag.severity() == Severity::Warning {
+                    diag.escalate_to_error();
+                }
+            }
+
+            // Filter by minimum severity
+            rule_diagnostics.retain(|d| d.severity() >= self.config.min_severity);
+
+            if self.ends_run(&rule_diagnostics) {
+                stop_at.fetch_min(index, Ordering::Relaxed);
+            }
+            Some(rule_diagnostics)
+        };
+
+        #[cfg(feature = "parallel")]
+        if self.config.parallel && self.rules.len() > 1 {
+            use rayon::prelude::*;
+            return (0..self.rules.len()).into_par_iter().map(&check).collect();
+        }
+
+        (0..self.rules.len()).map(check).collect()
+    }
+
+    /// Whether no rule after one reporting `diagnostics` can affect the output.
+    ///
+    /// True if the rule alone reaches the diagnostic limit, or found an error
+    /// under `stop_on_error`.
+    fn ends_run(&self, diagnostics: &[Diagnostic]) -> bool {
+        diagnostics.len() >= self.config.max_diagnostics
+            || (self.config.stop_on_error
+                && diagnostics.iter().any(|d| d.severity() == Severity::Error))
+    }
+
     /// Check if any errors were found
     pub fn has_errors(&self, diagnostics: &[Diagnostic]) -> bool {
         diagnostics.iter().any(|d| d.severity() == Severity::Error)
@@ -856,4 +915,53 @@ mod tests {
 
         assert!(!diagnostics.is_empty());
     }
+
+    // ==================== Early exit and parallel tests ====================
+
+    /// Unused schema (a warning, escalated to error) plus an empty list (a hint).
+    fn error_and_hint_document() -> Document {
+        let mut doc = Document::new((1, 0));
+        doc.structs.insert("Unused".to_string(), vec!["id".to_string()]);
+        let list = MatrixList::new("Empty", vec!["id".to_string()]);
+        doc.root.insert("empty".to_string(), Item::List(list));
+        doc
+    }
+
+    #[test]
+    fn test_lint_runner_stop_on_error() {
+        let mut config = LintConfig::default();
+        config.set_rule_error("unused-schema");
+
+        let all = LintRunner::new(config.clone()).run(&error_and_hint_document());
+        assert!(all.iter().any(|d| matches!(d.kind(), DiagnosticKind::EmptyList)));
+
+        config.stop_on_error = true;
+        let early = LintRunner::new(config).run(&error_and_hint_document());
+        assert_eq!(early.len(), 1);
+        assert!(matches!(early[0].kind(), DiagnosticKind::UnusedSchema));
+        assert_eq!(early[0].severity(), Severity::Error);
+    }
+
+    #[test]
+    fn test_lint_runner_parallel_matches_sequential() {
+        let mut doc = error_and_hint_document();
+        let mut list = MatrixList::new("User", vec!["id".to_string()]);
+        for id in ["a", "b", "1"] {
+            list.add_row(Node::new("User", id, vec![]));
+        }
+        doc.root.insert("users".to_string(), Item::List(list));
+
+        let cases = [(false, MAX_DIAGNOSTICS), (true, MAX_DIAGNOSTICS), (false, 2)];
+        for (stop_on_error, max_diagnostics) in cases {
+            let mut config = LintConfig::default();
+            config.set_rule_error("unused-schema");
+            config.stop_on_error = stop_on_error;
+            config.max_diagnostics = max_diagnostics;
+
+            let sequential = LintRunner::new(config.clone()).run(&doc);
+            config.parallel = true;
+            let parallel = LintRunner::new(config).run(&doc);
+            assert_eq!(format!("{:?}", sequential), format!("{:?}", parallel));
+        }
+    }
 }
@@ -155,5 +155,6 @@ pub use from_neo4j::{
 };
 pub use mapping::{Neo4jNode, Neo4jRelationship};
 pub use to_cypher::{
-    hedl_to_cypher, node_to_cypher_inline, to_cypher, to_cypher_statements, to_cypher_stream,
+    hedl_to_cypher, node_to_cypher_inline, to_cypher, to_cypher_batches, to_cypher_statements,
+    to_cypher_stream,
 };
@@ -522,23 +522,103 @@ pub fn to_cypher_stream<W: Write>(
     // Create the statement writer closure
     let (mut write_statement, _first_stmt_marker) = create_statement_writer(config);
 
+    stream_statements(doc, config, writer, &mut write_statement)
+}
+
+/// Convert a HEDL document to parameterized Cypher statements, one JSON object per line.
+///
+/// Each line is `{"statement": "...", "parameters": {...}}`, the shape Neo4j drivers and
+/// the HTTP transaction API accept. Nodes are grouped by label and relationships by
+/// type into `UNWIND $rows AS row` statements of at most `config.batch_size` rows, with
+/// the rows carried in `parameters.rows` instead of being inlined as literals. Neo4j
+/// then plans each distinct statement text once and reuses the plan for every batch.
+///
+/// Statements appear in the same order as in [`to_cypher_stream`]: constraints, nodes,
+/// then relationships. Comments are omitted, as is the unresolved-reference warning,
+/// which is a comment with nothing to execute.
+///
+/// # Errors
+///
+/// Returns `Neo4jError::EmptyMatrixList` if a MatrixList has no rows.
+/// Returns `Neo4jError::RecursionLimitExceeded` if NEST depth exceeds limit.
+/// Returns I/O and serialization errors as `Neo4jError::HedlError`.
+///
+/// # Examples
+///
+/// ```rust
+/// use hedl_core::Document;
+/// use hedl_neo4j::{to_cypher_batches, ToCypherConfig};
+///
+/// fn example(doc: &Document) -> Result<(), hedl_neo4j::Neo4jError> {
+///     let config = ToCypherConfig::new().with_batch_size(10_000);
+///     let mut payload = Vec::new();
+///     to_cypher_batches(doc, &config, &mut payload)?;
+///
+///     for line in String::from_utf8(payload).unwrap().lines() {
+///         // session.run(statement, parameters) for each line
+///         let _ = line;
+///     }
+///     Ok(())
+/// }
+/// ```
+pub fn to_cypher_batches<W: Write>(
+    doc: &Document,
+    config: &ToCypherConfig,
+    writer: &mut W,
+) -> Result<()> {
+    let mut write_statement = |stmt: &CypherStatement, writer: &mut W| -> Result<()> {
+        if stmt.query.starts_with("//") {
+            return Ok(());
+        }
+
+        let line = ParameterizedStatement {
+            statement: &stmt.query,
+            parameters: &stmt.parameters,
+        };
+        serde_json::to_writer(&mut *writer, &line)
+            .map_err(|e| Neo4jError::HedlError(e.to_string()))?;
+        writer
+            .write_all(b"\n")
+            .map_err(|e| Neo4jError::HedlError(e.to_string()))
+    };
+
+    stream_statements(doc, config, writer, &mut write_statement)
+}
+
+/// One line of [`to_cypher_batches`] output.
+#[derive(serde::Serialize)]
+struct ParameterizedStatement<'a> {
+    statement: &'a str,
+    parameters: &'a BTreeMap<String, CypherValue>,
+}
+
+/// Generate every statement for `doc` in script order and hand each to `write_statement`.
+fn stream_statements<W: Write, F>(
+    doc: &Document,
+    config: &ToCypherConfig,
+    writer: &mut W,
+    write_statement: &mut F,
+) -> Result<()>
+where
+    F: FnMut(&CypherStatement, &mut W) -> Result<()>,
+{
     // Collect all node types for constraint generation
     let node_types = collect_all_node_types(doc, config)?;
 
     // Generate and write constraints first
-    stream_constraints(&node_types, config, writer, &mut write_statement)?;
+    stream_constraints(&node_types, config, writer, write_statement)?;
 
     // Stream all nodes (including child nodes from NEST hierarchies)
-    stream_all_nodes(doc, config, writer, &mut write_statement)?;
+    stream_all_nodes(doc, config, writer, write_statement)?;
 
     // Generate relationships from references and NEST
     let relationships = extract_relationships(doc, config)?;
 
     // Stream reference validation warnings
-    stream_reference_warnings(doc, &relationships, writer, &mut write_statement)?;
+    stream_reference_warnings(doc, &relationships, writer, write_statement)?;
 
     // Stream relationship creation statements
-    stream_relationship_statements(&relationships, config, writer, &mut write_statement)?;
+    stream_relationship_statements(&relationships, config, writer, write_statement)?;
 
     // Flush the writer to ensure all data is written
     writer
@@ -1702,6 +1782,42 @@ mod tests {
         assert_eq!(batch_count, 5, "Expected 5 batches for 5000 nodes with batch_size 1000");
     }
 
+    #[test]
+    fn test_batches_carry_rows_as_parameters() {
+        let doc = make_simple_doc();
+        let config = ToCypherConfig::new().with_batch_size(1);
+
+        let mut output = Vec::new();
+        to_cypher_batches(&doc, &config, &mut output).unwrap();
+        let output = String::from_utf8(output).unwrap();
+
+        let lines: Vec<serde_json::Value> = output
+            .lines()
+            .map(|line| serde_json::from_str(line).unwrap())
+            .collect();
+        let statements = to_cypher_statements(&doc, &config).unwrap();
+        assert_eq!(lines.len(), statements.len());
+
+        for (line, stmt) in lines.iter().zip(&statements) {
+            assert_eq!(line["statement"], stmt.query.as_str());
+            assert_eq!(
+                line["parameters"],
+                serde_json::to_value(&stmt.parameters).unwrap()
+            );
+        }
+
+        // Rows are parameters, not literals in the statement text
+        let nodes: Vec<&serde_json::Value> = lines
+            .iter()
+            .filter(|l| l["statement"].as_str().unwrap().starts_with("UNWIND"))
+            .collect();
+        assert!(!nodes.is_empty());
+        for line in nodes {
+            assert!(line["statement"].as_str().unwrap().contains("$rows"));
+            assert_eq!(line["parameters"]["rows"].as_array().unwrap().len(), 1);
+        }
+    }
+
     #[test]
     fn test_deep_nested_children_use_schema_column_names() {
         // Create a 3-level NEST hierarchy: Organization > Department > Employee
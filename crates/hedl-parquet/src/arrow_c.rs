@@ -0,0 +1,277 @@
+// Dweve HEDL - Hierarchical Entity Data Language
+//
+// Copyright (c) 2025 Dweve IP B.V. and individual contributors.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License in the LICENSE file at the
+// root of this repository or at: http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Matrix lists as Arrow record batches, in process or over the Arrow C
+//! Data Interface.
+//!
+//! [`to_record_batch`] builds Arrow arrays straight from a matrix list's
+//! rows, with the same schema and type mapping `to_parquet` writes, and
+//! [`from_record_batch`] is the inverse of reading that Parquet back. No
+//! Parquet encoding or decoding happens on either path.
+//!
+//! [`to_arrow_c`] and [`from_arrow_c`] move those batches across the C
+//! Data Interface as a struct array, so consumers such as DuckDB or Polars
+//! adopt the Arrow buffers without copying them.
+//!
+//! # Example
+//!
+//! ```
+//! use hedl_core::{Document, Item, MatrixList, Node, Value};
+//! use hedl_parquet::{from_record_batch, to_record_batch};
+//!
+//! let mut doc = Document::new((1, 0));
+//! let mut list = MatrixList::new("User", vec!["id".to_string(), "age".to_string()]);
+//! list.add_row(Node::new("User", "alice", vec![
+//!     Value::String("alice".to_string()),
+//!     Value::Int(30),
+//! ]));
+//! doc.root.insert("users".to_string(), Item::List(list));
+//!
+//! let batch = to_record_batch(&doc, "User").unwrap();
+//! assert_eq!(batch.num_rows(), 1);
+//!
+//! let back = from_record_batch(&batch).unwrap();
+//! assert!(back.root.contains_key("users"));
+//! ```
+
+use std::collections::BTreeMap;
+
+use arrow::array::{Array, StructArray};
+use arrow::datatypes::{DataType, Schema};
+use arrow::ffi::{from_ffi, FFI_ArrowArray, FFI_ArrowSchema};
+use arrow::record_batch::RecordBatch;
+
+use hedl_core::{Document, HedlError, HedlErrorKind, Item, MatrixList};
+
+use crate::from_parquet::{convert_record_batch_to_hedl, HedlMetadata};
+use crate::to_parquet::{build_record_batch_from_nodes, build_schema_from_matrix_list};
+
+/// Convert the matrix list of type `type_name` to an Arrow record batch.
+///
+/// The list is looked up among the root items and, depth first, inside
+/// nested objects. The schema carries `hedl:type_name` and `hedl:key`
+/// metadata so [`from_record_batch`] restores the list under its key.
+///
+/// # Errors
+///
+/// Returns a [`HedlErrorKind::Schema`] error if the document has no matrix
+/// list of that type.
+pub fn to_record_batch(doc: &Document, type_name: &str) -> Result<RecordBatch, HedlError> {
+    let (key, list) = find_matrix_list(&doc.root, type_name).ok_or_else(|| {
+        HedlError::new(
+            HedlErrorKind::Schema,
+            format!("no matrix list of type '{}'", type_name),
+            0,
+        )
+    })?;
+
+    let schema = build_schema_from_matrix_list(list, key)?;
+    build_record_batch_from_nodes(&list.rows, &schema)
+}
+
+/// Convert an Arrow record batch to a document holding one matrix list.
+///
+/// Type name and list key come from the schema's `hedl:type_name` and
+/// `hedl:key` metadata when present; the first column provides node IDs.
+/// A batch with the two Utf8 columns `key` and `value` becomes root
+/// key-value pairs, as in [`crate::from_parquet_bytes`].
+pub fn from_record_batch(batch: &RecordBatch) -> Result<Document, HedlError> {
+    let mut doc = Document::new((1, 0));
+    let metadata = HedlMetadata::from_schema(&batch.schema());
+    convert_record_batch_to_hedl(batch, &mut doc, &metadata)?;
+    Ok(doc)
+}
+
+/// Export the matrix list of type `type_name` over the Arrow C Data Interface.
+///
+/// The result is a struct array with one child per column, and its schema.
+/// Both own their buffers and free them through their `release` callbacks,
+/// so they may outlive `doc`.
+///
+/// # Errors
+///
+/// Same as [`to_record_batch`], plus a [`HedlErrorKind::Conversion`] error
+/// if the schema cannot be exported.
+pub fn to_arrow_c(
+    doc: &Document,
+    type_name: &str,
+) -> Result<(FFI_ArrowArray, FFI_ArrowSchema), HedlError> {
+    let batch = to_record_batch(doc, type_name)?;
+    let schema = FFI_ArrowSchema::try_from(batch.schema().as_ref())
+        .map_err(|e| arrow_error("Failed to export Arrow schema", e))?;
+    let array = FFI_ArrowArray::new(&StructArray::from(batch).into_data());
+    Ok((array, schema))
+}
+
+/// Import a struct array from the Arrow C Data Interface as a document.
+///
+/// Takes ownership of `array`, which is released when this returns; the
+/// schema is only borrowed. See [`from_record_batch`] for the mapping.
+///
+/// # Errors
+///
+/// Returns a [`HedlErrorKind::Conversion`] error if the array is invalid,
+/// not a struct array, or has null rows at the top level.
+///
+/// # Safety
+///
+/// `array` and `schema` must be valid C Data Interface structures that
+/// describe the same data.
+pub unsafe fn from_arrow_c(
+    array: FFI_ArrowArray,
+    schema: &FFI_ArrowSchema,
+) -> Result<Document, HedlError> {
+    let arrow_schema =
+        Schema::try_from(schema).map_err(|e| arrow_error("Invalid Arrow schema", e))?;
+    let data = from_ffi(array, schema).map_err(|e| arrow_error("Invalid Arrow array", e))?;
+
+    if !matches!(data.data_type(), DataType::Struct(_)) {
+        return Err(HedlError::new(
+            HedlErrorKind::Conversion,
+            format!("Expected an Arrow struct array, got {}", data.data_type()),
+            0,
+        ));
+    }
+    let rows = StructArray::from(data);
+    if rows.null_count() > 0 {
+        return Err(HedlError::new(
+            HedlErrorKind::Conversion,
+            "Arrow struct array has null rows",
+            0,
+        ));
+    }
+
+    // The array's own fields carry no schema-level metadata; restore it
+    let batch = RecordBatch::from(rows)
+        .with_schema(std::sync::Arc::new(arrow_schema))
+        .map_err(|e| arrow_error("Arrow schema does not match array", e))?;
+    from_record_batch(&batch)
+}
+
+/// Find a matrix list by type name, returning it with its key.
+fn find_matrix_list<'a>(
+    items: &'a BTreeMap<String, Item>,
+    type_name: &str,
+) -> Option<(&'a str, &'a MatrixList)> {
+    for (key, item) in items {
+        match item {
+            Item::List(list) if list.type_name == type_name => return Some((key, list)),
+            Item::Object(object) => {
+                if let Some(found) = find_matrix_list(object, type_name) {
+                    return Some(found);
+                }
+            }
+            _ => {}
+        }
+    }
+    None
+}
+
+fn arrow_error(context: &str, e: arrow::error::ArrowError) -> HedlError {
+    HedlError::new(HedlErrorKind::Conversion, format!("{}: {}", context, e), 0)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use hedl_core::{Node, Value};
+
+    fn users_doc() -> Document {
+        let mut doc = Document::new((1, 0));
+        let mut list = MatrixList::new(
+            "User",
+            vec![
+                "id".to_string(),
+                "name".to_string(),
+                "age".to_string(),
+                "active".to_string(),
+            ],
+        );
+        for (id, name, age, active) in [("alice", "Alice", 30, true), ("bob", "Bob", 25, false)] {
+            list.add_row(Node::new(
+                "User",
+                id,
+                vec![
+                    Value::String(id.to_string()),
+                    Value::String(name.to_string()),
+                    Value::Int(age),
+                    Value::Bool(active),
+                ],
+            ));
+        }
+        let mut team = BTreeMap::new();
+        team.insert("members".to_string(), Item::List(list));
+        doc.root.insert("team".to_string(), Item::Object(team));
+        doc
+    }
+
+    fn members(doc: &Document) -> &MatrixList {
+        match doc.root.get("members") {
+            Some(Item::List(list)) => list,
+            other => panic!("expected members list, got {:?}", other),
+        }
+    }
+
+    #[test]
+    fn test_record_batch_columns() {
+        let batch = to_record_batch(&users_doc(), "User").unwrap();
+        assert_eq!(batch.num_rows(), 2);
+        assert_eq!(batch.num_columns(), 4);
+        let schema = batch.schema();
+        assert_eq!(schema.field(2).data_type(), &DataType::Int64);
+        assert_eq!(schema.field(3).data_type(), &DataType::Boolean);
+        assert_eq!(schema.metadata().get("hedl:key").unwrap(), "members");
+    }
+
+    #[test]
+    fn test_record_batch_round_trip() {
+        let doc = users_doc();
+        let back = from_record_batch(&to_record_batch(&doc, "User").unwrap()).unwrap();
+        let list = members(&back);
+        assert_eq!(list.type_name, "User");
+        assert_eq!(list.rows.len(), 2);
+        assert_eq!(list.rows[1].id, "bob");
+        assert_eq!(list.rows[1].fields[2], Value::Int(25));
+        assert_eq!(list.rows[1].fields[3], Value::Bool(false));
+    }
+
+    #[test]
+    fn test_unknown_type() {
+        let err = to_record_batch(&users_doc(), "Post").unwrap_err();
+        assert!(matches!(err.kind, HedlErrorKind::Schema));
+        assert!(err.message.contains("Post"));
+    }
+
+    #[test]
+    fn test_c_data_interface_round_trip() {
+        let (array, schema) = to_arrow_c(&users_doc(), "User").unwrap();
+        let back = unsafe { from_arrow_c(array, &schema) }.unwrap();
+        let list = members(&back);
+        assert_eq!(list.rows.len(), 2);
+        assert_eq!(list.rows[0].id, "alice");
+        assert_eq!(list.rows[0].fields[1], Value::String("Alice".to_string()));
+    }
+
+    #[test]
+    fn test_c_data_interface_rejects_non_struct() {
+        let data = arrow::array::Int64Array::from(vec![1, 2]).into_data();
+        let array = FFI_ArrowArray::new(&data);
+        let schema = FFI_ArrowSchema::try_from(data.data_type()).unwrap();
+        let err = unsafe { from_arrow_c(array, &schema) }.unwrap_err();
+        assert!(matches!(err.kind, HedlErrorKind::Conversion));
+    }
+}
@@ -73,7 +73,13 @@ use arrow::array::{
 };
 use arrow::datatypes::DataType;
 use arrow::record_batch::RecordBatch;
-use parquet::arrow::arrow_reader::ParquetRecordBatchReaderBuilder;
+use parquet::arrow::arrow_reader::{
+    ArrowReaderMetadata, ArrowReaderOptions, ParquetRecordBatchReader,
+    ParquetRecordBatchReaderBuilder,
+};
+use parquet::arrow::ProjectionMask;
+use parquet::file::reader::ChunkReader;
+use rayon::prelude::*;
 
 use hedl_core::{Document, HedlError, HedlErrorKind, Item, MatrixList, Node, Value};
 
@@ -124,6 +130,62 @@ pub fn from_parquet(path: &Path) -> Result<Document, HedlError> {
     read_parquet_from_file(file)
 }
 
+/// Selects which parts of a Parquet file to decode.
+///
+/// Selection happens against the footer metadata, so column chunks and row
+/// groups that are not selected are never read or decompressed.
+#[derive(Debug, Clone, Default)]
+pub struct ParquetReadOptions {
+    /// Top-level column names to read (`None` reads all columns).
+    ///
+    /// Selected columns keep their file order; the first one becomes the
+    /// node ID column.
+    pub columns: Option<Vec<String>>,
+    /// Row group indices to read (`None` reads all row groups).
+    pub row_groups: Option<Vec<usize>>,
+}
+
+/// Read a HEDL document from a memory-mapped Parquet file.
+///
+/// The file is mapped rather than read into memory, and the reader slices
+/// only the footer and the selected column chunks out of the mapping, so
+/// the OS pages in just those byte ranges. Large files therefore need no
+/// heap copy of the input.
+///
+/// The file must not be modified or truncated while it is being read.
+///
+/// # Errors
+///
+/// Returns an error if the file cannot be opened or mapped, a selected
+/// column or row group does not exist, or the data cannot be converted.
+///
+/// # Example
+///
+/// ```no_run
+/// use hedl_parquet::{from_parquet_mmap, ParquetReadOptions};
+/// use std::path::Path;
+///
+/// let options = ParquetReadOptions {
+///     columns: Some(vec!["id".to_string(), "name".to_string()]),
+///     row_groups: Some(vec![0]),
+/// };
+/// let doc = from_parquet_mmap(Path::new("archive.parquet"), &options).unwrap();
+/// ```
+pub fn from_parquet_mmap(path: &Path, options: &ParquetReadOptions) -> Result<Document, HedlError> {
+    let file = std::fs::File::open(path).map_err(|e| {
+        HedlError::io(format!("Failed to open Parquet file: {}", e))
+    })?;
+
+    // SAFETY: the mapping is read-only and the caller guarantees the file is
+    // not modified while it is mapped.
+    let mmap = unsafe { memmap2::Mmap::map(&file) }.map_err(|e| {
+        HedlError::io(format!("Failed to map Parquet file: {}", e))
+    })?;
+
+    // Zero-copy: the reader's byte ranges are slices of the mapping
+    read_parquet_parallel(bytes::Bytes::from_owner(mmap), options)
+}
+
 /// Read a HEDL document from Parquet bytes.
 ///
 /// # Example
@@ -138,41 +200,165 @@ pub fn from_parquet_bytes(bytes: &[u8]) -> Result<Document, HedlError> {
     // Convert to bytes::Bytes for ChunkReader implementation
     let bytes_data = bytes::Bytes::copy_from_slice(bytes);
 
-    let builder = ParquetRecordBatchReaderBuilder::try_new(bytes_data).map_err(|e| {
-        HedlError::io(format!("Failed to create Parquet reader: {}", e))
-    })?;
+    read_parquet_parallel(bytes_data, &ParquetReadOptions::default())
+}
 
-    // Extract file metadata before building reader
-    let file_metadata = builder.metadata().file_metadata();
-    let hedl_metadata = extract_hedl_metadata(file_metadata);
+/// Read Parquet data from a File.
+fn read_parquet_from_file(file: std::fs::File) -> Result<Document, HedlError> {
+    read_parquet(file, &ParquetReadOptions::default())
+}
 
-    let arrow_reader = builder.build().map_err(|e| {
-        HedlError::io(format!("Failed to build Parquet reader: {}", e))
-    })?;
+/// Build a reader over any chunk source, apply `options` and convert.
+fn read_parquet<T: ChunkReader + 'static>(
+    source: T,
+    options: &ParquetReadOptions,
+) -> Result<Document, HedlError> {
+    let metadata = load_metadata(&source)?;
+    let hedl_metadata = extract_hedl_metadata(metadata.metadata().file_metadata());
+    let selection = Selection::new(&metadata, options)?;
 
-    read_batches(arrow_reader, hedl_metadata)
+    let arrow_reader = selection.reader(source, metadata, selection.row_groups.clone())?;
+    read_batches(arrow_reader.map(|batch| batch.map_err(batch_error)), hedl_metadata)
 }
 
-/// Read Parquet data from a File.
-fn read_parquet_from_file(file: std::fs::File) -> Result<Document, HedlError> {
-    let builder = ParquetRecordBatchReaderBuilder::try_new(file).map_err(|e| {
+/// Like [`read_parquet`], but decodes the selected row groups in parallel.
+///
+/// Every row group gets its own reader over a shared, cheaply cloned
+/// buffer. Groups are decoded one window of worker threads at a time and
+/// converted in selection order, so the security limits in
+/// [`read_batches`] still stop a run before it decodes the whole file.
+fn read_parquet_parallel(
+    source: bytes::Bytes,
+    options: &ParquetReadOptions,
+) -> Result<Document, HedlError> {
+    let metadata = load_metadata(&source)?;
+    let hedl_metadata = extract_hedl_metadata(metadata.metadata().file_metadata());
+    let selection = Selection::new(&metadata, options)?;
+
+    let groups = selection
+        .row_groups
+        .clone()
+        .unwrap_or_else(|| (0..metadata.metadata().num_row_groups()).collect());
+    if groups.len() < 2 {
+        let arrow_reader = selection.reader(source, metadata, selection.row_groups.clone())?;
+        return read_batches(arrow_reader.map(|batch| batch.map_err(batch_error)), hedl_metadata);
+    }
+
+    let window = rayon::current_num_threads().max(1);
+    let batches = groups.chunks(window).flat_map(|chunk| {
+        let decoded: Vec<Result<Vec<RecordBatch>, HedlError>> = chunk
+            .par_iter()
+            .map(|&group| -> Result<Vec<RecordBatch>, HedlError> {
+                selection
+                    .reader(source.clone(), metadata.clone(), Some(vec![group]))?
+                    .map(|batch| batch.map_err(batch_error))
+                    .collect()
+            })
+            .collect();
+
+        let mut ordered = Vec::new();
+        for group in decoded {
+            match group {
+                Ok(group_batches) => ordered.extend(group_batches.into_iter().map(Ok)),
+                Err(e) => ordered.push(Err(e)),
+            }
+        }
+        ordered
+    });
+
+    read_batches(batches, hedl_metadata)
+}
+
+/// Read the footer of a Parquet source.
+fn load_metadata<T: ChunkReader>(source: &T) -> Result<ArrowReaderMetadata, HedlError> {
+    ArrowReaderMetadata::load(source, ArrowReaderOptions::new()).map_err(|e| {
         HedlError::io(format!("Failed to create Parquet reader: {}", e))
-    })?;
+    })
+}
 
-    // Extract file metadata before building reader
-    let file_metadata = builder.metadata().file_metadata();
-    let hedl_metadata = extract_hedl_metadata(file_metadata);
+/// Map a decoding failure to the error reported for unreadable batches.
+fn batch_error(e: arrow::error::ArrowError) -> HedlError {
+    HedlError::io(format!("Failed to read record batch: {}", e))
+}
 
-    let arrow_reader = builder.build().map_err(|e| {
-        HedlError::io(format!("Failed to build Parquet reader: {}", e))
-    })?;
+/// [`ParquetReadOptions`] checked against a file's footer.
+struct Selection {
+    projection: Option<ProjectionMask>,
+    row_groups: Option<Vec<usize>>,
+}
+
+impl Selection {
+    /// Resolve column names and check row group indices.
+    fn new(
+        metadata: &ArrowReaderMetadata,
+        options: &ParquetReadOptions,
+    ) -> Result<Self, HedlError> {
+        let parquet_schema = metadata.metadata().file_metadata().schema_descr();
+
+        let projection = match &options.columns {
+            Some(columns) => {
+                let roots = parquet_schema.root_schema().get_fields();
+                let mut indices = Vec::with_capacity(columns.len());
+                for name in columns {
+                    let index =
+                        roots.iter().position(|f| f.name() == name.as_str()).ok_or_else(|| {
+                            HedlError::new(
+                                HedlErrorKind::Schema,
+                                format!("Parquet file has no column '{}'", name),
+                                0,
+                            )
+                        })?;
+                    indices.push(index);
+                }
+                Some(ProjectionMask::roots(parquet_schema, indices))
+            }
+            None => None,
+        };
+
+        if let Some(row_groups) = &options.row_groups {
+            let available = metadata.metadata().num_row_groups();
+            if let Some(&bad) = row_groups.iter().find(|&&g| g >= available) {
+                return Err(HedlError::new(
+                    HedlErrorKind::Schema,
+                    format!(
+                        "Row group {} out of range (file has {})",
+                        bad, available
+                    ),
+                    0,
+                ));
+            }
+        }
+
+        Ok(Self {
+            projection,
+            row_groups: options.row_groups.clone(),
+        })
+    }
 
-    read_batches(arrow_reader, hedl_metadata)
+    /// Build a reader for `row_groups` (`None` reads every group).
+    fn reader<T: ChunkReader + 'static>(
+        &self,
+        source: T,
+        metadata: ArrowReaderMetadata,
+        row_groups: Option<Vec<usize>>,
+    ) -> Result<ParquetRecordBatchReader, HedlError> {
+        let mut builder = ParquetRecordBatchReaderBuilder::new_with_metadata(source, metadata);
+        if let Some(mask) = &self.projection {
+            builder = builder.with_projection(mask.clone());
+        }
+        if let Some(row_groups) = row_groups {
+            builder = builder.with_row_groups(row_groups);
+        }
+
+        builder.build().map_err(|e| {
+            HedlError::io(format!("Failed to build Parquet reader: {}", e))
+        })
+    }
 }
 
 /// HEDL metadata extracted from Parquet file.
 #[derive(Debug, Clone, Default)]
-struct HedlMetadata {
+pub(crate) struct HedlMetadata {
     type_name: Option<String>,
     key: Option<String>,
 }
@@ -189,35 +375,47 @@ fn is_valid_identifier(name: &str) -> bool {
         && name.chars().all(|c| c.is_alphanumeric() || c == '_')
 }
 
+impl HedlMetadata {
+    /// Record one metadata entry, ignoring unknown keys.
+    ///
+    /// # Metadata Keys
+    ///
+    /// Uses standardized metadata key names:
+    /// - `hedl:type_name` - The HEDL type name for entities
+    /// - `hedl:key` - The key name for the list in the document
+    ///
+    /// Both values are validated as valid HEDL identifiers before use.
+    fn set(&mut self, key: &str, value: &str) {
+        // Security: Metadata key names are hardcoded for safety, and values
+        // must be valid identifiers
+        if !is_valid_identifier(value) {
+            return;
+        }
+        if key == "hedl:type_name" {
+            self.type_name = Some(value.to_string());
+        } else if key == "hedl:key" {
+            self.key = Some(value.to_string());
+        }
+    }
+
+    /// Extract HEDL metadata from Arrow schema metadata.
+    pub(crate) fn from_schema(schema: &arrow::datatypes::Schema) -> Self {
+        let mut metadata = Self::default();
+        for (key, value) in schema.metadata() {
+            metadata.set(key, value);
+        }
+        metadata
+    }
+}
+
 /// Extract HEDL metadata from Parquet file metadata.
-///
-/// # Metadata Keys
-///
-/// Uses standardized metadata key names:
-/// - `hedl:type_name` - The HEDL type name for entities
-/// - `hedl:key` - The key name for the list in the document
-///
-/// Both values are validated as valid HEDL identifiers before use.
 fn extract_hedl_metadata(file_metadata: &parquet::file::metadata::FileMetaData) -> HedlMetadata {
     let mut metadata = HedlMetadata::default();
 
     if let Some(kv_metadata) = file_metadata.key_value_metadata() {
         for kv in kv_metadata {
-            // Security: Metadata key names are hardcoded for safety
-            if kv.key == "hedl:type_name" {
-                // Security: Validate that extracted type_name is a valid identifier
-                if let Some(ref value) = kv.value {
-                    if is_valid_identifier(value) {
-                        metadata.type_name = Some(value.clone());
-                    }
-                }
-            } else if kv.key == "hedl:key" {
-                // Security: Validate that extracted key is a valid identifier
-                if let Some(ref value) = kv.value {
-                    if is_valid_identifier(value) {
-                        metadata.key = Some(value.clone());
-                    }
-                }
+            if let Some(ref value) = kv.value {
+                metadata.set(&kv.key, value);
             }
         }
     }
@@ -227,7 +425,7 @@ fn extract_hedl_metadata(file_metadata: &parquet::file::metadata::FileMetaData)
 
 /// Read all record batches from the Arrow reader.
 fn read_batches(
-    arrow_reader: impl Iterator<Item = Result<RecordBatch, arrow::error::ArrowError>>,
+    arrow_reader: impl Iterator<Item = Result<RecordBatch, HedlError>>,
     hedl_metadata: HedlMetadata,
 ) -> Result<Document, HedlError> {
     let mut doc = Document::new((1, 0));
@@ -235,9 +433,7 @@ fn read_batches(
 
     // Read all record batches
     for batch_result in arrow_reader {
-        let batch = batch_result.map_err(|e| {
-            HedlError::io(format!("Failed to read record batch: {}", e))
-        })?;
+        let batch = batch_result?;
 
         // Security: Track decompressed data size to prevent decompression bombs
         let batch_bytes = estimate_batch_size(&batch);
@@ -271,7 +467,7 @@ fn estimate_batch_size(batch: &RecordBatch) -> usize {
 }
 
 /// Convert a RecordBatch to HEDL structure.
-fn convert_record_batch_to_hedl(
+pub(crate) fn convert_record_batch_to_hedl(
     batch: &RecordBatch,
     doc: &mut Document,
     hedl_metadata: &HedlMetadata,
@@ -401,7 +597,13 @@ fn convert_to_matrix_list(
         .clone()
         .unwrap_or_else(|| format!("{}s", type_name.to_lowercase()));
 
-    let mut matrix_list = MatrixList::new(&type_name, column_names.clone());
+    // Later batches of the same table continue the list started by the first
+    let mut matrix_list = match doc.root.remove(&list_key) {
+        Some(Item::List(list)) if list.type_name == type_name && list.schema == column_names => {
+            list
+        }
+        _ => MatrixList::new(&type_name, column_names.clone()),
+    };
 
     // Convert each row to a Node
     for row_idx in 0..num_rows {
@@ -167,12 +167,24 @@
 //!
 //! to_parquet_with_config(&doc, Path::new("output.parquet"), &config).unwrap();
 //! ```
+//!
+//! # Row Groups and Parallelism
+//!
+//! Matrix lists are split into row groups of `max_row_group_size` rows, and the
+//! column chunks of each row group are encoded in parallel unless `parallel` is
+//! turned off. The output is byte-for-byte the same either way.
+//!
+//! `from_parquet_bytes` and `from_parquet_mmap` decode row groups in parallel,
+//! and `ParquetReadOptions` restricts a read to chosen columns and row groups.
 
+mod arrow_c;
 mod from_parquet;
 mod to_parquet;
 
 // Re-export public API
-pub use from_parquet::{from_parquet, from_parquet_bytes};
+pub use arrow::ffi::{FFI_ArrowArray, FFI_ArrowSchema};
+pub use arrow_c::{from_arrow_c, from_record_batch, to_arrow_c, to_record_batch};
+pub use from_parquet::{from_parquet, from_parquet_bytes, from_parquet_mmap, ParquetReadOptions};
 pub use to_parquet::{
     to_parquet, to_parquet_bytes, to_parquet_bytes_with_config, to_parquet_with_config,
     ToParquetConfig,
@@ -82,9 +82,17 @@ use std::sync::Arc;
 use arrow::array::{ArrayRef, BooleanArray, Float64Array, Int64Array, StringBuilder};
 use arrow::datatypes::{DataType, Field, Schema};
 use arrow::record_batch::RecordBatch;
-use parquet::arrow::ArrowWriter;
+use parquet::arrow::arrow_writer::{
+    compute_leaves, get_column_writers, ArrowColumnChunk, ArrowColumnWriter, ArrowLeafColumn,
+};
+use parquet::arrow::{add_encoded_arrow_schema_to_metadata, ArrowSchemaConverter};
 use parquet::basic::{Compression, Encoding};
-use parquet::file::properties::{WriterProperties, WriterVersion};
+use parquet::file::properties::{
+    WriterProperties, WriterPropertiesBuilder, WriterVersion, DEFAULT_MAX_ROW_GROUP_SIZE,
+};
+use parquet::file::writer::SerializedFileWriter;
+use parquet::schema::types::SchemaDescriptor;
+use rayon::prelude::*;
 
 use hedl_core::{Document, HedlError, HedlErrorKind, Item, MatrixList, Node, Value};
 
@@ -97,6 +105,17 @@ pub struct ToParquetConfig {
     pub writer_version: WriterVersion,
     /// Encoding for string columns.
     pub string_encoding: Encoding,
+    /// Maximum number of rows per row group.
+    ///
+    /// Readers can project and skip data one row group at a time, so
+    /// smaller groups make selective reads cheaper at some cost in
+    /// compression ratio.
+    pub max_row_group_size: usize,
+    /// Dictionary-encode columns, falling back to plain encoding when a
+    /// column's dictionary grows too large.
+    pub dictionary_enabled: bool,
+    /// Encode the column chunks of each row group in parallel.
+    pub parallel: bool,
 }
 
 impl Default for ToParquetConfig {
@@ -105,6 +124,9 @@ impl Default for ToParquetConfig {
             compression: Compression::SNAPPY,
             writer_version: WriterVersion::PARQUET_2_0,
             string_encoding: Encoding::PLAIN,
+            max_row_group_size: DEFAULT_MAX_ROW_GROUP_SIZE,
+            dictionary_enabled: true,
+            parallel: true,
         }
     }
 }
@@ -210,12 +232,7 @@ fn write_matrix_list_to_buffer(
     let record_batch = build_record_batch_from_nodes(&matrix_list.rows, &schema)?;
 
     // Configure writer properties with metadata
-    let mut props_builder = WriterProperties::builder()
-        .set_compression(config.compression)
-        .set_writer_version(config.writer_version);
-
-    // Add metadata as key-value pairs
-    props_builder = props_builder.set_key_value_metadata(Some(vec![
+    let props_builder = writer_properties(config).set_key_value_metadata(Some(vec![
         parquet::file::metadata::KeyValue::new(
             "hedl:type_name".to_string(),
             matrix_list.type_name.clone(),
@@ -223,17 +240,70 @@ fn write_matrix_list_to_buffer(
         parquet::file::metadata::KeyValue::new("hedl:key".to_string(), hedl_key.to_string()),
     ]));
 
-    let props = props_builder.build();
+    write_table(&record_batch, props_builder, buffer, config)
+}
+
+/// Writer properties shared by every table.
+fn writer_properties(config: &ToParquetConfig) -> WriterPropertiesBuilder {
+    WriterProperties::builder()
+        .set_compression(config.compression)
+        .set_writer_version(config.writer_version)
+        .set_dictionary_enabled(config.dictionary_enabled)
+}
+
+/// Write a record batch as a Parquet file, one row group per
+/// `max_row_group_size` rows.
+///
+/// Each row group's column chunks are encoded independently and then
+/// appended in schema order, so the file is identical whether or not the
+/// chunks were encoded in parallel.
+fn write_table(
+    batch: &RecordBatch,
+    props_builder: WriterPropertiesBuilder,
+    buffer: &mut Vec<u8>,
+    config: &ToParquetConfig,
+) -> Result<(), HedlError> {
+    let schema = batch.schema();
+
+    // Embed the Arrow schema the same way ArrowWriter does
+    let mut props = props_builder.build();
+    add_encoded_arrow_schema_to_metadata(&schema, &mut props);
+    let props = Arc::new(props);
+
+    let parquet_schema = ArrowSchemaConverter::new()
+        .with_coerce_types(props.coerce_types())
+        .convert(&schema)
+        .map_err(|e| HedlError::io(format!("Failed to create Parquet writer: {}", e)))?;
 
-    // Write to buffer
     let mut writer =
-        ArrowWriter::try_new(buffer, Arc::clone(&schema), Some(props)).map_err(|e| {
-            HedlError::io(format!("Failed to create Parquet writer: {}", e))
+        SerializedFileWriter::new(buffer, parquet_schema.root_schema_ptr(), Arc::clone(&props))
+            .map_err(|e| HedlError::io(format!("Failed to create Parquet writer: {}", e)))?;
+
+    let group_rows = config.max_row_group_size.max(1);
+    let mut offset = 0;
+    while offset < batch.num_rows() {
+        let rows = group_rows.min(batch.num_rows() - offset);
+        let chunks = encode_row_group(
+            &batch.slice(offset, rows),
+            &parquet_schema,
+            &props,
+            config.parallel,
+        )?;
+
+        let mut row_group = writer.next_row_group().map_err(|e| {
+            HedlError::io(format!("Failed to start row group: {}", e))
+        })?;
+        for chunk in chunks {
+            chunk.append_to_row_group(&mut row_group).map_err(|e| {
+                HedlError::io(format!("Failed to write column chunk: {}", e))
+            })?;
+        }
+        row_group.close().map_err(|e| {
+            HedlError::io(format!("Failed to close row group: {}", e))
         })?;
 
-    writer.write(&record_batch).map_err(|e| {
-        HedlError::io(format!("Failed to write record batch: {}", e))
-    })?;
+        offset += rows;
+    }
 
     writer.close().map_err(|e| {
         HedlError::io(format!("Failed to close Parquet writer: {}", e))
@@ -242,8 +312,42 @@ fn write_matrix_list_to_buffer(
     Ok(())
 }
 
+/// Encode every leaf column of one row group into a finished column chunk.
+fn encode_row_group(
+    batch: &RecordBatch,
+    parquet_schema: &SchemaDescriptor,
+    props: &Arc<WriterProperties>,
+    parallel: bool,
+) -> Result<Vec<ArrowColumnChunk>, HedlError> {
+    let schema = batch.schema();
+    let writers = get_column_writers(parquet_schema, props, &schema).map_err(|e| {
+        HedlError::io(format!("Failed to create column writers: {}", e))
+    })?;
+
+    let mut leaves = Vec::with_capacity(writers.len());
+    for (field, column) in schema.fields().iter().zip(batch.columns()) {
+        let field_leaves = compute_leaves(field, column).map_err(|e| {
+            HedlError::io(format!("Failed to prepare column '{}': {}", field.name(), e))
+        })?;
+        leaves.extend(field_leaves);
+    }
+
+    let encode = |(mut writer, leaf): (ArrowColumnWriter, ArrowLeafColumn)| {
+        writer.write(&leaf)?;
+        writer.close()
+    };
+
+    let chunks: Result<Vec<ArrowColumnChunk>, _> = if parallel {
+        writers.into_par_iter().zip(leaves).map(encode).collect()
+    } else {
+        writers.into_iter().zip(leaves).map(encode).collect()
+    };
+
+    chunks.map_err(|e| HedlError::io(format!("Failed to encode column chunk: {}", e)))
+}
+
 /// Build Arrow schema from a matrix list.
-fn build_schema_from_matrix_list(
+pub(crate) fn build_schema_from_matrix_list(
     matrix_list: &MatrixList,
     hedl_key: &str,
 ) -> Result<Arc<Schema>, HedlError> {
@@ -301,7 +405,7 @@ fn infer_arrow_type(value: &Value) -> DataType {
 /// - No reordering or sorting occurs
 ///
 /// This guarantees that row position is maintained from HEDL to Parquet.
-fn build_record_batch_from_nodes(
+pub(crate) fn build_record_batch_from_nodes(
     nodes: &[Node],
     schema: &Arc<Schema>,
 ) -> Result<RecordBatch, HedlError> {
@@ -451,27 +555,7 @@ fn write_metadata_to_buffer(
             )
         })?;
 
-    // Configure writer properties
-    let props = WriterProperties::builder()
-        .set_compression(config.compression)
-        .set_writer_version(config.writer_version)
-        .build();
-
-    // Write to buffer
-    let mut writer =
-        ArrowWriter::try_new(buffer, Arc::clone(&schema), Some(props)).map_err(|e| {
-            HedlError::io(format!("Failed to create metadata Parquet writer: {}", e))
-        })?;
-
-    writer.write(&record_batch).map_err(|e| {
-        HedlError::io(format!("Failed to write metadata record batch: {}", e))
-    })?;
-
-    writer.close().map_err(|e| {
-        HedlError::io(format!("Failed to close metadata Parquet writer: {}", e))
-    })?;
-
-    Ok(())
+    write_table(&record_batch, writer_properties(config), buffer, config)
 }
 
 #[cfg(test)]
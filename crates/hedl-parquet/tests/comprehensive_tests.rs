@@ -21,10 +21,12 @@
 
 use hedl_core::{Document, Item, MatrixList, Node, Reference, Value};
 use hedl_parquet::{
-    from_parquet_bytes, to_parquet_bytes, to_parquet_bytes_with_config, ToParquetConfig,
+    from_parquet_bytes, from_parquet_mmap, to_parquet_bytes, to_parquet_bytes_with_config,
+    ParquetReadOptions, ToParquetConfig,
 };
 use hedl_test::fixtures;
 use parquet::basic::Compression;
+use tempfile::TempDir;
 
 // =============================================================================
 // Basic Round-Trip Tests
@@ -740,6 +742,166 @@ fn test_single_column_list() {
     }
 }
 
+// =============================================================================
+// Memory-Mapped Read Tests
+// =============================================================================
+
+fn write_user_list(dir: &TempDir) -> std::path::PathBuf {
+    let path = dir.path().join("users.parquet");
+    std::fs::write(&path, to_parquet_bytes(&fixtures::user_list()).unwrap()).unwrap();
+    path
+}
+
+#[test]
+fn test_mmap_matches_bytes_reader() {
+    let dir = TempDir::new().unwrap();
+    let path = write_user_list(&dir);
+
+    let mapped = from_parquet_mmap(&path, &ParquetReadOptions::default()).unwrap();
+    let copied = from_parquet_bytes(&std::fs::read(&path).unwrap()).unwrap();
+
+    assert_eq!(mapped.root, copied.root);
+}
+
+#[test]
+fn test_mmap_column_projection() {
+    let dir = TempDir::new().unwrap();
+    let path = write_user_list(&dir);
+
+    let options = ParquetReadOptions {
+        columns: Some(vec!["id".to_string(), "email".to_string()]),
+        row_groups: Some(vec![0]),
+    };
+    let doc = from_parquet_mmap(&path, &options).unwrap();
+
+    if let Some(Item::List(list)) = doc.root.get("users") {
+        assert_eq!(list.schema, vec!["id".to_string(), "email".to_string()]);
+        assert_eq!(list.rows.len(), 3);
+        assert_eq!(list.rows[0].id, "alice");
+        assert_eq!(
+            list.rows[0].fields[1],
+            Value::String("alice@example.com".to_string())
+        );
+    } else {
+        panic!("Expected users list");
+    }
+}
+
+#[test]
+fn test_mmap_rejects_unknown_selection() {
+    let dir = TempDir::new().unwrap();
+    let path = write_user_list(&dir);
+
+    let unknown_column = ParquetReadOptions {
+        columns: Some(vec!["missing".to_string()]),
+        row_groups: None,
+    };
+    assert!(from_parquet_mmap(&path, &unknown_column).is_err());
+
+    let unknown_group = ParquetReadOptions {
+        columns: None,
+        row_groups: Some(vec![99]),
+    };
+    assert!(from_parquet_mmap(&path, &unknown_group).is_err());
+}
+
+// =============================================================================
+// Row Group Tests
+// =============================================================================
+
+fn numbered_items(count: usize) -> Document {
+    let mut doc = Document::new((1, 0));
+    let mut list = MatrixList::new("Item", vec!["id".to_string(), "value".to_string()]);
+    for i in 0..count {
+        list.add_row(Node::new(
+            "Item",
+            format!("item_{}", i),
+            vec![Value::String(format!("item_{}", i)), Value::Int(i as i64)],
+        ));
+    }
+    doc.root.insert("items".to_string(), Item::List(list));
+    doc
+}
+
+fn item_ids(doc: &Document) -> Vec<String> {
+    match doc.root.get("items") {
+        Some(Item::List(list)) => list.rows.iter().map(|row| row.id.clone()).collect(),
+        _ => panic!("Expected items list"),
+    }
+}
+
+#[test]
+fn test_row_groups_follow_configured_size() {
+    let dir = TempDir::new().unwrap();
+    let path = dir.path().join("items.parquet");
+    let config = ToParquetConfig {
+        max_row_group_size: 4,
+        ..Default::default()
+    };
+    std::fs::write(
+        &path,
+        to_parquet_bytes_with_config(&numbered_items(10), &config).unwrap(),
+    )
+    .unwrap();
+
+    let all = from_parquet_mmap(&path, &ParquetReadOptions::default()).unwrap();
+    let expected: Vec<String> = (0..10).map(|i| format!("item_{}", i)).collect();
+    assert_eq!(item_ids(&all), expected);
+
+    let options = ParquetReadOptions {
+        columns: None,
+        row_groups: Some(vec![2, 0]),
+    };
+    let selected = from_parquet_mmap(&path, &options).unwrap();
+    assert_eq!(
+        item_ids(&selected),
+        vec!["item_8", "item_9", "item_0", "item_1", "item_2", "item_3"]
+    );
+
+    let past_end = ParquetReadOptions {
+        columns: None,
+        row_groups: Some(vec![3]),
+    };
+    assert!(from_parquet_mmap(&path, &past_end).is_err());
+}
+
+#[test]
+fn test_parallel_encoding_matches_sequential() {
+    let doc = numbered_items(5000);
+    let parallel = ToParquetConfig {
+        max_row_group_size: 1000,
+        ..Default::default()
+    };
+    let sequential = ToParquetConfig {
+        parallel: false,
+        ..parallel.clone()
+    };
+
+    let bytes = to_parquet_bytes_with_config(&doc, &parallel).unwrap();
+    assert_eq!(
+        bytes,
+        to_parquet_bytes_with_config(&doc, &sequential).unwrap()
+    );
+
+    let restored = from_parquet_bytes(&bytes).unwrap();
+    assert_eq!(item_ids(&restored), item_ids(&doc));
+}
+
+#[test]
+fn test_dictionary_disabled_round_trip() {
+    let doc = numbered_items(50);
+    let config = ToParquetConfig {
+        dictionary_enabled: false,
+        compression: Compression::UNCOMPRESSED,
+        ..Default::default()
+    };
+
+    let bytes = to_parquet_bytes_with_config(&doc, &config).unwrap();
+    let restored = from_parquet_bytes(&bytes).unwrap();
+
+    assert_eq!(item_ids(&restored), item_ids(&doc));
+}
+
 // =============================================================================
 // Shared Fixture Tests
 // =============================================================================
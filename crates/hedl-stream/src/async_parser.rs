@@ -104,7 +104,7 @@
 use crate::async_reader::AsyncLineReader;
 use crate::error::{StreamError, StreamResult};
 use crate::event::{HeaderInfo, NodeEvent, NodeInfo};
-use crate::parser::{strip_comment, StreamingParserConfig};
+use crate::parser::{strip_comment, BlockString, StreamingParserConfig};
 use hedl_core::Value;
 use hedl_core::lex::{calculate_indent, is_valid_key_token, is_valid_type_name};
 use tokio::io::AsyncRead;
@@ -189,6 +189,8 @@ struct ParserState {
     stack: Vec<Context>,
     /// Previous row values for ditto handling.
     prev_row: Option<Vec<Value>>,
+    /// Block string whose closing `"""` has not been read yet.
+    block_string: Option<BlockString>,
 }
 
 #[derive(Debug, Clone)]
@@ -307,6 +309,7 @@ impl<R: AsyncRead + Unpin> AsyncStreamingParser<R> {
             state: ParserState {
                 stack: vec![Context::Root],
                 prev_row: None,
+                block_string: None,
             },
             finished: false,
             start_time: Instant::now(),
@@ -416,11 +419,23 @@ impl<R: AsyncRead + Unpin> AsyncStreamingParser<R> {
             let (line_num, line) = match self.reader.next_line().await? {
                 Some(l) => l,
                 None => {
+                    if let Some(block) = &self.state.block_string {
+                        return Err(block.unclosed());
+                    }
                     self.finished = true;
                     return self.finalize();
                 }
             };
 
+            // Lines of an open block string are content up to its closing `"""`
+            if let Some(mut block) = self.state.block_string.take() {
+                if block.push_line(&line, line_num)? {
+                    return Ok(Some(block.into_event()));
+                }
+                self.state.block_string = Some(block);
+                continue;
+            }
+
             let trimmed = line.trim();
 
             // Skip blank lines and comments
@@ -452,6 +467,11 @@ impl<R: AsyncRead + Unpin> AsyncStreamingParser<R> {
                 return Ok(Some(event));
             }
 
+            if let Some(block) = BlockString::open(content, line_num)? {
+                self.state.block_string = Some(block);
+                continue;
+            }
+
             // Parse line content
             return self.parse_line(content, indent, line_num);
         }
@@ -796,7 +816,7 @@ impl<R: AsyncRead + Unpin> AsyncStreamingParser<R> {
 
         let (type_name, schema, parent_info) = self.find_list_context(indent, line_num)?;
 
-        let fields = hedl_core::lex::parse_csv_row(content)
+        let fields = hedl_core::lex::parse_csv_row_ref(content)
             .map_err(|e| StreamError::syntax(line_num, format!("row parse error: {}", e)))?;
 
         if fields.len() != schema.len() {
@@ -816,7 +836,7 @@ impl<R: AsyncRead + Unpin> AsyncStreamingParser<R> {
                     .and_then(|prev| prev.get(col_idx).cloned())
                     .unwrap_or(Value::Null)
             } else if field.is_quoted {
-                Value::String(field.value.clone())
+                Value::String(field.value.to_string())
             } else {
                 self.infer_value(&field.value, line_num)?
             };
@@ -24,6 +24,7 @@
 //! # Design Philosophy
 //!
 //! - **Memory Efficiency**: Only the current line and parsing state are kept in memory
+//!   (plus the text of a block string until its closing `"""`)
 //! - **Iterator-Based**: Standard Rust iterator interface for easy composition
 //! - **Error Recovery**: Clear error messages with line numbers for debugging
 //! - **Safety**: Built-in timeout protection against malicious/untrusted input
@@ -59,7 +60,7 @@
 use crate::error::{StreamError, StreamResult};
 use crate::event::{HeaderInfo, NodeEvent, NodeInfo};
 use crate::reader::LineReader;
-use hedl_core::Value;
+use hedl_core::{Limits, Value};
 use hedl_core::lex::{calculate_indent, is_valid_key_token, is_valid_type_name};
 use std::io::Read;
 use std::time::{Duration, Instant};
@@ -387,6 +388,8 @@ struct ParserState {
     stack: Vec<Context>,
     /// Previous row values for ditto handling.
     prev_row: Option<Vec<Value>>,
+    /// Block string whose closing `"""` has not been read yet.
+    block_string: Option<BlockString>,
 }
 
 #[derive(Debug, Clone)]
@@ -407,6 +410,101 @@ enum Context {
     },
 }
 
+/// A block string (`key: """`) being read line by line.
+///
+/// Follows the document parser: the text after the opening `"""` and every
+/// following line up to the closing `"""` are kept as-is, joined with `\n`.
+#[derive(Debug)]
+pub(crate) struct BlockString {
+    key: String,
+    line: usize,
+    content: String,
+}
+
+impl BlockString {
+    /// Start a block string if `content`, a line after its indentation,
+    /// opens one.
+    pub(crate) fn open(content: &str, line_num: usize) -> StreamResult<Option<Self>> {
+        if content.starts_with('|') {
+            return Ok(None);
+        }
+        let colon_pos = match content.find(':') {
+            Some(pos) => pos,
+            None => return Ok(None),
+        };
+        let key = content[..colon_pos].trim();
+        let after_colon = &content[colon_pos + 1..];
+        if !after_colon.is_empty() && !after_colon.starts_with(' ') {
+            return Ok(None);
+        }
+        let after_open = match after_colon.trim().strip_prefix("\"\"\"") {
+            Some(rest) => rest,
+            None => return Ok(None),
+        };
+
+        if !is_valid_key_token(key) {
+            return Err(StreamError::syntax(line_num, format!("invalid key: {}", key)));
+        }
+        let rest = after_open.trim_start();
+        if !rest.is_empty() && !rest.starts_with('#') {
+            return Err(StreamError::syntax(
+                line_num,
+                "block string must have newline after opening \"\"\"",
+            ));
+        }
+        Ok(Some(Self {
+            key: key.to_string(),
+            line: line_num,
+            content: after_open.to_string(),
+        }))
+    }
+
+    /// Add the next line; returns `true` once it held the closing `"""`.
+    pub(crate) fn push_line(&mut self, line: &str, line_num: usize) -> StreamResult<bool> {
+        let (text, closed) = match line.find("\"\"\"") {
+            Some(end) => {
+                let after_close = line[end + 3..].trim();
+                if !after_close.is_empty() && !after_close.starts_with('#') {
+                    return Err(StreamError::syntax(
+                        line_num,
+                        "unexpected content after closing \"\"\"",
+                    ));
+                }
+                (&line[..end], true)
+            }
+            None => (line, false),
+        };
+
+        let limit = Limits::default().max_block_string_size;
+        if self.content.len() + 1 + text.len() > limit {
+            return Err(StreamError::syntax(
+                line_num,
+                format!("block string exceeds limit of {} bytes", limit),
+            ));
+        }
+        self.content.push('\n');
+        self.content.push_str(text);
+        Ok(closed)
+    }
+
+    /// The finished string as a scalar event at its opening line.
+    pub(crate) fn into_event(self) -> NodeEvent {
+        NodeEvent::Scalar {
+            key: self.key,
+            value: Value::String(self.content),
+            line: self.line,
+        }
+    }
+
+    /// Error for input that ends inside the block string.
+    pub(crate) fn unclosed(&self) -> StreamError {
+        StreamError::syntax(
+            self.line,
+            format!("unclosed block string starting at line {}", self.line),
+        )
+    }
+}
+
 impl<R: Read> StreamingParser<R> {
     /// Create a new streaming parser with default configuration.
     ///
@@ -578,6 +676,7 @@ impl<R: Read> StreamingParser<R> {
             state: ParserState {
                 stack: vec![Context::Root],
                 prev_row: None,
+                block_string: None,
             },
             finished: false,
             start_time: Instant::now(),
@@ -890,12 +989,24 @@ impl<R: Read> StreamingParser<R> {
             let (line_num, line) = match self.reader.next_line()? {
                 Some(l) => l,
                 None => {
+                    if let Some(block) = &self.state.block_string {
+                        return Err(block.unclosed());
+                    }
                     self.finished = true;
                     // Emit any remaining list ends
                     return self.finalize();
                 }
             };
 
+            // Lines of an open block string are content up to its closing `"""`
+            if let Some(mut block) = self.state.block_string.take() {
+                if block.push_line(&line, line_num)? {
+                    return Ok(Some(block.into_event()));
+                }
+                self.state.block_string = Some(block);
+                continue;
+            }
+
             let trimmed = line.trim();
 
             // Skip blank lines and comments
@@ -927,6 +1038,11 @@ impl<R: Read> StreamingParser<R> {
                 return Ok(Some(event));
             }
 
+            if let Some(block) = BlockString::open(content, line_num)? {
+                self.state.block_string = Some(block);
+                continue;
+            }
+
             // Parse line content
             return self.parse_line(content, indent, line_num);
         }
@@ -1113,7 +1229,7 @@ impl<R: Read> StreamingParser<R> {
 
         // Parse HEDL matrix row (comma-separated values after the |)
         // Use hedl_row parser for proper CSV-like parsing
-        let fields = hedl_core::lex::parse_csv_row(content)
+        let fields = hedl_core::lex::parse_csv_row_ref(content)
             .map_err(|e| StreamError::syntax(line_num, format!("row parse error: {}", e)))?;
 
         // Validate shape
@@ -1136,7 +1252,7 @@ impl<R: Read> StreamingParser<R> {
                     .and_then(|prev| prev.get(col_idx).cloned())
                     .unwrap_or(Value::Null)
             } else if field.is_quoted {
-                Value::String(field.value.clone())
+                Value::String(field.value.to_string())
             } else {
                 self.infer_value(&field.value, line_num)?
             };
@@ -2032,6 +2148,35 @@ config:
         assert_eq!(scalars.len(), 3);
     }
 
+    #[test]
+    fn test_block_string_value() {
+        let input = "%VERSION: 1.0\n---\nconfig:\n  script: \"\"\"\n  a: 1\nb: 2\n  \"\"\"\n  after: 1\n";
+        let parser = StreamingParser::new(Cursor::new(input)).unwrap();
+        let events: Vec<_> = parser.collect::<Result<_, _>>().unwrap();
+
+        let scalars: Vec<_> = events
+            .iter()
+            .filter_map(|e| match e {
+                NodeEvent::Scalar { key, value, line } => Some((key.as_str(), value, *line)),
+                _ => None,
+            })
+            .collect();
+        assert_eq!(scalars.len(), 2);
+        assert_eq!(
+            scalars[0],
+            ("script", &Value::String("\n  a: 1\nb: 2\n  ".to_string()), 4)
+        );
+        assert_eq!(scalars[1].0, "after");
+    }
+
+    #[test]
+    fn test_unclosed_block_string() {
+        let input = "%VERSION: 1.0\n---\ntext: \"\"\"\nnever closed\n";
+        let parser = StreamingParser::new(Cursor::new(input)).unwrap();
+        let err = parser.filter_map(|e| e.err()).next().unwrap();
+        assert!(err.to_string().contains("unclosed block string starting at line 3"));
+    }
+
     // ============ UNICODE TESTS ============
 
     #[test]
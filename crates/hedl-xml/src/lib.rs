@@ -150,7 +150,7 @@ pub mod schema;
 pub mod async_api;
 
 pub use from_xml::{from_xml, FromXmlConfig};
-pub use to_xml::{to_xml, ToXmlConfig};
+pub use to_xml::{to_xml, to_xml_writer, ToXmlConfig};
 pub use streaming::{from_xml_stream, StreamConfig, StreamItem, XmlStreamingParser};
 pub use schema::{SchemaValidator, SchemaCache, ValidationError};
 
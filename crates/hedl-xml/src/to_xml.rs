@@ -63,11 +63,26 @@ impl hedl_core::convert::ExportConfig for ToXmlConfig {
 
 /// Convert HEDL Document to XML string
 pub fn to_xml(doc: &Document, config: &ToXmlConfig) -> Result<String, String> {
+    let mut buffer = Cursor::new(Vec::new());
+    to_xml_writer(doc, config, &mut buffer)?;
+    String::from_utf8(buffer.into_inner())
+        .map_err(|e| format!("Invalid UTF-8 in XML output: {}", e))
+}
+
+/// Convert HEDL Document to XML, writing events directly to `output`
+///
+/// Produces the same bytes as [`to_xml`]; nothing beyond the current element
+/// is buffered, so memory use does not grow with document size.
+pub fn to_xml_writer<W: std::io::Write>(
+    doc: &Document,
+    config: &ToXmlConfig,
+    output: W,
+) -> Result<(), String> {
     let mut writer = if config.pretty {
         // new_with_indent takes (inner, indent_char, indent_size)
-        Writer::new_with_indent(Cursor::new(Vec::new()), b' ', config.indent.len())
+        Writer::new_with_indent(output, b' ', config.indent.len())
     } else {
-        Writer::new(Cursor::new(Vec::new()))
+        Writer::new(output)
     };
 
     // Write XML declaration
@@ -95,8 +110,8 @@ pub fn to_xml(doc: &Document, config: &ToXmlConfig) -> Result<String, String> {
         .write_event(Event::End(BytesEnd::new(&config.root_element)))
         .map_err(|e| format!("Failed to close root element: {}", e))?;
 
-    let result = writer.into_inner().into_inner();
-    String::from_utf8(result).map_err(|e| format!("Invalid UTF-8 in XML output: {}", e))
+    std::io::Write::flush(&mut writer.into_inner())
+        .map_err(|e| format!("Failed to flush XML output: {}", e))
 }
 
 fn write_root<W: std::io::Write>(
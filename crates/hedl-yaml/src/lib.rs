@@ -155,7 +155,7 @@ pub use from_yaml::{
     from_yaml, from_yaml_value, FromYamlConfig, FromYamlConfigBuilder, DEFAULT_MAX_ARRAY_LENGTH,
     DEFAULT_MAX_DOCUMENT_SIZE, DEFAULT_MAX_NESTING_DEPTH,
 };
-pub use to_yaml::{to_yaml, to_yaml_value, ToYamlConfig};
+pub use to_yaml::{to_yaml, to_yaml_value, to_yaml_writer, ToYamlConfig};
 
 use hedl_core::Document;
 
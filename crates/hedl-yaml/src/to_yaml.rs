@@ -60,6 +60,19 @@ pub fn to_yaml(doc: &Document, config: &ToYamlConfig) -> Result<String, String>
     serde_yaml::to_string(&value).map_err(|e| format!("YAML serialization error: {}", e))
 }
 
+/// Convert Document to YAML, writing the output to `writer`
+///
+/// Produces the same bytes as [`to_yaml`] without holding the serialized
+/// string in memory; the intermediate `serde_yaml::Value` is still built.
+pub fn to_yaml_writer<W: std::io::Write>(
+    doc: &Document,
+    config: &ToYamlConfig,
+    writer: W,
+) -> Result<(), String> {
+    let value = to_yaml_value(doc, config)?;
+    serde_yaml::to_writer(writer, &value).map_err(|e| format!("YAML serialization error: {}", e))
+}
+
 /// Convert Document to serde_yaml::Value
 pub fn to_yaml_value(doc: &Document, config: &ToYamlConfig) -> Result<YamlValue, String> {
     root_to_yaml(&doc.root, config)
@@ -110,7 +110,7 @@ pub mod lex {
 // Re-export CSV utilities
 pub mod csv {
     //! CSV field parsing
-    pub use hedl_core::lex::{parse_csv_row, CsvField};
+    pub use hedl_core::lex::{parse_csv_row, parse_csv_row_ref, CsvField, CsvFieldRef};
 }
 
 // Re-export tensor utilities